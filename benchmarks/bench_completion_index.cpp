@@ -0,0 +1,104 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+/**
+ * @file bench_completion_index.cpp
+ * @brief Prefix and fuzzy completion latency over a large candidate set
+ *
+ * Builds a CompletionIndex over N synthetic identifiers with random
+ * weights, then times complete() for a series of typed prefixes
+ * ("p", "pa", "pat", ...) in exact and fuzzy mode. Prints build time and
+ * per-query latency percentiles (util::Histogram) as JSON.
+ *
+ * Usage: bench_completion_index [candidates] [queries]
+ */
+
+#include "mcpp/server/completion_index.h"
+#include "mcpp/util/metrics.h"
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace mcpp;
+
+namespace {
+
+std::string random_word(std::mt19937_64& rng, size_t min_len, size_t max_len) {
+    static const char alphabet[] = "abcdefghijklmnopqrstuvwxyz_/";
+    std::uniform_int_distribution<size_t> len(min_len, max_len);
+    std::uniform_int_distribution<size_t> ch(0, sizeof(alphabet) - 2);
+    std::string word(len(rng), ' ');
+    for (auto& c : word) c = alphabet[ch(rng)];
+    return word;
+}
+
+nlohmann::json time_queries(const server::CompletionIndex& index,
+                            const std::vector<std::string>& queries,
+                            util::Histogram& latency) {
+    size_t returned = 0;
+    for (const auto& query : queries) {
+        for (size_t len = 1; len <= query.size(); ++len) {
+            auto start = std::chrono::steady_clock::now();
+            auto result = index.complete(std::string_view(query).substr(0, len));
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count();
+            latency.record(static_cast<uint64_t>(ns));
+            returned += result.values.size();
+        }
+    }
+    return {
+        {"values_returned", returned},
+        {"latency_ns", latency.snapshot()}
+    };
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    const size_t candidates = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    const size_t queries = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 200;
+
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<uint32_t> weight(0, 1000000);
+    std::vector<server::CompletionCandidate> values;
+    values.reserve(candidates);
+    for (size_t i = 0; i < candidates; ++i) {
+        values.push_back({random_word(rng, 6, 24), weight(rng), std::nullopt});
+    }
+
+    std::vector<std::string> typed;
+    for (size_t i = 0; i < queries; ++i) {
+        typed.push_back(values[rng() % values.size()].value.substr(0, 8));
+    }
+
+    server::CompletionIndex::Options exact_options;
+    exact_options.max_edits = 0;
+    server::CompletionIndex exact(exact_options);
+    server::CompletionIndex fuzzy;
+
+    auto start = std::chrono::steady_clock::now();
+    exact.build(values);
+    auto build_seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+    fuzzy.build(std::move(values));
+
+    auto& registry = util::MetricsRegistry::global();
+    nlohmann::json report = {
+        {"benchmark", "completion_index"},
+        {"candidates", candidates},
+        {"build_seconds", build_seconds},
+        {"exact", time_queries(exact, typed, registry.histogram("bench.completion.exact_ns"))},
+        {"fuzzy", time_queries(fuzzy, typed, registry.histogram("bench.completion.fuzzy_ns"))}
+    };
+    std::cout << report.dump(2) << std::endl;
+    return 0;
+}
@@ -0,0 +1,82 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+/**
+ * @file bench_frame_limits.cpp
+ * @brief Cost of the transport pre-parse checks
+ *
+ * Builds a tools/call frame carrying a large base64 argument plus some
+ * non-ASCII text, then reports throughput (MB/s) of the SIMD and scalar
+ * UTF-8 validators, the full check_frame() pass, and nlohmann::json::parse
+ * for comparison. Output is JSON.
+ *
+ * Usage: bench_frame_limits [payload_bytes] [iterations]
+ */
+
+#include "mcpp/transport/frame_limits.h"
+#include "mcpp/util/utf8.h"
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using namespace mcpp;
+
+namespace {
+
+template<typename F>
+double megabytes_per_second(size_t bytes, size_t iterations, F&& fn) {
+    size_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        sink += fn() ? 1 : 0;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (sink != iterations) {
+        std::cerr << "unexpected validation failure\n";
+    }
+    return static_cast<double>(bytes * iterations) / (1024.0 * 1024.0) / seconds;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    size_t payload_bytes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 8 * 1024 * 1024;
+    size_t iterations = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20;
+
+    std::string payload(payload_bytes, 'A');
+    for (size_t i = 0; i < payload.size(); i += 7) {
+        payload[i] = "QUJDREVGR0hJSktMTU5PUFFSU1RVVldYWVo+/"[i % 37];
+    }
+    nlohmann::json request{
+        {"jsonrpc", "2.0"},
+        {"id", 1},
+        {"method", "tools/call"},
+        {"params", {{"name", "upload"}, {"arguments", {{"data", payload}, {"note", "caf\xc3\xa9 \xe2\x82\xac"}}}}}
+    };
+    std::string frame = request.dump();
+    transport::FrameLimits limits;
+    limits.max_frame_bytes = 0;
+
+    nlohmann::json report{
+        {"frame_bytes", frame.size()},
+        {"iterations", iterations},
+        {"utf8_backend", util::utf8_backend()},
+        {"utf8_simd_mb_s", megabytes_per_second(frame.size(), iterations,
+            [&] { return util::is_valid_utf8(frame); })},
+        {"utf8_scalar_mb_s", megabytes_per_second(frame.size(), iterations,
+            [&] { return util::is_valid_utf8_scalar(frame); })},
+        {"check_frame_mb_s", megabytes_per_second(frame.size(), iterations,
+            [&] { return transport::check_frame(frame, limits) == transport::FrameError::None; })},
+        {"json_parse_mb_s", megabytes_per_second(frame.size(), iterations,
+            [&] { return !nlohmann::json::parse(frame).is_discarded(); })},
+    };
+    std::cout << report.dump(2) << std::endl;
+    return 0;
+}
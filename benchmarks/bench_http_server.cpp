@@ -0,0 +1,155 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+/**
+ * @file bench_http_server.cpp
+ * @brief Streamable HTTP request throughput as shards are added
+ *
+ * Starts HttpServer with 1, 2, 4, ... shards (up to the CPU count). Each
+ * client thread opens a session, then sends POSTs for it over one
+ * keep-alive connection. Reports requests per second for each shard
+ * count and the number of connection handoffs. Output is JSON.
+ *
+ * Usage: bench_http_server [clients] [seconds_per_run]
+ */
+
+#include "mcpp/transport/http_server.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mcpp;
+
+namespace {
+
+int connect_to(uint16_t port) {
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    ::inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    int one = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return fd;
+}
+
+/// Send one request and read until the response body is complete
+bool round_trip(int fd, const std::string& request, std::string& buffer, std::string* session) {
+    if (::write(fd, request.data(), request.size()) != static_cast<ssize_t>(request.size())) {
+        return false;
+    }
+    buffer.clear();
+    char chunk[4096];
+    while (true) {
+        size_t head_end = buffer.find("\r\n\r\n");
+        if (head_end != std::string::npos) {
+            size_t cl = buffer.find("Content-Length: ");
+            size_t length = cl < head_end ? std::strtoul(buffer.c_str() + cl + 16, nullptr, 10) : 0;
+            if (buffer.size() >= head_end + 4 + length) {
+                if (session != nullptr) {
+                    size_t sid = buffer.find("Mcp-Session-Id: ");
+                    if (sid != std::string::npos) {
+                        *session = buffer.substr(sid + 16, 32);
+                    }
+                }
+                return true;
+            }
+        }
+        ssize_t n = ::read(fd, chunk, sizeof(chunk));
+        if (n <= 0) {
+            return false;
+        }
+        buffer.append(chunk, static_cast<size_t>(n));
+    }
+}
+
+std::string post(const std::string& session, const std::string& body) {
+    std::string req = "POST /mcp HTTP/1.1\r\nHost: localhost\r\n";
+    if (!session.empty()) {
+        req += "Mcp-Session-Id: " + session + "\r\n";
+    }
+    return req + "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+}
+
+double run(size_t shards, size_t clients, double seconds, uint64_t& handoffs) {
+    transport::HttpServer::Options options;
+    options.shards = shards;
+    transport::HttpServer server(options, [](size_t) {
+        return [](transport::HttpServer::Session&, std::string_view body) -> std::optional<std::string> {
+            return std::string(body);
+        };
+    });
+    if (!server.start()) {
+        return 0;
+    }
+
+    const std::string body = "{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"ping\"}";
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> total{0};
+    std::vector<std::thread> threads;
+    for (size_t c = 0; c < clients; ++c) {
+        threads.emplace_back([&] {
+            int fd = connect_to(server.port());
+            if (fd < 0) {
+                return;
+            }
+            std::string buffer;
+            std::string session;
+            round_trip(fd, post("", "{\"jsonrpc\":\"2.0\",\"id\":0,\"method\":\"initialize\"}"),
+                       buffer, &session);
+            const std::string request = post(session, body);
+            uint64_t count = 0;
+            while (!stop.load(std::memory_order_relaxed) && round_trip(fd, request, buffer, nullptr)) {
+                ++count;
+            }
+            total += count;
+            ::close(fd);
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    stop = true;
+    for (auto& t : threads) {
+        t.join();
+    }
+    handoffs = server.handoff_count();
+    server.stop();
+    return static_cast<double>(total.load()) / seconds;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    size_t clients = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 64;
+    double seconds = argc > 2 ? std::strtod(argv[2], nullptr) : 2.0;
+    size_t cpus = std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << "{\n  \"clients\": " << clients << ",\n  \"runs\": [\n";
+    bool first = true;
+    for (size_t shards = 1; shards <= cpus; shards *= 2) {
+        uint64_t handoffs = 0;
+        double rps = run(shards, clients, seconds, handoffs);
+        std::cout << (first ? "" : ",\n") << "    {\"shards\": " << shards
+                  << ", \"requests_per_sec\": " << rps << ", \"handoffs\": " << handoffs << "}";
+        first = false;
+    }
+    std::cout << "\n  ]\n}\n";
+    return 0;
+}
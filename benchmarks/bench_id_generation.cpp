@@ -0,0 +1,72 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+/**
+ * @file bench_id_generation.cpp
+ * @brief Session/task ID generation cost, per-call mt19937 vs. SecureRandom
+ *
+ * Times N UUID v4 strings made the way session and task IDs used to be
+ * (std::random_device seeding a Mersenne Twister, formatted through a
+ * stringstream), then the same through SecureRandom and the Id128
+ * lookup-table formatter, both to a std::string and into a stack buffer.
+ * Reports nanoseconds per ID. Output is JSON.
+ *
+ * Usage: bench_id_generation [count]
+ */
+
+#include "mcpp/util/id128.h"
+#include "mcpp/util/secure_random.h"
+#include "bench_timing.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+using namespace mcpp;
+using mcpp::bench::ns_per_call;
+
+namespace {
+
+std::string legacy_uuid() {
+    std::random_device rd;
+    std::mt19937_64 gen(rd());
+    uint64_t r1 = gen();
+    uint64_t r2 = gen();
+    std::ostringstream oss;
+    oss << std::hex << std::setfill('0');
+    oss << std::setw(8) << (r1 >> 32) << "-";
+    oss << std::setw(4) << ((r1 >> 16) & 0xFFFF) << "-";
+    oss << "4" << std::setw(3) << ((r1 >> 8) & 0xFFF) << "-";
+    oss << ((r1 & 0x3) | 0x8) << std::setw(3) << ((r2 >> 48) & 0xFFF) << "-";
+    oss << std::setw(12) << (r2 & 0xFFFFFFFFFFFFULL);
+    return oss.str();
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+
+    double legacy = ns_per_call(count, [] { return legacy_uuid().size(); });
+    double secure_string = ns_per_call(count, [] {
+        return util::SecureRandom::next_id128().as_uuid_v4().to_uuid().size();
+    });
+    double secure_buffer = ns_per_call(count, [] {
+        char buf[util::Id128::UUID_LENGTH];
+        util::SecureRandom::next_id128().as_uuid_v4().write_uuid(buf);
+        return static_cast<size_t>(buf[0]);
+    });
+
+    std::cout << "{\n  \"count\": " << count
+              << ",\n  \"ns_per_id\": {\n    \"mt19937_stringstream\": " << legacy
+              << ",\n    \"secure_random_string\": " << secure_string
+              << ",\n    \"secure_random_buffer\": " << secure_buffer << "\n  }\n}\n";
+    return 0;
+}
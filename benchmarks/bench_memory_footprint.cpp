@@ -0,0 +1,200 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+/**
+ * @file bench_memory_footprint.cpp
+ * @brief Heap bytes held per idle session, in-flight request and task
+ *
+ * Replaces global operator new/delete with versions that track live heap
+ * bytes (as reported by malloc_usable_size, so allocator rounding counts),
+ * then creates N of each object and divides the growth by N:
+ *
+ * - http_server_session: idle HttpServer session opened by a POST
+ * - http_transport_session: HttpTransport::create_session()
+ * - request_context: one RequestContext, as held for an in-flight request
+ * - task: TaskManager::create_task()
+ *
+ * Also projects the heap needed for one million idle HttpServer sessions.
+ * Output is JSON.
+ *
+ * Usage: bench_memory_footprint [count]
+ */
+
+#include "mcpp/server/request_context.h"
+#include "mcpp/server/task_manager.h"
+#include "mcpp/transport/http_server.h"
+#include "mcpp/transport/http_transport.h"
+#include "mcpp/transport/null_transport.h"
+
+#include <arpa/inet.h>
+#include <malloc.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::atomic<int64_t> g_live_bytes{0};
+
+void* counted_alloc(size_t size) {
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    g_live_bytes.fetch_add(static_cast<int64_t>(::malloc_usable_size(p)), std::memory_order_relaxed);
+    return p;
+}
+
+void counted_free(void* p) noexcept {
+    if (p != nullptr) {
+        g_live_bytes.fetch_sub(static_cast<int64_t>(::malloc_usable_size(p)), std::memory_order_relaxed);
+        std::free(p);
+    }
+}
+
+} // anonymous namespace
+
+void* operator new(size_t size) { return counted_alloc(size); }
+void* operator new[](size_t size) { return counted_alloc(size); }
+void operator delete(void* p) noexcept { counted_free(p); }
+void operator delete[](void* p) noexcept { counted_free(p); }
+void operator delete(void* p, size_t) noexcept { counted_free(p); }
+void operator delete[](void* p, size_t) noexcept { counted_free(p); }
+
+using namespace mcpp;
+
+namespace {
+
+int64_t live_bytes() {
+    return g_live_bytes.load(std::memory_order_relaxed);
+}
+
+int connect_to(uint16_t port) {
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    ::inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/// Open @p count sessions over one keep-alive connection
+bool open_sessions(uint16_t port, size_t count) {
+    int fd = connect_to(port);
+    if (fd < 0) {
+        return false;
+    }
+    const std::string body = "{\"jsonrpc\":\"2.0\",\"id\":0,\"method\":\"initialize\"}";
+    const std::string request = "POST /mcp HTTP/1.1\r\nHost: localhost\r\nContent-Length: " +
+                                std::to_string(body.size()) + "\r\n\r\n" + body;
+    std::string buffer;
+    char chunk[4096];
+    for (size_t i = 0; i < count; ++i) {
+        if (::write(fd, request.data(), request.size()) != static_cast<ssize_t>(request.size())) {
+            ::close(fd);
+            return false;
+        }
+        // 202 responses have no body; read up to the end of the head
+        buffer.clear();
+        while (buffer.find("\r\n\r\n") == std::string::npos) {
+            ssize_t n = ::read(fd, chunk, sizeof(chunk));
+            if (n <= 0) {
+                ::close(fd);
+                return false;
+            }
+            buffer.append(chunk, static_cast<size_t>(n));
+        }
+    }
+    ::close(fd);
+    return true;
+}
+
+double http_server_session(size_t count) {
+    transport::HttpServer::Options options;
+    options.shards = 1;
+    options.max_sessions = 0;
+    transport::HttpServer server(options, [](size_t) {
+        return [](transport::HttpServer::Session&, std::string_view) -> std::optional<std::string> {
+            return std::nullopt;
+        };
+    });
+    if (!server.start()) {
+        return -1;
+    }
+    // Warm up connection and table state so only per-session growth is measured
+    open_sessions(server.port(), 1);
+    int64_t before = live_bytes();
+    if (!open_sessions(server.port(), count)) {
+        return -1;
+    }
+    int64_t after = live_bytes();
+    server.stop();
+    return static_cast<double>(after - before) / static_cast<double>(count);
+}
+
+double http_transport_session(size_t count) {
+    transport::HttpTransport transport;
+    transport.create_session();
+    int64_t before = live_bytes();
+    for (size_t i = 0; i < count; ++i) {
+        transport.create_session();
+    }
+    return static_cast<double>(live_bytes() - before) / static_cast<double>(count);
+}
+
+double request_context(size_t count) {
+    transport::NullTransport transport;
+    std::vector<std::unique_ptr<server::RequestContext>> contexts;
+    contexts.reserve(count);
+    int64_t before = live_bytes();
+    for (size_t i = 0; i < count; ++i) {
+        contexts.push_back(std::make_unique<server::RequestContext>(std::to_string(i), transport));
+        contexts.back()->set_progress_token("progress-" + std::to_string(i));
+    }
+    return static_cast<double>(live_bytes() - before) / static_cast<double>(count);
+}
+
+double task(size_t count) {
+    server::TaskManager tasks;
+    tasks.create_task();
+    int64_t before = live_bytes();
+    for (size_t i = 0; i < count; ++i) {
+        tasks.create_task(60000, 1000);
+    }
+    return static_cast<double>(live_bytes() - before) / static_cast<double>(count);
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000;
+
+    double server_session = http_server_session(count);
+    double transport_session = http_transport_session(count);
+    double context = request_context(count);
+    double task_bytes = task(count);
+
+    std::cout << "{\n  \"count\": " << count
+              << ",\n  \"bytes_per\": {\n    \"http_server_session\": " << server_session
+              << ",\n    \"http_transport_session\": " << transport_session
+              << ",\n    \"request_context\": " << context
+              << ",\n    \"task\": " << task_bytes
+              << "\n  },\n  \"projected_mb_per_1m_idle_sessions\": "
+              << server_session * 1e6 / (1024.0 * 1024.0) << "\n}\n";
+    return 0;
+}
@@ -0,0 +1,99 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+/**
+ * @file bench_reactor_backends.cpp
+ * @brief Echo throughput of FdTransport on the epoll and io_uring backends
+ *
+ * A peer thread writes bursts of small JSON-RPC lines into a Unix
+ * socketpair; an FdTransport on the reactor thread echoes every line
+ * back. Reports messages per second for each backend. Run under
+ * `strace -c -f` to compare system call counts. Output is JSON.
+ *
+ * Usage: bench_reactor_backends [messages] [burst]
+ */
+
+#include "mcpp/async/reactor.h"
+#include "mcpp/transport/fd_transport.h"
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+using namespace mcpp;
+
+namespace {
+
+double run(async::Reactor::Backend backend, size_t messages, size_t burst, bool& used) {
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+        return 0;
+    }
+    async::Reactor::Options options;
+    options.backend = backend;
+    async::Reactor reactor(options);
+    used = reactor.backend() == backend;
+
+    transport::FdTransport::Options transport_options;
+    transport_options.owns_fds = true;
+    transport::FdTransport transport(reactor, fds[0], fds[0], transport_options);
+    transport.set_message_callback([&](std::string_view msg) { transport.send(msg); });
+    transport.connect();
+
+    const std::string line = "{\"jsonrpc\":\"2.0\",\"method\":\"notifications/progress\",\"params\":{\"progress\":1}}\n";
+    auto start = std::chrono::steady_clock::now();
+    std::thread peer([&] {
+        std::string batch;
+        for (size_t i = 0; i < burst; ++i) {
+            batch += line;
+        }
+        size_t received = 0;
+        char buf[65536];
+        for (size_t sent = 0; sent < messages; sent += burst) {
+            [[maybe_unused]] auto w = ::write(fds[1], batch.data(), batch.size());
+            size_t target = (sent + burst) * line.size();
+            while (received < target) {
+                ssize_t n = ::read(fds[1], buf, sizeof(buf));
+                if (n <= 0) {
+                    break;
+                }
+                received += static_cast<size_t>(n);
+            }
+        }
+        reactor.stop();
+    });
+    reactor.run();
+    peer.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    ::close(fds[1]);
+    return static_cast<double>(messages) / seconds;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    size_t messages = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    size_t burst = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 64;
+
+    bool epoll_used = false;
+    bool uring_used = false;
+    double epoll = run(async::Reactor::Backend::Epoll, messages, burst, epoll_used);
+    double uring = run(async::Reactor::Backend::IoUring, messages, burst, uring_used);
+
+    std::cout << "{\n"
+              << "  \"messages\": " << messages << ",\n"
+              << "  \"burst\": " << burst << ",\n"
+              << "  \"epoll_msgs_per_sec\": " << epoll << ",\n"
+              << "  \"io_uring_available\": " << (uring_used ? "true" : "false") << ",\n"
+              << "  \"io_uring_msgs_per_sec\": " << uring << "\n"
+              << "}\n";
+    return 0;
+}
@@ -0,0 +1,73 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+/**
+ * @file bench_task_timestamps.cpp
+ * @brief Cost of task timestamps: gmtime/put_time vs. the cached writer
+ *
+ * Times ISO 8601 formatting through gmtime + put_time + stringstream (the
+ * previous TaskManager path) against util::write_iso8601 and
+ * util::format_iso8601, then TaskManager::update_status on a live task,
+ * which now only stores a binary time point. Reports nanoseconds per
+ * call. Output is JSON.
+ *
+ * Usage: bench_task_timestamps [count]
+ */
+
+#include "mcpp/server/task_manager.h"
+#include "mcpp/util/timestamp.h"
+#include "bench_timing.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using namespace mcpp;
+using mcpp::bench::ns_per_call;
+
+namespace {
+
+std::string put_time_timestamp(std::chrono::system_clock::time_point time) {
+    auto time_t = std::chrono::system_clock::to_time_t(time);
+    std::stringstream ss;
+    ss << std::put_time(std::gmtime(&time_t), "%Y-%m-%dT%H:%M:%SZ");
+    return ss.str();
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+    double put_time = ns_per_call(count, [] {
+        return put_time_timestamp(std::chrono::system_clock::now()).size();
+    });
+    double write = ns_per_call(count, [] {
+        char buf[util::ISO8601_LENGTH];
+        util::write_iso8601(std::chrono::system_clock::now(), buf);
+        return static_cast<size_t>(buf[23]);
+    });
+    double format = ns_per_call(count, [] {
+        return util::format_iso8601(std::chrono::system_clock::now()).size();
+    });
+
+    server::TaskManager tasks;
+    std::string id = tasks.create_task();
+    double update = ns_per_call(count, [&] {
+        return static_cast<size_t>(tasks.update_status(id, server::TaskStatus::Working));
+    });
+
+    std::cout << "{\n  \"count\": " << count
+              << ",\n  \"ns_per_call\": {\n    \"gmtime_put_time\": " << put_time
+              << ",\n    \"write_iso8601\": " << write
+              << ",\n    \"format_iso8601\": " << format
+              << ",\n    \"task_update_status\": " << update << "\n  }\n}\n";
+    return 0;
+}
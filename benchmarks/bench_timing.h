@@ -0,0 +1,51 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+/**
+ * @file bench_timing.h
+ * @brief Per-call timing helpers shared by the microbenchmarks
+ */
+
+#ifndef MCPP_BENCHMARKS_BENCH_TIMING_H
+#define MCPP_BENCHMARKS_BENCH_TIMING_H
+
+#include <chrono>
+#include <cstddef>
+
+namespace mcpp::bench {
+
+/**
+ * @brief Make the compiler assume value is read, so the code producing it
+ * cannot be dropped or hoisted out of the timed loop
+ */
+template<typename T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * @brief Average wall time of f() over count calls, in nanoseconds
+ *
+ * Every result of f() is passed through do_not_optimize().
+ */
+template<typename F>
+double ns_per_call(size_t count, F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        do_not_optimize(f());
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(count);
+}
+
+} // namespace mcpp::bench
+
+#endif // MCPP_BENCHMARKS_BENCH_TIMING_H
@@ -0,0 +1,197 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+/**
+ * @file bench_websocket.cpp
+ * @brief Per-message round-trip latency: WebSocket vs. Streamable HTTP POST
+ *
+ * One client sends a small JSON-RPC request and waits for the echo, over
+ * (a) a WebSocket session in each negotiated encoding and (b) keep-alive
+ * HTTP POSTs to HttpServer. Reports p50/p99 round-trip time in
+ * microseconds. Output is JSON.
+ *
+ * Usage: bench_websocket [round_trips]
+ */
+
+#include "mcpp/transport/http_server.h"
+#include "mcpp/transport/websocket_server.h"
+#include "mcpp/transport/websocket_transport.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace mcpp::transport;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+const std::string kBody = "{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"tools/call\","
+                          "\"params\":{\"name\":\"echo\",\"arguments\":{\"text\":\"hello\"}}}";
+
+struct Percentiles {
+    double p50 = 0;
+    double p99 = 0;
+};
+
+Percentiles summarize(std::vector<double>& samples) {
+    if (samples.empty()) {
+        return {};
+    }
+    std::sort(samples.begin(), samples.end());
+    return {samples[samples.size() / 2], samples[samples.size() * 99 / 100]};
+}
+
+Percentiles bench_websocket(size_t round_trips, bool cbor) {
+    WebSocketServer::Options server_options;
+    server_options.transport.allow_cbor = cbor;
+    std::vector<std::unique_ptr<WebSocketTransport>> sessions;
+    WebSocketServer server(server_options);
+    server.start([&](std::unique_ptr<WebSocketTransport> transport) {
+        WebSocketTransport* raw = transport.get();
+        raw->set_message_callback([raw](std::string_view message) { raw->send(message); });
+        raw->connect();
+        sessions.push_back(std::move(transport));
+    });
+
+    WebSocketTransport::Options options;
+    options.allow_cbor = cbor;
+    std::string error;
+    auto client = WebSocketTransport::connect_to("127.0.0.1", server.port(), options, error);
+    if (!client) {
+        std::cerr << error << "\n";
+        return {};
+    }
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool received = false;
+    client->set_message_callback([&](std::string_view) {
+        std::lock_guard<std::mutex> lock(mutex);
+        received = true;
+        cv.notify_one();
+    });
+    client->connect();
+
+    std::vector<double> samples;
+    samples.reserve(round_trips);
+    for (size_t i = 0; i < round_trips; ++i) {
+        auto start = Clock::now();
+        client->send(kBody);
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] { return received; });
+        received = false;
+        samples.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+    }
+    client.reset();
+    server.stop();
+    return summarize(samples);
+}
+
+Percentiles bench_http(size_t round_trips) {
+    HttpServer::Options options;
+    options.shards = 1;
+    HttpServer server(options, [](size_t) {
+        return [](HttpServer::Session&, std::string_view body) -> std::optional<std::string> {
+            return std::string(body);
+        };
+    });
+    if (!server.start()) {
+        return {};
+    }
+
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(server.port());
+    ::inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        ::close(fd);
+        return {};
+    }
+    int one = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    auto round_trip = [&](const std::string& request, std::string* session) {
+        if (::write(fd, request.data(), request.size()) != static_cast<ssize_t>(request.size())) {
+            return false;
+        }
+        std::string buffer;
+        char chunk[4096];
+        while (true) {
+            size_t head_end = buffer.find("\r\n\r\n");
+            if (head_end != std::string::npos) {
+                size_t cl = buffer.find("Content-Length: ");
+                size_t length = cl < head_end ? std::strtoul(buffer.c_str() + cl + 16, nullptr, 10) : 0;
+                if (buffer.size() >= head_end + 4 + length) {
+                    size_t sid = buffer.find("Mcp-Session-Id: ");
+                    if (session != nullptr && sid != std::string::npos) {
+                        *session = buffer.substr(sid + 16, 32);
+                    }
+                    return true;
+                }
+            }
+            ssize_t n = ::read(fd, chunk, sizeof(chunk));
+            if (n <= 0) {
+                return false;
+            }
+            buffer.append(chunk, static_cast<size_t>(n));
+        }
+    };
+    auto post = [](const std::string& session, std::string_view body = kBody) {
+        std::string req = "POST /mcp HTTP/1.1\r\nHost: localhost\r\n";
+        if (!session.empty()) {
+            req += "Mcp-Session-Id: " + session + "\r\n";
+        }
+        return req + "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n" + std::string(body);
+    };
+
+    std::string session;
+    round_trip(post("", "{\"jsonrpc\":\"2.0\",\"id\":0,\"method\":\"initialize\"}"), &session);
+    const std::string request = post(session);
+
+    std::vector<double> samples;
+    samples.reserve(round_trips);
+    for (size_t i = 0; i < round_trips; ++i) {
+        auto start = Clock::now();
+        if (!round_trip(request, nullptr)) {
+            break;
+        }
+        samples.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+    }
+    ::close(fd);
+    server.stop();
+    return summarize(samples);
+}
+
+void print(const char* name, const Percentiles& p, bool last) {
+    std::cout << "    {\"transport\": \"" << name << "\", \"p50_us\": " << p.p50
+              << ", \"p99_us\": " << p.p99 << "}" << (last ? "\n" : ",\n");
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    size_t round_trips = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000;
+
+    std::cout << "{\n  \"round_trips\": " << round_trips << ",\n  \"runs\": [\n";
+    print("websocket_text", bench_websocket(round_trips, false), false);
+    print("websocket_cbor", bench_websocket(round_trips, true), false);
+    print("http_post", bench_http(round_trips), true);
+    std::cout << "  ]\n}\n";
+    return 0;
+}
@@ -0,0 +1,211 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+/**
+ * @file capture_replay.cpp
+ * @brief Replays a transport capture against a stdio MCP server
+ *
+ * Usage:
+ *   capture_replay <capture-file> --list
+ *   capture_replay <capture-file> [options] -- <server-command> [args...]
+ *
+ * Options:
+ *   --session N      Session to replay (default: 0)
+ *   --fast           Send frames back-to-back instead of with original timing
+ *   --speed X        Timing multiplier with original timing (default: 1.0)
+ *   --client         Capture was taken on the client (replay outbound frames)
+ *   --ignore PTR     JSON pointer to drop before comparing (repeatable)
+ *   --timeout MS     Wait for outstanding responses (default: 5000)
+ *
+ * The server is spawned with its stdin/stdout connected to pipes. The
+ * recorded requests are written to its stdin and its responses are
+ * compared with the recorded ones. Prints a JSON report; exits non-zero
+ * if any response differs or is missing.
+ *
+ * Captures are produced by wrapping a transport in CaptureTransport.
+ */
+
+#include "mcpp/transport/capture_replay.h"
+#include "mcpp/transport/capture_transport.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace mcpp::transport;
+
+namespace {
+
+int usage() {
+    std::cerr << "usage: capture_replay <capture-file> --list\n"
+              << "       capture_replay <capture-file> [--session N] [--fast] [--speed X]\n"
+              << "                      [--client] [--ignore PTR]... [--timeout MS]\n"
+              << "                      -- <server-command> [args...]\n";
+    return 2;
+}
+
+/// Child process with stdin/stdout pipes
+struct Child {
+    pid_t pid = -1;
+    int in_fd = -1;   // write end, child's stdin
+    int out_fd = -1;  // read end, child's stdout
+};
+
+bool spawn(const std::vector<std::string>& argv, Child& child) {
+    int to_child[2];
+    int from_child[2];
+    if (pipe(to_child) != 0 || pipe(from_child) != 0) {
+        return false;
+    }
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        return false;
+    }
+    if (pid == 0) {
+        dup2(to_child[0], STDIN_FILENO);
+        dup2(from_child[1], STDOUT_FILENO);
+        close(to_child[0]);
+        close(to_child[1]);
+        close(from_child[0]);
+        close(from_child[1]);
+
+        std::vector<char*> args;
+        for (const auto& a : argv) {
+            args.push_back(const_cast<char*>(a.c_str()));
+        }
+        args.push_back(nullptr);
+        execvp(args[0], args.data());
+        _exit(127);
+    }
+
+    close(to_child[0]);
+    close(from_child[1]);
+    child.pid = pid;
+    child.in_fd = to_child[1];
+    child.out_fd = from_child[0];
+    return true;
+}
+
+bool write_all(int fd, std::string_view data) {
+    while (!data.empty()) {
+        ssize_t n = write(fd, data.data(), data.size());
+        if (n <= 0) {
+            return false;
+        }
+        data.remove_prefix(static_cast<size_t>(n));
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        return usage();
+    }
+
+    std::string path = argv[1];
+    uint32_t session = 0;
+    bool list = false;
+    ReplayOptions options;
+    std::vector<std::string> command;
+
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--list") {
+            list = true;
+        } else if (arg == "--session" && i + 1 < argc) {
+            session = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--fast") {
+            options.original_timing = false;
+        } else if (arg == "--speed" && i + 1 < argc) {
+            options.speed = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--client") {
+            options.requests = CaptureDirection::Outbound;
+        } else if (arg == "--ignore" && i + 1 < argc) {
+            options.ignore_paths.emplace_back(argv[++i]);
+        } else if (arg == "--timeout" && i + 1 < argc) {
+            options.response_timeout = std::chrono::milliseconds(std::strtol(argv[++i], nullptr, 10));
+        } else if (arg == "--") {
+            command.assign(argv + i + 1, argv + argc);
+            break;
+        } else {
+            return usage();
+        }
+    }
+
+    CaptureReader reader;
+    std::string error;
+    if (!reader.open(path, error)) {
+        std::cerr << error << std::endl;
+        return 1;
+    }
+
+    if (list) {
+        nlohmann::json sessions = nlohmann::json::array();
+        for (const auto& s : reader.sessions()) {
+            sessions.push_back({{"id", s.id}, {"label", s.label},
+                                {"startMs", static_cast<double>(s.start_ns) / 1e6},
+                                {"frames", s.frame_count}});
+        }
+        std::cout << sessions.dump(2) << std::endl;
+        return 0;
+    }
+
+    if (command.empty()) {
+        return usage();
+    }
+
+    signal(SIGPIPE, SIG_IGN);
+    Child child;
+    if (!spawn(command, child)) {
+        std::cerr << "Failed to spawn " << command[0] << std::endl;
+        return 1;
+    }
+
+    CaptureReplayer replayer(reader.read_session(session), options);
+
+    // Read newline-delimited responses from the server
+    std::thread reader_thread([&]() {
+        std::string buffer;
+        char chunk[4096];
+        for (;;) {
+            ssize_t n = read(child.out_fd, chunk, sizeof(chunk));
+            if (n <= 0) {
+                break;
+            }
+            buffer.append(chunk, static_cast<size_t>(n));
+            size_t pos;
+            while ((pos = buffer.find('\n')) != std::string::npos) {
+                if (pos > 0) {
+                    replayer.on_response(std::string_view(buffer.data(), pos));
+                }
+                buffer.erase(0, pos + 1);
+            }
+        }
+    });
+
+    auto report = replayer.run([&](std::string_view frame) {
+        return write_all(child.in_fd, frame) && write_all(child.in_fd, "\n");
+    });
+
+    close(child.in_fd);
+    kill(child.pid, SIGTERM);
+    waitpid(child.pid, nullptr, 0);
+    reader_thread.join();
+    close(child.out_fd);
+
+    std::cout << report.to_json().dump(2) << std::endl;
+    return report.ok() ? 0 : 1;
+}
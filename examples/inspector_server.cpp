@@ -549,10 +549,10 @@ int main(int argc, char* argv[]) {
         // Use Phase 8 validation layer - validates full JSON-RPC 2.0 structure
         if (auto parsed = mcpp::core::JsonRpcRequest::from_json(raw)) {
             // Valid JSON-RPC request - process with server
-            std::optional<json> response = server.handle_request(raw);
+            std::optional<std::string> response = server.handle_request_serialized(raw);
             if (response.has_value()) {
                 // Send response in the same format as the request
-                std::string response_str = response->dump();
+                const std::string& response_str = *response;
                 if (uses_content_length) {
                     std::cout << "Content-Length: " << response_str.size() << "\r\n\r\n" << response_str << std::flush;
                 } else {
@@ -39,6 +39,7 @@
 #include "mcpp/api/service.h"
 #include "mcpp/core/error.h"
 #include "mcpp/util/atomic_id.h"
+#include "mcpp/util/concurrency.h"
 
 namespace mcpp::api {
 
@@ -237,10 +238,22 @@ public:
      * Blocks until at least one message is available or the stop token
      * is requested. Used by the event loop to wait for work.
      *
+     * In MCPP_SINGLE_THREADED builds nothing else can enqueue while this
+     * thread waits, so it drains whatever is queued and returns instead
+     * of blocking.
+     *
      * @param token Stop token for cancellation
      * @return true if messages were processed, false if stopped
      */
     bool wait_and_process(std::stop_token token) {
+        if constexpr (util::SINGLE_THREADED) {
+            if (token.stop_requested()) {
+                return false;
+            }
+            process_messages();
+            return true;
+        }
+
         std::unique_lock lock(queue_mutex_);
 
         // Wait for messages or stop request
@@ -357,7 +370,7 @@ protected:
     std::optional<PeerInfo> peer_info_;
 
     /// Mutex protecting message_queue_
-    mutable std::mutex queue_mutex_;
+    mutable util::Mutex queue_mutex_{"api.peer.queue"};
 
     /// Condition variable for blocking wait on empty queue
     std::condition_variable_any queue_cv_;
@@ -0,0 +1,473 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mcpp/async/io_uring.h"
+
+#include <algorithm>
+#include <cerrno>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define MCPP_HAVE_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <csignal>
+#include <cstring>
+#endif
+
+namespace mcpp::async {
+
+#ifdef MCPP_HAVE_IO_URING
+
+struct IoUring::Sqe : io_uring_sqe {};
+
+namespace {
+
+// The ring indices are shared with the kernel: loads of indices it writes
+// need acquire, stores of indices it reads need release.
+unsigned load_acquire(unsigned* p) {
+    return std::atomic_ref<unsigned>(*p).load(std::memory_order_acquire);
+}
+
+void store_release(unsigned* p, unsigned value) {
+    std::atomic_ref<unsigned>(*p).store(value, std::memory_order_release);
+}
+
+int sys_setup(unsigned entries, io_uring_params* p) {
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, p));
+}
+
+int sys_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags,
+              const void* arg, size_t arg_size) {
+    return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags,
+                                      arg, arg_size));
+}
+
+int sys_register(int fd, unsigned opcode, const void* arg, unsigned nr_args) {
+    return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+void* map_ring(int fd, size_t size, off_t offset) {
+    void* p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, offset);
+    return p == MAP_FAILED ? nullptr : p;
+}
+
+} // namespace
+
+bool IoUring::supported() {
+    static const bool result = [] {
+        io_uring_params p{};
+        int fd = sys_setup(4, &p);
+        if (fd < 0) {
+            return false;
+        }
+        ::close(fd);
+        // EXT_ARG (5.11) gives submit_and_wait a timeout without a timeout SQE
+        return (p.features & IORING_FEAT_EXT_ARG) != 0;
+    }();
+    return result;
+}
+
+IoUring::IoUring(const Params& params) : params_(params) {
+    io_uring_params p{};
+    if (params.sq_poll) {
+        p.flags |= IORING_SETUP_SQPOLL;
+        p.sq_thread_idle = static_cast<uint32_t>(params.sq_poll_idle.count());
+    }
+    int fd = sys_setup(params.entries, &p);
+    if (fd < 0) {
+        return;
+    }
+    features_ = p.features;
+
+    sq_ring_size_ = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    cq_ring_size_ = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+    if (features_ & IORING_FEAT_SINGLE_MMAP) {
+        sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+    }
+    sq_ring_ = map_ring(fd, sq_ring_size_, IORING_OFF_SQ_RING);
+    if (sq_ring_ == nullptr) {
+        ::close(fd);
+        return;
+    }
+    if (features_ & IORING_FEAT_SINGLE_MMAP) {
+        cq_ring_ = sq_ring_;
+    } else {
+        cq_ring_ = map_ring(fd, cq_ring_size_, IORING_OFF_CQ_RING);
+        if (cq_ring_ == nullptr) {
+            ::munmap(sq_ring_, sq_ring_size_);
+            sq_ring_ = nullptr;
+            ::close(fd);
+            return;
+        }
+    }
+    sqes_size_ = p.sq_entries * sizeof(io_uring_sqe);
+    sqes_ = map_ring(fd, sqes_size_, IORING_OFF_SQES);
+    if (sqes_ == nullptr) {
+        if (cq_ring_ != sq_ring_) {
+            ::munmap(cq_ring_, cq_ring_size_);
+        }
+        ::munmap(sq_ring_, sq_ring_size_);
+        sq_ring_ = cq_ring_ = nullptr;
+        ::close(fd);
+        return;
+    }
+
+    auto* sq = static_cast<char*>(sq_ring_);
+    sq_head_ = reinterpret_cast<unsigned*>(sq + p.sq_off.head);
+    sq_tail_ = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+    sq_flags_ = reinterpret_cast<unsigned*>(sq + p.sq_off.flags);
+    sq_array_ = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+    sq_mask_ = *reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+    sq_entries_ = p.sq_entries;
+    // SQEs are always filled in ring order, so the indirection array is
+    // the identity and never needs touching again
+    for (unsigned i = 0; i < sq_entries_; ++i) {
+        sq_array_[i] = i;
+    }
+    sqe_head_ = sqe_tail_ = *sq_tail_;
+
+    auto* cq = static_cast<char*>(cq_ring_);
+    cq_head_ = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+    cqes_ = cq + p.cq_off.cqes;
+
+    ring_fd_ = fd;
+}
+
+IoUring::~IoUring() {
+    if (buf_ring_ != nullptr) {
+        io_uring_buf_reg reg{};
+        reg.bgid = 0;
+        sys_register(ring_fd_, IORING_UNREGISTER_PBUF_RING, &reg, 1);
+        ::munmap(buf_ring_, buf_ring_size_);
+        ::munmap(buf_data_, buf_data_size_);
+    }
+    if (ring_fd_ < 0) {
+        return;
+    }
+    ::munmap(sqes_, sqes_size_);
+    if (cq_ring_ != sq_ring_) {
+        ::munmap(cq_ring_, cq_ring_size_);
+    }
+    ::munmap(sq_ring_, sq_ring_size_);
+    ::close(ring_fd_);
+}
+
+size_t IoUring::sq_space() const {
+    return sq_entries_ - (sqe_tail_ - load_acquire(sq_head_));
+}
+
+IoUring::Sqe* IoUring::next_sqe() {
+    if (!valid()) {
+        return nullptr;
+    }
+    if (sq_space() == 0) {
+        // Ring full: hand what we have to the kernel and try once more
+        submit();
+        if (sq_space() == 0) {
+            return nullptr;
+        }
+    }
+    auto* sqe = static_cast<Sqe*>(sqes_) + (sqe_tail_ & sq_mask_);
+    std::memset(sqe, 0, sizeof(*sqe));
+    ++sqe_tail_;
+    return sqe;
+}
+
+void IoUring::flush_sq() {
+    if (sqe_head_ != sqe_tail_) {
+        store_release(sq_tail_, sqe_tail_);
+        sqe_head_ = sqe_tail_;
+    }
+}
+
+int IoUring::enter(unsigned to_submit, unsigned min_complete, unsigned flags,
+                   const void* arg, size_t arg_size) {
+    ++enter_calls_;
+    int r;
+    do {
+        r = sys_enter(ring_fd_, to_submit, min_complete, flags, arg, arg_size);
+    } while (r < 0 && errno == EINTR && arg == nullptr);
+    return r < 0 ? -errno : r;
+}
+
+bool IoUring::prep_poll(int fd, uint32_t poll_mask, uint64_t user_data) {
+    Sqe* sqe = next_sqe();
+    if (sqe == nullptr) {
+        return false;
+    }
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = fd;
+    sqe->poll32_events = poll_mask;
+    sqe->user_data = user_data;
+    return true;
+}
+
+bool IoUring::prep_poll_remove(uint64_t target, uint64_t user_data) {
+    Sqe* sqe = next_sqe();
+    if (sqe == nullptr) {
+        return false;
+    }
+    sqe->opcode = IORING_OP_POLL_REMOVE;
+    sqe->fd = -1;
+    sqe->addr = target;
+    sqe->user_data = user_data;
+    return true;
+}
+
+bool IoUring::prep_cancel(uint64_t target, uint64_t user_data) {
+    Sqe* sqe = next_sqe();
+    if (sqe == nullptr) {
+        return false;
+    }
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = target;
+    sqe->user_data = user_data;
+    return true;
+}
+
+bool IoUring::prep_cancel_all(uint64_t user_data) {
+    Sqe* sqe = next_sqe();
+    if (sqe == nullptr) {
+        return false;
+    }
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->cancel_flags = IORING_ASYNC_CANCEL_ANY;
+    sqe->user_data = user_data;
+    return true;
+}
+
+bool IoUring::prep_recv_multishot(int fd, uint64_t user_data) {
+    if (!has_buffers()) {
+        return false;
+    }
+    Sqe* sqe = next_sqe();
+    if (sqe == nullptr) {
+        return false;
+    }
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = fd;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = 0;
+    sqe->user_data = user_data;
+    return true;
+}
+
+bool IoUring::prep_writev(int fd, const iovec* iov, unsigned count, bool link, uint64_t user_data) {
+    Sqe* sqe = next_sqe();
+    if (sqe == nullptr) {
+        return false;
+    }
+    sqe->opcode = IORING_OP_WRITEV;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(iov);
+    sqe->len = count;
+    sqe->off = static_cast<uint64_t>(-1);  // current position; ignored for pipes/sockets
+    sqe->flags = link ? IOSQE_IO_LINK : 0;
+    sqe->user_data = user_data;
+    return true;
+}
+
+int IoUring::submit() {
+    if (!valid()) {
+        return -EBADF;
+    }
+    flush_sq();
+    if (params_.sq_poll) {
+        // The poller thread picks entries up on its own; only kick it if it
+        // has gone to sleep
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (std::atomic_ref<unsigned>(*sq_flags_).load(std::memory_order_relaxed) & IORING_SQ_NEED_WAKEUP) {
+            return enter(0, 0, IORING_ENTER_SQ_WAKEUP, nullptr, 0);
+        }
+        return 0;
+    }
+    unsigned pending = *sq_tail_ - load_acquire(sq_head_);
+    if (pending == 0) {
+        return 0;
+    }
+    return enter(pending, 0, 0, nullptr, 0);
+}
+
+int IoUring::submit_and_wait(std::chrono::nanoseconds timeout) {
+    if (!valid()) {
+        return -EBADF;
+    }
+    flush_sq();
+    unsigned pending = params_.sq_poll ? 0 : *sq_tail_ - load_acquire(sq_head_);
+    unsigned flags = IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG;
+    if (params_.sq_poll) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (std::atomic_ref<unsigned>(*sq_flags_).load(std::memory_order_relaxed) & IORING_SQ_NEED_WAKEUP) {
+            flags |= IORING_ENTER_SQ_WAKEUP;
+        }
+    }
+    bool cq_ready = load_acquire(cq_tail_) != *cq_head_;
+    if (cq_ready || timeout <= std::chrono::nanoseconds::zero()) {
+        // Nothing to wait for: only enter if there is something to submit
+        if (pending == 0 && !(flags & IORING_ENTER_SQ_WAKEUP)) {
+            return 0;
+        }
+        return enter(pending, 0, flags & ~IORING_ENTER_GETEVENTS & ~IORING_ENTER_EXT_ARG, nullptr, 0);
+    }
+
+    __kernel_timespec ts{};
+    ts.tv_sec = std::chrono::duration_cast<std::chrono::seconds>(timeout).count();
+    ts.tv_nsec = (timeout - std::chrono::seconds(ts.tv_sec)).count();
+    io_uring_getevents_arg arg{};
+    arg.sigmask = 0;
+    arg.sigmask_sz = _NSIG / 8;
+    arg.ts = reinterpret_cast<uint64_t>(&ts);
+    return enter(pending, 1, flags, &arg, sizeof(arg));
+}
+
+size_t IoUring::reap(std::vector<Completion>& out) {
+    if (!valid()) {
+        return 0;
+    }
+    unsigned head = *cq_head_;
+    unsigned tail = load_acquire(cq_tail_);
+    auto* cqes = static_cast<io_uring_cqe*>(cqes_);
+    for (unsigned i = head; i != tail; ++i) {
+        const io_uring_cqe& cqe = cqes[i & cq_mask_];
+        out.push_back(Completion{cqe.user_data, cqe.res, cqe.flags});
+    }
+    store_release(cq_head_, tail);
+    return tail - head;
+}
+
+bool IoUring::setup_buffers(unsigned count, unsigned size) {
+    if (!valid() || has_buffers() || count == 0 || (count & (count - 1)) != 0 || count > 32768) {
+        return false;
+    }
+    size_t ring_size = count * sizeof(io_uring_buf);
+    void* ring = ::mmap(nullptr, ring_size, PROT_READ | PROT_WRITE,
+                        MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+    if (ring == MAP_FAILED) {
+        return false;
+    }
+    size_t data_size = static_cast<size_t>(count) * size;
+    void* data = ::mmap(nullptr, data_size, PROT_READ | PROT_WRITE,
+                        MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+    if (data == MAP_FAILED) {
+        ::munmap(ring, ring_size);
+        return false;
+    }
+
+    io_uring_buf_reg reg{};
+    reg.ring_addr = reinterpret_cast<uint64_t>(ring);
+    reg.ring_entries = count;
+    reg.bgid = 0;
+    if (sys_register(ring_fd_, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+        ::munmap(data, data_size);
+        ::munmap(ring, ring_size);
+        return false;
+    }
+
+    buf_ring_ = ring;
+    buf_ring_size_ = ring_size;
+    buf_data_ = static_cast<char*>(data);
+    buf_data_size_ = data_size;
+    buf_count_ = count;
+    buf_size_ = size;
+    buf_tail_ = 0;
+    for (unsigned i = 0; i < count; ++i) {
+        recycle(static_cast<int>(i));
+    }
+    return true;
+}
+
+int IoUring::buffer_id(uint32_t flags) {
+    if (!(flags & IORING_CQE_F_BUFFER)) {
+        return -1;
+    }
+    return static_cast<int>(flags >> IORING_CQE_BUFFER_SHIFT);
+}
+
+bool IoUring::has_more(uint32_t flags) {
+    return (flags & IORING_CQE_F_MORE) != 0;
+}
+
+std::string_view IoUring::buffer(int id, size_t len) const {
+    if (id < 0 || static_cast<unsigned>(id) >= buf_count_) {
+        return {};
+    }
+    return std::string_view(buf_data_ + static_cast<size_t>(id) * buf_size_,
+                            std::min<size_t>(len, buf_size_));
+}
+
+void IoUring::recycle(int id) {
+    if (buf_ring_ == nullptr || id < 0 || static_cast<unsigned>(id) >= buf_count_) {
+        return;
+    }
+    // Index the ring by hand: compiled as C++, the uapi header's
+    // __DECLARE_FLEX_ARRAY places io_uring_buf_ring::bufs at offset 8
+    // rather than 0. The tail overlays bufs[0].resv.
+    auto* bufs = static_cast<io_uring_buf*>(buf_ring_);
+    io_uring_buf& buf = bufs[buf_tail_ & (buf_count_ - 1)];
+    buf.addr = reinterpret_cast<uint64_t>(buf_data_ + static_cast<size_t>(id) * buf_size_);
+    buf.len = buf_size_;
+    buf.bid = static_cast<uint16_t>(id);
+    ++buf_tail_;
+    std::atomic_ref<uint16_t>(bufs[0].resv).store(buf_tail_, std::memory_order_release);
+}
+
+#else  // !MCPP_HAVE_IO_URING
+
+struct IoUring::Sqe {};
+
+bool IoUring::supported() { return false; }
+IoUring::IoUring(const Params& params) : params_(params) {}
+IoUring::~IoUring() = default;
+size_t IoUring::sq_space() const { return 0; }
+IoUring::Sqe* IoUring::next_sqe() { return nullptr; }
+void IoUring::flush_sq() {}
+int IoUring::enter(unsigned, unsigned, unsigned, const void*, size_t) { return -ENOSYS; }
+bool IoUring::prep_poll(int, uint32_t, uint64_t) { return false; }
+bool IoUring::prep_poll_remove(uint64_t, uint64_t) { return false; }
+bool IoUring::prep_cancel(uint64_t, uint64_t) { return false; }
+bool IoUring::prep_cancel_all(uint64_t) { return false; }
+bool IoUring::prep_recv_multishot(int, uint64_t) { return false; }
+bool IoUring::prep_writev(int, const iovec*, unsigned, bool, uint64_t) { return false; }
+int IoUring::submit() { return -ENOSYS; }
+int IoUring::submit_and_wait(std::chrono::nanoseconds) { return -ENOSYS; }
+size_t IoUring::reap(std::vector<Completion>&) { return 0; }
+bool IoUring::setup_buffers(unsigned, unsigned) { return false; }
+int IoUring::buffer_id(uint32_t) { return -1; }
+bool IoUring::has_more(uint32_t) { return false; }
+std::string_view IoUring::buffer(int, size_t) const { return {}; }
+void IoUring::recycle(int) {}
+
+#endif  // MCPP_HAVE_IO_URING
+
+} // namespace mcpp::async
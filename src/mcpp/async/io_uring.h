@@ -0,0 +1,227 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef MCPP_ASYNC_IO_URING_H
+#define MCPP_ASYNC_IO_URING_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+struct iovec;
+
+namespace mcpp::async {
+
+/**
+ * @brief Minimal io_uring ring driven through raw syscalls
+ *
+ * Wraps io_uring_setup/enter/register without liburing: maps the SQ/CQ
+ * rings, prepares the handful of operations the Reactor needs (poll,
+ * multishot recv, linked writes, cancel), and manages one provided
+ * buffer ring for multishot receives.
+ *
+ * Submission is batched: prep_*() only fills SQEs; nothing reaches the
+ * kernel until submit() or submit_and_wait(), which issue a single
+ * io_uring_enter for everything prepared since the last call. With
+ * Params::sq_poll a kernel thread consumes the SQ and the enter is
+ * skipped entirely unless that thread has gone idle.
+ *
+ * Used by async::Reactor when constructed with Backend::IoUring; most
+ * code should go through the Reactor rather than use this directly.
+ *
+ * Thread safety: Not thread-safe; owned by one reactor thread.
+ */
+class IoUring {
+public:
+    /// Ring setup parameters
+    struct Params {
+        /// Submission queue entries (rounded up to a power of two by the kernel)
+        unsigned entries = 256;
+        /// Let a kernel thread poll the SQ (IORING_SETUP_SQPOLL)
+        bool sq_poll = false;
+        /// Idle time before the SQ poll thread sleeps
+        std::chrono::milliseconds sq_poll_idle{1000};
+    };
+
+    /// One reaped completion
+    struct Completion {
+        uint64_t user_data;
+        int32_t res;
+        uint32_t flags;
+    };
+
+    /**
+     * @brief Whether this kernel supports everything IoUring relies on
+     *
+     * Probes once (io_uring_setup plus IORING_FEAT_EXT_ARG) and caches the
+     * answer. False on non-Linux builds, old kernels, or when io_uring is
+     * disabled by sysctl or seccomp.
+     */
+    static bool supported();
+
+    /// Create the ring; check valid() afterwards
+    explicit IoUring(const Params& params);
+
+    /// Unmap the rings and close the ring descriptor
+    ~IoUring();
+
+    // Non-copyable, non-movable (kernel-shared memory)
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+    IoUring(IoUring&&) = delete;
+    IoUring& operator=(IoUring&&) = delete;
+
+    /// @return true if the ring was created and mapped
+    bool valid() const { return ring_fd_ >= 0; }
+
+    /// @return Free submission slots not yet prepared
+    size_t sq_space() const;
+
+    /// One-shot poll for @p poll_mask (POLLIN/POLLOUT/...)
+    bool prep_poll(int fd, uint32_t poll_mask, uint64_t user_data);
+
+    /// Remove a pending poll identified by its user_data
+    bool prep_poll_remove(uint64_t target, uint64_t user_data);
+
+    /// Cancel a pending request identified by its user_data
+    bool prep_cancel(uint64_t target, uint64_t user_data);
+
+    /// Cancel every pending request
+    bool prep_cancel_all(uint64_t user_data);
+
+    /// Multishot recv into the provided buffer ring (requires setup_buffers())
+    bool prep_recv_multishot(int fd, uint64_t user_data);
+
+    /**
+     * @brief Gather-write @p count iovecs at the current file position
+     *
+     * The iovec array must stay valid until the completion is reaped.
+     *
+     * @param link Set IOSQE_IO_LINK so the next prepared SQE starts only
+     *             after this one completes in full
+     */
+    bool prep_writev(int fd, const iovec* iov, unsigned count, bool link, uint64_t user_data);
+
+    /**
+     * @brief Submit prepared SQEs without waiting
+     *
+     * @return Number submitted, or -errno
+     */
+    int submit();
+
+    /**
+     * @brief Submit prepared SQEs and wait for at least one completion
+     *
+     * @param timeout Upper bound on the wait; zero polls
+     * @return Number submitted, or -errno (-ETIME on timeout is normal)
+     */
+    int submit_and_wait(std::chrono::nanoseconds timeout);
+
+    /**
+     * @brief Move all available completions into @p out
+     *
+     * @return Number of completions appended
+     */
+    size_t reap(std::vector<Completion>& out);
+
+    /**
+     * @brief Register the provided buffer ring used by multishot recv
+     *
+     * @param count Number of buffers (power of two)
+     * @param size Bytes per buffer
+     * @return false if the kernel lacks IORING_REGISTER_PBUF_RING (< 5.19)
+     */
+    bool setup_buffers(unsigned count, unsigned size);
+
+    /// @return true once setup_buffers() has succeeded
+    bool has_buffers() const { return buf_ring_ != nullptr; }
+
+    /**
+     * @brief Provided buffer a completion was received into
+     *
+     * @return Buffer id, or -1 if the completion carries no buffer
+     */
+    static int buffer_id(uint32_t flags);
+
+    /// @return true if the request will post further completions
+    static bool has_more(uint32_t flags);
+
+    /// Bytes of buffer @p id as filled by a completion of @p len bytes
+    std::string_view buffer(int id, size_t len) const;
+
+    /// Return buffer @p id to the kernel after its data has been consumed
+    void recycle(int id);
+
+    /// @return Number of io_uring_enter calls made so far
+    uint64_t enter_calls() const { return enter_calls_; }
+
+private:
+    struct Sqe;
+    Sqe* next_sqe();
+    void flush_sq();
+    int enter(unsigned to_submit, unsigned min_complete, unsigned flags, const void* arg, size_t arg_size);
+
+    Params params_;
+    int ring_fd_ = -1;
+    uint32_t features_ = 0;
+
+    // Submission queue (pointers into the shared mapping)
+    void* sq_ring_ = nullptr;
+    size_t sq_ring_size_ = 0;
+    unsigned* sq_head_ = nullptr;
+    unsigned* sq_tail_ = nullptr;
+    unsigned* sq_flags_ = nullptr;
+    unsigned* sq_array_ = nullptr;
+    unsigned sq_mask_ = 0;
+    unsigned sq_entries_ = 0;
+    void* sqes_ = nullptr;
+    size_t sqes_size_ = 0;
+    unsigned sqe_head_ = 0;   ///< First SQE not yet published to the kernel
+    unsigned sqe_tail_ = 0;   ///< One past the last prepared SQE
+
+    // Completion queue
+    void* cq_ring_ = nullptr;
+    size_t cq_ring_size_ = 0;
+    unsigned* cq_head_ = nullptr;
+    unsigned* cq_tail_ = nullptr;
+    unsigned cq_mask_ = 0;
+    void* cqes_ = nullptr;
+
+    // Provided buffer ring (group 0)
+    void* buf_ring_ = nullptr;
+    size_t buf_ring_size_ = 0;
+    char* buf_data_ = nullptr;
+    size_t buf_data_size_ = 0;
+    unsigned buf_count_ = 0;
+    unsigned buf_size_ = 0;
+    uint16_t buf_tail_ = 0;
+
+    uint64_t enter_calls_ = 0;
+};
+
+} // namespace mcpp::async
+
+#endif // MCPP_ASYNC_IO_URING_H
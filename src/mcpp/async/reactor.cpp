@@ -0,0 +1,673 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mcpp/async/reactor.h"
+
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <utility>
+
+namespace mcpp::async {
+
+namespace {
+
+constexpr int MAX_EVENTS = 64;
+
+/// io_uring user_data of the wake eventfd poll
+constexpr uint64_t WAKE_OP = 1;
+
+/// Buffers gathered into one writev SQE
+constexpr size_t MAX_IOVECS_PER_WRITE = 64;
+
+/// Longest IOSQE_IO_LINK chain submitted at once; longer write_chain()
+/// calls continue in further chains as earlier ones complete
+constexpr size_t MAX_LINKED_WRITES = 16;
+
+uint32_t to_epoll(uint32_t interest) {
+    uint32_t events = 0;
+    if (interest & Reactor::Readable) events |= EPOLLIN;
+    if (interest & Reactor::Writable) events |= EPOLLOUT;
+    return events;
+}
+
+uint32_t from_epoll(uint32_t events) {
+    uint32_t result = 0;
+    if (events & (EPOLLIN | EPOLLPRI)) result |= Reactor::Readable;
+    if (events & EPOLLOUT) result |= Reactor::Writable;
+    if (events & (EPOLLHUP | EPOLLERR | EPOLLRDHUP)) result |= Reactor::Closed;
+    return result;
+}
+
+uint32_t to_poll(uint32_t interest) {
+    uint32_t events = POLLRDHUP;
+    if (interest & Reactor::Readable) events |= POLLIN;
+    if (interest & Reactor::Writable) events |= POLLOUT;
+    return events;
+}
+
+uint32_t from_poll(uint32_t events) {
+    uint32_t result = 0;
+    if (events & (POLLIN | POLLPRI)) result |= Reactor::Readable;
+    if (events & POLLOUT) result |= Reactor::Writable;
+    if (events & (POLLHUP | POLLERR | POLLRDHUP | POLLNVAL)) result |= Reactor::Closed;
+    return result;
+}
+
+} // namespace
+
+struct Reactor::WriteChain {
+    /// One writev SQE of the current submission
+    struct Segment {
+        std::vector<iovec> iov;
+        size_t bytes = 0;
+        size_t written = 0;
+    };
+
+    int fd = -1;
+    std::vector<util::SharedBuffer> buffers;
+    size_t next = 0;    ///< First buffer not yet fully written
+    size_t offset = 0;  ///< Bytes of buffers[next] already written
+    std::vector<Segment> segments;
+    WriteCallback done;
+    size_t inflight = 0;
+    int error = 0;
+    bool would_block = false;
+
+    /// Advance next/offset past @p bytes written
+    void consume(size_t bytes) {
+        while (bytes > 0 && next < buffers.size()) {
+            size_t left = buffers[next].size() - offset;
+            if (bytes < left) {
+                offset += bytes;
+                return;
+            }
+            bytes -= left;
+            ++next;
+            offset = 0;
+        }
+    }
+};
+
+Reactor::Reactor(std::shared_ptr<util::Clock> clock)
+    : Reactor(Options{}, std::move(clock)) {}
+
+Reactor::Reactor(const Options& options, std::shared_ptr<util::Clock> clock)
+    : clock_(clock ? std::move(clock) : util::Clock::system()) {
+    if (options.backend == Backend::IoUring && IoUring::supported() && init_io_uring(options)) {
+        return;
+    }
+    epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd_ < 0) {
+        return;
+    }
+    wake_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wake_fd_ < 0) {
+        ::close(epoll_fd_);
+        epoll_fd_ = -1;
+        return;
+    }
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = wake_fd_;
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &ev);
+}
+
+bool Reactor::init_io_uring(const Options& options) {
+    auto ring = std::make_unique<IoUring>(
+        IoUring::Params{options.ring_entries, options.sq_poll, options.sq_poll_idle});
+    if (!ring->valid()) {
+        return false;
+    }
+    wake_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wake_fd_ < 0) {
+        return false;
+    }
+    // Optional: without provided buffers (< 5.19) recv_multishot() is
+    // unavailable but readiness and writes still work
+    ring->setup_buffers(options.recv_buffer_count, options.recv_buffer_size);
+    ring_ = std::move(ring);
+    arm_wake();
+    ring_->submit();
+    return true;
+}
+
+Reactor::~Reactor() {
+    if (ring_) {
+        // The kernel may still reference buffers owned by in-flight writes;
+        // cancel everything and give the cancellations a moment to land
+        // before those buffers are released.
+        ring_->prep_cancel_all(0);
+        for (int i = 0; i < 10 && !ops_.empty(); ++i) {
+            ring_->submit_and_wait(std::chrono::milliseconds(5));
+            completions_.clear();
+            ring_->reap(completions_);
+            for (const auto& completion : completions_) {
+                if (!IoUring::has_more(completion.flags)) {
+                    ops_.erase(completion.user_data);
+                }
+            }
+        }
+        ring_.reset();
+    }
+    if (wake_fd_ >= 0) {
+        ::close(wake_fd_);
+    }
+    if (epoll_fd_ >= 0) {
+        ::close(epoll_fd_);
+    }
+}
+
+bool Reactor::add(int fd, uint32_t interest, IoCallback callback) {
+    if (!valid() || fd < 0 || handlers_.count(fd) != 0) {
+        return false;
+    }
+    if (ring_) {
+        auto it = handlers_.emplace(
+            fd, Handler{interest, std::make_shared<IoCallback>(std::move(callback))}).first;
+        if (!arm_poll(fd, it->second)) {
+            handlers_.erase(it);
+            return false;
+        }
+        return true;
+    }
+    epoll_event ev{};
+    ev.events = to_epoll(interest) | EPOLLRDHUP;
+    ev.data.fd = fd;
+    if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) != 0) {
+        return false;
+    }
+    handlers_.emplace(fd, Handler{interest, std::make_shared<IoCallback>(std::move(callback))});
+    return true;
+}
+
+bool Reactor::modify(int fd, uint32_t interest) {
+    auto it = handlers_.find(fd);
+    if (it == handlers_.end()) {
+        return false;
+    }
+    if (it->second.interest == interest) {
+        return true;
+    }
+    if (ring_) {
+        // Poll requests are one-shot; replace the armed one. If we are
+        // inside this fd's callback nothing is armed and the re-arm after
+        // dispatch picks up the new interest.
+        it->second.interest = interest;
+        if (it->second.poll_op != 0) {
+            ring_->prep_poll_remove(it->second.poll_op, 0);
+            ops_.erase(it->second.poll_op);
+            it->second.poll_op = 0;
+            return arm_poll(fd, it->second);
+        }
+        return true;
+    }
+    epoll_event ev{};
+    ev.events = to_epoll(interest) | EPOLLRDHUP;
+    ev.data.fd = fd;
+    if (::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd, &ev) != 0) {
+        return false;
+    }
+    it->second.interest = interest;
+    return true;
+}
+
+void Reactor::remove(int fd) {
+    auto it = handlers_.find(fd);
+    if (it == handlers_.end()) {
+        return;
+    }
+    if (ring_) {
+        if (it->second.poll_op != 0) {
+            ring_->prep_poll_remove(it->second.poll_op, 0);
+            ops_.erase(it->second.poll_op);
+        }
+    } else {
+        ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+    }
+    handlers_.erase(it);
+}
+
+bool Reactor::arm_poll(int fd, Handler& handler) {
+    OpId op = next_op_++;
+    if (!ring_->prep_poll(fd, to_poll(handler.interest), op)) {
+        return false;
+    }
+    ops_.emplace(op, Op{Op::Poll, fd, nullptr, nullptr, 0});
+    handler.poll_op = op;
+    return true;
+}
+
+void Reactor::arm_wake() {
+    ring_->prep_poll(wake_fd_, POLLIN, WAKE_OP);
+}
+
+bool Reactor::arm_recv(OpId op, int fd) {
+    return ring_->prep_recv_multishot(fd, op);
+}
+
+Reactor::OpId Reactor::recv_multishot(int fd, RecvCallback callback) {
+    if (!ring_ || !ring_->has_buffers() || fd < 0) {
+        return 0;
+    }
+    OpId op = next_op_++;
+    if (!arm_recv(op, fd)) {
+        return 0;
+    }
+    ops_.emplace(op, Op{Op::Recv, fd, std::make_shared<RecvCallback>(std::move(callback)), nullptr, 0});
+    return op;
+}
+
+void Reactor::cancel(OpId op) {
+    auto it = ops_.find(op);
+    if (it == ops_.end() || it->second.kind != Op::Recv) {
+        return;
+    }
+    // Completions still in flight find no entry and are dropped (their
+    // buffers are recycled in dispatch_completion)
+    ring_->prep_cancel(op, 0);
+    ops_.erase(it);
+}
+
+bool Reactor::write_chain(int fd, std::vector<util::SharedBuffer> buffers, WriteCallback done) {
+    if (!ring_ || fd < 0) {
+        return false;
+    }
+    auto chain = std::make_shared<WriteChain>();
+    chain->fd = fd;
+    chain->buffers = std::move(buffers);
+    chain->done = std::move(done);
+    submit_chain(chain);
+    return true;
+}
+
+void Reactor::submit_chain(const std::shared_ptr<WriteChain>& chain) {
+    chain->would_block = false;
+    chain->segments.clear();
+
+    // Gather the unwritten remainder into writev segments
+    size_t offset = chain->offset;
+    for (size_t i = chain->next; i < chain->buffers.size(); ++i) {
+        const auto& buffer = chain->buffers[i];
+        if (buffer.size() == offset) {
+            offset = 0;
+            continue;
+        }
+        if (chain->segments.empty() || chain->segments.back().iov.size() == MAX_IOVECS_PER_WRITE) {
+            if (chain->segments.size() == MAX_LINKED_WRITES) {
+                break;
+            }
+            chain->segments.emplace_back();
+        }
+        auto& segment = chain->segments.back();
+        segment.iov.push_back(iovec{const_cast<char*>(buffer.data()) + offset, buffer.size() - offset});
+        segment.bytes += buffer.size() - offset;
+        offset = 0;
+    }
+    if (chain->segments.empty()) {
+        auto done = std::move(chain->done);
+        defer([done = std::move(done)] {
+            if (done) {
+                done(0);
+            }
+        });
+        return;
+    }
+
+    // A chain must be prepared whole: a trailing IOSQE_IO_LINK would
+    // otherwise link to whatever unrelated SQE comes next
+    size_t count = chain->segments.size();
+    if (ring_->sq_space() < count) {
+        ring_->submit();
+        count = std::min(count, ring_->sq_space());
+        if (count == 0) {
+            chain->error = -EBUSY;
+            finish_write(chain);
+            return;
+        }
+        chain->segments.resize(count);
+    }
+    for (size_t k = 0; k < count; ++k) {
+        const auto& segment = chain->segments[k];
+        OpId op = next_op_++;
+        ops_.emplace(op, Op{Op::Write, chain->fd, nullptr, chain, k});
+        ring_->prep_writev(chain->fd, segment.iov.data(), static_cast<unsigned>(segment.iov.size()),
+                           k + 1 < count, op);
+    }
+    chain->inflight = count;
+}
+
+void Reactor::finish_write(const std::shared_ptr<WriteChain>& chain) {
+    // Links run in order and a short write cancels the rest, so the bytes
+    // written form a prefix of the submission
+    for (const auto& segment : chain->segments) {
+        chain->consume(segment.written);
+    }
+    chain->segments.clear();
+
+    if (chain->error == 0 && chain->would_block) {
+        // Non-blocking descriptor is full: wait for POLLOUT, then resume
+        OpId op = next_op_++;
+        if (ring_->prep_poll(chain->fd, POLLOUT, op)) {
+            ops_.emplace(op, Op{Op::WritePoll, chain->fd, nullptr, chain, 0});
+            return;
+        }
+        chain->error = -EBUSY;
+    }
+    if (chain->error != 0) {
+        auto done = std::move(chain->done);
+        if (done) {
+            done(chain->error);
+        }
+        return;
+    }
+    submit_chain(chain);
+}
+
+Reactor::TimerId Reactor::schedule(std::chrono::steady_clock::duration delay,
+                                   std::chrono::steady_clock::duration interval,
+                                   TimerCallback callback) {
+    TimerId id = next_timer_id_++;
+    timers_.emplace(id, Timer{interval, std::make_shared<TimerCallback>(std::move(callback))});
+    timer_heap_.push(TimerSlot{clock_->steady_now() + delay, id});
+    return id;
+}
+
+Reactor::TimerId Reactor::call_after(std::chrono::milliseconds delay, TimerCallback callback) {
+    return schedule(delay, std::chrono::steady_clock::duration::zero(), std::move(callback));
+}
+
+Reactor::TimerId Reactor::call_every(std::chrono::milliseconds interval, TimerCallback callback) {
+    return schedule(interval, std::max<std::chrono::steady_clock::duration>(
+                                  interval, std::chrono::milliseconds(1)),
+                    std::move(callback));
+}
+
+void Reactor::cancel_timer(TimerId id) {
+    // The heap entry stays behind and is discarded when it reaches the top
+    timers_.erase(id);
+}
+
+void Reactor::post(std::function<void()> fn) {
+    {
+        std::lock_guard<std::mutex> lock(post_mutex_);
+        posted_.push_back(std::move(fn));
+    }
+    wake();
+}
+
+void Reactor::stop() {
+    stopping_.store(true, std::memory_order_release);
+    wake();
+}
+
+void Reactor::wake() {
+    if (wake_fd_ >= 0) {
+        uint64_t one = 1;
+        [[maybe_unused]] auto n = ::write(wake_fd_, &one, sizeof(one));
+    }
+}
+
+size_t Reactor::run_due_timers() {
+    size_t fired = 0;
+    const auto now = clock_->steady_now();
+    while (!timer_heap_.empty() && timer_heap_.top().deadline <= now) {
+        TimerSlot slot = timer_heap_.top();
+        timer_heap_.pop();
+
+        auto it = timers_.find(slot.id);
+        if (it == timers_.end()) {
+            continue;  // cancelled
+        }
+        auto callback = it->second.callback;
+        if (it->second.interval > std::chrono::steady_clock::duration::zero()) {
+            // Re-arm from the scheduled deadline so periodic timers don't drift
+            timer_heap_.push(TimerSlot{std::max(slot.deadline + it->second.interval, now), slot.id});
+        } else {
+            timers_.erase(it);
+        }
+        (*callback)();
+        ++fired;
+    }
+    return fired;
+}
+
+size_t Reactor::run_posted() {
+    std::vector<std::function<void()>> batch;
+    {
+        std::lock_guard<std::mutex> lock(post_mutex_);
+        batch.swap(posted_);
+    }
+    for (auto& fn : batch) {
+        fn();
+    }
+    return batch.size();
+}
+
+void Reactor::defer(std::function<void()> fn) {
+    deferred_.push_back(std::move(fn));
+}
+
+size_t Reactor::run_deferred() {
+    size_t count = 0;
+    // Deferred functions may defer more; run until quiescent
+    while (!deferred_.empty()) {
+        std::vector<std::function<void()>> batch;
+        batch.swap(deferred_);
+        for (auto& fn : batch) {
+            fn();
+        }
+        count += batch.size();
+    }
+    return count;
+}
+
+size_t Reactor::dispatch_completion(const IoUring::Completion& completion) {
+    if (completion.user_data == 0) {
+        return 0;
+    }
+    if (completion.user_data == WAKE_OP) {
+        uint64_t value;
+        [[maybe_unused]] auto r = ::read(wake_fd_, &value, sizeof(value));
+        arm_wake();
+        return 0;
+    }
+
+    const OpId op = completion.user_data;
+    const int buffer_id = IoUring::buffer_id(completion.flags);
+    auto it = ops_.find(op);
+    if (it == ops_.end()) {
+        // Removed or cancelled; still return any buffer it consumed
+        ring_->recycle(buffer_id);
+        return 0;
+    }
+
+    switch (it->second.kind) {
+        case Op::Poll: {
+            int fd = it->second.fd;
+            ops_.erase(it);
+            auto handler = handlers_.find(fd);
+            if (handler == handlers_.end() || handler->second.poll_op != op) {
+                return 0;
+            }
+            handler->second.poll_op = 0;
+            uint32_t ready = completion.res < 0
+                ? static_cast<uint32_t>(Closed)
+                : from_poll(static_cast<uint32_t>(completion.res));
+            auto callback = handler->second.callback;
+            (*callback)(ready);
+            // Level-triggered semantics: re-arm unless the callback removed
+            // the fd or already re-armed it through modify()
+            handler = handlers_.find(fd);
+            if (handler != handlers_.end() && handler->second.poll_op == 0) {
+                arm_poll(fd, handler->second);
+            }
+            return 1;
+        }
+
+        case Op::Recv: {
+            int fd = it->second.fd;
+            auto callback = it->second.recv;
+            if (completion.res > 0) {
+                (*callback)(ring_->buffer(buffer_id, static_cast<size_t>(completion.res)),
+                            completion.res);
+                ring_->recycle(buffer_id);
+                if (!IoUring::has_more(completion.flags) && ops_.count(op) != 0) {
+                    arm_recv(op, fd);
+                }
+                return 1;
+            }
+            ring_->recycle(buffer_id);
+            if (completion.res == -ENOBUFS) {
+                // Every buffer was in use; they have been recycled by now
+                arm_recv(op, fd);
+                return 0;
+            }
+            ops_.erase(it);
+            (*callback)(std::string_view(), completion.res);
+            return 1;
+        }
+
+        case Op::Write: {
+            auto chain = it->second.chain;
+            size_t index = it->second.index;
+            ops_.erase(it);
+            if (completion.res > 0) {
+                chain->segments[index].written = static_cast<size_t>(completion.res);
+            } else if (completion.res == -EAGAIN || completion.res == 0) {
+                chain->would_block = true;
+            } else if (completion.res != -ECANCELED && chain->error == 0) {
+                // -ECANCELED only means an earlier link came up short
+                chain->error = completion.res;
+            }
+            if (--chain->inflight == 0) {
+                finish_write(chain);
+                return 1;
+            }
+            return 0;
+        }
+
+        case Op::WritePoll: {
+            auto chain = it->second.chain;
+            ops_.erase(it);
+            if (completion.res < 0) {
+                chain->error = completion.res;
+                finish_write(chain);
+            } else {
+                submit_chain(chain);
+            }
+            return 1;
+        }
+    }
+    return 0;
+}
+
+size_t Reactor::wait_io_uring(std::chrono::milliseconds wait) {
+    ring_->submit_and_wait(wait);
+    completions_.clear();
+    ring_->reap(completions_);
+    size_t dispatched = 0;
+    for (const auto& completion : completions_) {
+        dispatched += dispatch_completion(completion);
+    }
+    return dispatched;
+}
+
+size_t Reactor::run_once(std::chrono::milliseconds max_wait) {
+    if (!valid()) {
+        return 0;
+    }
+
+    size_t dispatched = run_due_timers();
+    dispatched += run_deferred();
+
+    // Don't sleep past the next timer deadline
+    auto wait = max_wait;
+    while (!timer_heap_.empty() && timers_.count(timer_heap_.top().id) == 0) {
+        timer_heap_.pop();
+    }
+    if (!timer_heap_.empty()) {
+        auto until = std::chrono::ceil<std::chrono::milliseconds>(
+            timer_heap_.top().deadline - clock_->steady_now());
+        wait = std::clamp(until, std::chrono::milliseconds(0), wait);
+    }
+    if (dispatched > 0) {
+        wait = std::chrono::milliseconds(0);
+    }
+
+    if (ring_) {
+        dispatched += wait_io_uring(wait);
+        dispatched += run_posted();
+        dispatched += run_due_timers();
+        dispatched += run_deferred();
+        // One io_uring_enter for everything the callbacks queued
+        ring_->submit();
+        return dispatched;
+    }
+
+    epoll_event events[MAX_EVENTS];
+    int n = ::epoll_wait(epoll_fd_, events, MAX_EVENTS, static_cast<int>(wait.count()));
+    if (n < 0 && errno != EINTR) {
+        return dispatched;
+    }
+
+    for (int i = 0; i < n; ++i) {
+        int fd = events[i].data.fd;
+        if (fd == wake_fd_) {
+            uint64_t value;
+            [[maybe_unused]] auto r = ::read(wake_fd_, &value, sizeof(value));
+            continue;
+        }
+        // Look up each time: an earlier callback in this batch may have
+        // removed (or closed and re-added) this descriptor.
+        auto it = handlers_.find(fd);
+        if (it == handlers_.end()) {
+            continue;
+        }
+        uint32_t ready = from_epoll(events[i].events);
+        auto callback = it->second.callback;
+        (*callback)(ready);
+        ++dispatched;
+    }
+
+    dispatched += run_posted();
+    dispatched += run_due_timers();
+    dispatched += run_deferred();
+    return dispatched;
+}
+
+void Reactor::run() {
+    while (!stopping_.load(std::memory_order_acquire)) {
+        run_once(std::chrono::milliseconds(1000));
+    }
+    // Re-arm so the reactor can be run again
+    stopping_.store(false, std::memory_order_release);
+}
+
+} // namespace mcpp::async
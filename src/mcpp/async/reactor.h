@@ -0,0 +1,371 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef MCPP_ASYNC_REACTOR_H
+#define MCPP_ASYNC_REACTOR_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "mcpp/async/io_uring.h"
+#include "mcpp/util/clock.h"
+#include "mcpp/util/shared_buffer.h"
+
+namespace mcpp::async {
+
+/**
+ * @brief Single-threaded event loop (epoll or io_uring, plus timers)
+ *
+ * The Reactor multiplexes file descriptor readiness and timers on the
+ * calling thread. It is the driver for MCPP_SINGLE_THREADED builds: one
+ * reactor per core, each owning its transports and servers, with no
+ * cross-thread synchronization on the I/O or timer paths.
+ *
+ * Timers are measured against an injectable util::Clock, so tests can
+ * drive them with a ManualClock and run_once(0ms).
+ *
+ * With Backend::IoUring readiness is delivered through io_uring poll
+ * requests instead of epoll (same level-triggered semantics for
+ * IoCallback), and two completion-based operations become available:
+ * recv_multishot() (one request, many receives into kernel-selected
+ * buffers) and write_chain() (a linked sequence of writes submitted in
+ * one go). Everything prepared during an iteration reaches the kernel in
+ * a single io_uring_enter. If the kernel lacks io_uring the reactor
+ * silently falls back to epoll; check backend().
+ *
+ * Thread safety: add/modify/remove/call_after/cancel_timer/run_once/run
+ * must be called from the reactor thread (or before it starts). post()
+ * and stop() may be called from any thread; they wake the loop via an
+ * eventfd.
+ */
+class Reactor {
+public:
+    /// Interest/readiness flags passed to and reported by IoCallback
+    enum Events : uint32_t {
+        Readable = 1u << 0,  ///< Data (or EOF) available to read
+        Writable = 1u << 1,  ///< Space available to write
+        Closed   = 1u << 2,  ///< Hang-up or error on the descriptor
+    };
+
+    /// Invoked with a mask of Events when a registered fd becomes ready
+    using IoCallback = std::function<void(uint32_t events)>;
+
+    /// Invoked when a timer expires
+    using TimerCallback = std::function<void()>;
+
+    /// Opaque timer handle (0 is never a valid id)
+    using TimerId = uint64_t;
+
+    /// Handle for an in-flight completion operation (0 is never valid)
+    using OpId = uint64_t;
+
+    /**
+     * @brief Invoked for each multishot receive
+     *
+     * @param data Received bytes, valid only for the duration of the call
+     * @param result Bytes received (> 0), 0 on EOF, or -errno; the
+     *               operation is finished after a result <= 0
+     */
+    using RecvCallback = std::function<void(std::string_view data, int result)>;
+
+    /// Invoked once a write chain has been written in full (0) or failed (-errno)
+    using WriteCallback = std::function<void(int error)>;
+
+    /// Kernel interface used to wait for events
+    enum class Backend {
+        Epoll,    ///< epoll_wait readiness
+        IoUring,  ///< io_uring poll and completion requests
+    };
+
+    /// Construction options
+    struct Options {
+        /// Requested backend; IoUring falls back to Epoll when unsupported
+        Backend backend = Backend::Epoll;
+        /// io_uring submission queue size
+        unsigned ring_entries = 256;
+        /// Use a kernel SQ polling thread (saves io_uring_enter under load,
+        /// costs a busy kernel thread)
+        bool sq_poll = false;
+        /// Idle time before the SQ polling thread sleeps
+        std::chrono::milliseconds sq_poll_idle{1000};
+        /// Provided buffers for recv_multishot() (power of two)
+        unsigned recv_buffer_count = 64;
+        /// Size of each provided buffer
+        unsigned recv_buffer_size = 16 * 1024;
+    };
+
+    /**
+     * @brief Create the epoll instance and wakeup eventfd
+     *
+     * @param clock Time source for timers (defaults to util::Clock::default_clock())
+     *
+     * On failure valid() returns false and every registration fails.
+     */
+    explicit Reactor(std::shared_ptr<util::Clock> clock = util::Clock::default_clock());
+
+    /**
+     * @brief Create a reactor on the requested backend
+     *
+     * @param options Backend selection and io_uring tuning
+     * @param clock Time source for timers
+     */
+    explicit Reactor(const Options& options,
+                     std::shared_ptr<util::Clock> clock = util::Clock::default_clock());
+
+    /**
+     * @brief Close the epoll and eventfd descriptors
+     *
+     * Registered descriptors are not closed; they belong to the caller.
+     * In-flight io_uring operations are cancelled and their callbacks
+     * are not invoked.
+     */
+    ~Reactor();
+
+    // Non-copyable, non-movable (owns kernel handles, callbacks capture this)
+    Reactor(const Reactor&) = delete;
+    Reactor& operator=(const Reactor&) = delete;
+    Reactor(Reactor&&) = delete;
+    Reactor& operator=(Reactor&&) = delete;
+
+    /// @return true if the epoll instance or io_uring ring was created successfully
+    bool valid() const { return epoll_fd_ >= 0 || ring_ != nullptr; }
+
+    /// @return Backend actually in use
+    Backend backend() const { return ring_ ? Backend::IoUring : Backend::Epoll; }
+
+    /// @return true if recv_multishot() and write_chain() are available
+    bool uses_io_uring() const { return ring_ != nullptr; }
+
+    /**
+     * @brief Watch a descriptor for readiness
+     *
+     * @param fd Descriptor to watch (must support epoll; regular files do not)
+     * @param interest Mask of Readable/Writable
+     * @param callback Invoked with the ready Events
+     * @return false if the fd is already registered or epoll_ctl fails
+     */
+    bool add(int fd, uint32_t interest, IoCallback callback);
+
+    /**
+     * @brief Change the interest mask of a registered descriptor
+     *
+     * @return false if the fd is not registered or epoll_ctl fails
+     */
+    bool modify(int fd, uint32_t interest);
+
+    /**
+     * @brief Stop watching a descriptor
+     *
+     * Safe to call from inside that descriptor's own callback.
+     */
+    void remove(int fd);
+
+    /**
+     * @brief Schedule a one-shot timer
+     *
+     * @param delay Time from now (per the reactor clock) until it fires
+     * @param callback Invoked on the reactor thread
+     * @return Timer handle for cancel_timer()
+     */
+    TimerId call_after(std::chrono::milliseconds delay, TimerCallback callback);
+
+    /**
+     * @brief Schedule a repeating timer
+     *
+     * @param interval Period between invocations (first fires after one interval)
+     * @param callback Invoked on the reactor thread until cancelled
+     * @return Timer handle for cancel_timer()
+     */
+    TimerId call_every(std::chrono::milliseconds interval, TimerCallback callback);
+
+    /**
+     * @brief Cancel a pending timer
+     *
+     * No-op if the timer already fired (one-shot) or was cancelled.
+     */
+    void cancel_timer(TimerId id);
+
+    /**
+     * @brief Start a multishot receive on a socket (io_uring only)
+     *
+     * One request keeps delivering data as it arrives; the reactor re-arms
+     * it transparently when the kernel ends it early (for example when
+     * the provided buffers run out).
+     *
+     * @return Operation handle for cancel(), or 0 if unavailable (epoll
+     *         backend, or a kernel without provided buffer rings)
+     */
+    OpId recv_multishot(int fd, RecvCallback callback);
+
+    /**
+     * @brief Write buffers in order as one linked submission (io_uring only)
+     *
+     * The buffers are kept alive until the chain completes. Short writes
+     * are resumed automatically, so @p done reports either complete
+     * success or the first error.
+     *
+     * @return false on the epoll backend or if fd is invalid
+     */
+    bool write_chain(int fd, std::vector<util::SharedBuffer> buffers, WriteCallback done);
+
+    /**
+     * @brief Cancel a recv_multishot() operation
+     *
+     * The callback is not invoked again, even for completions already
+     * queued. Safe to call from inside that operation's own callback.
+     */
+    void cancel(OpId op);
+
+    /**
+     * @brief Run a function later in the current iteration
+     *
+     * Deferred functions run after event dispatch and before the next
+     * submission, so work queued by several callbacks (e.g. writes) can be
+     * coalesced into one system call.
+     */
+    void defer(std::function<void()> fn);
+
+    /**
+     * @brief Run a function on the reactor thread
+     *
+     * Thread safety: Safe to call from any thread.
+     */
+    void post(std::function<void()> fn);
+
+    /**
+     * @brief Wait for and dispatch one batch of events
+     *
+     * Runs due timers, waits up to max_wait (shortened to the next timer
+     * deadline) for fd readiness, dispatches ready descriptors, then runs
+     * posted functions and timers that became due.
+     *
+     * @param max_wait Upper bound on blocking; 0 polls without blocking
+     * @return Number of callbacks invoked
+     */
+    size_t run_once(std::chrono::milliseconds max_wait);
+
+    /**
+     * @brief Dispatch events until stop() is called
+     */
+    void run();
+
+    /**
+     * @brief Make run() return after the current iteration
+     *
+     * Thread safety: Safe to call from any thread.
+     */
+    void stop();
+
+    /// @return Number of registered descriptors
+    size_t watched_count() const { return handlers_.size(); }
+
+    /// @return Number of pending (not yet fired or cancelled) timers
+    size_t timer_count() const { return timers_.size(); }
+
+    /// @return Number of in-flight io_uring operations (always 0 on epoll)
+    size_t inflight_count() const { return ops_.size(); }
+
+    /// @return The clock used for timers
+    const std::shared_ptr<util::Clock>& clock() const { return clock_; }
+
+private:
+    struct Handler {
+        uint32_t interest;
+        std::shared_ptr<IoCallback> callback;
+        OpId poll_op = 0;  ///< Armed io_uring poll, 0 if none
+    };
+
+    /// Shared state of one write_chain() call (defined in reactor.cpp)
+    struct WriteChain;
+
+    /// What an io_uring user_data token refers to
+    struct Op {
+        enum Kind { Poll, Recv, Write, WritePoll } kind;
+        int fd = -1;
+        std::shared_ptr<RecvCallback> recv;
+        std::shared_ptr<WriteChain> chain;
+        size_t index = 0;  ///< Segment within the current submission (Write)
+    };
+
+    struct Timer {
+        std::chrono::steady_clock::duration interval;  ///< zero for one-shot
+        std::shared_ptr<TimerCallback> callback;
+    };
+
+    /// Heap entry; stale entries (cancelled timers) are skipped lazily
+    struct TimerSlot {
+        std::chrono::steady_clock::time_point deadline;
+        TimerId id;
+        bool operator>(const TimerSlot& other) const { return deadline > other.deadline; }
+    };
+
+    TimerId schedule(std::chrono::steady_clock::duration delay,
+                     std::chrono::steady_clock::duration interval,
+                     TimerCallback callback);
+    size_t run_due_timers();
+    size_t run_posted();
+    size_t run_deferred();
+    void wake();
+
+    bool init_io_uring(const Options& options);
+    bool arm_poll(int fd, Handler& handler);
+    void arm_wake();
+    bool arm_recv(OpId op, int fd);
+    void submit_chain(const std::shared_ptr<WriteChain>& chain);
+    void finish_write(const std::shared_ptr<WriteChain>& chain);
+    size_t wait_io_uring(std::chrono::milliseconds wait);
+    size_t dispatch_completion(const IoUring::Completion& completion);
+
+    std::shared_ptr<util::Clock> clock_;
+    int epoll_fd_ = -1;
+    int wake_fd_ = -1;
+    std::unique_ptr<IoUring> ring_;
+    std::unordered_map<OpId, Op> ops_;
+    std::vector<IoUring::Completion> completions_;
+    OpId next_op_ = 2;  ///< 1 is the wake eventfd poll, 0 is ignored
+    std::vector<std::function<void()>> deferred_;
+    std::atomic<bool> stopping_{false};
+
+    std::unordered_map<int, Handler> handlers_;
+    std::unordered_map<TimerId, Timer> timers_;
+    std::priority_queue<TimerSlot, std::vector<TimerSlot>, std::greater<>> timer_heap_;
+    TimerId next_timer_id_ = 1;
+
+    // post() is the one cross-thread entry point, so it keeps a real mutex
+    // even in MCPP_SINGLE_THREADED builds.
+    std::mutex post_mutex_;
+    std::vector<std::function<void()>> posted_;
+};
+
+} // namespace mcpp::async
+
+#endif // MCPP_ASYNC_REACTOR_H
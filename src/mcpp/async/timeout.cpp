@@ -28,33 +28,35 @@
 
 namespace mcpp::async {
 
-TimeoutManager::TimeoutManager(std::chrono::milliseconds default_timeout)
-    : default_timeout_(default_timeout) {
+TimeoutManager::TimeoutManager(std::chrono::milliseconds default_timeout,
+                               std::shared_ptr<util::Clock> clock)
+    : default_timeout_(default_timeout)
+    , clock_(clock ? std::move(clock) : util::Clock::system()) {
     // deadlines_ map starts empty
 }
 
 void TimeoutManager::set_timeout(RequestId id,
                                  std::chrono::milliseconds timeout,
                                  TimeoutCallback on_timeout) {
-    TimePoint deadline = Clock::now() + timeout;
+    TimePoint deadline = clock_->steady_now() + timeout;
 
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<util::Mutex> lock(mutex_);
     deadlines_[id] = TimeoutEntry{deadline, std::move(on_timeout)};
 }
 
 void TimeoutManager::cancel(RequestId id) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<util::Mutex> lock(mutex_);
     deadlines_.erase(id);
 }
 
 std::vector<RequestId> TimeoutManager::check_timeouts() {
-    TimePoint now = Clock::now();
+    TimePoint now = clock_->steady_now();
     std::vector<RequestId> expired_ids;
     std::vector<TimeoutCallback> expired_callbacks;
 
     // Collect expired entries while holding the lock
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<util::Mutex> lock(mutex_);
 
         // Find all entries that have expired
         for (auto& [id, entry] : deadlines_) {
@@ -87,12 +89,12 @@ std::vector<RequestId> TimeoutManager::check_timeouts() {
 }
 
 bool TimeoutManager::has_timeout(const RequestId& id) const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<util::Mutex> lock(mutex_);
     return deadlines_.find(id) != deadlines_.end();
 }
 
 size_t TimeoutManager::pending_count() const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<util::Mutex> lock(mutex_);
     return deadlines_.size();
 }
 
@@ -27,11 +27,14 @@
 
 #include <chrono>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
 #include <vector>
 
 #include "mcpp/async/callbacks.h"
+#include "mcpp/util/clock.h"
+#include "mcpp/util/concurrency.h"
 
 namespace mcpp::async {
 
@@ -43,7 +46,8 @@ namespace mcpp::async {
  * cleanup of requests that take too long to complete.
  *
  * Key design decisions:
- * - Uses steady_clock for timeout calculations (unaffected by system time changes)
+ * - Uses steady time from an injectable util::Clock (unaffected by system
+ *   time changes; a ManualClock makes expiry deterministic in tests)
  * - Thread-safe: all operations are mutex-protected
  * - Callbacks invoked AFTER mutex release to prevent deadlock
  * - Returns list of expired IDs for cleanup coordination
@@ -81,11 +85,13 @@ public:
      * Construct a TimeoutManager with a default timeout duration
      *
      * @param default_timeout The default timeout to use when not explicitly specified
+     * @param clock Time source for deadlines (defaults to util::Clock::default_clock())
      *
      * The default timeout is used as a fallback when registering timeouts.
      * Common values: 30s for MCP tool calls, 60s for long operations.
      */
-    explicit TimeoutManager(std::chrono::milliseconds default_timeout);
+    explicit TimeoutManager(std::chrono::milliseconds default_timeout,
+                            std::shared_ptr<util::Clock> clock = util::Clock::default_clock());
 
     /**
      * @brief Default destructor
@@ -199,11 +205,14 @@ private:
     /// Default timeout duration for new timeouts
     std::chrono::milliseconds default_timeout_;
 
+    /// Time source for deadlines
+    std::shared_ptr<util::Clock> clock_;
+
     /// Map of request IDs to their timeout entries
     std::unordered_map<RequestId, TimeoutEntry> deadlines_;
 
     /// Mutex protecting deadlines_ map
-    mutable std::mutex mutex_;
+    mutable util::Mutex mutex_{"async.timeout_manager"};
 };
 
 } // namespace mcpp::async
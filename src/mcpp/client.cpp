@@ -24,9 +24,13 @@
 
 #include "mcpp/client.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <future>
 #include <utility>
+#include <vector>
+
+#include "mcpp/util/metrics.h"
 
 namespace mcpp {
 
@@ -75,12 +79,7 @@ McpClient::McpClient(
     , timeout_manager_(default_timeout)
     , default_timeout_(default_timeout) {
     // Set up transport callbacks
-    transport_->set_message_callback([this](std::string_view message) {
-        on_message(message);
-    });
-    transport_->set_error_callback([this](std::string_view error) {
-        on_transport_error(error);
-    });
+    attach(*transport_);
 
     // Set up roots notification callback
     roots_manager_.set_notify_callback([this]() {
@@ -90,9 +89,7 @@ McpClient::McpClient(
     // Register roots/list request handler
     set_request_handler("roots/list",
         [this](std::string_view /* method */, const JsonValue& /* params */) -> JsonValue {
-            client::ListRootsResult result;
-            result.roots = roots_manager_.get_roots();
-            return result.to_json();
+            return roots_manager_.list_result();
         }
     );
 
@@ -123,6 +120,13 @@ McpClient::McpClient(
         }
     );
 
+    // Answer server keepalive pings
+    set_request_handler("ping",
+        [](std::string_view /* method */, const JsonValue& /* params */) -> JsonValue {
+            return JsonValue::object();
+        }
+    );
+
     // Register elicitation/create request handler
     set_request_handler("elicitation/create",
         [this](std::string_view /* method */, const JsonValue& params) -> JsonValue {
@@ -139,25 +143,65 @@ McpClient::McpClient(
 }
 
 McpClient::~McpClient() {
+    // The recovery and heartbeat threads call back into this client
+    std::thread recovery;
+    {
+        std::lock_guard<std::mutex> lock(transport_mutex_);
+        stopping_ = true;
+        recovery = std::move(recovery_thread_);
+    }
+    recovery_cv_.notify_all();
+    if (recovery.joinable()) {
+        recovery.join();
+    }
+    replace_keepalive(nullptr);
     if (transport_ && transport_->is_connected()) {
         disconnect();
     }
 }
 
+void McpClient::attach(transport::Transport& transport) {
+    transport.set_message_callback([this](std::string_view message) {
+        on_message(message);
+    });
+    transport.set_error_callback([this](std::string_view error) {
+        on_transport_error(error);
+    });
+}
+
+std::shared_ptr<transport::Transport> McpClient::current_transport() const {
+    std::lock_guard<std::mutex> lock(transport_mutex_);
+    return transport_;
+}
+
+bool McpClient::send_message(std::string_view message) {
+    std::shared_ptr<transport::Transport> transport;
+    {
+        std::lock_guard<std::mutex> lock(transport_mutex_);
+        if (recovering_) {
+            return false;  // held in outbound_ and sent after reconnecting
+        }
+        transport = transport_;
+    }
+    return transport->send(message);
+}
+
 // ============================================================================
 // Connection management
 // ============================================================================
 
 bool McpClient::connect() {
-    return transport_->connect();
+    closing_ = false;
+    return current_transport()->connect();
 }
 
 void McpClient::disconnect() {
-    transport_->disconnect();
+    closing_ = true;
+    current_transport()->disconnect();
 }
 
 bool McpClient::is_connected() const {
-    return transport_->is_connected();
+    return current_transport()->is_connected();
 }
 
 void McpClient::cancel_request(core::RequestId id) {
@@ -191,6 +235,29 @@ void McpClient::send_request(
     // Serialize to JSON string
     std::string message = request.to_string();
 
+    if (reconnect_) {
+        if (method == "resources/subscribe" || method == "resources/unsubscribe") {
+            // Remember subscriptions so they survive a reconnect
+            on_success = [this, subscribe = method == "resources/subscribe",
+                          uri = params.is_object() ? params.value("uri", std::string()) : std::string(),
+                          on_success = std::move(on_success)](const JsonValue& result) {
+                {
+                    std::lock_guard<std::mutex> lock(transport_mutex_);
+                    if (subscribe) {
+                        subscriptions_.insert(uri);
+                    } else {
+                        subscriptions_.erase(uri);
+                    }
+                }
+                if (on_success) {
+                    on_success(result);
+                }
+            };
+        }
+        std::lock_guard<std::mutex> lock(transport_mutex_);
+        outbound_[id] = Outbound{message, is_idempotent(method, params)};
+    }
+
     // Determine timeout
     std::chrono::milliseconds actual_timeout = timeout.value_or(default_timeout_);
 
@@ -213,6 +280,7 @@ void McpClient::send_request(
             // Request timed out - remove from pending and invoke error callback
             auto pending = request_tracker_.complete(timeout_id);
             cancellation_manager_.unregister_request(timeout_id);
+            forget_outbound(timeout_id);
             if (pending && pending->on_error) {
                 core::JsonRpcError timeout_error{
                     core::INTERNAL_ERROR,
@@ -224,7 +292,7 @@ void McpClient::send_request(
     );
 
     // Send via transport
-    transport_->send(message);
+    send_message(message);
 }
 
 void McpClient::send_notification(std::string_view method, const JsonValue& params) {
@@ -235,7 +303,7 @@ void McpClient::send_notification(std::string_view method, const JsonValue& para
 
     // Serialize and send (no response expected, no tracking needed)
     std::string message = notification.to_string();
-    transport_->send(message);
+    send_message(message);
 }
 
 // ============================================================================
@@ -287,7 +355,7 @@ void McpClient::enable_tool_use_for_sampling(bool enable) {
             req.params = params;
 
             std::string message = req.to_string();
-            transport_->send(message);
+            send_message(message);
 
             // Wait for response with a timeout
             // Note: This blocks the event loop - in production would need async approach
@@ -429,8 +497,13 @@ void McpClient::initialize(
             }
         };
 
-    // Send initialize request
-    send_request("initialize", protocol::make_initialize_request(params).params,
+    // Send initialize request; a reconnect repeats it with the same params
+    JsonValue init_params = protocol::make_initialize_request(params).params;
+    {
+        std::lock_guard<std::mutex> lock(transport_mutex_);
+        init_params_ = init_params;
+    }
+    send_request("initialize", init_params,
         std::move(wrapped_on_success),
         std::move(on_error)
     );
@@ -444,10 +517,36 @@ void McpClient::send_initialized_notification() {
 // Transport callbacks
 // ============================================================================
 
+void McpClient::set_parse_budget(const std::string& method, const core::ParseBudget& budget) {
+    parser_.set_budget(method, budget);
+}
+
+void McpClient::set_default_parse_budget(const core::ParseBudget& budget) {
+    parser_.set_default_budget(budget);
+}
+
 void McpClient::on_message(std::string_view message) {
+    if (auto heartbeat = keepalive()) {
+        heartbeat->on_activity();
+    }
     try {
-        // Parse JSON message
-        nlohmann::json j = nlohmann::json::parse(message);
+        // Parse under the message's budget; nothing is built for rejects
+        core::ParseOutcome outcome = parser_.parse(message);
+        if (!outcome.ok()) {
+            auto id = parse_request_id(outcome.id);
+            if (id && !outcome.method.empty()) {
+                // A server request we refuse still deserves an answer
+                send_error_response(*id, outcome.error);
+            } else if (id) {
+                // A response we refuse fails its request now, not at its timeout
+                core::JsonRpcResponse response;
+                response.id = *id;
+                response.error = outcome.error;
+                handle_response(response);
+            }
+            return;
+        }
+        nlohmann::json& j = *outcome.message;
 
         // Route based on message type
         if (is_response(j)) {
@@ -500,19 +599,353 @@ void McpClient::on_message(std::string_view message) {
         // Unknown message type - could log or ignore
         // For now, silently ignore
 
-    } catch (const nlohmann::json::parse_error&) {
-        // JSON parse error - send error response back
-        // (Can't send error without knowing message type)
     } catch (const std::exception&) {
         // Other exception - ignore
     }
 }
 
 void McpClient::on_transport_error(std::string_view error) {
-    // Transport errors are reported via callback
-    // For now, we don't have a user-facing error callback for transport errors
-    // This could be added in the future
-    (void)error; // Suppress unused warning
+    // Errors that leave the transport up (e.g. a rejected frame) are not
+    // losses, and neither is the close that disconnect() asked for
+    if (closing_ || current_transport()->is_connected()) {
+        return;
+    }
+    on_connection_lost(error);
+}
+
+// ============================================================================
+// Keepalive and connection loss
+// ============================================================================
+
+void McpClient::enable_keepalive(util::Heartbeat::Options options) {
+    replace_keepalive(nullptr);
+    if (options.metrics_prefix == util::Heartbeat::Options{}.metrics_prefix) {
+        options.metrics_prefix = "client.heartbeat";
+    }
+    const auto timeout = options.timeout;
+    auto heartbeat = std::make_shared<util::Heartbeat>(
+        std::move(options),
+        [this, timeout](util::Heartbeat::Pong pong) {
+            // Any response, even an error, proves the server is alive
+            try {
+                send_request("ping", JsonValue::object(),
+                    [pong](const JsonValue&) { pong(); },
+                    [pong](const core::JsonRpcError&) { pong(); },
+                    timeout);
+            } catch (...) {
+                // Send failure: the pong never arrives and counts as a miss
+            }
+        },
+        [this](const std::string& reason) {
+            on_connection_lost(reason);
+        });
+    heartbeat->start();
+    replace_keepalive(std::move(heartbeat));
+}
+
+void McpClient::disable_keepalive() {
+    replace_keepalive(nullptr);
+}
+
+std::shared_ptr<util::Heartbeat> McpClient::keepalive() const {
+    std::lock_guard<std::mutex> lock(heartbeat_mutex_);
+    return heartbeat_;
+}
+
+void McpClient::replace_keepalive(std::shared_ptr<util::Heartbeat> next) {
+    {
+        std::lock_guard<std::mutex> lock(heartbeat_mutex_);
+        heartbeat_.swap(next);
+    }
+    // next now holds the old pinger; dropping it here may join its thread,
+    // or detach it when this runs from that thread's dead callback
+}
+
+std::optional<util::Heartbeat::Stats> McpClient::keepalive_stats() const {
+    auto heartbeat = keepalive();
+    if (!heartbeat) {
+        return std::nullopt;
+    }
+    return heartbeat->stats();
+}
+
+void McpClient::set_connection_lost_handler(ConnectionLostHandler handler) {
+    connection_lost_handler_ = std::move(handler);
+}
+
+void McpClient::on_connection_lost(std::string_view reason) {
+    if (begin_recovery(reason)) {
+        return;
+    }
+    fail_in_flight(reason);
+    if (connection_lost_handler_) {
+        connection_lost_handler_(reason);
+    }
+}
+
+void McpClient::fail_in_flight(std::string_view reason) {
+    const core::JsonRpcError error{
+        core::INTERNAL_ERROR,
+        "Connection lost: " + std::string(reason),
+        std::nullopt
+    };
+    {
+        std::lock_guard<std::mutex> lock(transport_mutex_);
+        outbound_.clear();
+    }
+    for (auto& [id, pending] : request_tracker_.complete_all()) {
+        timeout_manager_.cancel(id);
+        cancellation_manager_.unregister_request(id);
+        if (pending.on_error) {
+            pending.on_error(error);
+        }
+    }
+}
+
+// ============================================================================
+// Reconnection
+// ============================================================================
+
+std::unordered_set<std::string> McpClient::default_idempotent_methods() {
+    return {
+        "completion/complete",
+        "logging/setLevel",
+        "prompts/complete",
+        "prompts/get",
+        "prompts/list",
+        "resources/complete",
+        "resources/list",
+        "resources/read",
+        "resources/subscribe",
+        "resources/templates/list",
+        "resources/unsubscribe",
+        "tasks/get",
+        "tasks/list",
+        "tasks/result",
+        "tools/list",
+    };
+}
+
+void McpClient::enable_reconnect(ReconnectOptions options) {
+    if (!options.backoff) {
+        options.backoff = std::make_shared<util::ExponentialBackoff>(
+            std::chrono::milliseconds(10), 2.0, std::chrono::milliseconds(1000));
+    }
+    options.max_attempts = std::max<uint32_t>(1, options.max_attempts);
+    reconnect_ = std::make_unique<ReconnectOptions>(std::move(options));
+}
+
+bool McpClient::is_idempotent(std::string_view method, const JsonValue& params) const {
+    if (method == "tools/call") {
+        auto name = params.find("name");
+        return name != params.end() && name->is_string() &&
+               reconnect_->idempotent_tools.count(name->get<std::string>()) > 0;
+    }
+    return reconnect_->idempotent_methods.count(std::string(method)) > 0;
+}
+
+void McpClient::forget_outbound(const core::RequestId& id) {
+    if (!reconnect_) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(transport_mutex_);
+    outbound_.erase(id);
+}
+
+bool McpClient::begin_recovery(std::string_view reason) {
+    if (!reconnect_) {
+        return false;
+    }
+    std::thread previous;
+    {
+        std::lock_guard<std::mutex> lock(transport_mutex_);
+        if (recovering_ || stopping_ || closing_) {
+            return true;  // already recovering, or the loss is expected
+        }
+        recovering_ = true;
+        previous = std::move(recovery_thread_);
+    }
+
+    // Requests that may have reached the old server are resent only if
+    // doing so twice is harmless; the rest fail now instead of hanging
+    const core::JsonRpcError error{
+        core::INTERNAL_ERROR,
+        "Connection lost: " + std::string(reason),
+        std::nullopt
+    };
+    auto& failed_fast = util::MetricsRegistry::global().counter("client.reconnect.failed_fast");
+    for (auto& [id, pending] : request_tracker_.complete_all()) {
+        bool replay = false;
+        {
+            std::lock_guard<std::mutex> lock(transport_mutex_);
+            auto it = outbound_.find(id);
+            if (it != outbound_.end()) {
+                replay = it->second.idempotent;
+                if (!replay) {
+                    outbound_.erase(it);
+                }
+            }
+        }
+        if (replay) {
+            request_tracker_.register_pending(id, std::move(pending.on_success), std::move(pending.on_error));
+            continue;
+        }
+        timeout_manager_.cancel(id);
+        cancellation_manager_.unregister_request(id);
+        failed_fast.add();
+        if (pending.on_error) {
+            pending.on_error(error);
+        }
+    }
+
+    // The previous recovery has finished (recovering_ was false)
+    if (previous.joinable()) {
+        previous.join();
+    }
+    std::lock_guard<std::mutex> lock(transport_mutex_);
+    if (stopping_) {
+        recovering_ = false;  // the destructor has already collected the thread
+        return true;
+    }
+    recovery_thread_ = std::thread([this, reason = std::string(reason)]() mutable {
+        recover(std::move(reason));
+    });
+    return true;
+}
+
+void McpClient::recover(std::string reason) {
+    auto& metrics = util::MetricsRegistry::global();
+    const auto started = std::chrono::steady_clock::now();
+
+    for (uint32_t attempt = 1; attempt <= reconnect_->max_attempts; ++attempt) {
+        if (attempt > 1) {
+            std::unique_lock<std::mutex> lock(transport_mutex_);
+            const auto delay = reconnect_->backoff->next_delay(static_cast<int>(attempt - 1));
+            if (recovery_cv_.wait_for(lock, delay, [this] { return stopping_; })) {
+                return;
+            }
+        }
+        metrics.counter("client.reconnect.attempts").add();
+        if (!reconnect_once(attempt == 1)) {
+            continue;
+        }
+
+        // Release held and replayable requests on the new connection
+        std::vector<std::string> replay;
+        {
+            std::lock_guard<std::mutex> lock(transport_mutex_);
+            recovering_ = false;
+            replay.reserve(outbound_.size());
+            for (const auto& [id, outbound] : outbound_) {
+                replay.push_back(outbound.message);
+            }
+        }
+        for (const std::string& message : replay) {
+            send_message(message);
+        }
+        if (auto heartbeat = keepalive()) {
+            heartbeat->reset();
+        }
+
+        metrics.counter("client.reconnect.successes").add();
+        metrics.counter("client.reconnect.replayed").add(replay.size());
+        metrics.histogram("client.reconnect.recovery_us").record(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - started).count()));
+        if (reconnect_->on_reconnected) {
+            reconnect_->on_reconnected(attempt);
+        }
+        return;
+    }
+
+    metrics.counter("client.reconnect.failures").add();
+    {
+        std::lock_guard<std::mutex> lock(transport_mutex_);
+        recovering_ = false;
+    }
+    const std::string failure = reason + " (reconnect failed after " +
+                                std::to_string(reconnect_->max_attempts) + " attempt(s))";
+    fail_in_flight(failure);
+    if (connection_lost_handler_) {
+        connection_lost_handler_(failure);
+    }
+}
+
+bool McpClient::reconnect_once(bool first) {
+    std::shared_ptr<transport::Transport> old = current_transport();
+    if (first) {
+        // Stop the old reader (and a hung server) before replacing it
+        old->disconnect();
+    }
+
+    if (reconnect_->factory) {
+        std::shared_ptr<transport::Transport> fresh = reconnect_->factory();
+        if (!fresh) {
+            return false;
+        }
+        attach(*fresh);
+        if (!fresh->connect()) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(transport_mutex_);
+        transport_ = std::move(fresh);
+    } else {
+        old->disconnect();
+        if (!old->connect()) {
+            return false;
+        }
+    }
+
+    std::optional<JsonValue> init_params;
+    std::vector<std::string> subscriptions;
+    {
+        std::lock_guard<std::mutex> lock(transport_mutex_);
+        init_params = init_params_;
+        subscriptions.assign(subscriptions_.begin(), subscriptions_.end());
+    }
+
+    if (init_params) {
+        auto done = std::make_shared<std::promise<bool>>();
+        std::future<bool> initialized = done->get_future();
+        core::RequestId id = send_direct("initialize", *init_params,
+            [done](const JsonValue&) { done->set_value(true); },
+            [done](const core::JsonRpcError&) { done->set_value(false); });
+        if (initialized.wait_for(reconnect_->initialize_timeout) != std::future_status::ready) {
+            request_tracker_.cancel(id);
+            return false;
+        }
+        if (!initialized.get()) {
+            return false;
+        }
+        core::JsonRpcNotification notification;
+        notification.method = "notifications/initialized";
+        current_transport()->send(notification.to_string());
+    }
+
+    // Answers arrive after the replayed requests are sent; nothing waits
+    for (const std::string& uri : subscriptions) {
+        send_direct("resources/subscribe", JsonValue{{"uri", uri}}, nullptr, nullptr);
+    }
+    return true;
+}
+
+core::RequestId McpClient::send_direct(std::string_view method, const JsonValue& params,
+                                       async::ResponseCallback on_success,
+                                       async::ErrorCallback on_error) {
+    core::RequestId id = request_tracker_.next_id();
+    request_tracker_.register_pending(id, std::move(on_success), on_error);
+
+    core::JsonRpcRequest request;
+    request.id = id;
+    request.method = method;
+    request.params = params;
+    if (!current_transport()->send(request.to_string())) {
+        auto pending = request_tracker_.complete(id);
+        if (pending && pending->on_error) {
+            pending->on_error(core::JsonRpcError{core::INTERNAL_ERROR, "Send failed", std::nullopt});
+        }
+    }
+    return id;
 }
 
 // ============================================================================
@@ -528,6 +961,7 @@ void McpClient::handle_response(const core::JsonRpcResponse& response) {
 
     // Unregister from cancellation tracking
     cancellation_manager_.unregister_request(response.id);
+    forget_outbound(response.id);
 
     if (!pending) {
         // No pending request found - response without matching request
@@ -585,7 +1019,7 @@ void McpClient::send_response(core::RequestId id, const JsonValue& result) {
     response.result = result;
 
     std::string message = response.to_string();
-    transport_->send(message);
+    send_message(message);
 }
 
 void McpClient::send_error_response(core::RequestId id, const core::JsonRpcError& error) {
@@ -594,7 +1028,7 @@ void McpClient::send_error_response(core::RequestId id, const core::JsonRpcError
     response.error = error;
 
     std::string message = response.to_string();
-    transport_->send(message);
+    send_message(message);
 }
 
 } // namespace mcpp
@@ -25,13 +25,18 @@
 #ifndef MCPP_CLIENT_H
 #define MCPP_CLIENT_H
 
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "mcpp/async/callbacks.h"
 #include "mcpp/async/timeout.h"
@@ -39,10 +44,13 @@
 #include "mcpp/client/elicitation.h"
 #include "mcpp/client/roots.h"
 #include "mcpp/client/sampling.h"
+#include "mcpp/core/budgeted_parser.h"
 #include "mcpp/core/json_rpc.h"
 #include "mcpp/core/request_tracker.h"
 #include "mcpp/protocol/initialize.h"
 #include "mcpp/transport/transport.h"
+#include "mcpp/util/heartbeat.h"
+#include "mcpp/util/retry.h"
 
 namespace mcpp {
 
@@ -105,6 +113,43 @@ public:
      */
     using NotificationHandler = std::function<void(std::string_view method, const JsonValue& params)>;
 
+    /**
+     * @brief Callback invoked when the connection to the server is lost
+     *
+     * @param reason Why the connection is considered lost
+     */
+    using ConnectionLostHandler = std::function<void(std::string_view reason)>;
+
+    /// Builds a fresh transport for reconnecting (e.g. respawns the server)
+    using TransportFactory = std::function<std::unique_ptr<transport::Transport>()>;
+
+    /// @return Methods replayed after a reconnect by default (reads and lists)
+    static std::unordered_set<std::string> default_idempotent_methods();
+
+    /**
+     * @brief Configuration for enable_reconnect()
+     */
+    struct ReconnectOptions {
+        /// Creates the replacement transport; when empty the current
+        /// transport is disconnected and connected again
+        TransportFactory factory;
+        /// Connection attempts before giving up
+        uint32_t max_attempts = 5;
+        /// Delay before each retry (nullptr = 10ms doubling up to 1s);
+        /// the first attempt is immediate
+        std::shared_ptr<util::RetryPolicy<void>> backoff;
+        /// Time to wait for the repeated initialize to be answered
+        std::chrono::milliseconds initialize_timeout{5000};
+        /// Methods safe to send twice; in-flight requests for other
+        /// methods fail fast when the connection is lost
+        std::unordered_set<std::string> idempotent_methods = default_idempotent_methods();
+        /// Tools whose tools/call is safe to send twice (e.g. annotated
+        /// idempotentHint); other tool calls fail fast
+        std::unordered_set<std::string> idempotent_tools;
+        /// Called on the recovery thread after a successful reconnect
+        std::function<void(uint32_t attempts)> on_reconnected;
+    };
+
     /**
      * @brief Construct a McpClient with a transport implementation
      *
@@ -319,9 +364,93 @@ public:
      */
     void set_elicitation_handler(client::ElicitationHandler handler);
 
+    /**
+     * @brief Set the parse budget for incoming messages of one method
+     *
+     * Incoming messages are parsed with a core::BudgetedParser. A server
+     * request that exceeds its budget is answered with -32600 and never
+     * reaches its handler; other rejected messages are dropped.
+     *
+     * Must be called before connect().
+     *
+     * @param method Server-to-client method (e.g. "sampling/createMessage")
+     * @param budget Limits for that method's messages
+     */
+    void set_parse_budget(const std::string& method, const core::ParseBudget& budget);
+
+    /**
+     * @brief Set the parse budget for responses and unlisted methods
+     *
+     * Must be called before connect().
+     */
+    void set_default_parse_budget(const core::ParseBudget& budget);
+
+    /**
+     * @brief Ping the server periodically and detect a dead server
+     *
+     * Sends MCP "ping" requests on an idle connection (any inbound message
+     * postpones the next one) and tracks round-trip time and jitter under
+     * "client.heartbeat.*" metrics unless options.metrics_prefix is
+     * changed. When the server misses options.max_missed pongs in a row,
+     * every in-flight request fails immediately with "Connection lost"
+     * and the connection lost handler runs, so a hung server is detected
+     * in seconds rather than after the request timeouts.
+     *
+     * Call after connect(); replaces any previous keepalive.
+     *
+     * @param options Ping interval, pong timeout and miss threshold
+     */
+    void enable_keepalive(util::Heartbeat::Options options);
+
+    /// Stop sending keepalive pings
+    void disable_keepalive();
+
+    /// @return Keepalive statistics (RTT, misses), or nullopt if not enabled
+    std::optional<util::Heartbeat::Stats> keepalive_stats() const;
+
+    /**
+     * @brief Set the handler called when the connection is lost
+     *
+     * Runs after in-flight requests have been failed, on the thread that
+     * detected the loss.
+     */
+    void set_connection_lost_handler(ConnectionLostHandler handler);
+
+    /**
+     * @brief Recover automatically when the connection is lost
+     *
+     * A loss is a transport error that leaves the transport disconnected
+     * (server process exited, socket closed) or a dead server reported by
+     * the keepalive. On a loss:
+     * - in-flight requests for idempotent methods stay pending; all other
+     *   in-flight requests fail at once with "Connection lost"
+     * - a recovery thread connects again (through options.factory if set),
+     *   repeats initialize with the params of the last initialize() call,
+     *   re-subscribes every resource subscribed with resources/subscribe,
+     *   then resends the pending requests with their original ids
+     * - requests sent while recovering are held and sent afterwards;
+     *   responses and notifications to the old server are dropped
+     *
+     * If every attempt fails, pending requests fail and the connection
+     * lost handler runs. Progress is exported as "client.reconnect.*"
+     * metrics (attempts, successes, failures, replayed, failed_fast and a
+     * recovery_us histogram).
+     *
+     * Must be called before connect().
+     *
+     * @param options Transport factory, retry policy and idempotent methods
+     */
+    void enable_reconnect(ReconnectOptions options);
+
 private:
-    /// Transport layer for sending/receiving messages
-    std::unique_ptr<transport::Transport> transport_;
+    /// A request that may be resent after a reconnect
+    struct Outbound {
+        std::string message;  ///< Serialized request (keeps its id)
+        bool idempotent;      ///< Safe to send again if possibly delivered
+    };
+
+    /// Transport layer for sending/receiving messages (swapped on reconnect)
+    std::shared_ptr<transport::Transport> transport_;
 
     /// Request ID generator and pending request storage
     core::RequestTracker request_tracker_;
@@ -341,6 +470,9 @@ private:
     /// Roots manager for handling roots/list requests and list_changed notifications
     client::RootsManager roots_manager_;
 
+    /// Budgeted parser for incoming messages
+    core::BudgetedParser parser_;
+
     /// Sampling client for handling sampling/createMessage requests from server
     client::SamplingClient sampling_client_;
 
@@ -350,6 +482,87 @@ private:
     /// Cancellation manager for handling request cancellation
     client::CancellationManager cancellation_manager_;
 
+    /// Called when the connection is lost (dead peer)
+    ConnectionLostHandler connection_lost_handler_;
+
+    /// Keepalive pinger (null unless enabled). Replaced from user threads,
+    /// the recovery thread and its own dead callback, so it is only touched
+    /// through keepalive() and replace_keepalive().
+    std::shared_ptr<util::Heartbeat> heartbeat_;
+
+    /// Guards heartbeat_
+    mutable std::mutex heartbeat_mutex_;
+
+    /// @return The current pinger, or null
+    std::shared_ptr<util::Heartbeat> keepalive() const;
+
+    /// Swap in @p next; the old pinger is stopped outside the lock
+    void replace_keepalive(std::shared_ptr<util::Heartbeat> next);
+
+    /// Reconnect configuration (null unless enabled)
+    std::unique_ptr<ReconnectOptions> reconnect_;
+
+    /// Guards transport_ swaps and the reconnect state below
+    mutable std::mutex transport_mutex_;
+
+    /// A recovery is in progress; sends are held
+    bool recovering_ = false;
+
+    /// Set by the destructor to abandon recovery
+    bool stopping_ = false;
+
+    /// Set between disconnect() and connect(); transport errors are expected
+    std::atomic<bool> closing_{false};
+
+    /// Unanswered requests by id (only tracked when reconnect is enabled)
+    std::unordered_map<core::RequestId, Outbound> outbound_;
+
+    /// Resource URIs successfully subscribed with resources/subscribe
+    std::unordered_set<std::string> subscriptions_;
+
+    /// Params of the last initialize() call, repeated after reconnecting
+    std::optional<JsonValue> init_params_;
+
+    /// Runs recover(); wakes early when stopping_
+    std::thread recovery_thread_;
+    std::condition_variable recovery_cv_;
+
+    /// Install the message and error callbacks on a transport
+    void attach(transport::Transport& transport);
+
+    /// @return The current transport
+    std::shared_ptr<transport::Transport> current_transport() const;
+
+    /// Send unless a recovery is in progress (held requests are replayed)
+    bool send_message(std::string_view message);
+
+    /// @return Whether a request may be resent after a reconnect
+    bool is_idempotent(std::string_view method, const JsonValue& params) const;
+
+    /// Forget a request that was answered, timed out or failed
+    void forget_outbound(const core::RequestId& id);
+
+    /// Fail non-idempotent requests and start the recovery thread
+    /// @return false if reconnecting is not enabled
+    bool begin_recovery(std::string_view reason);
+
+    /// Recovery thread body: reconnect with backoff, then replay
+    void recover(std::string reason);
+
+    /// One reconnect attempt: connect, initialize, re-subscribe
+    bool reconnect_once(bool first);
+
+    /// Send a request on the current transport even while recovering
+    /// @return The request id (already failed if the send failed)
+    core::RequestId send_direct(std::string_view method, const JsonValue& params,
+                                async::ResponseCallback on_success, async::ErrorCallback on_error);
+
+    /// Fail every in-flight request and notify connection_lost_handler_
+    void on_connection_lost(std::string_view reason);
+
+    /// Fail every in-flight request with a "Connection lost" error
+    void fail_in_flight(std::string_view reason);
+
     /// Callback invoked by transport when a message is received
     void on_message(std::string_view message);
 
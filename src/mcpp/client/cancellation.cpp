@@ -30,12 +30,12 @@
 namespace mcpp::client {
 
 void CancellationManager::register_request(core::RequestId id, CancellationSource source) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<util::Mutex> lock(mutex_);
     pending_.emplace(std::move(id), std::move(source));
 }
 
 void CancellationManager::handle_cancelled(core::RequestId id, const std::optional<std::string>& reason) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<util::Mutex> lock(mutex_);
 
     auto it = pending_.find(id);
     if (it != pending_.end()) {
@@ -52,13 +52,13 @@ void CancellationManager::handle_cancelled(core::RequestId id, const std::option
 }
 
 void CancellationManager::unregister_request(core::RequestId id) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<util::Mutex> lock(mutex_);
     pending_.erase(id);
     // No error if not present (already unregistered or cancelled)
 }
 
 size_t CancellationManager::pending_count() const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<util::Mutex> lock(mutex_);
     return pending_.size();
 }
 
@@ -33,6 +33,7 @@
 #include <variant>
 
 #include "../core/json_rpc.h"
+#include "../util/concurrency.h"
 
 namespace mcpp::client {
 
@@ -253,7 +254,7 @@ private:
     std::unordered_map<core::RequestId, CancellationSource> pending_;
 
     // Mutex protecting pending_ map
-    mutable std::mutex mutex_;
+    mutable util::Mutex mutex_{"client.cancellation_manager"};
 };
 
 } // namespace mcpp::client
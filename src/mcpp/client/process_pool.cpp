@@ -0,0 +1,538 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mcpp/client/process_pool.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "mcpp/transport/process_transport.h"
+
+namespace mcpp::client {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Transport decorator that records when the connection is lost
+ *
+ * McpClient owns its transport's error callback, so the pool observes
+ * liveness through this wrapper instead.
+ */
+class MonitoredTransport : public transport::Transport {
+public:
+    MonitoredTransport(std::unique_ptr<transport::Transport> inner,
+                       std::shared_ptr<std::atomic<bool>> alive)
+        : inner_(std::move(inner))
+        , alive_(std::move(alive)) {}
+
+    bool connect() override { return inner_->connect(); }
+    void disconnect() override { inner_->disconnect(); }
+    bool is_connected() const override { return inner_->is_connected(); }
+
+    bool send(std::string_view message) override {
+        if (!inner_->send(message)) {
+            alive_->store(false);
+            return false;
+        }
+        return true;
+    }
+
+    void set_message_callback(MessageCallback cb) override {
+        inner_->set_message_callback(std::move(cb));
+    }
+
+    void set_error_callback(ErrorCallback cb) override {
+        // Rejected frames are reported here too; only a lost connection
+        // makes the server unusable
+        inner_->set_error_callback(
+            [inner = inner_.get(), alive = alive_, cb = std::move(cb)](std::string_view error) {
+                if (!inner->is_connected()) {
+                    alive->store(false);
+                }
+                if (cb) {
+                    cb(error);
+                }
+            });
+    }
+
+private:
+    std::unique_ptr<transport::Transport> inner_;
+    std::shared_ptr<std::atomic<bool>> alive_;
+};
+
+} // namespace
+
+struct ProcessPool::Entry {
+    enum class State { Starting, Idle, Checking, Leased, Dead };
+
+    std::unique_ptr<McpClient> client;
+    std::shared_ptr<std::atomic<bool>> alive;
+    protocol::InitializeResult server_info;
+    State state = State::Starting;
+    Clock::time_point created;
+    Clock::time_point idle_since;
+    Clock::time_point last_check;
+    Clock::time_point check_started;
+    size_t uses = 0;
+
+    bool usable() const { return alive->load() && client->is_connected(); }
+};
+
+// ============================================================================
+// Lease
+// ============================================================================
+
+ProcessPool::Lease::Lease(ProcessPool* pool, uint64_t id, McpClient* client,
+                          const protocol::InitializeResult* server_info)
+    : pool_(pool)
+    , id_(id)
+    , client_(client)
+    , server_info_(server_info) {}
+
+ProcessPool::Lease::Lease(Lease&& other) noexcept
+    : pool_(std::exchange(other.pool_, nullptr))
+    , id_(other.id_)
+    , client_(std::exchange(other.client_, nullptr))
+    , server_info_(std::exchange(other.server_info_, nullptr))
+    , discard_(other.discard_) {}
+
+ProcessPool::Lease& ProcessPool::Lease::operator=(Lease&& other) noexcept {
+    if (this != &other) {
+        release();
+        pool_ = std::exchange(other.pool_, nullptr);
+        id_ = other.id_;
+        client_ = std::exchange(other.client_, nullptr);
+        server_info_ = std::exchange(other.server_info_, nullptr);
+        discard_ = other.discard_;
+    }
+    return *this;
+}
+
+void ProcessPool::Lease::release() {
+    if (pool_ == nullptr) {
+        return;
+    }
+    pool_->give_back(id_, discard_);
+    pool_ = nullptr;
+    client_ = nullptr;
+    server_info_ = nullptr;
+}
+
+// ============================================================================
+// ProcessPool
+// ============================================================================
+
+ProcessPool::ProcessPool(std::string command, std::vector<std::string> args, Options options)
+    : ProcessPool(
+          [command = std::move(command), args = std::move(args)](std::string& error)
+              -> std::unique_ptr<transport::Transport> {
+              return transport::ProcessTransport::spawn(command, args, error);
+          },
+          std::move(options)) {}
+
+ProcessPool::ProcessPool(Launcher launcher, Options options)
+    : launcher_(std::move(launcher))
+    , options_(std::move(options)) {
+    if (options_.init_params.protocolVersion.empty()) {
+        options_.init_params.protocolVersion = protocol::PROTOCOL_VERSION;
+    }
+    if (options_.init_params.clientInfo.name.empty()) {
+        options_.init_params.clientInfo = {"mcpp-pool", "0.1.0"};
+    }
+    options_.max_size = std::max<size_t>(options_.max_size, 1);
+    options_.min_idle = std::min(options_.min_idle, options_.max_size);
+}
+
+ProcessPool::~ProcessPool() {
+    stop();
+}
+
+void ProcessPool::start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_ || thread_.joinable()) {
+        return;
+    }
+    running_ = true;
+    thread_ = std::thread([this]() { run(); });
+}
+
+void ProcessPool::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+        wake_ = true;
+    }
+    maintenance_cv_.notify_all();
+    ready_cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+
+    // Leased servers are terminated by give_back() when released
+    std::vector<std::unique_ptr<Entry>> garbage;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto it = entries_.begin(); it != entries_.end();) {
+            if (it->second->state == Entry::State::Leased) {
+                ++it;
+                continue;
+            }
+            garbage.push_back(std::move(it->second));
+            it = entries_.erase(it);
+            ++counters_.retired;
+        }
+        idle_.clear();
+    }
+}
+
+ProcessPool::Lease ProcessPool::acquire(std::chrono::milliseconds timeout) {
+    auto deadline = Clock::now() + timeout;
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (true) {
+        if (!running_) {
+            return {};
+        }
+
+        while (!idle_.empty()) {
+            uint64_t id = idle_.back();
+            idle_.pop_back();
+            Entry& entry = *entries_.at(id);
+
+            if (!entry.usable()) {
+                // Died since its last health check
+                entry.state = Entry::State::Dead;
+                ++counters_.health_failures;
+                wake_ = true;
+                maintenance_cv_.notify_one();
+                continue;
+            }
+
+            entry.state = Entry::State::Leased;
+            ++counters_.acquired;
+            return Lease(this, id, entry.client.get(), &entry.server_info);
+        }
+
+        // Nothing idle: ask the maintenance thread to grow the pool
+        ++waiting_;
+        wake_ = true;
+        maintenance_cv_.notify_one();
+        bool available = ready_cv_.wait_until(lock, deadline, [this]() {
+            return !idle_.empty() || !running_;
+        });
+        --waiting_;
+
+        if (!available) {
+            ++counters_.acquire_timeouts;
+            return {};
+        }
+    }
+}
+
+bool ProcessPool::wait_ready(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    ready_cv_.wait_for(lock, timeout, [this]() {
+        return idle_.size() >= options_.min_idle || !running_;
+    });
+    return running_ && idle_.size() >= options_.min_idle;
+}
+
+ProcessPool::Stats ProcessPool::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats = counters_;
+    for (const auto& [id, entry] : entries_) {
+        switch (entry->state) {
+            case Entry::State::Starting:
+                ++stats.starting;
+                break;
+            case Entry::State::Idle:
+            case Entry::State::Checking:
+                ++stats.idle;
+                break;
+            case Entry::State::Leased:
+                ++stats.leased;
+                break;
+            case Entry::State::Dead:
+                break;
+        }
+    }
+    return stats;
+}
+
+void ProcessPool::wake_maintenance() {
+    wake_ = true;
+    maintenance_cv_.notify_one();
+}
+
+void ProcessPool::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (running_) {
+        std::vector<std::unique_ptr<Entry>> garbage;
+        std::vector<uint64_t> to_ping;
+        size_t to_spawn = 0;
+        maintain(garbage, to_ping, to_spawn);
+
+        // Destroying a client joins its read thread and reaps the child;
+        // neither may happen under the lock its callbacks take
+        lock.unlock();
+        garbage.clear();
+        for (uint64_t id : to_ping) {
+            ping(id);
+        }
+        for (size_t i = 0; i < to_spawn; ++i) {
+            spawn_one();
+        }
+        lock.lock();
+
+        maintenance_cv_.wait_for(lock, options_.maintenance_interval, [this]() {
+            return wake_ || !running_;
+        });
+        wake_ = false;
+    }
+}
+
+void ProcessPool::maintain(std::vector<std::unique_ptr<Entry>>& garbage,
+                           std::vector<uint64_t>& to_ping, size_t& to_spawn) {
+    const auto now = Clock::now();
+
+    auto unlist = [this](uint64_t id) {
+        idle_.erase(std::remove(idle_.begin(), idle_.end(), id), idle_.end());
+    };
+
+    size_t starting = 0;
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        Entry& entry = *it->second;
+        bool retire = false;
+
+        switch (entry.state) {
+            case Entry::State::Dead:
+                retire = true;
+                break;
+            case Entry::State::Starting:
+                if (now - entry.created > options_.init_timeout) {
+                    ++counters_.spawn_failures;
+                    retire = true;
+                } else {
+                    ++starting;
+                }
+                break;
+            case Entry::State::Idle:
+                if (!entry.usable()) {
+                    ++counters_.health_failures;
+                    retire = true;
+                } else if (options_.max_age.count() > 0 && now - entry.created >= options_.max_age) {
+                    retire = true;
+                } else if (options_.health_check_interval.count() > 0 &&
+                           now - entry.last_check >= options_.health_check_interval) {
+                    entry.state = Entry::State::Checking;
+                    entry.check_started = now;
+                    unlist(it->first);
+                    to_ping.push_back(it->first);
+                }
+                break;
+            case Entry::State::Checking:
+                // McpClient does not drive its own request timeouts, so
+                // the pool enforces the ping deadline here
+                if (now - entry.check_started > options_.ping_timeout) {
+                    ++counters_.health_failures;
+                    retire = true;
+                } else {
+                    ++starting;
+                }
+                break;
+            case Entry::State::Leased:
+                break;
+        }
+
+        if (retire) {
+            unlist(it->first);
+            garbage.push_back(std::move(it->second));
+            it = entries_.erase(it);
+            ++counters_.retired;
+        } else {
+            ++it;
+        }
+    }
+
+    // Shrink: retire the least recently used servers beyond min_idle once
+    // they have been idle for idle_timeout
+    while (idle_.size() > options_.min_idle) {
+        uint64_t id = idle_.front();
+        auto it = entries_.find(id);
+        if (now - it->second->idle_since < options_.idle_timeout) {
+            break;
+        }
+        idle_.erase(idle_.begin());
+        garbage.push_back(std::move(it->second));
+        entries_.erase(it);
+        ++counters_.retired;
+    }
+
+    // Grow: keep min_idle ready plus one server per blocked acquire()
+    size_t supply = idle_.size() + starting;
+    size_t target = options_.min_idle + waiting_;
+    if (supply < target && entries_.size() < options_.max_size) {
+        to_spawn = std::min(target - supply, options_.max_size - entries_.size());
+    }
+}
+
+void ProcessPool::spawn_one() {
+    std::string error;
+    auto transport = launcher_(error);
+    if (!transport) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++counters_.spawn_failures;
+        return;
+    }
+
+    auto alive = std::make_shared<std::atomic<bool>>(true);
+    auto client = std::make_unique<McpClient>(
+        std::make_unique<MonitoredTransport>(std::move(transport), alive),
+        options_.request_timeout);
+    if (options_.on_spawn) {
+        options_.on_spawn(*client);
+    }
+    if (!client->connect()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++counters_.spawn_failures;
+        return;
+    }
+
+    // Only the maintenance thread (and stop(), after joining it) destroys
+    // entries, so the client outlives the initialize() call below
+    McpClient* raw = client.get();
+    uint64_t id = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) {
+            return;
+        }
+        id = next_id_++;
+        auto entry = std::make_unique<Entry>();
+        entry->client = std::move(client);
+        entry->alive = std::move(alive);
+        entry->created = Clock::now();
+        entries_.emplace(id, std::move(entry));
+        ++counters_.spawned;
+    }
+
+    raw->initialize(
+        options_.init_params,
+        [this, id](const protocol::InitializeResult& result) { on_ready(id, result); },
+        [this, id](const core::JsonRpcError&) { on_failed(id, false); });
+}
+
+void ProcessPool::ping(uint64_t id) {
+    McpClient* client = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(id);
+        if (it == entries_.end() || it->second->state != Entry::State::Checking) {
+            return;
+        }
+        client = it->second->client.get();
+    }
+
+    client->send_request(
+        "ping", JsonValue::object(),
+        [this, id](const JsonValue&) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = entries_.find(id);
+            if (it == entries_.end() || it->second->state != Entry::State::Checking) {
+                return;
+            }
+            Entry& entry = *it->second;
+            entry.state = Entry::State::Idle;
+            entry.last_check = Clock::now();
+            // Keep its place as least recently used
+            idle_.insert(idle_.begin(), id);
+            ready_cv_.notify_one();
+        },
+        [this, id](const core::JsonRpcError&) { on_failed(id, true); },
+        options_.ping_timeout);
+}
+
+void ProcessPool::on_ready(uint64_t id, const protocol::InitializeResult& result) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(id);
+    if (it == entries_.end() || it->second->state != Entry::State::Starting) {
+        return;
+    }
+    Entry& entry = *it->second;
+    entry.server_info = result;
+    entry.state = Entry::State::Idle;
+    entry.idle_since = entry.last_check = Clock::now();
+    idle_.push_back(id);
+    ready_cv_.notify_all();
+}
+
+void ProcessPool::on_failed(uint64_t id, bool health_check) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(id);
+    if (it == entries_.end()) {
+        return;
+    }
+    Entry& entry = *it->second;
+    if (entry.state != Entry::State::Starting && entry.state != Entry::State::Checking) {
+        return;
+    }
+    entry.state = Entry::State::Dead;
+    ++(health_check ? counters_.health_failures : counters_.spawn_failures);
+    wake_maintenance();
+}
+
+void ProcessPool::give_back(uint64_t id, bool discard) {
+    std::unique_ptr<Entry> doomed;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(id);
+    if (it == entries_.end()) {
+        return;
+    }
+    Entry& entry = *it->second;
+    ++entry.uses;
+
+    const auto now = Clock::now();
+    bool retire = discard || !entry.usable() ||
+                  (options_.max_uses > 0 && entry.uses >= options_.max_uses) ||
+                  (options_.max_age.count() > 0 && now - entry.created >= options_.max_age);
+
+    if (!running_) {
+        // Pool stopped while leased: nobody else will clean this up
+        doomed = std::move(it->second);
+        entries_.erase(it);
+        ++counters_.retired;
+    } else if (retire) {
+        entry.state = Entry::State::Dead;
+        wake_maintenance();
+    } else {
+        entry.state = Entry::State::Idle;
+        entry.idle_since = now;
+        idle_.push_back(id);
+        ready_cv_.notify_one();
+    }
+}
+
+} // namespace mcpp::client
@@ -0,0 +1,259 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef MCPP_CLIENT_PROCESS_POOL_H
+#define MCPP_CLIENT_PROCESS_POOL_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "mcpp/client.h"
+#include "mcpp/protocol/initialize.h"
+#include "mcpp/transport/transport.h"
+
+namespace mcpp::client {
+
+/**
+ * @brief Pool of pre-initialized McpClients backed by stdio server processes
+ *
+ * Spawning a stdio MCP server and completing the initialize handshake costs
+ * a process start plus a round trip, often hundreds of milliseconds for
+ * interpreted servers. The pool keeps Options::min_idle servers spawned and
+ * initialized ahead of demand, so acquire() normally returns a ready client
+ * without waiting.
+ *
+ * Lifecycle of a pooled server:
+ * - Spawned and initialized by the maintenance thread (Starting)
+ * - Handed out by acquire() (Leased) and returned when the Lease is
+ *   destroyed (Idle)
+ * - Pinged with "ping" every Options::health_check_interval while idle;
+ *   a failed or late reply retires it
+ * - Retired after Options::max_uses leases or Options::max_age, so a
+ *   server that leaks memory or state never lives forever
+ * - Retired when idle longer than Options::idle_timeout while more than
+ *   min_idle servers are idle (shrink)
+ *
+ * When acquire() finds nothing idle, the maintenance thread spawns extra
+ * servers (one per waiter) up to Options::max_size (grow).
+ *
+ * Retired servers are destroyed on the maintenance thread, never on a
+ * client's read thread; ProcessTransport terminates and reaps the child.
+ *
+ * Thread safety: all methods may be called from any thread. A Lease must
+ * not outlive its pool.
+ */
+class ProcessPool {
+public:
+    /// Creates the transport for one new server (nullptr + error on failure)
+    using Launcher = std::function<std::unique_ptr<transport::Transport>(std::string& error)>;
+
+    /// Pool options
+    struct Options {
+        /// Initialized servers kept ready ahead of demand
+        size_t min_idle = 1;
+
+        /// Upper bound on live servers (idle, leased and starting)
+        size_t max_size = 8;
+
+        /// Leases served before a server is retired (0 = unlimited)
+        size_t max_uses = 0;
+
+        /// Age after which a server is retired when returned (0 = unlimited)
+        std::chrono::milliseconds max_age{0};
+
+        /// Idle time after which servers beyond min_idle are retired
+        std::chrono::milliseconds idle_timeout{60000};
+
+        /// Interval between pings of an idle server (0 = never)
+        std::chrono::milliseconds health_check_interval{10000};
+
+        /// Time a server has to answer a health-check ping
+        std::chrono::milliseconds ping_timeout{2000};
+
+        /// Time a server has to complete the initialize handshake
+        std::chrono::milliseconds init_timeout{10000};
+
+        /// Default timeout for requests sent through leased clients
+        std::chrono::milliseconds request_timeout{30000};
+
+        /// Maintenance thread wake-up interval
+        std::chrono::milliseconds maintenance_interval{100};
+
+        /// Parameters for the initialize handshake (clientInfo defaults to "mcpp-pool")
+        protocol::InitializeRequestParams init_params;
+
+        /// Called for each new client before connect() (e.g. to set handlers)
+        std::function<void(McpClient&)> on_spawn;
+    };
+
+    /// Point-in-time pool counters
+    struct Stats {
+        size_t idle = 0;               ///< Initialized and available
+        size_t leased = 0;             ///< Handed out
+        size_t starting = 0;           ///< Spawned, handshake in progress
+        uint64_t spawned = 0;          ///< Servers spawned in total
+        uint64_t retired = 0;          ///< Servers destroyed in total
+        uint64_t spawn_failures = 0;   ///< Spawns or handshakes that failed
+        uint64_t health_failures = 0;  ///< Idle servers that failed a ping
+        uint64_t acquired = 0;         ///< Successful acquire() calls
+        uint64_t acquire_timeouts = 0; ///< acquire() calls that timed out
+    };
+
+    /**
+     * @brief Exclusive use of one pooled client
+     *
+     * Move-only. The server goes back to the pool when the Lease is
+     * destroyed or release() is called; discard() retires it instead
+     * (e.g. after a request left the server in an unknown state).
+     */
+    class Lease {
+    public:
+        Lease() = default;
+        ~Lease() { release(); }
+
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&& other) noexcept;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        /// @return true if this lease holds a client
+        explicit operator bool() const { return client_ != nullptr; }
+
+        McpClient& client() const { return *client_; }
+        McpClient* operator->() const { return client_; }
+
+        /// @return The server's answer to the initialize handshake
+        const protocol::InitializeResult& server_info() const { return *server_info_; }
+
+        /// Retire the server instead of returning it to the pool
+        void discard() { discard_ = true; }
+
+        /// Return the server to the pool now (no-op on an empty lease)
+        void release();
+
+    private:
+        friend class ProcessPool;
+        Lease(ProcessPool* pool, uint64_t id, McpClient* client,
+              const protocol::InitializeResult* server_info);
+
+        ProcessPool* pool_ = nullptr;
+        uint64_t id_ = 0;
+        McpClient* client_ = nullptr;
+        const protocol::InitializeResult* server_info_ = nullptr;
+        bool discard_ = false;
+    };
+
+    /**
+     * @brief Pool of servers started as `command args...`
+     *
+     * Each server is spawned with transport::ProcessTransport.
+     */
+    ProcessPool(std::string command, std::vector<std::string> args, Options options);
+
+    /// Pool of servers whose transports are created by launcher
+    ProcessPool(Launcher launcher, Options options);
+
+    /// Stops the pool and terminates every server
+    ~ProcessPool();
+
+    // Non-copyable, non-movable (maintenance thread and leases reference this)
+    ProcessPool(const ProcessPool&) = delete;
+    ProcessPool& operator=(const ProcessPool&) = delete;
+    ProcessPool(ProcessPool&&) = delete;
+    ProcessPool& operator=(ProcessPool&&) = delete;
+
+    /**
+     * @brief Start the maintenance thread and begin pre-warming
+     *
+     * Returns immediately; use wait_ready() to block until warm.
+     */
+    void start();
+
+    /**
+     * @brief Stop maintenance and terminate all servers that are not leased
+     *
+     * Pending acquire() calls return empty leases. Leased servers are
+     * terminated when their lease is released.
+     */
+    void stop();
+
+    /**
+     * @brief Take an initialized client from the pool
+     *
+     * @param timeout How long to wait for a server to become available
+     * @return The lease, or an empty lease on timeout or after stop()
+     */
+    Lease acquire(std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Block until min_idle servers are idle
+     *
+     * @return false on timeout
+     */
+    bool wait_ready(std::chrono::milliseconds timeout);
+
+    /// @return Current counters
+    Stats stats() const;
+
+private:
+    struct Entry;
+
+    void run();
+    void maintain(std::vector<std::unique_ptr<Entry>>& garbage,
+                  std::vector<uint64_t>& to_ping, size_t& to_spawn);
+    void spawn_one();
+    void ping(uint64_t id);
+    void on_ready(uint64_t id, const protocol::InitializeResult& result);
+    void on_failed(uint64_t id, bool health_check);
+    void give_back(uint64_t id, bool discard);
+    void wake_maintenance();
+
+    Launcher launcher_;
+    Options options_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable ready_cv_;       ///< Signals idle servers to acquire()
+    std::condition_variable maintenance_cv_; ///< Wakes the maintenance thread
+    std::unordered_map<uint64_t, std::unique_ptr<Entry>> entries_;
+    std::vector<uint64_t> idle_;             ///< Most recently returned last
+    size_t waiting_ = 0;                     ///< acquire() calls blocked
+    bool wake_ = false;                      ///< Maintenance requested before the next tick
+    uint64_t next_id_ = 1;
+    Stats counters_;                         ///< Cumulative counters only
+    bool running_ = false;
+    std::thread thread_;
+};
+
+} // namespace mcpp::client
+
+#endif // MCPP_CLIENT_PROCESS_POOL_H
@@ -24,6 +24,8 @@
 
 #include "mcpp/client/roots.h"
 
+#include <mutex>
+
 namespace mcpp::client {
 
 // ============================================================================
@@ -87,17 +89,67 @@ std::optional<ListRootsResult> ListRootsResult::from_json(const JsonValue& j) {
 // ============================================================================
 
 void RootsManager::set_roots(std::vector<Root> roots) {
+    std::lock_guard<util::SharedStateMutex> lock(mutex_);
     roots_ = std::move(roots);
+    cached_result_.reset();
+
+    index_.clear();
+    root_positions_.clear();
+    for (size_t i = 0; i < roots_.size(); ++i) {
+        auto normalized = util::PathTrie::normalize(roots_[i].uri);
+        if (normalized && index_.insert(*normalized)) {
+            root_positions_.emplace(std::move(*normalized), i);
+        }
+    }
+}
+
+std::vector<Root> RootsManager::get_roots() const {
+    std::lock_guard<util::SharedStateMutex> lock(mutex_);
+    return roots_;
+}
+
+bool RootsManager::contains(std::string_view path_or_uri) const {
+    std::lock_guard<util::SharedStateMutex> lock(mutex_);
+    return index_.contains(path_or_uri);
+}
+
+std::optional<Root> RootsManager::root_for(std::string_view path_or_uri) const {
+    std::lock_guard<util::SharedStateMutex> lock(mutex_);
+    auto root_path = index_.root_for(path_or_uri);
+    if (!root_path) {
+        return std::nullopt;
+    }
+    auto it = root_positions_.find(*root_path);
+    if (it == root_positions_.end()) {
+        return std::nullopt;
+    }
+    return roots_[it->second];
+}
+
+JsonValue RootsManager::list_result() const {
+    std::lock_guard<util::SharedStateMutex> lock(mutex_);
+    if (!cached_result_) {
+        ListRootsResult result;
+        result.roots = roots_;
+        cached_result_ = result.to_json();
+    }
+    return *cached_result_;
 }
 
 void RootsManager::set_notify_callback(NotifyCallback cb) {
+    std::lock_guard<util::SharedStateMutex> lock(mutex_);
     notify_cb_ = std::move(cb);
 }
 
 void RootsManager::notify_changed() {
     // Send notification if callback is registered
-    if (notify_cb_) {
-        notify_cb_();
+    NotifyCallback cb;
+    {
+        std::lock_guard<util::SharedStateMutex> lock(mutex_);
+        cb = notify_cb_;
+    }
+    if (cb) {
+        cb();
     }
 }
 
@@ -28,10 +28,15 @@
 #include <functional>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #include <nlohmann/json.hpp>
 
+#include "mcpp/util/concurrency.h"
+#include "mcpp/util/path_trie.h"
+
 namespace mcpp::client {
 
 // Type alias for JSON values - using nlohmann::json
@@ -107,7 +112,14 @@ struct ListRootsResult {
  * RootsManager stores the list of root URIs that the client advertises
  * to the server. It can send notifications when the roots change.
  *
- * Thread safety: Not thread-safe. Use external synchronization if needed.
+ * The roots are also indexed in a util::PathTrie, so contains() and
+ * root_for() answer "is this path inside an advertised root?" in
+ * O(path depth). The roots/list result is built once per change and
+ * reused until set_roots() is called again.
+ *
+ * Thread safety: All methods are safe to call concurrently (a
+ * RootsWatcher updates roots from its own thread). The notify callback
+ * is invoked without the lock held.
  *
  * Usage:
  *   RootsManager manager;
@@ -138,13 +150,11 @@ public:
     RootsManager() = default;
     ~RootsManager() = default;
 
-    // Non-copyable
+    // Non-copyable, non-movable (owns a mutex)
     RootsManager(const RootsManager&) = delete;
     RootsManager& operator=(const RootsManager&) = delete;
-
-    // Movable
-    RootsManager(RootsManager&&) = default;
-    RootsManager& operator=(RootsManager&&) = default;
+    RootsManager(RootsManager&&) = delete;
+    RootsManager& operator=(RootsManager&&) = delete;
 
     /**
      * @brief Set the roots list
@@ -160,9 +170,35 @@ public:
     /**
      * @brief Get the current roots list
      *
-     * @return const reference to current roots
+     * @return Copy of the current roots
+     */
+    std::vector<Root> get_roots() const;
+
+    /**
+     * @brief Whether a path or file:// URI is inside an advertised root
+     *
+     * @param path_or_uri Absolute path or file:// URI
+     * @return true if it equals or lies beneath one of the roots
+     */
+    bool contains(std::string_view path_or_uri) const;
+
+    /**
+     * @brief The deepest advertised root containing a path
+     *
+     * @param path_or_uri Absolute path or file:// URI
+     * @return The matching root, or nullopt if none contains it
+     */
+    std::optional<Root> root_for(std::string_view path_or_uri) const;
+
+    /**
+     * @brief roots/list result for the current roots
+     *
+     * Built on first use after each set_roots() and cached until the
+     * next change.
+     *
+     * @return JSON in MCP ListRootsResult format
      */
-    const std::vector<Root>& get_roots() const { return roots_; }
+    JsonValue list_result() const;
 
     /**
      * @brief Set the callback for roots changed notifications
@@ -194,9 +230,22 @@ public:
     }
 
 private:
+    /// A real lock even in single-threaded builds: RootsWatcher publishes
+    /// from its own thread
+    mutable util::SharedStateMutex mutex_{"client.roots_manager"};
+
     /// Current roots list
     std::vector<Root> roots_;
 
+    /// Path index over roots_ (roots with unparseable URIs are skipped)
+    util::PathTrie index_;
+
+    /// Normalized root path -> position in roots_
+    std::unordered_map<std::string, size_t> root_positions_;
+
+    /// Cached list_result(), reset by set_roots()
+    mutable std::optional<JsonValue> cached_result_;
+
     /// Callback for sending list_changed notifications
     NotifyCallback notify_cb_;
 };
@@ -0,0 +1,232 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mcpp/client/roots_watcher.h"
+
+#include <dirent.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <utility>
+
+#include "mcpp/util/path_trie.h"
+
+namespace mcpp::client {
+
+namespace {
+
+constexpr uint32_t DIRECTORY_EVENTS =
+    IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+
+bool is_directory(const std::string& path) {
+    struct stat st{};
+    return ::stat(path.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+std::string parent_of(const std::string& path) {
+    auto slash = path.find_last_of('/');
+    if (slash == std::string::npos || slash == 0) {
+        return "/";
+    }
+    return path.substr(0, slash);
+}
+
+} // anonymous namespace
+
+RootsWatcher::RootsWatcher(RootsManager& manager)
+    : RootsWatcher(manager, Options{}) {}
+
+RootsWatcher::RootsWatcher(RootsManager& manager, Options options)
+    : manager_(manager)
+    , options_(options) {}
+
+RootsWatcher::~RootsWatcher() {
+    stop();
+}
+
+void RootsWatcher::add_root(std::string path, std::optional<std::string> name) {
+    auto normalized = util::PathTrie::normalize(path);
+    fixed_roots_.push_back(FixedRoot{normalized ? *normalized : std::move(path), std::move(name)});
+}
+
+void RootsWatcher::add_workspace(std::string directory) {
+    auto normalized = util::PathTrie::normalize(directory);
+    workspaces_.push_back(normalized ? *normalized : std::move(directory));
+}
+
+std::vector<Root> RootsWatcher::compute_roots() const {
+    std::vector<Root> roots;
+
+    for (const auto& fixed : fixed_roots_) {
+        if (is_directory(fixed.path)) {
+            roots.push_back(Root{util::PathTrie::to_file_uri(fixed.path), fixed.name});
+        }
+    }
+
+    for (const auto& workspace : workspaces_) {
+        DIR* dir = ::opendir(workspace.c_str());
+        if (dir == nullptr) {
+            continue;
+        }
+        std::vector<Root> children;
+        while (dirent* entry = ::readdir(dir)) {
+            if (entry->d_name[0] == '.') {
+                continue;
+            }
+            std::string path = workspace == "/" ? "/" + std::string(entry->d_name)
+                                                : workspace + "/" + entry->d_name;
+            if (is_directory(path)) {
+                children.push_back(Root{util::PathTrie::to_file_uri(path), std::string(entry->d_name)});
+            }
+        }
+        ::closedir(dir);
+        // readdir order is arbitrary; keep the advertised list stable
+        std::sort(children.begin(), children.end(),
+                  [](const Root& a, const Root& b) { return a.uri < b.uri; });
+        for (auto& child : children) {
+            roots.push_back(std::move(child));
+        }
+    }
+
+    return roots;
+}
+
+bool RootsWatcher::rescan() {
+    std::lock_guard<std::mutex> lock(rescan_mutex_);
+    auto roots = compute_roots();
+
+    auto same = [](const std::vector<Root>& a, const std::vector<Root>& b) {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+                          [](const Root& x, const Root& y) { return x.uri == y.uri && x.name == y.name; });
+    };
+    if (same(roots, published_)) {
+        return false;
+    }
+
+    published_ = roots;
+    manager_.set_roots(std::move(roots));
+    manager_.notify_changed();
+    ++notifications_;
+    return true;
+}
+
+void RootsWatcher::add_watches() {
+    // Parents of fixed roots see the root being created, removed or renamed;
+    // workspaces see their children change. Re-adding an existing watch just
+    // returns the same descriptor, so overlapping directories are harmless.
+    for (const auto& fixed : fixed_roots_) {
+        ::inotify_add_watch(inotify_fd_, parent_of(fixed.path).c_str(), DIRECTORY_EVENTS);
+    }
+    for (const auto& workspace : workspaces_) {
+        ::inotify_add_watch(inotify_fd_, workspace.c_str(), DIRECTORY_EVENTS);
+    }
+}
+
+bool RootsWatcher::start() {
+    if (running_.load()) {
+        return true;
+    }
+
+    inotify_fd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd_ < 0) {
+        return false;
+    }
+    wake_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wake_fd_ < 0) {
+        ::close(inotify_fd_);
+        inotify_fd_ = -1;
+        return false;
+    }
+
+    add_watches();
+    {
+        std::lock_guard<std::mutex> lock(rescan_mutex_);
+        published_ = compute_roots();
+        manager_.set_roots(published_);
+    }
+
+    running_.store(true);
+    thread_ = std::thread([this] { run(); });
+    return true;
+}
+
+void RootsWatcher::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    uint64_t one = 1;
+    [[maybe_unused]] auto n = ::write(wake_fd_, &one, sizeof(one));
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    ::close(inotify_fd_);
+    ::close(wake_fd_);
+    inotify_fd_ = -1;
+    wake_fd_ = -1;
+}
+
+void RootsWatcher::run() {
+    using Clock = std::chrono::steady_clock;
+    std::optional<Clock::time_point> deadline;
+    alignas(inotify_event) char buffer[4096];
+
+    while (running_.load()) {
+        int timeout = -1;
+        if (deadline) {
+            auto remaining = std::chrono::ceil<std::chrono::milliseconds>(*deadline - Clock::now());
+            timeout = static_cast<int>(std::max<int64_t>(0, remaining.count()));
+        }
+
+        pollfd fds[2] = {{inotify_fd_, POLLIN, 0}, {wake_fd_, POLLIN, 0}};
+        int ready = ::poll(fds, 2, timeout);
+        if (ready < 0 && errno != EINTR) {
+            break;
+        }
+        if (!running_.load()) {
+            break;
+        }
+
+        if (ready > 0 && (fds[0].revents & POLLIN)) {
+            // Drain; the exact events don't matter, only that something changed
+            while (::read(inotify_fd_, buffer, sizeof(buffer)) > 0) {
+            }
+            deadline = Clock::now() + options_.debounce;
+            continue;
+        }
+
+        if (deadline && Clock::now() >= *deadline) {
+            deadline.reset();
+            // Directories may have been recreated; watches on them are new
+            add_watches();
+            rescan();
+        }
+    }
+}
+
+} // namespace mcpp::client
@@ -0,0 +1,159 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef MCPP_CLIENT_ROOTS_WATCHER_H
+#define MCPP_CLIENT_ROOTS_WATCHER_H
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "mcpp/client/roots.h"
+
+namespace mcpp::client {
+
+/**
+ * @brief Keeps a RootsManager in sync with the filesystem via inotify
+ *
+ * Two kinds of roots can be watched:
+ * - Fixed roots (add_root): advertised while the directory exists, so a
+ *   deleted or renamed project disappears from roots/list and comes back
+ *   when it is recreated.
+ * - Workspaces (add_workspace): every immediate subdirectory of the
+ *   workspace directory is advertised as a root.
+ *
+ * The watcher monitors the parent of each fixed root and each workspace
+ * directory. Filesystem events start a trailing debounce timer; once
+ * events stop for Options::debounce, the root set is recomputed and, if
+ * it changed, published with RootsManager::set_roots() followed by a
+ * single notify_changed() (notifications/roots/list_changed).
+ *
+ * Linux only; start() returns false where inotify is unavailable.
+ *
+ * start() spawns a watcher thread, even in MCPP_SINGLE_THREADED builds;
+ * set_roots() and notify_changed() (and so the notify callback) run on
+ * that thread. RootsManager keeps a real lock for this reason.
+ *
+ * Thread safety: add_root/add_workspace must be called before start().
+ * rescan() and stop() may be called from any thread.
+ */
+class RootsWatcher {
+public:
+    /// Watcher options
+    struct Options {
+        /// Quiet period after the last event before roots are republished
+        std::chrono::milliseconds debounce{250};
+    };
+
+    explicit RootsWatcher(RootsManager& manager);
+    RootsWatcher(RootsManager& manager, Options options);
+
+    /// Stops the watcher thread
+    ~RootsWatcher();
+
+    // Non-copyable, non-movable (background thread references this)
+    RootsWatcher(const RootsWatcher&) = delete;
+    RootsWatcher& operator=(const RootsWatcher&) = delete;
+    RootsWatcher(RootsWatcher&&) = delete;
+    RootsWatcher& operator=(RootsWatcher&&) = delete;
+
+    /**
+     * @brief Advertise a directory as a root while it exists
+     *
+     * @param path Absolute directory path
+     * @param name Optional display name (defaults to none)
+     */
+    void add_root(std::string path, std::optional<std::string> name = std::nullopt);
+
+    /**
+     * @brief Advertise every subdirectory of a directory as a root
+     *
+     * Hidden entries (names starting with '.') are skipped.
+     *
+     * @param directory Absolute directory path
+     */
+    void add_workspace(std::string directory);
+
+    /**
+     * @brief Publish the initial roots and start watching
+     *
+     * The initial set_roots() does not send a notification; the client
+     * advertises roots in response to the server's first roots/list.
+     *
+     * @return false if inotify could not be initialized
+     */
+    bool start();
+
+    /**
+     * @brief Stop watching and join the thread
+     */
+    void stop();
+
+    /**
+     * @brief Recompute roots now and notify if they changed
+     *
+     * @return true if the roots changed
+     */
+    bool rescan();
+
+    /// @return true while the watcher thread is running
+    bool is_running() const { return running_.load(); }
+
+    /// @return Number of list_changed notifications sent so far
+    size_t notifications() const { return notifications_.load(); }
+
+private:
+    struct FixedRoot {
+        std::string path;
+        std::optional<std::string> name;
+    };
+
+    std::vector<Root> compute_roots() const;
+    void add_watches();
+    void run();
+
+    RootsManager& manager_;
+    Options options_;
+
+    std::vector<FixedRoot> fixed_roots_;
+    std::vector<std::string> workspaces_;
+
+    int inotify_fd_ = -1;
+    int wake_fd_ = -1;
+    std::atomic<bool> running_{false};
+    std::atomic<size_t> notifications_{0};
+    std::thread thread_;
+
+    /// Serializes rescans between the watcher thread and rescan() callers
+    std::mutex rescan_mutex_;
+    std::vector<Root> published_;
+};
+
+} // namespace mcpp::client
+
+#endif // MCPP_CLIENT_ROOTS_WATCHER_H
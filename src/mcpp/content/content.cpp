@@ -26,6 +26,7 @@
 
 #include "mcpp/client/sampling.h"
 #include "mcpp/server/resource_registry.h"
+#include "mcpp/util/json_writer.h"
 
 #include <variant>
 
@@ -294,4 +295,79 @@ std::optional<::mcpp::client::ContentBlock> content_from_json(const nlohmann::js
     return std::nullopt;
 }
 
+// ============================================================================
+// Direct serialization
+// ============================================================================
+//
+// Keys are written in the order nlohmann::json (std::map) dumps them, so the
+// output matches content_to_json(block).dump() byte for byte.
+
+namespace {
+
+void append_annotations(std::string& out, const std::optional<Annotations>& annotations) {
+    if (annotations.has_value()) {
+        out.append("\"annotations\":");
+        out.append(annotations_to_json(*annotations).dump());
+        out.push_back(',');
+    }
+}
+
+void append_media_json(
+    std::string& out,
+    const std::string& type,
+    const util::SharedBuffer& data,
+    const std::string& mime_type,
+    const std::optional<Annotations>& annotations
+) {
+    out.reserve(out.size() + data.size() + mime_type.size() + 64);
+    out.push_back('{');
+    append_annotations(out, annotations);
+    out.append("\"data\":");
+    util::append_json_string(out, data);
+    out.append(",\"mimeType\":");
+    util::append_json_string(out, mime_type);
+    out.append(",\"type\":");
+    util::append_json_string(out, type);
+    out.push_back('}');
+}
+
+} // namespace
+
+void append_json(std::string& out, const ImageContent& content) {
+    append_media_json(out, content.type, content.data, content.mime_type, content.annotations);
+}
+
+void append_json(std::string& out, const AudioContent& content) {
+    append_media_json(out, content.type, content.data, content.mime_type, content.annotations);
+}
+
+void append_json(std::string& out, const EmbeddedResource& content) {
+    const server::ResourceContent& resource = content.resource;
+    const util::SharedBuffer& payload = resource.is_text ? resource.text : resource.blob;
+
+    out.reserve(out.size() + payload.size() + resource.uri.size() + 64);
+    out.push_back('{');
+    append_annotations(out, content.annotations);
+    if (!resource.is_text) {
+        out.append("\"blob\":");
+        util::append_json_string(out, payload);
+        out.push_back(',');
+    }
+    if (resource.mime_type.has_value()) {
+        out.append("\"mimeType\":");
+        util::append_json_string(out, *resource.mime_type);
+        out.push_back(',');
+    }
+    if (resource.is_text) {
+        out.append("\"text\":");
+        util::append_json_string(out, payload);
+        out.push_back(',');
+    }
+    out.append("\"type\":");
+    util::append_json_string(out, content.type);
+    out.append(",\"uri\":");
+    util::append_json_string(out, resource.uri);
+    out.push_back('}');
+}
+
 } // namespace mcpp::content
@@ -31,6 +31,8 @@
 
 #include <nlohmann/json.hpp>
 
+#include "mcpp/util/shared_buffer.h"
+
 // Include for ResourceContent definition used by EmbeddedResource
 #include "mcpp/server/resource_registry.h"
 
@@ -85,8 +87,9 @@ struct ImageContent {
     /// Content type identifier
     std::string type = "image";
 
-    /// Base64-encoded image bytes (caller's responsibility to encode)
-    std::string data;
+    /// Base64-encoded image bytes (caller's responsibility to encode).
+    /// Shared, so copying the block does not copy the payload.
+    util::SharedBuffer data;
 
     /// MIME type of the image (e.g., "image/png", "image/jpeg")
     std::string mime_type;
@@ -113,8 +116,9 @@ struct AudioContent {
     /// Content type identifier
     std::string type = "audio";
 
-    /// Base64-encoded audio bytes (caller's responsibility to encode)
-    std::string data;
+    /// Base64-encoded audio bytes (caller's responsibility to encode).
+    /// Shared, so copying the block does not copy the payload.
+    util::SharedBuffer data;
 
     /// MIME type of the audio (e.g., "audio/mp3", "audio/wav")
     std::string mime_type;
@@ -164,6 +168,25 @@ struct EmbeddedResource {
     std::optional<Annotations> annotations;
 };
 
+// ============================================================================
+// Direct serialization
+// ============================================================================
+
+/**
+ * @brief Append the JSON for a content block to @p out
+ *
+ * Writes the payload straight from its SharedBuffer instead of copying it
+ * into a nlohmann::json string node first. The output is byte-identical to
+ * dumping the DOM produced by content_to_json().
+ */
+void append_json(std::string& out, const ImageContent& content);
+
+/// @copydoc append_json(std::string&, const ImageContent&)
+void append_json(std::string& out, const AudioContent& content);
+
+/// @copydoc append_json(std::string&, const ImageContent&)
+void append_json(std::string& out, const EmbeddedResource& content);
+
 } // namespace mcpp::content
 
 #endif // MCPP_CONTENT_CONTENT_H
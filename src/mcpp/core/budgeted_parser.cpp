@@ -0,0 +1,374 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "budgeted_parser.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace mcpp::core {
+
+namespace {
+
+/// max() where 0 (unlimited) wins
+size_t widest(size_t a, size_t b) {
+    return (a == 0 || b == 0) ? 0 : std::max(a, b);
+}
+
+bool over(size_t value, size_t limit) {
+    return limit != 0 && value > limit;
+}
+
+} // anonymous namespace
+
+/**
+ * nlohmann SAX handler that builds the DOM while charging a budget
+ *
+ * Returning false from any callback aborts nlohmann::json::sax_parse().
+ * After a budget violation the DOM is dropped and the rest of the message
+ * is only skimmed for the top-level "id" and "method" (members are
+ * unordered, so they may follow the oversized part), so the rejection can
+ * still be answered; skimming stops as soon as both are known.
+ */
+class BudgetedSaxHandler {
+public:
+    using number_integer_t = JsonValue::number_integer_t;
+    using number_unsigned_t = JsonValue::number_unsigned_t;
+    using number_float_t = JsonValue::number_float_t;
+    using string_t = JsonValue::string_t;
+    using binary_t = JsonValue::binary_t;
+
+    BudgetedSaxHandler(const BudgetedParser& parser, ParseOutcome& outcome)
+        : parser_(parser)
+        , outcome_(outcome)
+        , budget_(&parser.envelope_budget_) {}
+
+    bool null() { return add_value(JsonValue(nullptr)); }
+    bool boolean(bool value) { return add_value(JsonValue(value)); }
+    bool number_integer(number_integer_t value) { return add_value(JsonValue(value)); }
+    bool number_unsigned(number_unsigned_t value) { return add_value(JsonValue(value)); }
+    bool number_float(number_float_t value, const string_t&) { return add_value(JsonValue(value)); }
+
+    bool string(string_t& value) {
+        if (skimming_) {
+            return skim_value(JsonValue(std::move(value)));
+        }
+        if (!charge_string(value.size())) {
+            return begin_skim(0);
+        }
+        return add_value(JsonValue(std::move(value)));
+    }
+
+    bool binary(binary_t&) {
+        return reject("binary values are not supported");
+    }
+
+    bool start_object(std::size_t) {
+        return skimming_ ? skim_open() : open(JsonValue::value_t::object) || begin_skim(1);
+    }
+
+    bool key(string_t& name) {
+        if (skimming_) {
+            if (skim_depth_ == 1) {
+                skim_key_ = std::move(name);
+            }
+            return true;
+        }
+        if (!charge_string(name.size())) {
+            return begin_skim(0);
+        }
+        Frame& frame = stack_.back();
+        ++frame.count;
+        max_members_ = std::max(max_members_, frame.count);
+        if (over(frame.count, budget_->max_object_members)) {
+            reject("object exceeds max_object_members");
+            if (!begin_skim(0)) {
+                return false;
+            }
+            if (skim_depth_ == 1) {
+                skim_key_ = std::move(name);  // its value follows
+            }
+            return true;
+        }
+        key_ = std::move(name);
+        return true;
+    }
+
+    bool end_object() {
+        return close();
+    }
+
+    bool start_array(std::size_t) {
+        return skimming_ ? skim_open() : open(JsonValue::value_t::array) || begin_skim(1);
+    }
+
+    bool end_array() {
+        return close();
+    }
+
+    bool parse_error(std::size_t, const std::string&, const JsonValue::exception& ex) {
+        // Malformed input after a budget violation keeps the budget error
+        if (!skimming_) {
+            outcome_.error = JsonRpcError{PARSE_ERROR, "Parse error", JsonValue(ex.what())};
+        }
+        return false;
+    }
+
+    /// @return true if the message broke its budget (even if skimming finished)
+    bool rejected() const { return skimming_; }
+
+    /// Move the finished DOM out (only valid after a successful parse)
+    JsonValue take_root() { return std::move(root_); }
+
+private:
+    struct Frame {
+        JsonValue* value;
+        size_t count;
+    };
+
+    bool reject(const char* reason) {
+        outcome_.error = JsonRpcError{INVALID_REQUEST, "Invalid Request", JsonValue(reason)};
+        return false;
+    }
+
+    bool charge_string(size_t bytes) {
+        max_string_ = std::max(max_string_, bytes);
+        if (over(bytes, budget_->max_string_bytes)) {
+            return reject("string exceeds max_string_bytes");
+        }
+        return true;
+    }
+
+    bool open(JsonValue::value_t type) {
+        if (over(stack_.size() + 1, budget_->max_depth)) {
+            return reject("message exceeds max_depth");
+        }
+        max_depth_ = std::max(max_depth_, stack_.size() + 1);
+        JsonValue* slot = insert(JsonValue(type));
+        if (slot == nullptr) {
+            return false;
+        }
+        stack_.push_back(Frame{slot, 0});
+        return true;
+    }
+
+    bool add_value(JsonValue value) {
+        if (skimming_) {
+            return skim_value(std::move(value));
+        }
+        return insert(std::move(value)) != nullptr || begin_skim(0);
+    }
+
+    bool close() {
+        if (skimming_) {
+            --skim_depth_;
+        } else {
+            stack_.pop_back();
+        }
+        return true;
+    }
+
+    /**
+     * Switch to skimming after a rejection, if the reply still lacks the
+     * id or method
+     *
+     * @param unopened 1 if the rejected token opened a container that was
+     *        not pushed (its end will still arrive), else 0
+     * @return false to stop parsing
+     */
+    bool begin_skim(size_t unopened) {
+        if (outcome_.error.code != INVALID_REQUEST || (seen_id_ && !outcome_.method.empty())) {
+            return false;
+        }
+        skimming_ = true;
+        skim_depth_ = stack_.size() + unopened;
+        stack_.clear();
+        root_ = JsonValue();
+        return true;
+    }
+
+    bool skim_open() {
+        if (skim_depth_ == 1) {
+            skim_key_.clear();  // a container is neither a valid id nor a method
+        }
+        ++skim_depth_;
+        return true;
+    }
+
+    bool skim_value(JsonValue value) {
+        if (skim_depth_ != 1) {
+            return true;
+        }
+        if (skim_key_ == "id") {
+            outcome_.id = std::move(value);
+            seen_id_ = true;
+        } else if (skim_key_ == "method" && value.is_string() && outcome_.method.empty()) {
+            outcome_.method = value.get<std::string>();
+        }
+        skim_key_.clear();
+        return !(seen_id_ && !outcome_.method.empty());
+    }
+
+    /// Charge one node and place @p value in the current container
+    JsonValue* insert(JsonValue value) {
+        ++nodes_;
+        if (over(nodes_, budget_->max_nodes)) {
+            reject("message exceeds max_nodes");
+            return nullptr;
+        }
+
+        if (stack_.empty()) {
+            root_ = std::move(value);
+            return &root_;
+        }
+
+        Frame& frame = stack_.back();
+        if (frame.value->is_array()) {
+            ++frame.count;
+            max_elements_ = std::max(max_elements_, frame.count);
+            if (over(frame.count, budget_->max_array_elements)) {
+                reject("array exceeds max_array_elements");
+                return nullptr;
+            }
+            auto& array = frame.value->get_ref<JsonValue::array_t&>();
+            array.push_back(std::move(value));
+            return &array.back();
+        }
+
+        bool top_level = stack_.size() == 1;
+        auto& object = frame.value->get_ref<JsonValue::object_t&>();
+        auto it = object.insert_or_assign(std::move(key_), std::move(value)).first;
+        if (top_level && !note_envelope_member(it->first, it->second)) {
+            return nullptr;
+        }
+        return &it->second;
+    }
+
+    /// Capture id/method and switch to the method's budget once known
+    bool note_envelope_member(const std::string& name, const JsonValue& value) {
+        if (name == "id") {
+            outcome_.id = value;
+            seen_id_ = true;
+            return true;
+        }
+        if (name != "method" || !value.is_string()) {
+            return true;
+        }
+
+        outcome_.method = value.get<std::string>();
+        budget_ = &parser_.budget_for(outcome_.method);
+
+        // Everything parsed so far was charged against the envelope budget
+        if (over(max_string_, budget_->max_string_bytes)) {
+            return reject("string exceeds max_string_bytes");
+        }
+        if (over(max_elements_, budget_->max_array_elements)) {
+            return reject("array exceeds max_array_elements");
+        }
+        if (over(max_members_, budget_->max_object_members)) {
+            return reject("object exceeds max_object_members");
+        }
+        if (over(nodes_, budget_->max_nodes)) {
+            return reject("message exceeds max_nodes");
+        }
+        if (over(max_depth_, budget_->max_depth)) {
+            return reject("message exceeds max_depth");
+        }
+        return true;
+    }
+
+    const BudgetedParser& parser_;
+    ParseOutcome& outcome_;
+    const ParseBudget* budget_;
+
+    JsonValue root_;
+    std::vector<Frame> stack_;
+    std::string key_;
+
+    size_t nodes_ = 0;
+    size_t max_string_ = 0;
+    size_t max_elements_ = 0;
+    size_t max_members_ = 0;
+    size_t max_depth_ = 0;
+
+    bool seen_id_ = false;
+    bool skimming_ = false;
+    size_t skim_depth_ = 0;   ///< Open containers while skimming (1 = top level)
+    std::string skim_key_;    ///< Last top-level key while skimming
+};
+
+std::string ParseOutcome::error_response() const {
+    JsonValue response;
+    response["jsonrpc"] = "2.0";
+    response["id"] = id;
+    response["error"] = error.to_json();
+    return response.dump();
+}
+
+BudgetedParser::BudgetedParser(ParseBudget default_budget)
+    : default_budget_(default_budget)
+    , envelope_budget_(default_budget) {}
+
+void BudgetedParser::set_default_budget(const ParseBudget& budget) {
+    default_budget_ = budget;
+    recompute_envelope_budget();
+}
+
+void BudgetedParser::set_budget(const std::string& method, const ParseBudget& budget) {
+    method_budgets_[method] = budget;
+    recompute_envelope_budget();
+}
+
+const ParseBudget& BudgetedParser::budget_for(std::string_view method) const {
+    if (!method_budgets_.empty()) {
+        auto it = method_budgets_.find(std::string(method));
+        if (it != method_budgets_.end()) {
+            return it->second;
+        }
+    }
+    return default_budget_;
+}
+
+void BudgetedParser::recompute_envelope_budget() {
+    envelope_budget_ = default_budget_;
+    for (const auto& [method, budget] : method_budgets_) {
+        envelope_budget_.max_string_bytes = widest(envelope_budget_.max_string_bytes, budget.max_string_bytes);
+        envelope_budget_.max_array_elements = widest(envelope_budget_.max_array_elements, budget.max_array_elements);
+        envelope_budget_.max_object_members = widest(envelope_budget_.max_object_members, budget.max_object_members);
+        envelope_budget_.max_nodes = widest(envelope_budget_.max_nodes, budget.max_nodes);
+        envelope_budget_.max_depth = widest(envelope_budget_.max_depth, budget.max_depth);
+    }
+}
+
+ParseOutcome BudgetedParser::parse(std::string_view frame) const {
+    ParseOutcome outcome;
+    BudgetedSaxHandler handler(*this, outcome);
+    if (JsonValue::sax_parse(frame.begin(), frame.end(), &handler) && !handler.rejected()) {
+        outcome.message = handler.take_root();
+    }
+    return outcome;
+}
+
+} // namespace mcpp::core
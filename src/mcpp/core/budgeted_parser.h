@@ -0,0 +1,165 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef MCPP_CORE_BUDGETED_PARSER_H
+#define MCPP_CORE_BUDGETED_PARSER_H
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "json_rpc.h"
+#include "error.h"
+
+namespace mcpp::core {
+
+/**
+ * Resource limits applied while a message is being parsed
+ *
+ * Each limit is checked as the parser produces the corresponding token,
+ * so a message that blows its budget is abandoned at that point instead
+ * of being materialized first. A limit of 0 means "unlimited".
+ */
+struct ParseBudget {
+    /// Longest string value or object key, in bytes
+    size_t max_string_bytes = 8 * 1024 * 1024;
+
+    /// Most elements in any single array
+    size_t max_array_elements = 100000;
+
+    /// Most members in any single object
+    size_t max_object_members = 10000;
+
+    /// Most values (scalars, objects and arrays) in the whole message
+    size_t max_nodes = 1000000;
+
+    /// Deepest object/array nesting
+    size_t max_depth = 128;
+};
+
+/**
+ * Result of BudgetedParser::parse()
+ */
+struct ParseOutcome {
+    /// Parsed message; set only when the message was accepted
+    std::optional<JsonValue> message;
+
+    /// Why the message was rejected (PARSE_ERROR for malformed JSON,
+    /// INVALID_REQUEST for a budget violation). Meaningless on success.
+    JsonRpcError error{PARSE_ERROR, "Parse error", std::nullopt};
+
+    /// Top-level "id" if the message has one (also when rejected), else null
+    JsonValue id;
+
+    /// Top-level "method" if the message has one (also when rejected)
+    std::string method;
+
+    /// @return true if the message was accepted
+    bool ok() const { return message.has_value(); }
+
+    /**
+     * Serialized JSON-RPC error response for a rejected message
+     *
+     * Uses the id captured during parsing (null if none was seen).
+     */
+    std::string error_response() const;
+};
+
+/**
+ * SAX-driven JSON-RPC parser that enforces per-method budgets
+ *
+ * Replaces nlohmann::json::parse() for untrusted input. The message is fed
+ * through nlohmann's SAX interface and the DOM is built incrementally, with
+ * every string, container and node counted against a ParseBudget. On the
+ * first violation the DOM is dropped, so a hostile peer cannot make the
+ * process allocate an unbounded DOM.
+ *
+ * After a violation nothing more is built, but the rest of the message is
+ * still scanned for a top-level "id" and "method" that follow the
+ * oversized part, so requests are answered and only true notifications go
+ * unanswered.
+ *
+ * Budgets are chosen by the top-level "method" member. Until the method
+ * has been seen (JSON object members are unordered, so "params" may come
+ * first), the field-wise maximum of all configured budgets applies; when
+ * the method appears, everything counted so far is re-checked against that
+ * method's budget. Responses and methods without a budget of their own use
+ * the default budget.
+ *
+ * Note: a single string token is buffered in full by the lexer before it
+ * can be measured. Bound raw frame size at the transport (see
+ * transport::FrameLimits) to cap that too.
+ *
+ * Thread safety: Configure before use. parse() is const and may then be
+ * called from any number of threads.
+ */
+class BudgetedParser {
+public:
+    BudgetedParser() = default;
+
+    /**
+     * Create a parser with the given default budget
+     */
+    explicit BudgetedParser(ParseBudget default_budget);
+
+    /**
+     * Set the budget for messages without a method-specific one
+     */
+    void set_default_budget(const ParseBudget& budget);
+
+    /**
+     * Set the budget for one method (e.g. "tools/call")
+     */
+    void set_budget(const std::string& method, const ParseBudget& budget);
+
+    /**
+     * @return Budget that applies to @p method
+     */
+    const ParseBudget& budget_for(std::string_view method) const;
+
+    /**
+     * Parse one JSON-RPC message under its budget
+     *
+     * @param frame Complete message text
+     * @return Outcome carrying either the message or the rejection reason
+     */
+    ParseOutcome parse(std::string_view frame) const;
+
+private:
+    friend class BudgetedSaxHandler;
+
+    void recompute_envelope_budget();
+
+    ParseBudget default_budget_;
+    std::unordered_map<std::string, ParseBudget> method_budgets_;
+
+    /// Field-wise maximum of all budgets; applies until the method is known
+    ParseBudget envelope_budget_;
+};
+
+} // namespace mcpp::core
+
+#endif // MCPP_CORE_BUDGETED_PARSER_H
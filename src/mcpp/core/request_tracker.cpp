@@ -37,7 +37,7 @@ void RequestTracker::register_pending(
     ResponseCallback on_success,
     std::function<void(const JsonRpcError&)> on_error
 ) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<util::Mutex> lock(mutex_);
 
     pending_[id] = PendingRequest{
         .on_success = std::move(on_success),
@@ -47,7 +47,7 @@ void RequestTracker::register_pending(
 }
 
 std::optional<PendingRequest> RequestTracker::complete(RequestId id) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<util::Mutex> lock(mutex_);
 
     auto it = pending_.find(id);
     if (it == pending_.end()) {
@@ -62,13 +62,26 @@ std::optional<PendingRequest> RequestTracker::complete(RequestId id) {
 }
 
 void RequestTracker::cancel(RequestId id) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<util::Mutex> lock(mutex_);
 
     pending_.erase(id);
 }
 
+std::vector<std::pair<RequestId, PendingRequest>> RequestTracker::complete_all() {
+    std::lock_guard<util::Mutex> lock(mutex_);
+
+    std::vector<std::pair<RequestId, PendingRequest>> requests;
+    requests.reserve(pending_.size());
+    for (auto& [id, request] : pending_) {
+        requests.emplace_back(id, std::move(request));
+    }
+    pending_.clear();
+
+    return requests;
+}
+
 size_t RequestTracker::pending_count() const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<util::Mutex> lock(mutex_);
 
     return pending_.size();
 }
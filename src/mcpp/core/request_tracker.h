@@ -31,9 +31,12 @@
 #include <mutex>
 #include <optional>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "json_rpc.h"
 #include "error.h"
+#include "../util/concurrency.h"
 
 namespace mcpp::core {
 
@@ -67,8 +70,9 @@ struct PendingRequest {
  * - Pending requests tracked in mutex-protected unordered_map
  *
  * Thread safety:
- * - next_id() is lock-free (uses std::atomic)
+ * - next_id() is lock-free (uses util::Atomic)
  * - All other methods use mutex for pending map access
+ * - In MCPP_SINGLE_THREADED builds both compile to plain operations
  */
 class RequestTracker {
 public:
@@ -131,6 +135,17 @@ public:
      */
     void cancel(RequestId id);
 
+    /**
+     * Remove and return every pending request
+     *
+     * Used when the connection is lost, so callers can fail all
+     * in-flight requests at once instead of waiting for their timeouts.
+     * Thread-safe: uses mutex lock.
+     *
+     * @return The removed requests with their IDs
+     */
+    std::vector<std::pair<RequestId, PendingRequest>> complete_all();
+
     /**
      * Get the current count of pending requests
      *
@@ -142,13 +157,13 @@ public:
 
 private:
     // Atomic counter for lock-free ID generation
-    std::atomic<uint64_t> counter_{0};
+    util::Atomic<uint64_t> counter_{0};
 
     // Pending request storage, protected by mutex
     std::unordered_map<RequestId, PendingRequest> pending_;
 
     // Mutex protecting pending_ map
-    mutable std::mutex mutex_;
+    mutable util::Mutex mutex_{"core.request_tracker"};
 };
 
 } // namespace mcpp::core
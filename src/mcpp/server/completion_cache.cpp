@@ -0,0 +1,157 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+#include "mcpp/server/completion_cache.h"
+
+#include <mutex>
+#include <utility>
+
+namespace mcpp::server {
+
+namespace {
+
+bool starts_with_folded(std::string_view value, std::string_view prefix) {
+    if (value.size() < prefix.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < prefix.size(); ++i) {
+        char a = value[i];
+        char b = prefix[i];
+        if (a >= 'A' && a <= 'Z') a = static_cast<char>(a - 'A' + 'a');
+        if (b >= 'A' && b <= 'Z') b = static_cast<char>(b - 'A' + 'a');
+        if (a != b) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t estimate_bytes(const std::string& key, const std::vector<Completion>& values) {
+    size_t bytes = key.size() + sizeof(std::vector<Completion>);
+    for (const auto& completion : values) {
+        bytes += sizeof(Completion) + completion.value.size() +
+                 (completion.description ? completion.description->size() : 0);
+    }
+    return bytes;
+}
+
+} // anonymous namespace
+
+CompletionCache::CompletionCache(size_t capacity, size_t max_bytes)
+    : entries_(capacity), capacity_(capacity), max_bytes_(max_bytes) {}
+
+void CompletionCache::put_locked(std::string key, Values values) {
+    if (capacity_ == 0) {
+        return;
+    }
+    const size_t bytes = estimate_bytes(key, *values);
+    if (max_bytes_ > 0 && bytes > max_bytes_) {
+        return;  // would evict everything and still not fit
+    }
+    if (Entry* existing = entries_.get(key)) {
+        bytes_ -= existing->bytes;
+        entries_.erase(key);
+    }
+    // Evict here rather than in LruCache::put() so bytes_ stays exact
+    while (entries_.size() > 0 &&
+           (entries_.size() >= capacity_ || (max_bytes_ > 0 && bytes_ + bytes > max_bytes_))) {
+        bytes_ -= entries_.oldest()->bytes;
+        entries_.pop_oldest();
+    }
+    bytes_ += bytes;
+    entries_.put(std::move(key), Entry{std::move(values), bytes});
+}
+
+std::string CompletionCache::make_scope(std::string_view kind, std::string_view name,
+                                        std::string_view argument, std::string_view reference) {
+    // Length-prefix each field so no choice of names can collide
+    std::string scope;
+    for (std::string_view field : {kind, name, argument, reference}) {
+        scope.append(std::to_string(field.size()));
+        scope.push_back(':');
+        scope.append(field);
+    }
+    return scope;
+}
+
+std::string CompletionCache::make_key(std::string_view scope, std::string_view prefix) {
+    std::string key;
+    key.reserve(scope.size() + 1 + prefix.size());
+    key.append(scope);
+    key.push_back('\0');
+    key.append(prefix);
+    return key;
+}
+
+std::optional<CompletionCache::Values> CompletionCache::lookup(std::string_view scope,
+                                                               std::string_view prefix) {
+    std::lock_guard<util::Mutex> lock(mutex_);
+
+    std::string key = make_key(scope, prefix);
+    if (Entry* exact = entries_.get(key)) {
+        ++hits_;
+        return exact->values;
+    }
+
+    // Longest cached prefix of the current value
+    const size_t base = key.size() - prefix.size();
+    for (size_t len = prefix.size(); len-- > 0;) {
+        key.resize(base + len);
+        Entry* shorter = entries_.get(key);
+        if (shorter == nullptr) {
+            continue;
+        }
+
+        auto refined = std::make_shared<std::vector<Completion>>();
+        for (const auto& completion : *shorter->values) {
+            if (starts_with_folded(completion.value, prefix)) {
+                refined->push_back(completion);
+            }
+        }
+        Values result = std::move(refined);
+        put_locked(make_key(scope, prefix), result);
+        ++refinements_;
+        return result;
+    }
+
+    ++misses_;
+    return std::nullopt;
+}
+
+void CompletionCache::store(std::string_view scope, std::string_view prefix,
+                            std::vector<Completion> values) {
+    auto shared = std::make_shared<const std::vector<Completion>>(std::move(values));
+    std::lock_guard<util::Mutex> lock(mutex_);
+    put_locked(make_key(scope, prefix), std::move(shared));
+}
+
+void CompletionCache::clear() {
+    std::lock_guard<util::Mutex> lock(mutex_);
+    entries_.clear();
+    bytes_ = 0;
+}
+
+size_t CompletionCache::bytes() const {
+    std::lock_guard<util::Mutex> lock(mutex_);
+    return bytes_;
+}
+
+uint64_t CompletionCache::hits() const {
+    std::lock_guard<util::Mutex> lock(mutex_);
+    return hits_;
+}
+
+uint64_t CompletionCache::refinements() const {
+    std::lock_guard<util::Mutex> lock(mutex_);
+    return refinements_;
+}
+
+uint64_t CompletionCache::misses() const {
+    std::lock_guard<util::Mutex> lock(mutex_);
+    return misses_;
+}
+
+} // namespace mcpp::server
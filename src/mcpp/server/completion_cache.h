@@ -0,0 +1,140 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef MCPP_SERVER_COMPLETION_CACHE_H
+#define MCPP_SERVER_COMPLETION_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "mcpp/server/completion_index.h"
+#include "mcpp/util/concurrency.h"
+#include "mcpp/util/lru_cache.h"
+
+namespace mcpp::server {
+
+/**
+ * @brief Keystroke-aware cache of completion handler results
+ *
+ * Clients send a completion request per keystroke with a growing prefix.
+ * The cache stores the full (uncapped) candidate list a handler returned
+ * for each (scope, prefix), where scope identifies the prompt/resource,
+ * argument and reference context. A lookup for a prefix that extends a
+ * cached one is answered by filtering that cached list instead of calling
+ * the handler again; the filtered list is cached in turn, so each
+ * keystroke narrows a smaller set.
+ *
+ * Refinement assumes the handler's contract is prefix matching: every
+ * value it returns for "ab" starts with "ab" (ASCII case-insensitive),
+ * and every such value it would return for "abc" is among the values it
+ * returned for "ab". Only enable the cache for handlers that satisfy it.
+ *
+ * Thread safety: All methods are safe to call concurrently.
+ */
+class CompletionCache {
+public:
+    using Values = std::shared_ptr<const std::vector<Completion>>;
+
+    /**
+     * @param capacity Number of (scope, prefix) entries to keep
+     * @param max_bytes Approximate memory bound for the cached candidates
+     *                  (0 = bounded by @p capacity only); least recently
+     *                  used entries are evicted to stay under it
+     */
+    explicit CompletionCache(size_t capacity = 256, size_t max_bytes = 0);
+
+    // Non-copyable, non-movable (owns a mutex)
+    CompletionCache(const CompletionCache&) = delete;
+    CompletionCache& operator=(const CompletionCache&) = delete;
+    CompletionCache(CompletionCache&&) = delete;
+    CompletionCache& operator=(CompletionCache&&) = delete;
+
+    /**
+     * @brief Find candidates for a prefix, refining a shorter cached prefix
+     *
+     * @param scope Identifies what is being completed (see make_scope())
+     * @param prefix Current partial value
+     * @return Candidates for @p prefix, or nullopt if nothing usable is cached
+     */
+    std::optional<Values> lookup(std::string_view scope, std::string_view prefix);
+
+    /**
+     * @brief Cache the full candidate list a handler returned
+     */
+    void store(std::string_view scope, std::string_view prefix, std::vector<Completion> values);
+
+    /**
+     * @brief Drop all entries (call when prompts/resources/handlers change)
+     */
+    void clear();
+
+    /// @return Lookups answered by an exact (scope, prefix) entry
+    uint64_t hits() const;
+    /// @return Lookups answered by filtering a shorter prefix's entry
+    uint64_t refinements() const;
+    /// @return Lookups that required calling the handler
+    uint64_t misses() const;
+    /// @return Approximate bytes held by cached entries
+    size_t bytes() const;
+
+    /**
+     * @brief Build a scope key from the request fields
+     *
+     * @param kind "prompt" or "resource"
+     * @param name Prompt name or resource URI/template
+     * @param argument Argument being completed
+     * @param reference Serialized reference context ("" if none)
+     */
+    static std::string make_scope(std::string_view kind, std::string_view name,
+                                  std::string_view argument, std::string_view reference);
+
+private:
+    struct Entry {
+        Values values;
+        size_t bytes = 0;
+    };
+
+    static std::string make_key(std::string_view scope, std::string_view prefix);
+
+    /// Insert an entry, evicting to stay within capacity and max_bytes_ (mutex_ held)
+    void put_locked(std::string key, Values values);
+
+    mutable util::Mutex mutex_{"server.completion_cache"};
+    util::LruCache<std::string, Entry> entries_;
+    size_t capacity_;
+    size_t max_bytes_;
+    size_t bytes_ = 0;
+    uint64_t hits_ = 0;
+    uint64_t refinements_ = 0;
+    uint64_t misses_ = 0;
+};
+
+} // namespace mcpp::server
+
+#endif // MCPP_SERVER_COMPLETION_CACHE_H
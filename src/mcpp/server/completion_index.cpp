@@ -0,0 +1,477 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+#include "mcpp/server/completion_index.h"
+
+#include <algorithm>
+#include <numeric>
+#include <queue>
+#include <thread>
+#include <utility>
+
+namespace mcpp::server {
+
+namespace {
+
+char fold(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+} // anonymous namespace
+
+namespace detail {
+
+/**
+ * @brief Immutable sorted candidate set plus ranking structure
+ */
+struct CompletionSnapshot {
+    /// Candidates in key order
+    std::vector<CompletionCandidate> candidates;
+    /// Matching keys (folded if case-insensitive), back to back
+    std::string arena;
+    /// Start of key i in arena; offsets[n] == arena.size()
+    std::vector<uint32_t> offsets;
+    /// Weights in key order, kept apart from candidates for cache density
+    std::vector<uint32_t> weights;
+    /// Segment tree of argmax(weight) over [0, n); leaves start at leaf_base
+    std::vector<uint32_t> tree;
+    size_t leaf_base = 1;
+
+    /**
+     * @brief Materialized trie node for large key ranges
+     *
+     * Near the root, enumerating a node's children by binary search costs
+     * a cache miss per probe across the whole arena. Nodes spanning more
+     * than MATERIALIZE_MIN keys therefore store their child ranges; smaller
+     * ranges are bisected directly, which stays within a few cache lines.
+     */
+    struct TrieNode {
+        uint32_t terminal_end;  ///< End of the keys that stop at this node
+        uint32_t first_child;   ///< Index into children
+        uint32_t child_count;
+    };
+
+    struct TrieChild {
+        char c;
+        uint32_t lo;
+        uint32_t hi;
+        uint32_t node;  ///< Index into nodes, or NO_NODE if not materialized
+    };
+
+    static constexpr uint32_t NO_NODE = ~0u;
+    static constexpr size_t MATERIALIZE_MIN = 256;
+
+    std::vector<TrieNode> nodes;
+    std::vector<TrieChild> children;
+
+    size_t size() const { return candidates.size(); }
+
+    std::string_view key(size_t i) const {
+        return std::string_view(arena).substr(offsets[i], offsets[i + 1] - offsets[i]);
+    }
+
+    /// Better of two candidate indices (higher weight, then key order)
+    uint32_t better(uint32_t a, uint32_t b) const {
+        if (a >= size()) return b;
+        if (b >= size()) return a;
+        if (weights[a] != weights[b]) {
+            return weights[a] > weights[b] ? a : b;
+        }
+        return std::min(a, b);
+    }
+
+    void build_tree() {
+        const auto n = static_cast<uint32_t>(size());
+        leaf_base = 1;
+        while (leaf_base < n) leaf_base <<= 1;
+        tree.assign(2 * leaf_base, n);  // n is the "no candidate" sentinel
+        for (uint32_t i = 0; i < n; ++i) tree[leaf_base + i] = i;
+        for (size_t i = leaf_base - 1; i > 0; --i) tree[i] = better(tree[2 * i], tree[2 * i + 1]);
+    }
+
+    /// First key in [lo, hi) (all sharing depth chars) longer than depth
+    size_t terminal_end(size_t lo, size_t hi, size_t depth) const {
+        return partition(lo, hi, [&](size_t i) { return key(i).size() == depth; });
+    }
+
+    /// End of the run of keys in [lo, hi) with byte c at depth
+    size_t child_end(size_t lo, size_t hi, size_t depth, char c) const {
+        return partition(lo, hi, [&](size_t i) { return key(i)[depth] == c; });
+    }
+
+    /// Materialize trie nodes breadth-first, starting with the root
+    void build_trie() {
+        struct Pending { uint32_t lo, hi, depth; };
+        std::vector<Pending> queue{{0, static_cast<uint32_t>(size()), 0}};
+        for (size_t q = 0; q < queue.size(); ++q) {
+            const Pending node = queue[q];
+            TrieNode entry{static_cast<uint32_t>(terminal_end(node.lo, node.hi, node.depth)),
+                           static_cast<uint32_t>(children.size()), 0};
+            for (uint32_t lo = entry.terminal_end; lo < node.hi;) {
+                const char c = key(lo)[node.depth];
+                auto hi = static_cast<uint32_t>(child_end(lo, node.hi, node.depth, c));
+                uint32_t child_node = NO_NODE;
+                if (hi - lo > MATERIALIZE_MIN) {
+                    child_node = static_cast<uint32_t>(queue.size());
+                    queue.push_back({lo, hi, node.depth + 1});
+                }
+                children.push_back({c, lo, hi, child_node});
+                ++entry.child_count;
+                lo = hi;
+            }
+            nodes.push_back(entry);
+        }
+    }
+
+    /// Best candidate in [lo, hi)
+    uint32_t best_in(size_t lo, size_t hi) const {
+        auto result = static_cast<uint32_t>(size());
+        for (lo += leaf_base, hi += leaf_base; lo < hi; lo >>= 1, hi >>= 1) {
+            if (lo & 1) result = better(result, tree[lo++]);
+            if (hi & 1) result = better(result, tree[--hi]);
+        }
+        return result;
+    }
+
+    /// Index of first key >= prefix, and one past the last key starting with it
+    std::pair<size_t, size_t> prefix_range(std::string_view prefix, size_t lo, size_t hi) const {
+        size_t first = partition(lo, hi, [&](size_t i) {
+            return key(i).substr(0, prefix.size()) < prefix;
+        });
+        size_t last = partition(first, hi, [&](size_t i) {
+            return key(i).substr(0, prefix.size()) == prefix;
+        });
+        return {first, last};
+    }
+
+    /// First index in [lo, hi) for which pred is false (pred must be partitioned)
+    template<typename Pred>
+    static size_t partition(size_t lo, size_t hi, Pred pred) {
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (pred(mid)) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return lo;
+    }
+};
+
+} // namespace detail
+
+namespace {
+
+/// A key range whose keys all match at the same edit distance
+struct MatchRange {
+    size_t lo;
+    size_t hi;
+    unsigned distance;
+};
+
+/**
+ * @brief Fuzzy prefix search over the implicit trie of sorted keys
+ *
+ * A key matches at distance d when some prefix of it is within d edits
+ * of the query; ranges are emitted with the smallest such d, and are
+ * disjoint.
+ */
+class FuzzyWalker {
+public:
+    FuzzyWalker(const detail::CompletionSnapshot& snapshot, std::string_view query, unsigned max_edits)
+        : s_(snapshot), query_(query), max_edits_(max_edits) {}
+
+    std::vector<MatchRange> run() {
+        // One Levenshtein row per depth. A node deeper than
+        // |query| + max_edits has every row entry above max_edits and is
+        // pruned before its children are expanded, which bounds the depth.
+        const size_t width = query_.size() + 1;
+        rows_.assign((query_.size() + max_edits_ + 2) * width, 0);
+        std::iota(rows_.begin(), rows_.begin() + static_cast<std::ptrdiff_t>(width), 0u);
+        visit(0, s_.size(), 0, s_.nodes.empty() ? Snapshot::NO_NODE : 0, NO_MATCH);
+        return std::move(ranges_);
+    }
+
+private:
+    using Snapshot = detail::CompletionSnapshot;
+    static constexpr unsigned NO_MATCH = ~0u;
+
+    void visit(size_t lo, size_t hi, size_t depth, uint32_t node, unsigned best) {
+        const size_t width = query_.size() + 1;
+        const unsigned* row = rows_.data() + depth * width;
+        if (row[width - 1] <= max_edits_ && row[width - 1] < best) {
+            best = row[width - 1];
+        }
+        const unsigned floor = *std::min_element(row, row + width);
+        if (best == 0 || (best != NO_MATCH && floor >= best)) {
+            // No descendant can match more closely than this node already does
+            ranges_.push_back({lo, hi, best});
+            return;
+        }
+        if (floor > max_edits_) {
+            return;
+        }
+
+        // Keys that end at this node sort first
+        const bool materialized = node != Snapshot::NO_NODE;
+        size_t child = materialized ? s_.nodes[node].terminal_end : s_.terminal_end(lo, hi, depth);
+        if (child > lo && best != NO_MATCH) {
+            ranges_.push_back({lo, child, best});
+        }
+
+        unsigned* next = rows_.data() + (depth + 1) * width;
+        auto descend = [&](char c, size_t child_lo, size_t child_hi, uint32_t child_node) {
+            next[0] = row[0] + 1;
+            for (size_t j = 1; j < width; ++j) {
+                unsigned substitute = row[j - 1] + (query_[j - 1] == c ? 0u : 1u);
+                next[j] = std::min({row[j] + 1, next[j - 1] + 1, substitute});
+            }
+            visit(child_lo, child_hi, depth + 1, child_node, best);
+        };
+
+        if (materialized) {
+            const auto& entry = s_.nodes[node];
+            for (uint32_t i = 0; i < entry.child_count; ++i) {
+                const auto& c = s_.children[entry.first_child + i];
+                descend(c.c, c.lo, c.hi, c.node);
+            }
+            return;
+        }
+        while (child < hi) {
+            const char c = s_.key(child)[depth];
+            size_t end = s_.child_end(child, hi, depth, c);
+            descend(c, child, end, Snapshot::NO_NODE);
+            child = end;
+        }
+    }
+
+    const detail::CompletionSnapshot& s_;
+    std::string_view query_;
+    unsigned max_edits_;
+    std::vector<unsigned> rows_;
+    std::vector<MatchRange> ranges_;
+};
+
+} // anonymous namespace
+
+CompletionResult make_completion_result(std::vector<Completion> values, size_t limit) {
+    limit = std::min(limit, MAX_COMPLETION_VALUES);
+    CompletionResult result;
+    result.total = values.size();
+    result.has_more = values.size() > limit;
+    if (result.has_more) {
+        values.resize(limit);
+    }
+    result.values = std::move(values);
+    return result;
+}
+
+CompletionIndex::CompletionIndex() : CompletionIndex(Options{}) {}
+
+CompletionIndex::CompletionIndex(Options options, std::shared_ptr<util::Clock> clock)
+    : options_(options)
+    , clock_(clock ? std::move(clock) : util::Clock::system())
+    , snapshot_(make_snapshot({})) {}
+
+CompletionIndex::CompletionIndex(std::vector<CompletionCandidate> candidates)
+    : CompletionIndex(Options{}) {
+    build(std::move(candidates));
+}
+
+CompletionIndex::CompletionIndex(const std::vector<std::string>& values)
+    : CompletionIndex(Options{}) {
+    std::vector<CompletionCandidate> candidates;
+    candidates.reserve(values.size());
+    for (const auto& value : values) {
+        candidates.push_back(CompletionCandidate{value, 0, std::nullopt});
+    }
+    build(std::move(candidates));
+}
+
+CompletionIndex::~CompletionIndex() {
+    std::thread rebuild;
+    {
+        std::lock_guard<util::Mutex> lock(refresh_mutex_);
+        rebuild = std::move(rebuild_thread_);
+    }
+    if (rebuild.joinable()) {
+        rebuild.join();
+    }
+}
+
+std::shared_ptr<const CompletionIndex::Snapshot>
+CompletionIndex::make_snapshot(std::vector<CompletionCandidate> candidates) const {
+    auto folded = [&](const std::string& value) {
+        std::string key = value;
+        if (options_.case_insensitive) {
+            std::transform(key.begin(), key.end(), key.begin(), fold);
+        }
+        return key;
+    };
+
+    // Sort once by folded key; keep a permutation to avoid re-folding in comparisons
+    std::vector<std::string> keys;
+    keys.reserve(candidates.size());
+    for (const auto& candidate : candidates) {
+        keys.push_back(folded(candidate.value));
+    }
+    std::vector<uint32_t> order(candidates.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+
+    auto snapshot = std::make_shared<Snapshot>();
+    snapshot->candidates.reserve(candidates.size());
+    snapshot->weights.reserve(candidates.size());
+    snapshot->offsets.reserve(candidates.size() + 1);
+    size_t arena_size = 0;
+    for (const auto& key : keys) arena_size += key.size();
+    snapshot->arena.reserve(arena_size);
+
+    for (uint32_t i : order) {
+        snapshot->offsets.push_back(static_cast<uint32_t>(snapshot->arena.size()));
+        snapshot->arena.append(keys[i]);
+        snapshot->weights.push_back(candidates[i].weight);
+        snapshot->candidates.push_back(std::move(candidates[i]));
+    }
+    snapshot->offsets.push_back(static_cast<uint32_t>(snapshot->arena.size()));
+    snapshot->build_tree();
+    snapshot->build_trie();
+    return snapshot;
+}
+
+void CompletionIndex::build(std::vector<CompletionCandidate> candidates) {
+    auto next = make_snapshot(std::move(candidates));
+    std::lock_guard<util::Mutex> lock(snapshot_mutex_);
+    snapshot_ = std::move(next);
+}
+
+void CompletionIndex::set_source(Source source, std::chrono::milliseconds ttl) {
+    {
+        std::lock_guard<util::Mutex> lock(refresh_mutex_);
+        source_ = std::move(source);
+        ttl_ = ttl;
+    }
+    refresh();
+}
+
+void CompletionIndex::refresh() {
+    std::lock_guard<util::Mutex> lock(refresh_mutex_);
+    if (!source_) {
+        return;
+    }
+    auto next = make_snapshot(source_());
+    refreshed_at_ = clock_->steady_now();
+    // A background rebuild still running started from older data
+    ++source_generation_;
+    std::lock_guard<util::Mutex> swap_lock(snapshot_mutex_);
+    snapshot_ = std::move(next);
+}
+
+void CompletionIndex::maybe_refresh() const {
+    // Only one caller starts a rebuild; everyone keeps the current snapshot
+    std::unique_lock<util::Mutex> lock(refresh_mutex_, std::try_to_lock);
+    if (!lock.owns_lock() || !source_ || ttl_.count() <= 0 || rebuilding_) {
+        return;
+    }
+    const auto now = clock_->steady_now();
+    if (now - refreshed_at_ < ttl_) {
+        return;
+    }
+    // The previous rebuild has cleared rebuilding_ and is about to exit
+    if (rebuild_thread_.joinable()) {
+        rebuild_thread_.join();
+    }
+    refreshed_at_ = now;
+    rebuilding_ = true;
+    rebuild_thread_ = std::thread([this, source = source_, generation = source_generation_] {
+        std::shared_ptr<const Snapshot> next;
+        try {
+            next = make_snapshot(source());
+        } catch (...) {
+            // Keep serving the old snapshot; the next TTL expiry retries
+        }
+        std::lock_guard<util::Mutex> lock(refresh_mutex_);
+        rebuilding_ = false;
+        if (next && generation == source_generation_) {
+            std::lock_guard<util::Mutex> swap_lock(snapshot_mutex_);
+            snapshot_ = std::move(next);
+        }
+    });
+}
+
+std::shared_ptr<const CompletionIndex::Snapshot> CompletionIndex::snapshot() const {
+    std::lock_guard<util::Mutex> lock(snapshot_mutex_);
+    return snapshot_;
+}
+
+size_t CompletionIndex::size() const {
+    return snapshot()->size();
+}
+
+CompletionResult CompletionIndex::complete(std::string_view prefix, size_t limit) const {
+    maybe_refresh();
+    const auto s = snapshot();
+    limit = std::min(limit, MAX_COMPLETION_VALUES);
+
+    std::string query(prefix);
+    if (options_.case_insensitive) {
+        std::transform(query.begin(), query.end(), query.begin(), fold);
+    }
+
+    std::vector<MatchRange> ranges;
+    if (options_.max_edits > 0 && query.size() >= options_.min_fuzzy_length) {
+        ranges = FuzzyWalker(*s, query, options_.max_edits).run();
+        std::stable_sort(ranges.begin(), ranges.end(),
+                         [](const MatchRange& a, const MatchRange& b) { return a.distance < b.distance; });
+    } else {
+        auto [lo, hi] = s->prefix_range(query, 0, s->size());
+        if (lo < hi) {
+            ranges.push_back({lo, hi, 0});
+        }
+    }
+
+    CompletionResult result;
+    for (const auto& range : ranges) {
+        result.total += range.hi - range.lo;
+    }
+
+    // Top-k per distance tier: a heap of sub-ranges keyed by their best candidate
+    struct Span {
+        uint32_t best;
+        size_t lo;
+        size_t hi;
+    };
+    auto worse = [&](const Span& a, const Span& b) { return s->better(a.best, b.best) == b.best; };
+
+    size_t tier_begin = 0;
+    while (tier_begin < ranges.size() && result.values.size() < limit) {
+        size_t tier_end = tier_begin;
+        std::priority_queue<Span, std::vector<Span>, decltype(worse)> heap(worse);
+        while (tier_end < ranges.size() && ranges[tier_end].distance == ranges[tier_begin].distance) {
+            const auto& r = ranges[tier_end++];
+            heap.push(Span{s->best_in(r.lo, r.hi), r.lo, r.hi});
+        }
+        while (!heap.empty() && result.values.size() < limit) {
+            Span span = heap.top();
+            heap.pop();
+            const auto& candidate = s->candidates[span.best];
+            result.values.push_back(Completion{candidate.value, candidate.description});
+            if (span.lo < span.best) {
+                heap.push(Span{s->best_in(span.lo, span.best), span.lo, span.best});
+            }
+            if (span.best + 1 < span.hi) {
+                heap.push(Span{s->best_in(span.best + 1, span.hi), span.best + 1, span.hi});
+            }
+        }
+        tier_begin = tier_end;
+    }
+
+    result.has_more = result.total > result.values.size();
+    return result;
+}
+
+} // namespace mcpp::server
@@ -0,0 +1,221 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef MCPP_SERVER_COMPLETION_INDEX_H
+#define MCPP_SERVER_COMPLETION_INDEX_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "mcpp/util/clock.h"
+#include "mcpp/util/concurrency.h"
+
+namespace mcpp::server {
+
+namespace detail {
+struct CompletionSnapshot;
+} // namespace detail
+
+/**
+ * @brief Completion suggestion for argument autocompletion
+ *
+ * Represents a single completion value with an optional description.
+ * Matches the MCP CompleteResult format which returns an array of
+ * completion values with optional descriptions.
+ */
+struct Completion {
+    /// The completion value to insert
+    std::string value;
+
+    /// Optional human-readable description of this completion
+    std::optional<std::string> description;
+};
+
+/// Maximum number of values in a CompleteResult (MCP specification)
+inline constexpr size_t MAX_COMPLETION_VALUES = 100;
+
+/**
+ * @brief A completion result after capping
+ *
+ * Serialized as the spec's {"values": [...], "total": N, "hasMore": bool}.
+ */
+struct CompletionResult {
+    std::vector<Completion> values;
+    size_t total = 0;       ///< Number of matches before capping
+    bool has_more = false;  ///< true if values were truncated
+};
+
+/**
+ * @brief Cap a handler-produced completion list at the spec limit
+ *
+ * @param values All suggestions, best first
+ * @param limit Maximum values to keep (capped at MAX_COMPLETION_VALUES)
+ * @return Truncated values with total/has_more set from the full list
+ */
+CompletionResult make_completion_result(std::vector<Completion> values,
+                                        size_t limit = MAX_COMPLETION_VALUES);
+
+/**
+ * @brief A value that can be suggested by a CompletionIndex
+ */
+struct CompletionCandidate {
+    std::string value;
+    /// Ranking weight; higher weights are suggested first
+    uint32_t weight = 0;
+    std::optional<std::string> description;
+};
+
+/**
+ * @brief Prefix/fuzzy completion index over a fixed candidate set
+ *
+ * Candidates are sorted by their (optionally case-folded) key into one
+ * contiguous arena, which acts as an implicit prefix trie: every trie
+ * node is a contiguous key range found by binary search, so a prefix
+ * lookup is O(|prefix| log n) with no per-node allocation. A max-weight
+ * segment tree over the sorted order yields the top-k of any range in
+ * O(k log n), so ranking cost does not grow with the number of matches.
+ *
+ * Fuzzy matching walks the implicit trie with a Levenshtein row per
+ * depth and prunes subtrees whose row minimum exceeds max_edits. Exact
+ * prefix matches rank ahead of matches needing 1 edit, and so on; within
+ * a distance tier, candidates rank by weight.
+ *
+ * Case folding is ASCII-only; other bytes compare exactly.
+ *
+ * The candidate set can be static (build()) or pulled from a source
+ * that is re-read once its TTL expires (set_source()). Expired sources
+ * are re-read on a background thread and the new snapshot is swapped in
+ * atomically; complete() never waits for a rebuild and keeps answering
+ * from the previous snapshot until then.
+ *
+ * Thread safety: All methods are safe to call concurrently.
+ */
+class CompletionIndex {
+public:
+    /// Source of candidates for refreshable indexes
+    using Source = std::function<std::vector<CompletionCandidate>()>;
+
+    /// Matching options
+    struct Options {
+        /// Fold ASCII case for matching (suggested values keep their case)
+        bool case_insensitive = true;
+        /// Maximum edit distance for fuzzy prefix matches (0 disables fuzzy)
+        unsigned max_edits = 1;
+        /// Shortest prefix for which fuzzy matching is attempted
+        size_t min_fuzzy_length = 3;
+    };
+
+    CompletionIndex();
+    explicit CompletionIndex(Options options,
+                             std::shared_ptr<util::Clock> clock = util::Clock::default_clock());
+
+    /**
+     * @brief Create an index over a static candidate set
+     */
+    explicit CompletionIndex(std::vector<CompletionCandidate> candidates);
+
+    /**
+     * @brief Create an index over plain values (all weight 0)
+     */
+    explicit CompletionIndex(const std::vector<std::string>& values);
+
+    ~CompletionIndex();
+
+    // Non-copyable, non-movable (shared between registries via shared_ptr)
+    CompletionIndex(const CompletionIndex&) = delete;
+    CompletionIndex& operator=(const CompletionIndex&) = delete;
+    CompletionIndex(CompletionIndex&&) = delete;
+    CompletionIndex& operator=(CompletionIndex&&) = delete;
+
+    /**
+     * @brief Replace the candidate set
+     */
+    void build(std::vector<CompletionCandidate> candidates);
+
+    /**
+     * @brief Pull candidates from a source, re-reading it every @p ttl
+     *
+     * The source is called immediately on this thread. After the TTL
+     * expires, the next complete() starts a re-read on a background
+     * thread and returns from the old snapshot, as do all calls until the
+     * rebuild is swapped in. If the source throws there, the old snapshot
+     * stays until the next expiry. A zero TTL never refreshes
+     * automatically.
+     */
+    void set_source(Source source, std::chrono::milliseconds ttl);
+
+    /**
+     * @brief Re-read the source now (no-op without a source)
+     */
+    void refresh();
+
+    /**
+     * @brief Suggest completions for a partial value
+     *
+     * @param prefix Text typed so far
+     * @param limit Maximum values to return (capped at MAX_COMPLETION_VALUES)
+     * @return Ranked values with the total match count
+     */
+    CompletionResult complete(std::string_view prefix,
+                              size_t limit = MAX_COMPLETION_VALUES) const;
+
+    /// @return Number of candidates in the current snapshot
+    size_t size() const;
+
+private:
+    using Snapshot = detail::CompletionSnapshot;
+
+    std::shared_ptr<const Snapshot> snapshot() const;
+    void maybe_refresh() const;
+    std::shared_ptr<const Snapshot> make_snapshot(std::vector<CompletionCandidate> candidates) const;
+
+    Options options_;
+    std::shared_ptr<util::Clock> clock_;
+
+    mutable util::Mutex snapshot_mutex_{"server.completion_index"};
+    mutable std::shared_ptr<const Snapshot> snapshot_;
+
+    mutable util::Mutex refresh_mutex_{"server.completion_index.refresh"};
+    Source source_;
+    std::chrono::milliseconds ttl_{0};
+    mutable std::chrono::steady_clock::time_point refreshed_at_{};
+
+    /// Background rebuild started by maybe_refresh() (guarded by refresh_mutex_)
+    mutable std::thread rebuild_thread_;
+    mutable bool rebuilding_ = false;
+    /// Bumped by refresh() so an older background rebuild is discarded
+    uint64_t source_generation_ = 0;
+};
+
+} // namespace mcpp::server
+
+#endif // MCPP_SERVER_COMPLETION_INDEX_H
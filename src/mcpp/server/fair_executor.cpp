@@ -0,0 +1,125 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+#include "mcpp/server/fair_executor.h"
+
+#include <algorithm>
+
+namespace mcpp {
+namespace server {
+
+FairExecutor::FairExecutor()
+    : FairExecutor(Options{}) {}
+
+FairExecutor::FairExecutor(Options options)
+    : options_(std::move(options)) {
+    options_.threads = std::max<size_t>(1, options_.threads);
+    options_.quantum = std::max<uint32_t>(1, options_.quantum);
+    threads_.reserve(options_.threads);
+    for (size_t i = 0; i < options_.threads; ++i) {
+        threads_.emplace_back([this] { run(); });
+    }
+}
+
+FairExecutor::~FairExecutor() {
+    stop();
+}
+
+bool FairExecutor::submit(const std::string& flow_key, Job job, uint32_t cost) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) {
+            return false;
+        }
+        Flow& flow = flows_[flow_key];
+        if (options_.max_queued_per_flow > 0 && flow.jobs.size() >= options_.max_queued_per_flow) {
+            return false;
+        }
+        flow.jobs.emplace_back(std::move(job), std::max<uint32_t>(1, cost));
+        ++pending_;
+        if (!flow.active) {
+            flow.active = true;
+            flow.weight = options_.weight_of ? std::max<uint32_t>(1, options_.weight_of(flow_key)) : 1;
+            active_.push_back(&flow);
+        }
+    }
+    cv_.notify_one();
+    return true;
+}
+
+std::pair<FairExecutor::Job, FairExecutor::Flow*> FairExecutor::next_locked() {
+    for (;;) {
+        Flow* flow = active_.front();
+        if (!flow->credited) {
+            flow->deficit += static_cast<uint64_t>(options_.quantum) * flow->weight;
+            flow->credited = true;
+        }
+        auto& [job, cost] = flow->jobs.front();
+        if (flow->deficit >= cost) {
+            flow->deficit -= cost;
+            Job next = std::move(job);
+            flow->jobs.pop_front();
+            --pending_;
+            if (flow->jobs.empty()) {
+                // An idle flow does not bank credit for its next backlog
+                flow->deficit = 0;
+                flow->credited = false;
+                flow->active = false;
+                active_.pop_front();
+            }
+            return {std::move(next), flow};
+        }
+        // Out of credit: end the flow's turn
+        flow->credited = false;
+        active_.splice(active_.end(), active_, active_.begin());
+    }
+}
+
+void FairExecutor::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        cv_.wait(lock, [this] { return pending_ > 0 || stopping_; });
+        if (pending_ == 0) {
+            return;  // stopping and drained
+        }
+        auto [job, flow] = next_locked();
+        lock.unlock();
+        try {
+            job();
+        } catch (...) {
+            // A failing job must not take the worker thread down
+        }
+        lock.lock();
+        ++flow->completed;
+    }
+}
+
+void FairExecutor::stop() {
+    std::vector<std::thread> threads;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        threads.swap(threads_);
+    }
+    cv_.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+size_t FairExecutor::pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_;
+}
+
+uint64_t FairExecutor::completed(const std::string& flow) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = flows_.find(flow);
+    return it != flows_.end() ? it->second.completed : 0;
+}
+
+} // namespace server
+} // namespace mcpp
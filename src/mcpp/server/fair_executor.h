@@ -0,0 +1,147 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef MCPP_SERVER_FAIR_EXECUTOR_H
+#define MCPP_SERVER_FAIR_EXECUTOR_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace mcpp {
+namespace server {
+
+/**
+ * @brief Thread pool that shares its threads fairly between flows
+ *
+ * Jobs are submitted under a flow key (normally a tenant id). Each flow
+ * has its own FIFO queue, and the worker threads pick flows by deficit
+ * round robin: when a flow's turn comes it earns quantum x weight
+ * credits and runs jobs while it has credit for their cost. Over time
+ * each backlogged flow gets a share of the threads proportional to its
+ * weight, however many jobs the others queue, so one tenant's burst only
+ * delays that tenant.
+ *
+ * Weights come from Options::weight_of when a flow becomes backlogged,
+ * so with TenantManager::weight() a reconfigured weight applies from the
+ * flow's next backlog:
+ * ```cpp
+ * FairExecutor::Options options;
+ * options.weight_of = [tenants](const std::string& id) { return tenants->weight(id); };
+ * FairExecutor executor(options);
+ * executor.submit(tenants->tenant_id_for(session), [=] { handle(message); });
+ * ```
+ *
+ * Thread safety: All methods are safe to call concurrently. Jobs must
+ * not call stop().
+ */
+class FairExecutor {
+public:
+    using Job = std::function<void()>;
+
+    struct Options {
+        /// Worker threads
+        size_t threads = 4;
+        /// Credit a weight-1 flow earns per turn, in job cost units
+        uint32_t quantum = 1;
+        /// Weight of a flow (nullptr = every flow has weight 1)
+        std::function<uint32_t(const std::string& flow)> weight_of;
+        /// Queued jobs per flow before submit() refuses (0 = unbounded)
+        size_t max_queued_per_flow = 0;
+    };
+
+    /// Start with default options
+    FairExecutor();
+
+    /// Start the worker threads
+    explicit FairExecutor(Options options);
+
+    /// Calls stop()
+    ~FairExecutor();
+
+    // Non-copyable and non-movable
+    FairExecutor(const FairExecutor&) = delete;
+    FairExecutor& operator=(const FairExecutor&) = delete;
+    FairExecutor(FairExecutor&&) = delete;
+    FairExecutor& operator=(FairExecutor&&) = delete;
+
+    /**
+     * @brief Queue a job for a flow
+     *
+     * @param flow Flow key (e.g. tenant id)
+     * @param job Work to run on a worker thread
+     * @param cost Relative cost charged against the flow's credit (>= 1)
+     * @return false if stopped or the flow's queue is full
+     */
+    bool submit(const std::string& flow, Job job, uint32_t cost = 1);
+
+    /**
+     * @brief Stop accepting jobs, run those already queued, join the threads
+     */
+    void stop();
+
+    /// @return Jobs queued and not yet started
+    size_t pending() const;
+
+    /// @return Jobs of a flow that have finished
+    uint64_t completed(const std::string& flow) const;
+
+private:
+    struct Flow {
+        std::deque<std::pair<Job, uint32_t>> jobs;
+        uint64_t deficit = 0;
+        uint32_t weight = 1;
+        bool credited = false;  ///< Earned this turn's quantum already
+        bool active = false;    ///< In active_
+        uint64_t completed = 0;
+    };
+
+    void run();
+
+    /// Pick the next job by DRR (mutex_ held, at least one job queued)
+    std::pair<Job, Flow*> next_locked();
+
+    Options options_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::unordered_map<std::string, Flow> flows_;
+    std::list<Flow*> active_;
+    size_t pending_ = 0;
+    bool stopping_ = false;
+    std::vector<std::thread> threads_;
+};
+
+} // namespace server
+} // namespace mcpp
+
+#endif // MCPP_SERVER_FAIR_EXECUTOR_H
@@ -6,7 +6,12 @@
 
 #include "mcpp/server/mcp_server.h"
 
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+
 #include "mcpp/transport/transport.h"
+#include "mcpp/util/metrics.h"
 
 namespace mcpp {
 namespace server {
@@ -20,6 +25,14 @@ constexpr int JSONRPC_METHOD_NOT_FOUND = -32601;
 constexpr int JSONRPC_INVALID_PARAMS = -32602;
 constexpr int JSONRPC_INTERNAL_ERROR = -32603;
 
+// Implementation-defined server errors
+constexpr int MCPP_RATE_LIMITED = -32029;            // rejected by RateLimiter
+constexpr int MCPP_TENANT_BUDGET_EXCEEDED = -32030;  // over a TenantBudget
+constexpr int MCPP_SERVER_DRAINING = -32031;         // rejected during drain()
+
+/// Tenant the current request runs as (set by McpServer::TenantScope)
+thread_local Tenant* t_tenant = nullptr;
+
 /**
  * @brief Create a JSON-RPC error response
  */
@@ -34,6 +47,81 @@ nlohmann::json make_error(int code, const std::string& message, const nlohmann::
     };
 }
 
+/**
+ * @brief Build an MCP CompleteResult
+ *
+ * {"completion": {"values": [...], "total": N, "hasMore": bool}}; an
+ * unknown prompt/resource yields an empty value list.
+ */
+nlohmann::json make_complete_result(const std::optional<CompletionResult>& completions) {
+    nlohmann::json::array_t values;
+    size_t total = 0;
+    bool has_more = false;
+
+    if (completions.has_value()) {
+        values.reserve(completions->values.size());
+        for (const auto& completion : completions->values) {
+            values.emplace_back(completion.value);
+        }
+        total = completions->total;
+        has_more = completions->has_more;
+    }
+
+    return nlohmann::json{
+        {"completion", {
+            {"values", std::move(values)},
+            {"total", total},
+            {"hasMore", has_more}
+        }}
+    };
+}
+
+/**
+ * @brief Complete through the per-session cache when it applies
+ *
+ * Index-backed arguments and non-string values go straight to the
+ * registry. Otherwise the cache is consulted (exact hit or refinement of
+ * a shorter prefix) and the handler is only called on a miss, with its
+ * full candidate list cached before capping.
+ */
+template<typename Registry>
+std::optional<CompletionResult> complete_cached(
+    const Registry& registry,
+    CompletionCache* cache,
+    std::string_view kind,
+    const std::string& name,
+    const std::string& argument,
+    const nlohmann::json& value,
+    const std::optional<nlohmann::json>& reference
+) {
+    if (cache == nullptr || !(value.is_string() || value.is_null()) ||
+        registry.has_completion_index(name, argument)) {
+        return registry.complete(name, argument, value, reference);
+    }
+
+    const std::string prefix = value.is_string() ? value.get<std::string>() : std::string();
+    const std::string scope = CompletionCache::make_scope(
+        kind, name, argument, reference.has_value() ? reference->dump() : std::string());
+
+    if (auto cached = cache->lookup(scope, prefix)) {
+        const auto& values = **cached;
+        CompletionResult result;
+        result.total = values.size();
+        result.has_more = values.size() > MAX_COMPLETION_VALUES;
+        result.values.assign(values.begin(),
+                             values.begin() + static_cast<std::ptrdiff_t>(
+                                 std::min(values.size(), MAX_COMPLETION_VALUES)));
+        return result;
+    }
+
+    auto completions = registry.get_completion(name, argument, value, reference);
+    if (!completions.has_value()) {
+        return std::nullopt;
+    }
+    cache->store(scope, prefix, *completions);
+    return make_completion_result(std::move(*completions));
+}
+
 /**
  * @brief Create a JSON-RPC error response with data
  */
@@ -54,11 +142,75 @@ nlohmann::json make_error_with_data(
     };
 }
 
+nlohmann::json make_budget_error(const Tenant& tenant, const char* budget, size_t limit,
+                                 const nlohmann::json& id) {
+    return make_error_with_data(
+        MCPP_TENANT_BUDGET_EXCEEDED,
+        "Tenant budget exceeded",
+        {{"tenant", tenant.id()}, {"budget", budget}, {"limit", limit}},
+        id
+    );
+}
+
+/// Response limit of the current tenant (0 = none)
+size_t result_byte_limit() {
+    return t_tenant != nullptr ? t_tenant->config()->budget.max_result_bytes : 0;
+}
+
+/// Drop list entries the current tenant may not see
+template<typename Visible>
+nlohmann::json::array_t visible_only(std::vector<nlohmann::json> entries, Visible visible) {
+    nlohmann::json::array_t out;
+    out.reserve(entries.size());
+    for (auto& entry : entries) {
+        if (t_tenant == nullptr || visible(*t_tenant, entry)) {
+            out.push_back(std::move(entry));
+        }
+    }
+    return out;
+}
+
 } // anonymous namespace
 
-McpServer::McpServer(const std::string& name, const std::string& version)
+McpServer::McpServer(const std::string& name,
+                     const std::string& version,
+                     std::shared_ptr<util::Clock> clock)
     : server_info_{name, version},
-      transport_(std::nullopt) {}
+      transport_(std::nullopt),
+      clock_(clock ? std::move(clock) : util::Clock::system()),
+      task_manager_(clock_) {}
+
+/// Heartbeat plus the pings it is waiting on
+struct McpServer::Keepalive {
+    std::mutex mutex;
+    /// Pong callbacks by ping request id
+    std::unordered_map<std::string, util::Heartbeat::Pong> pending;
+    uint64_t next_id = 0;
+    /// Declared last so its thread stops before the rest is destroyed
+    std::unique_ptr<util::Heartbeat> heartbeat;
+};
+
+class McpServer::InFlightGuard {
+public:
+    explicit InFlightGuard(McpServer& server) : server_(server) {
+        server_.in_flight_.fetch_add(1);
+    }
+
+    ~InFlightGuard() {
+        if (server_.in_flight_.fetch_sub(1) == 1 && server_.draining_.load()) {
+            std::lock_guard<std::mutex> lock(server_.drain_mutex_);
+            server_.drain_cv_.notify_all();
+        }
+    }
+
+    InFlightGuard(const InFlightGuard&) = delete;
+    InFlightGuard& operator=(const InFlightGuard&) = delete;
+
+private:
+    McpServer& server_;
+};
+
+McpServer::~McpServer() = default;
 
 void McpServer::set_transport(transport::Transport& transport) {
     transport_ = &transport;
@@ -80,6 +232,7 @@ bool McpServer::register_resource(
     const std::string& mime_type,
     ResourceHandler handler
 ) {
+    invalidate_completions();
     return resources_.register_resource(uri, name, description, mime_type, std::move(handler));
 }
 
@@ -89,11 +242,364 @@ bool McpServer::register_prompt(
     const std::vector<PromptArgument>& arguments,
     PromptHandler handler
 ) {
+    invalidate_completions();
     return prompts_.register_prompt(name, description, arguments, std::move(handler));
 }
 
+bool McpServer::register_prompt(
+    const std::string& name,
+    const std::optional<std::string>& description,
+    const std::vector<PromptArgument>& arguments,
+    const std::vector<PromptMessageTemplate>& messages,
+    PromptTemplateOptions options
+) {
+    invalidate_completions();
+    return prompts_.register_prompt(name, description, arguments, messages, options);
+}
+
+void McpServer::set_prompt_completion_handler(const std::string& prompt_name,
+                                              CompletionHandler handler) {
+    invalidate_completions();
+    prompts_.set_completion_handler(prompt_name, std::move(handler));
+}
+
+void McpServer::set_prompt_completion_index(const std::string& prompt_name,
+                                            const std::string& argument_name,
+                                            std::shared_ptr<CompletionIndex> index) {
+    invalidate_completions();
+    prompts_.set_completion_index(prompt_name, argument_name, std::move(index));
+}
+
+void McpServer::set_resource_completion_handler(const std::string& resource_name,
+                                                CompletionHandler handler) {
+    invalidate_completions();
+    resources_.set_completion_handler(resource_name, std::move(handler));
+}
+
+void McpServer::set_resource_completion_index(const std::string& resource_name,
+                                              const std::string& argument_name,
+                                              std::shared_ptr<CompletionIndex> index) {
+    invalidate_completions();
+    resources_.set_completion_index(resource_name, argument_name, std::move(index));
+}
+
+void McpServer::enable_completion_cache(size_t capacity) {
+    completion_cache_ = capacity > 0 ? std::make_unique<CompletionCache>(capacity) : nullptr;
+}
+
+void McpServer::invalidate_completions() {
+    if (completion_cache_) {
+        completion_cache_->clear();
+    }
+    if (tenants_) {
+        tenants_->clear_caches();
+    }
+}
+
+std::shared_ptr<CompletionCache> McpServer::tenant_completion_cache() const {
+    // Tenants get their own cache only where the server caches at all
+    if (t_tenant == nullptr || !completion_cache_) {
+        return nullptr;
+    }
+    return t_tenant->completion_cache();
+}
+
+void McpServer::enable_cpu_accounting(bool enabled) {
+    tools_.set_cpu_accounting(enabled);
+    resources_.set_cpu_accounting(enabled);
+    prompts_.set_cpu_accounting(enabled);
+}
+
+void McpServer::set_parse_budget(const std::string& method, const core::ParseBudget& budget) {
+    parser_.set_budget(method, budget);
+}
+
+void McpServer::set_default_parse_budget(const core::ParseBudget& budget) {
+    parser_.set_default_budget(budget);
+}
+
+void McpServer::set_session_id(std::string session) {
+    session_id_ = std::move(session);
+}
+
+void McpServer::set_rate_limiter(std::shared_ptr<RateLimiter> limiter, std::string session) {
+    rate_limiter_ = std::move(limiter);
+    if (!session.empty()) {
+        session_id_ = std::move(session);
+    }
+}
+
+void McpServer::set_tenants(std::shared_ptr<TenantManager> tenants) {
+    tenants_ = std::move(tenants);
+}
+
+void McpServer::end_session(std::string_view session) {
+    if (tenants_) {
+        tenants_->unbind(session);
+    }
+    if (rate_limiter_) {
+        rate_limiter_->remove_session(std::string(session));
+    }
+}
+
+std::string_view McpServer::current_session() const {
+    return SessionScope::current().value_or(std::string_view(session_id_));
+}
+
+class McpServer::TenantScope {
+public:
+    TenantScope() = default;
+
+    ~TenantScope() {
+        if (tenant_) {
+            t_tenant = previous_;
+        }
+    }
+
+    TenantScope(const TenantScope&) = delete;
+    TenantScope& operator=(const TenantScope&) = delete;
+
+    void enter(std::shared_ptr<Tenant> tenant, Tenant::Admission admission) {
+        tenant_ = std::move(tenant);
+        admission_ = std::move(admission);
+        previous_ = t_tenant;
+        t_tenant = tenant_.get();
+    }
+
+    const Tenant* tenant() const { return tenant_.get(); }
+
+private:
+    std::shared_ptr<Tenant> tenant_;
+    Tenant::Admission admission_;
+    Tenant* previous_ = nullptr;
+};
+
+std::optional<nlohmann::json> McpServer::enter_tenant(const nlohmann::json& request_json,
+                                                      TenantScope& scope) {
+    auto id = request_json.find("id");
+    if (id == request_json.end()) {
+        return std::nullopt;  // notifications carry no work to budget
+    }
+    std::shared_ptr<Tenant> tenant = tenants_->tenant_for(current_session());
+    if (!tenant) {
+        return std::nullopt;
+    }
+    std::optional<Tenant::Admission> admission = Tenant::admit(tenant);
+    if (!admission) {
+        return make_budget_error(*tenant, "inFlight", tenant->config()->budget.max_in_flight, *id);
+    }
+    scope.enter(std::move(tenant), std::move(*admission));
+    return std::nullopt;
+}
+
+void McpServer::enable_keepalive(util::Heartbeat::Options options,
+                                 util::Heartbeat::DeadCallback on_dead) {
+    keepalive_.reset();
+    if (!transport_) {
+        return;
+    }
+    if (options.metrics_prefix == util::Heartbeat::Options{}.metrics_prefix) {
+        options.metrics_prefix = "server.heartbeat";
+    }
+    auto keepalive = std::make_unique<Keepalive>();
+    Keepalive* state = keepalive.get();
+    transport::Transport* transport = *transport_;
+    keepalive->heartbeat = std::make_unique<util::Heartbeat>(
+        std::move(options),
+        [state, transport](util::Heartbeat::Pong pong) {
+            std::string id;
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                // The heartbeat has at most one ping outstanding; anything
+                // still pending was already counted as missed
+                state->pending.clear();
+                id = "mcpp-ping-" + std::to_string(++state->next_id);
+                state->pending.emplace(id, std::move(pong));
+            }
+            transport->send("{\"jsonrpc\":\"2.0\",\"id\":\"" + id + "\",\"method\":\"ping\"}");
+        },
+        std::move(on_dead));
+    keepalive->heartbeat->start();
+    keepalive_ = std::move(keepalive);
+}
+
+void McpServer::disable_keepalive() {
+    keepalive_.reset();
+}
+
+std::optional<util::Heartbeat::Stats> McpServer::keepalive_stats() const {
+    if (!keepalive_) {
+        return std::nullopt;
+    }
+    return keepalive_->heartbeat->stats();
+}
+
+bool McpServer::observe_inbound(const nlohmann::json& message) {
+    keepalive_->heartbeat->on_activity();
+    if (message.contains("method")) {
+        return false;
+    }
+    auto id = message.find("id");
+    if (id == message.end() || !id->is_string()) {
+        return false;
+    }
+    util::Heartbeat::Pong pong;
+    {
+        std::lock_guard<std::mutex> lock(keepalive_->mutex);
+        auto it = keepalive_->pending.find(id->get_ref<const std::string&>());
+        if (it == keepalive_->pending.end()) {
+            return false;
+        }
+        pong = std::move(it->second);
+        keepalive_->pending.erase(it);
+    }
+    // Any response, even an error, proves the client is alive
+    pong();
+    return true;
+}
+
+void McpServer::begin_drain(std::chrono::milliseconds retry_after) {
+    drain_retry_after_ms_.store(retry_after.count());
+    draining_.store(true);
+}
+
+bool McpServer::drain(std::chrono::milliseconds timeout, std::chrono::milliseconds retry_after) {
+    begin_drain(retry_after);
+
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    bool idle = false;
+    {
+        std::unique_lock<std::mutex> lock(drain_mutex_);
+        while (true) {
+            idle = in_flight_.load() == 0 && task_manager_.count_active() == 0;
+            const auto now = std::chrono::steady_clock::now();
+            if (idle || now >= deadline) {
+                break;
+            }
+            // Requests notify on completion; tasks finish without notice,
+            // so poll them
+            drain_cv_.wait_for(lock, std::min<std::chrono::steady_clock::duration>(
+                                         deadline - now, std::chrono::milliseconds(10)));
+        }
+    }
+
+    if (!idle) {
+        task_manager_.cancel_active("Server shutting down");
+    }
+    task_manager_.cleanup_expired();
+    disable_keepalive();
+    return idle;
+}
+
+std::optional<nlohmann::json> McpServer::check_draining(const nlohmann::json& request_json) const {
+    auto method = request_json.find("method");
+    auto id = request_json.find("id");
+    if (method == request_json.end() || !method->is_string() || id == request_json.end()) {
+        return std::nullopt;
+    }
+    // Let clients collect results of tasks that are finishing
+    const std::string& name = method->get_ref<const std::string&>();
+    if (name == "tasks/get" || name == "tasks/result" || name == "tasks/cancel" || name == "tasks/list") {
+        return std::nullopt;
+    }
+    return make_error_with_data(
+        MCPP_SERVER_DRAINING,
+        "Server draining",
+        {{"retryAfterMs", drain_retry_after_ms_.load()}},
+        *id
+    );
+}
+
+std::optional<nlohmann::json> McpServer::check_rate_limit(const nlohmann::json& request_json) {
+    // Notifications are never limited: there is no response to carry
+    // the rejection, and dropping cancellations would waste more work
+    auto method = request_json.find("method");
+    auto id = request_json.find("id");
+    if (method == request_json.end() || !method->is_string() || id == request_json.end()) {
+        return std::nullopt;
+    }
+    const std::string& method_name = method->get_ref<const std::string&>();
+
+    std::string_view tool;
+    auto params = request_json.find("params");
+    if (method_name == "tools/call" && params != request_json.end() && params->is_object()) {
+        auto name = params->find("name");
+        if (name != params->end() && name->is_string()) {
+            tool = name->get_ref<const std::string&>();
+        }
+    }
+    const std::string_view session =
+        current_session();
+
+    RateLimiter::Decision decision = rate_limiter_->check(session, method_name, tool);
+    if (decision.allowed) {
+        return std::nullopt;
+    }
+    return make_error_with_data(
+        MCPP_RATE_LIMITED,
+        "Rate limit exceeded",
+        {{"retryAfterMs", decision.retry_after.count()}, {"scope", std::string(decision.scope)}},
+        *id
+    );
+}
+
+std::optional<nlohmann::json> McpServer::admit(const nlohmann::json& request_json,
+                                               TenantScope& scope) {
+    if (keepalive_ && observe_inbound(request_json)) {
+        return nlohmann::json(nlohmann::json::value_t::discarded);
+    }
+    // Liveness checks must not be throttled or charged to a tenant
+    auto method = request_json.find("method");
+    auto id = request_json.find("id");
+    if (method != request_json.end() && id != request_json.end() && *method == "ping") {
+        return nlohmann::json{{"jsonrpc", "2.0"}, {"id", *id}, {"result", nlohmann::json::object()}};
+    }
+    if (draining_.load()) {
+        if (auto rejected = check_draining(request_json)) {
+            return rejected;
+        }
+    }
+    if (rate_limiter_) {
+        if (auto rejected = check_rate_limit(request_json)) {
+            return rejected;
+        }
+    }
+    if (tenants_) {
+        if (auto rejected = enter_tenant(request_json, scope)) {
+            return rejected;
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<nlohmann::json> McpServer::check_result_bytes(size_t bytes, const nlohmann::json& id,
+                                                            const TenantScope& scope) const {
+    const size_t limit = result_byte_limit();
+    if (limit == 0 || bytes <= limit) {
+        return std::nullopt;
+    }
+    return make_budget_error(*scope.tenant(), "resultBytes", limit, id);
+}
+
 std::optional<nlohmann::json> McpServer::handle_request(
     const nlohmann::json& request_json
+) {
+    InFlightGuard in_flight(*this);
+    TenantScope tenant_scope;
+    if (auto answer = admit(request_json, tenant_scope)) {
+        if (answer->is_discarded()) {
+            return std::nullopt;
+        }
+        return answer;
+    }
+
+    // The result-bytes budget is checked by the serializing entry points;
+    // measuring the DOM here would serialize it twice
+    return dispatch_request(request_json);
+}
+
+std::optional<nlohmann::json> McpServer::dispatch_request(
+    const nlohmann::json& request_json
 ) {
     // Extract method, params, and id
     if (!request_json.contains("method")) {
@@ -141,6 +647,8 @@ std::optional<nlohmann::json> McpServer::handle_request(
         result = handle_tasks_result(params);
     } else if (method == "tasks/list") {
         result = handle_tasks_list(params);
+    } else if (method == "ping") {
+        result = nlohmann::json::object();
     } else {
         // For unknown methods on notifications, return no response (per JSON-RPC spec)
         if (is_notification) {
@@ -159,27 +667,96 @@ std::optional<nlohmann::json> McpServer::handle_request(
         return std::nullopt;
     }
 
-    nlohmann::json result_value = *result;
+    nlohmann::json& result_value = *result;
 
     // Check if handler returned an error response (has "error" key at top level)
     // Error responses should not be wrapped in "result"
     if (result_value.contains("error") && result_value["error"].is_object()) {
-        return nlohmann::json{
-            {"jsonrpc", "2.0"},
-            {"id", id},
-            {"error", result_value["error"]}
-        };
+        nlohmann::json response;
+        response["jsonrpc"] = "2.0";
+        response["id"] = std::move(id);
+        response["error"] = std::move(result_value["error"]);
+        return response;
     }
 
-    // Build successful response
-    return nlohmann::json{
-        {"jsonrpc", "2.0"},
-        {"id", id},
-        {"result", result_value}
-    };
+    // Build successful response. Assign rather than use an initializer
+    // list, which would deep-copy the (possibly large) result.
+    nlohmann::json response;
+    response["jsonrpc"] = "2.0";
+    response["id"] = std::move(id);
+    response["result"] = std::move(result_value);
+    return response;
+}
+
+std::optional<std::string> McpServer::handle_raw_message(std::string_view frame) {
+    core::ParseOutcome outcome = parser_.parse(frame);
+    if (!outcome.ok()) {
+        if (outcome.error.code == core::PARSE_ERROR || !outcome.id.is_null()) {
+            return outcome.error_response();
+        }
+        // No id to answer: a notification over budget is dropped silently
+        static util::Counter& dropped =
+            util::MetricsRegistry::global().counter("server.rejected_notifications");
+        dropped.add();
+        return std::nullopt;
+    }
+    return handle_request_serialized(*outcome.message);
+}
+
+std::optional<std::string> McpServer::handle_request_serialized(
+    const nlohmann::json& request_json
+) {
+    InFlightGuard in_flight(*this);
+    TenantScope tenant_scope;
+    if (auto answer = admit(request_json, tenant_scope)) {
+        if (answer->is_discarded()) {
+            return std::nullopt;
+        }
+        return answer->dump();
+    }
+
+    // resources/read is the one response whose payload comes from a
+    // SharedBuffer; write it without a DOM. Everything else goes through
+    // dispatch_request().
+    auto method = request_json.find("method");
+    auto id = request_json.find("id");
+    if (method != request_json.end() && id != request_json.end() &&
+        method->is_string() && method->get_ref<const std::string&>() == "resources/read") {
+        auto params = request_json.find("params");
+        if (params != request_json.end() && params->is_object()) {
+            auto uri = params->find("uri");
+            if (uri != params->end() && uri->is_string() &&
+                (t_tenant == nullptr || t_tenant->resource_visible(uri->get_ref<const std::string&>()))) {
+                std::string out = "{\"id\":" + id->dump() + ",\"jsonrpc\":\"2.0\",\"result\":";
+                if (resources_.write_resource(uri->get_ref<const std::string&>(), out)) {
+                    out.push_back('}');
+                    if (auto rejected = check_result_bytes(out.size(), *id, tenant_scope)) {
+                        return rejected->dump();
+                    }
+                    return out;
+                }
+            }
+        }
+    }
+
+    std::optional<nlohmann::json> response = dispatch_request(request_json);
+    if (!response) {
+        return std::nullopt;
+    }
+    std::string out = response->dump();
+    if (response->contains("result")) {
+        if (auto rejected = check_result_bytes(out.size(), (*response)["id"], tenant_scope)) {
+            return rejected->dump();
+        }
+    }
+    return out;
 }
 
 nlohmann::json McpServer::handle_initialize(const nlohmann::json& params) {
+    if (tenants_) {
+        tenants_->bind(current_session(), params);
+    }
+
     // Extract and store client capabilities if provided
     if (params.contains("capabilities") && params["capabilities"].is_object()) {
         const nlohmann::json& caps_json = params["capabilities"];
@@ -219,11 +796,10 @@ nlohmann::json McpServer::handle_initialize(const nlohmann::json& params) {
 }
 
 nlohmann::json McpServer::handle_tools_list() {
-    nlohmann::json::array_t tools_array;
-    std::vector<nlohmann::json> tools = tools_.list_tools();
-    for (auto& tool : tools) {
-        tools_array.push_back(std::move(tool));
-    }
+    nlohmann::json::array_t tools_array = visible_only(tools_.list_tools(),
+        [](const Tenant& tenant, const nlohmann::json& tool) {
+            return tenant.tool_visible(tool.value("name", ""));
+        });
     return nlohmann::json{
         {"tools", tools_array}
     };
@@ -264,14 +840,17 @@ nlohmann::json McpServer::handle_tools_call(const nlohmann::json& params) {
 
     // Create RequestContext with transport reference
     transport::Transport& transport = **transport_;
-    RequestContext ctx(request_id, transport);
+    RequestContext ctx(request_id, transport, DEFAULT_REQUEST_TIMEOUT, clock_.get());
 
     if (progress_token) {
         ctx.set_progress_token(*progress_token);
     }
 
-    // Call the tool
-    std::optional<nlohmann::json> result = tools_.call_tool(name, arguments, ctx);
+    // Call the tool (tools hidden from the tenant are not found)
+    std::optional<nlohmann::json> result;
+    if (t_tenant == nullptr || t_tenant->tool_visible(name)) {
+        result = tools_.call_tool(name, arguments, ctx);
+    }
     if (result) {
         return std::move(*result);
     } else {
@@ -285,11 +864,11 @@ nlohmann::json McpServer::handle_tools_call(const nlohmann::json& params) {
 }
 
 nlohmann::json McpServer::handle_resources_list() {
-    std::vector<nlohmann::json> resources = resources_.list_resources();
-    nlohmann::json::array_t resources_array;
-    for (auto& resource : resources) {
-        resources_array.push_back(std::move(resource));
-    }
+    nlohmann::json::array_t resources_array = visible_only(resources_.list_resources(),
+        [](const Tenant& tenant, const nlohmann::json& resource) {
+            return tenant.resource_visible(resource.contains("uri")
+                ? resource.value("uri", "") : resource.value("uriTemplate", ""));
+        });
     return nlohmann::json{
         {"resources", resources_array}
     };
@@ -306,7 +885,10 @@ nlohmann::json McpServer::handle_resources_read(const nlohmann::json& params) {
     }
 
     std::string uri = params["uri"].get<std::string>();
-    std::optional<nlohmann::json> result = resources_.read_resource(uri);
+    std::optional<nlohmann::json> result;
+    if (t_tenant == nullptr || t_tenant->resource_visible(uri)) {
+        result = resources_.read_resource(uri);
+    }
 
     if (result) {
         return std::move(*result);
@@ -321,11 +903,10 @@ nlohmann::json McpServer::handle_resources_read(const nlohmann::json& params) {
 }
 
 nlohmann::json McpServer::handle_prompts_list() {
-    std::vector<nlohmann::json> prompts = prompts_.list_prompts();
-    nlohmann::json::array_t prompts_array;
-    for (auto& prompt : prompts) {
-        prompts_array.push_back(std::move(prompt));
-    }
+    nlohmann::json::array_t prompts_array = visible_only(prompts_.list_prompts(),
+        [](const Tenant& tenant, const nlohmann::json& prompt) {
+            return tenant.prompt_visible(prompt.value("name", ""));
+        });
     return nlohmann::json{
         {"prompts", prompts_array}
     };
@@ -344,7 +925,10 @@ nlohmann::json McpServer::handle_prompts_get(const nlohmann::json& params) {
     std::string name = params["name"].get<std::string>();
     nlohmann::json arguments = params.value("arguments", nlohmann::json::object());
 
-    std::optional<nlohmann::json> result = prompts_.get_prompt(name, arguments);
+    std::optional<nlohmann::json> result;
+    if (t_tenant == nullptr || t_tenant->prompt_visible(name)) {
+        result = prompts_.get_prompt(name, arguments);
+    }
 
     if (result) {
         return std::move(*result);
@@ -405,29 +989,15 @@ nlohmann::json McpServer::handle_prompts_complete(const nlohmann::json& params)
         reference = params["reference"];
     }
 
-    // Get completion suggestions from the prompt registry
-    std::optional<std::vector<Completion>> completions =
-        prompts_.get_completion(name, argument, value, reference);
-
-    // Build MCP CompleteResult format
-    nlohmann::json::array_t completion_array;
-
-    if (completions.has_value()) {
-        for (const auto& completion : *completions) {
-            nlohmann::json completion_item;
-            completion_item["value"] = completion.value;
-
-            if (completion.description.has_value()) {
-                completion_item["description"] = *completion.description;
-            }
-
-            completion_array.push_back(std::move(completion_item));
-        }
+    if (t_tenant != nullptr && !t_tenant->prompt_visible(name)) {
+        return make_complete_result(std::nullopt);
     }
 
-    return nlohmann::json{
-        {"completion", std::move(completion_array)}
-    };
+    // Get capped completion suggestions from the prompt registry
+    std::shared_ptr<CompletionCache> tenant_cache = tenant_completion_cache();
+    return make_complete_result(complete_cached(
+        prompts_, tenant_cache ? tenant_cache.get() : completion_cache_.get(),
+        "prompt", name, argument, value, reference));
 }
 
 nlohmann::json McpServer::handle_resources_complete(const nlohmann::json& params) {
@@ -460,29 +1030,15 @@ nlohmann::json McpServer::handle_resources_complete(const nlohmann::json& params
         reference = params["reference"];
     }
 
-    // Get completion suggestions from the resource registry
-    std::optional<std::vector<Completion>> completions =
-        resources_.get_completion(name, argument, value, reference);
-
-    // Build MCP CompleteResult format
-    nlohmann::json::array_t completion_array;
-
-    if (completions.has_value()) {
-        for (const auto& completion : *completions) {
-            nlohmann::json completion_item;
-            completion_item["value"] = completion.value;
-
-            if (completion.description.has_value()) {
-                completion_item["description"] = *completion.description;
-            }
-
-            completion_array.push_back(std::move(completion_item));
-        }
+    if (t_tenant != nullptr && !t_tenant->resource_visible(name)) {
+        return make_complete_result(std::nullopt);
     }
 
-    return nlohmann::json{
-        {"completion", std::move(completion_array)}
-    };
+    // Get capped completion suggestions from the resource registry
+    std::shared_ptr<CompletionCache> tenant_cache = tenant_completion_cache();
+    return make_complete_result(complete_cached(
+        resources_, tenant_cache ? tenant_cache.get() : completion_cache_.get(),
+        "resource", name, argument, value, reference));
 }
 
 void McpServer::setup_registry_callbacks() {
@@ -537,6 +1093,10 @@ void McpServer::send_list_changed_notification(const std::string& method) {
     (*transport_)->send(notification.dump());
 }
 
+bool McpServer::task_visible(const Task& task) const {
+    return t_tenant == nullptr || task.owner == t_tenant->id();
+}
+
 nlohmann::json McpServer::handle_tasks_send(const nlohmann::json& params) {
     // Extract optional TTL and poll interval
     std::optional<uint64_t> ttl_ms;
@@ -549,8 +1109,16 @@ nlohmann::json McpServer::handle_tasks_send(const nlohmann::json& params) {
         poll_interval_ms = params["pollIntervalMs"].get<uint64_t>();
     }
 
-    // Create the task
-    std::string task_id = task_manager_.create_task(ttl_ms, poll_interval_ms);
+    // Create the task in the tenant's namespace
+    const std::string owner = t_tenant != nullptr ? t_tenant->id() : std::string();
+    if (t_tenant != nullptr) {
+        const size_t max_tasks = t_tenant->config()->budget.max_tasks;
+        if (max_tasks > 0 && task_manager_.count_tasks(owner) >= max_tasks) {
+            nlohmann::json response = make_budget_error(*t_tenant, "tasks", max_tasks, nullptr);
+            return nlohmann::json{{"error", std::move(response["error"])}};
+        }
+    }
+    std::string task_id = task_manager_.create_task(ttl_ms, poll_interval_ms, owner);
 
     // Get the created task metadata
     std::optional<Task> task = task_manager_.get_task(task_id);
@@ -567,8 +1135,8 @@ nlohmann::json McpServer::handle_tasks_send(const nlohmann::json& params) {
     return nlohmann::json{
         {"id", task->task_id},
         {"status", to_string(task->status)},
-        {"createdAt", task->created_at},
-        {"lastUpdatedAt", task->last_updated_at},
+        {"createdAt", TaskManager::format_timestamp(task->created_at)},
+        {"lastUpdatedAt", TaskManager::format_timestamp(task->last_updated_at)},
         {"ttlMs", task->ttl_ms.has_value() ? nlohmann::json(*task->ttl_ms) : nlohmann::json()},
         {"pollIntervalMs", task->poll_interval_ms.has_value() ? nlohmann::json(*task->poll_interval_ms) : nlohmann::json()}
     };
@@ -587,9 +1155,9 @@ nlohmann::json McpServer::handle_tasks_get(const nlohmann::json& params) {
 
     std::string task_id = params["id"].get<std::string>();
 
-    // Get the task
+    // Get the task (other tenants' tasks are not found)
     std::optional<Task> task = task_manager_.get_task(task_id);
-    if (!task) {
+    if (!task || !task_visible(*task)) {
         return nlohmann::json{
             {"error", {
                 {"code", JSONRPC_INVALID_PARAMS},
@@ -602,8 +1170,8 @@ nlohmann::json McpServer::handle_tasks_get(const nlohmann::json& params) {
     nlohmann::json result = {
         {"id", task->task_id},
         {"status", to_string(task->status)},
-        {"createdAt", task->created_at},
-        {"lastUpdatedAt", task->last_updated_at}
+        {"createdAt", TaskManager::format_timestamp(task->created_at)},
+        {"lastUpdatedAt", TaskManager::format_timestamp(task->last_updated_at)}
     };
 
     if (task->status_message.has_value()) {
@@ -633,7 +1201,8 @@ nlohmann::json McpServer::handle_tasks_cancel(const nlohmann::json& params) {
     std::string task_id = params["id"].get<std::string>();
 
     // Cancel the task
-    bool cancelled = task_manager_.cancel_task(task_id);
+    std::optional<Task> existing = task_manager_.get_task(task_id);
+    bool cancelled = existing && task_visible(*existing) && task_manager_.cancel_task(task_id);
     if (!cancelled) {
         return nlohmann::json{
             {"error", {
@@ -650,7 +1219,8 @@ nlohmann::json McpServer::handle_tasks_cancel(const nlohmann::json& params) {
     nlohmann::json result = {
         {"id", task_id},
         {"status", "cancelled"},
-        {"lastUpdatedAt", task_manager_.get_timestamp()}
+        {"lastUpdatedAt", task ? TaskManager::format_timestamp(task->last_updated_at)
+                               : task_manager_.current_timestamp()}
     };
 
     if (task && task->status_message.has_value()) {
@@ -674,7 +1244,11 @@ nlohmann::json McpServer::handle_tasks_result(const nlohmann::json& params) {
     std::string task_id = params["id"].get<std::string>();
 
     // Get the task result
-    std::optional<nlohmann::json> result = task_manager_.get_result(task_id);
+    std::optional<Task> task = task_manager_.get_task(task_id);
+    std::optional<nlohmann::json> result;
+    if (task && task_visible(*task)) {
+        result = task_manager_.get_result(task_id);
+    }
     if (!result) {
         return nlohmann::json{
             {"error", {
@@ -698,7 +1272,11 @@ nlohmann::json McpServer::handle_tasks_list(const nlohmann::json& params) {
     }
 
     // List tasks
-    TaskManager::PaginatedResult<Task> page = task_manager_.list_tasks(cursor);
+    std::optional<std::string> owner;
+    if (t_tenant != nullptr) {
+        owner = t_tenant->id();
+    }
+    TaskManager::PaginatedResult<Task> page = task_manager_.list_tasks(cursor, owner);
 
     // Build result items array
     nlohmann::json::array_t items_array;
@@ -706,8 +1284,8 @@ nlohmann::json McpServer::handle_tasks_list(const nlohmann::json& params) {
         nlohmann::json item = {
             {"id", task.task_id},
             {"status", to_string(task.status)},
-            {"createdAt", task.created_at},
-            {"lastUpdatedAt", task.last_updated_at}
+            {"createdAt", TaskManager::format_timestamp(task.created_at)},
+            {"lastUpdatedAt", TaskManager::format_timestamp(task.last_updated_at)}
         };
 
         if (task.status_message.has_value()) {
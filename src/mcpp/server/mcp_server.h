@@ -25,17 +25,28 @@
 #ifndef MCPP_SERVER_MCP_SERVER_H
 #define MCPP_SERVER_MCP_SERVER_H
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 
 #include <nlohmann/json.hpp>
 
+#include "mcpp/core/budgeted_parser.h"
 #include "mcpp/protocol/capabilities.h"
 #include "mcpp/protocol/types.h"
+#include "mcpp/server/completion_cache.h"
 #include "mcpp/server/prompt_registry.h"
+#include "mcpp/server/rate_limiter.h"
+#include "mcpp/server/session_scope.h"
 #include "mcpp/server/resource_registry.h"
 #include "mcpp/server/task_manager.h"
+#include "mcpp/server/tenant.h"
 #include "mcpp/server/tool_registry.h"
+#include "mcpp/util/heartbeat.h"
 
 namespace mcpp {
 
@@ -111,16 +122,19 @@ public:
      *
      * @param name Server name (reported in initialize response)
      * @param version Server version (reported in initialize response)
+     * @param clock Time source for task timestamps/expiry and request
+     *              deadlines (defaults to util::Clock::default_clock())
      */
     explicit McpServer(
         const std::string& name = "mcpp-server",
-        const std::string& version = "1.0.0"
+        const std::string& version = "1.0.0",
+        std::shared_ptr<util::Clock> clock = util::Clock::default_clock()
     );
 
     /**
      * @brief Destructor
      */
-    ~McpServer() = default;
+    ~McpServer();
 
     // Non-copyable
     McpServer(const McpServer&) = delete;
@@ -190,6 +204,242 @@ public:
         PromptHandler handler
     );
 
+    /**
+     * @brief Register a declarative prompt built from message templates
+     *
+     * See PromptRegistry::register_prompt(..., messages, options).
+     *
+     * @param name Unique prompt name
+     * @param description Optional description
+     * @param arguments List of argument definitions
+     * @param messages Message templates with {{argument}} placeholders
+     * @param options Render cache configuration
+     * @return true if registration succeeded, false if name already exists
+     */
+    bool register_prompt(
+        const std::string& name,
+        const std::optional<std::string>& description,
+        const std::vector<PromptArgument>& arguments,
+        const std::vector<PromptMessageTemplate>& messages,
+        PromptTemplateOptions options = {}
+    );
+
+    /**
+     * @brief Set a completion handler for a prompt's arguments
+     *
+     * @param prompt_name Prompt the handler completes
+     * @param handler Function returning suggestions, best first
+     */
+    void set_prompt_completion_handler(const std::string& prompt_name, CompletionHandler handler);
+
+    /**
+     * @brief Serve a prompt argument's completions from an index
+     *
+     * @param prompt_name Prompt the argument belongs to
+     * @param argument_name Argument to complete
+     * @param index Candidate index (may be shared; nullptr removes it)
+     */
+    void set_prompt_completion_index(const std::string& prompt_name,
+                                     const std::string& argument_name,
+                                     std::shared_ptr<CompletionIndex> index);
+
+    /**
+     * @brief Set a completion handler for a resource's arguments
+     *
+     * @param resource_name Resource URI or template the handler completes
+     * @param handler Function returning suggestions, best first
+     */
+    void set_resource_completion_handler(const std::string& resource_name, CompletionHandler handler);
+
+    /**
+     * @brief Serve a resource argument's completions from an index
+     *
+     * @param resource_name Resource URI or template the argument belongs to
+     * @param argument_name Argument to complete
+     * @param index Candidate index (may be shared; nullptr removes it)
+     */
+    void set_resource_completion_index(const std::string& resource_name,
+                                       const std::string& argument_name,
+                                       std::shared_ptr<CompletionIndex> index);
+
+    /**
+     * @brief Cache completion handler results across keystrokes
+     *
+     * Handler-backed prompts/complete and resources/complete results are
+     * cached per (prompt/resource, argument, reference, prefix); a longer
+     * prefix is answered by filtering the cached candidates of a shorter
+     * one instead of calling the handler. Requires handlers to follow the
+     * prefix-matching contract described in CompletionCache. The cache is
+     * cleared whenever prompts, resources or completion sources change.
+     * Index-backed arguments bypass the cache.
+     *
+     * @param capacity Entries to keep (0 disables the cache)
+     */
+    void enable_completion_cache(size_t capacity = 256);
+
+    /**
+     * @brief The completion cache, or nullptr if not enabled
+     */
+    const CompletionCache* completion_cache() const { return completion_cache_.get(); }
+
+    /**
+     * @brief Enable or disable per-handler CPU accounting
+     *
+     * Turns on CPU accounting in the tool, resource and prompt registries.
+     * Handler CPU time, instructions and cache misses are then aggregated
+     * per name in util::MetricsRegistry::global() under "tool.<name>.*",
+     * "resource.<uri>.*" and "prompt.<name>.*". Uses perf_event_open where
+     * permitted and CLOCK_THREAD_CPUTIME_ID otherwise.
+     *
+     * @param enabled true to record CPU metrics
+     */
+    void enable_cpu_accounting(bool enabled = true);
+
+    /**
+     * @brief Set the parse budget for one method
+     *
+     * Applies to messages fed through handle_raw_message(). See
+     * core::BudgetedParser for how budgets are enforced.
+     *
+     * @param method Method name (e.g. "tools/call")
+     * @param budget Limits for that method's messages
+     */
+    void set_parse_budget(const std::string& method, const core::ParseBudget& budget);
+
+    /**
+     * @brief Set the parse budget for methods without their own budget
+     */
+    void set_default_parse_budget(const core::ParseBudget& budget);
+
+    /**
+     * @brief Set the session this server serves outside a SessionScope
+     *
+     * Servers dedicated to one client (e.g. stdio) name it here; servers
+     * shared by several sessions open a SessionScope per request instead.
+     * Used for per-session rate limits and tenant resolution.
+     */
+    void set_session_id(std::string session);
+
+    /**
+     * @brief Apply rate limits to incoming requests
+     *
+     * Every request (not notifications) is charged against the limiter
+     * before it is routed. Over-limit requests are answered at once with
+     * error -32029 "Rate limit exceeded" whose data holds
+     * {"retryAfterMs": N, "scope": "global"|"method"|"tool"|"session"}.
+     *
+     * The session level is charged to the innermost open SessionScope on
+     * the calling thread, or to the set_session_id() session if there is
+     * none. The limiter may be shared by many servers.
+     *
+     * @param limiter Limits to apply (nullptr disables limiting)
+     * @param session If not empty, passed to set_session_id()
+     */
+    void set_rate_limiter(std::shared_ptr<RateLimiter> limiter, std::string session = {});
+
+    /**
+     * @brief Run each request as the tenant of its session
+     *
+     * Sessions are bound to a tenant on initialize (see TenantManager).
+     * While a request runs as a tenant:
+     * - tools/list, resources/list and prompts/list show only what the
+     *   tenant may see; calls, reads, gets and completions of anything
+     *   else fail as if it were not registered
+     * - tasks are created in the tenant's namespace, and tasks/ methods
+     *   only see that namespace
+     * - completions use the tenant's own cache (if the completion cache
+     *   is enabled)
+     * - budgets are enforced; an exceeded budget is answered with error
+     *   -32030 "Tenant budget exceeded" whose data holds
+     *   {"tenant": id, "budget": "inFlight"|"tasks"|"resultBytes", "limit": N}
+     * - resultBytes is checked where the response is serialized
+     *   (handle_request_serialized(), handle_raw_message()); handle_request()
+     *   returns a DOM and does not measure it
+     *
+     * The manager may be shared by many servers (one per HttpServer shard)
+     * so budgets span them.
+     *
+     * @param tenants Tenant directory (nullptr disables tenancy)
+     */
+    void set_tenants(std::shared_ptr<TenantManager> tenants);
+
+    /**
+     * @brief Release what the server keeps for a session that has ended
+     *
+     * Drops the session's tenant binding and rate-limit bucket. Transports serving several
+     * sessions call this when one closes (see
+     * HttpServer::Options::on_session_closed).
+     *
+     * @param session Session id as passed to SessionScope
+     */
+    void end_session(std::string_view session);
+
+    /**
+     * @brief Ping the client periodically and detect a dead client
+     *
+     * Sends {"method":"ping"} requests through the transport on an idle
+     * connection and matches the client's responses as they come back
+     * through handle_request(). Round-trip time and jitter are exported
+     * under "server.heartbeat.*" metrics unless options.metrics_prefix is
+     * changed. After options.max_missed missed pongs in a row, @p on_dead
+     * runs once so the owner can drop the session.
+     *
+     * Requires a transport (see set_transport()); replaces any previous
+     * keepalive.
+     *
+     * @param options Ping interval, pong timeout and miss threshold
+     * @param on_dead Called from the heartbeat thread when the client is dead
+     */
+    void enable_keepalive(util::Heartbeat::Options options,
+                          util::Heartbeat::DeadCallback on_dead = {});
+
+    /// Stop sending keepalive pings
+    void disable_keepalive();
+
+    /// @return Keepalive statistics (RTT, misses), or nullopt if not enabled
+    std::optional<util::Heartbeat::Stats> keepalive_stats() const;
+
+    /**
+     * @brief Stop admitting new work
+     *
+     * From now on initialize and every other request is answered with
+     * error -32031 "Server draining", whose data holds {"retryAfterMs": N}
+     * so clients retry (against the replacement server). Notifications,
+     * ping and tasks/get, tasks/result, tasks/cancel and tasks/list are
+     * still served so clients can collect work that is finishing.
+     * Requests already running are unaffected. Idempotent.
+     *
+     * @param retry_after Delay suggested to rejected clients
+     */
+    void begin_drain(std::chrono::milliseconds retry_after = std::chrono::milliseconds(1000));
+
+    /**
+     * @brief Drain the server before shutting it down
+     *
+     * Calls begin_drain(), then waits until no request is running and no
+     * task is working or waiting for input, or until @p timeout. Tasks
+     * still active at the deadline are cancelled. Finally expired tasks
+     * are purged and the keepalive is stopped.
+     *
+     * For a zero-downtime restart of an HTTP server, hand the listening
+     * sockets to the new process (transport::HttpServer::release_listeners),
+     * drain every McpServer, then HttpServer::drain() to flush responses.
+     *
+     * Must not be called from a request handler.
+     *
+     * @param timeout Longest time to wait for in-flight work
+     * @param retry_after Delay suggested to rejected clients
+     * @return true if all in-flight work finished before the deadline
+     */
+    bool drain(std::chrono::milliseconds timeout,
+               std::chrono::milliseconds retry_after = std::chrono::milliseconds(1000));
+
+    /// @return true once begin_drain() or drain() has been called
+    bool is_draining() const { return draining_.load(); }
+
+    /// @return Requests being handled right now
+    size_t in_flight_requests() const { return in_flight_.load(); }
+
     /**
      * @brief Handle a JSON-RPC request
      *
@@ -211,6 +461,10 @@ public:
      * - tasks/cancel: Cancel a task
      * - tasks/result: Get task result
      * - tasks/list: List all tasks
+     * - ping: Liveness check (answered before rate limits and tenancy)
+     *
+     * Responses to keepalive pings (see enable_keepalive()) are consumed
+     * and answered with nullopt.
      *
      * @param request_json The JSON-RPC request object
      * @return Optional JSON-RPC response (nullopt for notifications)
@@ -219,7 +473,108 @@ public:
         const nlohmann::json& request_json
     );
 
+    /**
+     * @brief Handle a JSON-RPC request and return the serialized response
+     *
+     * Equivalent to handle_request(request_json)->dump(), but
+     * resources/read responses are written directly from the handler's
+     * SharedBuffer (see ResourceRegistry::write_resource), so large text
+     * or blob payloads are never copied into a JSON DOM. Transports that
+     * send strings should prefer this overload.
+     *
+     * @param request_json The JSON-RPC request object
+     * @return Serialized JSON-RPC response (nullopt for notifications)
+     */
+    std::optional<std::string> handle_request_serialized(
+        const nlohmann::json& request_json
+    );
+
+    /**
+     * @brief Parse and handle a raw JSON-RPC frame
+     *
+     * Parses with a core::BudgetedParser, so oversized or malformed input
+     * is rejected while it is being parsed, before a DOM is built for it.
+     * Rejections are answered with a JSON-RPC error: -32700 for malformed
+     * JSON, -32600 for a budget violation (error.data names the limit).
+     * A budget violation is answered only if the request's id was seen;
+     * otherwise (e.g. an oversized notification) the message is dropped
+     * and counted in the "server.rejected_notifications" counter, since
+     * JSON-RPC forbids replying to notifications.
+     * Accepted messages go to handle_request_serialized().
+     *
+     * @param frame One complete message as received from the transport
+     * @return Serialized response (nullopt for notifications)
+     */
+    std::optional<std::string> handle_raw_message(std::string_view frame);
+
 private:
+    struct Keepalive;
+
+    /// Counts a request as in flight for drain()
+    class InFlightGuard;
+
+    /// @return Error response if the server is draining and @p request_json
+    ///         is not allowed through, else nullopt
+    std::optional<nlohmann::json> check_draining(const nlohmann::json& request_json) const;
+
+    /**
+     * @brief Note inbound traffic for the keepalive
+     *
+     * @return true if @p message was a response to a keepalive ping
+     */
+    bool observe_inbound(const nlohmann::json& message);
+
+    /**
+     * @brief Charge a request against the rate limiter
+     *
+     * @return Error response if the request is over a limit, else nullopt
+     */
+    std::optional<nlohmann::json> check_rate_limit(const nlohmann::json& request_json);
+
+    /**
+     * @brief Route a request to its handler (handle_request() minus limiting)
+     */
+    std::optional<nlohmann::json> dispatch_request(const nlohmann::json& request_json);
+
+    /// Tenant admission held for the duration of one request
+    class TenantScope;
+
+    /**
+     * @brief Admit a request under its session's tenant
+     *
+     * @return Error response if the tenant is at its in-flight budget
+     */
+    std::optional<nlohmann::json> enter_tenant(const nlohmann::json& request_json, TenantScope& scope);
+
+    /**
+     * @brief Run a request through keepalive, drain, rate and tenant admission
+     *
+     * Shared by handle_request() and handle_request_serialized(), which
+     * differ only in how they encode the response.
+     *
+     * @return The complete answer when admission settles the request (a
+     *         ping or a rejection), a discarded value when it needs none (a
+     *         keepalive pong), or nullopt to dispatch it
+     */
+    std::optional<nlohmann::json> admit(const nlohmann::json& request_json, TenantScope& scope);
+
+    /**
+     * @brief Apply the tenant's result size budget
+     *
+     * @return Error response if a result of @p bytes is over the budget
+     */
+    std::optional<nlohmann::json> check_result_bytes(size_t bytes, const nlohmann::json& id,
+                                                     const TenantScope& scope) const;
+
+    /// Session of the current request (SessionScope, else session_id_)
+    std::string_view current_session() const;
+
+    /// Completion cache of the current tenant, or nullptr to use the server's
+    std::shared_ptr<CompletionCache> tenant_completion_cache() const;
+
+    /// @return true if the current tenant may see the task
+    bool task_visible(const Task& task) const;
+
     /**
      * @brief Handle the initialize request
      *
@@ -372,6 +727,9 @@ private:
      */
     void send_list_changed_notification(const std::string& method);
 
+    /// Drop cached completions after a registry or handler change
+    void invalidate_completions();
+
     /// Server implementation info (name, version)
     protocol::Implementation server_info_;
 
@@ -390,8 +748,42 @@ private:
     /// Prompt registry
     PromptRegistry prompts_;
 
+    /// Per-session completion cache (null unless enabled)
+    std::unique_ptr<CompletionCache> completion_cache_;
+
+    /// Parser for handle_raw_message()
+    core::BudgetedParser parser_;
+
+    /// Request rate limits (null unless set)
+    std::shared_ptr<RateLimiter> rate_limiter_;
+
+    /// Session served outside a SessionScope
+    std::string session_id_;
+
+    /// Tenant directory (null unless set)
+    std::shared_ptr<TenantManager> tenants_;
+
+    /// Time source shared with task_manager_ and borrowed by RequestContexts
+    std::shared_ptr<util::Clock> clock_;
+
     /// Task manager for experimental tasks API
     TaskManager task_manager_;
+
+    /// Keepalive pinger and outstanding pings (null unless enabled)
+    std::unique_ptr<Keepalive> keepalive_;
+
+    /// New work is rejected (see begin_drain())
+    std::atomic<bool> draining_{false};
+
+    /// Retry delay reported to rejected clients, in milliseconds
+    std::atomic<int64_t> drain_retry_after_ms_{0};
+
+    /// Requests currently being handled
+    std::atomic<size_t> in_flight_{0};
+
+    /// drain() waits on drain_cv_ for in_flight_ to reach zero
+    std::mutex drain_mutex_;
+    std::condition_variable drain_cv_;
 };
 
 } // namespace server
@@ -6,12 +6,78 @@
 
 #include "mcpp/server/prompt_registry.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <optional>
+
+#include "mcpp/util/concurrency.h"
+#include "mcpp/util/cpu_counters.h"
+#include "mcpp/util/lru_cache.h"
 
 namespace mcpp::server {
 
+struct PromptRenderCache {
+    explicit PromptRenderCache(size_t capacity) : lru(capacity) {}
+
+    util::Mutex mutex{"server.prompt_render_cache"};
+    /// Shared so a hit copies a pointer, not the DOM, under the lock
+    util::LruCache<std::string, std::shared_ptr<const nlohmann::json>> lru;
+};
+
 namespace {
 
+/**
+ * @brief Build the render cache key for a prompt invocation
+ *
+ * Template prompts only depend on the arguments their placeholders
+ * reference, so the key is those values, length-prefixed so that
+ * ("ab","c") and ("a","bc") differ. Handler prompts use the whole
+ * arguments object (nlohmann objects serialize with sorted keys).
+ */
+std::string render_cache_key(const PromptRegistration& registration,
+                             const nlohmann::json& arguments) {
+    if (registration.templates.empty()) {
+        return arguments.dump();
+    }
+    std::string key;
+    std::string value;
+    for (const auto& name : registration.template_arguments) {
+        value.clear();
+        PromptTemplate::append_argument(arguments, name, value);
+        key.append(std::to_string(value.size()));
+        key.push_back(':');
+        key.append(value);
+    }
+    return key;
+}
+
+/**
+ * @brief Render a declarative prompt into GetPromptResult format
+ */
+nlohmann::json render_templates(const PromptRegistration& registration,
+                                const nlohmann::json& arguments) {
+    nlohmann::json::array_t messages_array;
+    messages_array.reserve(registration.templates.size());
+
+    for (const auto& message : registration.templates) {
+        std::string text;
+        message.text.render_to(arguments, text);
+
+        nlohmann::json content;
+        content["type"] = "text";
+        content["text"] = std::move(text);
+
+        nlohmann::json msg_entry;
+        msg_entry["role"] = message.role;
+        msg_entry["content"] = std::move(content);
+        messages_array.push_back(std::move(msg_entry));
+    }
+
+    nlohmann::json result;
+    result["messages"] = std::move(messages_array);
+    return result;
+}
+
 /**
  * @brief Convert a PromptRegistration to JSON format
  *
@@ -67,7 +133,10 @@ bool PromptRegistry::register_prompt(
         name,
         description,
         arguments,
-        std::move(handler)
+        std::move(handler),
+        {},
+        {},
+        nullptr
     };
 
     prompts_[name] = std::move(registration);
@@ -75,6 +144,51 @@ bool PromptRegistry::register_prompt(
     return true;
 }
 
+bool PromptRegistry::register_prompt(
+    const std::string& name,
+    const std::optional<std::string>& description,
+    const std::vector<PromptArgument>& arguments,
+    const std::vector<PromptMessageTemplate>& messages,
+    PromptTemplateOptions options
+) {
+    if (prompts_.find(name) != prompts_.end()) {
+        return false;
+    }
+
+    PromptRegistration registration{name, description, arguments, nullptr, {}, {}, nullptr};
+    registration.templates.reserve(messages.size());
+    for (const auto& message : messages) {
+        CompiledPromptMessage compiled{message.role, PromptTemplate(message.text)};
+        for (const auto& placeholder : compiled.text.placeholders()) {
+            registration.template_arguments.push_back(placeholder);
+        }
+        registration.templates.push_back(std::move(compiled));
+    }
+
+    auto& names = registration.template_arguments;
+    std::sort(names.begin(), names.end());
+    names.erase(std::unique(names.begin(), names.end()), names.end());
+
+    if (options.cache_capacity > 0) {
+        registration.render_cache = std::make_shared<PromptRenderCache>(options.cache_capacity);
+    }
+
+    prompts_[name] = std::move(registration);
+    notify_changed();
+    return true;
+}
+
+bool PromptRegistry::set_render_cache(const std::string& name, size_t capacity) {
+    auto it = prompts_.find(name);
+    if (it == prompts_.end()) {
+        return false;
+    }
+    it->second.render_cache = capacity > 0
+        ? std::make_shared<PromptRenderCache>(capacity)
+        : nullptr;
+    return true;
+}
+
 std::vector<nlohmann::json> PromptRegistry::list_prompts() const {
     std::vector<nlohmann::json> result;
     result.reserve(prompts_.size());
@@ -129,9 +243,43 @@ std::optional<nlohmann::json> PromptRegistry::get_prompt(
         return std::nullopt;
     }
 
-    // Call the handler to get prompt messages with argument substitution
     const PromptRegistration& registration = it->second;
+
+    // Deterministic prompts: serve a previously rendered result if we have one
+    std::string cache_key;
+    if (registration.render_cache) {
+        cache_key = render_cache_key(registration, arguments);
+        std::shared_ptr<const nlohmann::json> cached;
+        {
+            std::lock_guard<util::Mutex> lock(registration.render_cache->mutex);
+            if (const auto* entry = registration.render_cache->lru.get(cache_key)) {
+                cached = *entry;
+            }
+        }
+        if (cached) {
+            return *cached;
+        }
+    }
+
+    std::optional<util::CpuScope> cpu;
+    if (cpu_accounting_) {
+        cpu.emplace("prompt." + name);
+    }
+
+    if (!registration.templates.empty()) {
+        nlohmann::json rendered = render_templates(registration, arguments);
+        cpu.reset();
+        if (registration.render_cache) {
+            auto shared = std::make_shared<const nlohmann::json>(rendered);
+            std::lock_guard<util::Mutex> lock(registration.render_cache->mutex);
+            registration.render_cache->lru.put(std::move(cache_key), std::move(shared));
+        }
+        return rendered;
+    }
+
+    // Call the handler to get prompt messages with argument substitution
     std::vector<PromptMessage> messages = registration.handler(name, arguments);
+    cpu.reset();
 
     // Convert to MCP GetPromptResult format
     nlohmann::json result;
@@ -149,6 +297,12 @@ std::optional<nlohmann::json> PromptRegistry::get_prompt(
     // Include optional _meta if the prompt provided any metadata
     // (This would be an extension - not required for basic prompts)
 
+    if (registration.render_cache) {
+        auto shared = std::make_shared<const nlohmann::json>(result);
+        std::lock_guard<util::Mutex> lock(registration.render_cache->mutex);
+        registration.render_cache->lru.put(std::move(cache_key), std::move(shared));
+    }
+
     return result;
 }
 
@@ -179,6 +333,49 @@ std::optional<std::vector<Completion>> PromptRegistry::get_completion(
     return handler(argument_name, current_value, reference);
 }
 
+void PromptRegistry::set_completion_index(
+    const std::string& prompt_name,
+    const std::string& argument_name,
+    std::shared_ptr<CompletionIndex> index
+) {
+    std::string index_key = prompt_name + '\n' + argument_name;
+    if (index) {
+        completion_indexes_[index_key] = std::move(index);
+    } else {
+        completion_indexes_.erase(index_key);
+    }
+}
+
+bool PromptRegistry::has_completion_index(const std::string& prompt_name,
+                                    const std::string& argument_name) const {
+    return !completion_indexes_.empty() &&
+           completion_indexes_.count(prompt_name + '\n' + argument_name) != 0;
+}
+
+std::optional<CompletionResult> PromptRegistry::complete(
+    const std::string& prompt_name,
+    const std::string& argument_name,
+    const nlohmann::json& current_value,
+    const std::optional<nlohmann::json>& reference
+) const {
+    if (!completion_indexes_.empty()) {
+        auto it = completion_indexes_.find(prompt_name + '\n' + argument_name);
+        if (it != completion_indexes_.end()) {
+            std::string_view prefix;
+            if (current_value.is_string()) {
+                prefix = current_value.get_ref<const std::string&>();
+            }
+            return it->second->complete(prefix);
+        }
+    }
+
+    auto completions = get_completion(prompt_name, argument_name, current_value, reference);
+    if (!completions.has_value()) {
+        return std::nullopt;
+    }
+    return make_completion_result(std::move(*completions));
+}
+
 void PromptRegistry::set_notify_callback(NotifyCallback cb) {
     notify_cb_ = std::move(cb);
 }
@@ -27,30 +27,18 @@
 
 #include <nlohmann/json.hpp>
 #include <functional>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <optional>
 #include <vector>
 
 #include "mcpp/content/pagination.h"
+#include "mcpp/server/completion_index.h"
+#include "mcpp/server/prompt_template.h"
 
 namespace mcpp::server {
 
-/**
- * @brief Completion suggestion for argument autocompletion
- *
- * Represents a single completion value with an optional description.
- * Matches the MCP CompleteResult format which returns an array of
- * completion values with optional descriptions.
- */
-struct Completion {
-    /// The completion value to insert
-    std::string value;
-
-    /// Optional human-readable description of this completion
-    std::optional<std::string> description;
-};
-
 /**
  * @brief Completion handler function type
  *
@@ -129,17 +117,38 @@ using PromptHandler = std::function<std::vector<PromptMessage>(
     const nlohmann::json& arguments
 )>;
 
+/**
+ * @brief Options for declarative (template) prompts
+ */
+struct PromptTemplateOptions {
+    /// Rendered results to keep, keyed by argument values (0 disables caching)
+    size_t cache_capacity = 256;
+};
+
+/// LRU of rendered GetPromptResult JSON (defined in prompt_registry.cpp)
+struct PromptRenderCache;
+
 /**
  * PromptRegistration stores all metadata for a registered prompt.
  *
  * This includes the prompt name, description, argument definitions,
- * and the handler function that generates the prompt messages.
+ * and either the handler function that generates the prompt messages or
+ * the compiled message templates of a declarative prompt.
  */
 struct PromptRegistration {
     std::string name;
     std::optional<std::string> description;
     std::vector<PromptArgument> arguments;
     PromptHandler handler;
+
+    /// Compiled templates for declarative prompts (empty for handler prompts)
+    std::vector<CompiledPromptMessage> templates;
+
+    /// Distinct placeholder names across all templates, sorted
+    std::vector<std::string> template_arguments;
+
+    /// Render cache for deterministic prompts (null when disabled)
+    std::shared_ptr<PromptRenderCache> render_cache;
 };
 
 /**
@@ -170,6 +179,49 @@ public:
         PromptHandler handler
     );
 
+    /**
+     * @brief Register a declarative prompt built from message templates
+     *
+     * Each message text may contain {{argument}} placeholders; the texts
+     * are compiled once here and rendered directly into the result on
+     * every prompts/get, without a user handler. Rendering depends only on
+     * the arguments, so results are cached in an LRU keyed by the values
+     * of the referenced arguments (see PromptTemplateOptions).
+     *
+     * Example:
+     *   registry.register_prompt("code_review", "Review code",
+     *       {{"language", std::nullopt, true}, {"code", std::nullopt, true}},
+     *       std::vector<PromptMessageTemplate>{
+     *           {"user", "Review this {{language}} code:\n{{code}}"}});
+     *
+     * @param name Unique name for the prompt
+     * @param description Optional human-readable description
+     * @param arguments List of argument definitions
+     * @param messages Message templates, rendered as text content
+     * @param options Cache configuration
+     * @return true if registration succeeded, false if name already exists
+     */
+    bool register_prompt(
+        const std::string& name,
+        const std::optional<std::string>& description,
+        const std::vector<PromptArgument>& arguments,
+        const std::vector<PromptMessageTemplate>& messages,
+        PromptTemplateOptions options = {}
+    );
+
+    /**
+     * @brief Cache rendered results of a deterministic handler prompt
+     *
+     * Only use this for handlers whose output depends solely on their
+     * arguments. Results are keyed by the serialized arguments object.
+     * Template prompts are cached automatically at registration.
+     *
+     * @param name Prompt name
+     * @param capacity Number of results to keep (0 disables caching)
+     * @return false if the prompt does not exist
+     */
+    bool set_render_cache(const std::string& name, size_t capacity);
+
     /**
      * List all registered prompts.
      *
@@ -251,6 +303,65 @@ public:
         const std::optional<nlohmann::json>& reference
     ) const;
 
+    /**
+     * @brief Serve completions for one argument from an index
+     *
+     * Takes precedence over the completion handler for that argument.
+     * The same index may be shared by several prompts.
+     *
+     * @param prompt_name Name of the prompt
+     * @param argument_name Argument the index completes
+     * @param index Candidate index (nullptr removes it)
+     */
+    void set_completion_index(
+        const std::string& prompt_name,
+        const std::string& argument_name,
+        std::shared_ptr<CompletionIndex> index
+    );
+
+    /**
+     * @brief Whether an index serves completions for this argument
+     */
+    bool has_completion_index(const std::string& prompt_name, const std::string& argument_name) const;
+
+    /**
+     * @brief Get capped completion results for a prompt argument
+     *
+     * Uses the argument's CompletionIndex if one is set, otherwise the
+     * prompt's completion handler, and applies the spec's
+     * MAX_COMPLETION_VALUES cap with total/hasMore.
+     *
+     * @param prompt_name Name of the prompt
+     * @param argument_name Name of the argument being completed
+     * @param current_value Current partial value in the argument field
+     * @param reference Optional reference context (e.g., cursor position)
+     * @return Completion result, or nullopt if neither index nor handler is set
+     */
+    std::optional<CompletionResult> complete(
+        const std::string& prompt_name,
+        const std::string& argument_name,
+        const nlohmann::json& current_value,
+        const std::optional<nlohmann::json>& reference
+    ) const;
+
+    /**
+     * @brief Enable or disable per-prompt CPU accounting
+     *
+     * When enabled, every handler invocation is wrapped in a
+     * util::CpuScope and its CPU time (plus instructions and cache misses
+     * where hardware counters are available) is aggregated under
+     * "prompt.<name>.*" in util::MetricsRegistry::global().
+     * Disabled by default; set before serving requests.
+     *
+     * @param enabled true to record per-prompt CPU metrics
+     */
+    void set_cpu_accounting(bool enabled) noexcept { cpu_accounting_ = enabled; }
+
+    /**
+     * @brief Whether per-prompt CPU accounting is enabled
+     */
+    bool cpu_accounting() const noexcept { return cpu_accounting_; }
+
     /**
      * @brief Set the callback for sending list_changed notifications
      *
@@ -275,8 +386,14 @@ private:
     /// Completion handlers keyed by prompt name
     std::unordered_map<std::string, CompletionHandler> completion_handlers_;
 
+    /// Completion indexes keyed by "<name>\n<argument>"
+    std::unordered_map<std::string, std::shared_ptr<CompletionIndex>> completion_indexes_;
+
     /// Callback for sending list_changed notifications
     NotifyCallback notify_cb_;
+
+    /// Record per-prompt CPU metrics around handler calls
+    bool cpu_accounting_ = false;
 };
 
 } // namespace mcpp::server
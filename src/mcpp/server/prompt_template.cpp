@@ -0,0 +1,108 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+#include "mcpp/server/prompt_template.h"
+
+#include <algorithm>
+
+namespace mcpp::server {
+
+namespace {
+
+std::string_view trim(std::string_view s) {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t')) s.remove_suffix(1);
+    return s;
+}
+
+} // anonymous namespace
+
+PromptTemplate::PromptTemplate(std::string_view source) {
+    std::string literal;
+    size_t pos = 0;
+
+    auto flush_literal = [&] {
+        if (!literal.empty()) {
+            literal_size_ += literal.size();
+            segments_.push_back(Segment{std::move(literal), -1});
+            literal.clear();
+        }
+    };
+
+    while (pos < source.size()) {
+        size_t open = source.find("{{", pos);
+        if (open == std::string_view::npos) {
+            literal.append(source.substr(pos));
+            break;
+        }
+        size_t close = source.find("}}", open + 2);
+        if (close == std::string_view::npos) {
+            literal.append(source.substr(pos));
+            break;
+        }
+
+        std::string_view name = trim(source.substr(open + 2, close - open - 2));
+        if (name.empty()) {
+            literal.append(source.substr(pos, close + 2 - pos));
+            pos = close + 2;
+            continue;
+        }
+        if (name.find('{') != std::string_view::npos) {
+            // "{{{x}}": the placeholder starts at a later brace
+            literal.append(source.substr(pos, open + 1 - pos));
+            pos = open + 1;
+            continue;
+        }
+
+        literal.append(source.substr(pos, open - pos));
+        flush_literal();
+
+        auto it = std::find(placeholders_.begin(), placeholders_.end(), name);
+        int slot = static_cast<int>(it - placeholders_.begin());
+        if (it == placeholders_.end()) {
+            placeholders_.emplace_back(name);
+        }
+        segments_.push_back(Segment{std::string(), slot});
+        pos = close + 2;
+    }
+    flush_literal();
+}
+
+void PromptTemplate::append_argument(const nlohmann::json& arguments,
+                                     const std::string& name,
+                                     std::string& out) {
+    if (!arguments.is_object()) {
+        return;
+    }
+    auto it = arguments.find(name);
+    if (it == arguments.end() || it->is_null()) {
+        return;
+    }
+    if (it->is_string()) {
+        out.append(it->get_ref<const std::string&>());
+    } else {
+        out.append(it->dump());
+    }
+}
+
+void PromptTemplate::render_to(const nlohmann::json& arguments, std::string& out) const {
+    out.reserve(out.size() + literal_size_);
+    for (const auto& segment : segments_) {
+        if (segment.slot < 0) {
+            out.append(segment.literal);
+        } else {
+            append_argument(arguments, placeholders_[static_cast<size_t>(segment.slot)], out);
+        }
+    }
+}
+
+std::string PromptTemplate::render(const nlohmann::json& arguments) const {
+    std::string out;
+    render_to(arguments, out);
+    return out;
+}
+
+} // namespace mcpp::server
@@ -0,0 +1,129 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef MCPP_SERVER_PROMPT_TEMPLATE_H
+#define MCPP_SERVER_PROMPT_TEMPLATE_H
+
+#include <nlohmann/json.hpp>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mcpp::server {
+
+/**
+ * @brief Text template with {{name}} placeholders, compiled once
+ *
+ * The source is split at construction into alternating literal and slot
+ * segments, so rendering is a single pass of appends into the caller's
+ * buffer with no scanning or intermediate strings.
+ *
+ * Placeholder rules:
+ * - "{{ name }}" - whitespace around the name is ignored
+ * - String arguments are inserted verbatim; numbers, booleans, arrays and
+ *   objects are inserted as their JSON serialization
+ * - Missing or null arguments render as the empty string
+ * - An unterminated "{{" or an empty name is kept as literal text
+ *
+ * Thread safety: Immutable after construction; render_to() may be called
+ * concurrently.
+ */
+class PromptTemplate {
+public:
+    PromptTemplate() = default;
+
+    /**
+     * @brief Compile a template
+     *
+     * @param source Template text, e.g. "Summarize {{topic}} in {{style}} style"
+     */
+    explicit PromptTemplate(std::string_view source);
+
+    /**
+     * @brief Render into an existing buffer
+     *
+     * @param arguments JSON object of argument values
+     * @param out Buffer the rendered text is appended to
+     */
+    void render_to(const nlohmann::json& arguments, std::string& out) const;
+
+    /**
+     * @brief Render into a new string
+     */
+    std::string render(const nlohmann::json& arguments) const;
+
+    /// @return Distinct placeholder names, in order of first appearance
+    const std::vector<std::string>& placeholders() const { return placeholders_; }
+
+    /// @return Total bytes of literal text (lower bound on rendered size)
+    size_t literal_size() const { return literal_size_; }
+
+    /**
+     * @brief Append one argument value the way render_to() inserts it
+     *
+     * @param arguments JSON object of argument values
+     * @param name Argument name
+     * @param out Buffer the value is appended to
+     */
+    static void append_argument(const nlohmann::json& arguments,
+                                const std::string& name,
+                                std::string& out);
+
+private:
+    struct Segment {
+        std::string literal;  ///< Literal text (slot < 0)
+        int slot = -1;        ///< Index into placeholders_ for slot segments
+    };
+
+    std::vector<Segment> segments_;
+    std::vector<std::string> placeholders_;
+    size_t literal_size_ = 0;
+};
+
+/**
+ * @brief Declarative prompt message: a role and a text template
+ *
+ * Used with PromptRegistry::register_prompt() to define a prompt without
+ * a handler. The text is compiled into a PromptTemplate at registration.
+ *
+ * Example:
+ *   PromptMessageTemplate{"user", "Review this {{language}} code:\n{{code}}"}
+ */
+struct PromptMessageTemplate {
+    std::string role;  // "user" or "assistant"
+    std::string text;
+};
+
+/**
+ * @brief A PromptMessageTemplate after compilation
+ */
+struct CompiledPromptMessage {
+    std::string role;
+    PromptTemplate text;
+};
+
+} // namespace mcpp::server
+
+#endif // MCPP_SERVER_PROMPT_TEMPLATE_H
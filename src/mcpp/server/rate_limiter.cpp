@@ -0,0 +1,360 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+#include "mcpp/server/rate_limiter.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <mutex>
+
+namespace mcpp {
+namespace server {
+
+/**
+ * One bucket in GCRA form. tat is the steady-clock time (ns) at which the
+ * bucket would be full again; a request at `now` fits if tat - now is at
+ * most tolerance, and pushes tat forward by one interval.
+ */
+struct RateLimiter::Bucket {
+    std::atomic<int64_t> tat{std::numeric_limits<int64_t>::min()};
+    std::atomic<int64_t> interval{0};   ///< ns per token
+    std::atomic<int64_t> tolerance{0};  ///< (burst - 1) * interval
+    util::Counter* allowed = nullptr;
+    util::Counter* rejected = nullptr;
+
+    /// Apply a new limit, keeping the fill level (tokens owed) at `now`
+    void set_limit(const Limit& limit, int64_t now) noexcept {
+        const int64_t ns = std::max<int64_t>(1, static_cast<int64_t>(std::llround(1e9 / limit.rate_per_sec)));
+        const int64_t old_ns = interval.exchange(ns, std::memory_order_relaxed);
+        tolerance.store(ns * (limit.burst > 0 ? limit.burst - 1 : 0), std::memory_order_relaxed);
+        int64_t old = tat.load(std::memory_order_relaxed);
+        if (old_ns > 0 && old > now) {
+            const double owed = static_cast<double>(old - now) / static_cast<double>(old_ns);
+            tat.compare_exchange_strong(old, now + static_cast<int64_t>(owed * static_cast<double>(ns)),
+                                        std::memory_order_relaxed);
+        }
+    }
+
+    /// Take one token; returns 0 on success, else ns until one is available
+    int64_t acquire(int64_t now) noexcept {
+        const int64_t step = interval.load(std::memory_order_relaxed);
+        const int64_t tau = tolerance.load(std::memory_order_relaxed);
+        int64_t old = tat.load(std::memory_order_relaxed);
+        for (;;) {
+            const int64_t base = std::max(old, now);
+            if (base - now > tau) {
+                return base - tau - now;
+            }
+            if (tat.compare_exchange_weak(old, base + step, std::memory_order_relaxed)) {
+                return 0;
+            }
+        }
+    }
+
+    /// Return a token taken by acquire()
+    void refund() noexcept {
+        tat.fetch_sub(interval.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+};
+
+namespace {
+
+std::atomic<uint64_t> g_next_instance{1};
+
+/// Per-thread cache of bucket lookups for the limiter used last
+struct LookupCache {
+    uint64_t instance = 0;
+    uint64_t generation = 0;
+    std::string key;
+    std::unordered_map<std::string, std::shared_ptr<void>> entries;
+};
+
+thread_local LookupCache g_cache;
+
+/// Bound on cached lookups per thread (mostly sessions)
+constexpr size_t MAX_CACHED = 4096;
+
+/// Session buckets tolerated before the first sweep for idle ones
+constexpr size_t MIN_SESSION_SWEEP = 256;
+
+char level_tag(uint8_t level) {
+    static constexpr std::array<char, 4> tags{'g', 'm', 't', 's'};
+    return tags[level];
+}
+
+constexpr std::array<std::string_view, 4> SCOPE_NAMES{"global", "method", "tool", "session"};
+
+std::string make_key(char tag, std::string_view name) {
+    std::string key(1, tag);
+    key.push_back(':');
+    key.append(name);
+    return key;
+}
+
+/// Metric name prefix for a level (indexes as in SCOPE_NAMES)
+std::string metric_prefix(uint8_t level, std::string_view name) {
+    std::string prefix = "ratelimit.";
+    prefix.append(SCOPE_NAMES[level]);
+    if (level == 1 || level == 2) {  // method, tool
+        prefix.push_back('.');
+        prefix.append(name);
+    }
+    return prefix;
+}
+
+void export_limit(const std::string& prefix, const std::optional<RateLimiter::Limit>& limit) {
+    auto& registry = util::MetricsRegistry::global();
+    const bool limited = limit && limit->rate_per_sec > 0;
+    registry.gauge(prefix + ".interval_us")
+        .set(limited ? static_cast<int64_t>(std::llround(1e6 / limit->rate_per_sec)) : 0);
+    registry.gauge(prefix + ".burst").set(limited ? limit->burst : 0);
+}
+
+} // namespace
+
+RateLimiter::RateLimiter(std::shared_ptr<util::Clock> clock)
+    : clock_(std::move(clock)),
+      instance_id_(g_next_instance.fetch_add(1, std::memory_order_relaxed)) {}
+
+RateLimiter::~RateLimiter() = default;
+
+int64_t RateLimiter::now_ns() const noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        clock_->steady_now().time_since_epoch()).count();
+}
+
+void RateLimiter::bump_generation() noexcept {
+    generation_.fetch_add(1, std::memory_order_release);
+}
+
+void RateLimiter::configure(Level level, const std::string& name, const Limit& limit) {
+    const uint8_t index = static_cast<uint8_t>(level);
+    if (limit.rate_per_sec <= 0) {
+        remove(level, name);
+        return;
+    }
+    auto [it, inserted] = buckets_.try_emplace(make_key(level_tag(index), name));
+    if (inserted) {
+        auto bucket = std::make_shared<Bucket>();
+        const std::string prefix = metric_prefix(index, name);
+        auto& registry = util::MetricsRegistry::global();
+        bucket->allowed = &registry.counter(prefix + ".allowed");
+        bucket->rejected = &registry.counter(prefix + ".rejected");
+        it->second = std::move(bucket);
+        if (level == Level::Session) {
+            ++sessions_;
+        }
+        // Threads may have cached "unlimited" for this key
+        bump_generation();
+    }
+    it->second->set_limit(limit, now_ns());
+}
+
+void RateLimiter::remove(Level level, const std::string& name) {
+    if (buckets_.erase(make_key(level_tag(static_cast<uint8_t>(level)), name)) > 0) {
+        if (level == Level::Session) {
+            --sessions_;
+        }
+        bump_generation();
+    }
+}
+
+void RateLimiter::set_global(const Limit& limit) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    configure(Level::Global, {}, limit);
+    export_limit(metric_prefix(0, {}), limit);
+}
+
+void RateLimiter::set_method(const std::string& method, const Limit& limit) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    configure(Level::Method, method, limit);
+    export_limit(metric_prefix(1, method), limit);
+}
+
+void RateLimiter::set_tool(const std::string& tool, const Limit& limit) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    configure(Level::Tool, tool, limit);
+    export_limit(metric_prefix(2, tool), limit);
+}
+
+void RateLimiter::set_session_default(const Limit& limit) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    const int64_t now = now_ns();
+    session_default_ = limit;
+    // Existing sessions without their own limit follow the new default
+    for (auto it = buckets_.begin(); it != buckets_.end();) {
+        if (it->first[0] != 's' || session_overrides_.count(it->first.substr(2)) > 0) {
+            ++it;
+        } else if (limit.rate_per_sec <= 0) {
+            it = buckets_.erase(it);
+            --sessions_;
+        } else {
+            it->second->set_limit(limit, now);
+            ++it;
+        }
+    }
+    bump_generation();
+    export_limit(metric_prefix(3, {}), limit);
+}
+
+void RateLimiter::set_session(const std::string& session, const Limit& limit) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    session_overrides_[session] = limit;
+    configure(Level::Session, session, limit);
+}
+
+void RateLimiter::clear_global() {
+    set_global(Limit{});
+}
+
+void RateLimiter::clear_method(const std::string& method) {
+    set_method(method, Limit{});
+}
+
+void RateLimiter::clear_tool(const std::string& tool) {
+    set_tool(tool, Limit{});
+}
+
+void RateLimiter::clear_session_default() {
+    set_session_default(Limit{});
+}
+
+void RateLimiter::remove_session(const std::string& session) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    session_overrides_.erase(session);
+    remove(Level::Session, session);
+}
+
+void RateLimiter::evict_idle_sessions() {
+    const int64_t now = now_ns();
+    size_t evicted = 0;
+    for (auto it = buckets_.begin(); it != buckets_.end();) {
+        // A bucket whose TAT has passed is full: a fresh one is identical
+        if (it->first[0] == 's' && it->second->tat.load(std::memory_order_relaxed) <= now &&
+            session_overrides_.count(it->first.substr(2)) == 0) {
+            it = buckets_.erase(it);
+            ++evicted;
+        } else {
+            ++it;
+        }
+    }
+    sessions_ -= evicted;
+    next_sweep_ = std::max(MIN_SESSION_SWEEP, sessions_ * 2);
+    if (evicted > 0) {
+        bump_generation();
+    }
+}
+
+size_t RateLimiter::session_count() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return sessions_;
+}
+
+std::shared_ptr<RateLimiter::Bucket> RateLimiter::lookup_shared(Level level, std::string_view name) {
+    const std::string key = make_key(level_tag(static_cast<uint8_t>(level)), name);
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = buckets_.find(key);
+        if (it != buckets_.end()) {
+            return it->second;
+        }
+        if (level != Level::Session || session_default_.rate_per_sec <= 0 ||
+            session_overrides_.count(key.substr(2)) > 0) {
+            return nullptr;
+        }
+    }
+
+    // First request of a session: give it a bucket at the default limit
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (sessions_ >= next_sweep_ && buckets_.find(key) == buckets_.end()) {
+        evict_idle_sessions();
+    }
+    auto [it, inserted] = buckets_.try_emplace(key);
+    if (inserted) {
+        if (session_default_.rate_per_sec <= 0) {
+            buckets_.erase(it);
+            return nullptr;
+        }
+        auto bucket = std::make_shared<Bucket>();
+        auto& registry = util::MetricsRegistry::global();
+        bucket->allowed = &registry.counter("ratelimit.session.allowed");
+        bucket->rejected = &registry.counter("ratelimit.session.rejected");
+        bucket->set_limit(session_default_, 0);
+        it->second = std::move(bucket);
+        ++sessions_;
+    }
+    return it->second;
+}
+
+std::shared_ptr<RateLimiter::Bucket> RateLimiter::lookup(Level level, std::string_view name) {
+    LookupCache& cache = g_cache;
+    const uint64_t generation = generation_.load(std::memory_order_acquire);
+    if (cache.instance != instance_id_ || cache.generation != generation ||
+        cache.entries.size() >= MAX_CACHED) {
+        cache.entries.clear();
+        cache.instance = instance_id_;
+        cache.generation = generation;
+    }
+
+    cache.key.assign(1, level_tag(static_cast<uint8_t>(level)));
+    cache.key.push_back(':');
+    cache.key.append(name);
+    auto it = cache.entries.find(cache.key);
+    if (it != cache.entries.end()) {
+        return std::static_pointer_cast<Bucket>(it->second);
+    }
+
+    std::shared_ptr<Bucket> bucket = lookup_shared(level, name);
+    cache.entries.emplace(cache.key, bucket);
+    return bucket;
+}
+
+RateLimiter::Decision RateLimiter::check(std::string_view session, std::string_view method,
+                                         std::string_view tool) {
+    const int64_t now = now_ns();
+
+    const std::array<std::pair<Level, std::string_view>, 4> levels{{
+        {Level::Global, {}},
+        {Level::Method, method},
+        {Level::Tool, tool},
+        {Level::Session, session},
+    }};
+
+    std::array<std::shared_ptr<Bucket>, 4> charged;
+    size_t count = 0;
+    for (const auto& [level, name] : levels) {
+        if (level != Level::Global && name.empty()) {
+            continue;
+        }
+        std::shared_ptr<Bucket> bucket = lookup(level, name);
+        if (!bucket) {
+            continue;
+        }
+        const int64_t wait_ns = bucket->acquire(now);
+        if (wait_ns > 0) {
+            bucket->rejected->add();
+            for (size_t i = 0; i < count; ++i) {
+                charged[i]->refund();
+            }
+            Decision decision;
+            decision.allowed = false;
+            decision.retry_after = std::chrono::milliseconds((wait_ns + 999999) / 1000000);
+            decision.scope = SCOPE_NAMES[static_cast<uint8_t>(level)];
+            return decision;
+        }
+        charged[count++] = std::move(bucket);
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        charged[i]->allowed->add();
+    }
+    return Decision{};
+}
+
+} // namespace server
+} // namespace mcpp
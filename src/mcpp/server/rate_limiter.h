@@ -0,0 +1,235 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef MCPP_SERVER_RATE_LIMITER_H
+#define MCPP_SERVER_RATE_LIMITER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "mcpp/server/session_scope.h"
+#include "mcpp/util/clock.h"
+#include "mcpp/util/metrics.h"
+
+namespace mcpp {
+namespace server {
+
+/**
+ * @brief Hierarchical token-bucket rate limits for McpServer
+ *
+ * Every request is charged one token against each configured level:
+ * the global bucket, the bucket of its method, the bucket of the tool
+ * (tools/call only) and the bucket of the calling session. A request is
+ * admitted only if every level has a token; otherwise it is rejected at
+ * once (nothing queues) and the decision carries how long the caller
+ * should wait before the limiting level has a token again. Tokens taken
+ * from levels that admitted a rejected request are returned.
+ *
+ * Each bucket is a single atomic "theoretical arrival time" (the GCRA
+ * form of a token bucket): a check is one compare-and-swap, with no lock
+ * on the request path. Threads cache bucket lookups thread-locally, so
+ * the shared tables are only locked when a session is first seen or
+ * after a reconfiguration.
+ *
+ * Limits can be changed at any time. A changed level keeps the number
+ * of tokens its bucket owes, so a reconfiguration neither grants a fresh
+ * burst nor carries the old rate's wait over.
+ *
+ * Metrics in util::MetricsRegistry::global():
+ * - "ratelimit.<level>.allowed" / ".rejected" counters, where level is
+ *   "global", "session", "method.<name>" or "tool.<name>" (sessions
+ *   share one pair to keep the metric set bounded)
+ * - "ratelimit.<level>.interval_us" / ".burst" gauges with the configured
+ *   limit (interval_us is the time to earn one token; 0 = unlimited)
+ *
+ * Usage:
+ * ```cpp
+ * auto limiter = std::make_shared<RateLimiter>();
+ * limiter->set_global({1000.0, 200});
+ * limiter->set_session_default({20.0, 40});
+ * limiter->set_tool("search", {2.0, 5});
+ * server.set_rate_limiter(limiter);
+ * ```
+ *
+ * The session level is charged to the session named by SessionScope.
+ *
+ * Thread safety: All methods are safe to call concurrently.
+ */
+class RateLimiter {
+public:
+    /**
+     * @brief Rate and burst of one level
+     */
+    struct Limit {
+        /// Tokens earned per second (<= 0 means unlimited)
+        double rate_per_sec = 0.0;
+        /// Bucket capacity: requests admitted back-to-back from full
+        uint32_t burst = 1;
+    };
+
+    /**
+     * @brief Outcome of check()
+     */
+    struct Decision {
+        /// True if the request may proceed
+        bool allowed = true;
+        /// When rejected, time until the limiting level has a token
+        std::chrono::milliseconds retry_after{0};
+        /// When rejected, the limiting level ("global", "method",
+        /// "tool" or "session"); empty when allowed
+        std::string_view scope;
+    };
+
+    /// Kept for callers written before SessionScope moved to its own header
+    using SessionScope = server::SessionScope;
+
+    /**
+     * @brief Create a limiter with no limits configured
+     *
+     * @param clock Time source for token refill
+     *              (defaults to util::Clock::default_clock())
+     */
+    explicit RateLimiter(std::shared_ptr<util::Clock> clock = util::Clock::default_clock());
+
+    ~RateLimiter();
+
+    // Non-copyable and non-movable
+    RateLimiter(const RateLimiter&) = delete;
+    RateLimiter& operator=(const RateLimiter&) = delete;
+    RateLimiter(RateLimiter&&) = delete;
+    RateLimiter& operator=(RateLimiter&&) = delete;
+
+    /// Limit shared by all requests
+    void set_global(const Limit& limit);
+
+    /// Limit for one JSON-RPC method (e.g. "tools/call")
+    void set_method(const std::string& method, const Limit& limit);
+
+    /// Limit for calls to one tool, shared by all sessions
+    void set_tool(const std::string& tool, const Limit& limit);
+
+    /// Limit given to each session without its own limit
+    void set_session_default(const Limit& limit);
+
+    /// Limit for one session, overriding the session default
+    void set_session(const std::string& session, const Limit& limit);
+
+    /// Remove the global limit
+    void clear_global();
+
+    /// Remove a method limit
+    void clear_method(const std::string& method);
+
+    /// Remove a tool limit
+    void clear_tool(const std::string& tool);
+
+    /// Remove the session default (sessions with their own limit keep it)
+    void clear_session_default();
+
+    /**
+     * @brief Forget a session's bucket and any per-session limit
+     *
+     * Call when a session ends to release its bucket at once. Buckets of
+     * sessions at the default limit are also dropped once they are idle
+     * (full again), so sessions that end without this call are reclaimed
+     * when enough new sessions have arrived.
+     */
+    void remove_session(const std::string& session);
+
+    /**
+     * @brief Charge one request and decide whether it may proceed
+     *
+     * @param session Calling session (empty to skip the session level)
+     * @param method JSON-RPC method
+     * @param tool Tool name for tools/call (empty otherwise)
+     * @return Decision; when rejected no level is charged
+     */
+    Decision check(std::string_view session, std::string_view method, std::string_view tool = {});
+
+    /// @return Number of sessions with a bucket
+    size_t session_count() const;
+
+private:
+    struct Bucket;
+
+    enum class Level : uint8_t { Global, Method, Tool, Session };
+
+    /// Bucket for (level, name), nullptr if that level is unlimited
+    std::shared_ptr<Bucket> lookup(Level level, std::string_view name);
+
+    /// Bucket for (level, name) from the shared tables (takes the table lock)
+    std::shared_ptr<Bucket> lookup_shared(Level level, std::string_view name);
+
+    /// Create or update the bucket for (level, name) (table lock held)
+    void configure(Level level, const std::string& name, const Limit& limit);
+
+    /// Drop the bucket for (level, name) (table lock held)
+    void remove(Level level, const std::string& name);
+
+    /// Drop full buckets of sessions at the default limit (table lock held)
+    void evict_idle_sessions();
+
+    /// Current steady time in nanoseconds
+    int64_t now_ns() const noexcept;
+
+    /// Invalidate every thread's lookup cache
+    void bump_generation() noexcept;
+
+    std::shared_ptr<util::Clock> clock_;
+
+    /// Distinguishes this limiter in the thread-local lookup caches
+    const uint64_t instance_id_;
+
+    /// Incremented whenever a bucket is added, replaced or removed
+    std::atomic<uint64_t> generation_{0};
+
+    mutable std::shared_mutex mutex_;
+
+    /// Configured buckets keyed by level tag + name
+    std::unordered_map<std::string, std::shared_ptr<Bucket>> buckets_;
+
+    /// Limit for sessions without their own (rate 0 = none)
+    Limit session_default_;
+
+    /// Sessions configured with set_session() (not reset by the default)
+    std::unordered_map<std::string, Limit> session_overrides_;
+
+    /// Number of "s:" entries in buckets_
+    size_t sessions_ = 0;
+
+    /// Session count at which a new session first evicts idle ones;
+    /// twice the survivors of the last sweep, so sweeps stay amortized O(1)
+    size_t next_sweep_ = 0;
+};
+
+} // namespace server
+} // namespace mcpp
+
+#endif // MCPP_SERVER_RATE_LIMITER_H
@@ -15,13 +15,15 @@ namespace server {
 RequestContext::RequestContext(
     const std::string& request_id,
     transport::Transport& transport,
-    Duration default_timeout
+    Duration default_timeout,
+    util::Clock* clock
 ) : request_id_(request_id),
     transport_(transport),
     progress_token_(std::nullopt),
-    streaming_(false),
     default_timeout_(default_timeout),
-    deadline_(Clock::now() + default_timeout) {}
+    clock_(clock ? clock : util::Clock::default_clock().get()),
+    deadline_ns_((clock_->steady_now() + default_timeout).time_since_epoch().count()),
+    streaming_(false) {}
 
 void RequestContext::set_progress_token(const std::string& token) {
     progress_token_ = token;
@@ -73,18 +75,16 @@ void RequestContext::report_progress(double progress, const std::string& message
 
 void RequestContext::reset_timeout_on_progress() {
     // Reset the deadline to now + default_timeout
-    std::lock_guard lock(deadline_mutex_);
-    deadline_ = Clock::now() + default_timeout_;
+    TimePoint deadline = clock_->steady_now() + default_timeout_;
+    deadline_ns_.store(deadline.time_since_epoch().count(), std::memory_order_relaxed);
 }
 
 bool RequestContext::is_timeout_expired() const {
-    std::lock_guard lock(deadline_mutex_);
-    return Clock::now() > deadline_;
+    return clock_->steady_now() > deadline();
 }
 
 RequestContext::TimePoint RequestContext::deadline() const {
-    std::lock_guard lock(deadline_mutex_);
-    return deadline_;
+    return TimePoint(TimePoint::duration(deadline_ns_.load(std::memory_order_relaxed)));
 }
 
 transport::Transport& RequestContext::transport() {
@@ -25,13 +25,16 @@
 #ifndef MCPP_SERVER_REQUEST_CONTEXT_H
 #define MCPP_SERVER_REQUEST_CONTEXT_H
 
+#include <atomic>
 #include <chrono>
-#include <mutex>
+#include <cstdint>
+#include <memory>
 #include <nlohmann/json.hpp>
 #include <optional>
 #include <string>
 
 #include "mcpp/transport/transport.h"
+#include "mcpp/util/clock.h"
 #include "mcpp/util/sse_formatter.h"
 
 namespace mcpp {
@@ -120,11 +123,15 @@ public:
      * @param request_id The JSON-RPC request ID for this request
      * @param transport Reference to the transport for sending notifications
      * @param default_timeout Optional custom timeout (defaults to 5 minutes)
+     * @param clock Time source for the deadline; not owned and must outlive
+     *              the context (nullptr uses util::Clock::default_clock(),
+     *              which must then not be replaced while the context lives)
      */
     RequestContext(
         const std::string& request_id,
         transport::Transport& transport,
-        Duration default_timeout = DEFAULT_REQUEST_TIMEOUT
+        Duration default_timeout = DEFAULT_REQUEST_TIMEOUT,
+        util::Clock* clock = nullptr
     );
 
     /**
@@ -200,7 +207,7 @@ public:
      * Resets the deadline to now + default_timeout. This is called when
      * a progress notification with a matching progress_token is received.
      *
-     * Thread-safe: Uses mutex lock for deadline access.
+     * Thread-safe: the deadline is a single atomic.
      *
      * This allows long-running operations to keep the request alive by
      * sending periodic progress notifications.
@@ -212,7 +219,7 @@ public:
      *
      * @return true if the current time is past the deadline, false otherwise
      *
-     * Thread-safe: Uses mutex lock for deadline access.
+     * Thread-safe: the deadline is a single atomic.
      */
     bool is_timeout_expired() const;
 
@@ -221,7 +228,7 @@ public:
      *
      * @return The time point when this request will timeout
      *
-     * Thread-safe: Uses mutex lock for deadline access.
+     * Thread-safe: the deadline is a single atomic.
      */
     TimePoint deadline() const;
 
@@ -288,16 +295,19 @@ private:
     std::string request_id_;
     transport::Transport& transport_;
     std::optional<std::string> progress_token_;
-    bool streaming_ = false;
 
     /// Default timeout duration (5 minutes by default)
     Duration default_timeout_;
 
-    /// Deadline for request timeout (UTIL-02)
-    TimePoint deadline_;
+    /// Time source for deadline_ns_ (not owned; the server outlives its contexts)
+    util::Clock* clock_;
+
+    /// Deadline for request timeout (UTIL-02), as steady-clock nanoseconds
+    /// since the epoch; an atomic instead of a mutex keeps one context per
+    /// in-flight request small and its timeout checks lock-free
+    std::atomic<int64_t> deadline_ns_;
 
-    /// Mutex protecting deadline_ for thread-safe access
-    mutable std::mutex deadline_mutex_;
+    bool streaming_ = false;
 };
 
 } // namespace server
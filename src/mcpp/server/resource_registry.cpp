@@ -15,6 +15,8 @@
 
 #include "mcpp/core/json_rpc.h"
 #include "mcpp/transport/transport.h"
+#include "mcpp/util/cpu_counters.h"
+#include "mcpp/util/json_writer.h"
 #include "mcpp/util/uri_template.h"
 
 namespace mcpp {
@@ -201,14 +203,20 @@ content::PaginatedResult<nlohmann::json> ResourceRegistry::list_resources_pagina
     return result;
 }
 
-std::optional<nlohmann::json> ResourceRegistry::read_resource(const std::string& uri) const {
+std::optional<ResourceContent> ResourceRegistry::invoke_handler(
+    const std::string& uri,
+    std::string& mime_type
+) const {
     // First, try to find a static resource
     auto it = resources_.find(uri);
     if (it != resources_.end()) {
         const ResourceRegistration& registration = it->second;
-        ResourceContent content = registration.handler(uri);
-
-        return build_resource_result(content, registration.mime_type);
+        std::optional<util::CpuScope> cpu;
+        if (cpu_accounting_) {
+            cpu.emplace("resource." + uri);
+        }
+        mime_type = registration.mime_type;
+        return registration.handler(uri);
     }
 
     // Try to match against templates
@@ -216,15 +224,56 @@ std::optional<nlohmann::json> ResourceRegistry::read_resource(const std::string&
         nlohmann::json params = match_template(uri, registration.uri_template, registration.parameter_names);
         if (params != nullptr && !params.empty()) {
             // Template matched - call the template handler
-            ResourceContent content = registration.handler(uri, params);
-
-            return build_resource_result(content, registration.mime_type);
+            std::optional<util::CpuScope> cpu;
+            if (cpu_accounting_) {
+                cpu.emplace("resource." + template_str);
+            }
+            mime_type = registration.mime_type;
+            return registration.handler(uri, params);
         }
     }
 
     return std::nullopt;
 }
 
+std::optional<nlohmann::json> ResourceRegistry::read_resource(const std::string& uri) const {
+    std::string mime_type;
+    std::optional<ResourceContent> content = invoke_handler(uri, mime_type);
+    if (!content) {
+        return std::nullopt;
+    }
+    return build_resource_result(*content, mime_type);
+}
+
+bool ResourceRegistry::write_resource(const std::string& uri, std::string& out) const {
+    std::string mime_type;
+    std::optional<ResourceContent> content = invoke_handler(uri, mime_type);
+    if (!content) {
+        return false;
+    }
+
+    // Keys in the order nlohmann::json (std::map) dumps them, so the output
+    // matches read_resource(uri)->dump() byte for byte
+    const util::SharedBuffer& payload = content->is_text ? content->text : content->blob;
+    out.reserve(out.size() + payload.size() + content->uri.size() + 96);
+    out.append("{\"contents\":[{");
+    if (!content->is_text) {
+        out.append("\"blob\":");
+        util::append_json_string(out, payload);
+        out.push_back(',');
+    }
+    out.append("\"mimeType\":");
+    util::append_json_string(out, content->mime_type ? *content->mime_type : mime_type);
+    if (content->is_text) {
+        out.append(",\"text\":");
+        util::append_json_string(out, payload);
+    }
+    out.append(",\"type\":\"resource\",\"uri\":");
+    util::append_json_string(out, content->uri);
+    out.append("}]}");
+    return true;
+}
+
 bool ResourceRegistry::has_resource(const std::string& uri) const {
     // Check static resources
     if (resources_.find(uri) != resources_.end()) {
@@ -456,6 +505,49 @@ std::optional<std::vector<Completion>> ResourceRegistry::get_completion(
     return handler(argument_name, current_value, reference);
 }
 
+void ResourceRegistry::set_completion_index(
+    const std::string& resource_name,
+    const std::string& argument_name,
+    std::shared_ptr<CompletionIndex> index
+) {
+    std::string index_key = resource_name + '\n' + argument_name;
+    if (index) {
+        completion_indexes_[index_key] = std::move(index);
+    } else {
+        completion_indexes_.erase(index_key);
+    }
+}
+
+bool ResourceRegistry::has_completion_index(const std::string& resource_name,
+                                    const std::string& argument_name) const {
+    return !completion_indexes_.empty() &&
+           completion_indexes_.count(resource_name + '\n' + argument_name) != 0;
+}
+
+std::optional<CompletionResult> ResourceRegistry::complete(
+    const std::string& resource_name,
+    const std::string& argument_name,
+    const nlohmann::json& current_value,
+    const std::optional<nlohmann::json>& reference
+) const {
+    if (!completion_indexes_.empty()) {
+        auto it = completion_indexes_.find(resource_name + '\n' + argument_name);
+        if (it != completion_indexes_.end()) {
+            std::string_view prefix;
+            if (current_value.is_string()) {
+                prefix = current_value.get_ref<const std::string&>();
+            }
+            return it->second->complete(prefix);
+        }
+    }
+
+    auto completions = get_completion(resource_name, argument_name, current_value, reference);
+    if (!completions.has_value()) {
+        return std::nullopt;
+    }
+    return make_completion_result(std::move(*completions));
+}
+
 // === Private Helpers ===
 
 nlohmann::json ResourceRegistry::build_resource_result(
@@ -27,6 +27,7 @@
 
 #include <chrono>
 #include <functional>
+#include <memory>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -36,6 +37,7 @@
 
 #include "mcpp/content/pagination.h"
 #include "mcpp/server/prompt_registry.h"  // For shared Completion struct
+#include "mcpp/util/shared_buffer.h"
 #include "mcpp/util/uri_template.h"
 
 namespace mcpp {
@@ -96,11 +98,12 @@ struct ResourceContent {
     /// Content type flag: true for text, false for binary blob
     bool is_text = true;
 
-    /// Text content (used when is_text == true)
-    std::string text;
+    /// Text content (used when is_text == true). Shared, so the payload is
+    /// not copied on its way from the handler to the serializer.
+    util::SharedBuffer text;
 
     /// Binary content as base64-encoded string (used when is_text == false)
-    std::string blob;
+    util::SharedBuffer blob;
 };
 
 /**
@@ -313,6 +316,19 @@ public:
      */
     std::optional<nlohmann::json> read_resource(const std::string& uri) const;
 
+    /**
+     * @brief Read a resource and append its serialized ReadResourceResult
+     *
+     * Same output as read_resource(uri)->dump(), but the text or blob is
+     * written straight from the handler's SharedBuffer without passing
+     * through a nlohmann::json string node. Preferred for large payloads.
+     *
+     * @param uri URI of the resource to read
+     * @param out Buffer the JSON object is appended to
+     * @return false (and @p out untouched) if the URI is not registered
+     */
+    bool write_resource(const std::string& uri, std::string& out) const;
+
     /**
      * @brief Check if a resource URI is registered
      *
@@ -430,6 +446,65 @@ public:
         const std::optional<nlohmann::json>& reference
     ) const;
 
+    /**
+     * @brief Serve completions for one argument from an index
+     *
+     * Takes precedence over the completion handler for that argument.
+     * The same index may be shared by several resources.
+     *
+     * @param resource_name Name of the resource
+     * @param argument_name Argument the index completes
+     * @param index Candidate index (nullptr removes it)
+     */
+    void set_completion_index(
+        const std::string& resource_name,
+        const std::string& argument_name,
+        std::shared_ptr<CompletionIndex> index
+    );
+
+    /**
+     * @brief Whether an index serves completions for this argument
+     */
+    bool has_completion_index(const std::string& resource_name, const std::string& argument_name) const;
+
+    /**
+     * @brief Get capped completion results for a resource argument
+     *
+     * Uses the argument's CompletionIndex if one is set, otherwise the
+     * resource's completion handler, and applies the spec's
+     * MAX_COMPLETION_VALUES cap with total/hasMore.
+     *
+     * @param resource_name Name of the resource
+     * @param argument_name Name of the argument being completed
+     * @param current_value Current partial value in the argument field
+     * @param reference Optional reference context (e.g., cursor position)
+     * @return Completion result, or nullopt if neither index nor handler is set
+     */
+    std::optional<CompletionResult> complete(
+        const std::string& resource_name,
+        const std::string& argument_name,
+        const nlohmann::json& current_value,
+        const std::optional<nlohmann::json>& reference
+    ) const;
+
+    /**
+     * @brief Enable or disable per-resource CPU accounting
+     *
+     * When enabled, every handler invocation is wrapped in a
+     * util::CpuScope and its CPU time (plus instructions and cache misses
+     * where hardware counters are available) is aggregated under
+     * "resource.<uri>.*" (the URI template for templated resources) in util::MetricsRegistry::global().
+     * Disabled by default; set before serving requests.
+     *
+     * @param enabled true to record per-resource CPU metrics
+     */
+    void set_cpu_accounting(bool enabled) noexcept { cpu_accounting_ = enabled; }
+
+    /**
+     * @brief Whether per-resource CPU accounting is enabled
+     */
+    bool cpu_accounting() const noexcept { return cpu_accounting_; }
+
     /**
      * @brief Set the callback for sending list_changed notifications
      *
@@ -475,9 +550,15 @@ private:
     /// Completion handlers keyed by resource name (URI or template)
     std::unordered_map<std::string, CompletionHandler> completion_handlers_;
 
+    /// Completion indexes keyed by "<name>\n<argument>"
+    std::unordered_map<std::string, std::shared_ptr<CompletionIndex>> completion_indexes_;
+
     /// Callback for sending list_changed notifications
     NotifyCallback notify_cb_;
 
+    /// Record per-resource CPU metrics around handler calls
+    bool cpu_accounting_ = false;
+
     /**
      * @brief Match a URI against a template and extract parameters
      *
@@ -503,6 +584,18 @@ private:
         const ResourceContent& content,
         const std::string& default_mime_type
     ) const;
+
+    /**
+     * @brief Find the handler for a URI and call it
+     *
+     * @param uri URI of the resource to read
+     * @param mime_type Set to the registration's MIME type on success
+     * @return Handler result, or nullopt if no resource or template matches
+     */
+    std::optional<ResourceContent> invoke_handler(
+        const std::string& uri,
+        std::string& mime_type
+    ) const;
 };
 
 } // namespace server
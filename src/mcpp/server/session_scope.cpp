@@ -0,0 +1,35 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+#include "mcpp/server/session_scope.h"
+
+namespace mcpp {
+namespace server {
+
+namespace {
+
+thread_local const SessionScope* g_session_scope = nullptr;
+
+} // namespace
+
+SessionScope::SessionScope(std::string_view session) noexcept
+    : previous_(g_session_scope), session_(session) {
+    g_session_scope = this;
+}
+
+SessionScope::~SessionScope() {
+    g_session_scope = previous_;
+}
+
+std::optional<std::string_view> SessionScope::current() noexcept {
+    if (g_session_scope == nullptr) {
+        return std::nullopt;
+    }
+    return g_session_scope->session_;
+}
+
+} // namespace server
+} // namespace mcpp
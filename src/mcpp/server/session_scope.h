@@ -0,0 +1,69 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef MCPP_SERVER_SESSION_SCOPE_H
+#define MCPP_SERVER_SESSION_SCOPE_H
+
+#include <optional>
+#include <string_view>
+
+namespace mcpp {
+namespace server {
+
+/**
+ * @brief Names the session whose request is being handled on this thread
+ *
+ * McpServer charges rate limits (RateLimiter) and resolves tenants
+ * (TenantManager) per session. A server dedicated to one client sets its
+ * session once with McpServer::set_session_id(); servers shared by several
+ * sessions (one McpServer per HttpServer shard) run each request inside a
+ * scope instead. HttpServer and server-side WebSocketTransport open one
+ * around every message they deliver; other transports do it themselves:
+ * ```cpp
+ * SessionScope scope(session.id());
+ * return server->handle_raw_message(body);
+ * ```
+ * Scopes nest; the innermost one wins. The viewed string must outlive the
+ * scope.
+ */
+class SessionScope {
+public:
+    explicit SessionScope(std::string_view session) noexcept;
+    ~SessionScope();
+
+    SessionScope(const SessionScope&) = delete;
+    SessionScope& operator=(const SessionScope&) = delete;
+
+    /// @return Session of the innermost open scope on this thread, if any
+    static std::optional<std::string_view> current() noexcept;
+
+private:
+    const SessionScope* previous_;
+    std::string_view session_;
+};
+
+} // namespace server
+} // namespace mcpp
+
+#endif // MCPP_SERVER_SESSION_SCOPE_H
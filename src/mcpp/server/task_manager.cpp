@@ -8,32 +8,9 @@
 
 #include <algorithm>
 #include <chrono>
-#include <iomanip>
-#include <random>
-#include <sstream>
-#include <ctime>
-
-namespace {
-
-/**
- * @brief Parse ISO 8601 timestamp to time_t
- *
- * @param ts ISO 8601 timestamp string (e.g., "2025-01-31T12:34:56Z")
- * @return time_t value, or 0 if parsing fails
- */
-std::time_t parse_iso8601(const std::string& ts) {
-    std::tm tm = {};
-    std::istringstream ss(ts);
-    ss >> std::get_time(&tm, "%Y-%m-%dT%H:%M:%SZ");
-    if (ss.fail()) {
-        return 0;
-    }
-    // Use timegm to convert UTC tm to time_t (Linux-specific)
-    // For portability, we assume mktime with UTC adjustment
-    return timegm(&tm);
-}
 
-} // anonymous namespace
+#include "mcpp/util/secure_random.h"
+#include "mcpp/util/timestamp.h"
 
 namespace mcpp {
 namespace server {
@@ -44,61 +21,59 @@ namespace server {
 
 Task::Task(std::string id, TaskStatus s, std::optional<uint64_t> ttl)
     : task_id(std::move(id)),
-      status(s),
-      created_at(TaskManager::get_timestamp()),
-      last_updated_at(TaskManager::get_timestamp()),
-      ttl_ms(ttl) {}
+      created_at(std::chrono::system_clock::now()),
+      last_updated_at(created_at),
+      created_steady(std::chrono::steady_clock::now()),
+      ttl_ms(ttl),
+      status(s) {}
 
 // ============================================================================
 // TaskManager Implementation
 // ============================================================================
 
+TaskManager::TaskManager(std::shared_ptr<util::Clock> clock)
+    : clock_(clock ? std::move(clock) : util::Clock::system()) {
+}
+
 std::string TaskManager::get_timestamp() {
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
-    std::stringstream ss;
-    ss << std::put_time(std::gmtime(&time_t), "%Y-%m-%dT%H:%M:%SZ");
-    return ss.str();
+    return format_timestamp(std::chrono::system_clock::now());
+}
+
+std::string TaskManager::current_timestamp() const {
+    return format_timestamp(clock_->system_now());
+}
+
+std::string TaskManager::format_timestamp(std::chrono::system_clock::time_point time) {
+    return util::format_iso8601(time);
 }
 
 std::string TaskManager::generate_task_id() const {
-    // Simple UUID-like format using random_device
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(0, 15);
-
-    std::stringstream ss;
-    ss << std::hex;
-    for (int i = 0; i < 8; ++i) ss << dis(gen);
-    ss << '-';
-    for (int i = 0; i < 4; ++i) ss << dis(gen);
-    ss << "-4";  // Version 4
-    for (int i = 0; i < 3; ++i) ss << dis(gen);
-    ss << '-';
-    ss << std::uniform_int_distribution<>(8, 11)(gen);  // Variant
-    for (int i = 0; i < 3; ++i) ss << dis(gen);
-    ss << '-';
-    for (int i = 0; i < 12; ++i) ss << dis(gen);
-
-    return ss.str();
+    // UUID v4 from the shared CSPRNG; task IDs are capabilities for
+    // tasks/get and tasks/result, so they must not be guessable
+    return util::SecureRandom::next_id128().as_uuid_v4().to_uuid();
 }
 
 std::string TaskManager::create_task(
     std::optional<uint64_t> ttl_ms,
-    std::optional<uint64_t> poll_interval_ms
+    std::optional<uint64_t> poll_interval_ms,
+    const std::string& owner
 ) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<util::Mutex> lock(mutex_);
 
     std::string task_id = generate_task_id();
     Task task(task_id, TaskStatus::Working, ttl_ms);
     task.poll_interval_ms = poll_interval_ms;
+    task.owner = owner;
+    task.created_at = clock_->system_now();
+    task.last_updated_at = task.created_at;
+    task.created_steady = clock_->steady_now();
 
     tasks_[task_id] = std::move(task);
     return task_id;
 }
 
 std::optional<Task> TaskManager::get_task(const std::string& task_id) const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<util::Mutex> lock(mutex_);
 
     auto it = tasks_.find(task_id);
     if (it == tasks_.end()) {
@@ -112,7 +87,7 @@ bool TaskManager::update_status(
     TaskStatus new_status,
     const std::optional<std::string>& message
 ) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<util::Mutex> lock(mutex_);
 
     auto it = tasks_.find(id);
     if (it == tasks_.end()) {
@@ -138,7 +113,7 @@ bool TaskManager::update_status(
     }
 
     task.status = new_status;
-    task.last_updated_at = get_timestamp();
+    task.last_updated_at = clock_->system_now();
     if (message.has_value()) {
         task.status_message = message;
     }
@@ -146,7 +121,7 @@ bool TaskManager::update_status(
 }
 
 bool TaskManager::set_result(const std::string& task_id, const nlohmann::json& result) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<util::Mutex> lock(mutex_);
 
     auto it = tasks_.find(task_id);
     if (it == tasks_.end()) {
@@ -158,7 +133,7 @@ bool TaskManager::set_result(const std::string& task_id, const nlohmann::json& r
 }
 
 std::optional<nlohmann::json> TaskManager::get_result(const std::string& task_id) const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<util::Mutex> lock(mutex_);
 
     auto it = results_.find(task_id);
     if (it == results_.end()) {
@@ -173,7 +148,7 @@ bool TaskManager::cancel_task(const std::string& task_id) {
 }
 
 bool TaskManager::delete_task(const std::string& task_id) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<util::Mutex> lock(mutex_);
 
     auto task_it = tasks_.find(task_id);
     if (task_it == tasks_.end()) {
@@ -186,17 +161,20 @@ bool TaskManager::delete_task(const std::string& task_id) {
 }
 
 TaskManager::PaginatedResult<Task> TaskManager::list_tasks(
-    const std::optional<std::string>& cursor
+    const std::optional<std::string>& cursor,
+    const std::optional<std::string>& owner
 ) const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<util::Mutex> lock(mutex_);
 
     PaginatedResult<Task> result;
 
-    // Get all task IDs
+    // Get all task IDs (in the requested namespace)
     std::vector<std::string> task_ids;
     task_ids.reserve(tasks_.size());
     for (const auto& pair : tasks_) {
-        task_ids.push_back(pair.first);
+        if (!owner || pair.second.owner == *owner) {
+            task_ids.push_back(pair.first);
+        }
     }
 
     // Sort for consistent pagination
@@ -232,25 +210,46 @@ bool TaskManager::is_expired(const Task& task) const {
         return false;  // No TTL = never expires
     }
 
-    // Parse the ISO 8601 timestamp to time_t
-    std::time_t created_time = parse_iso8601(task.created_at);
-    if (created_time == 0) {
-        return false;  // Failed to parse, assume not expired
-    }
-
-    // Calculate elapsed time since creation
-    auto now = std::chrono::system_clock::now();
-    auto created = std::chrono::system_clock::from_time_t(created_time);
-
+    // Elapsed time since creation on the monotonic clock, so wall-clock
+    // steps neither expire tasks early nor keep them alive
     auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-        now - created
+        clock_->steady_now() - task.created_steady
     ).count();
 
     return elapsed > static_cast<int64_t>(*task.ttl_ms);
 }
 
+size_t TaskManager::count_tasks(const std::string& owner) const {
+    std::lock_guard<util::Mutex> lock(mutex_);
+    return static_cast<size_t>(std::count_if(tasks_.begin(), tasks_.end(), [&](const auto& pair) {
+        return pair.second.owner == owner;
+    }));
+}
+
+size_t TaskManager::count_active() const {
+    std::lock_guard<util::Mutex> lock(mutex_);
+    return static_cast<size_t>(std::count_if(tasks_.begin(), tasks_.end(), [](const auto& pair) {
+        return pair.second.status == TaskStatus::Working ||
+               pair.second.status == TaskStatus::InputRequired;
+    }));
+}
+
+size_t TaskManager::cancel_active(const std::string& message) {
+    std::lock_guard<util::Mutex> lock(mutex_);
+    size_t cancelled = 0;
+    for (auto& [id, task] : tasks_) {
+        if (task.status == TaskStatus::Working || task.status == TaskStatus::InputRequired) {
+            task.status = TaskStatus::Cancelled;
+            task.status_message = message;
+            task.last_updated_at = clock_->system_now();
+            ++cancelled;
+        }
+    }
+    return cancelled;
+}
+
 size_t TaskManager::cleanup_expired() {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<util::Mutex> lock(mutex_);
 
     std::vector<std::string> expired_ids;
     for (const auto& pair : tasks_) {
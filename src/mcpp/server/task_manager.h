@@ -27,6 +27,7 @@
 
 #include <chrono>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
@@ -35,6 +36,9 @@
 
 #include <nlohmann/json.hpp>
 
+#include "mcpp/util/clock.h"
+#include "mcpp/util/concurrency.h"
+
 namespace mcpp {
 namespace server {
 
@@ -74,15 +78,23 @@ inline const char* to_string(TaskStatus status) {
  *
  * Stores all information about a long-running task including
  * its status, timestamps, and optional configuration.
+ *
+ * Times are kept as binary time points and rendered to ISO 8601 only
+ * when a response is built (see TaskManager::format_timestamp()).
  */
 struct Task {
+    using SystemTime = std::chrono::system_clock::time_point;
+    using SteadyTime = std::chrono::steady_clock::time_point;
+
     std::string task_id;                          ///< Unique task identifier
-    TaskStatus status;                            ///< Current status
     std::optional<std::string> status_message;    ///< Optional human-readable status
-    std::string created_at;                       ///< ISO 8601 creation timestamp
-    std::string last_updated_at;                  ///< ISO 8601 last update timestamp
+    std::string owner;                            ///< Namespace (tenant) that created it ("" = shared)
+    SystemTime created_at{};                      ///< Creation time (wall clock, reported to clients)
+    SystemTime last_updated_at{};                 ///< Last status change (wall clock)
+    SteadyTime created_steady{};                  ///< Creation time for TTL expiry (monotonic)
     std::optional<uint64_t> ttl_ms;               ///< TTL in milliseconds (null = unlimited)
     std::optional<uint64_t> poll_interval_ms;     ///< Suggested poll interval for clients
+    TaskStatus status = TaskStatus::Working;      ///< Current status
 
     /**
      * @brief Default constructor (for unordered_map compatibility)
@@ -142,9 +154,12 @@ struct Task {
 class TaskManager {
 public:
     /**
-     * @brief Default constructor
+     * @brief Construct a task manager
+     *
+     * @param clock Time source for timestamps and TTL expiry
+     *              (defaults to util::Clock::default_clock())
      */
-    TaskManager() = default;
+    explicit TaskManager(std::shared_ptr<util::Clock> clock = util::Clock::default_clock());
 
     /**
      * @brief Default destructor
@@ -176,11 +191,13 @@ public:
      *
      * @param ttl_ms Optional TTL in milliseconds (nullopt = unlimited)
      * @param poll_interval_ms Optional suggested poll interval
+     * @param owner Namespace the task belongs to (see list_tasks())
      * @return New task ID
      */
     std::string create_task(
         std::optional<uint64_t> ttl_ms = std::nullopt,
-        std::optional<uint64_t> poll_interval_ms = std::nullopt
+        std::optional<uint64_t> poll_interval_ms = std::nullopt,
+        const std::string& owner = {}
     );
 
     /**
@@ -252,12 +269,35 @@ public:
      * to retrieve subsequent pages.
      *
      * @param cursor Optional pagination cursor
+     * @param owner If set, only tasks in this namespace are listed
      * @return Paginated result of tasks
      */
     PaginatedResult<Task> list_tasks(
-        const std::optional<std::string>& cursor = std::nullopt
+        const std::optional<std::string>& cursor = std::nullopt,
+        const std::optional<std::string>& owner = std::nullopt
     ) const;
 
+    /**
+     * @brief Count the tasks in one namespace (including finished ones
+     * that have not expired)
+     *
+     * @param owner Namespace passed to create_task()
+     */
+    size_t count_tasks(const std::string& owner) const;
+
+    /// @return Tasks still working or waiting for input (all namespaces)
+    size_t count_active() const;
+
+    /**
+     * @brief Cancel every task that is still working or waiting for input
+     *
+     * Used when the server shuts down with tasks unfinished.
+     *
+     * @param message Status message recorded on each cancelled task
+     * @return Number of tasks cancelled
+     */
+    size_t cancel_active(const std::string& message);
+
     /**
      * @brief Clean up expired tasks
      *
@@ -276,6 +316,22 @@ public:
      */
     static std::string get_timestamp();
 
+    /**
+     * @brief Format a wall-clock time as an ISO 8601 UTC timestamp
+     *
+     * Uses util::format_iso8601(), which reuses the rendered second
+     * across calls on the same thread.
+     *
+     * @param time Time point to format
+     * @return Timestamp such as "2025-01-31T12:34:56.789Z"
+     */
+    static std::string format_timestamp(std::chrono::system_clock::time_point time);
+
+    /**
+     * @brief Current ISO 8601 timestamp according to this manager's clock
+     */
+    std::string current_timestamp() const;
+
 private:
     /// Page size for task listing
     static constexpr size_t PAGE_SIZE = 50;
@@ -292,8 +348,11 @@ private:
     /// Task results storage
     std::unordered_map<std::string, nlohmann::json> results_;
 
+    /// Time source for timestamps and expiry
+    std::shared_ptr<util::Clock> clock_;
+
     /// Mutex for thread-safe access
-    mutable std::mutex mutex_;
+    mutable util::Mutex mutex_{"server.task_manager"};
 };
 
 } // namespace server
@@ -0,0 +1,198 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+#include "mcpp/server/tenant.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace mcpp {
+namespace server {
+
+namespace {
+
+std::string tenant_from_meta(std::string_view, const nlohmann::json& params) {
+    auto meta = params.find("_meta");
+    if (meta == params.end() || !meta->is_object()) {
+        return {};
+    }
+    auto tenant = meta->find("tenant");
+    if (tenant == meta->end() || !tenant->is_string()) {
+        return {};
+    }
+    return tenant->get<std::string>();
+}
+
+std::shared_ptr<CompletionCache> make_cache(const TenantConfig& config) {
+    return std::make_shared<CompletionCache>(config.cache_entries, config.budget.max_cache_bytes);
+}
+
+} // namespace
+
+Tenant::Admission::~Admission() {
+    if (tenant_) {
+        tenant_->in_flight_.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+Tenant::Admission& Tenant::Admission::operator=(Admission&& other) noexcept {
+    if (this != &other) {
+        if (tenant_) {
+            tenant_->in_flight_.fetch_sub(1, std::memory_order_relaxed);
+        }
+        tenant_ = std::move(other.tenant_);
+    }
+    return *this;
+}
+
+Tenant::Tenant(std::string id, TenantConfig config)
+    : id_(std::move(id)),
+      config_(std::make_shared<const TenantConfig>(std::move(config))),
+      cache_(make_cache(*config_)) {}
+
+std::shared_ptr<const TenantConfig> Tenant::config() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return config_;
+}
+
+std::shared_ptr<CompletionCache> Tenant::completion_cache() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cache_;
+}
+
+void Tenant::reconfigure(TenantConfig config) {
+    auto next = std::make_shared<const TenantConfig>(std::move(config));
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (next->cache_entries != config_->cache_entries ||
+        next->budget.max_cache_bytes != config_->budget.max_cache_bytes) {
+        cache_ = make_cache(*next);
+    } else {
+        // Visibility may have narrowed; cached candidates could leak it
+        cache_->clear();
+    }
+    config_ = std::move(next);
+}
+
+bool Tenant::tool_visible(std::string_view name) const {
+    auto snapshot = config();
+    return !snapshot->tools || snapshot->tools->count(std::string(name)) > 0;
+}
+
+bool Tenant::prompt_visible(std::string_view name) const {
+    auto snapshot = config();
+    return !snapshot->prompts || snapshot->prompts->count(std::string(name)) > 0;
+}
+
+bool Tenant::resource_visible(std::string_view uri) const {
+    auto snapshot = config();
+    if (!snapshot->resources) {
+        return true;
+    }
+    for (const auto& prefix : *snapshot->resources) {
+        if (uri.substr(0, prefix.size()) == prefix) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::optional<Tenant::Admission> Tenant::admit(const std::shared_ptr<Tenant>& self) {
+    const size_t limit = self->config()->budget.max_in_flight;
+    size_t current = self->in_flight_.load(std::memory_order_relaxed);
+    do {
+        if (limit > 0 && current >= limit) {
+            return std::nullopt;
+        }
+    } while (!self->in_flight_.compare_exchange_weak(current, current + 1, std::memory_order_relaxed));
+    return Admission(self);
+}
+
+TenantManager::TenantManager()
+    : TenantManager(tenant_from_meta) {}
+
+TenantManager::TenantManager(Resolver resolver)
+    : resolver_(std::move(resolver)) {}
+
+void TenantManager::set_tenant(const std::string& id, TenantConfig config) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = tenants_.find(id);
+    if (it != tenants_.end()) {
+        it->second->reconfigure(std::move(config));
+    } else {
+        tenants_.emplace(id, std::make_shared<Tenant>(id, std::move(config)));
+    }
+}
+
+bool TenantManager::remove_tenant(const std::string& id) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return tenants_.erase(id) > 0;
+}
+
+std::shared_ptr<Tenant> TenantManager::find(const std::string& id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = tenants_.find(id);
+    return it != tenants_.end() ? it->second : nullptr;
+}
+
+void TenantManager::set_default_tenant(std::string id) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    default_tenant_ = std::move(id);
+}
+
+std::string TenantManager::bind(std::string_view session, const nlohmann::json& initialize_params) {
+    std::string id = resolver_ ? resolver_(session, initialize_params) : std::string();
+    bind_session(session, id);
+    return id;
+}
+
+void TenantManager::bind_session(std::string_view session, std::string tenant_id) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (tenant_id.empty()) {
+        sessions_.erase(std::string(session));
+    } else {
+        sessions_[std::string(session)] = std::move(tenant_id);
+    }
+}
+
+void TenantManager::unbind(std::string_view session) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    sessions_.erase(std::string(session));
+}
+
+std::string TenantManager::tenant_id_locked(std::string_view session) const {
+    auto it = sessions_.find(std::string(session));
+    if (it != sessions_.end() && tenants_.count(it->second) > 0) {
+        return it->second;
+    }
+    return default_tenant_;
+}
+
+std::string TenantManager::tenant_id_for(std::string_view session) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return tenant_id_locked(session);
+}
+
+std::shared_ptr<Tenant> TenantManager::tenant_for(std::string_view session) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = tenants_.find(tenant_id_locked(session));
+    return it != tenants_.end() ? it->second : nullptr;
+}
+
+uint32_t TenantManager::weight(const std::string& id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = tenants_.find(id);
+    return it != tenants_.end() ? std::max<uint32_t>(1, it->second->config()->weight) : 1;
+}
+
+void TenantManager::clear_caches() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    for (const auto& [id, tenant] : tenants_) {
+        tenant->completion_cache()->clear();
+    }
+}
+
+} // namespace server
+} // namespace mcpp
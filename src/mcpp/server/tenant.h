@@ -0,0 +1,266 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef MCPP_SERVER_TENANT_H
+#define MCPP_SERVER_TENANT_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "mcpp/server/completion_cache.h"
+
+namespace mcpp {
+namespace server {
+
+/**
+ * @brief Resource budgets of one tenant (0 = unlimited)
+ */
+struct TenantBudget {
+    /// Requests of the tenant being handled at once, across its sessions
+    size_t max_in_flight = 0;
+    /// Tasks the tenant may hold in TaskManager (until they expire)
+    size_t max_tasks = 0;
+    /// Size of one serialized response (checked by
+    /// McpServer::handle_request_serialized())
+    size_t max_result_bytes = 0;
+    /// Memory of the tenant's completion cache
+    size_t max_cache_bytes = 0;
+};
+
+/**
+ * @brief What one tenant may see and use
+ */
+struct TenantConfig {
+    /// Share of FairExecutor time relative to other tenants
+    uint32_t weight = 1;
+
+    TenantBudget budget;
+
+    /// Visible tool names (nullopt = all tools)
+    std::optional<std::unordered_set<std::string>> tools;
+
+    /// Visible resource URI prefixes (nullopt = all resources); a resource
+    /// template is visible if its uriTemplate starts with a prefix
+    std::optional<std::vector<std::string>> resources;
+
+    /// Visible prompt names (nullopt = all prompts)
+    std::optional<std::unordered_set<std::string>> prompts;
+
+    /// Entries in the tenant's completion cache
+    size_t cache_entries = 256;
+};
+
+/**
+ * @brief One tenant: its configuration and live accounting
+ *
+ * Created and reconfigured by TenantManager. The in-flight count and the
+ * completion cache survive reconfiguration (the cache is rebuilt only if
+ * its size limits change).
+ *
+ * Thread safety: All methods are safe to call concurrently.
+ */
+class Tenant {
+public:
+    /**
+     * @brief One in-flight slot; released on destruction
+     */
+    class Admission {
+    public:
+        Admission() = default;
+        explicit Admission(std::shared_ptr<Tenant> tenant) : tenant_(std::move(tenant)) {}
+        ~Admission();
+
+        Admission(Admission&& other) noexcept = default;
+        Admission& operator=(Admission&& other) noexcept;
+        Admission(const Admission&) = delete;
+        Admission& operator=(const Admission&) = delete;
+
+    private:
+        std::shared_ptr<Tenant> tenant_;
+    };
+
+    Tenant(std::string id, TenantConfig config);
+
+    // Non-copyable and non-movable
+    Tenant(const Tenant&) = delete;
+    Tenant& operator=(const Tenant&) = delete;
+    Tenant(Tenant&&) = delete;
+    Tenant& operator=(Tenant&&) = delete;
+
+    /// @return Tenant identifier
+    const std::string& id() const { return id_; }
+
+    /// @return Current configuration (a snapshot; later changes do not affect it)
+    std::shared_ptr<const TenantConfig> config() const;
+
+    /// @return true if the tenant may list and call the tool
+    bool tool_visible(std::string_view name) const;
+
+    /// @return true if the tenant may list and read the resource (URI or template)
+    bool resource_visible(std::string_view uri) const;
+
+    /// @return true if the tenant may list and get the prompt
+    bool prompt_visible(std::string_view name) const;
+
+    /**
+     * @brief Take an in-flight slot
+     *
+     * @param self shared_ptr owning this tenant (kept alive by the Admission)
+     * @return Admission, or nullopt if max_in_flight requests are running
+     */
+    static std::optional<Admission> admit(const std::shared_ptr<Tenant>& self);
+
+    /// @return Requests currently admitted
+    size_t in_flight() const { return in_flight_.load(std::memory_order_relaxed); }
+
+    /// @return The tenant's completion cache (bounded by max_cache_bytes)
+    std::shared_ptr<CompletionCache> completion_cache() const;
+
+    /// Replace the configuration (see TenantManager::set_tenant())
+    void reconfigure(TenantConfig config);
+
+private:
+    const std::string id_;
+    mutable std::mutex mutex_;
+    std::shared_ptr<const TenantConfig> config_;
+    std::shared_ptr<CompletionCache> cache_;
+    std::atomic<size_t> in_flight_{0};
+};
+
+/**
+ * @brief Maps sessions to tenants
+ *
+ * A single server process can serve many tenants while keeping them
+ * apart: McpServer::set_tenants() makes every request run as the tenant
+ * of its session (see SessionScope). The tenant then
+ * - only sees and can call the tools, resources and prompts in its
+ *   TenantConfig (others behave as if they were not registered),
+ * - only sees its own tasks (tasks/list, get, cancel and result),
+ * - is held to its TenantBudget, and
+ * - gets its own completion cache.
+ *
+ * Sessions are bound to a tenant when they send initialize: the resolver
+ * picks a tenant id from the initialize params. The default resolver
+ * reads params._meta.tenant. Sessions that are not bound, or bound to an
+ * id that is not configured, use the default tenant; if that is not
+ * configured either, requests run unrestricted.
+ *
+ * For weighted-fair scheduling, key a FairExecutor by tenant_id_for()
+ * and take its weights from weight().
+ *
+ * Thread safety: All methods are safe to call concurrently.
+ */
+class TenantManager {
+public:
+    /// Picks the tenant id for a session from its initialize params ("" = default)
+    using Resolver = std::function<std::string(std::string_view session,
+                                               const nlohmann::json& initialize_params)>;
+
+    /// Create a manager using the params._meta.tenant resolver
+    TenantManager();
+
+    /// Create a manager with a custom resolver
+    explicit TenantManager(Resolver resolver);
+
+    // Non-copyable and non-movable
+    TenantManager(const TenantManager&) = delete;
+    TenantManager& operator=(const TenantManager&) = delete;
+    TenantManager(TenantManager&&) = delete;
+    TenantManager& operator=(TenantManager&&) = delete;
+
+    /**
+     * @brief Add a tenant or change its configuration
+     *
+     * Takes effect for the next request; requests already admitted finish
+     * under the old configuration.
+     */
+    void set_tenant(const std::string& id, TenantConfig config);
+
+    /**
+     * @brief Remove a tenant; its sessions fall back to the default tenant
+     *
+     * @return true if the tenant existed
+     */
+    bool remove_tenant(const std::string& id);
+
+    /// @return The tenant, or nullptr if not configured
+    std::shared_ptr<Tenant> find(const std::string& id) const;
+
+    /// Tenant for sessions without a (configured) tenant of their own
+    void set_default_tenant(std::string id);
+
+    /**
+     * @brief Bind a session using the resolver
+     *
+     * Called by McpServer on initialize.
+     *
+     * @return Tenant id the session was bound to ("" = default tenant)
+     */
+    std::string bind(std::string_view session, const nlohmann::json& initialize_params);
+
+    /// Bind a session to a tenant id directly
+    void bind_session(std::string_view session, std::string tenant_id);
+
+    /// Forget a session's binding (call when the session ends)
+    void unbind(std::string_view session);
+
+    /// @return Tenant id the session runs as (the default tenant if unbound)
+    std::string tenant_id_for(std::string_view session) const;
+
+    /// @return Tenant the session runs as, or nullptr if unrestricted
+    std::shared_ptr<Tenant> tenant_for(std::string_view session) const;
+
+    /// @return Configured weight of a tenant (1 if not configured)
+    uint32_t weight(const std::string& id) const;
+
+    /// Clear every tenant's completion cache (registries changed)
+    void clear_caches() const;
+
+private:
+    std::string tenant_id_locked(std::string_view session) const;
+
+    Resolver resolver_;
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<Tenant>> tenants_;
+    std::unordered_map<std::string, std::string> sessions_;
+    std::string default_tenant_;
+};
+
+} // namespace server
+} // namespace mcpp
+
+#endif // MCPP_SERVER_TENANT_H
@@ -7,9 +7,12 @@
 #include "mcpp/server/tool_registry.h"
 
 #include <cstdint>
+#include <optional>
 #include <sstream>
 #include <string>
 
+#include "mcpp/util/cpu_counters.h"
+
 #if MCPP_HAS_JSON_SCHEMA
     #include <nlohmann/json-schema.hpp>
 #endif
@@ -319,8 +322,16 @@ std::optional<nlohmann::json> ToolRegistry::call_tool(
     }
 #endif
 
-    // Call the handler with validated arguments
-    nlohmann::json result = registration.handler(name, args, ctx);
+    // Call the handler with validated arguments, charging its CPU cost
+    // to the tool when accounting is enabled
+    nlohmann::json result;
+    {
+        std::optional<util::CpuScope> cpu;
+        if (cpu_accounting_) {
+            cpu.emplace("tool." + name);
+        }
+        result = registration.handler(name, args, ctx);
+    }
 
     // Validate output against output schema if declared
     //
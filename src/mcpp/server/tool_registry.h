@@ -317,6 +317,24 @@ public:
      */
     void clear() noexcept { tools_.clear(); }
 
+    /**
+     * @brief Enable or disable per-tool CPU accounting
+     *
+     * When enabled, every handler invocation is wrapped in a
+     * util::CpuScope and its CPU time (plus instructions and cache misses
+     * where hardware counters are available) is aggregated under
+     * "tool.<name>.*" in util::MetricsRegistry::global().
+     * Disabled by default; set before serving requests.
+     *
+     * @param enabled true to record per-tool CPU metrics
+     */
+    void set_cpu_accounting(bool enabled) noexcept { cpu_accounting_ = enabled; }
+
+    /**
+     * @brief Whether per-tool CPU accounting is enabled
+     */
+    bool cpu_accounting() const noexcept { return cpu_accounting_; }
+
     /**
      * @brief Set the callback for sending list_changed notifications
      *
@@ -341,6 +359,9 @@ private:
 
     /// Callback for sending list_changed notifications
     NotifyCallback notify_cb_;
+
+    /// Record per-tool CPU metrics around handler calls
+    bool cpu_accounting_ = false;
 };
 
 } // namespace server
@@ -0,0 +1,636 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+#include "mcpp/server/worker_pool.h"
+
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <signal.h>
+#include <sys/prctl.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+
+#include "mcpp/transport/transport.h"
+
+namespace mcpp {
+namespace server {
+
+namespace {
+
+// Frame layout on the socketpair: [u32 payload size][u8 type][CBOR payload]
+enum class FrameType : uint8_t {
+    Call = 1,     ///< server -> worker: {name, args, request_id, progress_token?}
+    Result = 2,   ///< worker -> server: CallToolResult
+    Message = 3   ///< worker -> server: serialized notification to relay
+};
+
+constexpr size_t kHeaderSize = 5;
+
+/// How often a waiting call checks its deadline
+constexpr int kPollSliceMs = 20;
+
+/// Time a worker gets to exit after EOF before it is killed
+constexpr auto kExitGrace = std::chrono::milliseconds(100);
+
+bool write_all(int fd, const uint8_t* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = ::send(fd, data, size, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool read_all(int fd, uint8_t* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = ::read(fd, data, size);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool write_frame(int fd, FrameType type, const nlohmann::json& body) {
+    std::vector<uint8_t> frame(kHeaderSize);
+    nlohmann::json::to_cbor(body, frame);
+    uint32_t size = static_cast<uint32_t>(frame.size() - kHeaderSize);
+    std::memcpy(frame.data(), &size, sizeof(size));
+    frame[4] = static_cast<uint8_t>(type);
+    return write_all(fd, frame.data(), frame.size());
+}
+
+bool read_frame(int fd, FrameType& type, nlohmann::json& body) {
+    uint8_t header[kHeaderSize];
+    if (!read_all(fd, header, sizeof(header))) {
+        return false;
+    }
+    uint32_t size = 0;
+    std::memcpy(&size, header, sizeof(size));
+    type = static_cast<FrameType>(header[4]);
+
+    std::vector<uint8_t> payload(size);
+    if (!read_all(fd, payload.data(), payload.size())) {
+        return false;
+    }
+    body = nlohmann::json::from_cbor(payload, true, false);
+    return !body.is_discarded();
+}
+
+/// Requests the server sends the zygote over the control socket
+enum class ZygoteOp : uint8_t {
+    Spawn = 1,    ///< reply: i32 pid, worker's socket end as SCM_RIGHTS
+    Reap = 2      ///< reply: i32 wait status
+};
+
+struct ZygoteRequest {
+    ZygoteOp op;
+    int32_t pid;
+};
+
+bool send_pid_and_fd(int sock, int32_t pid, int fd) {
+    iovec iov{&pid, sizeof(pid)};
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    if (fd >= 0) {
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+        cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+        std::memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+    }
+    ssize_t n;
+    do {
+        n = ::sendmsg(sock, &msg, MSG_NOSIGNAL);
+    } while (n < 0 && errno == EINTR);
+    return n == static_cast<ssize_t>(sizeof(pid));
+}
+
+bool recv_pid_and_fd(int sock, int32_t& pid, int& fd) {
+    iovec iov{&pid, sizeof(pid)};
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    ssize_t n;
+    do {
+        n = ::recvmsg(sock, &msg, MSG_CMSG_CLOEXEC);
+    } while (n < 0 && errno == EINTR);
+    if (n != static_cast<ssize_t>(sizeof(pid))) {
+        return false;
+    }
+    fd = -1;
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    if (cmsg != nullptr && cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+        std::memcpy(&fd, CMSG_DATA(cmsg), sizeof(int));
+    }
+    return true;
+}
+
+nlohmann::json make_tool_error(const std::string& message) {
+    return nlohmann::json{
+        {"content", {{{"type", "text"}, {"text", message}}}},
+        {"isError", true}
+    };
+}
+
+std::string describe_exit(int status) {
+    if (WIFSIGNALED(status)) {
+        int sig = WTERMSIG(status);
+        return "terminated by signal " + std::to_string(sig) + " (" + ::strsignal(sig) + ")";
+    }
+    if (WIFEXITED(status)) {
+        return "exited with status " + std::to_string(WEXITSTATUS(status));
+    }
+    return "stopped";
+}
+
+void apply_limits(const WorkerPool::Limits& limits) {
+    if (limits.max_memory_bytes != 0) {
+        rlimit rl{limits.max_memory_bytes, limits.max_memory_bytes};
+        ::setrlimit(RLIMIT_AS, &rl);
+    }
+    if (limits.max_cpu.count() != 0) {
+        // SIGXCPU at the soft limit, SIGKILL a second later
+        rlim_t seconds = static_cast<rlim_t>(limits.max_cpu.count());
+        rlimit rl{seconds, seconds + 1};
+        ::setrlimit(RLIMIT_CPU, &rl);
+    }
+    if (limits.max_open_files != 0) {
+        rlimit rl{limits.max_open_files, limits.max_open_files};
+        ::setrlimit(RLIMIT_NOFILE, &rl);
+    }
+}
+
+/**
+ * @brief Worker-side transport: frames every send() back to the server
+ */
+class ParentTransport : public transport::Transport {
+public:
+    explicit ParentTransport(int fd) : fd_(fd) {}
+
+    bool connect() override { return true; }
+    void disconnect() override {}
+    bool is_connected() const override { return true; }
+
+    bool send(std::string_view message) override {
+        return write_frame(fd_, FrameType::Message, std::string(message));
+    }
+
+    void set_message_callback(MessageCallback) override {}
+    void set_error_callback(ErrorCallback) override {}
+
+private:
+    int fd_;
+};
+
+} // anonymous namespace
+
+WorkerPool::WorkerPool()
+    : WorkerPool(Options{}) {}
+
+WorkerPool::WorkerPool(Options options)
+    : options_(std::move(options)) {
+    if (options_.workers == 0) {
+        options_.workers = 1;
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    stop();
+}
+
+ToolHandler WorkerPool::isolate(const std::string& name, ToolHandler handler) {
+    handlers_[name] = std::move(handler);
+    return [this, name](const std::string&, const nlohmann::json& args, RequestContext& ctx) {
+        return call(name, args, ctx);
+    };
+}
+
+bool WorkerPool::start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_) {
+        return true;
+    }
+
+    // The zygote is forked once, here, so the only process that ever
+    // forks workers is single-threaded and holds no lock of ours
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) != 0) {
+        return false;
+    }
+    pid_t parent = ::getpid();
+    pid_t pid = ::fork();
+    if (pid < 0) {
+        ::close(fds[0]);
+        ::close(fds[1]);
+        return false;
+    }
+    if (pid == 0) {
+        ::close(fds[0]);
+        ::prctl(PR_SET_PDEATHSIG, SIGKILL);
+        if (::getppid() != parent) {
+            ::_exit(0);
+        }
+        zygote_main(fds[1]);
+    }
+    ::close(fds[1]);
+    zygote_pid_ = pid;
+    zygote_fd_ = fds[0];
+
+    workers_.assign(options_.workers, Worker{});
+    for (Worker& worker : workers_) {
+        if (!spawn(worker.pid, worker.fd)) {
+            for (Worker& spawned : workers_) {
+                if (spawned.pid > 0) {
+                    reap(spawned.pid, spawned.fd);
+                    spawned.pid = -1;
+                    spawned.fd = -1;
+                }
+            }
+            stop_zygote();
+            return false;
+        }
+    }
+    running_ = true;
+    return true;
+}
+
+void WorkerPool::stop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    running_ = false;
+
+    // Busy workers are killed here and reaped by their callers
+    for (Worker& worker : workers_) {
+        if (worker.busy) {
+            if (worker.pid > 0) {
+                ::kill(worker.pid, SIGKILL);
+            }
+        } else if (worker.pid > 0) {
+            reap(worker.pid, worker.fd);
+            worker.pid = -1;
+            worker.fd = -1;
+        }
+    }
+    cv_.notify_all();
+    cv_.wait(lock, [this]() {
+        for (const Worker& worker : workers_) {
+            if (worker.busy) {
+                return false;
+            }
+        }
+        return true;
+    });
+    stop_zygote();
+}
+
+nlohmann::json WorkerPool::call(const std::string& name, const nlohmann::json& args,
+                                RequestContext& ctx) {
+    Worker* worker = nullptr;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this, &worker]() {
+            if (!running_) {
+                return true;
+            }
+            for (Worker& candidate : workers_) {
+                if (!candidate.busy) {
+                    worker = &candidate;
+                    return true;
+                }
+            }
+            return false;
+        });
+        if (!running_) {
+            return make_tool_error("Worker pool is not running");
+        }
+
+        worker->busy = true;
+        worker->cancelled = false;
+        worker->request_id = ctx.request_id();
+        ++counters_.calls;
+    }
+
+    // A worker whose replacement failed earlier is forked now, without the
+    // pool lock (see the replacement below)
+    if (worker->pid < 0) {
+        pid_t pid = -1;
+        int fd = -1;
+        const bool spawned = spawn(pid, fd);
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!spawned || !running_) {
+            if (spawned) {
+                reap(pid, fd);
+            }
+            worker->busy = false;
+            worker->request_id.clear();
+            cv_.notify_all();
+            return make_tool_error(running_ ? "Failed to start a worker process"
+                                            : "Worker pool is not running");
+        }
+        worker->pid = pid;
+        worker->fd = fd;
+        worker->calls = 0;
+    }
+
+    nlohmann::json request = {
+        {"name", name},
+        {"args", args},
+        {"request_id", ctx.request_id()}
+    };
+    if (ctx.progress_token()) {
+        request["progress_token"] = *ctx.progress_token();
+    }
+
+    // The worker is ours until busy is cleared, so its fd needs no lock
+    enum class Outcome { Done, Died, TimedOut } outcome = Outcome::Died;
+    nlohmann::json result;
+    if (write_frame(worker->fd, FrameType::Call, request)) {
+        while (true) {
+            pollfd pfd{worker->fd, POLLIN, 0};
+            int ready = ::poll(&pfd, 1, kPollSliceMs);
+            if (ready < 0 && errno == EINTR) {
+                continue;
+            }
+            if (ready > 0) {
+                FrameType type;
+                nlohmann::json body;
+                if (!read_frame(worker->fd, type, body)) {
+                    break;
+                }
+                if (type == FrameType::Message && body.is_string()) {
+                    const std::string& message = body.get_ref<const std::string&>();
+                    ctx.transport().send(message);
+                    if (message.find("\"notifications/progress\"") != std::string::npos) {
+                        ctx.reset_timeout_on_progress();
+                    }
+                    continue;
+                }
+                if (type == FrameType::Result) {
+                    result = std::move(body);
+                    outcome = Outcome::Done;
+                }
+                break;
+            }
+            if (ctx.is_timeout_expired()) {
+                outcome = Outcome::TimedOut;
+                break;
+            }
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    ++worker->calls;
+    bool replace = outcome != Outcome::Done || !running_ ||
+                   (options_.max_calls_per_worker != 0 &&
+                    worker->calls >= options_.max_calls_per_worker);
+
+    if (outcome == Outcome::Done) {
+        // Result already in hand
+    } else if (!running_) {
+        result = make_tool_error("Worker pool stopped");
+    } else if (worker->cancelled) {
+        ++counters_.cancellations;
+        result = make_tool_error("Tool call cancelled");
+    } else if (outcome == Outcome::TimedOut) {
+        ++counters_.timeouts;
+        result = make_tool_error("Tool call exceeded its deadline");
+    } else {
+        ++counters_.crashes;
+    }
+
+    if (replace) {
+        const bool crashed = outcome == Outcome::Died && running_ && !worker->cancelled;
+        const bool respawn = running_;
+
+        // Take the process out of the table so cancel() and stop() leave it
+        // alone, then do the zygote round trips without the pool lock: a
+        // reap can wait kExitGrace for the old process. The worker stays
+        // busy, so no other call picks it up meanwhile.
+        const pid_t old_pid = std::exchange(worker->pid, -1);
+        const int old_fd = std::exchange(worker->fd, -1);
+        lock.unlock();
+        const std::string status = reap(old_pid, old_fd);
+        pid_t pid = -1;
+        int fd = -1;
+        const bool spawned = respawn && spawn(pid, fd);
+        lock.lock();
+
+        if (crashed) {
+            result = make_tool_error("Tool worker " + status);
+        }
+        if (spawned && running_) {
+            worker->pid = pid;
+            worker->fd = fd;
+            worker->calls = 0;
+            ++counters_.restarts;
+        } else if (spawned) {
+            // stop() ran while the lock was released
+            reap(pid, fd);
+        }
+    }
+
+    worker->busy = false;
+    worker->request_id.clear();
+    cv_.notify_all();
+    return result;
+}
+
+bool WorkerPool::cancel(const std::string& request_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (Worker& worker : workers_) {
+        if (worker.busy && worker.pid > 0 && worker.request_id == request_id) {
+            worker.cancelled = true;
+            ::kill(worker.pid, SIGKILL);
+            return true;
+        }
+    }
+    return false;
+}
+
+WorkerPool::Stats WorkerPool::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats = counters_;
+    for (const Worker& worker : workers_) {
+        if (worker.pid > 0) {
+            ++stats.workers;
+        }
+    }
+    return stats;
+}
+
+bool WorkerPool::spawn(pid_t& worker_pid, int& worker_fd) {
+    ZygoteRequest request{ZygoteOp::Spawn, 0};
+    int32_t pid = -1;
+    int fd = -1;
+    std::lock_guard<std::mutex> lock(zygote_mutex_);
+    if (zygote_fd_ < 0 ||
+        !write_all(zygote_fd_, reinterpret_cast<const uint8_t*>(&request), sizeof(request)) ||
+        !recv_pid_and_fd(zygote_fd_, pid, fd)) {
+        return false;
+    }
+    if (pid < 0 || fd < 0) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        return false;
+    }
+
+    worker_pid = pid;
+    worker_fd = fd;
+    return true;
+}
+
+std::string WorkerPool::reap(pid_t pid, int fd) {
+    // EOF asks an idle worker to exit; a crashed one is already exiting
+    ::close(fd);
+
+    // Workers are the zygote's children, so it waits for them
+    ZygoteRequest request{ZygoteOp::Reap, static_cast<int32_t>(pid)};
+    int32_t status = 0;
+    std::lock_guard<std::mutex> lock(zygote_mutex_);
+    if (zygote_fd_ < 0 ||
+        !write_all(zygote_fd_, reinterpret_cast<const uint8_t*>(&request), sizeof(request)) ||
+        !read_all(zygote_fd_, reinterpret_cast<uint8_t*>(&status), sizeof(status))) {
+        ::kill(pid, SIGKILL);
+        status = SIGKILL;
+    }
+    return describe_exit(status);
+}
+
+void WorkerPool::stop_zygote() {
+    std::lock_guard<std::mutex> lock(zygote_mutex_);
+    if (zygote_pid_ < 0) {
+        return;
+    }
+    // EOF on the control socket makes the zygote exit; any worker still
+    // alive follows through PR_SET_PDEATHSIG
+    ::close(zygote_fd_);
+    ::waitpid(zygote_pid_, nullptr, 0);
+    zygote_pid_ = -1;
+    zygote_fd_ = -1;
+}
+
+void WorkerPool::zygote_main(int fd) {
+    while (true) {
+        ZygoteRequest request;
+        if (!read_all(fd, reinterpret_cast<uint8_t*>(&request), sizeof(request))) {
+            ::_exit(0);
+        }
+
+        if (request.op == ZygoteOp::Reap) {
+            int status = 0;
+            pid_t result = 0;
+            auto deadline = std::chrono::steady_clock::now() + kExitGrace;
+            while ((result = ::waitpid(request.pid, &status, WNOHANG)) == 0 &&
+                   std::chrono::steady_clock::now() < deadline) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            if (result == 0) {
+                ::kill(request.pid, SIGKILL);
+                ::waitpid(request.pid, &status, 0);
+            }
+            int32_t reply = status;
+            if (!write_all(fd, reinterpret_cast<const uint8_t*>(&reply), sizeof(reply))) {
+                ::_exit(0);
+            }
+            continue;
+        }
+
+        int fds[2];
+        pid_t pid = -1;
+        if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) == 0) {
+            pid_t zygote = ::getpid();
+            pid = ::fork();
+            if (pid == 0) {
+                // Worker: keep only its own end of its own channel, and die
+                // with the zygote
+                ::close(fds[0]);
+                ::close(fd);
+                ::prctl(PR_SET_PDEATHSIG, SIGKILL);
+                if (::getppid() != zygote) {
+                    ::_exit(0);
+                }
+                apply_limits(options_.limits);
+                worker_main(fds[1]);
+            }
+            ::close(fds[1]);
+            if (pid < 0) {
+                ::close(fds[0]);
+                fds[0] = -1;
+            }
+        }
+        bool sent = send_pid_and_fd(fd, static_cast<int32_t>(pid), pid < 0 ? -1 : fds[0]);
+        if (pid >= 0) {
+            ::close(fds[0]);
+        }
+        if (!sent) {
+            ::_exit(0);
+        }
+    }
+}
+
+void WorkerPool::worker_main(int fd) {
+    ParentTransport transport(fd);
+
+    while (true) {
+        FrameType type;
+        nlohmann::json request;
+        if (!read_frame(fd, type, request) || type != FrameType::Call) {
+            ::_exit(0);
+        }
+
+        nlohmann::json result;
+        std::string name = request.value("name", "");
+        auto it = handlers_.find(name);
+        if (it == handlers_.end()) {
+            result = make_tool_error("No isolated handler for tool: " + name);
+        } else {
+            // The server enforces the real deadline
+            RequestContext ctx(request.value("request_id", ""), transport,
+                               std::chrono::hours(24));
+            if (request.contains("progress_token")) {
+                ctx.set_progress_token(request["progress_token"].get<std::string>());
+            }
+            try {
+                result = it->second(name, request["args"], ctx);
+            } catch (const std::exception& e) {
+                result = make_tool_error(std::string("Tool handler failed: ") + e.what());
+            } catch (...) {
+                result = make_tool_error("Tool handler failed");
+            }
+        }
+
+        if (!write_frame(fd, FrameType::Result, result)) {
+            ::_exit(0);
+        }
+    }
+}
+
+} // namespace server
+} // namespace mcpp
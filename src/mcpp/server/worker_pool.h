@@ -0,0 +1,222 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef MCPP_SERVER_WORKER_POOL_H
+#define MCPP_SERVER_WORKER_POOL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <sys/types.h>
+
+#include <nlohmann/json.hpp>
+
+#include "mcpp/server/request_context.h"
+#include "mcpp/server/tool_registry.h"
+
+namespace mcpp {
+namespace server {
+
+/**
+ * @brief Runs selected tool handlers in forked worker processes
+ *
+ * Handlers registered with isolate() execute in a pool of worker
+ * processes forked from the server, so a handler that crashes, leaks or
+ * spins takes down one worker rather than the server, and CPU-bound
+ * handlers run in parallel without sharing locks inside native libraries.
+ *
+ * isolate() returns an ordinary ToolHandler, so an isolated tool is
+ * registered and called through ToolRegistry exactly like an in-process
+ * one (schema validation stays in the server):
+ * ```cpp
+ * auto pool = std::make_shared<WorkerPool>(options);
+ * registry.register_tool("render", "...", schema,
+ *                        pool->isolate("render", render_handler));
+ * pool->start();
+ * ```
+ *
+ * Calls travel over a Unix socketpair per worker as length-prefixed CBOR
+ * frames. Notifications the handler sends through its RequestContext
+ * (progress, stream results) are relayed to the real transport, and a
+ * relayed progress notification extends the call's deadline as it would
+ * in-process.
+ *
+ * Failure handling: if the worker dies, the call's deadline
+ * (RequestContext::is_timeout_expired) passes, or cancel() names the
+ * call's request, the worker is killed and restarted and the call
+ * returns a CallToolResult with isError set. Handlers need not poll for
+ * cancellation.
+ *
+ * start() forks a single-threaded zygote process, and every worker
+ * (including replacements) is forked from the zygote rather than from the
+ * server, so a worker never inherits a lock held by another server thread.
+ * Handlers therefore see the server's memory as of start() and must not
+ * rely on other threads. Call start() before the server starts its own
+ * threads (transport readers, reactor, logger), and isolate all handlers
+ * before start().
+ *
+ * Thread safety: call(), cancel() and stats() may be used from any thread;
+ * calls beyond the worker count wait for a free worker.
+ */
+class WorkerPool {
+public:
+    /// Per-worker resource limits applied with setrlimit() (0 = unlimited)
+    struct Limits {
+        /// Address space cap in bytes (RLIMIT_AS); allocations beyond it fail
+        size_t max_memory_bytes = 0;
+
+        /// CPU time per worker process (RLIMIT_CPU); the worker gets SIGXCPU
+        std::chrono::seconds max_cpu{0};
+
+        /// Open file descriptor cap (RLIMIT_NOFILE)
+        size_t max_open_files = 0;
+    };
+
+    /// Pool options
+    struct Options {
+        /// Number of worker processes
+        size_t workers = 2;
+
+        /// Calls served before a worker is replaced (0 = never); bounds leaks
+        /// and the cumulative RLIMIT_CPU budget
+        size_t max_calls_per_worker = 0;
+
+        /// Resource limits for every worker
+        Limits limits;
+    };
+
+    /// Cumulative counters
+    struct Stats {
+        size_t workers = 0;          ///< Live worker processes
+        uint64_t calls = 0;          ///< Calls dispatched
+        uint64_t crashes = 0;        ///< Workers that died during a call
+        uint64_t timeouts = 0;       ///< Calls killed at their deadline
+        uint64_t cancellations = 0;  ///< Calls killed by cancel()
+        uint64_t restarts = 0;       ///< Workers forked after the first start()
+    };
+
+    WorkerPool();
+    explicit WorkerPool(Options options);
+
+    /// Stops the pool, waiting for in-flight calls to return
+    ~WorkerPool();
+
+    // Non-copyable, non-movable (isolated handlers reference this)
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    WorkerPool(WorkerPool&&) = delete;
+    WorkerPool& operator=(WorkerPool&&) = delete;
+
+    /**
+     * @brief Move a tool handler into the worker processes
+     *
+     * Must be called before start().
+     *
+     * @param name Tool name the handler is registered under
+     * @param handler Handler to run in the workers
+     * @return A handler that dispatches to the pool, for ToolRegistry
+     */
+    ToolHandler isolate(const std::string& name, ToolHandler handler);
+
+    /**
+     * @brief Fork the workers
+     *
+     * @return false if a worker could not be forked
+     */
+    bool start();
+
+    /**
+     * @brief Stop all workers
+     *
+     * In-flight calls are killed and return isError results; waiting
+     * calls return immediately.
+     */
+    void stop();
+
+    /**
+     * @brief Run an isolated handler in a worker
+     *
+     * Blocks until the worker answers, dies, the deadline passes or the
+     * call is cancelled.
+     *
+     * @param name Tool name passed to isolate()
+     * @param args Tool arguments (already validated)
+     * @param ctx Request context; its transport receives relayed notifications
+     * @return CallToolResult from the handler, or one with isError set
+     */
+    nlohmann::json call(const std::string& name, const nlohmann::json& args, RequestContext& ctx);
+
+    /**
+     * @brief Cancel the in-flight call for a request
+     *
+     * @param request_id RequestContext::request_id() of the call
+     * @return true if a running call was found and its worker killed
+     */
+    bool cancel(const std::string& request_id);
+
+    /// @return Current counters
+    Stats stats() const;
+
+private:
+    struct Worker {
+        pid_t pid = -1;
+        int fd = -1;                ///< Parent end of the socketpair
+        bool busy = false;
+        bool cancelled = false;
+        size_t calls = 0;
+        std::string request_id;     ///< Request of the in-flight call
+    };
+
+    /// Fork a worker from the zygote (takes zygote_mutex_ only)
+    bool spawn(pid_t& pid, int& fd);
+    /// Stop a worker and describe its exit (takes zygote_mutex_ only)
+    std::string reap(pid_t pid, int fd);
+    void stop_zygote();
+    [[noreturn]] void zygote_main(int fd);
+    [[noreturn]] void worker_main(int fd);
+
+    Options options_;
+    std::unordered_map<std::string, ToolHandler> handlers_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::vector<Worker> workers_;
+
+    /// Serializes round trips on the zygote socket; taken after mutex_
+    /// when both are held, and alone while a call replaces its worker
+    std::mutex zygote_mutex_;
+    pid_t zygote_pid_ = -1;
+    int zygote_fd_ = -1;            ///< Server end of the zygote control socket
+    Stats counters_;
+    bool running_ = false;
+};
+
+} // namespace server
+} // namespace mcpp
+
+#endif // MCPP_SERVER_WORKER_POOL_H
@@ -0,0 +1,168 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mcpp/transport/capture_replay.h"
+
+#include <optional>
+#include <thread>
+
+namespace mcpp {
+namespace transport {
+
+namespace {
+
+/// Parse a frame and return it if it is a JSON-RPC response
+std::optional<nlohmann::json> parse_response(std::string_view frame) {
+    auto msg = nlohmann::json::parse(frame, nullptr, false);
+    if (msg.is_discarded() || !msg.is_object() || !msg.contains("id") ||
+        msg.contains("method") || !(msg.contains("result") || msg.contains("error"))) {
+        return std::nullopt;
+    }
+    return msg;
+}
+
+} // anonymous namespace
+
+nlohmann::json ReplayReport::to_json() const {
+    nlohmann::json details = nlohmann::json::array();
+    for (const auto& m : mismatches) {
+        details.push_back({{"id", m.id}, {"expected", m.expected}, {"actual", m.actual}});
+    }
+    return {
+        {"framesSent", frames_sent},
+        {"responsesExpected", responses_expected},
+        {"matched", matched},
+        {"mismatched", mismatches.size()},
+        {"missing", missing},
+        {"elapsedMs", static_cast<double>(elapsed_ns) / 1e6},
+        {"mismatches", std::move(details)}
+    };
+}
+
+CaptureReplayer::CaptureReplayer(std::vector<CapturedFrame> frames, ReplayOptions options)
+    : frames_(std::move(frames))
+    , options_(std::move(options)) {
+    for (const auto& frame : frames_) {
+        if (frame.direction == options_.requests) {
+            continue;
+        }
+        if (auto response = parse_response(frame.payload)) {
+            std::string key = (*response)["id"].dump();
+            expected_[key] = normalized(std::move(*response));
+        }
+    }
+}
+
+ReplayReport CaptureReplayer::run(const SendFn& send) {
+    ReplayReport report;
+    report.responses_expected = expected_.size();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        actual_.clear();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::optional<uint64_t> first_ts;
+    double speed = options_.speed > 0.0 ? options_.speed : 1.0;
+
+    for (const auto& frame : frames_) {
+        if (frame.direction != options_.requests) {
+            continue;
+        }
+        if (options_.original_timing) {
+            if (!first_ts) {
+                first_ts = frame.timestamp_ns;
+            }
+            auto offset = std::chrono::nanoseconds(static_cast<int64_t>(
+                static_cast<double>(frame.timestamp_ns - *first_ts) / speed));
+            std::this_thread::sleep_until(start + offset);
+        }
+        if (send(frame.payload)) {
+            report.frames_sent++;
+        }
+    }
+
+    // Wait for the outstanding responses
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait_for(lock, options_.response_timeout, [this]() {
+        for (const auto& [id, _] : expected_) {
+            if (actual_.find(id) == actual_.end()) {
+                return false;
+            }
+        }
+        return true;
+    });
+
+    report.elapsed_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count());
+
+    for (const auto& [id, expected] : expected_) {
+        auto it = actual_.find(id);
+        if (it == actual_.end()) {
+            report.missing.push_back(id);
+        } else if (it->second == expected) {
+            report.matched++;
+        } else {
+            report.mismatches.push_back(ReplayMismatch{id, expected, it->second});
+        }
+    }
+    return report;
+}
+
+void CaptureReplayer::on_response(std::string_view message) {
+    auto response = parse_response(message);
+    if (!response) {
+        return;
+    }
+    std::string key = (*response)["id"].dump();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        actual_[key] = normalized(std::move(*response));
+    }
+    cv_.notify_all();
+}
+
+nlohmann::json CaptureReplayer::normalized(nlohmann::json message) const {
+    for (const auto& path : options_.ignore_paths) {
+        try {
+            nlohmann::json::json_pointer ptr(path);
+            if (!message.contains(ptr)) {
+                continue;
+            }
+            auto parent = ptr.parent_pointer();
+            auto& container = message.at(parent);
+            if (container.is_object()) {
+                container.erase(ptr.back());
+            } else if (container.is_array()) {
+                container.erase(std::stoul(ptr.back()));
+            }
+        } catch (const std::exception&) {
+            // Malformed pointer or index - ignore this path
+        }
+    }
+    return message;
+}
+
+} // namespace transport
+} // namespace mcpp
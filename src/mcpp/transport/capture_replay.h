@@ -0,0 +1,177 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef MCPP_TRANSPORT_CAPTURE_REPLAY_H
+#define MCPP_TRANSPORT_CAPTURE_REPLAY_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "mcpp/transport/capture_transport.h"
+
+namespace mcpp {
+namespace transport {
+
+/**
+ * @brief Options for CaptureReplayer
+ */
+struct ReplayOptions {
+    /// Reproduce the original inter-frame gaps (false = as fast as possible)
+    bool original_timing = true;
+
+    /// Timing multiplier when original_timing is set (2.0 = twice as fast)
+    double speed = 1.0;
+
+    /// Direction of the frames to re-send. Inbound for a server-side
+    /// capture, Outbound for a client-side capture.
+    CaptureDirection requests = CaptureDirection::Inbound;
+
+    /// JSON pointers removed from both responses before comparison
+    /// (e.g. "/result/serverInfo/version", "/result/task/createdAt")
+    std::vector<std::string> ignore_paths;
+
+    /// How long to wait for outstanding responses after the last send
+    std::chrono::milliseconds response_timeout{5000};
+};
+
+/**
+ * @brief A replayed response that differs from the recorded one
+ */
+struct ReplayMismatch {
+    std::string id;
+    nlohmann::json expected;
+    nlohmann::json actual;
+};
+
+/**
+ * @brief Outcome of a replay run
+ */
+struct ReplayReport {
+    size_t frames_sent = 0;
+    size_t responses_expected = 0;
+    size_t matched = 0;
+    std::vector<ReplayMismatch> mismatches;
+
+    /// Ids of recorded responses that never arrived
+    std::vector<std::string> missing;
+
+    /// Wall time of the run in nanoseconds
+    uint64_t elapsed_ns = 0;
+
+    /// True if every recorded response was reproduced
+    bool ok() const noexcept { return mismatches.empty() && missing.empty(); }
+
+    /// Summary as JSON (mismatch details included)
+    nlohmann::json to_json() const;
+};
+
+/**
+ * @brief Re-drives a peer with the frames of a captured session
+ *
+ * Frames in the request direction are sent in order, optionally with
+ * their original spacing. Frames in the other direction that are JSON-RPC
+ * responses become the expected results; the replayed peer's responses
+ * are fed back via on_response() and matched by id.
+ *
+ * Works for in-process targets (send() calls McpServer::handle_request
+ * and passes the result straight to on_response()) and for out-of-process
+ * targets (a reader thread calls on_response()).
+ *
+ * Thread safety: on_response() may be called from any thread while run()
+ * is executing. run() itself must not be called concurrently.
+ *
+ * Example usage:
+ *   CaptureReader reader;
+ *   reader.open("prod.mcpcap", err);
+ *   CaptureReplayer replayer(reader.read_session(0), {.original_timing = false});
+ *   auto report = replayer.run([&](std::string_view frame) {
+ *       if (auto r = server.handle_request(nlohmann::json::parse(frame))) {
+ *           replayer.on_response(r->dump());
+ *       }
+ *       return true;
+ *   });
+ */
+class CaptureReplayer {
+public:
+    /// Sends one frame to the replayed peer
+    using SendFn = std::function<bool(std::string_view)>;
+
+    /**
+     * @brief Prepare a replay
+     *
+     * @param frames Frames of one session, in capture order
+     * @param options Replay options
+     */
+    explicit CaptureReplayer(std::vector<CapturedFrame> frames, ReplayOptions options = {});
+
+    CaptureReplayer(const CaptureReplayer&) = delete;
+    CaptureReplayer& operator=(const CaptureReplayer&) = delete;
+
+    /**
+     * @brief Run the replay (blocking)
+     *
+     * @param send Function that delivers a frame to the replayed peer
+     * @return Replay report
+     */
+    ReplayReport run(const SendFn& send);
+
+    /**
+     * @brief Deliver a message produced by the replayed peer
+     *
+     * Non-response messages (notifications, server-initiated requests)
+     * are ignored.
+     *
+     * @param message Serialized JSON-RPC message
+     */
+    void on_response(std::string_view message);
+
+private:
+    nlohmann::json normalized(nlohmann::json message) const;
+
+    std::vector<CapturedFrame> frames_;
+    ReplayOptions options_;
+
+    /// Recorded responses keyed by serialized id
+    std::unordered_map<std::string, nlohmann::json> expected_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+
+    /// Replayed responses keyed by serialized id (guarded by mutex_)
+    std::unordered_map<std::string, nlohmann::json> actual_;
+};
+
+} // namespace transport
+} // namespace mcpp
+
+#endif // MCPP_TRANSPORT_CAPTURE_REPLAY_H
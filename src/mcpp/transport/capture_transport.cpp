@@ -0,0 +1,519 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mcpp/transport/capture_transport.h"
+
+#include <chrono>
+#include <cstring>
+
+#include "mcpp/transport/frame_limits.h"
+
+#if MCPP_HAS_ZSTD
+    #include <zstd.h>
+#endif
+
+namespace mcpp {
+namespace transport {
+
+namespace {
+
+constexpr char FILE_MAGIC[8] = {'M', 'C', 'P', 'P', 'C', 'A', 'P', '1'};
+constexpr char INDEX_MAGIC[8] = {'M', 'C', 'P', 'P', 'I', 'D', 'X', '1'};
+constexpr uint32_t FORMAT_VERSION = 1;
+constexpr uint32_t FLAG_ZSTD = 1u << 0;
+constexpr size_t HEADER_SIZE = 24;
+constexpr size_t TRAILER_SIZE = 16;
+
+// Record kinds (low 7 bits); bit 7 marks a compressed payload
+constexpr uint8_t KIND_INBOUND = 0;
+constexpr uint8_t KIND_OUTBOUND = 1;
+constexpr uint8_t KIND_SESSION = 2;
+constexpr uint8_t KIND_COMPRESSED = 0x80;
+
+/// Largest decompressed payload a reader accepts; a capture holds frames
+/// that already passed the transport's size limit
+const uint64_t MAX_RAW_LEN = FrameLimits{}.max_frame_bytes;
+
+uint64_t steady_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void put_u32(std::string& out, uint32_t v) {
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<char>((v >> (8 * i)) & 0xff));
+    }
+}
+
+void put_u64(std::string& out, uint64_t v) {
+    for (int i = 0; i < 8; ++i) {
+        out.push_back(static_cast<char>((v >> (8 * i)) & 0xff));
+    }
+}
+
+uint64_t get_u64(const unsigned char* p) {
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; --i) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+void put_varint(std::string& out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<char>((v & 0x7f) | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<char>(v));
+}
+
+bool read_varint(std::FILE* f, uint64_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        int c = std::fgetc(f);
+        if (c == EOF) {
+            return false;
+        }
+        v |= static_cast<uint64_t>(c & 0x7f) << shift;
+        if ((c & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool read_varint(const std::string& buf, size_t& pos, uint64_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 64 && pos < buf.size(); shift += 7) {
+        auto c = static_cast<unsigned char>(buf[pos++]);
+        v |= static_cast<uint64_t>(c & 0x7f) << shift;
+        if ((c & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// CaptureWriter
+// ============================================================================
+
+CaptureWriter::~CaptureWriter() {
+    close();
+}
+
+bool CaptureWriter::open(const std::string& path, CaptureOptions options) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (file_) {
+        return false;
+    }
+
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) {
+        return false;
+    }
+
+    options_ = options;
+#if MCPP_HAS_ZSTD
+    compress_ = options.compress;
+#else
+    compress_ = false;
+#endif
+    offset_ = 0;
+    sessions_.clear();
+    start_ns_ = steady_ns();
+    last_ns_ = start_ns_;
+
+    auto wall = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+
+    std::string header(FILE_MAGIC, sizeof(FILE_MAGIC));
+    put_u32(header, FORMAT_VERSION);
+    put_u32(header, compress_ ? FLAG_ZSTD : 0);
+    put_u64(header, wall);
+    write_bytes(header.data(), header.size());
+    return true;
+}
+
+bool CaptureWriter::compressing() const noexcept {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return compress_;
+}
+
+uint32_t CaptureWriter::begin_session(std::string_view label) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto id = static_cast<uint32_t>(sessions_.size());
+
+    CaptureSession session;
+    session.id = id;
+    session.label = std::string(label);
+    session.start_ns = steady_ns() - start_ns_;
+    session.first_offset = offset_;
+    sessions_.push_back(std::move(session));
+
+    if (file_) {
+        write_record(KIND_SESSION, id, label);
+    }
+    return id;
+}
+
+void CaptureWriter::record(uint32_t session, CaptureDirection direction, std::string_view payload) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!file_ || session >= sessions_.size()) {
+        return;
+    }
+    sessions_[session].frame_count++;
+    write_record(direction == CaptureDirection::Inbound ? KIND_INBOUND : KIND_OUTBOUND,
+                 session, payload);
+}
+
+void CaptureWriter::flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (file_) {
+        std::fflush(file_);
+    }
+}
+
+void CaptureWriter::close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!file_) {
+        return;
+    }
+
+    // Session index: count, then per session id/label/start/frames/offset
+    uint64_t index_offset = offset_;
+    std::string index;
+    put_varint(index, sessions_.size());
+    for (const auto& s : sessions_) {
+        put_varint(index, s.id);
+        put_varint(index, s.label.size());
+        index.append(s.label);
+        put_varint(index, s.start_ns);
+        put_varint(index, s.frame_count);
+        put_varint(index, s.first_offset);
+    }
+    put_u64(index, index_offset);
+    index.append(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    write_bytes(index.data(), index.size());
+
+    std::fclose(file_);
+    file_ = nullptr;
+}
+
+void CaptureWriter::write_record(uint8_t kind, uint32_t session, std::string_view payload) {
+    uint64_t now = steady_ns();
+    uint64_t delta = now >= last_ns_ ? now - last_ns_ : 0;
+    last_ns_ = now;
+
+    std::string_view stored = payload;
+#if MCPP_HAS_ZSTD
+    if (compress_ && kind != KIND_SESSION && payload.size() >= options_.compress_min_bytes) {
+        scratch_.resize(ZSTD_compressBound(payload.size()));
+        size_t n = ZSTD_compress(scratch_.data(), scratch_.size(),
+                                 payload.data(), payload.size(),
+                                 options_.compression_level);
+        if (!ZSTD_isError(n) && n < payload.size()) {
+            stored = std::string_view(scratch_.data(), n);
+            kind |= KIND_COMPRESSED;
+        }
+    }
+#endif
+
+    std::string header;
+    header.push_back(static_cast<char>(kind));
+    put_varint(header, delta);
+    put_varint(header, session);
+    put_varint(header, stored.size());
+    if (kind & KIND_COMPRESSED) {
+        put_varint(header, payload.size());
+    }
+    write_bytes(header.data(), header.size());
+    write_bytes(stored.data(), stored.size());
+}
+
+void CaptureWriter::write_bytes(const void* data, size_t size) {
+    if (size > 0 && std::fwrite(data, 1, size, file_) == size) {
+        offset_ += size;
+    }
+}
+
+// ============================================================================
+// CaptureReader
+// ============================================================================
+
+CaptureReader::~CaptureReader() {
+    if (file_) {
+        std::fclose(file_);
+    }
+}
+
+bool CaptureReader::open(const std::string& path, std::string& error_message) {
+    if (file_) {
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+    sessions_.clear();
+
+    file_ = std::fopen(path.c_str(), "rb");
+    if (!file_) {
+        error_message = "Cannot open capture file: " + path;
+        return false;
+    }
+
+    unsigned char header[HEADER_SIZE];
+    if (std::fread(header, 1, HEADER_SIZE, file_) != HEADER_SIZE ||
+        std::memcmp(header, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0) {
+        error_message = "Not an mcpp capture file: " + path;
+        return false;
+    }
+    uint32_t flags = static_cast<uint32_t>(header[12]) | (static_cast<uint32_t>(header[13]) << 8);
+#if !MCPP_HAS_ZSTD
+    if (flags & FLAG_ZSTD) {
+        error_message = "Capture file is zstd-compressed but mcpp was built without zstd";
+        return false;
+    }
+#else
+    (void)flags;
+#endif
+    wall_start_ns_ = get_u64(header + 16);
+    data_start_ = HEADER_SIZE;
+
+    std::fseek(file_, 0, SEEK_END);
+    auto size = static_cast<uint64_t>(std::ftell(file_));
+    data_end_ = size;
+
+    // Load the index from the trailer if the writer was closed cleanly
+    if (size >= HEADER_SIZE + TRAILER_SIZE) {
+        unsigned char trailer[TRAILER_SIZE];
+        std::fseek(file_, static_cast<long>(size - TRAILER_SIZE), SEEK_SET);
+        if (std::fread(trailer, 1, TRAILER_SIZE, file_) == TRAILER_SIZE &&
+            std::memcmp(trailer + 8, INDEX_MAGIC, sizeof(INDEX_MAGIC)) == 0) {
+            uint64_t index_offset = get_u64(trailer);
+            if (index_offset >= HEADER_SIZE && index_offset <= size - TRAILER_SIZE) {
+                std::string index(size - TRAILER_SIZE - index_offset, '\0');
+                std::fseek(file_, static_cast<long>(index_offset), SEEK_SET);
+                if (std::fread(index.data(), 1, index.size(), file_) == index.size()) {
+                    size_t pos = 0;
+                    uint64_t count = 0;
+                    bool ok = read_varint(index, pos, count);
+                    for (uint64_t i = 0; ok && i < count; ++i) {
+                        CaptureSession s;
+                        uint64_t id = 0, label_len = 0;
+                        ok = read_varint(index, pos, id) && read_varint(index, pos, label_len) &&
+                             pos + label_len <= index.size();
+                        if (!ok) {
+                            break;
+                        }
+                        s.id = static_cast<uint32_t>(id);
+                        s.label = index.substr(pos, label_len);
+                        pos += label_len;
+                        ok = read_varint(index, pos, s.start_ns) &&
+                             read_varint(index, pos, s.frame_count) &&
+                             read_varint(index, pos, s.first_offset);
+                        if (ok) {
+                            sessions_.push_back(std::move(s));
+                        }
+                    }
+                    if (ok) {
+                        data_end_ = index_offset;
+                    } else {
+                        sessions_.clear();
+                    }
+                }
+            }
+        }
+    }
+
+    // No (valid) index - rebuild it by scanning the records
+    if (data_end_ == size) {
+        rewind();
+        uint8_t kind = 0;
+        CapturedFrame frame;
+        uint64_t records = 0;
+        for (;;) {
+            auto record_offset = static_cast<uint64_t>(std::ftell(file_));
+            if (!read_record(kind, frame)) {
+                break;
+            }
+            ++records;
+            if ((kind & 0x7f) == KIND_SESSION) {
+                // Writers number sessions in record order, so an id past
+                // the records read so far means a corrupt file
+                if (frame.session >= records) {
+                    break;
+                }
+                CaptureSession s;
+                s.id = frame.session;
+                s.label = std::move(frame.payload);
+                s.start_ns = frame.timestamp_ns;
+                s.first_offset = record_offset;
+                if (sessions_.size() <= s.id) {
+                    sessions_.resize(s.id + 1);
+                }
+                sessions_[s.id] = std::move(s);
+            } else if (frame.session < sessions_.size()) {
+                sessions_[frame.session].frame_count++;
+            }
+        }
+    }
+
+    rewind();
+    return true;
+}
+
+void CaptureReader::rewind() {
+    if (file_) {
+        std::fseek(file_, static_cast<long>(data_start_), SEEK_SET);
+    }
+    last_ns_ = 0;
+}
+
+bool CaptureReader::next(CapturedFrame& frame) {
+    uint8_t kind = 0;
+    while (read_record(kind, frame)) {
+        if ((kind & 0x7f) != KIND_SESSION) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<CapturedFrame> CaptureReader::read_session(uint32_t session) {
+    std::vector<CapturedFrame> frames;
+    rewind();
+    CapturedFrame frame;
+    while (next(frame)) {
+        if (frame.session == session) {
+            frames.push_back(std::move(frame));
+        }
+    }
+    rewind();
+    return frames;
+}
+
+bool CaptureReader::read_record(uint8_t& kind, CapturedFrame& frame) {
+    if (!file_ || static_cast<uint64_t>(std::ftell(file_)) >= data_end_) {
+        return false;
+    }
+
+    int c = std::fgetc(file_);
+    if (c == EOF) {
+        return false;
+    }
+    kind = static_cast<uint8_t>(c);
+
+    uint64_t delta = 0, session = 0, stored_len = 0, raw_len = 0;
+    if (!read_varint(file_, delta) || !read_varint(file_, session) ||
+        !read_varint(file_, stored_len)) {
+        return false;
+    }
+    bool compressed = (kind & KIND_COMPRESSED) != 0;
+    if (compressed && !read_varint(file_, raw_len)) {
+        return false;
+    }
+
+    // Lengths come from the file; never allocate past what it can hold
+    if (stored_len > data_end_ - static_cast<uint64_t>(std::ftell(file_)) ||
+        raw_len > MAX_RAW_LEN) {
+        return false;
+    }
+
+    std::string stored(stored_len, '\0');
+    if (stored_len > 0 && std::fread(stored.data(), 1, stored_len, file_) != stored_len) {
+        return false;
+    }
+
+    last_ns_ += delta;
+    frame.timestamp_ns = last_ns_;
+    frame.session = static_cast<uint32_t>(session);
+    frame.direction = (kind & 0x7f) == KIND_OUTBOUND
+        ? CaptureDirection::Outbound : CaptureDirection::Inbound;
+
+    if (!compressed) {
+        frame.payload = std::move(stored);
+        return true;
+    }
+
+#if MCPP_HAS_ZSTD
+    if (ZSTD_getFrameContentSize(stored.data(), stored.size()) != raw_len) {
+        return false;
+    }
+    frame.payload.resize(raw_len);
+    size_t n = ZSTD_decompress(frame.payload.data(), raw_len, stored.data(), stored.size());
+    return !ZSTD_isError(n) && n == raw_len;
+#else
+    return false;
+#endif
+}
+
+// ============================================================================
+// CaptureTransport
+// ============================================================================
+
+CaptureTransport::CaptureTransport(std::unique_ptr<Transport> inner,
+                                   std::shared_ptr<CaptureWriter> writer,
+                                   std::string_view label)
+    : inner_(std::move(inner))
+    , writer_(std::move(writer))
+    , session_(writer_->begin_session(label)) {
+}
+
+bool CaptureTransport::connect() {
+    return inner_->connect();
+}
+
+void CaptureTransport::disconnect() {
+    inner_->disconnect();
+    writer_->flush();
+}
+
+bool CaptureTransport::is_connected() const {
+    return inner_->is_connected();
+}
+
+bool CaptureTransport::send(std::string_view message) {
+    writer_->record(session_, CaptureDirection::Outbound, message);
+    return inner_->send(message);
+}
+
+void CaptureTransport::set_message_callback(MessageCallback cb) {
+    if (!cb) {
+        inner_->set_message_callback(nullptr);
+        return;
+    }
+    inner_->set_message_callback(
+        [writer = writer_, session = session_, cb = std::move(cb)](std::string_view message) {
+            writer->record(session, CaptureDirection::Inbound, message);
+            cb(message);
+        });
+}
+
+void CaptureTransport::set_error_callback(ErrorCallback cb) {
+    inner_->set_error_callback(std::move(cb));
+}
+
+} // namespace transport
+} // namespace mcpp
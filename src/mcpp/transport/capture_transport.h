@@ -0,0 +1,307 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef MCPP_TRANSPORT_CAPTURE_TRANSPORT_H
+#define MCPP_TRANSPORT_CAPTURE_TRANSPORT_H
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "mcpp/transport/transport.h"
+
+namespace mcpp {
+namespace transport {
+
+/**
+ * @brief Direction of a captured frame relative to the capturing process
+ */
+enum class CaptureDirection : uint8_t {
+    Inbound = 0,   ///< Received through the message callback
+    Outbound = 1   ///< Passed to send()
+};
+
+/**
+ * @brief One frame read back from a capture file
+ */
+struct CapturedFrame {
+    /// Session the frame belongs to (see CaptureWriter::begin_session)
+    uint32_t session = 0;
+
+    /// Inbound or outbound
+    CaptureDirection direction = CaptureDirection::Inbound;
+
+    /// Nanoseconds since the capture file was opened
+    uint64_t timestamp_ns = 0;
+
+    /// Frame payload (decompressed)
+    std::string payload;
+};
+
+/**
+ * @brief Session index entry
+ *
+ * A session is one transport connection. Several sessions may share a
+ * capture file (e.g. one per HTTP session); their frames interleave.
+ */
+struct CaptureSession {
+    uint32_t id = 0;
+    std::string label;
+    uint64_t start_ns = 0;
+    uint64_t frame_count = 0;
+
+    /// File offset of the session's first record (start of scan)
+    uint64_t first_offset = 0;
+};
+
+/**
+ * @brief Options for CaptureWriter
+ */
+struct CaptureOptions {
+    /// Compress frame payloads with zstd (ignored if built without zstd)
+    bool compress = false;
+
+    /// zstd compression level
+    int compression_level = 3;
+
+    /// Frames smaller than this are never compressed
+    size_t compress_min_bytes = 256;
+};
+
+/**
+ * @brief Writes timestamped frames to a compact binary capture file
+ *
+ * File layout:
+ * - 24-byte header: magic "MCPPCAP1", u32 version, u32 flags,
+ *   u64 wall-clock start (ns since Unix epoch), all little-endian
+ * - Records: u8 kind (bit 7 = zstd-compressed), then varints for
+ *   timestamp delta (ns), session id, stored length and - if compressed -
+ *   raw length, followed by the payload bytes
+ * - On close(): a session index block followed by a 16-byte trailer
+ *   (u64 index offset + magic "MCPPIDX1")
+ *
+ * A file without a trailer (e.g. the process crashed) is still readable;
+ * CaptureReader rebuilds the index by scanning.
+ *
+ * Thread safety: All methods are thread-safe. Frames from a transport's
+ * read thread and from senders on other threads are serialized by an
+ * internal mutex.
+ */
+class CaptureWriter {
+public:
+    CaptureWriter() = default;
+
+    /**
+     * @brief Closes the file (writing the session index) if still open
+     */
+    ~CaptureWriter();
+
+    CaptureWriter(const CaptureWriter&) = delete;
+    CaptureWriter& operator=(const CaptureWriter&) = delete;
+    CaptureWriter(CaptureWriter&&) = delete;
+    CaptureWriter& operator=(CaptureWriter&&) = delete;
+
+    /**
+     * @brief Create (truncate) a capture file
+     *
+     * @param path File path
+     * @param options Compression options
+     * @return true on success, false if the file cannot be created
+     */
+    bool open(const std::string& path, CaptureOptions options = {});
+
+    /**
+     * @brief Whether compression is actually in effect
+     *
+     * False if compression was not requested or mcpp was built without zstd.
+     */
+    bool compressing() const noexcept;
+
+    /**
+     * @brief Start a new session
+     *
+     * @param label Free-form label (e.g. session ID or peer name)
+     * @return Session id to pass to record()
+     */
+    uint32_t begin_session(std::string_view label);
+
+    /**
+     * @brief Append a frame
+     *
+     * @param session Session id from begin_session()
+     * @param direction Inbound or outbound
+     * @param payload Frame bytes
+     */
+    void record(uint32_t session, CaptureDirection direction, std::string_view payload);
+
+    /**
+     * @brief Flush buffered records to the file
+     */
+    void flush();
+
+    /**
+     * @brief Write the session index and close the file
+     */
+    void close();
+
+private:
+    void write_record(uint8_t kind, uint32_t session, std::string_view payload);
+    void write_bytes(const void* data, size_t size);
+
+    mutable std::mutex mutex_;
+    std::FILE* file_ = nullptr;
+    CaptureOptions options_;
+    bool compress_ = false;
+    uint64_t offset_ = 0;
+    uint64_t start_ns_ = 0;
+    uint64_t last_ns_ = 0;
+    std::vector<CaptureSession> sessions_;
+    std::string scratch_;
+};
+
+/**
+ * @brief Reads a capture file written by CaptureWriter
+ *
+ * Thread safety: Not thread-safe.
+ */
+class CaptureReader {
+public:
+    CaptureReader() = default;
+    ~CaptureReader();
+
+    CaptureReader(const CaptureReader&) = delete;
+    CaptureReader& operator=(const CaptureReader&) = delete;
+
+    /**
+     * @brief Open a capture file and load its session index
+     *
+     * @param path File path
+     * @param error_message Receives a description on failure
+     * @return true on success
+     */
+    bool open(const std::string& path, std::string& error_message);
+
+    /**
+     * @brief Session index (from the trailer, or rebuilt by scanning)
+     */
+    const std::vector<CaptureSession>& sessions() const noexcept { return sessions_; }
+
+    /**
+     * @brief Wall-clock time the capture started (ns since Unix epoch)
+     */
+    uint64_t wall_clock_start_ns() const noexcept { return wall_start_ns_; }
+
+    /**
+     * @brief Read the next frame in file order
+     *
+     * @param frame Receives the frame
+     * @return false at end of file or on a corrupt/unsupported record
+     */
+    bool next(CapturedFrame& frame);
+
+    /**
+     * @brief Rewind to the first record
+     */
+    void rewind();
+
+    /**
+     * @brief Read every frame of one session, in order
+     *
+     * @param session Session id
+     * @return Frames of that session
+     */
+    std::vector<CapturedFrame> read_session(uint32_t session);
+
+private:
+    bool read_record(uint8_t& kind, CapturedFrame& frame);
+
+    std::FILE* file_ = nullptr;
+    uint64_t data_start_ = 0;
+    uint64_t data_end_ = 0;
+    uint64_t wall_start_ns_ = 0;
+    uint64_t last_ns_ = 0;
+    std::vector<CaptureSession> sessions_;
+};
+
+/**
+ * @brief Transport decorator that records every frame to a CaptureWriter
+ *
+ * Wraps another transport: outbound frames are recorded in send() before
+ * being forwarded, inbound frames are recorded before the user's message
+ * callback runs. Recording is synchronous but buffered, so the hot path
+ * cost is a mutex and a memcpy.
+ *
+ * Example usage:
+ *   auto writer = std::make_shared<CaptureWriter>();
+ *   writer->open("session.mcpcap", {.compress = true});
+ *   CaptureTransport transport(std::make_unique<MyTransport>(), writer, "client-1");
+ *   server.set_transport(transport);
+ */
+class CaptureTransport : public Transport {
+public:
+    /**
+     * @brief Wrap a transport
+     *
+     * @param inner Transport that does the actual I/O
+     * @param writer Shared capture writer (may be shared across transports)
+     * @param label Session label written to the index
+     */
+    CaptureTransport(std::unique_ptr<Transport> inner,
+                     std::shared_ptr<CaptureWriter> writer,
+                     std::string_view label = {});
+
+    ~CaptureTransport() override = default;
+
+    bool connect() override;
+    void disconnect() override;
+    bool is_connected() const override;
+    bool send(std::string_view message) override;
+    void set_message_callback(MessageCallback cb) override;
+    void set_error_callback(ErrorCallback cb) override;
+
+    /**
+     * @brief Session id assigned by the writer
+     */
+    uint32_t session() const noexcept { return session_; }
+
+    /**
+     * @brief Access the wrapped transport
+     */
+    Transport& inner() noexcept { return *inner_; }
+
+private:
+    std::unique_ptr<Transport> inner_;
+    std::shared_ptr<CaptureWriter> writer_;
+    uint32_t session_;
+};
+
+} // namespace transport
+} // namespace mcpp
+
+#endif // MCPP_TRANSPORT_CAPTURE_TRANSPORT_H
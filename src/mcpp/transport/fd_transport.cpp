@@ -0,0 +1,324 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mcpp/transport/fd_transport.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+namespace mcpp {
+namespace transport {
+
+namespace {
+
+bool set_nonblocking(int fd) {
+    int flags = ::fcntl(fd, F_GETFL, 0);
+    if (flags < 0) {
+        return false;
+    }
+    return (flags & O_NONBLOCK) || ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+bool is_socket(int fd) {
+    struct stat st{};
+    return ::fstat(fd, &st) == 0 && S_ISSOCK(st.st_mode);
+}
+
+} // namespace
+
+FdTransport::FdTransport(async::Reactor& reactor, int in_fd, int out_fd)
+    : FdTransport(reactor, in_fd, out_fd, Options{}) {}
+
+FdTransport::FdTransport(async::Reactor& reactor, int in_fd, int out_fd, Options options)
+    : reactor_(reactor)
+    , in_fd_(in_fd)
+    , out_fd_(out_fd)
+    , options_(options) {}
+
+FdTransport::~FdTransport() {
+    disconnect();
+    if (options_.owns_fds) {
+        if (in_fd_ >= 0) {
+            ::close(in_fd_);
+        }
+        if (out_fd_ >= 0 && out_fd_ != in_fd_) {
+            ::close(out_fd_);
+        }
+    }
+}
+
+bool FdTransport::connect() {
+    if (connected_) {
+        return true;
+    }
+    if (in_fd_ < 0 || out_fd_ < 0 || !set_nonblocking(in_fd_) || !set_nonblocking(out_fd_)) {
+        return false;
+    }
+    if (reactor_.uses_io_uring() && is_socket(in_fd_)) {
+        recv_op_ = reactor_.recv_multishot(in_fd_, [this](std::string_view data, int result) {
+            on_recv(data, result);
+        });
+    }
+    if (recv_op_ == 0 && !reactor_.add(in_fd_, async::Reactor::Readable, [this](uint32_t events) {
+            on_input(events);
+        })) {
+        return false;
+    }
+    alive_ = std::make_shared<bool>(true);
+    framer_.reset();
+    connected_ = true;
+    return true;
+}
+
+void FdTransport::disconnect() {
+    if (!connected_) {
+        return;
+    }
+    connected_ = false;
+    if (recv_op_ != 0) {
+        reactor_.cancel(recv_op_);
+        recv_op_ = 0;
+    }
+    reactor_.remove(in_fd_);
+    if (out_fd_ != in_fd_) {
+        reactor_.remove(out_fd_);
+    }
+    want_write_ = false;
+    out_buffer_.clear();
+    out_offset_ = 0;
+    alive_.reset();
+    queued_.clear();
+    queued_bytes_ = 0;
+    inflight_bytes_ = 0;
+    write_scheduled_ = false;
+    write_inflight_ = false;
+}
+
+bool FdTransport::send(std::string_view message) {
+    if (!connected_) {
+        return false;
+    }
+    if (reactor_.uses_io_uring()) {
+        // Collect this iteration's messages and submit them together as
+        // one linked chain once the reactor has finished dispatching
+        std::string line;
+        line.reserve(message.size() + 1);
+        line.append(message);
+        line.push_back('\n');
+        queued_bytes_ += line.size();
+        queued_.emplace_back(std::move(line));
+        if (!write_scheduled_ && !write_inflight_) {
+            write_scheduled_ = true;
+            reactor_.defer([this, alive = std::weak_ptr<bool>(alive_)] {
+                if (alive.expired()) {
+                    return;
+                }
+                write_scheduled_ = false;
+                submit_writes();
+            });
+        }
+        return true;
+    }
+    // Compact once everything queued so far has been written
+    if (out_offset_ == out_buffer_.size()) {
+        out_buffer_.clear();
+        out_offset_ = 0;
+    }
+    out_buffer_.reserve(out_buffer_.size() + message.size() + 1);
+    out_buffer_.append(message);
+    out_buffer_.push_back('\n');
+
+    if (want_write_) {
+        return true;  // already waiting for EPOLLOUT; keep ordering
+    }
+    return flush();
+}
+
+bool FdTransport::flush() {
+    while (out_offset_ < out_buffer_.size()) {
+        ssize_t n = ::write(out_fd_, out_buffer_.data() + out_offset_,
+                            out_buffer_.size() - out_offset_);
+        if (n > 0) {
+            out_offset_ += static_cast<size_t>(n);
+            continue;
+        }
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            if (!want_write_) {
+                want_write_ = true;
+                update_output_interest();
+            }
+            return true;
+        }
+        report_error(std::string("write failed: ") + std::strerror(errno));
+        return false;
+    }
+
+    out_buffer_.clear();
+    out_offset_ = 0;
+    if (want_write_) {
+        want_write_ = false;
+        update_output_interest();
+    }
+    return true;
+}
+
+void FdTransport::submit_writes() {
+    if (queued_.empty() || write_inflight_) {
+        return;
+    }
+    write_inflight_ = true;
+    inflight_bytes_ = queued_bytes_;
+    queued_bytes_ = 0;
+    std::vector<util::SharedBuffer> chain;
+    chain.swap(queued_);
+    bool submitted = reactor_.write_chain(
+        out_fd_, std::move(chain), [this, alive = std::weak_ptr<bool>(alive_)](int error) {
+            if (alive.expired()) {
+                return;
+            }
+            write_inflight_ = false;
+            inflight_bytes_ = 0;
+            if (error != 0) {
+                report_error(std::string("write failed: ") + std::strerror(-error));
+                return;
+            }
+            // Messages sent while this chain was in flight go out next
+            submit_writes();
+        });
+    if (!submitted) {
+        write_inflight_ = false;
+        report_error("write failed: submission rejected");
+    }
+}
+
+void FdTransport::update_output_interest() {
+    if (out_fd_ == in_fd_) {
+        uint32_t interest = async::Reactor::Readable;
+        if (want_write_) {
+            interest |= async::Reactor::Writable;
+        }
+        reactor_.modify(in_fd_, interest);
+        return;
+    }
+    if (want_write_) {
+        reactor_.add(out_fd_, async::Reactor::Writable, [this](uint32_t events) {
+            on_output(events);
+        });
+    } else {
+        reactor_.remove(out_fd_);
+    }
+}
+
+void FdTransport::on_output(uint32_t events) {
+    if (events & async::Reactor::Writable) {
+        flush();
+    } else if (events & async::Reactor::Closed) {
+        report_error("output closed");
+    }
+}
+
+void FdTransport::on_input(uint32_t events) {
+    if (out_fd_ == in_fd_ && (events & async::Reactor::Writable)) {
+        if (!flush() || !connected_) {
+            return;
+        }
+    }
+    if (!(events & (async::Reactor::Readable | async::Reactor::Closed))) {
+        return;
+    }
+
+    // Registration is level-triggered, but draining here saves a round trip
+    // through epoll_wait for large bursts.
+    read_buffer_.resize(options_.read_chunk);
+    while (connected_) {
+        ssize_t n = ::read(in_fd_, read_buffer_.data(), read_buffer_.size());
+        if (n > 0) {
+            deliver(std::string_view(read_buffer_.data(), static_cast<size_t>(n)));
+            continue;
+        }
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return;
+        }
+        report_error(n == 0 ? std::string("EOF") : std::string("read failed: ") + std::strerror(errno));
+        return;
+    }
+}
+
+void FdTransport::on_recv(std::string_view data, int result) {
+    if (result > 0) {
+        deliver(data);
+        return;
+    }
+    recv_op_ = 0;  // the operation ends with a non-positive result
+    if (result == -EINVAL) {
+        // Kernel has provided buffers but not multishot recv (5.19);
+        // fall back to readiness
+        if (reactor_.add(in_fd_, async::Reactor::Readable, [this](uint32_t events) {
+                on_input(events);
+            })) {
+            return;
+        }
+    }
+    report_error(result == 0 ? std::string("EOF")
+                             : std::string("read failed: ") + std::strerror(-result));
+}
+
+void FdTransport::deliver(std::string_view data) {
+    framer_.feed(data, options_.limits, [this](std::string_view line, FrameError error) {
+        if (error != FrameError::None) {
+            reject_frame(error);
+        } else if (message_callback_) {
+            message_callback_(line);
+        }
+        return connected_;
+    });
+}
+
+void FdTransport::reject_frame(FrameError error) {
+    send(make_frame_error_response(error));
+    if (error_callback_) {
+        error_callback_(std::string("rejected frame: ") + to_string(error));
+    }
+}
+
+void FdTransport::report_error(std::string_view message) {
+    disconnect();
+    if (error_callback_) {
+        error_callback_(message);
+    }
+}
+
+} // namespace transport
+} // namespace mcpp
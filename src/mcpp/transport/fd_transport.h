@@ -0,0 +1,177 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef MCPP_TRANSPORT_FD_TRANSPORT_H
+#define MCPP_TRANSPORT_FD_TRANSPORT_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "mcpp/async/reactor.h"
+#include "mcpp/transport/frame_limits.h"
+#include "mcpp/transport/transport.h"
+#include "mcpp/util/shared_buffer.h"
+
+namespace mcpp {
+namespace transport {
+
+/**
+ * @brief Newline-delimited transport over raw descriptors, driven by a Reactor
+ *
+ * FdTransport speaks the stdio framing (one JSON-RPC message per line)
+ * over any pair of pollable descriptors: the process's own stdin/stdout,
+ * a pipe pair, or a connected Unix/TCP socket (pass the same fd twice).
+ * Unlike StdioTransport it owns no thread; reads and buffered writes are
+ * dispatched by the async::Reactor it is attached to, which makes it the
+ * natural transport for MCPP_SINGLE_THREADED builds.
+ *
+ * Both descriptors are switched to non-blocking mode on connect(). Writes
+ * that cannot complete immediately are queued and flushed when the output
+ * descriptor becomes writable.
+ *
+ * On a reactor using Backend::IoUring the transport switches to
+ * completion-based I/O: socket input arrives through one multishot recv
+ * instead of a readiness wakeup plus read() per chunk, and every message
+ * sent during a reactor iteration goes out as one linked write chain in
+ * a single submission. Non-socket input (pipes, terminals) keeps the
+ * readiness path, which the reactor serves with io_uring polls.
+ *
+ * @note epoll cannot watch regular files, so connect() fails when stdin is
+ *       redirected from a file; use StdioTransport in that case.
+ *
+ * Thread safety: Must be used on the reactor's thread.
+ */
+class FdTransport : public Transport {
+public:
+    /// Construction options
+    struct Options {
+        /// Close the descriptors in the destructor
+        bool owns_fds = false;
+        /// Pre-parse limits; violating lines are dropped, answered with a
+        /// JSON-RPC parse error and reported to the error callback
+        FrameLimits limits;
+        /// Bytes to read per read() call
+        size_t read_chunk = 64 * 1024;
+    };
+
+    /**
+     * @brief Create a transport over the given descriptors
+     *
+     * @param reactor Event loop that will drive this transport (must outlive it)
+     * @param in_fd Descriptor to read messages from
+     * @param out_fd Descriptor to write messages to (may equal in_fd)
+     */
+    FdTransport(async::Reactor& reactor, int in_fd, int out_fd);
+
+    /// @copydoc FdTransport(async::Reactor&, int, int)
+    FdTransport(async::Reactor& reactor, int in_fd, int out_fd, Options options);
+
+    /**
+     * @brief Destructor - unregisters from the reactor, closes owned fds
+     */
+    ~FdTransport() override;
+
+    // Non-copyable, non-movable (registered with the reactor by address)
+    FdTransport(const FdTransport&) = delete;
+    FdTransport& operator=(const FdTransport&) = delete;
+    FdTransport(FdTransport&&) = delete;
+    FdTransport& operator=(FdTransport&&) = delete;
+
+    /**
+     * @brief Register the input descriptor with the reactor
+     *
+     * @return false if the descriptors are invalid or cannot be polled
+     */
+    bool connect() override;
+
+    /**
+     * @brief Unregister from the reactor
+     *
+     * Pending output that could not be written is discarded.
+     */
+    void disconnect() override;
+
+    bool is_connected() const override { return connected_; }
+
+    /**
+     * @brief Send a message followed by '\n'
+     *
+     * Writes as much as possible immediately and queues the rest.
+     *
+     * @return false if not connected or the descriptor reported an error
+     */
+    bool send(std::string_view message) override;
+
+    void set_message_callback(MessageCallback cb) override { message_callback_ = std::move(cb); }
+    void set_error_callback(ErrorCallback cb) override { error_callback_ = std::move(cb); }
+
+    /// @return Bytes queued for writing but not yet accepted by the kernel
+    size_t pending_output() const {
+        return out_buffer_.size() - out_offset_ + queued_bytes_ + inflight_bytes_;
+    }
+
+private:
+    void on_input(uint32_t events);
+    void on_output(uint32_t events);
+    bool flush();
+    void on_recv(std::string_view data, int result);
+    void submit_writes();
+    void update_output_interest();
+    void deliver(std::string_view data);
+    void reject_frame(FrameError error);
+    void report_error(std::string_view message);
+
+    async::Reactor& reactor_;
+    int in_fd_;
+    int out_fd_;
+    Options options_;
+    bool connected_ = false;
+    bool want_write_ = false;
+
+    LineFramer framer_;
+    std::string read_buffer_;
+    std::string out_buffer_;
+    size_t out_offset_ = 0;
+
+    // io_uring mode
+    async::Reactor::OpId recv_op_ = 0;
+    std::vector<util::SharedBuffer> queued_;  ///< Sent this iteration, not yet submitted
+    size_t queued_bytes_ = 0;
+    size_t inflight_bytes_ = 0;
+    bool write_scheduled_ = false;
+    bool write_inflight_ = false;
+    /// Expires on disconnect so late write completions are ignored
+    std::shared_ptr<bool> alive_;
+
+    MessageCallback message_callback_;
+    ErrorCallback error_callback_;
+};
+
+} // namespace transport
+} // namespace mcpp
+
+#endif // MCPP_TRANSPORT_FD_TRANSPORT_H
@@ -0,0 +1,134 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mcpp/transport/frame_limits.h"
+
+#include <cstring>
+
+#include <nlohmann/json.hpp>
+
+#include "mcpp/core/error.h"
+#include "mcpp/util/utf8.h"
+
+namespace mcpp {
+namespace transport {
+
+namespace {
+
+/**
+ * @brief Whether object/array nesting in @p frame exceeds @p max_depth
+ *
+ * Not a JSON validator: brackets inside strings are skipped and anything
+ * else malformed is left for the parser to report.
+ */
+bool exceeds_depth(std::string_view frame, size_t max_depth) {
+    const char* p = frame.data();
+    const char* const end = p + frame.size();
+    size_t depth = 0;
+
+    while (p < end) {
+        char c = *p++;
+        switch (c) {
+        case '{':
+        case '[':
+            if (++depth > max_depth) {
+                return true;
+            }
+            break;
+        case '}':
+        case ']':
+            if (depth > 0) {
+                --depth;
+            }
+            break;
+        case '"':
+            // Jump to the closing quote: one not preceded by an odd number
+            // of backslashes. Long string values cost a memchr, not a loop.
+            while (true) {
+                const void* quote = std::memchr(p, '"', static_cast<size_t>(end - p));
+                if (quote == nullptr) {
+                    return false;  // Unterminated string; the parser reports it
+                }
+                const char* q = static_cast<const char*>(quote);
+                size_t backslashes = 0;
+                for (const char* b = q; b > p && b[-1] == '\\'; --b) {
+                    ++backslashes;
+                }
+                p = q + 1;
+                if (backslashes % 2 == 0) {
+                    break;
+                }
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    return false;
+}
+
+} // anonymous namespace
+
+const char* to_string(FrameError error) {
+    switch (error) {
+    case FrameError::None:
+        return "ok";
+    case FrameError::TooLarge:
+        return "frame exceeds max_frame_bytes";
+    case FrameError::InvalidUtf8:
+        return "frame is not valid UTF-8";
+    case FrameError::TooDeep:
+        return "frame exceeds max_depth";
+    }
+    return "unknown frame error";
+}
+
+FrameError check_frame(std::string_view frame, const FrameLimits& limits) {
+    if (limits.max_frame_bytes != 0 && frame.size() > limits.max_frame_bytes) {
+        return FrameError::TooLarge;
+    }
+    if (limits.max_depth != 0 && exceeds_depth(frame, limits.max_depth)) {
+        return FrameError::TooDeep;
+    }
+    if (limits.validate_utf8 && !util::is_valid_utf8(frame)) {
+        return FrameError::InvalidUtf8;
+    }
+    return FrameError::None;
+}
+
+std::string make_frame_error_response(FrameError error) {
+    nlohmann::json response{
+        {"jsonrpc", "2.0"},
+        {"id", nullptr},
+        {"error", {
+            {"code", core::PARSE_ERROR},
+            {"message", "Parse error"},
+            {"data", to_string(error)}
+        }}
+    };
+    return response.dump();
+}
+
+} // namespace transport
+} // namespace mcpp
@@ -0,0 +1,168 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef MCPP_TRANSPORT_FRAME_LIMITS_H
+#define MCPP_TRANSPORT_FRAME_LIMITS_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace mcpp {
+namespace transport {
+
+/**
+ * @brief Per-transport limits applied to every incoming frame
+ *
+ * Checked before a frame reaches the JSON parser so pathological input
+ * (multi-GB lines, invalid UTF-8, deeply nested arrays) is rejected at a
+ * fraction of the cost of a failed DOM parse.
+ */
+struct FrameLimits {
+    /// Largest accepted frame in bytes (0 = unlimited)
+    size_t max_frame_bytes = 16 * 1024 * 1024;
+
+    /// Deepest accepted object/array nesting (0 = unlimited)
+    size_t max_depth = 128;
+
+    /// Reject frames that are not well-formed UTF-8
+    bool validate_utf8 = true;
+};
+
+/// Why a frame was rejected
+enum class FrameError {
+    None,           ///< Frame passed all checks
+    TooLarge,       ///< Larger than max_frame_bytes
+    InvalidUtf8,    ///< Not well-formed UTF-8
+    TooDeep         ///< Nesting deeper than max_depth
+};
+
+/// @return Human-readable reason ("frame exceeds max_frame_bytes", ...)
+const char* to_string(FrameError error);
+
+/**
+ * @brief Run the pre-parse checks on a complete frame
+ *
+ * Checks, cheapest first: size, nesting depth (a single pass that skips
+ * string contents with memchr), then UTF-8 (see util::is_valid_utf8).
+ *
+ * @param frame Raw frame bytes, without framing delimiters
+ * @param limits Limits to enforce
+ * @return FrameError::None if the frame may be handed to the parser
+ */
+FrameError check_frame(std::string_view frame, const FrameLimits& limits);
+
+/**
+ * @brief Serialized JSON-RPC parse error (-32700) for a rejected frame
+ *
+ * The id is null because the frame was never parsed. The reason from
+ * to_string() is carried in error.data.
+ */
+std::string make_frame_error_response(FrameError error);
+
+/**
+ * @brief Splits a newline-delimited byte stream into checked frames
+ *
+ * Shared by the line-oriented transports (stdio, fd, child process).
+ * Lines that arrive whole in one chunk are passed on without copying;
+ * only a line split across chunks is buffered. Once a partial line
+ * exceeds max_frame_bytes it is reported once and the rest of it, up to
+ * the next newline, is dropped unbuffered. Empty lines are skipped and a
+ * trailing '\r' is removed.
+ */
+class LineFramer {
+public:
+    /**
+     * @brief Consume a chunk of input
+     *
+     * @param data Bytes read from the stream
+     * @param limits Limits to enforce
+     * @param sink Called as sink(frame, error) for every line: error is
+     *             FrameError::None for an accepted frame, else the reason
+     *             to reject it (frame is then empty for a dropped partial
+     *             line). Returns false to stop; the rest of @p data is
+     *             discarded.
+     * @return false if @p sink asked to stop
+     */
+    template <typename Sink>
+    bool feed(std::string_view data, const FrameLimits& limits, Sink&& sink);
+
+    /// Drop any buffered partial line
+    void reset() {
+        buffer_.clear();
+        discarding_ = false;
+    }
+
+private:
+    std::string buffer_;
+    bool discarding_ = false;
+};
+
+template <typename Sink>
+bool LineFramer::feed(std::string_view data, const FrameLimits& limits, Sink&& sink) {
+    while (!data.empty()) {
+        const size_t newline = data.find('\n');
+        const bool complete = newline != std::string_view::npos;
+        std::string_view piece = complete ? data.substr(0, newline) : data;
+        data.remove_prefix(complete ? newline + 1 : data.size());
+
+        if (discarding_) {
+            discarding_ = !complete;
+            continue;
+        }
+
+        if (!complete) {
+            buffer_.append(piece);
+            if (limits.max_frame_bytes != 0 && buffer_.size() > limits.max_frame_bytes) {
+                // Stop buffering now rather than holding a multi-GB line
+                buffer_.clear();
+                discarding_ = true;
+                if (!sink(std::string_view(), FrameError::TooLarge)) {
+                    return false;
+                }
+            }
+            continue;
+        }
+
+        std::string_view line = piece;
+        if (!buffer_.empty()) {
+            buffer_.append(piece);
+            line = buffer_;
+        }
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        bool keep_going = line.empty() || sink(line, check_frame(line, limits));
+        buffer_.clear();
+        if (!keep_going) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace transport
+} // namespace mcpp
+
+#endif // MCPP_TRANSPORT_FRAME_LIMITS_H
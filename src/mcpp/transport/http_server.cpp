@@ -0,0 +1,1100 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mcpp/transport/http_server.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <future>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+#include <nlohmann/json.hpp>
+
+#include "mcpp/server/session_scope.h"
+#include "mcpp/util/secure_random.h"
+
+namespace mcpp {
+namespace transport {
+
+namespace {
+
+constexpr char SESSION_NOT_FOUND[] =
+    "{\"jsonrpc\":\"2.0\",\"error\":{\"code\":-32001,\"message\":\"Session not found\"},\"id\":null}\n";
+constexpr char MISSING_SESSION[] =
+    "{\"jsonrpc\":\"2.0\",\"error\":{\"code\":-32600,\"message\":\"Missing Mcp-Session-Id\"},\"id\":null}\n";
+constexpr char INTERNAL_ERROR[] =
+    "{\"jsonrpc\":\"2.0\",\"error\":{\"code\":-32603,\"message\":\"Internal error\"},\"id\":null}\n";
+constexpr char SERVER_DRAINING[] =
+    "{\"jsonrpc\":\"2.0\",\"error\":{\"code\":-32031,\"message\":\"Server draining\"},\"id\":null}\n";
+constexpr char TOO_MANY_SESSIONS[] =
+    "{\"jsonrpc\":\"2.0\",\"error\":{\"code\":-32000,\"message\":\"Too many sessions\"},\"id\":null}\n";
+
+/// Session IDs are 32 lowercase hex digits; the first four name the shard
+constexpr size_t SHARD_DIGITS = 4;
+constexpr size_t SESSION_HEADER_SIZE = sizeof("Mcp-Session-Id: \r\n") + util::Id128::HEX_LENGTH;
+/// Offset of the ID within the session header
+constexpr size_t SESSION_HEADER_PREFIX = sizeof("Mcp-Session-Id: ") - 1;
+
+constexpr size_t READ_CHUNK = 16 * 1024;
+
+/// Connection IDs carry the accepting shard in the top bits so they stay
+/// unique after a handoff
+constexpr int CONNECTION_SHARD_SHIFT = 48;
+
+/**
+ * @brief SAX handler that stops at the top-level "method" value
+ *
+ * Lets a sessionless POST be classified without building a DOM.
+ */
+class MethodPeek : public nlohmann::json_sax<nlohmann::json> {
+public:
+    std::string method;
+
+    bool null() override { return scalar(); }
+    bool boolean(bool) override { return scalar(); }
+    bool number_integer(number_integer_t) override { return scalar(); }
+    bool number_unsigned(number_unsigned_t) override { return scalar(); }
+    bool number_float(number_float_t, const string_t&) override { return scalar(); }
+    bool string(string_t& value) override {
+        if (depth_ == 1 && method_key_) {
+            method = std::move(value);
+            return false;  // found it; stop parsing
+        }
+        return scalar();
+    }
+    bool binary(binary_t&) override { return scalar(); }
+    bool start_object(std::size_t) override { return enter(); }
+    bool key(string_t& key) override {
+        method_key_ = depth_ == 1 && key == "method";
+        return true;
+    }
+    bool end_object() override { return leave(); }
+    bool start_array(std::size_t) override {
+        // Batches never carry initialize
+        return depth_ != 0 && enter();
+    }
+    bool end_array() override { return leave(); }
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception&) override {
+        return false;
+    }
+
+private:
+    bool scalar() {
+        method_key_ = false;
+        return true;
+    }
+    bool enter() {
+        method_key_ = false;
+        ++depth_;
+        return true;
+    }
+    bool leave() {
+        --depth_;
+        return true;
+    }
+
+    int depth_ = 0;
+    bool method_key_ = false;
+};
+
+/// @return true if @p body is a single JSON-RPC initialize request
+bool is_initialize(std::string_view body) {
+    MethodPeek peek;
+    nlohmann::json::sax_parse(body.begin(), body.end(), &peek);
+    return peek.method == "initialize";
+}
+
+/// "Mcp-Session-Id: <id>\r\n", formatted into @p buf (SESSION_HEADER_SIZE bytes)
+std::string_view session_header(const util::Id128& id, char* buf) {
+    constexpr std::string_view prefix = "Mcp-Session-Id: ";
+    char* p = std::copy(prefix.begin(), prefix.end(), buf);
+    p = id.write_hex(p);
+    *p++ = '\r';
+    *p++ = '\n';
+    return std::string_view(buf, static_cast<size_t>(p - buf));
+}
+
+std::string to_lower(std::string_view s) {
+    std::string out(s);
+    for (char& c : out) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return out;
+}
+
+std::string_view trim(std::string_view s) {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t')) s.remove_suffix(1);
+    return s;
+}
+
+const char* reason_phrase(int status) {
+    switch (status) {
+        case 200: return "OK";
+        case 202: return "Accepted";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 413: return "Payload Too Large";
+        case 431: return "Request Header Fields Too Large";
+        case 500: return "Internal Server Error";
+        case 501: return "Not Implemented";
+        case 503: return "Service Unavailable";
+        default: return "Unknown";
+    }
+}
+
+struct Request {
+    std::string method;
+    std::string path;
+    std::vector<std::pair<std::string, std::string>> headers;  ///< Names lowercased
+    std::string body;
+    bool keep_alive = true;
+
+    const std::string* header(std::string_view name) const {
+        for (const auto& [key, value] : headers) {
+            if (key == name) {
+                return &value;
+            }
+        }
+        return nullptr;
+    }
+};
+
+enum class ParseStatus { Incomplete, Complete, Bad, HeadTooLarge, BodyTooLarge, Unsupported };
+
+/// Parse one request from the front of @p buffer, consuming it on success
+ParseStatus parse_request(std::string& buffer, size_t max_head, size_t max_body, Request& out) {
+    size_t head_end = buffer.find("\r\n\r\n");
+    if (head_end == std::string::npos) {
+        return buffer.size() > max_head ? ParseStatus::HeadTooLarge : ParseStatus::Incomplete;
+    }
+    if (head_end > max_head) {
+        return ParseStatus::HeadTooLarge;
+    }
+    std::string_view head(buffer.data(), head_end);
+
+    size_t line_end = std::min(head.find("\r\n"), head.size());
+    std::string_view request_line = head.substr(0, line_end);
+    size_t sp1 = request_line.find(' ');
+    size_t sp2 = request_line.rfind(' ');
+    if (sp1 == std::string_view::npos || sp2 == sp1) {
+        return ParseStatus::Bad;
+    }
+    Request req;
+    req.method = std::string(request_line.substr(0, sp1));
+    std::string_view target = request_line.substr(sp1 + 1, sp2 - sp1 - 1);
+    std::string_view version = request_line.substr(sp2 + 1);
+    if (version != "HTTP/1.1" && version != "HTTP/1.0") {
+        return ParseStatus::Bad;
+    }
+    req.keep_alive = version == "HTTP/1.1";
+    req.path = std::string(target.substr(0, target.find('?')));
+
+    size_t content_length = 0;
+    size_t pos = line_end + 2;
+    while (pos < head.size()) {
+        size_t end = std::min(head.find("\r\n", pos), head.size());
+        std::string_view line = head.substr(pos, end - pos);
+        pos = end + 2;
+        size_t colon = line.find(':');
+        if (colon == std::string_view::npos || colon == 0) {
+            return ParseStatus::Bad;
+        }
+        std::string name = to_lower(trim(line.substr(0, colon)));
+        std::string_view value = trim(line.substr(colon + 1));
+        if (name == "content-length") {
+            auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), content_length);
+            if (ec != std::errc() || ptr != value.data() + value.size()) {
+                return ParseStatus::Bad;
+            }
+        } else if (name == "transfer-encoding") {
+            if (to_lower(value) != "identity") {
+                return ParseStatus::Unsupported;
+            }
+        } else if (name == "connection") {
+            std::string token = to_lower(value);
+            if (token == "close") {
+                req.keep_alive = false;
+            } else if (token == "keep-alive") {
+                req.keep_alive = true;
+            }
+        }
+        req.headers.emplace_back(std::move(name), std::string(value));
+    }
+
+    if (max_body != 0 && content_length > max_body) {
+        return ParseStatus::BodyTooLarge;
+    }
+    size_t total = head_end + 4 + content_length;
+    if (buffer.size() < total) {
+        return ParseStatus::Incomplete;
+    }
+    req.body.assign(buffer, head_end + 4, content_length);
+    buffer.erase(0, total);
+    out = std::move(req);
+    return ParseStatus::Complete;
+}
+
+/// True if a complete but body-less head asks for "Expect: 100-continue"
+bool expects_continue(const std::string& buffer) {
+    size_t head_end = buffer.find("\r\n\r\n");
+    if (head_end == std::string::npos) {
+        return false;
+    }
+    return to_lower(std::string_view(buffer.data(), head_end)).find("\r\nexpect: 100-continue") !=
+           std::string::npos;
+}
+
+std::string format_event(uint64_t id, std::string_view message) {
+    std::string event;
+    event.reserve(message.size() + 32);
+    event += "id: ";
+    event += std::to_string(id);
+    event += '\n';
+    // Each line of a multi-line payload needs its own data: field
+    size_t start = 0;
+    while (true) {
+        size_t nl = message.find('\n', start);
+        event += "data: ";
+        event.append(message.substr(start, nl == std::string_view::npos ? nl : nl - start));
+        event += '\n';
+        if (nl == std::string_view::npos) {
+            break;
+        }
+        start = nl + 1;
+    }
+    event += '\n';
+    return event;
+}
+
+struct Connection {
+    Connection(uint64_t conn_id, int conn_fd) : id(conn_id), fd(conn_fd) {}
+    ~Connection() {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+    Connection(const Connection&) = delete;
+    Connection& operator=(const Connection&) = delete;
+
+    uint64_t id;
+    int fd;
+    std::string in;
+    std::string out;
+    size_t out_offset = 0;
+    bool want_write = false;
+    bool close_after_write = false;
+    bool continue_sent = false;
+    util::Id128 stream_session;  ///< Set once the connection carries an SSE stream
+};
+
+int open_listener(const sockaddr_in& addr) {
+    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    int one = 1;
+    if (::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one)) != 0 ||
+        ::setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)) != 0 ||
+        ::bind(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        ::listen(fd, SOMAXCONN) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/// Take over an inherited listening socket (blocking accept would stall a shard)
+int adopt_listener(int fd, bool duplicate) {
+    if (duplicate) {
+        fd = ::fcntl(fd, F_DUPFD_CLOEXEC, 0);
+    } else if (fd >= 0) {
+        ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+    if (fd < 0) {
+        return -1;
+    }
+    int flags = ::fcntl(fd, F_GETFL);
+    if (flags < 0 || ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) != 0) {
+        if (duplicate) {
+            ::close(fd);
+        }
+        return -1;
+    }
+    return fd;
+}
+
+} // anonymous namespace
+
+struct HttpServer::Shard {
+    Shard(HttpServer& owner, size_t shard_index)
+        : server(owner)
+        , options(owner.options_)
+        , index(shard_index) {
+        async::Reactor::Options reactor_options;
+        reactor_options.backend = options.backend;
+        reactor = std::make_unique<async::Reactor>(reactor_options, options.clock);
+    }
+
+    ~Shard() {
+        // Connections and sessions go before the reactor they are registered with
+        sessions.clear();
+        connections.clear();
+        if (listen_fd >= 0) {
+            ::close(listen_fd);
+        }
+    }
+
+    void run();
+    void on_accept();
+    void on_io(uint64_t conn_id, uint32_t events);
+    void process(uint64_t conn_id);
+    void dispatch(uint64_t conn_id, Request req);
+    void handoff(uint64_t conn_id, size_t owner, Request req);
+    void adopt(std::unique_ptr<Connection> conn, Request req);
+    void handle_post(uint64_t conn_id, const Request& req, const util::Id128* session_id);
+    void handle_get(uint64_t conn_id, const Request& req, const util::Id128* session_id);
+    void handle_delete(uint64_t conn_id, const Request& req, const util::Id128* session_id);
+    void respond(uint64_t conn_id, int status, std::string_view content_type, std::string_view body,
+                 bool keep_alive, std::string_view extra_headers = {});
+    bool write(Connection& conn, std::string_view data);
+    bool flush(Connection& conn);
+    void close_connection(uint64_t conn_id);
+    Connection* find(uint64_t conn_id);
+
+    Session& create_session();
+    void remove_session(const util::Id128& id);
+    void publish(Session& session, std::string_view message);
+    void sweep();
+
+    HttpServer& server;
+    const Options& options;
+    size_t index;
+    std::unique_ptr<async::Reactor> reactor;
+    std::thread thread;
+    int listen_fd = -1;
+    Handler handler;
+    std::unordered_map<util::Id128, std::unique_ptr<Session>, util::Id128Hash> sessions;
+    std::unordered_map<uint64_t, std::unique_ptr<Connection>> connections;
+    uint64_t next_connection = 1;
+    std::atomic<size_t> session_count{0};
+    std::atomic<uint64_t> handoffs{0};
+};
+
+// ============================================================================
+// Session
+// ============================================================================
+
+void HttpServer::Session::send(std::string_view message) {
+    owner_.publish(*this, message);
+}
+
+// ============================================================================
+// Shard
+// ============================================================================
+
+void HttpServer::Shard::run() {
+    if (options.pin_threads) {
+        unsigned cpus = std::max(1u, std::thread::hardware_concurrency());
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(index % cpus, &set);
+        ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+    }
+    if (server.factory_) {
+        handler = server.factory_(index);
+    }
+    reactor->add(listen_fd, async::Reactor::Readable, [this](uint32_t) { on_accept(); });
+    reactor->call_every(options.sweep_interval, [this] { sweep(); });
+    reactor->run();
+}
+
+void HttpServer::Shard::on_accept() {
+    while (true) {
+        int fd = ::accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            return;  // EAGAIN, or out of descriptors until something closes
+        }
+        int one = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        uint64_t id = (static_cast<uint64_t>(index) << CONNECTION_SHARD_SHIFT) | next_connection++;
+        connections.emplace(id, std::make_unique<Connection>(id, fd));
+        if (!reactor->add(fd, async::Reactor::Readable, [this, id](uint32_t events) {
+                on_io(id, events);
+            })) {
+            connections.erase(id);
+        }
+    }
+}
+
+Connection* HttpServer::Shard::find(uint64_t conn_id) {
+    auto it = connections.find(conn_id);
+    return it == connections.end() ? nullptr : it->second.get();
+}
+
+void HttpServer::Shard::close_connection(uint64_t conn_id) {
+    auto it = connections.find(conn_id);
+    if (it == connections.end()) {
+        return;
+    }
+    Connection& conn = *it->second;
+    if (!conn.stream_session.is_nil()) {
+        auto session = sessions.find(conn.stream_session);
+        if (session != sessions.end() && session->second->stream_ == conn_id) {
+            session->second->stream_ = 0;
+        }
+    }
+    reactor->remove(conn.fd);
+    connections.erase(it);  // closes the descriptor
+}
+
+void HttpServer::Shard::on_io(uint64_t conn_id, uint32_t events) {
+    Connection* conn = find(conn_id);
+    if (conn == nullptr) {
+        return;
+    }
+    if ((events & async::Reactor::Writable) && !flush(*conn)) {
+        return;
+    }
+    if (!(events & (async::Reactor::Readable | async::Reactor::Closed))) {
+        return;
+    }
+    while (true) {
+        size_t old_size = conn->in.size();
+        conn->in.resize(old_size + READ_CHUNK);
+        ssize_t n = ::read(conn->fd, conn->in.data() + old_size, READ_CHUNK);
+        if (n > 0) {
+            conn->in.resize(old_size + static_cast<size_t>(n));
+            if (static_cast<size_t>(n) < READ_CHUNK) {
+                break;
+            }
+            continue;
+        }
+        conn->in.resize(old_size);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        }
+        close_connection(conn_id);  // EOF or error
+        return;
+    }
+    if (!conn->stream_session.is_nil()) {
+        conn->in.clear();  // nothing meaningful arrives on an SSE stream
+        return;
+    }
+    process(conn_id);
+}
+
+void HttpServer::Shard::process(uint64_t conn_id) {
+    while (true) {
+        // Re-resolve each time: the previous request may have closed the
+        // connection or handed it to another shard
+        Connection* conn = find(conn_id);
+        if (conn == nullptr || !conn->stream_session.is_nil() || conn->close_after_write) {
+            return;
+        }
+        Request req;
+        size_t max_body = options.limits.max_frame_bytes;
+        switch (parse_request(conn->in, options.max_header_bytes, max_body, req)) {
+            case ParseStatus::Incomplete:
+                if (!conn->continue_sent && expects_continue(conn->in)) {
+                    conn->continue_sent = true;
+                    write(*conn, "HTTP/1.1 100 Continue\r\n\r\n");
+                }
+                return;
+            case ParseStatus::Bad:
+                respond(conn_id, 400, "text/plain", "Bad Request\n", false);
+                return;
+            case ParseStatus::HeadTooLarge:
+                respond(conn_id, 431, "text/plain", "Request Header Fields Too Large\n", false);
+                return;
+            case ParseStatus::BodyTooLarge:
+                respond(conn_id, 413, "application/json",
+                        make_frame_error_response(FrameError::TooLarge) + "\n", false);
+                return;
+            case ParseStatus::Unsupported:
+                respond(conn_id, 501, "text/plain", "Transfer-Encoding not supported\n", false);
+                return;
+            case ParseStatus::Complete:
+                conn->continue_sent = false;
+                dispatch(conn_id, std::move(req));
+                break;
+        }
+    }
+}
+
+void HttpServer::Shard::dispatch(uint64_t conn_id, Request req) {
+    if (req.path != options.path) {
+        respond(conn_id, 404, "text/plain", "Not Found\n", req.keep_alive);
+        return;
+    }
+    std::optional<util::Id128> parsed;
+    const std::string* header = req.header("mcp-session-id");
+    if (header != nullptr && !header->empty()) {
+        auto owner = shard_of(*header);
+        if (!owner || *owner >= server.shard_count_) {
+            respond(conn_id, 404, "application/json", SESSION_NOT_FOUND, req.keep_alive);
+            return;
+        }
+        if (*owner != index) {
+            handoff(conn_id, *owner, std::move(req));
+            return;
+        }
+        parsed = util::Id128::parse(*header);
+    }
+    const util::Id128* session_id = parsed ? &*parsed : nullptr;
+
+    if (req.method == "POST") {
+        handle_post(conn_id, req, session_id);
+    } else if (req.method == "GET") {
+        handle_get(conn_id, req, session_id);
+    } else if (req.method == "DELETE") {
+        handle_delete(conn_id, req, session_id);
+    } else {
+        respond(conn_id, 405, "text/plain", "Method Not Allowed\n", req.keep_alive,
+                "Allow: GET, POST, DELETE\r\n");
+    }
+}
+
+void HttpServer::Shard::handoff(uint64_t conn_id, size_t owner, Request req) {
+    auto it = connections.find(conn_id);
+    if (it == connections.end()) {
+        return;
+    }
+    std::unique_ptr<Connection> conn = std::move(it->second);
+    connections.erase(it);
+    reactor->remove(conn->fd);
+    handoffs.fetch_add(1, std::memory_order_relaxed);
+
+    // std::function needs a copyable callable, so box the move-only state
+    auto moved = std::make_shared<std::pair<std::unique_ptr<Connection>, Request>>(
+        std::move(conn), std::move(req));
+    Shard& target = *server.shards_[owner];
+    target.reactor->post([&target, moved] {
+        target.adopt(std::move(moved->first), std::move(moved->second));
+    });
+}
+
+void HttpServer::Shard::adopt(std::unique_ptr<Connection> conn, Request req) {
+    uint64_t conn_id = conn->id;
+    int fd = conn->fd;
+    uint32_t interest = async::Reactor::Readable;
+    if (conn->want_write) {
+        interest |= async::Reactor::Writable;
+    }
+    connections.emplace(conn_id, std::move(conn));
+    if (!reactor->add(fd, interest, [this, conn_id](uint32_t events) { on_io(conn_id, events); })) {
+        connections.erase(conn_id);
+        return;
+    }
+    dispatch(conn_id, std::move(req));
+    // Pipelined requests that arrived with it
+    process(conn_id);
+}
+
+void HttpServer::Shard::handle_post(uint64_t conn_id, const Request& req,
+                                    const util::Id128* session_id) {
+    FrameError frame_error = check_frame(req.body, options.limits);
+    if (frame_error != FrameError::None) {
+        respond(conn_id, frame_error == FrameError::TooLarge ? 413 : 400, "application/json",
+                make_frame_error_response(frame_error) + "\n", req.keep_alive);
+        return;
+    }
+
+    Session* session = nullptr;
+    if (session_id == nullptr) {
+        // Only initialize opens a session, so stray or hostile sessionless
+        // POSTs cannot grow the session tables
+        if (!is_initialize(req.body)) {
+            respond(conn_id, 400, "application/json", MISSING_SESSION, req.keep_alive);
+            return;
+        }
+        if (server.draining_) {
+            // New sessions belong on the replacement server
+            respond(conn_id, 503, "application/json", SERVER_DRAINING, false, "Retry-After: 1\r\n");
+            return;
+        }
+        if (options.max_sessions != 0 && server.session_count() >= options.max_sessions) {
+            respond(conn_id, 503, "application/json", TOO_MANY_SESSIONS, req.keep_alive,
+                    "Retry-After: 1\r\n");
+            return;
+        }
+        session = &create_session();
+    } else {
+        auto it = sessions.find(*session_id);
+        if (it == sessions.end()) {
+            respond(conn_id, 404, "application/json", SESSION_NOT_FOUND, req.keep_alive);
+            return;
+        }
+        session = it->second.get();
+    }
+    session->last_activity_ = reactor->clock()->steady_now();
+
+    char header_buf[SESSION_HEADER_SIZE];
+    std::string_view header = session_header(session->id_, header_buf);
+    std::optional<std::string> result;
+    try {
+        if (handler) {
+            // The hex ID inside the header outlives the scope
+            server::SessionScope scope(header.substr(SESSION_HEADER_PREFIX, util::Id128::HEX_LENGTH));
+            result = handler(*session, req.body);
+        }
+    } catch (const std::exception&) {
+        respond(conn_id, 500, "application/json", INTERNAL_ERROR, req.keep_alive, header);
+        return;
+    }
+    if (result) {
+        respond(conn_id, 200, "application/json", *result, req.keep_alive, header);
+    } else {
+        respond(conn_id, 202, {}, {}, req.keep_alive, header);
+    }
+}
+
+void HttpServer::Shard::handle_get(uint64_t conn_id, const Request& req,
+                                   const util::Id128* session_id) {
+    if (session_id == nullptr) {
+        respond(conn_id, 400, "application/json", MISSING_SESSION, req.keep_alive);
+        return;
+    }
+    auto it = sessions.find(*session_id);
+    if (it == sessions.end()) {
+        respond(conn_id, 404, "application/json", SESSION_NOT_FOUND, req.keep_alive);
+        return;
+    }
+    Session& session = *it->second;
+    if (session.stream_ != 0 && session.stream_ != conn_id) {
+        close_connection(session.stream_);  // a new stream replaces the old one
+    }
+    Connection* conn = find(conn_id);
+    if (conn == nullptr) {
+        return;
+    }
+    conn->stream_session = session.id_;
+    session.stream_ = conn_id;
+    session.last_activity_ = reactor->clock()->steady_now();
+
+    char header_buf[SESSION_HEADER_SIZE];
+    std::string out = "HTTP/1.1 200 OK\r\n"
+                      "Content-Type: text/event-stream\r\n"
+                      "Cache-Control: no-cache\r\n"
+                      "Connection: keep-alive\r\n";
+    out += session_header(session.id_, header_buf);
+    out += "\r\n";
+
+    // Resume after Last-Event-ID, or deliver what no stream has seen yet
+    uint64_t after = session.delivered_;
+    if (const std::string* last = req.header("last-event-id")) {
+        uint64_t parsed = 0;
+        auto [ptr, ec] = std::from_chars(last->data(), last->data() + last->size(), parsed);
+        if (ec == std::errc()) {
+            after = parsed;
+        }
+    }
+    size_t count = session.history_.size();
+    for (size_t i = 0; i < count; ++i) {
+        const auto& [event_id, event] = session.history_[(session.history_head_ + i) % count];
+        if (event_id > after) {
+            out += event;
+        }
+    }
+    session.delivered_ = session.next_event_id_ - 1;
+    write(*conn, out);
+}
+
+void HttpServer::Shard::handle_delete(uint64_t conn_id, const Request& req,
+                                      const util::Id128* session_id) {
+    if (session_id == nullptr) {
+        respond(conn_id, 400, "application/json", MISSING_SESSION, req.keep_alive);
+        return;
+    }
+    if (sessions.count(*session_id) == 0) {
+        respond(conn_id, 404, "application/json", SESSION_NOT_FOUND, req.keep_alive);
+        return;
+    }
+    remove_session(*session_id);
+    respond(conn_id, 200, {}, {}, req.keep_alive);
+}
+
+void HttpServer::Shard::respond(uint64_t conn_id, int status, std::string_view content_type,
+                                std::string_view body, bool keep_alive,
+                                std::string_view extra_headers) {
+    Connection* conn = find(conn_id);
+    if (conn == nullptr) {
+        return;
+    }
+    std::string out;
+    out.reserve(128 + extra_headers.size() + body.size());
+    out += "HTTP/1.1 ";
+    out += std::to_string(status);
+    out += ' ';
+    out += reason_phrase(status);
+    out += "\r\n";
+    if (!content_type.empty()) {
+        out += "Content-Type: ";
+        out += content_type;
+        out += "\r\n";
+    }
+    out += "Content-Length: ";
+    out += std::to_string(body.size());
+    out += "\r\n";
+    out += extra_headers;
+    if (!keep_alive || server.draining_) {
+        out += "Connection: close\r\n";
+        conn->close_after_write = true;
+    }
+    out += "\r\n";
+    out += body;
+    write(*conn, out);
+}
+
+bool HttpServer::Shard::write(Connection& conn, std::string_view data) {
+    if (conn.out_offset == conn.out.size()) {
+        conn.out.clear();
+        conn.out_offset = 0;
+    }
+    conn.out.append(data);
+    if (conn.want_write) {
+        return true;  // waiting for writability; keep ordering
+    }
+    return flush(conn);
+}
+
+bool HttpServer::Shard::flush(Connection& conn) {
+    while (conn.out_offset < conn.out.size()) {
+        ssize_t n = ::send(conn.fd, conn.out.data() + conn.out_offset,
+                           conn.out.size() - conn.out_offset, MSG_NOSIGNAL);
+        if (n > 0) {
+            conn.out_offset += static_cast<size_t>(n);
+            continue;
+        }
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            if (!conn.want_write) {
+                conn.want_write = true;
+                reactor->modify(conn.fd, async::Reactor::Readable | async::Reactor::Writable);
+            }
+            return true;
+        }
+        close_connection(conn.id);
+        return false;
+    }
+    conn.out.clear();
+    conn.out_offset = 0;
+    if (conn.want_write) {
+        conn.want_write = false;
+        reactor->modify(conn.fd, async::Reactor::Readable);
+    }
+    if (conn.close_after_write) {
+        close_connection(conn.id);
+        return false;
+    }
+    return true;
+}
+
+HttpServer::Session& HttpServer::Shard::create_session() {
+    // The top SHARD_DIGITS hex digits name the owning shard
+    util::Id128 id;
+    do {
+        id = util::SecureRandom::next_id128();
+        id.hi = (static_cast<uint64_t>(index) << 48) | (id.hi & 0xffffffffffffULL);
+    } while (id.is_nil() || sessions.count(id) != 0);
+
+    auto session = std::unique_ptr<Session>(new Session(*this, id, index));
+    Session& ref = *session;
+    sessions.emplace(id, std::move(session));
+    session_count.fetch_add(1, std::memory_order_relaxed);
+    return ref;
+}
+
+void HttpServer::Shard::remove_session(const util::Id128& id) {
+    auto it = sessions.find(id);
+    if (it == sessions.end()) {
+        return;
+    }
+    uint64_t stream = it->second->stream_;
+    if (options.on_session_closed) {
+        options.on_session_closed(*it->second);
+    }
+    sessions.erase(it);
+    session_count.fetch_sub(1, std::memory_order_relaxed);
+    if (stream != 0) {
+        close_connection(stream);
+    }
+}
+
+void HttpServer::Shard::publish(Session& session, std::string_view message) {
+    uint64_t event_id = session.next_event_id_++;
+    std::string event = format_event(event_id, message);
+    if (session.stream_ != 0) {
+        if (Connection* conn = find(session.stream_)) {
+            session.delivered_ = event_id;
+            session.last_activity_ = reactor->clock()->steady_now();
+            write(*conn, event);
+        }
+    }
+    if (options.event_history > 0) {
+        if (session.history_.size() < options.event_history) {
+            session.history_.emplace_back(event_id, std::move(event));
+        } else {
+            session.history_[session.history_head_] = {event_id, std::move(event)};
+            session.history_head_ =
+                static_cast<uint32_t>((session.history_head_ + 1) % session.history_.size());
+        }
+    }
+}
+
+void HttpServer::Shard::sweep() {
+    auto now = reactor->clock()->steady_now();
+    std::vector<util::Id128> expired;
+    for (const auto& [id, session] : sessions) {
+        if (session->stream_ == 0 && now - session->last_activity_ > options.session_timeout) {
+            expired.push_back(id);
+        }
+    }
+    for (const auto& id : expired) {
+        remove_session(id);
+    }
+}
+
+// ============================================================================
+// HttpServer
+// ============================================================================
+
+HttpServer::HttpServer(Options options, HandlerFactory factory)
+    : options_(std::move(options))
+    , factory_(std::move(factory))
+    , shard_count_(options_.shards != 0 ? options_.shards
+                                        : std::max(1u, std::thread::hardware_concurrency())) {
+    if (!options_.clock) {
+        options_.clock = util::Clock::default_clock();
+    }
+}
+
+HttpServer::HttpServer(Options options, Handler handler)
+    : HttpServer(std::move(options), HandlerFactory([handler = std::move(handler)](size_t) {
+          return handler;
+      })) {}
+
+HttpServer::~HttpServer() {
+    stop();
+}
+
+bool HttpServer::start() {
+    if (running_) {
+        return true;
+    }
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(options_.port);
+    if (::inet_pton(AF_INET, options_.host.c_str(), &addr.sin_addr) != 1) {
+        return false;
+    }
+
+    const std::vector<int>& inherited = options_.listen_fds;
+    for (size_t i = 0; i < shard_count_; ++i) {
+        auto shard = std::make_unique<Shard>(*this, i);
+        shard->listen_fd = inherited.empty()
+            ? open_listener(addr)
+            : adopt_listener(inherited[i % inherited.size()], i >= inherited.size());
+        if (shard->listen_fd < 0 || !shard->reactor->valid()) {
+            shards_.clear();
+            return false;
+        }
+        if (i == 0) {
+            // With port 0 the first listener picks the port the rest share
+            sockaddr_in bound{};
+            socklen_t len = sizeof(bound);
+            ::getsockname(shard->listen_fd, reinterpret_cast<sockaddr*>(&bound), &len);
+            addr.sin_port = bound.sin_port;
+            port_ = ntohs(bound.sin_port);
+        }
+        shards_.push_back(std::move(shard));
+    }
+
+    for (auto& shard : shards_) {
+        Shard* raw = shard.get();
+        shard->thread = std::thread([raw] { raw->run(); });
+    }
+    draining_ = false;
+    running_ = true;
+    return true;
+}
+
+void HttpServer::stop() {
+    if (!running_) {
+        return;
+    }
+    for (auto& shard : shards_) {
+        shard->reactor->stop();
+    }
+    for (auto& shard : shards_) {
+        if (shard->thread.joinable()) {
+            shard->thread.join();
+        }
+    }
+    shards_.clear();
+    running_ = false;
+}
+
+std::vector<int> HttpServer::release_listeners() {
+    std::vector<int> fds;
+    if (!running_) {
+        return fds;
+    }
+    for (auto& shard : shards_) {
+        Shard* raw = shard.get();
+        std::promise<int> released;
+        std::future<int> fd = released.get_future();
+        raw->reactor->post([raw, &released] {
+            int listen_fd = raw->listen_fd;
+            if (listen_fd >= 0) {
+                raw->reactor->remove(listen_fd);
+                raw->listen_fd = -1;
+            }
+            released.set_value(listen_fd);
+        });
+        int listen_fd = fd.get();
+        if (listen_fd >= 0) {
+            ::fcntl(listen_fd, F_SETFD, 0);
+            fds.push_back(listen_fd);
+        }
+    }
+    return fds;
+}
+
+bool HttpServer::drain(std::chrono::milliseconds timeout) {
+    if (!running_) {
+        return true;
+    }
+    draining_ = true;
+    for (auto& shard : shards_) {
+        Shard* raw = shard.get();
+        raw->reactor->post([raw] {
+            if (raw->listen_fd >= 0) {
+                raw->reactor->remove(raw->listen_fd);
+                ::close(raw->listen_fd);
+                raw->listen_fd = -1;
+            }
+        });
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    bool flushed = false;
+    while (true) {
+        size_t unsent = 0;
+        for (auto& shard : shards_) {
+            Shard* raw = shard.get();
+            std::promise<size_t> counted;
+            std::future<size_t> count = counted.get_future();
+            raw->reactor->post([raw, &counted] {
+                size_t n = 0;
+                for (const auto& [id, conn] : raw->connections) {
+                    if (conn->out_offset < conn->out.size()) {
+                        ++n;
+                    }
+                }
+                counted.set_value(n);
+            });
+            unsent += count.get();
+        }
+        if (unsent == 0) {
+            flushed = true;
+            break;
+        }
+        if (std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    stop();
+    return flushed;
+}
+
+size_t HttpServer::session_count() const {
+    size_t total = 0;
+    for (const auto& shard : shards_) {
+        total += shard->session_count.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+uint64_t HttpServer::handoff_count() const {
+    uint64_t total = 0;
+    for (const auto& shard : shards_) {
+        total += shard->handoffs.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+bool HttpServer::send(const std::string& session_id, std::string message) {
+    auto owner = shard_of(session_id);
+    if (!running_ || !owner || *owner >= shards_.size()) {
+        return false;
+    }
+    Shard& shard = *shards_[*owner];
+    shard.reactor->post([&shard, id = *util::Id128::parse(session_id),
+                         message = std::move(message)] {
+        auto it = shard.sessions.find(id);
+        if (it != shard.sessions.end()) {
+            shard.publish(*it->second, message);
+        }
+    });
+    return true;
+}
+
+std::optional<size_t> HttpServer::shard_of(std::string_view session_id) {
+    if (session_id.size() != util::Id128::HEX_LENGTH) {
+        return std::nullopt;
+    }
+    auto id = util::Id128::parse(session_id);
+    if (!id) {
+        return std::nullopt;
+    }
+    return static_cast<size_t>(id->hi >> (64 - 4 * SHARD_DIGITS));
+}
+
+} // namespace transport
+} // namespace mcpp
@@ -0,0 +1,306 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef MCPP_TRANSPORT_HTTP_SERVER_H
+#define MCPP_TRANSPORT_HTTP_SERVER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "mcpp/async/reactor.h"
+#include "mcpp/transport/frame_limits.h"
+#include "mcpp/util/clock.h"
+#include "mcpp/util/id128.h"
+
+namespace mcpp {
+namespace transport {
+
+/**
+ * @brief Built-in Streamable HTTP server sharded across reactor threads
+ *
+ * HttpServer serves the MCP Streamable HTTP endpoint (POST for client
+ * messages, GET for the SSE stream, DELETE to end a session) without an
+ * external HTTP library. It runs one shard per thread; each shard owns an
+ * async::Reactor, its own SO_REUSEPORT listening socket on the shared
+ * port, its slice of the session table, and the timers that expire idle
+ * sessions. The kernel spreads new connections over the listeners, so
+ * accepts never contend on a shared socket or lock.
+ *
+ * Session IDs encode the shard that created them (the first four hex
+ * digits). A request for a session owned by another shard hands its whole
+ * connection (descriptor, buffered input, parsed request) to the owner
+ * through that shard's post() queue, so session state is only ever
+ * touched by its owning thread. Subsequent keep-alive requests on that
+ * connection are then served locally.
+ *
+ * For lock-free operation give each shard its own McpServer through the
+ * HandlerFactory constructor; a single Handler shared by all shards must
+ * be thread-safe. Handlers run inside a server::SessionScope naming their
+ * session, so rate limits and tenants apply per session; pass
+ * McpServer::end_session() as Options::on_session_closed to release them.
+ *
+ * Example:
+ * @code
+ *   std::vector<std::unique_ptr<server::McpServer>> servers(n);
+ *   HttpServer http(options, [&](size_t shard) {
+ *       servers[shard] = make_server();
+ *       return [&, shard](HttpServer::Session&, std::string_view body) {
+ *           return servers[shard]->handle_raw_message(body);
+ *       };
+ *   });
+ *   http.start();
+ * @endcode
+ *
+ * Limitations: HTTP/1.1 with Content-Length bodies only (no chunked
+ * uploads, no TLS; terminate TLS in a proxy), IPv4 listeners.
+ *
+ * Thread safety: start(), stop() and the accessors may be called from any
+ * thread. Handlers and Session methods run on the owning shard's thread.
+ * send() is safe from any thread.
+ */
+class HttpServer {
+    struct Shard;
+
+public:
+    class Session;
+
+    /// Server configuration
+    struct Options {
+        /// IPv4 address to bind
+        std::string host = "127.0.0.1";
+        /// Port to bind; 0 picks an ephemeral port (see port())
+        uint16_t port = 0;
+        /// Reactor threads; 0 uses std::thread::hardware_concurrency()
+        size_t shards = 0;
+        /// Pin shard i to CPU i (modulo the CPU count)
+        bool pin_threads = false;
+        /// Endpoint path; other paths get 404
+        std::string path = "/mcp";
+        /// Sessions idle (no request, no open stream) this long are dropped
+        std::chrono::milliseconds session_timeout{std::chrono::minutes(30)};
+        /// Live sessions across all shards; an initialize beyond it gets
+        /// 503 (0 = unlimited)
+        size_t max_sessions = 10000;
+        /// How often each shard looks for idle sessions
+        std::chrono::milliseconds sweep_interval{std::chrono::seconds(1)};
+        /// SSE events kept per session for Last-Event-ID resumption
+        size_t event_history = 256;
+        /// Largest accepted request head (request line plus headers)
+        size_t max_header_bytes = 64 * 1024;
+        /// Pre-parse limits for POST bodies (max_frame_bytes caps Content-Length)
+        FrameLimits limits;
+        /// Called on the owning shard's thread when a session is deleted
+        /// or expires, before it is destroyed (not when the server stops)
+        std::function<void(Session&)> on_session_closed;
+        /// Reactor backend for the shard threads
+        async::Reactor::Backend backend = async::Reactor::Backend::Epoll;
+        /// Time source for session expiry
+        std::shared_ptr<util::Clock> clock;
+        /// Already-listening sockets to serve instead of binding host:port,
+        /// e.g. inherited from the process being replaced (see
+        /// release_listeners()). Shard i takes listen_fds[i % size]; the
+        /// server owns them from start() on.
+        std::vector<int> listen_fds;
+    };
+
+    /**
+     * @brief Server-side state of one MCP session
+     *
+     * Lives on, and may only be used from, its owning shard's thread.
+     */
+    class Session {
+    public:
+        /// @return Session ID as sent in Mcp-Session-Id
+        std::string id() const { return id_.to_hex(); }
+
+        /// @return Index of the owning shard
+        size_t shard() const { return shard_; }
+
+        /**
+         * @brief Queue a server-to-client message on the SSE stream
+         *
+         * Delivered immediately if a GET stream is open, otherwise kept
+         * (up to Options::event_history events) and sent when the client
+         * opens or resumes one.
+         */
+        void send(std::string_view message);
+
+        /// Slot for handler-defined per-session state (released with the session)
+        std::shared_ptr<void> state;
+
+    private:
+        friend struct Shard;
+        Session(Shard& owner, util::Id128 id, size_t shard)
+            : owner_(owner), id_(id), shard_(static_cast<uint32_t>(shard)) {}
+
+        // Kept small: an idle session is this object plus its map node
+        Shard& owner_;
+        util::Id128 id_;           ///< Formatted only when written to a response
+        uint32_t shard_;
+        uint32_t history_head_ = 0;  ///< Oldest entry once history_ is full
+        std::chrono::steady_clock::time_point last_activity_{};
+        uint64_t next_event_id_ = 1;
+        uint64_t delivered_ = 0;  ///< Last event ID written to a stream
+        uint64_t stream_ = 0;     ///< Connection carrying the GET stream, 0 if none
+        /// Formatted SSE events; grows to Options::event_history entries,
+        /// then wraps at history_head_ (empty until the first publish)
+        std::vector<std::pair<uint64_t, std::string>> history_;
+    };
+
+    /**
+     * @brief Handles one POST body for a session
+     *
+     * @return Response body (sent as application/json), or std::nullopt
+     *         for notifications and responses (answered with 202)
+     */
+    using Handler = std::function<std::optional<std::string>(Session& session, std::string_view body)>;
+
+    /// Creates the handler for one shard; called on that shard's thread before it serves
+    using HandlerFactory = std::function<Handler(size_t shard)>;
+
+    /**
+     * @brief Create a server whose shards each get their own handler
+     */
+    HttpServer(Options options, HandlerFactory factory);
+
+    /**
+     * @brief Create a server sharing one (thread-safe) handler across shards
+     */
+    HttpServer(Options options, Handler handler);
+
+    /**
+     * @brief Stops the shards and closes every socket
+     */
+    ~HttpServer();
+
+    // Non-copyable, non-movable (shard threads reference this)
+    HttpServer(const HttpServer&) = delete;
+    HttpServer& operator=(const HttpServer&) = delete;
+    HttpServer(HttpServer&&) = delete;
+    HttpServer& operator=(HttpServer&&) = delete;
+
+    /**
+     * @brief Bind the listeners and start the shard threads
+     *
+     * @return false if a listener could not be created (port in use,
+     *         SO_REUSEPORT unavailable, bad host)
+     */
+    bool start();
+
+    /**
+     * @brief Stop the shard threads and close all connections
+     *
+     * Sessions are discarded. Idempotent.
+     */
+    void stop();
+
+    /**
+     * @brief Stop accepting and hand the listening sockets to the caller
+     *
+     * For zero-downtime restarts: pass the descriptors to the replacement
+     * process (their close-on-exec flag is cleared, so a fork()/exec()
+     * child inherits them) and give them to it as Options::listen_fds.
+     * Connections already accepted keep being served here; new ones queue
+     * on the sockets for the new process. The caller owns the returned
+     * descriptors.
+     *
+     * Must not be called from a handler.
+     *
+     * @return One listening descriptor per shard (empty if not running)
+     */
+    std::vector<int> release_listeners();
+
+    /**
+     * @brief Stop gracefully: finish what is in progress, then stop()
+     *
+     * Closes the listeners (unless released), answers requests that would
+     * create a session with 503 and Retry-After, and closes each
+     * connection after its next response. Returns once no connection has
+     * unsent output (or at @p timeout), then calls stop(). Drain the
+     * McpServers behind the handlers first so their in-flight requests
+     * are answered.
+     *
+     * Must not be called from a handler.
+     *
+     * @param timeout Longest time to wait for output to flush
+     * @return true if everything was flushed before the deadline
+     */
+    bool drain(std::chrono::milliseconds timeout);
+
+    /// @return true once drain() has been called
+    bool is_draining() const { return draining_; }
+
+    /// @return true between a successful start() and stop()
+    bool is_running() const { return running_; }
+
+    /// @return Bound port (useful with Options::port = 0)
+    uint16_t port() const { return port_; }
+
+    /// @return Number of shards (valid after construction)
+    size_t shard_count() const { return shard_count_; }
+
+    /// @return Live sessions across all shards (approximate while running)
+    size_t session_count() const;
+
+    /// @return Connections moved between shards so far
+    uint64_t handoff_count() const;
+
+    /**
+     * @brief Push a message to a session's SSE stream from any thread
+     *
+     * @return false if the ID does not name a shard of this server; an
+     *         unknown session on a valid shard drops the message silently
+     */
+    bool send(const std::string& session_id, std::string message);
+
+    /**
+     * @brief Shard that owns a session ID
+     *
+     * @return Shard index, or std::nullopt if @p session_id is not in the
+     *         format this server generates
+     */
+    static std::optional<size_t> shard_of(std::string_view session_id);
+
+private:
+    Options options_;
+    HandlerFactory factory_;
+    size_t shard_count_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+    uint16_t port_ = 0;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> draining_{false};
+};
+
+} // namespace transport
+} // namespace mcpp
+
+#endif // MCPP_TRANSPORT_HTTP_SERVER_H
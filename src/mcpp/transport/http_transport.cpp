@@ -25,24 +25,20 @@
 #include "mcpp/transport/http_transport.h"
 
 #include <chrono>
-#include <iomanip>
-#include <random>
-#include <sstream>
 #include <thread>
 
+#include "mcpp/util/secure_random.h"
+
 namespace mcpp {
 namespace transport {
 
-namespace {
-    // Cryptographically secure random number generator
-    std::random_device& get_random_device() {
-        static std::random_device rd;
-        return rd;
-    }
+HttpTransport::HttpTransport()
+    : HttpTransport(util::Clock::default_clock()) {
+}
 
-    // Hex character set for UUID generation
-    constexpr char hex_chars[] = "0123456789abcdef";
-} // anonymous namespace
+HttpTransport::HttpTransport(std::shared_ptr<util::Clock> clock)
+    : clock_(clock ? std::move(clock) : util::Clock::system()) {
+}
 
 HttpTransport::~HttpTransport() {
     disconnect();
@@ -66,7 +62,8 @@ void HttpTransport::disconnect() {
 }
 
 bool HttpTransport::is_connected() const {
-    return !current_session_id_.empty() && sessions_.find(current_session_id_) != sessions_.end();
+    auto id = util::Id128::parse(current_session_id_);
+    return id && sessions_.count(*id) != 0;
 }
 
 bool HttpTransport::send(std::string_view message) {
@@ -78,8 +75,8 @@ bool HttpTransport::send(std::string_view message) {
     }
 
     // Find session and buffer the message (non-blocking)
-    auto it = sessions_.find(current_session_id_);
-    if (it == sessions_.end()) {
+    SessionData* session = find_session(current_session_id_);
+    if (session == nullptr) {
         if (error_callback_) {
             error_callback_("Cannot send: session not found");
         }
@@ -87,7 +84,7 @@ bool HttpTransport::send(std::string_view message) {
     }
 
     // Buffer message for SSE delivery (non-blocking)
-    it->second.pending_messages.push_back(std::string(message));
+    session->pending_messages.push_back(std::string(message));
     ++last_event_id_;
 
     return true;
@@ -109,8 +106,8 @@ void HttpTransport::send_notification(const nlohmann::json& notification) {
         return;
     }
 
-    auto it = sessions_.find(current_session_id_);
-    if (it == sessions_.end()) {
+    SessionData* session = find_session(current_session_id_);
+    if (session == nullptr) {
         if (error_callback_) {
             error_callback_("Cannot send notification: session not found");
         }
@@ -120,55 +117,42 @@ void HttpTransport::send_notification(const nlohmann::json& notification) {
     // Format as SSE event and buffer
     std::string event_id = std::to_string(last_event_id_);
     std::string sse_data = util::SseFormatter::format_event(notification, event_id);
-    it->second.pending_messages.push_back(sse_data);
+    session->pending_messages.push_back(sse_data);
     ++last_event_id_;
 }
 
 std::string HttpTransport::create_session() {
     // Generate UUID v4 using cryptographically secure random
     // Format: 8-4-4-4-12 hex digits (32 total)
-    std::ostringstream oss;
-    std::mt19937_64 generator(get_random_device()());
-    std::uniform_int_distribution<uint64_t> distribution;
-
-    // Generate 128 random bits
-    uint64_t r1 = distribution(generator);
-    uint64_t r2 = distribution(generator);
-
-    // Format as UUID v4 (version 4 = random, variant 1 = RFC 4122)
-    // xxxxxxxx-xxxx-4xxx-yxxx-xxxxxxxxxxxx where y in {8,9,A,B}
-    oss << std::hex << std::setfill('0');
-    oss << std::setw(8) << (r1 >> 32) << "-";
-    oss << std::setw(4) << ((r1 >> 16) & 0xFFFF) << "-";
-    oss << "4" << std::setw(3) << ((r1 >> 8) & 0xFFF) << "-";  // Version 4
-    uint64_t y = (r1 & 0xF);
-    y = (y & 0x3) | 0x8;  // Variant 1: 10xx
-    oss << y << std::setw(3) << ((r2 >> 48) & 0xFFF) << "-";
-    oss << std::setw(12) << (r2 & 0xFFFFFFFFFFFFULL);
-
-    std::string session_id = oss.str();
+    // 128 random bits with version 4 / variant 1 (RFC 4122) stamped on;
+    // the ID stays binary in sessions_ and is formatted once here
+    util::Id128 id;
+    do {
+        id = util::SecureRandom::next_id128().as_uuid_v4();
+    } while (sessions_.count(id) != 0);
 
     // Store session data
     SessionData data;
-    data.session_id = session_id;
-    data.last_activity = std::chrono::steady_clock::now();
+    data.session_id = id;
+    data.last_activity = clock_->steady_now();
     data.last_event_id = 0;
-    sessions_[session_id] = std::move(data);
+    sessions_[id] = std::move(data);
 
-    return session_id;
+    return id.to_uuid();
 }
 
 bool HttpTransport::validate_session(const std::string& session_id) {
     // Clean up expired sessions first
     cleanup_expired_sessions();
 
-    auto it = sessions_.find(session_id);
+    auto id = util::Id128::parse(session_id);
+    auto it = id ? sessions_.find(*id) : sessions_.end();
     if (it == sessions_.end()) {
         return false;
     }
 
     // Check session timeout
-    auto now = std::chrono::steady_clock::now();
+    auto now = clock_->steady_now();
     auto inactive_duration = std::chrono::duration_cast<std::chrono::minutes>(
         now - it->second.last_activity
     );
@@ -184,17 +168,12 @@ bool HttpTransport::validate_session(const std::string& session_id) {
 }
 
 bool HttpTransport::terminate_session(const std::string& session_id) {
-    auto it = sessions_.find(session_id);
-    if (it == sessions_.end()) {
-        return false;
-    }
-
-    sessions_.erase(it);
-    return true;
+    auto id = util::Id128::parse(session_id);
+    return id && sessions_.erase(*id) != 0;
 }
 
 void HttpTransport::cleanup_expired_sessions() {
-    auto now = std::chrono::steady_clock::now();
+    auto now = clock_->steady_now();
 
     for (auto it = sessions_.begin(); it != sessions_.end();) {
         auto inactive_duration = std::chrono::duration_cast<std::chrono::minutes>(
@@ -203,7 +182,7 @@ void HttpTransport::cleanup_expired_sessions() {
 
         if (inactive_duration >= SESSION_TIMEOUT) {
             if (error_callback_) {
-                std::string error = "Session timeout: " + it->first;
+                std::string error = "Session timeout: " + it->first.to_uuid();
                 error_callback_(error);
             }
             it = sessions_.erase(it);
@@ -213,5 +192,14 @@ void HttpTransport::cleanup_expired_sessions() {
     }
 }
 
+HttpTransport::SessionData* HttpTransport::find_session(std::string_view session_id) {
+    auto id = util::Id128::parse(session_id);
+    if (!id) {
+        return nullptr;
+    }
+    auto it = sessions_.find(*id);
+    return it != sessions_.end() ? &it->second : nullptr;
+}
+
 } // namespace transport
 } // namespace mcpp
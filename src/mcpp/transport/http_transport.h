@@ -27,13 +27,17 @@
 
 #include <chrono>
 #include <functional>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <unordered_map>
 #include <vector>
 
+#include "mcpp/transport/frame_limits.h"
 #include "mcpp/transport/transport.h"
+#include "mcpp/util/clock.h"
+#include "mcpp/util/id128.h"
 #include "mcpp/util/sse_formatter.h"
 #include <nlohmann/json.hpp>
 
@@ -216,7 +220,7 @@ public:
      * @brief Session data for tracking active HTTP sessions
      */
     struct SessionData {
-        std::string session_id;                                    ///< Unique session identifier (UUID v4)
+        util::Id128 session_id;                                    ///< Unique session identifier (UUID v4)
         std::vector<std::string> pending_messages;                 ///< Messages pending SSE delivery
         std::chrono::steady_clock::time_point last_activity;       ///< Last activity timestamp for timeout
         uint64_t last_event_id;                                    ///< Last SSE event ID sent (for resumability)
@@ -229,7 +233,14 @@ public:
      *
      * @note Call connect() to establish a session before use.
      */
-    HttpTransport() = default;
+    HttpTransport();
+
+    /**
+     * @brief Construct with an explicit clock for session expiry
+     *
+     * @param clock Time source for last_activity / SESSION_TIMEOUT checks
+     */
+    explicit HttpTransport(std::shared_ptr<util::Clock> clock);
 
     /**
      * @brief Destructor - cleans up sessions
@@ -299,6 +310,22 @@ public:
      */
     void set_error_callback(ErrorCallback cb) override;
 
+    /**
+     * @brief Set the pre-parse limits for POST bodies
+     *
+     * Bodies that are too large, too deeply nested or not valid UTF-8 are
+     * answered with a JSON-RPC parse error (-32700) and HTTP 413 (too
+     * large) or 400, without reaching the message callback. Users should
+     * also cap the body size in their HTTP server so oversized requests
+     * are refused before being read in full.
+     *
+     * @param limits Limits to enforce (see FrameLimits for defaults)
+     */
+    void set_frame_limits(const FrameLimits& limits) { limits_ = limits; }
+
+    /// @return Limits applied to POST bodies
+    const FrameLimits& frame_limits() const { return limits_; }
+
     /**
      * @brief Handle incoming POST request from client
      *
@@ -324,6 +351,18 @@ public:
     void handle_post_request(const std::string& body,
                              const std::string& session_id,
                              HttpResponseAdapter<T>& response) {
+        // Reject pathological bodies before touching session state
+        FrameError frame_error = check_frame(body, limits_);
+        if (frame_error != FrameError::None) {
+            response.set_status(frame_error == FrameError::TooLarge ? 413 : 400);
+            response.set_header("Content-Type", "application/json");
+            response.write(make_frame_error_response(frame_error) + "\n");
+            if (error_callback_) {
+                error_callback_(std::string("rejected frame: ") + to_string(frame_error));
+            }
+            return;
+        }
+
         // Validate or create session
         if (!session_id.empty()) {
             if (!validate_session(session_id)) {
@@ -338,9 +377,8 @@ public:
         }
 
         // Update session activity
-        auto it = sessions_.find(current_session_id_);
-        if (it != sessions_.end()) {
-            it->second.last_activity = std::chrono::steady_clock::now();
+        if (SessionData* session = find_session(current_session_id_)) {
+            session->last_activity = clock_->steady_now();
         }
 
         // Invoke message callback if set
@@ -395,9 +433,8 @@ public:
         }
 
         // Update session activity
-        auto it = sessions_.find(current_session_id_);
-        if (it != sessions_.end()) {
-            it->second.last_activity = std::chrono::steady_clock::now();
+        if (SessionData* session = find_session(current_session_id_)) {
+            session->last_activity = clock_->steady_now();
 
             // Set SSE headers
             writer.set_header("Content-Type", util::SseFormatter::content_type());
@@ -405,14 +442,14 @@ public:
             writer.set_header("Connection", util::SseFormatter::connection());
 
             // Send buffered messages via SSE
-            for (const auto& msg : it->second.pending_messages) {
+            for (const auto& msg : session->pending_messages) {
                 // Parse message for SSE formatting
                 try {
                     nlohmann::json j = nlohmann::json::parse(msg);
-                    std::string event_id = std::to_string(it->second.last_event_id);
+                    std::string event_id = std::to_string(session->last_event_id);
                     std::string sse_data = util::SseFormatter::format_event(j, event_id);
                     writer.write_sse(sse_data);
-                    ++(it->second.last_event_id);
+                    ++(session->last_event_id);
                 } catch (...) {
                     // Invalid JSON - send as-is
                     writer.write_sse("data: " + msg + "\n\n");
@@ -420,7 +457,7 @@ public:
             }
 
             // Clear buffer after sending
-            it->second.pending_messages.clear();
+            session->pending_messages.clear();
         }
     }
 
@@ -473,14 +510,22 @@ private:
      */
     void cleanup_expired_sessions();
 
+    /**
+     * @brief Look up a session by its text ID
+     * @return The session, or nullptr if @p session_id is malformed or unknown
+     */
+    SessionData* find_session(std::string_view session_id);
+
     static constexpr std::chrono::minutes SESSION_TIMEOUT{30};  ///< Session timeout duration
 
     std::string current_session_id_;                          ///< Current active session ID
     std::vector<std::string> message_buffer_;                 ///< Messages pending SSE delivery
-    std::unordered_map<std::string, SessionData> sessions_;   ///< Active sessions
+    std::unordered_map<util::Id128, SessionData, util::Id128Hash> sessions_;  ///< Active sessions
     MessageCallback message_callback_;                         ///< Callback for incoming POST requests
     ErrorCallback error_callback_;                             ///< Callback for error reporting
-    uint64_t last_event_id_;                                   ///< Last SSE event ID sent
+    FrameLimits limits_;                                       ///< Pre-parse limits for POST bodies
+    uint64_t last_event_id_ = 0;                               ///< Last SSE event ID sent
+    std::shared_ptr<util::Clock> clock_;                       ///< Time source for session expiry
 };
 
 } // namespace transport
@@ -0,0 +1,273 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mcpp/transport/process_transport.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+
+namespace mcpp {
+namespace transport {
+
+namespace {
+
+/// Poll waitpid() until the child exits or the grace period runs out
+bool wait_for_exit(pid_t pid, std::chrono::milliseconds grace) {
+    auto deadline = std::chrono::steady_clock::now() + grace;
+    while (true) {
+        pid_t result = ::waitpid(pid, nullptr, WNOHANG);
+        if (result == pid || (result < 0 && errno == ECHILD)) {
+            return true;
+        }
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        ::usleep(2000);
+    }
+}
+
+} // namespace
+
+std::unique_ptr<ProcessTransport> ProcessTransport::spawn(
+    const std::string& command,
+    const std::vector<std::string>& args,
+    std::string& error_message
+) {
+    return spawn(command, args, Options{}, error_message);
+}
+
+std::unique_ptr<ProcessTransport> ProcessTransport::spawn(
+    const std::string& command,
+    const std::vector<std::string>& args,
+    const Options& options,
+    std::string& error_message
+) {
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) != 0) {
+        error_message = std::string("socketpair failed: ") + std::strerror(errno);
+        return nullptr;
+    }
+
+    std::vector<char*> argv;
+    argv.reserve(args.size() + 2);
+    argv.push_back(const_cast<char*>(command.c_str()));
+    for (const auto& arg : args) {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+
+    // dup2() clears FD_CLOEXEC on the child's stdin/stdout; both socket
+    // ends themselves are close-on-exec
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, fds[1], STDIN_FILENO);
+    posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+
+    pid_t pid = 0;
+    int rc = ::posix_spawnp(&pid, command.c_str(), &actions, nullptr, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    ::close(fds[1]);
+
+    if (rc != 0) {
+        ::close(fds[0]);
+        error_message = "failed to spawn '" + command + "': " + std::strerror(rc);
+        return nullptr;
+    }
+
+    return std::unique_ptr<ProcessTransport>(new ProcessTransport(pid, fds[0], options));
+}
+
+ProcessTransport::ProcessTransport(pid_t pid, int fd, const Options& options)
+    : pid_(pid)
+    , fd_(fd)
+    , options_(options) {
+    if (::pipe2(wake_fds_, O_CLOEXEC | O_NONBLOCK) != 0) {
+        wake_fds_[0] = wake_fds_[1] = -1;
+    }
+}
+
+ProcessTransport::~ProcessTransport() {
+    disconnect();
+    terminate();
+    ::close(fd_);
+    if (wake_fds_[0] >= 0) {
+        ::close(wake_fds_[0]);
+        ::close(wake_fds_[1]);
+    }
+}
+
+bool ProcessTransport::connect() {
+    if (running_ || wake_fds_[0] < 0) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(reap_mutex_);
+    if (reaped_) {
+        return false;
+    }
+    running_ = true;
+    read_thread_ = std::thread([this]() { read_loop(); });
+    return true;
+}
+
+void ProcessTransport::disconnect() {
+    running_ = false;
+    if (wake_fds_[1] >= 0) {
+        char byte = 0;
+        [[maybe_unused]] ssize_t n = ::write(wake_fds_[1], &byte, 1);
+    }
+    if (read_thread_.joinable()) {
+        if (read_thread_.get_id() == std::this_thread::get_id()) {
+            read_thread_.detach();
+        } else {
+            read_thread_.join();
+        }
+    }
+}
+
+bool ProcessTransport::is_connected() const {
+    return running_;
+}
+
+bool ProcessTransport::send(std::string_view message) {
+    std::lock_guard<std::mutex> lock(send_mutex_);
+
+    auto write_all = [this](const char* data, size_t size) {
+        while (size > 0) {
+            ssize_t n = ::send(fd_, data, size, MSG_NOSIGNAL);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            data += n;
+            size -= static_cast<size_t>(n);
+        }
+        return true;
+    };
+
+    return write_all(message.data(), message.size()) && write_all("\n", 1);
+}
+
+void ProcessTransport::set_message_callback(MessageCallback cb) {
+    message_callback_ = std::move(cb);
+}
+
+void ProcessTransport::set_error_callback(ErrorCallback cb) {
+    error_callback_ = std::move(cb);
+}
+
+bool ProcessTransport::is_alive() {
+    std::lock_guard<std::mutex> lock(reap_mutex_);
+    if (reaped_) {
+        return false;
+    }
+    pid_t result = ::waitpid(pid_, nullptr, WNOHANG);
+    if (result == pid_ || (result < 0 && errno == ECHILD)) {
+        reaped_ = true;
+        return false;
+    }
+    return true;
+}
+
+void ProcessTransport::terminate() {
+    std::lock_guard<std::mutex> lock(reap_mutex_);
+    if (reaped_) {
+        return;
+    }
+    reaped_ = true;
+
+    // EOF on stdin is the polite way to ask a stdio server to exit
+    ::shutdown(fd_, SHUT_WR);
+    if (wait_for_exit(pid_, options_.kill_grace)) {
+        return;
+    }
+    ::kill(pid_, SIGTERM);
+    if (wait_for_exit(pid_, options_.kill_grace)) {
+        return;
+    }
+    ::kill(pid_, SIGKILL);
+    ::waitpid(pid_, nullptr, 0);
+}
+
+void ProcessTransport::read_loop() {
+    std::string buffer(64 * 1024, '\0');
+    LineFramer framer;
+
+    pollfd fds[2] = {{fd_, POLLIN, 0}, {wake_fds_[0], POLLIN, 0}};
+
+    while (running_) {
+        int ready = ::poll(fds, 2, -1);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        if (fds[1].revents != 0 || !running_) {
+            break;
+        }
+
+        ssize_t n = ::read(fd_, buffer.data(), buffer.size());
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            running_ = false;
+            if (error_callback_) {
+                error_callback_("child process closed stdout");
+            }
+            break;
+        }
+
+        framer.feed(std::string_view(buffer.data(), static_cast<size_t>(n)), options_.limits,
+                    [this](std::string_view line, FrameError error) {
+                        if (error != FrameError::None) {
+                            reject_frame(error);
+                        } else if (message_callback_) {
+                            message_callback_(line);
+                        }
+                        return running_.load();
+                    });
+    }
+}
+
+void ProcessTransport::reject_frame(FrameError error) {
+    send(make_frame_error_response(error));
+    if (error_callback_) {
+        error_callback_(std::string("rejected frame: ") + to_string(error));
+    }
+}
+
+} // namespace transport
+} // namespace mcpp
@@ -0,0 +1,156 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef MCPP_TRANSPORT_PROCESS_TRANSPORT_H
+#define MCPP_TRANSPORT_PROCESS_TRANSPORT_H
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <sys/types.h>
+
+#include "mcpp/transport/frame_limits.h"
+#include "mcpp/transport/transport.h"
+
+namespace mcpp {
+namespace transport {
+
+/**
+ * @brief Stdio transport to a child process spawned with posix_spawn
+ *
+ * The child's stdin and stdout are both bound to one end of a Unix
+ * socketpair, so writes from the parent use send(MSG_NOSIGNAL) and a child
+ * that dies mid-write surfaces as a failed send() rather than SIGPIPE.
+ * stderr is inherited.
+ *
+ * Unlike StdioTransport, the child's pid is always known, so the transport
+ * can check liveness and terminate the child deterministically: on
+ * destruction the socket is shut down (the child sees EOF on stdin), the
+ * child gets kill_grace to exit, then SIGTERM, then SIGKILL, and is reaped.
+ *
+ * Thread safety: send() may be called from any thread. Callbacks run on
+ * the read thread.
+ */
+class ProcessTransport : public Transport {
+public:
+    /// Spawn options
+    struct Options {
+        /// Time the child gets to exit on its own after EOF, and again after SIGTERM
+        std::chrono::milliseconds kill_grace{200};
+
+        /// Pre-parse limits for incoming lines
+        FrameLimits limits;
+    };
+
+    /**
+     * @brief Spawn a child process
+     *
+     * The command is looked up in PATH when it contains no slash.
+     *
+     * @param command Program to execute
+     * @param args Arguments (argv[1..])
+     * @param error_message Receives the failure reason
+     * @return The transport, or nullptr if the child could not be spawned
+     */
+    static std::unique_ptr<ProcessTransport> spawn(
+        const std::string& command,
+        const std::vector<std::string>& args,
+        std::string& error_message
+    );
+
+    /// @copydoc spawn
+    static std::unique_ptr<ProcessTransport> spawn(
+        const std::string& command,
+        const std::vector<std::string>& args,
+        const Options& options,
+        std::string& error_message
+    );
+
+    /**
+     * @brief Destructor - stops the read thread and terminates the child
+     */
+    ~ProcessTransport() override;
+
+    // Non-copyable, non-movable (owns a child process)
+    ProcessTransport(const ProcessTransport&) = delete;
+    ProcessTransport& operator=(const ProcessTransport&) = delete;
+    ProcessTransport(ProcessTransport&&) = delete;
+    ProcessTransport& operator=(ProcessTransport&&) = delete;
+
+    /// Start the read thread
+    bool connect() override;
+
+    /// Stop the read thread; the child keeps running
+    void disconnect() override;
+
+    /// @return true while the read thread is running
+    bool is_connected() const override;
+
+    /// Write the message and a newline to the child's stdin
+    bool send(std::string_view message) override;
+
+    void set_message_callback(MessageCallback cb) override;
+    void set_error_callback(ErrorCallback cb) override;
+
+    /// @return The child's pid
+    pid_t pid() const { return pid_; }
+
+    /// @return true if the child has not exited (reaps it if it has)
+    bool is_alive();
+
+    /**
+     * @brief Terminate and reap the child now
+     *
+     * Idempotent. Called by the destructor.
+     */
+    void terminate();
+
+private:
+    ProcessTransport(pid_t pid, int fd, const Options& options);
+
+    void read_loop();
+    void reject_frame(FrameError error);
+
+    pid_t pid_;                        ///< Child pid
+    int fd_;                           ///< Parent end of the socketpair
+    int wake_fds_[2] = {-1, -1};       ///< Pipe used to stop the read thread
+    Options options_;                  ///< Spawn options
+    bool reaped_ = false;              ///< waitpid() has collected the child
+    std::mutex reap_mutex_;            ///< Guards reaped_ and waitpid()
+    std::mutex send_mutex_;            ///< Serializes writes to fd_
+    std::atomic<bool> running_{false}; ///< Whether the read thread is running
+    std::thread read_thread_;          ///< Background thread reading stdout
+    MessageCallback message_callback_; ///< Callback for received messages
+    ErrorCallback error_callback_;     ///< Callback for transport errors
+};
+
+} // namespace transport
+} // namespace mcpp
+
+#endif // MCPP_TRANSPORT_PROCESS_TRANSPORT_H
@@ -123,24 +123,21 @@ void StdioTransport::set_error_callback(ErrorCallback cb) {
 
 void StdioTransport::read_loop() {
     char buffer[4096];
-    std::string line_buffer;
+    LineFramer framer;
 
     while (running_ && pipe_) {
         if (fgets(buffer, sizeof(buffer), pipe_)) {
-            line_buffer += buffer;
-
-            // Process complete lines (newline-delimited)
-            size_t pos;
-            while ((pos = line_buffer.find('\n')) != std::string::npos) {
-                std::string line = line_buffer.substr(0, pos);
-                line_buffer.erase(0, pos + 1);
-
-                if (message_callback_) {
+            framer.feed(buffer, limits_, [this](std::string_view line, FrameError error) {
+                if (error != FrameError::None) {
+                    reject_frame(error);
+                } else if (message_callback_) {
                     message_callback_(line);
                 }
-            }
+                return running_.load();
+            });
         } else {
             // EOF or error
+            running_ = false;
             if (error_callback_) {
                 error_callback_("Read error or EOF");
             }
@@ -149,6 +146,13 @@ void StdioTransport::read_loop() {
     }
 }
 
+void StdioTransport::reject_frame(FrameError error) {
+    send(make_frame_error_response(error));
+    if (error_callback_) {
+        error_callback_(std::string("rejected frame: ") + to_string(error));
+    }
+}
+
 StdioTransport::~StdioTransport() {
     disconnect();
 
@@ -34,6 +34,7 @@
 #include <vector>
 #include <unistd.h>  // for pid_t
 
+#include "mcpp/transport/frame_limits.h"
 #include "mcpp/transport/transport.h"
 
 namespace mcpp {
@@ -146,6 +147,21 @@ public:
      */
     void set_error_callback(ErrorCallback cb) override;
 
+    /**
+     * @brief Set the pre-parse limits for incoming lines
+     *
+     * Lines that are too long, too deeply nested or not valid UTF-8 are
+     * dropped before reaching the message callback; the subprocess gets a
+     * JSON-RPC parse error (-32700) and the error callback is invoked.
+     * Over-long lines are discarded while being read, so they are never
+     * buffered in full.
+     *
+     * Must be called before connect().
+     *
+     * @param limits Limits to enforce (see FrameLimits for defaults)
+     */
+    void set_frame_limits(const FrameLimits& limits) { limits_ = limits; }
+
 private:
     /**
      * @brief Private constructor for use by spawn()
@@ -163,12 +179,18 @@ private:
      */
     void read_loop();
 
+    /**
+     * @brief Answer a rejected line with a parse error and report it
+     */
+    void reject_frame(FrameError error);
+
     FILE* pipe_;                       ///< Pipe for stdin/stdout communication
     pid_t pid_;                        ///< Subprocess PID (may be 0 if unavailable)
     std::atomic<bool> running_;        ///< Whether the read thread is running
     std::thread read_thread_;          ///< Background thread for reading stdout
     MessageCallback message_callback_; ///< Callback for received messages
     ErrorCallback error_callback_;     ///< Callback for transport errors
+    FrameLimits limits_;               ///< Pre-parse limits for incoming lines
 };
 
 } // namespace transport
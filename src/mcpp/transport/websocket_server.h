@@ -0,0 +1,125 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef MCPP_TRANSPORT_WEBSOCKET_SERVER_H
+#define MCPP_TRANSPORT_WEBSOCKET_SERVER_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "mcpp/transport/websocket_transport.h"
+
+namespace mcpp {
+namespace transport {
+
+/**
+ * @brief Accepts WebSocket connections and hands each one out as a transport
+ *
+ * Listens on a TCP port, completes the opening handshake for each
+ * connection (bounded by Options::transport.handshake_timeout) and passes
+ * the resulting WebSocketTransport to the session handler, which
+ * typically attaches it to an McpServer and calls connect(). Each
+ * connection is its own session (WebSocketTransport::session_id()); set
+ * Options::transport.on_session_closed to McpServer::end_session() when
+ * one McpServer serves several connections.
+ *
+ * Example:
+ * @code
+ *   WebSocketServer ws(options);
+ *   ws.start([&](std::unique_ptr<WebSocketTransport> transport) {
+ *       sessions.push_back(make_session(std::move(transport)));
+ *   });
+ * @endcode
+ *
+ * Thread safety: the session handler runs on the accept thread.
+ * start() and stop() may be called from any thread.
+ */
+class WebSocketServer {
+public:
+    /// Server configuration
+    struct Options {
+        /// IPv4 address to bind
+        std::string host = "127.0.0.1";
+        /// Port to bind; 0 picks an ephemeral port (see port())
+        uint16_t port = 0;
+        /// Options for every accepted connection (path, encodings, keepalive)
+        WebSocketTransport::Options transport;
+    };
+
+    /// Receives each connection after a successful handshake
+    using SessionHandler = std::function<void(std::unique_ptr<WebSocketTransport>)>;
+
+    WebSocketServer();
+    explicit WebSocketServer(Options options);
+
+    /// Stops the accept thread
+    ~WebSocketServer();
+
+    // Non-copyable, non-movable (accept thread references this)
+    WebSocketServer(const WebSocketServer&) = delete;
+    WebSocketServer& operator=(const WebSocketServer&) = delete;
+    WebSocketServer(WebSocketServer&&) = delete;
+    WebSocketServer& operator=(WebSocketServer&&) = delete;
+
+    /**
+     * @brief Bind, listen and start accepting
+     *
+     * @param handler Receives every upgraded connection
+     * @return false if the socket could not be bound
+     */
+    bool start(SessionHandler handler);
+
+    /// Stop accepting; transports already handed out are unaffected
+    void stop();
+
+    /// @return The bound port (after start())
+    uint16_t port() const { return port_; }
+
+    /// @return Connections that completed the handshake
+    uint64_t sessions_accepted() const { return accepted_.load(); }
+
+    /// @return Connections whose handshake failed
+    uint64_t handshakes_failed() const { return failed_.load(); }
+
+private:
+    void accept_loop();
+
+    Options options_;
+    SessionHandler handler_;
+    int listen_fd_ = -1;
+    int wake_fds_[2] = {-1, -1};
+    uint16_t port_ = 0;
+    std::atomic<uint64_t> accepted_{0};
+    std::atomic<uint64_t> failed_{0};
+    std::thread thread_;
+};
+
+} // namespace transport
+} // namespace mcpp
+
+#endif // MCPP_TRANSPORT_WEBSOCKET_SERVER_H
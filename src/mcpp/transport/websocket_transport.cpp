@@ -0,0 +1,1042 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mcpp/transport/websocket_transport.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <nlohmann/json.hpp>
+
+#include "mcpp/server/session_scope.h"
+#include "mcpp/util/secure_random.h"
+
+#if MCPP_HAS_ZLIB
+#include <zlib.h>
+#endif
+
+namespace mcpp {
+namespace transport {
+
+namespace {
+
+constexpr uint8_t kContinuation = 0x0;
+constexpr uint8_t kText = 0x1;
+constexpr uint8_t kBinary = 0x2;
+constexpr uint8_t kClose = 0x8;
+constexpr uint8_t kPing = 0x9;
+constexpr uint8_t kPong = 0xA;
+
+constexpr uint16_t kCloseNormal = 1000;
+constexpr uint16_t kCloseProtocolError = 1002;
+constexpr uint16_t kCloseInvalidData = 1007;
+constexpr uint16_t kCloseTooBig = 1009;
+
+constexpr const char* kGuid = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+constexpr const char* kDeflateResponse =
+    "permessage-deflate; server_no_context_takeover; client_no_context_takeover";
+
+/// Largest accepted handshake head
+constexpr size_t kMaxHeadBytes = 16 * 1024;
+
+// ----------------------------------------------------------------------------
+// SHA-1 and base64, only needed for Sec-WebSocket-Accept
+// ----------------------------------------------------------------------------
+
+std::array<uint8_t, 20> sha1(std::string_view data) {
+    uint32_t h[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+
+    std::string padded(data);
+    uint64_t bit_length = static_cast<uint64_t>(data.size()) * 8;
+    padded.push_back(static_cast<char>(0x80));
+    while (padded.size() % 64 != 56) {
+        padded.push_back('\0');
+    }
+    for (int i = 7; i >= 0; --i) {
+        padded.push_back(static_cast<char>((bit_length >> (i * 8)) & 0xFF));
+    }
+
+    auto rotl = [](uint32_t x, int n) { return (x << n) | (x >> (32 - n)); };
+    for (size_t chunk = 0; chunk < padded.size(); chunk += 64) {
+        uint32_t w[80];
+        for (int i = 0; i < 16; ++i) {
+            const auto* p = reinterpret_cast<const uint8_t*>(padded.data() + chunk + i * 4);
+            w[i] = (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3];
+        }
+        for (int i = 16; i < 80; ++i) {
+            w[i] = rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+        }
+
+        uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+        for (int i = 0; i < 80; ++i) {
+            uint32_t f, k;
+            if (i < 20) {
+                f = (b & c) | (~b & d);
+                k = 0x5A827999;
+            } else if (i < 40) {
+                f = b ^ c ^ d;
+                k = 0x6ED9EBA1;
+            } else if (i < 60) {
+                f = (b & c) | (b & d) | (c & d);
+                k = 0x8F1BBCDC;
+            } else {
+                f = b ^ c ^ d;
+                k = 0xCA62C1D6;
+            }
+            uint32_t temp = rotl(a, 5) + f + e + k + w[i];
+            e = d;
+            d = c;
+            c = rotl(b, 30);
+            b = a;
+            a = temp;
+        }
+        h[0] += a;
+        h[1] += b;
+        h[2] += c;
+        h[3] += d;
+        h[4] += e;
+    }
+
+    std::array<uint8_t, 20> digest;
+    for (int i = 0; i < 5; ++i) {
+        digest[i * 4] = static_cast<uint8_t>(h[i] >> 24);
+        digest[i * 4 + 1] = static_cast<uint8_t>(h[i] >> 16);
+        digest[i * 4 + 2] = static_cast<uint8_t>(h[i] >> 8);
+        digest[i * 4 + 3] = static_cast<uint8_t>(h[i]);
+    }
+    return digest;
+}
+
+std::string base64(const uint8_t* data, size_t size) {
+    static constexpr char kAlphabet[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    out.reserve((size + 2) / 3 * 4);
+    for (size_t i = 0; i < size; i += 3) {
+        uint32_t n = uint32_t(data[i]) << 16;
+        if (i + 1 < size) n |= uint32_t(data[i + 1]) << 8;
+        if (i + 2 < size) n |= data[i + 2];
+        out.push_back(kAlphabet[(n >> 18) & 63]);
+        out.push_back(kAlphabet[(n >> 12) & 63]);
+        out.push_back(i + 1 < size ? kAlphabet[(n >> 6) & 63] : '=');
+        out.push_back(i + 2 < size ? kAlphabet[n & 63] : '=');
+    }
+    return out;
+}
+
+// ----------------------------------------------------------------------------
+// Handshake helpers
+// ----------------------------------------------------------------------------
+
+struct HttpHead {
+    std::string start_line;
+    std::vector<std::pair<std::string, std::string>> headers;  ///< Lower-case names
+
+    /// @return Comma-joined values of a header, or "" if absent
+    std::string get(std::string_view name) const {
+        std::string value;
+        for (const auto& [key, v] : headers) {
+            if (key == name) {
+                if (!value.empty()) {
+                    value += ", ";
+                }
+                value += v;
+            }
+        }
+        return value;
+    }
+};
+
+std::string lower(std::string_view s) {
+    std::string out(s);
+    std::transform(out.begin(), out.end(), out.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return out;
+}
+
+std::string_view trim(std::string_view s) {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t')) s.remove_suffix(1);
+    return s;
+}
+
+/// @return The comma-separated tokens of a header value, trimmed
+std::vector<std::string> split_tokens(std::string_view value) {
+    std::vector<std::string> tokens;
+    size_t start = 0;
+    while (start <= value.size()) {
+        size_t comma = value.find(',', start);
+        if (comma == std::string_view::npos) {
+            comma = value.size();
+        }
+        std::string_view token = trim(value.substr(start, comma - start));
+        if (!token.empty()) {
+            tokens.emplace_back(token);
+        }
+        start = comma + 1;
+    }
+    return tokens;
+}
+
+bool write_all(int fd, std::string_view data) {
+    while (!data.empty()) {
+        ssize_t n = ::send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data.remove_prefix(static_cast<size_t>(n));
+    }
+    return true;
+}
+
+bool write_iov(int fd, iovec* iov, int count) {
+    while (count > 0) {
+        msghdr msg{};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = static_cast<size_t>(count);
+        ssize_t n = ::sendmsg(fd, &msg, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        size_t written = static_cast<size_t>(n);
+        while (count > 0 && written >= iov->iov_len) {
+            written -= iov->iov_len;
+            ++iov;
+            --count;
+        }
+        if (count > 0) {
+            iov->iov_base = static_cast<char*>(iov->iov_base) + written;
+            iov->iov_len -= written;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Read an HTTP head (through the blank line) within a timeout
+ *
+ * @param rest Receives bytes read past the head (the first frames)
+ */
+bool read_head(int fd, std::chrono::milliseconds timeout, HttpHead& head, std::string& rest,
+               std::string& error) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    std::string data;
+    size_t end = std::string::npos;
+    char buffer[4096];
+
+    while ((end = data.find("\r\n\r\n")) == std::string::npos) {
+        if (data.size() > kMaxHeadBytes) {
+            error = "handshake head too large";
+            return false;
+        }
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0) {
+            error = "handshake timed out";
+            return false;
+        }
+        pollfd pfd{fd, POLLIN, 0};
+        int ready = ::poll(&pfd, 1, static_cast<int>(remaining.count()));
+        if (ready < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ready <= 0) {
+            continue;
+        }
+        ssize_t n = ::read(fd, buffer, sizeof(buffer));
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            error = "connection closed during handshake";
+            return false;
+        }
+        data.append(buffer, static_cast<size_t>(n));
+    }
+
+    rest = data.substr(end + 4);
+    std::string_view text(data.data(), end);
+    size_t line_end = text.find("\r\n");
+    head.start_line = std::string(text.substr(0, line_end));
+    while (line_end != std::string_view::npos) {
+        size_t start = line_end + 2;
+        line_end = text.find("\r\n", start);
+        std::string_view line = text.substr(start, line_end == std::string_view::npos
+                                                       ? std::string_view::npos
+                                                       : line_end - start);
+        size_t colon = line.find(':');
+        if (colon == std::string_view::npos) {
+            continue;
+        }
+        head.headers.emplace_back(lower(trim(line.substr(0, colon))),
+                                  std::string(trim(line.substr(colon + 1))));
+    }
+    return true;
+}
+
+bool contains_token(const std::string& value, std::string_view token) {
+    for (const auto& t : split_tokens(value)) {
+        if (lower(t) == token) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void set_nodelay(int fd) {
+    int one = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+}
+
+} // namespace
+
+// ============================================================================
+// permessage-deflate
+// ============================================================================
+
+struct WebSocketTransport::Deflate {
+#if MCPP_HAS_ZLIB
+    z_stream deflater{};
+    z_stream inflater{};
+
+    Deflate() {
+        deflateInit2(&deflater, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+        inflateInit2(&inflater, -15);
+    }
+
+    ~Deflate() {
+        deflateEnd(&deflater);
+        inflateEnd(&inflater);
+    }
+
+    /// Compress one message (no context takeover: every message starts fresh)
+    bool compress(std::string_view in, std::string& out) {
+        deflateReset(&deflater);
+        out.resize(deflateBound(&deflater, static_cast<uLong>(in.size())) + 16);
+        deflater.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(in.data()));
+        deflater.avail_in = static_cast<uInt>(in.size());
+        deflater.next_out = reinterpret_cast<Bytef*>(out.data());
+        deflater.avail_out = static_cast<uInt>(out.size());
+        if (deflate(&deflater, Z_SYNC_FLUSH) != Z_OK || deflater.avail_in != 0) {
+            return false;
+        }
+        out.resize(out.size() - deflater.avail_out);
+        // RFC 7692 7.2.1: drop the 00 00 FF FF tail of the sync flush
+        if (out.size() >= 4 && out.compare(out.size() - 4, 4, "\x00\x00\xff\xff", 4) == 0) {
+            out.resize(out.size() - 4);
+        }
+        return true;
+    }
+
+    /// Decompress one message, failing past max_bytes (0 = unlimited)
+    bool decompress(std::string in, std::string& out, size_t max_bytes) {
+        inflateReset(&inflater);
+        in.append("\x00\x00\xff\xff", 4);
+        inflater.next_in = reinterpret_cast<Bytef*>(in.data());
+        inflater.avail_in = static_cast<uInt>(in.size());
+        out.clear();
+        char chunk[16 * 1024];
+        while (inflater.avail_in > 0) {
+            inflater.next_out = reinterpret_cast<Bytef*>(chunk);
+            inflater.avail_out = sizeof(chunk);
+            int rc = inflate(&inflater, Z_SYNC_FLUSH);
+            if (rc != Z_OK && rc != Z_STREAM_END && rc != Z_BUF_ERROR) {
+                return false;
+            }
+            size_t produced = sizeof(chunk) - inflater.avail_out;
+            out.append(chunk, produced);
+            if (max_bytes != 0 && out.size() > max_bytes) {
+                return false;
+            }
+            if (produced == 0 || rc == Z_STREAM_END) {
+                break;
+            }
+        }
+        return true;
+    }
+#else
+    bool compress(std::string_view, std::string&) { return false; }
+    bool decompress(std::string, std::string&, size_t) { return false; }
+#endif
+};
+
+// ============================================================================
+// Handshakes
+// ============================================================================
+
+std::string WebSocketTransport::accept_key(std::string_view key) {
+    std::string input(key);
+    input += kGuid;
+    auto digest = sha1(input);
+    return base64(digest.data(), digest.size());
+}
+
+bool WebSocketTransport::deflate_supported() {
+#if MCPP_HAS_ZLIB
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::unique_ptr<WebSocketTransport> WebSocketTransport::connect_to(
+    const std::string& host,
+    uint16_t port,
+    const Options& options,
+    std::string& error_message
+) {
+    addrinfo hints{};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* result = nullptr;
+    std::string port_text = std::to_string(port);
+    int rc = ::getaddrinfo(host.c_str(), port_text.c_str(), &hints, &result);
+    if (rc != 0) {
+        error_message = "cannot resolve " + host + ": " + ::gai_strerror(rc);
+        return nullptr;
+    }
+
+    int fd = -1;
+    for (addrinfo* ai = result; ai != nullptr; ai = ai->ai_next) {
+        fd = ::socket(ai->ai_family, ai->ai_socktype | SOCK_CLOEXEC, ai->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+        if (::connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) {
+            break;
+        }
+        ::close(fd);
+        fd = -1;
+    }
+    ::freeaddrinfo(result);
+    if (fd < 0) {
+        error_message = "cannot connect to " + host + ":" + port_text + ": " + std::strerror(errno);
+        return nullptr;
+    }
+    set_nodelay(fd);
+
+    uint8_t nonce[16];
+    util::SecureRandom::fill(nonce, sizeof(nonce));
+    std::string key = base64(nonce, sizeof(nonce));
+    bool offer_deflate = options.allow_deflate && deflate_supported();
+
+    std::string request = "GET " + options.path + " HTTP/1.1\r\n"
+                          "Host: " + host + ":" + port_text + "\r\n"
+                          "Upgrade: websocket\r\n"
+                          "Connection: Upgrade\r\n"
+                          "Sec-WebSocket-Key: " + key + "\r\n"
+                          "Sec-WebSocket-Version: 13\r\n"
+                          "Sec-WebSocket-Protocol: " +
+                          (options.allow_cbor ? "mcp.cbor, mcp" : "mcp") + "\r\n";
+    if (offer_deflate) {
+        request += "Sec-WebSocket-Extensions: permessage-deflate; "
+                   "client_no_context_takeover; server_no_context_takeover\r\n";
+    }
+    request += "\r\n";
+
+    HttpHead head;
+    std::string rest;
+    if (!write_all(fd, request) ||
+        !read_head(fd, options.handshake_timeout, head, rest, error_message)) {
+        if (error_message.empty()) {
+            error_message = "failed to send handshake";
+        }
+        ::close(fd);
+        return nullptr;
+    }
+
+    if (head.start_line.compare(0, 12, "HTTP/1.1 101") != 0) {
+        error_message = "handshake rejected: " + head.start_line;
+        ::close(fd);
+        return nullptr;
+    }
+    if (head.get("sec-websocket-accept") != accept_key(key)) {
+        error_message = "handshake failed: bad Sec-WebSocket-Accept";
+        ::close(fd);
+        return nullptr;
+    }
+
+    std::string protocol = head.get("sec-websocket-protocol");
+    Encoding encoding = Encoding::Text;
+    if (protocol == "mcp.cbor" && options.allow_cbor) {
+        encoding = Encoding::Cbor;
+    } else if (!protocol.empty() && protocol != "mcp") {
+        error_message = "handshake failed: unexpected subprotocol " + protocol;
+        ::close(fd);
+        return nullptr;
+    }
+
+    std::string extensions = lower(head.get("sec-websocket-extensions"));
+    bool deflate = extensions.find("permessage-deflate") != std::string::npos;
+    if (deflate && !offer_deflate) {
+        error_message = "handshake failed: unrequested extension " + extensions;
+        ::close(fd);
+        return nullptr;
+    }
+
+    return std::unique_ptr<WebSocketTransport>(new WebSocketTransport(
+        fd, Role::Client, options, encoding, deflate, std::move(rest)));
+}
+
+std::unique_ptr<WebSocketTransport> WebSocketTransport::accept(
+    int fd,
+    const Options& options,
+    std::string& error_message
+) {
+    auto reject = [&](const std::string& status, const std::string& extra = "") {
+        write_all(fd, "HTTP/1.1 " + status + "\r\n" + extra +
+                      "Content-Length: 0\r\nConnection: close\r\n\r\n");
+        error_message = "handshake rejected: " + status;
+        ::close(fd);
+        return nullptr;
+    };
+
+    HttpHead head;
+    std::string rest;
+    if (!read_head(fd, options.handshake_timeout, head, rest, error_message)) {
+        ::close(fd);
+        return nullptr;
+    }
+
+    // "GET <path> HTTP/1.1"
+    size_t first_space = head.start_line.find(' ');
+    size_t second_space = head.start_line.find(' ', first_space + 1);
+    std::string method = head.start_line.substr(0, first_space);
+    std::string target = first_space == std::string::npos
+                             ? std::string()
+                             : head.start_line.substr(first_space + 1, second_space - first_space - 1);
+    if (method != "GET") {
+        return reject("405 Method Not Allowed");
+    }
+    if (target.substr(0, target.find('?')) != options.path) {
+        return reject("404 Not Found");
+    }
+    if (lower(head.get("upgrade")) != "websocket" ||
+        !contains_token(head.get("connection"), "upgrade")) {
+        return reject("426 Upgrade Required", "Upgrade: websocket\r\n");
+    }
+    if (head.get("sec-websocket-version") != "13") {
+        return reject("426 Upgrade Required", "Sec-WebSocket-Version: 13\r\n");
+    }
+    std::string key = head.get("sec-websocket-key");
+    if (key.empty()) {
+        return reject("400 Bad Request");
+    }
+
+    Encoding encoding = Encoding::Text;
+    std::string protocol;
+    auto offered = split_tokens(head.get("sec-websocket-protocol"));
+    if (options.allow_cbor &&
+        std::find(offered.begin(), offered.end(), "mcp.cbor") != offered.end()) {
+        encoding = Encoding::Cbor;
+        protocol = "mcp.cbor";
+    } else if (std::find(offered.begin(), offered.end(), "mcp") != offered.end()) {
+        protocol = "mcp";
+    }
+
+    // Accept the first permessage-deflate offer we can honour; an offer
+    // that limits our window size is declined rather than negotiated
+    bool deflate = false;
+    if (options.allow_deflate && deflate_supported()) {
+        for (const auto& offer : split_tokens(head.get("sec-websocket-extensions"))) {
+            std::string text = lower(offer);
+            if (text.compare(0, 18, "permessage-deflate") == 0 &&
+                text.find("server_max_window_bits") == std::string::npos) {
+                deflate = true;
+                break;
+            }
+        }
+    }
+
+    std::string response = "HTTP/1.1 101 Switching Protocols\r\n"
+                           "Upgrade: websocket\r\n"
+                           "Connection: Upgrade\r\n"
+                           "Sec-WebSocket-Accept: " + accept_key(key) + "\r\n";
+    if (!protocol.empty()) {
+        response += "Sec-WebSocket-Protocol: " + protocol + "\r\n";
+    }
+    if (deflate) {
+        response += std::string("Sec-WebSocket-Extensions: ") + kDeflateResponse + "\r\n";
+    }
+    response += "\r\n";
+    if (!write_all(fd, response)) {
+        error_message = "failed to send handshake response";
+        ::close(fd);
+        return nullptr;
+    }
+
+    set_nodelay(fd);
+    return std::unique_ptr<WebSocketTransport>(new WebSocketTransport(
+        fd, Role::Server, options, encoding, deflate, std::move(rest)));
+}
+
+// ============================================================================
+// Connection
+// ============================================================================
+
+WebSocketTransport::WebSocketTransport(int fd, Role role, const Options& options,
+                                       Encoding encoding, bool deflate, std::string buffered)
+    : fd_(fd)
+    , role_(role)
+    , options_(options)
+    , encoding_(encoding)
+    , deflate_(deflate ? std::make_unique<Deflate>() : nullptr)
+    , buffered_(std::move(buffered))
+    , session_id_(role == Role::Server ? util::SecureRandom::next_id128().to_hex() : std::string()) {}
+
+WebSocketTransport::~WebSocketTransport() {
+    disconnect();
+    ::close(fd_);
+}
+
+bool WebSocketTransport::connect() {
+    if (running_ || !open_) {
+        return false;
+    }
+    running_ = true;
+    read_thread_ = std::thread([this]() {
+        read_loop();
+        if (role_ == Role::Server && options_.on_session_closed) {
+            options_.on_session_closed(session_id_);
+        }
+    });
+    return true;
+}
+
+void WebSocketTransport::disconnect() {
+    if (open_.exchange(false)) {
+        std::lock_guard<std::mutex> lock(send_mutex_);
+        if (!close_sent_.exchange(true)) {
+            uint8_t code[2] = {kCloseNormal >> 8, kCloseNormal & 0xFF};
+            send_frame(kClose, false, std::string_view(reinterpret_cast<char*>(code), 2), true);
+        }
+    }
+    running_ = false;
+    ::shutdown(fd_, SHUT_RDWR);
+    if (read_thread_.joinable()) {
+        if (read_thread_.get_id() == std::this_thread::get_id()) {
+            read_thread_.detach();
+        } else {
+            read_thread_.join();
+        }
+    }
+}
+
+bool WebSocketTransport::is_connected() const {
+    return open_;
+}
+
+void WebSocketTransport::set_message_callback(MessageCallback cb) {
+    message_callback_ = std::move(cb);
+}
+
+void WebSocketTransport::set_error_callback(ErrorCallback cb) {
+    error_callback_ = std::move(cb);
+}
+
+bool WebSocketTransport::send(std::string_view message) {
+    // Stdio-style framing newlines have no meaning inside a WebSocket message
+    while (!message.empty() && message.back() == '\n') {
+        message.remove_suffix(1);
+    }
+
+    if (encoding_ == Encoding::Cbor) {
+        auto json = nlohmann::json::parse(message, nullptr, false);
+        if (json.is_discarded()) {
+            return false;
+        }
+        std::string cbor;
+        nlohmann::json::to_cbor(json, cbor);
+        return send_message(kBinary, cbor);
+    }
+    return send_message(kText, message);
+}
+
+bool WebSocketTransport::ping(std::string_view payload) {
+    if (payload.size() > 125) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(send_mutex_);
+    return open_ && send_frame(kPing, false, payload, true);
+}
+
+bool WebSocketTransport::send_message(uint8_t opcode, std::string_view payload) {
+    std::lock_guard<std::mutex> lock(send_mutex_);
+    if (!open_) {
+        return false;
+    }
+
+    std::string compressed;
+    bool rsv1 = false;
+    if (deflate_ && payload.size() >= options_.deflate_threshold &&
+        deflate_->compress(payload, compressed)) {
+        payload = compressed;
+        rsv1 = true;
+    }
+
+    const size_t fragment = options_.fragment_size;
+    if (fragment == 0 || payload.size() <= fragment) {
+        return send_frame(opcode, rsv1, payload, true);
+    }
+
+    // Fragmented: opcode and RSV1 on the first frame only (RFC 6455 5.4)
+    for (size_t offset = 0; offset < payload.size(); offset += fragment) {
+        bool first = offset == 0;
+        bool last = offset + fragment >= payload.size();
+        if (!send_frame(first ? opcode : kContinuation, first && rsv1,
+                        payload.substr(offset, fragment), last)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool WebSocketTransport::send_frame(uint8_t opcode, bool rsv1, std::string_view payload, bool fin) {
+    uint8_t header[14];
+    size_t header_size = 2;
+    header[0] = static_cast<uint8_t>((fin ? 0x80 : 0) | (rsv1 ? 0x40 : 0) | opcode);
+
+    const bool masked = role_ == Role::Client;
+    const uint8_t mask_bit = masked ? 0x80 : 0;
+    const size_t size = payload.size();
+    if (size < 126) {
+        header[1] = static_cast<uint8_t>(mask_bit | size);
+    } else if (size <= 0xFFFF) {
+        header[1] = mask_bit | 126;
+        header[2] = static_cast<uint8_t>(size >> 8);
+        header[3] = static_cast<uint8_t>(size);
+        header_size = 4;
+    } else {
+        header[1] = mask_bit | 127;
+        for (int i = 0; i < 8; ++i) {
+            header[2 + i] = static_cast<uint8_t>(static_cast<uint64_t>(size) >> (56 - i * 8));
+        }
+        header_size = 10;
+    }
+
+    iovec iov[2];
+    iov[0] = {header, header_size};
+
+    if (!masked) {
+        // Server frames go out without copying the payload
+        iov[1] = {const_cast<char*>(payload.data()), size};
+        return write_iov(fd_, iov, size > 0 ? 2 : 1);
+    }
+
+    // RFC 6455 5.3: keys must be unpredictable to defeat cache poisoning
+    uint8_t mask[4];
+    util::SecureRandom::fill(mask, sizeof(mask));
+    std::memcpy(header + header_size, mask, 4);
+    iov[0].iov_len = header_size + 4;
+
+    std::string masked_payload(payload);
+    for (size_t i = 0; i < size; ++i) {
+        masked_payload[i] = static_cast<char>(masked_payload[i] ^ mask[i & 3]);
+    }
+    iov[1] = {masked_payload.data(), size};
+    return write_iov(fd_, iov, size > 0 ? 2 : 1);
+}
+
+// ============================================================================
+// Receiving
+// ============================================================================
+
+void WebSocketTransport::read_loop() {
+    using Clock = std::chrono::steady_clock;
+
+    std::string input = std::move(buffered_);
+    std::string message;
+    uint8_t message_opcode = 0;
+    bool compressed = false;
+
+    const bool keepalive = options_.ping_interval.count() > 0;
+    auto last_activity = Clock::now();
+    bool ping_outstanding = false;
+    auto ping_sent = last_activity;
+
+    const size_t max_message = options_.limits.max_frame_bytes;
+    std::vector<char> chunk(64 * 1024);
+
+    while (running_) {
+        // Parse every complete frame in the buffer
+        size_t pos = 0;
+        while (input.size() - pos >= 2) {
+            const auto* p = reinterpret_cast<const uint8_t*>(input.data() + pos);
+            bool fin = p[0] & 0x80;
+            bool rsv1 = p[0] & 0x40;
+            uint8_t opcode = p[0] & 0x0F;
+            bool masked = p[1] & 0x80;
+            uint64_t length = p[1] & 0x7F;
+            size_t header = 2;
+
+            if ((p[0] & 0x30) != 0 || (rsv1 && !deflate_)) {
+                fail(kCloseProtocolError, "reserved bits set");
+                return;
+            }
+            // Clients must mask, servers must not (RFC 6455 5.1)
+            if (masked != (role_ == Role::Server)) {
+                fail(kCloseProtocolError, "bad frame masking");
+                return;
+            }
+
+            if (length == 126) {
+                if (input.size() - pos < 4) break;
+                length = (uint64_t(p[2]) << 8) | p[3];
+                header = 4;
+            } else if (length == 127) {
+                if (input.size() - pos < 10) break;
+                length = 0;
+                for (int i = 0; i < 8; ++i) {
+                    length = (length << 8) | p[2 + i];
+                }
+                header = 10;
+            }
+            if (max_message != 0 && length > max_message) {
+                fail(kCloseTooBig, "frame exceeds max_frame_bytes");
+                return;
+            }
+            size_t mask_offset = header;
+            if (masked) {
+                header += 4;
+            }
+            if (input.size() - pos < header + length) {
+                break;
+            }
+
+            std::string payload = input.substr(pos + header, length);
+            if (masked) {
+                const uint8_t* mask = p + mask_offset;
+                for (size_t i = 0; i < payload.size(); ++i) {
+                    payload[i] = static_cast<char>(payload[i] ^ mask[i & 3]);
+                }
+            }
+            pos += header + length;
+
+            if (!handle_frame(opcode, fin, rsv1, std::move(payload), message, message_opcode,
+                              compressed)) {
+                return;
+            }
+        }
+        input.erase(0, pos);
+
+        int timeout = -1;
+        if (keepalive) {
+            auto due = ping_outstanding ? ping_sent + options_.pong_timeout
+                                        : last_activity + options_.ping_interval;
+            timeout = static_cast<int>(std::max<int64_t>(
+                0, std::chrono::duration_cast<std::chrono::milliseconds>(due - Clock::now()).count()));
+        }
+
+        pollfd pfd{fd_, POLLIN, 0};
+        int ready = ::poll(&pfd, 1, timeout);
+        if (ready < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ready == 0) {
+            if (ping_outstanding) {
+                fail(kCloseNormal, "keepalive timeout");
+                return;
+            }
+            ping();
+            ping_outstanding = true;
+            ping_sent = Clock::now();
+            continue;
+        }
+
+        ssize_t n = ::read(fd_, chunk.data(), chunk.size());
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            if (open_.exchange(false)) {
+                report("connection closed");
+            }
+            return;
+        }
+        input.append(chunk.data(), static_cast<size_t>(n));
+        last_activity = Clock::now();
+        ping_outstanding = false;
+    }
+}
+
+bool WebSocketTransport::handle_frame(uint8_t opcode, bool fin, bool rsv1, std::string&& payload,
+                                      std::string& message, uint8_t& message_opcode,
+                                      bool& compressed) {
+    if (opcode >= kClose) {
+        if (!fin || payload.size() > 125 || rsv1) {
+            fail(kCloseProtocolError, "malformed control frame");
+            return false;
+        }
+        switch (opcode) {
+            case kPing: {
+                std::lock_guard<std::mutex> lock(send_mutex_);
+                if (open_) {
+                    send_frame(kPong, false, payload, true);
+                }
+                return true;
+            }
+            case kPong:
+                ++pongs_;
+                return true;
+            case kClose: {
+                // Echo the peer's status code and finish the closing handshake
+                if (open_.exchange(false)) {
+                    {
+                        std::lock_guard<std::mutex> lock(send_mutex_);
+                        if (!close_sent_.exchange(true)) {
+                            send_frame(kClose, false, std::string_view(payload).substr(0, 2), true);
+                        }
+                    }
+                    report("connection closed by peer");
+                }
+                ::shutdown(fd_, SHUT_RDWR);
+                return false;
+            }
+            default:
+                fail(kCloseProtocolError, "unknown control opcode");
+                return false;
+        }
+    }
+
+    if (opcode == kContinuation) {
+        if (message_opcode == 0 || rsv1) {
+            fail(kCloseProtocolError, "unexpected continuation frame");
+            return false;
+        }
+        message += payload;
+    } else if (opcode == kText || opcode == kBinary) {
+        if (message_opcode != 0) {
+            fail(kCloseProtocolError, "new message inside a fragmented message");
+            return false;
+        }
+        message_opcode = opcode;
+        compressed = rsv1;
+        message = std::move(payload);
+    } else {
+        fail(kCloseProtocolError, "unknown opcode");
+        return false;
+    }
+
+    const size_t max_message = options_.limits.max_frame_bytes;
+    if (max_message != 0 && message.size() > max_message) {
+        fail(kCloseTooBig, "message exceeds max_frame_bytes");
+        return false;
+    }
+
+    if (fin) {
+        uint8_t completed = message_opcode;
+        message_opcode = 0;
+        deliver(completed, std::move(message), compressed);
+        message.clear();
+    }
+    return open_;
+}
+
+void WebSocketTransport::deliver(uint8_t opcode, std::string&& payload, bool compressed) {
+    std::string text;
+    if (compressed) {
+        if (!deflate_->decompress(std::move(payload), text, options_.limits.max_frame_bytes)) {
+            fail(kCloseTooBig, "failed to inflate message");
+            return;
+        }
+    } else {
+        text = std::move(payload);
+    }
+
+    if (opcode == kBinary && encoding_ == Encoding::Cbor) {
+        auto json = nlohmann::json::from_cbor(text, true, false);
+        if (json.is_discarded()) {
+            fail(kCloseInvalidData, "invalid CBOR message");
+            return;
+        }
+        // CBOR text strings are not checked for UTF-8 on decode; dump() is
+        // where invalid sequences surface, on this read thread
+        try {
+            text = json.dump();
+        } catch (const nlohmann::json::type_error&) {
+            fail(kCloseInvalidData, "invalid UTF-8 in CBOR message");
+            return;
+        }
+    }
+
+    FrameError error = check_frame(text, options_.limits);
+    if (error == FrameError::InvalidUtf8) {
+        fail(kCloseInvalidData, to_string(error));
+        return;
+    }
+    if (error != FrameError::None) {
+        send(make_frame_error_response(error));
+        report(std::string("rejected frame: ") + to_string(error));
+        return;
+    }
+    if (message_callback_) {
+        if (role_ == Role::Server) {
+            // Rate limits and tenants of a shared McpServer apply per connection
+            server::SessionScope scope(session_id_);
+            message_callback_(text);
+        } else {
+            message_callback_(text);
+        }
+    }
+}
+
+void WebSocketTransport::fail(uint16_t close_code, const std::string& reason) {
+    if (open_.exchange(false)) {
+        {
+            std::lock_guard<std::mutex> lock(send_mutex_);
+            if (!close_sent_.exchange(true)) {
+                uint8_t code[2] = {static_cast<uint8_t>(close_code >> 8),
+                                   static_cast<uint8_t>(close_code & 0xFF)};
+                send_frame(kClose, false, std::string_view(reinterpret_cast<char*>(code), 2), true);
+            }
+        }
+        report(reason);
+    }
+    ::shutdown(fd_, SHUT_RDWR);
+}
+
+void WebSocketTransport::report(std::string_view error) {
+    if (error_callback_) {
+        error_callback_(error);
+    }
+}
+
+} // namespace transport
+} // namespace mcpp
@@ -0,0 +1,238 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef MCPP_TRANSPORT_WEBSOCKET_TRANSPORT_H
+#define MCPP_TRANSPORT_WEBSOCKET_TRANSPORT_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "mcpp/transport/frame_limits.h"
+#include "mcpp/transport/transport.h"
+
+namespace mcpp {
+namespace transport {
+
+/**
+ * @brief RFC 6455 WebSocket transport over a plain TCP socket
+ *
+ * One JSON-RPC message travels per WebSocket message, in both directions
+ * at once, with 2-14 bytes of framing instead of an HTTP request per call.
+ * The same class serves both ends: connect_to() performs the client
+ * handshake, accept() the server handshake on an already accepted socket
+ * (see WebSocketServer).
+ *
+ * Negotiated per connection during the handshake:
+ * - Encoding (Sec-WebSocket-Protocol): "mcp" carries JSON text frames;
+ *   "mcp.cbor" carries the same messages CBOR-encoded in binary frames.
+ *   The transport converts, so send() and the message callback always
+ *   see JSON text.
+ * - Compression (Sec-WebSocket-Extensions): permessage-deflate (RFC 7692)
+ *   with no context takeover, when built with MCPP_WITH_ZLIB. Messages
+ *   shorter than Options::deflate_threshold are sent uncompressed.
+ *
+ * Messages longer than Options::fragment_size are written as a sequence
+ * of continuation frames, so a multi-megabyte result does not have to be
+ * framed in one piece and control frames can interleave. Incoming
+ * fragments are reassembled up to limits.max_frame_bytes (larger messages
+ * close the connection with 1009).
+ *
+ * Keepalive: when Options::ping_interval is set, a ping is sent after that
+ * much silence; if nothing (pong or data) arrives within pong_timeout the
+ * connection is reported dead through the error callback.
+ *
+ * Limitations: no TLS (terminate in a proxy), IPv4 and hostnames resolved
+ * with getaddrinfo.
+ *
+ * Thread safety: send() and ping() may be called from any thread.
+ * Callbacks run on the read thread started by connect().
+ */
+class WebSocketTransport : public Transport {
+public:
+    /// Which side of the handshake this transport performed
+    enum class Role { Client, Server };
+
+    /// Message encoding chosen during the handshake
+    enum class Encoding { Text, Cbor };
+
+    /// Connection options
+    struct Options {
+        /// Request path (client) or the only accepted path (server)
+        std::string path = "/mcp";
+
+        /// Offer (client) or accept (server) the "mcp.cbor" subprotocol
+        bool allow_cbor = false;
+
+        /// Offer (client) or accept (server) permessage-deflate
+        bool allow_deflate = true;
+
+        /// Messages smaller than this are never compressed
+        size_t deflate_threshold = 256;
+
+        /// Split outgoing messages into frames of at most this many bytes (0 = never)
+        size_t fragment_size = 64 * 1024;
+
+        /// Send a ping after this much silence (0 = no keepalive)
+        std::chrono::milliseconds ping_interval{0};
+
+        /// Time the peer has to answer a keepalive ping
+        std::chrono::milliseconds pong_timeout{std::chrono::seconds(10)};
+
+        /// Time allowed for the opening handshake
+        std::chrono::milliseconds handshake_timeout{std::chrono::seconds(5)};
+
+        /// Pre-parse limits for incoming messages (max_frame_bytes caps reassembly)
+        FrameLimits limits;
+
+        /// Server side: called with session_id() on the read thread once
+        /// the connection has ended (must not destroy the transport)
+        std::function<void(std::string_view session)> on_session_closed;
+    };
+
+    /**
+     * @brief Open a TCP connection and perform the client handshake
+     *
+     * @param host Host name or IPv4 address
+     * @param port TCP port
+     * @param options Connection options
+     * @param error_message Receives the failure reason
+     * @return The transport, or nullptr on failure
+     */
+    static std::unique_ptr<WebSocketTransport> connect_to(
+        const std::string& host,
+        uint16_t port,
+        const Options& options,
+        std::string& error_message
+    );
+
+    /**
+     * @brief Perform the server handshake on an accepted socket
+     *
+     * Takes ownership of fd (closed on failure). Requests for another path
+     * or without a valid upgrade are answered with an HTTP error.
+     *
+     * @param fd Connected socket
+     * @param options Connection options
+     * @param error_message Receives the failure reason
+     * @return The transport, or nullptr on failure
+     */
+    static std::unique_ptr<WebSocketTransport> accept(
+        int fd,
+        const Options& options,
+        std::string& error_message
+    );
+
+    /// @return Sec-WebSocket-Accept value for a Sec-WebSocket-Key
+    static std::string accept_key(std::string_view key);
+
+    /// @return true if built with permessage-deflate support
+    static bool deflate_supported();
+
+    /// Sends a close frame, stops the read thread and closes the socket
+    ~WebSocketTransport() override;
+
+    // Non-copyable, non-movable (owns a socket and a thread)
+    WebSocketTransport(const WebSocketTransport&) = delete;
+    WebSocketTransport& operator=(const WebSocketTransport&) = delete;
+    WebSocketTransport(WebSocketTransport&&) = delete;
+    WebSocketTransport& operator=(WebSocketTransport&&) = delete;
+
+    /// Start the read thread (the handshake is already complete)
+    bool connect() override;
+
+    /// Send a close frame (1000) and stop the read thread
+    void disconnect() override;
+
+    /// @return true until the connection closes or fails
+    bool is_connected() const override;
+
+    /// Send one message as a text (or CBOR binary) message
+    bool send(std::string_view message) override;
+
+    void set_message_callback(MessageCallback cb) override;
+    void set_error_callback(ErrorCallback cb) override;
+
+    /// Send a ping control frame (payload up to 125 bytes)
+    bool ping(std::string_view payload = {});
+
+    Role role() const { return role_; }
+    Encoding encoding() const { return encoding_; }
+
+    /// @return true if permessage-deflate was negotiated
+    bool uses_deflate() const { return deflate_ != nullptr; }
+
+    /// @return Pongs received so far
+    uint64_t pongs_received() const { return pongs_.load(); }
+
+    /**
+     * @return Server side: random ID naming this connection's session
+     *         (empty for clients). Incoming messages are delivered inside a
+     *         server::SessionScope with this ID.
+     */
+    const std::string& session_id() const { return session_id_; }
+
+private:
+    struct Deflate;
+
+    WebSocketTransport(int fd, Role role, const Options& options, Encoding encoding,
+                       bool deflate, std::string buffered);
+
+    bool send_frame(uint8_t opcode, bool rsv1, std::string_view payload, bool fin);
+    bool send_message(uint8_t opcode, std::string_view payload);
+    void read_loop();
+    bool handle_frame(uint8_t opcode, bool fin, bool rsv1, std::string&& payload,
+                      std::string& message, uint8_t& message_opcode, bool& compressed);
+    void deliver(uint8_t opcode, std::string&& payload, bool compressed);
+    void fail(uint16_t close_code, const std::string& reason);
+    void report(std::string_view error);
+
+    int fd_;
+    Role role_;
+    Options options_;
+    Encoding encoding_;
+    std::unique_ptr<Deflate> deflate_;
+    std::string buffered_;               ///< Bytes read past the handshake
+    std::string session_id_;             ///< Server side only
+    std::mutex send_mutex_;              ///< Keeps frames of one message together
+    std::atomic<bool> open_{true};       ///< Cleared on close or failure
+    std::atomic<bool> close_sent_{false};
+    std::atomic<bool> running_{false};   ///< Whether the read thread is running
+    std::atomic<uint64_t> pongs_{0};
+    std::thread read_thread_;
+    MessageCallback message_callback_;
+    ErrorCallback error_callback_;
+};
+
+} // namespace transport
+} // namespace mcpp
+
+#endif // MCPP_TRANSPORT_WEBSOCKET_TRANSPORT_H
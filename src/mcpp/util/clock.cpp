@@ -0,0 +1,144 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mcpp/util/clock.h"
+
+#include <mutex>
+
+#include <time.h>
+
+namespace mcpp::util {
+
+namespace {
+
+std::mutex default_clock_mutex;
+
+std::shared_ptr<Clock>& default_clock_slot() {
+    static std::shared_ptr<Clock> slot = Clock::system();
+    return slot;
+}
+
+template<typename Duration>
+int64_t to_ns(Duration d) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+}
+
+#if defined(CLOCK_MONOTONIC_COARSE) && defined(CLOCK_REALTIME_COARSE)
+std::chrono::nanoseconds read_clock(clockid_t id) noexcept {
+    timespec ts{};
+    clock_gettime(id, &ts);
+    return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+}
+#endif
+
+} // anonymous namespace
+
+// ============================================================================
+// Clock
+// ============================================================================
+
+const std::shared_ptr<Clock>& Clock::system() {
+    static const std::shared_ptr<Clock> instance = std::make_shared<SystemClock>();
+    return instance;
+}
+
+const std::shared_ptr<Clock>& Clock::coarse() {
+    static const std::shared_ptr<Clock> instance = std::make_shared<CoarseClock>();
+    return instance;
+}
+
+std::shared_ptr<Clock> Clock::default_clock() {
+    std::lock_guard<std::mutex> lock(default_clock_mutex);
+    return default_clock_slot();
+}
+
+void Clock::set_default_clock(std::shared_ptr<Clock> clock) {
+    std::lock_guard<std::mutex> lock(default_clock_mutex);
+    default_clock_slot() = clock ? std::move(clock) : system();
+}
+
+// ============================================================================
+// CoarseClock
+// ============================================================================
+
+Clock::SteadyTimePoint CoarseClock::steady_now() const noexcept {
+#if defined(CLOCK_MONOTONIC_COARSE) && defined(CLOCK_REALTIME_COARSE)
+    // libstdc++/libc++ steady_clock is CLOCK_MONOTONIC, which shares its
+    // epoch with CLOCK_MONOTONIC_COARSE
+    return SteadyTimePoint(std::chrono::duration_cast<SteadyTimePoint::duration>(
+        read_clock(CLOCK_MONOTONIC_COARSE)));
+#else
+    return std::chrono::steady_clock::now();
+#endif
+}
+
+Clock::SystemTimePoint CoarseClock::system_now() const noexcept {
+#if defined(CLOCK_MONOTONIC_COARSE) && defined(CLOCK_REALTIME_COARSE)
+    return SystemTimePoint(std::chrono::duration_cast<SystemTimePoint::duration>(
+        read_clock(CLOCK_REALTIME_COARSE)));
+#else
+    return std::chrono::system_clock::now();
+#endif
+}
+
+// ============================================================================
+// ManualClock
+// ============================================================================
+
+ManualClock::ManualClock() noexcept
+    : ManualClock(std::chrono::steady_clock::now(), std::chrono::system_clock::now()) {
+}
+
+ManualClock::ManualClock(SteadyTimePoint steady, SystemTimePoint system) noexcept
+    : steady_ns_(to_ns(steady.time_since_epoch()))
+    , system_ns_(to_ns(system.time_since_epoch())) {
+}
+
+Clock::SteadyTimePoint ManualClock::steady_now() const noexcept {
+    return SteadyTimePoint(std::chrono::duration_cast<SteadyTimePoint::duration>(
+        std::chrono::nanoseconds(steady_ns_.load(std::memory_order_acquire))));
+}
+
+Clock::SystemTimePoint ManualClock::system_now() const noexcept {
+    return SystemTimePoint(std::chrono::duration_cast<SystemTimePoint::duration>(
+        std::chrono::nanoseconds(system_ns_.load(std::memory_order_acquire))));
+}
+
+void ManualClock::advance(std::chrono::nanoseconds delta) noexcept {
+    if (delta.count() <= 0) {
+        return;
+    }
+    steady_ns_.fetch_add(delta.count(), std::memory_order_acq_rel);
+    system_ns_.fetch_add(delta.count(), std::memory_order_acq_rel);
+}
+
+void ManualClock::set_steady(SteadyTimePoint t) noexcept {
+    steady_ns_.store(to_ns(t.time_since_epoch()), std::memory_order_release);
+}
+
+void ManualClock::set_system(SystemTimePoint t) noexcept {
+    system_ns_.store(to_ns(t.time_since_epoch()), std::memory_order_release);
+}
+
+} // namespace mcpp::util
@@ -0,0 +1,167 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef MCPP_UTIL_CLOCK_H
+#define MCPP_UTIL_CLOCK_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+namespace mcpp::util {
+
+/**
+ * @brief Injectable source of steady and wall-clock time
+ *
+ * Timer-driven components (TimeoutManager, TaskManager, HttpTransport
+ * session expiry, RequestContext deadlines) read time through a Clock
+ * instead of calling std::chrono clocks directly. Production code uses
+ * SystemClock or CoarseClock; tests and benchmarks use ManualClock to
+ * advance time instantly and deterministically.
+ *
+ * Time points are expressed in the std::chrono clock types so existing
+ * deadline arithmetic is unchanged.
+ *
+ * Thread safety: All implementations are thread-safe.
+ */
+class Clock {
+public:
+    using SteadyTimePoint = std::chrono::steady_clock::time_point;
+    using SystemTimePoint = std::chrono::system_clock::time_point;
+
+    virtual ~Clock() = default;
+
+    /// Monotonic time, for deadlines and timeouts
+    virtual SteadyTimePoint steady_now() const noexcept = 0;
+
+    /// Wall-clock time, for timestamps reported to peers
+    virtual SystemTimePoint system_now() const noexcept = 0;
+
+    /**
+     * @brief Shared SystemClock instance
+     */
+    static const std::shared_ptr<Clock>& system();
+
+    /**
+     * @brief Shared CoarseClock instance
+     */
+    static const std::shared_ptr<Clock>& coarse();
+
+    /**
+     * @brief Clock used by components constructed without an explicit clock
+     *
+     * Initially system(). Returned by value so a concurrent
+     * set_default_clock() cannot invalidate it.
+     */
+    static std::shared_ptr<Clock> default_clock();
+
+    /**
+     * @brief Replace the process-wide default clock
+     *
+     * Affects only components constructed afterwards.
+     *
+     * @param clock New default (nullptr restores system())
+     */
+    static void set_default_clock(std::shared_ptr<Clock> clock);
+
+protected:
+    Clock() = default;
+};
+
+/**
+ * @brief std::chrono::steady_clock / system_clock
+ */
+class SystemClock : public Clock {
+public:
+    SteadyTimePoint steady_now() const noexcept override {
+        return std::chrono::steady_clock::now();
+    }
+
+    SystemTimePoint system_now() const noexcept override {
+        return std::chrono::system_clock::now();
+    }
+};
+
+/**
+ * @brief Kernel-cached coarse clock (CLOCK_MONOTONIC_COARSE)
+ *
+ * Reads the timestamp the kernel updates on every tick instead of the
+ * hardware counter, which makes now() several times cheaper at the cost
+ * of tick resolution (1-4ms). Suitable for session expiry and request
+ * deadlines, not for latency measurement. Falls back to SystemClock
+ * behaviour where coarse clocks are unavailable.
+ */
+class CoarseClock : public Clock {
+public:
+    SteadyTimePoint steady_now() const noexcept override;
+    SystemTimePoint system_now() const noexcept override;
+};
+
+/**
+ * @brief Clock that only moves when told to
+ *
+ * Starts at the current real time (or at explicitly given time points)
+ * and advances only via advance()/set_*(). Both the steady and the system
+ * time move together on advance().
+ *
+ * Example usage:
+ *   auto clock = std::make_shared<ManualClock>();
+ *   TimeoutManager timeouts(std::chrono::seconds(30), clock);
+ *   timeouts.set_timeout(id, std::chrono::seconds(30), on_timeout);
+ *   clock->advance(std::chrono::seconds(31));
+ *   timeouts.check_timeouts();  // fires immediately
+ */
+class ManualClock : public Clock {
+public:
+    /// Start at the current real time
+    ManualClock() noexcept;
+
+    /// Start at the given time points
+    ManualClock(SteadyTimePoint steady, SystemTimePoint system) noexcept;
+
+    SteadyTimePoint steady_now() const noexcept override;
+    SystemTimePoint system_now() const noexcept override;
+
+    /**
+     * @brief Move both clocks forward
+     *
+     * @param delta Amount of time to advance (negative values are ignored)
+     */
+    void advance(std::chrono::nanoseconds delta) noexcept;
+
+    /// Set the steady time (may move backwards; use with care)
+    void set_steady(SteadyTimePoint t) noexcept;
+
+    /// Set the wall-clock time
+    void set_system(SystemTimePoint t) noexcept;
+
+private:
+    std::atomic<int64_t> steady_ns_;
+    std::atomic<int64_t> system_ns_;
+};
+
+} // namespace mcpp::util
+
+#endif // MCPP_UTIL_CLOCK_H
@@ -0,0 +1,164 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef MCPP_UTIL_CONCURRENCY_H
+#define MCPP_UTIL_CONCURRENCY_H
+
+#include <atomic>
+#include <string_view>
+
+#include "mcpp/util/instrumented_mutex.h"
+
+namespace mcpp::util {
+
+/**
+ * @brief True when mcpp is built with -DMCPP_SINGLE_THREADED=ON
+ *
+ * In single-threaded builds every component is assumed to be used from
+ * one thread (typically an async::Reactor thread), so internal locks
+ * compile to nothing and internal counters are plain integers.
+ */
+#if defined(MCPP_SINGLE_THREADED) && MCPP_SINGLE_THREADED
+inline constexpr bool SINGLE_THREADED = true;
+#else
+inline constexpr bool SINGLE_THREADED = false;
+#endif
+
+/**
+ * @brief Lockable that does nothing
+ *
+ * Used in place of a mutex when all access happens on one thread.
+ * Accepts a lock name so it is a drop-in for NamedMutex/InstrumentedMutex.
+ */
+class NullMutex {
+public:
+    constexpr NullMutex() noexcept = default;
+    constexpr explicit NullMutex(std::string_view) noexcept {}
+
+    NullMutex(const NullMutex&) = delete;
+    NullMutex& operator=(const NullMutex&) = delete;
+
+    constexpr void lock() noexcept {}
+    constexpr bool try_lock() noexcept { return true; }
+    constexpr void unlock() noexcept {}
+};
+
+/**
+ * @brief Non-atomic stand-in for std::atomic<T>
+ *
+ * Implements the subset of the std::atomic interface used by mcpp so
+ * single-threaded builds avoid locked instructions on hot paths. Memory
+ * order arguments are accepted and ignored.
+ */
+template<typename T>
+class PlainAtomic {
+public:
+    constexpr PlainAtomic() noexcept = default;
+    constexpr PlainAtomic(T value) noexcept : value_(value) {}
+
+    PlainAtomic(const PlainAtomic&) = delete;
+    PlainAtomic& operator=(const PlainAtomic&) = delete;
+
+    T load(std::memory_order = std::memory_order_seq_cst) const noexcept { return value_; }
+    void store(T value, std::memory_order = std::memory_order_seq_cst) noexcept { value_ = value; }
+
+    T exchange(T value, std::memory_order = std::memory_order_seq_cst) noexcept {
+        T old = value_;
+        value_ = value;
+        return old;
+    }
+
+    T fetch_add(T delta, std::memory_order = std::memory_order_seq_cst) noexcept {
+        T old = value_;
+        value_ += delta;
+        return old;
+    }
+
+    T fetch_sub(T delta, std::memory_order = std::memory_order_seq_cst) noexcept {
+        T old = value_;
+        value_ -= delta;
+        return old;
+    }
+
+    bool compare_exchange_strong(T& expected, T desired,
+                                 std::memory_order = std::memory_order_seq_cst) noexcept {
+        if (value_ == expected) {
+            value_ = desired;
+            return true;
+        }
+        expected = value_;
+        return false;
+    }
+
+    operator T() const noexcept { return value_; }
+
+private:
+    T value_{};
+};
+
+/**
+ * @brief Mutex type used by mcpp's internal components
+ *
+ * Selected at compile time:
+ * - MCPP_SINGLE_THREADED=ON:  NullMutex (no locking at all)
+ * - MCPP_INSTRUMENT_LOCKS=ON: InstrumentedMutex (wait/hold metrics)
+ * - otherwise:                NamedMutex (plain std::mutex)
+ */
+#if defined(MCPP_SINGLE_THREADED) && MCPP_SINGLE_THREADED
+using Mutex = NullMutex;
+#elif defined(MCPP_INSTRUMENT_LOCKS) && MCPP_INSTRUMENT_LOCKS
+using Mutex = InstrumentedMutex;
+#else
+using Mutex = NamedMutex;
+#endif
+
+/**
+ * @brief Mutex for state that a thread started by mcpp itself also touches
+ *
+ * Like Mutex, but still a real lock under MCPP_SINGLE_THREADED, where the
+ * "one thread" assumption does not hold for such state (e.g. RootsManager,
+ * written by the RootsWatcher thread).
+ */
+#if defined(MCPP_INSTRUMENT_LOCKS) && MCPP_INSTRUMENT_LOCKS
+using SharedStateMutex = InstrumentedMutex;
+#else
+using SharedStateMutex = NamedMutex;
+#endif
+
+/**
+ * @brief Atomic type used by mcpp's internal counters
+ *
+ * std::atomic<T> normally, PlainAtomic<T> in single-threaded builds.
+ */
+#if defined(MCPP_SINGLE_THREADED) && MCPP_SINGLE_THREADED
+template<typename T>
+using Atomic = PlainAtomic<T>;
+#else
+template<typename T>
+using Atomic = std::atomic<T>;
+#endif
+
+} // namespace mcpp::util
+
+#endif // MCPP_UTIL_CONCURRENCY_H
@@ -0,0 +1,187 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mcpp/util/cpu_counters.h"
+
+#include "mcpp/util/metrics.h"
+
+#include <ctime>
+
+#if defined(__linux__)
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+    #define MCPP_HAS_PERF_EVENTS 1
+#else
+    #define MCPP_HAS_PERF_EVENTS 0
+#endif
+
+namespace mcpp::util {
+
+namespace {
+
+uint64_t thread_cputime_ns() noexcept {
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+    timespec ts{};
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) {
+        return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull +
+               static_cast<uint64_t>(ts.tv_nsec);
+    }
+#endif
+    return 0;
+}
+
+#if MCPP_HAS_PERF_EVENTS
+
+int open_counter(uint32_t type, uint64_t config, int group_fd) noexcept {
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = group_fd == -1 ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+
+/**
+ * @brief perf event group owned by one thread
+ *
+ * Opened lazily on first use and closed when the thread exits.
+ */
+class PerfGroup {
+public:
+    PerfGroup() noexcept {
+        leader_ = open_counter(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK, -1);
+        if (leader_ < 0) {
+            return;
+        }
+        instructions_ = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, leader_);
+        if (instructions_ >= 0) {
+            cache_misses_ = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, leader_);
+            if (cache_misses_ < 0) {
+                close(instructions_);
+                instructions_ = -1;
+            }
+        }
+        ioctl(leader_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(leader_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+
+    ~PerfGroup() {
+        for (int fd : {cache_misses_, instructions_, leader_}) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+    }
+
+    PerfGroup(const PerfGroup&) = delete;
+    PerfGroup& operator=(const PerfGroup&) = delete;
+
+    bool available() const noexcept { return leader_ >= 0; }
+    bool hardware() const noexcept { return instructions_ >= 0; }
+
+    bool read(CpuSample& sample) const noexcept {
+        // PERF_FORMAT_GROUP layout: nr, then one value per event in
+        // the order they were added to the group
+        uint64_t values[4] = {};
+        ssize_t n = ::read(leader_, values, sizeof(values));
+        if (n < static_cast<ssize_t>(2 * sizeof(uint64_t))) {
+            return false;
+        }
+        sample.cpu_ns = values[1];
+        if (hardware() && values[0] >= 3) {
+            sample.instructions = values[2];
+            sample.cache_misses = values[3];
+            sample.hardware = true;
+        }
+        return true;
+    }
+
+private:
+    int leader_ = -1;
+    int instructions_ = -1;
+    int cache_misses_ = -1;
+};
+
+PerfGroup& thread_perf_group() noexcept {
+    thread_local PerfGroup group;
+    return group;
+}
+
+#endif // MCPP_HAS_PERF_EVENTS
+
+} // anonymous namespace
+
+// ============================================================================
+// ThreadCpuCounters
+// ============================================================================
+
+CpuSample ThreadCpuCounters::read() noexcept {
+    CpuSample sample;
+#if MCPP_HAS_PERF_EVENTS
+    auto& group = thread_perf_group();
+    if (group.available() && group.read(sample)) {
+        return sample;
+    }
+#endif
+    sample.cpu_ns = thread_cputime_ns();
+    return sample;
+}
+
+bool ThreadCpuCounters::hardware_available() noexcept {
+#if MCPP_HAS_PERF_EVENTS
+    return thread_perf_group().hardware();
+#else
+    return false;
+#endif
+}
+
+// ============================================================================
+// CpuScope
+// ============================================================================
+
+CpuScope::CpuScope(std::string metric_prefix) noexcept
+    : prefix_(std::move(metric_prefix))
+    , start_(ThreadCpuCounters::read()) {
+}
+
+CpuScope::~CpuScope() {
+    CpuSample end = ThreadCpuCounters::read();
+    auto& registry = MetricsRegistry::global();
+
+    registry.counter(prefix_ + ".calls").add();
+    registry.histogram(prefix_ + ".cpu_ns").record(
+        end.cpu_ns >= start_.cpu_ns ? end.cpu_ns - start_.cpu_ns : 0);
+
+    if (start_.hardware && end.hardware) {
+        registry.counter(prefix_ + ".instructions").add(end.instructions - start_.instructions);
+        registry.counter(prefix_ + ".cache_misses").add(end.cache_misses - start_.cache_misses);
+    }
+}
+
+} // namespace mcpp::util
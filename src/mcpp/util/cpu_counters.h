@@ -0,0 +1,121 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef MCPP_UTIL_CPU_COUNTERS_H
+#define MCPP_UTIL_CPU_COUNTERS_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace mcpp::util {
+
+/**
+ * @brief One reading of the calling thread's CPU counters
+ *
+ * Values are cumulative since the counters were opened for the thread;
+ * subtract two samples to get the cost of the code in between.
+ */
+struct CpuSample {
+    /// CPU time consumed by the thread in nanoseconds (task-clock)
+    uint64_t cpu_ns = 0;
+
+    /// Retired instructions (0 if hardware counters are unavailable)
+    uint64_t instructions = 0;
+
+    /// Last-level cache misses (0 if hardware counters are unavailable)
+    uint64_t cache_misses = 0;
+
+    /// True if instructions/cache_misses come from real PMU counters
+    bool hardware = false;
+};
+
+/**
+ * @brief Per-thread CPU and hardware performance counters
+ *
+ * On Linux, the first read() on a thread opens a perf_event_open group
+ * (task-clock, instructions, cache-misses) scoped to that thread and
+ * user space only, so it works with the default perf_event_paranoid
+ * setting. If hardware events are unavailable (VMs, containers without
+ * CAP_PERFMON) only task-clock is used; if perf events are unavailable
+ * entirely, cpu_ns falls back to clock_gettime(CLOCK_THREAD_CPUTIME_ID).
+ *
+ * Thread safety: read() only touches thread_local state.
+ */
+class ThreadCpuCounters {
+public:
+    /**
+     * @brief Read the calling thread's counters
+     */
+    static CpuSample read() noexcept;
+
+    /**
+     * @brief Whether hardware counters are available on the calling thread
+     */
+    static bool hardware_available() noexcept;
+};
+
+/**
+ * @brief RAII scope that charges its CPU cost to a named metric prefix
+ *
+ * On destruction, the counter deltas since construction are recorded in
+ * MetricsRegistry::global():
+ * - <prefix>.calls         counter
+ * - <prefix>.cpu_ns        histogram
+ * - <prefix>.instructions  counter (hardware counters only)
+ * - <prefix>.cache_misses  counter (hardware counters only)
+ *
+ * Example usage:
+ *   {
+ *       CpuScope scope("tool.search");
+ *       run_search();
+ *   }  // CPU time of run_search() is now in "tool.search.cpu_ns"
+ */
+class CpuScope {
+public:
+    /**
+     * @brief Start measuring
+     *
+     * @param metric_prefix Prefix for the recorded metrics
+     */
+    explicit CpuScope(std::string metric_prefix) noexcept;
+
+    /**
+     * @brief Stop measuring and record the deltas
+     */
+    ~CpuScope();
+
+    CpuScope(const CpuScope&) = delete;
+    CpuScope& operator=(const CpuScope&) = delete;
+    CpuScope(CpuScope&&) = delete;
+    CpuScope& operator=(CpuScope&&) = delete;
+
+private:
+    std::string prefix_;
+    CpuSample start_;
+};
+
+} // namespace mcpp::util
+
+#endif // MCPP_UTIL_CPU_COUNTERS_H
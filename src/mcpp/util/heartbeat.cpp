@@ -0,0 +1,244 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mcpp/util/heartbeat.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
+
+#include "mcpp/util/metrics.h"
+
+namespace mcpp::util {
+
+struct Heartbeat::State {
+    State(Options opts, PingFunction ping_fn, DeadCallback dead_fn)
+        : options(std::move(opts)),
+          ping(std::move(ping_fn)),
+          on_dead(std::move(dead_fn)),
+          srtt_gauge(MetricsRegistry::global().gauge(options.metrics_prefix + ".srtt_us")),
+          rttvar_gauge(MetricsRegistry::global().gauge(options.metrics_prefix + ".rttvar_us")),
+          last_rtt_gauge(MetricsRegistry::global().gauge(options.metrics_prefix + ".last_rtt_us")),
+          rtt_histogram(MetricsRegistry::global().histogram(options.metrics_prefix + ".rtt_us")),
+          pings_counter(MetricsRegistry::global().counter(options.metrics_prefix + ".pings")),
+          timeouts_counter(MetricsRegistry::global().counter(options.metrics_prefix + ".timeouts")),
+          dead_counter(MetricsRegistry::global().counter(options.metrics_prefix + ".dead")) {
+        if (!options.clock) {
+            options.clock = Clock::default_clock();
+        }
+        options.max_missed = std::max<uint32_t>(1, options.max_missed);
+        next_ping = options.clock->steady_now() + options.interval;
+    }
+
+    void on_pong(uint64_t seq) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!outstanding || seq != sequence) {
+            return;  // late pong for a ping already counted as missed
+        }
+        outstanding = false;
+        stats.missed = 0;
+        ++stats.pongs;
+
+        using std::chrono::microseconds;
+        const auto rtt = std::chrono::duration_cast<microseconds>(options.clock->steady_now() - sent_at);
+        if (!has_rtt) {
+            has_rtt = true;
+            stats.srtt = rtt;
+            stats.rttvar = rtt / 2;
+        } else {
+            const auto deviation = microseconds(std::abs((stats.srtt - rtt).count()));
+            stats.rttvar = (stats.rttvar * 3 + deviation) / 4;
+            stats.srtt = (stats.srtt * 7 + rtt) / 8;
+        }
+        stats.last_rtt = rtt;
+
+        srtt_gauge.set(stats.srtt.count());
+        rttvar_gauge.set(stats.rttvar.count());
+        last_rtt_gauge.set(rtt.count());
+        rtt_histogram.record(static_cast<uint64_t>(std::max<int64_t>(0, rtt.count())));
+    }
+
+    Options options;
+    PingFunction ping;
+    DeadCallback on_dead;
+
+    Gauge& srtt_gauge;
+    Gauge& rttvar_gauge;
+    Gauge& last_rtt_gauge;
+    Histogram& rtt_histogram;
+    Counter& pings_counter;
+    Counter& timeouts_counter;
+    Counter& dead_counter;
+
+    mutable std::mutex mutex;
+    Stats stats;
+    uint64_t sequence = 0;
+    bool outstanding = false;
+    bool has_rtt = false;
+    Clock::SteadyTimePoint sent_at{};
+    Clock::SteadyTimePoint next_ping{};
+
+    // Timer thread control. Kept here rather than in Heartbeat so a thread
+    // detached by stop() never touches the destroyed Heartbeat.
+    std::mutex thread_mutex;
+    std::condition_variable thread_cv;
+    bool running = false;
+    uint64_t generation = 0;  ///< Bumped by start(); retires detached threads
+};
+
+Heartbeat::Heartbeat(Options options, PingFunction ping, DeadCallback on_dead)
+    : state_(std::make_shared<State>(std::move(options), std::move(ping), std::move(on_dead))) {}
+
+Heartbeat::~Heartbeat() {
+    stop();
+}
+
+void Heartbeat::start() {
+    std::shared_ptr<State> state = state_;
+    std::lock_guard<std::mutex> lock(state->thread_mutex);
+    if (state->running) {
+        return;
+    }
+    state->running = true;
+    const uint64_t generation = ++state->generation;
+    // Wake often enough to notice an overdue pong promptly
+    const auto step = std::clamp(
+        std::min(state->options.interval, state->options.timeout) / 4,
+        std::chrono::milliseconds(10), std::chrono::milliseconds(1000));
+    thread_ = std::thread([state, step, generation] {
+        auto current = [&] { return state->running && state->generation == generation; };
+        std::unique_lock<std::mutex> lock(state->thread_mutex);
+        while (current()) {
+            lock.unlock();
+            run_tick(state);
+            lock.lock();
+            state->thread_cv.wait_for(lock, step, [&] { return !current(); });
+        }
+    });
+}
+
+void Heartbeat::stop() {
+    {
+        std::lock_guard<std::mutex> lock(state_->thread_mutex);
+        if (!state_->running) {
+            return;
+        }
+        state_->running = false;
+    }
+    state_->thread_cv.notify_all();
+    if (thread_.joinable()) {
+        // The dead callback may stop (or destroy) us from the timer thread
+        if (thread_.get_id() == std::this_thread::get_id()) {
+            thread_.detach();
+        } else {
+            thread_.join();
+        }
+    }
+}
+
+void Heartbeat::tick() {
+    run_tick(state_);
+}
+
+void Heartbeat::run_tick(const std::shared_ptr<State>& state) {
+    bool send = false;
+    bool dead = false;
+    uint64_t seq = 0;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (state->stats.dead) {
+            return;
+        }
+        const Clock::SteadyTimePoint now = state->options.clock->steady_now();
+        if (state->outstanding) {
+            if (now - state->sent_at < state->options.timeout) {
+                return;
+            }
+            state->outstanding = false;
+            ++state->stats.timeouts;
+            state->timeouts_counter.add();
+            if (++state->stats.missed >= state->options.max_missed) {
+                state->stats.dead = true;
+                state->dead_counter.add();
+                dead = true;
+            } else {
+                send = true;  // retry at once rather than after an interval
+            }
+        } else {
+            send = now >= state->next_ping;
+        }
+
+        if (send) {
+            seq = ++state->sequence;
+            state->outstanding = true;
+            state->sent_at = now;
+            state->next_ping = now + state->options.interval;
+            ++state->stats.pings;
+            state->pings_counter.add();
+        }
+    }
+
+    if (dead) {
+        if (state->on_dead) {
+            state->on_dead("peer did not answer " + std::to_string(state->options.max_missed) +
+                           " ping(s) within " + std::to_string(state->options.timeout.count()) + "ms");
+        }
+        return;
+    }
+    if (send && state->ping) {
+        std::weak_ptr<State> weak = state;
+        state->ping([weak, seq] {
+            if (auto alive = weak.lock()) {
+                alive->on_pong(seq);
+            }
+        });
+    }
+}
+
+void Heartbeat::on_activity() {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    if (!state_->outstanding) {
+        state_->next_ping = state_->options.clock->steady_now() + state_->options.interval;
+    }
+}
+
+void Heartbeat::reset() {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->outstanding = false;
+    state_->stats.missed = 0;
+    state_->stats.dead = false;
+    state_->has_rtt = false;
+    state_->stats.srtt = std::chrono::microseconds(0);
+    state_->stats.rttvar = std::chrono::microseconds(0);
+    state_->stats.last_rtt = std::chrono::microseconds(0);
+    state_->next_ping = state_->options.clock->steady_now() + state_->options.interval;
+}
+
+Heartbeat::Stats Heartbeat::stats() const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->stats;
+}
+
+} // namespace mcpp::util
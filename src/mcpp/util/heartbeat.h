@@ -0,0 +1,156 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef MCPP_UTIL_HEARTBEAT_H
+#define MCPP_UTIL_HEARTBEAT_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "mcpp/util/clock.h"
+
+namespace mcpp::util {
+
+/**
+ * @brief Keepalive pinger with RTT tracking and dead-peer detection
+ *
+ * Sends a ping through a caller-supplied function every Options::interval
+ * and expects the pong within Options::timeout. A missed pong is retried
+ * at once; after Options::max_missed consecutive misses the peer is
+ * declared dead and the dead callback runs (once, until reset()). A
+ * silent peer is therefore detected within about
+ * interval + max_missed * timeout rather than a request timeout.
+ *
+ * Round-trip times are smoothed as in RFC 6298 (SRTT with gain 1/8,
+ * RTTVAR with gain 1/4) and exported to MetricsRegistry::global():
+ * - "<prefix>.srtt_us", "<prefix>.rttvar_us" (jitter) and
+ *   "<prefix>.last_rtt_us" gauges
+ * - "<prefix>.rtt_us" histogram
+ * - "<prefix>.pings", "<prefix>.timeouts" and "<prefix>.dead" counters
+ *
+ * The owner wires it to a connection:
+ * ```cpp
+ * Heartbeat heartbeat(options,
+ *     [&](Heartbeat::Pong pong) { send_ping_request(std::move(pong)); },
+ *     [&](const std::string& reason) { fail_in_flight(reason); });
+ * heartbeat.start();
+ * // on every received message:
+ * heartbeat.on_activity();
+ * ```
+ * start() runs a timer thread; tests may instead call tick() with a
+ * ManualClock. The dead callback may stop or destroy the Heartbeat that
+ * invoked it: stop() called on the timer thread detaches it rather than
+ * joining.
+ *
+ * Thread safety: All methods are safe to call concurrently. The ping and
+ * dead callbacks run without internal locks held; a Pong may be invoked
+ * from any thread, even after the Heartbeat is destroyed.
+ */
+class Heartbeat {
+public:
+    /// Call when the pong (any response to the ping) arrives
+    using Pong = std::function<void()>;
+
+    /// Sends one ping; must arrange for @p pong to be called on reply
+    using PingFunction = std::function<void(Pong pong)>;
+
+    /// Called once when the peer is declared dead
+    using DeadCallback = std::function<void(const std::string& reason)>;
+
+    struct Options {
+        /// Time between pings on an idle connection
+        std::chrono::milliseconds interval{5000};
+        /// Time to wait for a pong before counting a miss
+        std::chrono::milliseconds timeout{2000};
+        /// Consecutive misses that mean the peer is dead
+        uint32_t max_missed = 2;
+        /// Metric name prefix
+        std::string metrics_prefix = "heartbeat";
+        /// Time source (nullptr = Clock::default_clock())
+        std::shared_ptr<Clock> clock;
+    };
+
+    struct Stats {
+        /// Smoothed round-trip time (0 until the first pong)
+        std::chrono::microseconds srtt{0};
+        /// Round-trip time variation (jitter)
+        std::chrono::microseconds rttvar{0};
+        /// Most recent round-trip time
+        std::chrono::microseconds last_rtt{0};
+        uint64_t pings = 0;
+        uint64_t pongs = 0;
+        uint64_t timeouts = 0;
+        /// Consecutive misses so far
+        uint32_t missed = 0;
+        bool dead = false;
+    };
+
+    Heartbeat(Options options, PingFunction ping, DeadCallback on_dead);
+
+    /// Calls stop()
+    ~Heartbeat();
+
+    // Non-copyable and non-movable
+    Heartbeat(const Heartbeat&) = delete;
+    Heartbeat& operator=(const Heartbeat&) = delete;
+    Heartbeat(Heartbeat&&) = delete;
+    Heartbeat& operator=(Heartbeat&&) = delete;
+
+    /// Start the timer thread (no-op if running)
+    void start();
+
+    /// Stop the timer thread
+    void stop();
+
+    /**
+     * @brief Run one step: count an overdue pong as missed, ping if due
+     *
+     * Called by the timer thread; callable directly when not started.
+     */
+    void tick();
+
+    /// Note inbound traffic; postpones the next ping on a busy connection
+    void on_activity();
+
+    /// Forget misses and RTT history and resume pinging (e.g. after reconnecting)
+    void reset();
+
+    /// @return Current statistics
+    Stats stats() const;
+
+private:
+    struct State;
+    static void run_tick(const std::shared_ptr<State>& state);
+
+    std::shared_ptr<State> state_;
+    std::thread thread_;
+};
+
+} // namespace mcpp::util
+
+#endif // MCPP_UTIL_HEARTBEAT_H
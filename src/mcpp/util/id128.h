@@ -0,0 +1,235 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef MCPP_UTIL_ID128_H
+#define MCPP_UTIL_ID128_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace mcpp::util {
+
+/**
+ * @brief 128-bit identifier kept in binary form
+ *
+ * Session and task IDs are compared, hashed and stored as two 64-bit
+ * words; text is produced only where an ID crosses the wire. Compared to
+ * a std::string key this saves the heap block a 32 or 36 character ID
+ * needs (it does not fit the small-string buffer) and turns lookups into
+ * two integer compares.
+ *
+ * Text forms, all lowercase and written through lookup tables into
+ * fixed-size buffers: 32 plain hex digits, the 8-4-4-4-12 UUID layout,
+ * and 26 RFC 4648 base32 characters (unpadded) where a shorter token is
+ * wanted. parse() accepts the two hex forms and rejects uppercase so
+ * that each ID has exactly one spelling.
+ */
+struct Id128 {
+    uint64_t hi = 0;  ///< Most significant 64 bits (first 16 hex digits)
+    uint64_t lo = 0;  ///< Least significant 64 bits
+
+    /// Characters written by write_hex()
+    static constexpr size_t HEX_LENGTH = 32;
+    /// Characters written by write_uuid()
+    static constexpr size_t UUID_LENGTH = 36;
+    /// Characters written by write_base32()
+    static constexpr size_t BASE32_LENGTH = 26;
+
+    /// @return true for the all-zero ID, used as "no ID"
+    constexpr bool is_nil() const noexcept { return hi == 0 && lo == 0; }
+
+    /**
+     * @brief Stamp RFC 4122 version 4 and variant bits onto random bits
+     */
+    constexpr Id128 as_uuid_v4() const noexcept {
+        return Id128{(hi & ~0xf000ULL) | 0x4000ULL,
+                     (lo & ~(0xcULL << 60)) | (0x8ULL << 60)};
+    }
+
+    /**
+     * @brief Write 32 lowercase hex digits (no terminator)
+     * @return Pointer past the last character written
+     */
+    char* write_hex(char* out) const noexcept {
+        out = write_word(out, hi, 16);
+        return write_word(out, lo, 16);
+    }
+
+    /**
+     * @brief Write the 8-4-4-4-12 UUID form (no terminator)
+     * @return Pointer past the last character written
+     */
+    char* write_uuid(char* out) const noexcept {
+        out = write_word(out, hi >> 32, 8);
+        *out++ = '-';
+        out = write_word(out, (hi >> 16) & 0xffff, 4);
+        *out++ = '-';
+        out = write_word(out, hi & 0xffff, 4);
+        *out++ = '-';
+        out = write_word(out, lo >> 48, 4);
+        *out++ = '-';
+        return write_word(out, lo & 0xffffffffffffULL, 12);
+    }
+
+    /**
+     * @brief Write 26 lowercase base32 characters (no terminator)
+     *
+     * The 128 bits are read most significant first, five at a time; the
+     * last character carries the final three bits.
+     *
+     * @return Pointer past the last character written
+     */
+    char* write_base32(char* out) const noexcept {
+        static constexpr char BASE32[] = "abcdefghijklmnopqrstuvwxyz234567";
+        uint64_t h = hi;
+        uint64_t l = lo;
+        out[BASE32_LENGTH - 1] = BASE32[(l & 0x7) << 2];
+        l = (l >> 3) | (h << 61);
+        h >>= 3;
+        for (size_t i = BASE32_LENGTH - 1; i-- > 0;) {
+            out[i] = BASE32[l & 0x1f];
+            l = (l >> 5) | (h << 59);
+            h >>= 5;
+        }
+        return out + BASE32_LENGTH;
+    }
+
+    /// @return 32 hex digit form
+    std::string to_hex() const {
+        std::string s(HEX_LENGTH, '\0');
+        write_hex(s.data());
+        return s;
+    }
+
+    /// @return UUID form
+    std::string to_uuid() const {
+        std::string s(UUID_LENGTH, '\0');
+        write_uuid(s.data());
+        return s;
+    }
+
+    /// @return Base32 form
+    std::string to_base32() const {
+        std::string s(BASE32_LENGTH, '\0');
+        write_base32(s.data());
+        return s;
+    }
+
+    /**
+     * @brief Parse either hex text form
+     * @return The ID, or std::nullopt if @p text is neither 32 lowercase
+     *         hex digits nor a lowercase UUID
+     */
+    static std::optional<Id128> parse(std::string_view text) noexcept {
+        char digits[HEX_LENGTH];
+        if (text.size() == HEX_LENGTH) {
+            for (size_t i = 0; i < HEX_LENGTH; ++i) {
+                digits[i] = text[i];
+            }
+        } else if (text.size() == UUID_LENGTH) {
+            size_t n = 0;
+            for (size_t i = 0; i < UUID_LENGTH; ++i) {
+                bool dash_slot = i == 8 || i == 13 || i == 18 || i == 23;
+                if (dash_slot != (text[i] == '-')) {
+                    return std::nullopt;
+                }
+                if (!dash_slot) {
+                    digits[n++] = text[i];
+                }
+            }
+        } else {
+            return std::nullopt;
+        }
+        Id128 id;
+        for (size_t i = 0; i < HEX_LENGTH; ++i) {
+            int v = hex_value(digits[i]);
+            if (v < 0) {
+                return std::nullopt;
+            }
+            uint64_t& word = i < 16 ? id.hi : id.lo;
+            word = (word << 4) | static_cast<uint64_t>(v);
+        }
+        return id;
+    }
+
+    friend constexpr bool operator==(const Id128& a, const Id128& b) noexcept {
+        return a.hi == b.hi && a.lo == b.lo;
+    }
+    friend constexpr bool operator!=(const Id128& a, const Id128& b) noexcept {
+        return !(a == b);
+    }
+    friend constexpr bool operator<(const Id128& a, const Id128& b) noexcept {
+        return a.hi != b.hi ? a.hi < b.hi : a.lo < b.lo;
+    }
+
+private:
+    /// Two hex digits per byte value, so a word is written a byte at a time
+    struct HexPairs {
+        char pairs[512];
+        constexpr HexPairs() : pairs() {
+            constexpr char hex[] = "0123456789abcdef";
+            for (int i = 0; i < 256; ++i) {
+                pairs[2 * i] = hex[i >> 4];
+                pairs[2 * i + 1] = hex[i & 0xf];
+            }
+        }
+    };
+
+    /// Low @p digits hex digits of @p value (digits is even)
+    static char* write_word(char* out, uint64_t value, int digits) noexcept {
+        static constexpr HexPairs HEX{};
+        for (int i = digits - 2; i >= 0; i -= 2) {
+            const char* pair = &HEX.pairs[2 * (value & 0xff)];
+            out[i] = pair[0];
+            out[i + 1] = pair[1];
+            value >>= 8;
+        }
+        return out + digits;
+    }
+
+    static constexpr int hex_value(char c) noexcept {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        return -1;
+    }
+};
+
+/**
+ * @brief Hash for unordered containers keyed by Id128
+ *
+ * IDs are random or contain random words, so mixing the halves is enough.
+ */
+struct Id128Hash {
+    size_t operator()(const Id128& id) const noexcept {
+        return static_cast<size_t>(id.lo ^ (id.hi * 0x9e3779b97f4a7c15ULL));
+    }
+};
+
+} // namespace mcpp::util
+
+#endif // MCPP_UTIL_ID128_H
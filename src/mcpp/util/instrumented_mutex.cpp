@@ -0,0 +1,79 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mcpp/util/instrumented_mutex.h"
+
+#include "mcpp/util/metrics.h"
+
+namespace mcpp::util {
+
+namespace {
+
+uint64_t elapsed_ns(std::chrono::steady_clock::time_point since,
+                    std::chrono::steady_clock::time_point now) {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now - since).count());
+}
+
+} // anonymous namespace
+
+InstrumentedMutex::InstrumentedMutex(std::string_view name)
+    : name_(name) {
+    auto& registry = MetricsRegistry::global();
+    std::string prefix = "lock." + name_ + ".";
+    wait_ns_ = &registry.histogram(prefix + "wait_ns");
+    hold_ns_ = &registry.histogram(prefix + "hold_ns");
+    acquired_ = &registry.counter(prefix + "acquired");
+    contended_ = &registry.counter(prefix + "contended");
+}
+
+void InstrumentedMutex::lock() {
+    if (!mutex_.try_lock()) {
+        auto start = Clock::now();
+        mutex_.lock();
+        acquired_at_ = Clock::now();
+        wait_ns_->record(elapsed_ns(start, acquired_at_));
+        contended_->add();
+    } else {
+        acquired_at_ = Clock::now();
+    }
+    acquired_->add();
+}
+
+bool InstrumentedMutex::try_lock() {
+    if (!mutex_.try_lock()) {
+        return false;
+    }
+    acquired_at_ = Clock::now();
+    acquired_->add();
+    return true;
+}
+
+void InstrumentedMutex::unlock() {
+    auto held = elapsed_ns(acquired_at_, Clock::now());
+    mutex_.unlock();
+    hold_ns_->record(held);
+}
+
+} // namespace mcpp::util
@@ -0,0 +1,113 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef MCPP_UTIL_INSTRUMENTED_MUTEX_H
+#define MCPP_UTIL_INSTRUMENTED_MUTEX_H
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace mcpp::util {
+
+class Counter;
+class Histogram;
+
+/**
+ * @brief std::mutex wrapper that records wait time, hold time and contention
+ *
+ * Each InstrumentedMutex reports into MetricsRegistry::global() under
+ * "lock.<name>.*":
+ * - wait_ns    histogram of time spent blocked in lock() (contended only)
+ * - hold_ns    histogram of time between lock() and unlock()
+ * - acquired   counter of successful acquisitions
+ * - contended  counter of acquisitions that had to block
+ *
+ * Instances sharing a name share metrics, so e.g. every RequestTracker in
+ * the process aggregates into "lock.core.request_tracker.*".
+ *
+ * The uncontended path is a try_lock() plus one clock read; the metric
+ * objects are resolved once in the constructor so lock()/unlock() never
+ * touch the registry.
+ *
+ * Satisfies Lockable, so it works with std::lock_guard, std::unique_lock
+ * and std::condition_variable_any.
+ *
+ * Thread safety: Same guarantees as std::mutex.
+ */
+class InstrumentedMutex {
+public:
+    /**
+     * @brief Construct a named mutex
+     *
+     * @param name Lock name used as metric prefix (e.g. "server.task_manager")
+     */
+    explicit InstrumentedMutex(std::string_view name);
+
+    InstrumentedMutex(const InstrumentedMutex&) = delete;
+    InstrumentedMutex& operator=(const InstrumentedMutex&) = delete;
+    InstrumentedMutex(InstrumentedMutex&&) = delete;
+    InstrumentedMutex& operator=(InstrumentedMutex&&) = delete;
+
+    /// Acquire the lock, recording wait time if contended
+    void lock();
+
+    /// Try to acquire the lock without blocking
+    bool try_lock();
+
+    /// Release the lock, recording hold time
+    void unlock();
+
+    /// Lock name as given at construction
+    const std::string& name() const noexcept { return name_; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    std::mutex mutex_;
+    std::string name_;
+    Histogram* wait_ns_;
+    Histogram* hold_ns_;
+    Counter* acquired_;
+    Counter* contended_;
+
+    /// Acquisition time; only read/written by the current holder
+    Clock::time_point acquired_at_{};
+};
+
+/**
+ * @brief Zero-overhead stand-in for InstrumentedMutex
+ *
+ * A std::mutex that accepts (and ignores) a lock name, so call sites can
+ * name their locks unconditionally.
+ */
+class NamedMutex : public std::mutex {
+public:
+    explicit NamedMutex(std::string_view) noexcept {}
+};
+
+} // namespace mcpp::util
+
+#endif // MCPP_UTIL_INSTRUMENTED_MUTEX_H
@@ -0,0 +1,94 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mcpp/util/json_writer.h"
+
+#include <array>
+#include <cstdint>
+
+#include <nlohmann/json.hpp>
+
+#include "mcpp/util/utf8.h"
+
+namespace mcpp::util {
+
+namespace {
+
+/// Escape sequence for each byte, or 0 if the byte is copied verbatim
+constexpr std::array<char, 256> make_escape_table() {
+    std::array<char, 256> table{};
+    for (int c = 0; c < 0x20; ++c) {
+        table[c] = 'u';
+    }
+    table['\b'] = 'b';
+    table['\f'] = 'f';
+    table['\n'] = 'n';
+    table['\r'] = 'r';
+    table['\t'] = 't';
+    table['"'] = '"';
+    table['\\'] = '\\';
+    return table;
+}
+
+constexpr std::array<char, 256> ESCAPES = make_escape_table();
+
+} // anonymous namespace
+
+void append_json_string(std::string& out, std::string_view value) {
+    if (!is_valid_utf8(value)) {
+        // Rare: let the DOM serializer substitute U+FFFD exactly as dump() would
+        out += nlohmann::json(std::string(value)).dump(-1, ' ', false,
+                                                       nlohmann::json::error_handler_t::replace);
+        return;
+    }
+    out.reserve(out.size() + value.size() + 2);
+    out.push_back('"');
+
+    const char* run = value.data();
+    const char* const end = value.data() + value.size();
+    for (const char* p = run; p != end; ++p) {
+        char escape = ESCAPES[static_cast<uint8_t>(*p)];
+        if (escape == 0) {
+            continue;
+        }
+        out.append(run, static_cast<size_t>(p - run));
+        run = p + 1;
+
+        out.push_back('\\');
+        if (escape == 'u') {
+            static constexpr char HEX[] = "0123456789abcdef";
+            auto byte = static_cast<uint8_t>(*p);
+            out.append("u00", 3);
+            out.push_back(HEX[byte >> 4]);
+            out.push_back(HEX[byte & 0x0F]);
+        } else {
+            out.push_back(escape);
+        }
+    }
+    out.append(run, static_cast<size_t>(end - run));
+
+    out.push_back('"');
+}
+
+} // namespace mcpp::util
@@ -0,0 +1,52 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef MCPP_UTIL_JSON_WRITER_H
+#define MCPP_UTIL_JSON_WRITER_H
+
+#include <string>
+#include <string_view>
+
+namespace mcpp::util {
+
+/**
+ * @brief Append a JSON string literal (quotes included) to @p out
+ *
+ * Escapes exactly the characters nlohmann::json::dump() escapes ('"', '\\'
+ * and control characters below 0x20), so output is byte-identical to the
+ * DOM serializer for valid UTF-8. Runs of characters that need no escaping
+ * are appended in bulk, which makes base64 payloads a single memcpy.
+ *
+ * The input is validated first (util::is_valid_utf8()); invalid sequences
+ * are replaced with U+FFFD as dump() does with error_handler_t::replace,
+ * so the output is always valid JSON.
+ *
+ * @param out Destination buffer
+ * @param value Unescaped string contents
+ */
+void append_json_string(std::string& out, std::string_view value);
+
+} // namespace mcpp::util
+
+#endif // MCPP_UTIL_JSON_WRITER_H
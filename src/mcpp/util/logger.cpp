@@ -144,7 +144,7 @@ void Logger::error(std::string_view message,
 }
 
 void Logger::set_level(Level level) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<Mutex> lock(mutex_);
     min_level_ = level;
 
 #if MCPP_HAS_SPDLOG
@@ -173,28 +173,28 @@ void Logger::set_level(Level level) {
 }
 
 Logger::Level Logger::level() const noexcept {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<Mutex> lock(mutex_);
     return min_level_;
 }
 
 void Logger::enable_payload_logging(bool enable, size_t max_size) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<Mutex> lock(mutex_);
     enable_payload_ = enable;
     max_payload_size_ = max_size;
 }
 
 bool Logger::payload_logging_enabled() const noexcept {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<Mutex> lock(mutex_);
     return enable_payload_;
 }
 
 size_t Logger::max_payload_size() const noexcept {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<Mutex> lock(mutex_);
     return max_payload_size_;
 }
 
 std::string Logger::format_payload(const nlohmann::json& payload) const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<Mutex> lock(mutex_);
 
     if (!enable_payload_) {
         return "(payload logging disabled)";
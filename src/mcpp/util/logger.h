@@ -35,6 +35,8 @@
 
 #include <nlohmann/json.hpp>
 
+#include "mcpp/util/concurrency.h"
+
 namespace mcpp::util {
 
 /**
@@ -271,7 +273,7 @@ private:
      */
     static std::string format_context(const std::map<std::string, std::string>& context);
 
-    mutable std::mutex mutex_;
+    mutable Mutex mutex_{"util.logger"};
     Level min_level_;
     bool enable_payload_;
     size_t max_payload_size_;
@@ -0,0 +1,146 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef MCPP_UTIL_LRU_CACHE_H
+#define MCPP_UTIL_LRU_CACHE_H
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace mcpp::util {
+
+/**
+ * @brief Fixed-capacity least-recently-used cache
+ *
+ * A doubly linked list keeps entries in recency order and a hash map
+ * indexes into it, so get() and put() are O(1). When the cache is full,
+ * put() evicts the least recently used entry.
+ *
+ * Thread safety: Not thread-safe. Callers sharing a cache across
+ * threads must guard it (see util::Mutex).
+ *
+ * @tparam Key Hashable key type
+ * @tparam Value Cached value type
+ */
+template<typename Key, typename Value, typename Hash = std::hash<Key>>
+class LruCache {
+public:
+    /**
+     * @brief Create a cache holding at most @p capacity entries
+     *
+     * A capacity of zero disables caching (put() is a no-op).
+     */
+    explicit LruCache(size_t capacity) : capacity_(capacity) {}
+
+    /**
+     * @brief Look up an entry and mark it most recently used
+     *
+     * @return Pointer to the cached value, or nullptr on miss. The pointer
+     *         is invalidated by the next put() or clear().
+     */
+    Value* get(const Key& key) {
+        auto it = index_.find(key);
+        if (it == index_.end()) {
+            ++misses_;
+            return nullptr;
+        }
+        entries_.splice(entries_.begin(), entries_, it->second);
+        ++hits_;
+        return &it->second->second;
+    }
+
+    /**
+     * @brief Insert or replace an entry, evicting the LRU entry if full
+     */
+    void put(Key key, Value value) {
+        if (capacity_ == 0) {
+            return;
+        }
+        auto it = index_.find(key);
+        if (it != index_.end()) {
+            it->second->second = std::move(value);
+            entries_.splice(entries_.begin(), entries_, it->second);
+            return;
+        }
+        if (entries_.size() >= capacity_) {
+            index_.erase(entries_.back().first);
+            entries_.pop_back();
+        }
+        entries_.emplace_front(std::move(key), std::move(value));
+        index_.emplace(entries_.front().first, entries_.begin());
+    }
+
+    /// Remove an entry if present
+    void erase(const Key& key) {
+        auto it = index_.find(key);
+        if (it != index_.end()) {
+            entries_.erase(it->second);
+            index_.erase(it);
+        }
+    }
+
+    /// @return The least recently used value, or nullptr if empty
+    const Value* oldest() const {
+        return entries_.empty() ? nullptr : &entries_.back().second;
+    }
+
+    /// Remove the least recently used entry (no-op if empty)
+    void pop_oldest() {
+        if (!entries_.empty()) {
+            index_.erase(entries_.back().first);
+            entries_.pop_back();
+        }
+    }
+
+    /// Remove all entries (hit/miss counters are kept)
+    void clear() {
+        index_.clear();
+        entries_.clear();
+    }
+
+    size_t size() const { return entries_.size(); }
+    size_t capacity() const { return capacity_; }
+
+    /// @return Number of get() calls that found an entry
+    size_t hits() const { return hits_; }
+
+    /// @return Number of get() calls that missed
+    size_t misses() const { return misses_; }
+
+private:
+    using Entry = std::pair<Key, Value>;
+
+    size_t capacity_;
+    std::list<Entry> entries_;
+    std::unordered_map<Key, typename std::list<Entry>::iterator, Hash> index_;
+    size_t hits_ = 0;
+    size_t misses_ = 0;
+};
+
+} // namespace mcpp::util
+
+#endif // MCPP_UTIL_LRU_CACHE_H
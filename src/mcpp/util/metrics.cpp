@@ -0,0 +1,170 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mcpp/util/metrics.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace mcpp::util {
+
+namespace {
+
+/// Look up or insert a metric of type T in one of the registry maps
+template<typename T>
+T& get_or_create(std::map<std::string, std::unique_ptr<T>, std::less<>>& map,
+                 std::string_view name) {
+    auto it = map.find(name);
+    if (it == map.end()) {
+        it = map.emplace(std::string(name), std::make_unique<T>()).first;
+    }
+    return *it->second;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Histogram
+// ============================================================================
+
+void Histogram::record(uint64_t value) noexcept {
+    buckets_[std::bit_width(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t prev = max_.load(std::memory_order_relaxed);
+    while (value > prev &&
+           !max_.compare_exchange_weak(prev, value, std::memory_order_relaxed)) {
+    }
+}
+
+uint64_t Histogram::percentile(double p) const noexcept {
+    uint64_t total = count();
+    if (total == 0) {
+        return 0;
+    }
+
+    // Rank of the requested observation (1-based)
+    auto rank = static_cast<uint64_t>(p / 100.0 * static_cast<double>(total));
+    if (rank == 0) {
+        rank = 1;
+    }
+
+    uint64_t seen = 0;
+    for (size_t b = 0; b < BUCKETS; ++b) {
+        seen += buckets_[b].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            uint64_t upper = b == 0 ? 0 : (b >= 64 ? UINT64_MAX : (uint64_t{1} << b) - 1);
+            return std::min(upper, max());
+        }
+    }
+    return max();
+}
+
+nlohmann::json Histogram::snapshot() const {
+    uint64_t n = count();
+    uint64_t s = sum();
+    return {
+        {"count", n},
+        {"sum", s},
+        {"mean", n == 0 ? 0.0 : static_cast<double>(s) / static_cast<double>(n)},
+        {"max", max()},
+        {"p50", percentile(50)},
+        {"p90", percentile(90)},
+        {"p99", percentile(99)}
+    };
+}
+
+void Histogram::reset() noexcept {
+    for (auto& bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+// ============================================================================
+// MetricsRegistry
+// ============================================================================
+
+MetricsRegistry& MetricsRegistry::global() {
+    static MetricsRegistry instance;
+    return instance;
+}
+
+Counter& MetricsRegistry::counter(std::string_view name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return get_or_create(counters_, name);
+}
+
+Gauge& MetricsRegistry::gauge(std::string_view name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return get_or_create(gauges_, name);
+}
+
+Histogram& MetricsRegistry::histogram(std::string_view name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return get_or_create(histograms_, name);
+}
+
+nlohmann::json MetricsRegistry::snapshot() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    nlohmann::json counters = nlohmann::json::object();
+    for (const auto& [name, c] : counters_) {
+        counters[name] = c->value();
+    }
+
+    nlohmann::json gauges = nlohmann::json::object();
+    for (const auto& [name, g] : gauges_) {
+        gauges[name] = g->value();
+    }
+
+    nlohmann::json histograms = nlohmann::json::object();
+    for (const auto& [name, h] : histograms_) {
+        histograms[name] = h->snapshot();
+    }
+
+    return {
+        {"counters", std::move(counters)},
+        {"gauges", std::move(gauges)},
+        {"histograms", std::move(histograms)}
+    };
+}
+
+void MetricsRegistry::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& [name, c] : counters_) {
+        c->reset();
+    }
+    for (auto& [name, g] : gauges_) {
+        g->reset();
+    }
+    for (auto& [name, h] : histograms_) {
+        h->reset();
+    }
+}
+
+} // namespace mcpp::util
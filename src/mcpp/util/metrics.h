@@ -0,0 +1,234 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef MCPP_UTIL_METRICS_H
+#define MCPP_UTIL_METRICS_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include <nlohmann/json.hpp>
+
+namespace mcpp::util {
+
+/**
+ * @brief Monotonically increasing counter
+ *
+ * Thread safety: All methods are lock-free and thread-safe.
+ */
+class Counter {
+public:
+    Counter() noexcept = default;
+
+    Counter(const Counter&) = delete;
+    Counter& operator=(const Counter&) = delete;
+
+    /// Add n to the counter (relaxed ordering)
+    void add(uint64_t n = 1) noexcept {
+        value_.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    /// Current value
+    uint64_t value() const noexcept {
+        return value_.load(std::memory_order_relaxed);
+    }
+
+    /// Reset to zero
+    void reset() noexcept { value_.store(0, std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> value_{0};
+};
+
+/**
+ * @brief Point-in-time value that can go up and down
+ *
+ * Thread safety: All methods are lock-free and thread-safe.
+ */
+class Gauge {
+public:
+    Gauge() noexcept = default;
+
+    Gauge(const Gauge&) = delete;
+    Gauge& operator=(const Gauge&) = delete;
+
+    /// Set the gauge to an absolute value
+    void set(int64_t v) noexcept { value_.store(v, std::memory_order_relaxed); }
+
+    /// Add a (possibly negative) delta
+    void add(int64_t delta) noexcept {
+        value_.fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    /// Current value
+    int64_t value() const noexcept {
+        return value_.load(std::memory_order_relaxed);
+    }
+
+    /// Reset to zero
+    void reset() noexcept { set(0); }
+
+private:
+    std::atomic<int64_t> value_{0};
+};
+
+/**
+ * @brief Lock-free log2-bucketed histogram
+ *
+ * Values are sorted into 65 power-of-two buckets (bucket b holds values
+ * in [2^(b-1), 2^b)), so recording is a handful of relaxed atomic adds.
+ * Percentiles reported by snapshot() are bucket upper bounds, which is
+ * accurate to within a factor of two - enough to tell a 200ns lock hold
+ * from a 20us one.
+ *
+ * Thread safety: record() is lock-free and thread-safe. snapshot() may
+ * observe a partially-applied concurrent record().
+ */
+class Histogram {
+public:
+    /// Number of buckets (bucket 0 holds the value 0)
+    static constexpr size_t BUCKETS = 65;
+
+    Histogram() noexcept = default;
+
+    Histogram(const Histogram&) = delete;
+    Histogram& operator=(const Histogram&) = delete;
+
+    /**
+     * @brief Record a single observation
+     *
+     * @param value Observed value (typically nanoseconds or bytes)
+     */
+    void record(uint64_t value) noexcept;
+
+    /// Total number of observations
+    uint64_t count() const noexcept {
+        return count_.load(std::memory_order_relaxed);
+    }
+
+    /// Sum of all observations
+    uint64_t sum() const noexcept {
+        return sum_.load(std::memory_order_relaxed);
+    }
+
+    /// Largest observation seen
+    uint64_t max() const noexcept {
+        return max_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Approximate percentile
+     *
+     * @param p Percentile in [0, 100]
+     * @return Upper bound of the bucket containing the percentile,
+     *         clamped to max(); 0 if the histogram is empty
+     */
+    uint64_t percentile(double p) const noexcept;
+
+    /**
+     * @brief Summary as JSON: count, sum, mean, max, p50, p90, p99
+     */
+    nlohmann::json snapshot() const;
+
+    /// Reset all buckets and totals to zero
+    void reset() noexcept;
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKETS> buckets_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> max_{0};
+};
+
+/**
+ * @brief Process-wide registry of named metrics
+ *
+ * Metrics are created on first lookup and live for the lifetime of the
+ * registry, so callers can cache the returned reference and update it on
+ * hot paths without touching the registry again. Names are dot-separated
+ * by convention (e.g. "lock.core.request_tracker.wait_ns").
+ *
+ * Thread safety: Lookups are mutex-protected; the returned metric objects
+ * are themselves lock-free. The registry mutex is a plain std::mutex so
+ * that instrumented locks can report into it without recursion.
+ *
+ * Example usage:
+ *   auto& calls = MetricsRegistry::global().counter("tool.echo.calls");
+ *   calls.add();
+ *   std::cout << MetricsRegistry::global().snapshot().dump(2);
+ */
+class MetricsRegistry {
+public:
+    /**
+     * @brief Get the process-wide registry
+     */
+    static MetricsRegistry& global();
+
+    MetricsRegistry() = default;
+
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+    MetricsRegistry(MetricsRegistry&&) = delete;
+    MetricsRegistry& operator=(MetricsRegistry&&) = delete;
+
+    /// Get or create a counter
+    Counter& counter(std::string_view name);
+
+    /// Get or create a gauge
+    Gauge& gauge(std::string_view name);
+
+    /// Get or create a histogram
+    Histogram& histogram(std::string_view name);
+
+    /**
+     * @brief Snapshot of every metric
+     *
+     * @return {"counters": {...}, "gauges": {...}, "histograms": {...}}
+     *         with names sorted lexicographically
+     */
+    nlohmann::json snapshot() const;
+
+    /**
+     * @brief Reset every metric to zero (metrics stay registered)
+     *
+     * Intended for benchmarks that want per-phase numbers.
+     */
+    void reset();
+
+private:
+    mutable std::mutex mutex_;
+    std::map<std::string, std::unique_ptr<Counter>, std::less<>> counters_;
+    std::map<std::string, std::unique_ptr<Gauge>, std::less<>> gauges_;
+    std::map<std::string, std::unique_ptr<Histogram>, std::less<>> histograms_;
+};
+
+} // namespace mcpp::util
+
+#endif // MCPP_UTIL_METRICS_H
@@ -0,0 +1,247 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mcpp/util/path_trie.h"
+
+namespace mcpp::util {
+
+namespace {
+
+int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+/// Call fn(component) for each non-empty component of a normalized path
+template<typename Fn>
+void for_each_component(std::string_view path, Fn&& fn) {
+    size_t pos = 1;  // skip leading '/'
+    while (pos < path.size()) {
+        size_t end = path.find('/', pos);
+        if (end == std::string_view::npos) end = path.size();
+        if (!fn(path.substr(pos, end - pos))) {
+            return;
+        }
+        pos = end + 1;
+    }
+}
+
+} // anonymous namespace
+
+std::optional<std::string> PathTrie::normalize(std::string_view path_or_uri) {
+    std::string decoded;
+    std::string_view path = path_or_uri;
+
+    if (path.rfind("file://", 0) == 0) {
+        path.remove_prefix(7);
+        // file://host/path: only empty host and "localhost" are local
+        if (path.rfind("localhost/", 0) == 0) {
+            path.remove_prefix(9);
+        }
+        decoded.reserve(path.size());
+        for (size_t i = 0; i < path.size(); ++i) {
+            if (path[i] == '%') {
+                if (i + 2 >= path.size()) return std::nullopt;
+                int hi = hex_value(path[i + 1]);
+                int lo = hex_value(path[i + 2]);
+                if (hi < 0 || lo < 0) return std::nullopt;
+                decoded.push_back(static_cast<char>(hi * 16 + lo));
+                i += 2;
+            } else {
+                decoded.push_back(path[i]);
+            }
+        }
+        path = decoded;
+    } else if (path.find("://") != std::string_view::npos) {
+        return std::nullopt;
+    }
+
+    if (path.empty() || path.front() != '/') {
+        return std::nullopt;
+    }
+
+    // Resolve "." and ".." lexically; ".." at the root stays at the root
+    std::vector<std::string_view> parts;
+    size_t pos = 0;
+    while (pos < path.size()) {
+        size_t end = path.find('/', pos);
+        if (end == std::string_view::npos) end = path.size();
+        std::string_view part = path.substr(pos, end - pos);
+        if (part == "..") {
+            if (!parts.empty()) parts.pop_back();
+        } else if (!part.empty() && part != ".") {
+            parts.push_back(part);
+        }
+        pos = end + 1;
+    }
+
+    std::string result;
+    result.reserve(path.size());
+    for (auto part : parts) {
+        result.push_back('/');
+        result.append(part);
+    }
+    if (result.empty()) {
+        result = "/";
+    }
+    return result;
+}
+
+std::string PathTrie::to_file_uri(std::string_view path) {
+    static const char hex[] = "0123456789ABCDEF";
+    std::string uri = "file://";
+    uri.reserve(uri.size() + path.size());
+    for (unsigned char c : path) {
+        bool unreserved = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                          (c >= '0' && c <= '9') || c == '-' || c == '.' ||
+                          c == '_' || c == '~' || c == '/';
+        if (unreserved) {
+            uri.push_back(static_cast<char>(c));
+        } else {
+            uri.push_back('%');
+            uri.push_back(hex[c >> 4]);
+            uri.push_back(hex[c & 0xF]);
+        }
+    }
+    return uri;
+}
+
+bool PathTrie::insert(std::string_view path_or_uri) {
+    auto normalized = normalize(path_or_uri);
+    if (!normalized) {
+        return false;
+    }
+    Node* node = &root_;
+    for_each_component(*normalized, [&](std::string_view part) {
+        auto it = node->children.find(part);
+        if (it == node->children.end()) {
+            it = node->children.emplace(std::string(part), std::make_unique<Node>()).first;
+        }
+        node = it->second.get();
+        return true;
+    });
+    if (node->is_root) {
+        return false;
+    }
+    node->is_root = true;
+    ++size_;
+    return true;
+}
+
+bool PathTrie::erase(std::string_view path_or_uri) {
+    auto normalized = normalize(path_or_uri);
+    if (!normalized) {
+        return false;
+    }
+    // Remember the path so empty branches can be pruned afterwards
+    std::vector<std::pair<Node*, std::string_view>> trail;
+    Node* node = &root_;
+    bool found = true;
+    for_each_component(*normalized, [&](std::string_view part) {
+        auto it = node->children.find(part);
+        if (it == node->children.end()) {
+            found = false;
+            return false;
+        }
+        trail.emplace_back(node, part);
+        node = it->second.get();
+        return true;
+    });
+    if (!found || !node->is_root) {
+        return false;
+    }
+    node->is_root = false;
+    --size_;
+
+    while (!trail.empty()) {
+        auto [parent, part] = trail.back();
+        trail.pop_back();
+        auto it = parent->children.find(part);
+        if (it->second->is_root || !it->second->children.empty()) {
+            break;
+        }
+        parent->children.erase(it);
+    }
+    return true;
+}
+
+void PathTrie::clear() {
+    root_.children.clear();
+    root_.is_root = false;
+    size_ = 0;
+}
+
+size_t PathTrie::deepest_root(std::string_view normalized) const {
+    const Node* node = &root_;
+    size_t depth = 0;
+    size_t best = root_.is_root ? 0 : std::string_view::npos;
+    for_each_component(normalized, [&](std::string_view part) {
+        auto it = node->children.find(part);
+        if (it == node->children.end()) {
+            return false;
+        }
+        node = it->second.get();
+        ++depth;
+        if (node->is_root) {
+            best = depth;
+        }
+        return true;
+    });
+    return best;
+}
+
+bool PathTrie::contains(std::string_view path_or_uri) const {
+    if (size_ == 0) {
+        return false;
+    }
+    auto normalized = normalize(path_or_uri);
+    return normalized && deepest_root(*normalized) != std::string_view::npos;
+}
+
+std::optional<std::string> PathTrie::root_for(std::string_view path_or_uri) const {
+    auto normalized = normalize(path_or_uri);
+    if (!normalized) {
+        return std::nullopt;
+    }
+    size_t depth = deepest_root(*normalized);
+    if (depth == std::string_view::npos) {
+        return std::nullopt;
+    }
+    if (depth == 0) {
+        return std::string("/");
+    }
+    // Cut the normalized path after `depth` components
+    size_t pos = 0;
+    for (size_t i = 0; i < depth; ++i) {
+        pos = normalized->find('/', pos + 1);
+        if (pos == std::string::npos) {
+            return normalized;
+        }
+    }
+    return normalized->substr(0, pos);
+}
+
+} // namespace mcpp::util
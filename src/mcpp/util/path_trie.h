@@ -0,0 +1,130 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef MCPP_UTIL_PATH_TRIE_H
+#define MCPP_UTIL_PATH_TRIE_H
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mcpp::util {
+
+/**
+ * @brief Set of directory roots with O(depth) containment checks
+ *
+ * Paths are normalized (file:// URIs decoded, "." and ".." resolved
+ * lexically, duplicate and trailing slashes removed) and split into
+ * components stored in a trie. contains() walks the query path one
+ * component at a time and succeeds as soon as it passes through a root,
+ * so the cost depends on path depth, not on the number of roots.
+ *
+ * Normalization is purely lexical: symlinks are not resolved, so callers
+ * enforcing a security boundary should realpath() first.
+ *
+ * Thread safety: Not thread-safe; const methods may run concurrently
+ * with each other.
+ */
+class PathTrie {
+public:
+    PathTrie() = default;
+    ~PathTrie() = default;
+
+    PathTrie(const PathTrie&) = delete;
+    PathTrie& operator=(const PathTrie&) = delete;
+    PathTrie(PathTrie&&) noexcept = default;
+    PathTrie& operator=(PathTrie&&) noexcept = default;
+
+    /**
+     * @brief Normalize an absolute path or file:// URI
+     *
+     * @param path_or_uri "/a/./b//c/../d", "file:///a/b%20c", ...
+     * @return Normalized absolute path ("/a/b/d"), or nullopt if the input
+     *         is relative, a non-file URI, or contains invalid escapes
+     */
+    static std::optional<std::string> normalize(std::string_view path_or_uri);
+
+    /**
+     * @brief Build a file:// URI for an absolute path
+     *
+     * Percent-encodes bytes outside the RFC 3986 unreserved set and "/".
+     */
+    static std::string to_file_uri(std::string_view path);
+
+    /**
+     * @brief Add a root
+     *
+     * @return false if the path cannot be normalized or is already present
+     */
+    bool insert(std::string_view path_or_uri);
+
+    /**
+     * @brief Remove a root
+     *
+     * @return false if the root was not present
+     */
+    bool erase(std::string_view path_or_uri);
+
+    /// Remove all roots
+    void clear();
+
+    /**
+     * @brief Whether a path is a root or lies beneath one
+     */
+    bool contains(std::string_view path_or_uri) const;
+
+    /**
+     * @brief The deepest root containing a path
+     *
+     * @return Normalized root path, or nullopt if no root contains it
+     */
+    std::optional<std::string> root_for(std::string_view path_or_uri) const;
+
+    /// @return Number of roots
+    size_t size() const { return size_; }
+
+    /// @return true if there are no roots
+    bool empty() const { return size_ == 0; }
+
+private:
+    struct Node {
+        bool is_root = false;
+        std::map<std::string, std::unique_ptr<Node>, std::less<>> children;
+    };
+
+    /// Deepest root node depth along the path, or npos
+    size_t deepest_root(std::string_view normalized) const;
+
+    Node root_;
+    size_t size_ = 0;
+};
+
+} // namespace mcpp::util
+
+#endif // MCPP_UTIL_PATH_TRIE_H
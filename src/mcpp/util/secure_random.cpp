@@ -0,0 +1,199 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mcpp/util/secure_random.h"
+
+#include <pthread.h>
+#include <sys/random.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <random>
+
+namespace mcpp::util {
+
+namespace {
+
+/// Bumped in the child after fork() so each thread rekeys there
+std::atomic<uint64_t> g_fork_generation{0};
+
+void register_fork_handler() {
+    static std::once_flag once;
+    std::call_once(once, [] {
+        ::pthread_atfork(nullptr, nullptr, [] {
+            g_fork_generation.fetch_add(1, std::memory_order_relaxed);
+        });
+    });
+}
+
+void kernel_random(void* out, size_t size) {
+    auto* p = static_cast<uint8_t*>(out);
+    while (size > 0) {
+        ssize_t n = ::getrandom(p, size, 0);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            // getrandom unavailable (pre-3.17 kernel or seccomp): the
+            // standard library still reads the kernel pool
+            std::random_device device;
+            for (; size > 0; --size) {
+                *p++ = static_cast<uint8_t>(device());
+            }
+            return;
+        }
+        p += n;
+        size -= static_cast<size_t>(n);
+    }
+}
+
+inline uint32_t rotl(uint32_t v, int n) {
+    return (v << n) | (v >> (32 - n));
+}
+
+inline void quarter_round(uint32_t& a, uint32_t& b, uint32_t& c, uint32_t& d) {
+    a += b; d ^= a; d = rotl(d, 16);
+    c += d; b ^= c; b = rotl(b, 12);
+    a += b; d ^= a; d = rotl(d, 8);
+    c += d; b ^= c; b = rotl(b, 7);
+}
+
+struct Generator {
+    uint32_t key[8] = {};
+    uint64_t counter = 0;
+    uint8_t buffer[SecureRandom::BATCH_BLOCKS * 64];
+    size_t pos = sizeof(buffer);  ///< Next unused byte in buffer
+    size_t since_reseed = 0;
+    uint64_t fork_generation = 0;
+    bool seeded = false;
+
+    ~Generator() {
+        wipe(key, sizeof(key));
+        wipe(buffer, sizeof(buffer));
+    }
+
+    static void wipe(void* p, size_t size) {
+        std::memset(p, 0, size);
+        // Keep the stores: the compiler may not assume nobody reads them
+        asm volatile("" : : "r"(p) : "memory");
+    }
+
+    void refill() {
+        if (!seeded || since_reseed >= SecureRandom::RESEED_BYTES) {
+            register_fork_handler();
+            kernel_random(key, sizeof(key));
+            counter = 0;
+            since_reseed = 0;
+            fork_generation = g_fork_generation.load(std::memory_order_relaxed);
+            seeded = true;
+        }
+        for (size_t i = 0; i < SecureRandom::BATCH_BLOCKS; ++i) {
+            SecureRandom::chacha20_block(key, counter++, 0, buffer + i * 64);
+        }
+        // Fast key erasure: the next key comes from this batch and is
+        // never handed out
+        std::memcpy(key, buffer, sizeof(key));
+        wipe(buffer, sizeof(key));
+        counter = 0;
+        pos = sizeof(key);
+        since_reseed += sizeof(buffer);
+    }
+
+    void fill(uint8_t* out, size_t size) {
+        if (fork_generation != g_fork_generation.load(std::memory_order_relaxed)) {
+            // Parent and child share this buffer and key: drop both
+            wipe(buffer, sizeof(buffer));
+            pos = sizeof(buffer);
+            seeded = false;
+        }
+        while (size > 0) {
+            if (pos == sizeof(buffer)) {
+                refill();
+            }
+            size_t n = std::min(size, sizeof(buffer) - pos);
+            std::memcpy(out, buffer + pos, n);
+            wipe(buffer + pos, n);
+            pos += n;
+            out += n;
+            size -= n;
+        }
+    }
+};
+
+Generator& generator() {
+    thread_local Generator instance;
+    return instance;
+}
+
+} // anonymous namespace
+
+void SecureRandom::chacha20_block(const uint32_t key[8], uint64_t counter, uint64_t nonce,
+                                  uint8_t out[64]) {
+    const uint32_t input[16] = {
+        0x61707865, 0x3320646e, 0x79622d32, 0x6b206574,  // "expand 32-byte k"
+        key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7],
+        static_cast<uint32_t>(counter), static_cast<uint32_t>(counter >> 32),
+        static_cast<uint32_t>(nonce), static_cast<uint32_t>(nonce >> 32),
+    };
+    uint32_t x[16];
+    std::memcpy(x, input, sizeof(x));
+    for (int i = 0; i < 10; ++i) {
+        quarter_round(x[0], x[4], x[8], x[12]);
+        quarter_round(x[1], x[5], x[9], x[13]);
+        quarter_round(x[2], x[6], x[10], x[14]);
+        quarter_round(x[3], x[7], x[11], x[15]);
+        quarter_round(x[0], x[5], x[10], x[15]);
+        quarter_round(x[1], x[6], x[11], x[12]);
+        quarter_round(x[2], x[7], x[8], x[13]);
+        quarter_round(x[3], x[4], x[9], x[14]);
+    }
+    for (int i = 0; i < 16; ++i) {
+        uint32_t v = x[i] + input[i];
+        out[4 * i] = static_cast<uint8_t>(v);
+        out[4 * i + 1] = static_cast<uint8_t>(v >> 8);
+        out[4 * i + 2] = static_cast<uint8_t>(v >> 16);
+        out[4 * i + 3] = static_cast<uint8_t>(v >> 24);
+    }
+}
+
+void SecureRandom::fill(void* out, size_t size) {
+    generator().fill(static_cast<uint8_t*>(out), size);
+}
+
+uint64_t SecureRandom::next_u64() {
+    uint64_t value;
+    fill(&value, sizeof(value));
+    return value;
+}
+
+Id128 SecureRandom::next_id128() {
+    uint64_t words[2];
+    fill(words, sizeof(words));
+    return Id128{words[0], words[1]};
+}
+
+} // namespace mcpp::util
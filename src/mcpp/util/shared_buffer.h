@@ -0,0 +1,135 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef MCPP_UTIL_SHARED_BUFFER_H
+#define MCPP_UTIL_SHARED_BUFFER_H
+
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace mcpp::util {
+
+/**
+ * @brief Immutable, reference-counted byte buffer
+ *
+ * Holds large payloads (base64 image/audio data, resource text and blobs)
+ * so they can travel from a handler through registries and into the
+ * serializer without being copied. Copying a SharedBuffer only bumps a
+ * reference count; the bytes are never modified after construction.
+ *
+ * Constructing from an rvalue std::string adopts its storage, so
+ *
+ *   content.data = std::move(base64);
+ *
+ * allocates nothing beyond the control block. Constructing from an lvalue
+ * string or a literal copies once.
+ *
+ * Access is through view() (or the implicit std::string_view conversion);
+ * str() makes an owned copy when one is really needed.
+ *
+ * Thread safety: Instances may be shared and read from any number of
+ * threads. Assigning to the same instance concurrently is not safe.
+ */
+class SharedBuffer {
+public:
+    /// Empty buffer (no allocation)
+    SharedBuffer() = default;
+
+    /// Adopt a string's storage (moved in) or copy an lvalue once.
+    /// Implicit so fields that used to be std::string keep their call sites.
+    SharedBuffer(std::string bytes) {
+        if (!bytes.empty()) {
+            bytes_ = std::make_shared<const std::string>(std::move(bytes));
+        }
+    }
+
+    /// Copy a NUL-terminated string
+    SharedBuffer(const char* bytes)
+        : SharedBuffer(std::string(bytes)) {}
+
+    /// Copy arbitrary bytes
+    static SharedBuffer copy_of(std::string_view bytes) {
+        return SharedBuffer(std::string(bytes));
+    }
+
+    /// @return View of the bytes; valid while any copy of this buffer lives
+    std::string_view view() const noexcept {
+        return bytes_ ? std::string_view(*bytes_) : std::string_view();
+    }
+
+    operator std::string_view() const noexcept { return view(); }
+
+    const char* data() const noexcept { return view().data(); }
+    size_t size() const noexcept { return bytes_ ? bytes_->size() : 0; }
+    bool empty() const noexcept { return size() == 0; }
+
+    std::string_view::const_iterator begin() const noexcept { return view().begin(); }
+    std::string_view::const_iterator end() const noexcept { return view().end(); }
+
+    /// @return Owned copy of the bytes
+    std::string str() const { return std::string(view()); }
+
+    /// @return Number of SharedBuffer instances sharing these bytes (0 if empty)
+    long use_count() const noexcept { return bytes_.use_count(); }
+
+    friend bool operator==(const SharedBuffer& a, const SharedBuffer& b) noexcept {
+        return a.bytes_ == b.bytes_ || a.view() == b.view();
+    }
+    friend bool operator==(const SharedBuffer& a, std::string_view b) noexcept {
+        return a.view() == b;
+    }
+    friend bool operator==(const SharedBuffer& a, const std::string& b) noexcept {
+        return a.view() == b;
+    }
+    friend bool operator==(const SharedBuffer& a, const char* b) noexcept {
+        return a.view() == b;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const SharedBuffer& buffer) {
+        return os << buffer.view();
+    }
+
+private:
+    std::shared_ptr<const std::string> bytes_;
+};
+
+/// nlohmann::json conversion (found by ADL); serializes as a JSON string
+template<typename BasicJsonType>
+void to_json(BasicJsonType& j, const SharedBuffer& buffer) {
+    j = buffer.view();
+}
+
+/// nlohmann::json conversion (found by ADL); requires a JSON string
+template<typename BasicJsonType>
+void from_json(const BasicJsonType& j, SharedBuffer& buffer) {
+    buffer = SharedBuffer(j.template get<std::string>());
+}
+
+} // namespace mcpp::util
+
+#endif // MCPP_UTIL_SHARED_BUFFER_H
@@ -0,0 +1,112 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mcpp/util/timestamp.h"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace mcpp::util {
+
+namespace {
+
+constexpr size_t SECOND_LENGTH = 19;  ///< "YYYY-MM-DDTHH:MM:SS"
+
+inline void write2(char* out, unsigned value) {
+    out[0] = static_cast<char>('0' + value / 10);
+    out[1] = static_cast<char>('0' + value % 10);
+}
+
+/// Floor division, so times before 1970 land on the right day
+inline int64_t floor_div(int64_t a, int64_t b) {
+    int64_t q = a / b;
+    return (a % b != 0 && (a < 0) != (b < 0)) ? q - 1 : q;
+}
+
+/// Render "YYYY-MM-DDTHH:MM:SS" for seconds since the Unix epoch
+void render_second(int64_t seconds, char* out) {
+    int64_t days = floor_div(seconds, 86400);
+    int64_t of_day = seconds - days * 86400;
+
+    // Civil date from days since 1970-01-01 (proleptic Gregorian; see
+    // H. Hinnant, "chrono-Compatible Low-Level Date Algorithms")
+    int64_t z = days + 719468;
+    int64_t era = floor_div(z, 146097);
+    int64_t doe = z - era * 146097;
+    int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int64_t mp = (5 * doy + 2) / 153;
+    unsigned day = static_cast<unsigned>(doy - (153 * mp + 2) / 5 + 1);
+    unsigned month = static_cast<unsigned>(mp < 10 ? mp + 3 : mp - 9);
+    int64_t year = yoe + era * 400 + (month <= 2 ? 1 : 0);
+    unsigned y = static_cast<unsigned>(year < 0 ? 0 : (year > 9999 ? 9999 : year));
+
+    write2(out, y / 100);
+    write2(out + 2, y % 100);
+    out[4] = '-';
+    write2(out + 5, month);
+    out[7] = '-';
+    write2(out + 8, day);
+    out[10] = 'T';
+    write2(out + 11, static_cast<unsigned>(of_day / 3600));
+    out[13] = ':';
+    write2(out + 14, static_cast<unsigned>(of_day / 60 % 60));
+    out[16] = ':';
+    write2(out + 17, static_cast<unsigned>(of_day % 60));
+}
+
+struct SecondCache {
+    int64_t second = std::numeric_limits<int64_t>::min();
+    char text[SECOND_LENGTH];
+};
+
+} // anonymous namespace
+
+char* write_iso8601(std::chrono::system_clock::time_point time, char* out) noexcept {
+    int64_t ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        time.time_since_epoch()).count();
+    int64_t second = floor_div(ms, 1000);
+    unsigned millis = static_cast<unsigned>(ms - second * 1000);
+
+    thread_local SecondCache cache;
+    if (cache.second != second) {
+        render_second(second, cache.text);
+        cache.second = second;
+    }
+    std::memcpy(out, cache.text, SECOND_LENGTH);
+    out[19] = '.';
+    out[20] = static_cast<char>('0' + millis / 100);
+    write2(out + 21, millis % 100);
+    out[23] = 'Z';
+    return out + ISO8601_LENGTH;
+}
+
+std::string format_iso8601(std::chrono::system_clock::time_point time) {
+    char buf[ISO8601_LENGTH];
+    write_iso8601(time, buf);
+    return std::string(buf, ISO8601_LENGTH);
+}
+
+} // namespace mcpp::util
@@ -0,0 +1,61 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef MCPP_UTIL_TIMESTAMP_H
+#define MCPP_UTIL_TIMESTAMP_H
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+namespace mcpp::util {
+
+/// Characters written by write_iso8601(): "YYYY-MM-DDTHH:MM:SS.mmmZ"
+inline constexpr size_t ISO8601_LENGTH = 24;
+
+/**
+ * @brief Write a UTC ISO 8601 timestamp with millisecond precision
+ *
+ * Allocation-free and thread-safe (no gmtime). Each thread caches the
+ * rendered "YYYY-MM-DDTHH:MM:SS" of the last second it formatted, so
+ * timestamps within the same second only append the milliseconds; the
+ * date is recomputed from days since the epoch when the second changes.
+ * Years 0000-9999 are supported.
+ *
+ * @param time Wall-clock time to format (truncated to milliseconds)
+ * @param out Buffer of at least ISO8601_LENGTH bytes (no terminator written)
+ * @return Pointer past the last character written
+ */
+char* write_iso8601(std::chrono::system_clock::time_point time, char* out) noexcept;
+
+/**
+ * @brief Format a UTC ISO 8601 timestamp with millisecond precision
+ *
+ * @return Timestamp such as "2025-01-31T12:34:56.789Z"
+ */
+std::string format_iso8601(std::chrono::system_clock::time_point time);
+
+} // namespace mcpp::util
+
+#endif // MCPP_UTIL_TIMESTAMP_H
@@ -0,0 +1,190 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mcpp/util/utf8.h"
+
+#include <cstdint>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define MCPP_UTF8_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define MCPP_UTF8_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace mcpp::util {
+
+namespace {
+
+/**
+ * @brief Validate one code point starting at @p p
+ *
+ * @return Pointer past the code point, or nullptr if it is malformed
+ */
+inline const uint8_t* next_code_point(const uint8_t* p, const uint8_t* end) noexcept {
+    uint8_t b0 = p[0];
+    if (b0 < 0x80) {
+        return p + 1;
+    }
+    auto is_cont = [](uint8_t b) { return (b & 0xC0) == 0x80; };
+
+    if (b0 < 0xC2) {
+        // Continuation byte or overlong 2-byte lead
+        return nullptr;
+    }
+    if (b0 < 0xE0) {
+        if (end - p < 2 || !is_cont(p[1])) {
+            return nullptr;
+        }
+        return p + 2;
+    }
+    if (b0 < 0xF0) {
+        if (end - p < 3 || !is_cont(p[1]) || !is_cont(p[2])) {
+            return nullptr;
+        }
+        if ((b0 == 0xE0 && p[1] < 0xA0) ||   // overlong
+            (b0 == 0xED && p[1] > 0x9F)) {   // surrogate
+            return nullptr;
+        }
+        return p + 3;
+    }
+    if (b0 < 0xF5) {
+        if (end - p < 4 || !is_cont(p[1]) || !is_cont(p[2]) || !is_cont(p[3])) {
+            return nullptr;
+        }
+        if ((b0 == 0xF0 && p[1] < 0x90) ||   // overlong
+            (b0 == 0xF4 && p[1] > 0x8F)) {   // above U+10FFFF
+            return nullptr;
+        }
+        return p + 4;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Validate code points until @p p reaches @p until (or beyond)
+ *
+ * A sequence may straddle @p until; it is validated in full.
+ *
+ * @return Pointer where validation stopped, or nullptr on malformed input
+ */
+inline const uint8_t* validate_until(const uint8_t* p, const uint8_t* until, const uint8_t* end) noexcept {
+    while (p < until) {
+        p = next_code_point(p, end);
+        if (p == nullptr) {
+            return nullptr;
+        }
+    }
+    return p;
+}
+
+#if defined(MCPP_UTF8_X86)
+
+bool validate_sse2(const uint8_t* p, const uint8_t* end) noexcept {
+    while (end - p >= 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        if (_mm_movemask_epi8(chunk) == 0) {
+            p += 16;
+            continue;
+        }
+        p = validate_until(p, p + 16, end);
+        if (p == nullptr) {
+            return false;
+        }
+    }
+    return validate_until(p, end, end) != nullptr;
+}
+
+__attribute__((target("avx2")))
+bool validate_avx2(const uint8_t* p, const uint8_t* end) noexcept {
+    while (end - p >= 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        if (_mm256_movemask_epi8(chunk) == 0) {
+            p += 32;
+            continue;
+        }
+        p = validate_until(p, p + 32, end);
+        if (p == nullptr) {
+            return false;
+        }
+    }
+    return validate_sse2(p, end);
+}
+
+bool has_avx2() noexcept {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+
+#elif defined(MCPP_UTF8_NEON)
+
+bool validate_neon(const uint8_t* p, const uint8_t* end) noexcept {
+    while (end - p >= 16) {
+        uint8x16_t chunk = vld1q_u8(p);
+        if (vmaxvq_u8(chunk) < 0x80) {
+            p += 16;
+            continue;
+        }
+        p = validate_until(p, p + 16, end);
+        if (p == nullptr) {
+            return false;
+        }
+    }
+    return validate_until(p, end, end) != nullptr;
+}
+
+#endif
+
+} // anonymous namespace
+
+bool is_valid_utf8_scalar(std::string_view bytes) noexcept {
+    const auto* p = reinterpret_cast<const uint8_t*>(bytes.data());
+    const auto* end = p + bytes.size();
+    return validate_until(p, end, end) != nullptr;
+}
+
+bool is_valid_utf8(std::string_view bytes) noexcept {
+    const auto* p = reinterpret_cast<const uint8_t*>(bytes.data());
+    const auto* end = p + bytes.size();
+#if defined(MCPP_UTF8_X86)
+    return has_avx2() ? validate_avx2(p, end) : validate_sse2(p, end);
+#elif defined(MCPP_UTF8_NEON)
+    return validate_neon(p, end);
+#else
+    return validate_until(p, end, end) != nullptr;
+#endif
+}
+
+const char* utf8_backend() noexcept {
+#if defined(MCPP_UTF8_X86)
+    return has_avx2() ? "avx2" : "sse2";
+#elif defined(MCPP_UTF8_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+} // namespace mcpp::util
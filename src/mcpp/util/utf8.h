@@ -0,0 +1,65 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef MCPP_UTIL_UTF8_H
+#define MCPP_UTIL_UTF8_H
+
+#include <string_view>
+
+namespace mcpp::util {
+
+/**
+ * @brief Check that a byte string is well-formed UTF-8 (RFC 3629)
+ *
+ * Rejects overlong encodings, surrogates (U+D800..U+DFFF), code points
+ * above U+10FFFF and truncated sequences.
+ *
+ * ASCII runs are skipped 16 or 32 bytes at a time with SIMD (AVX2 when
+ * the CPU supports it, else SSE2 on x86-64, NEON on AArch64); only
+ * blocks containing non-ASCII bytes are decoded with the scalar checker.
+ * JSON-RPC traffic is overwhelmingly ASCII, so this is typically several
+ * times faster than byte-by-byte validation.
+ *
+ * @param bytes Input to validate
+ * @return true if @p bytes is valid UTF-8
+ */
+bool is_valid_utf8(std::string_view bytes) noexcept;
+
+/**
+ * @brief Scalar reference implementation of is_valid_utf8()
+ *
+ * Exposed for tests and benchmarks.
+ */
+bool is_valid_utf8_scalar(std::string_view bytes) noexcept;
+
+/**
+ * @brief Name of the implementation is_valid_utf8() dispatches to
+ *
+ * @return "avx2", "sse2", "neon" or "scalar"
+ */
+const char* utf8_backend() noexcept;
+
+} // namespace mcpp::util
+
+#endif // MCPP_UTIL_UTF8_H
@@ -7,10 +7,20 @@
 #ifndef MCPP_TESTS_FIXTURES_COMMON_H
 #define MCPP_TESTS_FIXTURES_COMMON_H
 
+#include "mcpp/protocol/initialize.h"
+#include "mcpp/transport/transport.h"
+
 #include <gtest/gtest.h>
 #include <nlohmann/json.hpp>
+#include <atomic>
 #include <string>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace mcpp::test {
 
@@ -70,6 +80,152 @@ private:
     std::chrono::steady_clock::time_point start_time;
 };
 
+// Poll pred until it holds or timeout passes; returns the final verdict
+template <typename Pred>
+bool eventually(Pred pred, std::chrono::milliseconds timeout = std::chrono::milliseconds(2000)) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (pred()) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return pred();
+}
+
+// What every incarnation of a FakeServerTransport saw, and how it behaves
+struct FakeServerState {
+    std::mutex mutex;
+    std::vector<std::vector<nlohmann::json>> received;  // per connection
+    bool answer_requests = true;
+    bool refuse_connections = false;
+    std::atomic<bool> answer_pings{true};
+    std::atomic<int> pings{0};
+
+    std::vector<nlohmann::json> connection(size_t index) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return index < received.size() ? received[index] : std::vector<nlohmann::json>{};
+    }
+};
+
+// In-process stand-in for an MCP server: answers initialize with a minimal
+// result and every other request with an empty one from its own thread,
+// like a real child process would, and can be killed
+class FakeServerTransport : public transport::Transport {
+public:
+    explicit FakeServerTransport(std::shared_ptr<FakeServerState> state)
+        : state_(std::move(state)) {}
+
+    ~FakeServerTransport() override { disconnect(); }
+
+    bool connect() override {
+        {
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            if (state_->refuse_connections) {
+                return false;
+            }
+            index_ = state_->received.size();
+            state_->received.emplace_back();
+        }
+        running_ = true;
+        worker_ = std::thread([this]() { run(); });
+        return true;
+    }
+
+    void disconnect() override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            running_ = false;
+        }
+        cv_.notify_all();
+        if (worker_.joinable() && worker_.get_id() != std::this_thread::get_id()) {
+            worker_.join();
+        }
+    }
+
+    bool is_connected() const override { return running_; }
+
+    bool send(std::string_view message) override {
+        if (!running_) {
+            return false;
+        }
+        auto request = nlohmann::json::parse(message);
+        bool answer;
+        {
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            state_->received[index_].push_back(request);
+            answer = state_->answer_requests;
+        }
+        if (!request.contains("id") || !request.contains("method")) {
+            return true;
+        }
+        if (request["method"] == "ping") {
+            ++state_->pings;
+            answer = answer && state_->answer_pings;
+        }
+        if (!answer) {
+            return true;
+        }
+        nlohmann::json reply = {{"jsonrpc", "2.0"}, {"id", request["id"]}};
+        if (request["method"] == "initialize") {
+            reply["result"] = {{"protocolVersion", protocol::PROTOCOL_VERSION},
+                               {"capabilities", nlohmann::json::object()},
+                               {"serverInfo", {{"name", "fake"}, {"version", "1.0"}}}};
+        } else {
+            reply["result"] = nlohmann::json::object();
+        }
+        push(reply.dump());
+        return true;
+    }
+
+    void set_message_callback(MessageCallback cb) override { on_message_ = std::move(cb); }
+    void set_error_callback(ErrorCallback cb) override { on_error_ = std::move(cb); }
+
+    // Simulate the server process exiting
+    void kill() { push(""); }
+
+private:
+    void push(std::string message) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            replies_.push_back(std::move(message));
+        }
+        cv_.notify_one();
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            cv_.wait(lock, [this]() { return !replies_.empty() || !running_; });
+            if (!running_) {
+                return;
+            }
+            std::string reply = std::move(replies_.front());
+            replies_.pop_front();
+            lock.unlock();
+            if (reply.empty()) {
+                running_ = false;
+                if (on_error_) {
+                    on_error_("server exited");
+                }
+                return;
+            }
+            on_message_(reply);
+            lock.lock();
+        }
+    }
+
+    std::shared_ptr<FakeServerState> state_;
+    size_t index_ = 0;
+    std::atomic<bool> running_{false};
+    std::thread worker_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::string> replies_;
+    MessageCallback on_message_;
+    ErrorCallback on_error_;
+};
+
 } // namespace mcpp::test
 
 #endif // MCPP_TESTS_FIXTURES_COMMON_H
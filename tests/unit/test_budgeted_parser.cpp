@@ -0,0 +1,232 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+#include "mcpp/core/budgeted_parser.h"
+#include "mcpp/client.h"
+#include "mcpp/server/mcp_server.h"
+#include "mcpp/util/metrics.h"
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace mcpp;
+
+namespace {
+
+/// Keeps what the client sends and lets the test inject replies
+class CaptureTransport : public transport::Transport {
+public:
+    bool connect() override { return true; }
+    void disconnect() override {}
+    bool is_connected() const override { return true; }
+    bool send(std::string_view message) override {
+        sent.emplace_back(message);
+        return true;
+    }
+    void set_message_callback(MessageCallback cb) override { on_message = std::move(cb); }
+    void set_error_callback(ErrorCallback) override {}
+
+    std::vector<std::string> sent;
+    MessageCallback on_message;
+};
+
+std::string array_of(size_t n) {
+    std::string s = "[";
+    for (size_t i = 0; i < n; ++i) {
+        s += (i ? ",1" : "1");
+    }
+    return s + "]";
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// BudgetedParser
+// ============================================================================
+
+TEST(BudgetedParserTest, BuildsSameDomAsNlohmann) {
+    const std::string frame = R"({"jsonrpc":"2.0","id":7,"method":"tools/call",)"
+        R"("params":{"name":"x","arguments":{"a":[1,-2,3.5,true,null,"s"],"b":{},"c":[],"a2":18446744073709551615}}})";
+    core::BudgetedParser parser;
+    auto outcome = parser.parse(frame);
+    ASSERT_TRUE(outcome.ok());
+    EXPECT_EQ(*outcome.message, nlohmann::json::parse(frame));
+    EXPECT_EQ(outcome.id, 7);
+    EXPECT_EQ(outcome.method, "tools/call");
+}
+
+TEST(BudgetedParserTest, MalformedJsonIsParseError) {
+    core::BudgetedParser parser;
+    for (const char* frame : {"", "{", R"({"id":1,})", "[1] trailing"}) {
+        auto outcome = parser.parse(frame);
+        EXPECT_FALSE(outcome.ok()) << frame;
+        EXPECT_EQ(outcome.error.code, core::PARSE_ERROR) << frame;
+    }
+}
+
+TEST(BudgetedParserTest, EnforcesEachLimit) {
+    core::ParseBudget budget;
+    budget.max_string_bytes = 8;
+    budget.max_array_elements = 4;
+    budget.max_object_members = 3;
+    budget.max_nodes = 20;
+    budget.max_depth = 3;
+    core::BudgetedParser parser(budget);
+
+    auto reason = [&](const std::string& frame) {
+        auto outcome = parser.parse(frame);
+        EXPECT_FALSE(outcome.ok()) << frame;
+        EXPECT_EQ(outcome.error.code, core::INVALID_REQUEST);
+        return outcome.error.data.value_or(nullptr).get<std::string>();
+    };
+
+    EXPECT_EQ(reason(R"({"a":"123456789"})"), "string exceeds max_string_bytes");
+    EXPECT_EQ(reason(R"({"123456789":1})"), "string exceeds max_string_bytes");
+    EXPECT_EQ(reason(array_of(5)), "array exceeds max_array_elements");
+    EXPECT_EQ(reason(R"({"a":1,"b":2,"c":3,"d":4})"), "object exceeds max_object_members");
+    EXPECT_EQ(reason("[[[[1]]]]"), "message exceeds max_depth");
+    EXPECT_EQ(reason("[[1,1,1,1],[1,1,1,1],[1,1,1,1],[1,1,1,1],[1,1]]"), "message exceeds max_nodes");
+
+    EXPECT_TRUE(parser.parse(array_of(4)).ok());
+}
+
+TEST(BudgetedParserTest, AppliesMethodBudgetEvenWhenParamsComeFirst) {
+    core::ParseBudget strict;
+    strict.max_array_elements = 2;
+    core::BudgetedParser parser;
+    parser.set_budget("ping", strict);
+
+    // params are parsed under the envelope budget, then re-checked
+    auto outcome = parser.parse(R"({"params":{"x":[1,2,3]},"id":"r1","method":"ping","jsonrpc":"2.0"})");
+    ASSERT_FALSE(outcome.ok());
+    EXPECT_EQ(outcome.error.code, core::INVALID_REQUEST);
+    EXPECT_EQ(outcome.id, "r1");
+    EXPECT_EQ(outcome.method, "ping");
+
+    // Once the method is known, the strict budget stops the parse early
+    outcome = parser.parse(R"({"id":2,"method":"ping","params":{"x":[1,2,3]}})");
+    EXPECT_FALSE(outcome.ok());
+
+    // Other methods keep the default budget
+    EXPECT_TRUE(parser.parse(R"({"id":3,"method":"tools/list","params":{"x":[1,2,3]}})").ok());
+
+    auto response = nlohmann::json::parse(parser.parse(R"({"id":2,"method":"ping","params":[1,2,3]})").error_response());
+    EXPECT_EQ(response["id"], 2);
+    EXPECT_EQ(response["error"]["code"], -32600);
+}
+
+TEST(BudgetedParserTest, FindsIdAndMethodAfterTheViolation) {
+    core::ParseBudget budget;
+    budget.max_string_bytes = 8;
+    core::BudgetedParser parser(budget);
+
+    // The nested "id" must not be mistaken for the envelope's
+    auto outcome = parser.parse(
+        R"({"jsonrpc":"2.0","params":{"a":"123456789","b":[{"id":99}]},"method":"tools/call","id":7})");
+    ASSERT_FALSE(outcome.ok());
+    EXPECT_EQ(outcome.error.code, core::INVALID_REQUEST);
+    EXPECT_EQ(outcome.error.data, nlohmann::json("string exceeds max_string_bytes"));
+    EXPECT_EQ(outcome.id, 7);
+    EXPECT_EQ(outcome.method, "tools/call");
+
+    // Violations that open a container are skimmed at the right depth too
+    budget.max_depth = 2;
+    core::BudgetedParser shallow(budget);
+    outcome = shallow.parse(R"({"params":{"x":[[1]],"id":1},"id":"r2"})");
+    EXPECT_EQ(outcome.error.data, nlohmann::json("message exceeds max_depth"));
+    EXPECT_EQ(outcome.id, "r2");
+
+    // Malformed input after the violation keeps the budget error
+    outcome = parser.parse(R"({"params":"123456789","id":3,)");
+    EXPECT_EQ(outcome.error.code, core::INVALID_REQUEST);
+    EXPECT_EQ(outcome.id, 3);
+}
+
+// ============================================================================
+// McpServer::handle_raw_message
+// ============================================================================
+
+TEST(BudgetedParserTest, ServerRejectsRawMessagesOverBudget) {
+    server::McpServer server("test", "1.0");
+    core::ParseBudget budget;
+    budget.max_string_bytes = 16;
+    server.set_parse_budget("tools/call", budget);
+
+    auto rejected = server.handle_raw_message(
+        R"({"jsonrpc":"2.0","id":9,"method":"tools/call","params":{"name":"this-name-is-too-long"}})");
+    ASSERT_TRUE(rejected.has_value());
+    auto error = nlohmann::json::parse(*rejected);
+    EXPECT_EQ(error["id"], 9);
+    EXPECT_EQ(error["error"]["code"], -32600);
+
+    auto malformed = server.handle_raw_message("{not json");
+    ASSERT_TRUE(malformed.has_value());
+    EXPECT_EQ(nlohmann::json::parse(*malformed)["error"]["code"], -32700);
+
+    auto ok = server.handle_raw_message(R"({"jsonrpc":"2.0","id":1,"method":"tools/list"})");
+    ASSERT_TRUE(ok.has_value());
+    EXPECT_TRUE(nlohmann::json::parse(*ok).contains("result"));
+
+    EXPECT_FALSE(server.handle_raw_message(R"({"jsonrpc":"2.0","method":"notifications/initialized"})").has_value());
+}
+
+TEST(BudgetedParserTest, ServerAnswersRequestsWhoseIdFollowsTheViolation) {
+    server::McpServer server("test", "1.0");
+    core::ParseBudget budget;
+    budget.max_string_bytes = 16;
+    server.set_parse_budget("tools/call", budget);
+
+    auto& dropped = util::MetricsRegistry::global().counter("server.rejected_notifications");
+    const uint64_t before = dropped.value();
+    auto reply = server.handle_raw_message(
+        R"({"jsonrpc":"2.0","method":"tools/call","params":{"name":"this-name-is-too-long"},"id":7})");
+    ASSERT_TRUE(reply.has_value());
+    auto error = nlohmann::json::parse(*reply);
+    EXPECT_EQ(error["id"], 7);
+    EXPECT_EQ(error["error"]["code"], -32600);
+    EXPECT_EQ(dropped.value(), before);
+}
+
+TEST(BudgetedParserTest, ClientFailsRequestWhoseResponseIsOverBudget) {
+    auto owned = std::make_unique<CaptureTransport>();
+    CaptureTransport& transport = *owned;
+    McpClient client(std::move(owned));
+    ASSERT_TRUE(client.connect());
+    core::ParseBudget budget;
+    budget.max_string_bytes = 16;
+    client.set_default_parse_budget(budget);
+
+    std::optional<core::JsonRpcError> failure;
+    client.send_request("tools/list", nlohmann::json::object(),
+        [](const nlohmann::json&) {},
+        [&](const core::JsonRpcError& error) { failure = error; });
+    ASSERT_EQ(transport.sent.size(), 1u);
+    auto id = nlohmann::json::parse(transport.sent[0])["id"];
+
+    nlohmann::json response = {{"jsonrpc", "2.0"},
+                               {"result", {{"text", "longer than sixteen bytes"}}},
+                               {"id", id}};
+    transport.on_message(response.dump());
+    ASSERT_TRUE(failure.has_value());
+    EXPECT_EQ(failure->code, core::INVALID_REQUEST);
+}
+
+TEST(BudgetedParserTest, ServerDropsNotificationsOverBudget) {
+    server::McpServer server("test", "1.0");
+    core::ParseBudget budget;
+    budget.max_string_bytes = 16;
+    server.set_parse_budget("notifications/progress", budget);
+
+    auto& dropped = util::MetricsRegistry::global().counter("server.rejected_notifications");
+    const uint64_t before = dropped.value();
+    auto reply = server.handle_raw_message(
+        R"({"jsonrpc":"2.0","method":"notifications/progress","params":{"message":"far too long for the budget"}})");
+    EXPECT_FALSE(reply.has_value());
+    EXPECT_EQ(dropped.value(), before + 1);
+}
@@ -0,0 +1,252 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+#include "mcpp/transport/capture_transport.h"
+#include "mcpp/transport/capture_replay.h"
+#include "mcpp/server/mcp_server.h"
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace mcpp;
+using namespace mcpp::transport;
+
+namespace {
+
+// Loopback transport: records sends, lets the test inject inbound frames
+class LoopbackTransport : public Transport {
+public:
+    std::vector<std::string> sent;
+    MessageCallback on_message;
+
+    bool connect() override { return true; }
+    void disconnect() override {}
+    bool is_connected() const override { return true; }
+    bool send(std::string_view message) override {
+        sent.emplace_back(message);
+        return true;
+    }
+    void set_message_callback(MessageCallback cb) override { on_message = std::move(cb); }
+    void set_error_callback(ErrorCallback cb) override {}
+
+    void deliver(std::string_view message) {
+        if (on_message) {
+            on_message(message);
+        }
+    }
+};
+
+std::string temp_capture_path(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / ("mcpp_" + name + ".mcpcap")).string();
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// CaptureWriter / CaptureReader Tests
+// ============================================================================
+
+class CaptureTransportTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        std::remove(path.c_str());
+    }
+
+    std::string path = temp_capture_path(
+        ::testing::UnitTest::GetInstance()->current_test_info()->name());
+};
+
+TEST_F(CaptureTransportTest, RecordsBothDirections) {
+    auto writer = std::make_shared<CaptureWriter>();
+    ASSERT_TRUE(writer->open(path));
+
+    auto inner = std::make_unique<LoopbackTransport>();
+    auto* loopback = inner.get();
+    CaptureTransport transport(std::move(inner), writer, "session-a");
+
+    std::vector<std::string> received;
+    transport.set_message_callback([&](std::string_view m) { received.emplace_back(m); });
+
+    loopback->deliver(R"({"jsonrpc":"2.0","id":1,"method":"ping"})");
+    transport.send(R"({"jsonrpc":"2.0","id":1,"result":{}})");
+    writer->close();
+
+    ASSERT_EQ(received.size(), 1u);
+    ASSERT_EQ(loopback->sent.size(), 1u);
+
+    CaptureReader reader;
+    std::string error;
+    ASSERT_TRUE(reader.open(path, error)) << error;
+    ASSERT_EQ(reader.sessions().size(), 1u);
+    EXPECT_EQ(reader.sessions()[0].label, "session-a");
+    EXPECT_EQ(reader.sessions()[0].frame_count, 2u);
+
+    CapturedFrame frame;
+    ASSERT_TRUE(reader.next(frame));
+    EXPECT_EQ(frame.direction, CaptureDirection::Inbound);
+    EXPECT_EQ(frame.payload, R"({"jsonrpc":"2.0","id":1,"method":"ping"})");
+    ASSERT_TRUE(reader.next(frame));
+    EXPECT_EQ(frame.direction, CaptureDirection::Outbound);
+    EXPECT_GE(frame.timestamp_ns, 0u);
+    EXPECT_FALSE(reader.next(frame));
+}
+
+TEST_F(CaptureTransportTest, RebuildsIndexWithoutTrailer) {
+    {
+        CaptureWriter writer;
+        ASSERT_TRUE(writer.open(path));
+        auto a = writer.begin_session("a");
+        auto b = writer.begin_session("b");
+        writer.record(a, CaptureDirection::Inbound, "one");
+        writer.record(b, CaptureDirection::Inbound, "two");
+        writer.record(a, CaptureDirection::Outbound, "three");
+        writer.flush();
+
+        // Simulate a crash: truncate before the index is written
+        auto size = std::filesystem::file_size(path);
+        std::filesystem::copy_file(path, path + ".partial");
+        std::filesystem::resize_file(path + ".partial", size);
+    }
+    std::filesystem::rename(path + ".partial", path);
+
+    CaptureReader reader;
+    std::string error;
+    ASSERT_TRUE(reader.open(path, error)) << error;
+    ASSERT_EQ(reader.sessions().size(), 2u);
+    EXPECT_EQ(reader.sessions()[0].frame_count, 2u);
+    EXPECT_EQ(reader.sessions()[1].frame_count, 1u);
+
+    auto frames = reader.read_session(0);
+    ASSERT_EQ(frames.size(), 2u);
+    EXPECT_EQ(frames[1].payload, "three");
+}
+
+TEST_F(CaptureTransportTest, CorruptLengthsEndTheCaptureCleanly) {
+    {
+        CaptureWriter writer;
+        ASSERT_TRUE(writer.open(path));
+        auto a = writer.begin_session("a");
+        writer.record(a, CaptureDirection::Inbound, "one");
+        writer.flush();
+
+        auto size = std::filesystem::file_size(path);
+        std::filesystem::copy_file(path, path + ".partial");
+        std::filesystem::resize_file(path + ".partial", size);
+    }
+    std::filesystem::rename(path + ".partial", path);
+
+    // Append a session record numbered far past the record count, then a
+    // frame claiming a 1 TiB payload
+    std::FILE* f = std::fopen(path.c_str(), "ab");
+    const unsigned char session[] = {0x02, 0x00, 0xff, 0xff, 0x3f, 0x00};
+    const unsigned char frame[] = {0x00, 0x00, 0x00, 0x80, 0x80, 0x80, 0x80, 0x80, 0x20};
+    std::fwrite(session, 1, sizeof(session), f);
+    std::fwrite(frame, 1, sizeof(frame), f);
+    std::fclose(f);
+
+    CaptureReader reader;
+    std::string error;
+    ASSERT_TRUE(reader.open(path, error)) << error;
+    ASSERT_EQ(reader.sessions().size(), 1u);
+    EXPECT_EQ(reader.sessions()[0].frame_count, 1u);
+
+    CapturedFrame captured;
+    ASSERT_TRUE(reader.next(captured));
+    EXPECT_EQ(captured.payload, "one");
+    EXPECT_FALSE(reader.next(captured));
+}
+
+TEST_F(CaptureTransportTest, RejectsNonCaptureFile) {
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    std::fputs("not a capture file at all", f);
+    std::fclose(f);
+
+    CaptureReader reader;
+    std::string error;
+    EXPECT_FALSE(reader.open(path, error));
+    EXPECT_FALSE(error.empty());
+}
+
+// ============================================================================
+// CaptureReplayer Tests
+// ============================================================================
+
+namespace {
+
+std::vector<CapturedFrame> make_session(const std::vector<std::pair<CaptureDirection, std::string>>& frames) {
+    std::vector<CapturedFrame> out;
+    uint64_t ts = 0;
+    for (const auto& [dir, payload] : frames) {
+        out.push_back(CapturedFrame{0, dir, ts += 1000, payload});
+    }
+    return out;
+}
+
+} // anonymous namespace
+
+TEST(CaptureReplayerTest, ReplaysAgainstServerAndMatches) {
+    server::McpServer server("replay-test", "1.0.0");
+    LoopbackTransport transport;
+    server.set_transport(transport);
+    server.register_tool("echo", "Echo", nlohmann::json{{"type", "object"}},
+        [](const std::string&, const nlohmann::json& args, server::RequestContext&) {
+            return nlohmann::json{{"content", {{{"type", "text"}, {"text", args.value("text", "")}}}},
+                                  {"isError", false}};
+        });
+
+    auto frames = make_session({
+        {CaptureDirection::Inbound, R"({"jsonrpc":"2.0","id":7,"method":"tools/call","params":{"name":"echo","arguments":{"text":"hi"}}})"},
+        {CaptureDirection::Outbound, R"({"jsonrpc":"2.0","id":7,"result":{"content":[{"type":"text","text":"hi"}],"isError":false}})"},
+        {CaptureDirection::Inbound, R"({"jsonrpc":"2.0","id":8,"method":"tools/call","params":{"name":"echo","arguments":{"text":"yo"}}})"},
+        {CaptureDirection::Outbound, R"({"jsonrpc":"2.0","id":8,"result":{"content":[{"type":"text","text":"changed"}],"isError":false}})"},
+    });
+
+    CaptureReplayer replayer(frames, ReplayOptions{false, 1.0, CaptureDirection::Inbound, {}, std::chrono::milliseconds(100)});
+    auto report = replayer.run([&](std::string_view frame) {
+        if (auto response = server.handle_request(nlohmann::json::parse(frame))) {
+            replayer.on_response(response->dump());
+        }
+        return true;
+    });
+
+    EXPECT_EQ(report.frames_sent, 2u);
+    EXPECT_EQ(report.responses_expected, 2u);
+    EXPECT_EQ(report.matched, 1u);
+    ASSERT_EQ(report.mismatches.size(), 1u);
+    EXPECT_EQ(report.mismatches[0].id, "8");
+    EXPECT_FALSE(report.ok());
+}
+
+TEST(CaptureReplayerTest, IgnorePathsAndMissingResponses) {
+    auto frames = make_session({
+        {CaptureDirection::Inbound, R"({"jsonrpc":"2.0","id":1,"method":"a"})"},
+        {CaptureDirection::Outbound, R"({"jsonrpc":"2.0","id":1,"result":{"v":1,"ts":"old"}})"},
+        {CaptureDirection::Inbound, R"({"jsonrpc":"2.0","id":2,"method":"b"})"},
+        {CaptureDirection::Outbound, R"({"jsonrpc":"2.0","id":2,"result":{}})"},
+    });
+
+    ReplayOptions options;
+    options.original_timing = false;
+    options.ignore_paths = {"/result/ts"};
+    options.response_timeout = std::chrono::milliseconds(50);
+
+    CaptureReplayer replayer(frames, options);
+    auto report = replayer.run([&](std::string_view frame) {
+        auto msg = nlohmann::json::parse(frame);
+        if (msg["id"] == 1) {
+            replayer.on_response(R"({"jsonrpc":"2.0","id":1,"result":{"v":1,"ts":"new"}})");
+        }
+        return true;
+    });
+
+    EXPECT_EQ(report.matched, 1u);
+    ASSERT_EQ(report.missing.size(), 1u);
+    EXPECT_EQ(report.missing[0], "2");
+}
@@ -0,0 +1,199 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+#include "mcpp/client.h"
+#include "mcpp/protocol/initialize.h"
+#include "fixtures/common.h"
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mcpp;
+using namespace mcpp::test;
+using namespace std::chrono_literals;
+
+namespace {
+
+struct Fixture {
+    std::shared_ptr<FakeServerState> state = std::make_shared<FakeServerState>();
+    std::mutex mutex;
+    std::vector<FakeServerTransport*> transports;
+
+    std::unique_ptr<FakeServerTransport> make() {
+        auto transport = std::make_unique<FakeServerTransport>(state);
+        std::lock_guard<std::mutex> lock(mutex);
+        transports.push_back(transport.get());
+        return transport;
+    }
+
+    FakeServerTransport* latest() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return transports.back();
+    }
+
+    McpClient::ReconnectOptions options() {
+        McpClient::ReconnectOptions options;
+        options.factory = [this]() { return make(); };
+        options.max_attempts = 3;
+        options.backoff = std::make_shared<util::ExponentialBackoff>(1ms, 1.0, 1ms);
+        options.initialize_timeout = 1000ms;
+        return options;
+    }
+};
+
+void initialize(McpClient& client) {
+    protocol::InitializeRequestParams params;
+    params.protocolVersion = protocol::PROTOCOL_VERSION;
+    params.clientInfo = {"test-client", "1.0"};
+    std::atomic<bool> done{false};
+    client.initialize(params,
+        [&](const protocol::InitializeResult&) { done = true; },
+        [](const core::JsonRpcError&) {});
+    ASSERT_TRUE(eventually([&] { return done.load(); }));
+}
+
+std::vector<std::string> methods(const std::vector<nlohmann::json>& messages) {
+    std::vector<std::string> names;
+    for (const auto& message : messages) {
+        names.push_back(message.value("method", ""));
+    }
+    return names;
+}
+
+} // namespace
+
+TEST(ClientReconnectTest, ReplaysIdempotentRequestsAndFailsOthers) {
+    Fixture fixture;
+    McpClient client(fixture.make());
+    std::atomic<uint32_t> reconnected{0};
+    auto options = fixture.options();
+    options.on_reconnected = [&](uint32_t attempts) { reconnected = attempts; };
+    client.enable_reconnect(std::move(options));
+    ASSERT_TRUE(client.connect());
+    initialize(client);
+
+    std::atomic<bool> subscribed{false};
+    client.send_request("resources/subscribe", {{"uri", "file:///a"}},
+        [&](const nlohmann::json&) { subscribed = true; }, nullptr);
+    ASSERT_TRUE(eventually([&] { return subscribed.load(); }));
+
+    {
+        std::lock_guard<std::mutex> lock(fixture.state->mutex);
+        fixture.state->answer_requests = false;
+    }
+    std::atomic<bool> listed{false};
+    std::atomic<bool> call_failed{false};
+    std::string call_error;
+    client.send_request("tools/list", nlohmann::json::object(),
+        [&](const nlohmann::json&) { listed = true; }, nullptr);
+    client.send_request("tools/call", {{"name", "write"}, {"arguments", nlohmann::json::object()}},
+        nullptr,
+        [&](const core::JsonRpcError& error) {
+            call_error = error.message;
+            call_failed = true;
+        });
+    ASSERT_TRUE(eventually([&] { return fixture.state->connection(0).size() == 5u; }));
+    const nlohmann::json original_list = fixture.state->connection(0)[3];
+
+    {
+        std::lock_guard<std::mutex> lock(fixture.state->mutex);
+        fixture.state->answer_requests = true;
+    }
+    fixture.latest()->kill();
+
+    ASSERT_TRUE(eventually([&] { return listed.load(); }));
+    EXPECT_TRUE(call_failed);
+    EXPECT_EQ(call_error.rfind("Connection lost", 0), 0u);
+    // on_reconnected runs after the replay, which may already be answered
+    EXPECT_TRUE(eventually([&] { return reconnected.load() == 1u; }));
+
+    // The new server is initialized, re-subscribed and sent the same request
+    auto second = fixture.state->connection(1);
+    EXPECT_EQ(methods(second), (std::vector<std::string>{
+        "initialize", "notifications/initialized", "resources/subscribe", "tools/list"}));
+    EXPECT_EQ(second[2]["params"]["uri"], "file:///a");
+    EXPECT_EQ(second[3]["id"], original_list["id"]);
+    EXPECT_TRUE(client.is_connected());
+}
+
+TEST(ClientReconnectTest, IdempotentToolsAreReplayed) {
+    Fixture fixture;
+    McpClient client(fixture.make());
+    auto options = fixture.options();
+    options.idempotent_tools = {"lookup"};
+    client.enable_reconnect(std::move(options));
+    ASSERT_TRUE(client.connect());
+
+    {
+        std::lock_guard<std::mutex> lock(fixture.state->mutex);
+        fixture.state->answer_requests = false;
+    }
+    std::atomic<bool> answered{false};
+    client.send_request("tools/call", {{"name", "lookup"}, {"arguments", nlohmann::json::object()}},
+        [&](const nlohmann::json&) { answered = true; }, nullptr);
+    ASSERT_TRUE(eventually([&] { return fixture.state->connection(0).size() == 1u; }));
+    {
+        std::lock_guard<std::mutex> lock(fixture.state->mutex);
+        fixture.state->answer_requests = true;
+    }
+    fixture.latest()->kill();
+
+    EXPECT_TRUE(eventually([&] { return answered.load(); }));
+    // Never initialized, so nothing else is sent before the replay
+    EXPECT_EQ(methods(fixture.state->connection(1)), (std::vector<std::string>{"tools/call"}));
+}
+
+TEST(ClientReconnectTest, GivesUpAfterMaxAttempts) {
+    Fixture fixture;
+    McpClient client(fixture.make());
+    client.enable_reconnect(fixture.options());
+    ASSERT_TRUE(client.connect());
+
+    std::atomic<int> lost{0};
+    std::string lost_reason;
+    client.set_connection_lost_handler([&](std::string_view reason) {
+        lost_reason = std::string(reason);
+        ++lost;
+    });
+
+    {
+        std::lock_guard<std::mutex> lock(fixture.state->mutex);
+        fixture.state->answer_requests = false;
+        fixture.state->refuse_connections = true;
+    }
+    std::atomic<bool> failed{false};
+    client.send_request("tools/list", nlohmann::json::object(), nullptr,
+        [&](const core::JsonRpcError&) { failed = true; });
+    fixture.latest()->kill();
+
+    ASSERT_TRUE(eventually([&] { return lost.load() == 1; }));
+    EXPECT_TRUE(failed);
+    EXPECT_NE(lost_reason.find("after 3 attempt"), std::string::npos);
+}
+
+TEST(ClientReconnectTest, LossWithoutReconnectFailsInFlightAtOnce) {
+    Fixture fixture;
+    McpClient client(fixture.make());
+    ASSERT_TRUE(client.connect());
+
+    {
+        std::lock_guard<std::mutex> lock(fixture.state->mutex);
+        fixture.state->answer_requests = false;
+    }
+    std::atomic<bool> failed{false};
+    client.send_request("tools/list", nlohmann::json::object(), nullptr,
+        [&](const core::JsonRpcError&) { failed = true; });
+    fixture.latest()->kill();
+
+    EXPECT_TRUE(eventually([&] { return failed.load(); }));
+}
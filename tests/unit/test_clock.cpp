@@ -0,0 +1,125 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+#include "mcpp/util/clock.h"
+#include "mcpp/server/request_context.h"
+#include "mcpp/server/task_manager.h"
+#include "mcpp/transport/null_transport.h"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <memory>
+
+using namespace mcpp;
+
+// ============================================================================
+// Clock implementations
+// ============================================================================
+
+TEST(ClockTest, ManualClockOnlyMovesWhenAdvanced) {
+    util::ManualClock clock;
+    auto steady = clock.steady_now();
+    auto system = clock.system_now();
+
+    EXPECT_EQ(clock.steady_now(), steady);
+
+    clock.advance(std::chrono::seconds(90));
+    EXPECT_EQ(clock.steady_now() - steady, std::chrono::seconds(90));
+    EXPECT_EQ(clock.system_now() - system, std::chrono::seconds(90));
+
+    clock.advance(std::chrono::seconds(-5));
+    EXPECT_EQ(clock.steady_now() - steady, std::chrono::seconds(90));
+}
+
+TEST(ClockTest, CoarseClockTracksSteadyClock) {
+    util::CoarseClock clock;
+    auto coarse = clock.steady_now();
+    auto precise = std::chrono::steady_clock::now();
+
+    // Coarse clocks lag by at most a few scheduler ticks
+    EXPECT_LE(coarse, precise);
+    EXPECT_LT(precise - coarse, std::chrono::milliseconds(100));
+
+    auto wall_diff = std::chrono::system_clock::now() - clock.system_now();
+    EXPECT_LT(std::chrono::abs(wall_diff), std::chrono::milliseconds(100));
+}
+
+TEST(ClockTest, DefaultClockCanBeReplacedAndRestored) {
+    auto manual = std::make_shared<util::ManualClock>();
+    util::Clock::set_default_clock(manual);
+    EXPECT_EQ(util::Clock::default_clock(), manual);
+
+    util::Clock::set_default_clock(nullptr);
+    EXPECT_EQ(util::Clock::default_clock(), util::Clock::system());
+}
+
+// ============================================================================
+// Components driven by a virtual clock
+// ============================================================================
+
+TEST(VirtualClockTest, TaskManagerTtlExpiry) {
+    auto clock = std::make_shared<util::ManualClock>();
+    server::TaskManager manager(clock);
+
+    auto short_lived = manager.create_task(60000);   // 1 minute
+    auto long_lived = manager.create_task(3600000);  // 1 hour
+    manager.create_task();                           // no TTL
+
+    clock->advance(std::chrono::minutes(2));
+    EXPECT_EQ(manager.cleanup_expired(), 1u);
+    EXPECT_FALSE(manager.get_task(short_lived).has_value());
+
+    clock->advance(std::chrono::hours(2));
+    EXPECT_EQ(manager.cleanup_expired(), 1u);
+    EXPECT_FALSE(manager.get_task(long_lived).has_value());
+    EXPECT_EQ(manager.list_tasks().items.size(), 1u);
+}
+
+TEST(VirtualClockTest, TaskTimestampsComeFromClock) {
+    using namespace std::chrono;
+    auto epoch = system_clock::time_point(seconds(1735689600));  // 2025-01-01T00:00:00Z
+    auto clock = std::make_shared<util::ManualClock>(steady_clock::now(), epoch);
+    server::TaskManager manager(clock);
+
+    auto id = manager.create_task();
+    clock->advance(seconds(61));
+    manager.update_status(id, server::TaskStatus::Completed);
+
+    auto task = manager.get_task(id);
+    ASSERT_TRUE(task.has_value());
+    EXPECT_EQ(task->created_at, epoch);
+    EXPECT_EQ(task->last_updated_at, epoch + seconds(61));
+    EXPECT_EQ(server::TaskManager::format_timestamp(task->created_at), "2025-01-01T00:00:00.000Z");
+    EXPECT_EQ(server::TaskManager::format_timestamp(task->last_updated_at), "2025-01-01T00:01:01.000Z");
+}
+
+TEST(VirtualClockTest, RequestContextDeadline) {
+    auto clock = std::make_shared<util::ManualClock>();
+    transport::NullTransport transport;
+    server::RequestContext ctx("req-1", transport, std::chrono::minutes(5), clock.get());
+
+    clock->advance(std::chrono::minutes(4));
+    EXPECT_FALSE(ctx.is_timeout_expired());
+
+    ctx.reset_timeout_on_progress();
+    clock->advance(std::chrono::minutes(4));
+    EXPECT_FALSE(ctx.is_timeout_expired());
+
+    clock->advance(std::chrono::minutes(2));
+    EXPECT_TRUE(ctx.is_timeout_expired());
+}
+
+TEST(VirtualClockTest, RequestContextFollowsDefaultClock) {
+    auto clock = std::make_shared<util::ManualClock>();
+    util::Clock::set_default_clock(clock);
+    {
+        transport::NullTransport transport;
+        server::RequestContext ctx("req-1", transport, std::chrono::minutes(5));
+        clock->advance(std::chrono::minutes(6));
+        EXPECT_TRUE(ctx.is_timeout_expired());
+    }
+    util::Clock::set_default_clock(nullptr);
+}
@@ -0,0 +1,321 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+#include "mcpp/server/completion_index.h"
+#include "mcpp/server/mcp_server.h"
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mcpp::server;
+
+namespace {
+
+std::vector<std::string> values_of(const CompletionResult& result) {
+    std::vector<std::string> values;
+    for (const auto& completion : result.values) {
+        values.push_back(completion.value);
+    }
+    return values;
+}
+
+/// Poll until a background rebuild makes @p value the first suggestion
+std::vector<std::string> wait_for_value(const CompletionIndex& index, const std::string& value) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    std::vector<std::string> values = values_of(index.complete(value));
+    while ((values.empty() || values.front() != value) && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        values = values_of(index.complete(value));
+    }
+    return values;
+}
+
+} // namespace
+
+// ============================================================================
+// Prefix matching and ranking
+// ============================================================================
+
+TEST(CompletionIndex, PrefixMatchesRankedByWeight) {
+    CompletionIndex index(std::vector<CompletionCandidate>{
+        {"python", 10, std::nullopt},
+        {"pascal", 1, std::nullopt},
+        {"perl", 5, std::nullopt},
+        {"rust", 100, std::nullopt},
+        {"php", 5, std::nullopt},
+    });
+
+    auto result = index.complete("p");
+    EXPECT_EQ(values_of(result), (std::vector<std::string>{"python", "perl", "php", "pascal"}));
+    EXPECT_EQ(result.total, 4u);
+    EXPECT_FALSE(result.has_more);
+
+    EXPECT_EQ(values_of(index.complete("pe")), std::vector<std::string>{"perl"});
+    EXPECT_TRUE(index.complete("zz").values.empty());
+    EXPECT_EQ(index.complete("").total, 5u);
+}
+
+TEST(CompletionIndex, CaseInsensitiveKeepsOriginalValue) {
+    CompletionIndex index(std::vector<std::string>{"README.md", "src/Main.cpp"});
+
+    EXPECT_EQ(values_of(index.complete("read")), std::vector<std::string>{"README.md"});
+    EXPECT_EQ(values_of(index.complete("SRC/m")), std::vector<std::string>{"src/Main.cpp"});
+
+    CompletionIndex::Options options;
+    options.case_insensitive = false;
+    CompletionIndex exact(options);
+    exact.build({{"README.md", 0, std::nullopt}});
+    EXPECT_TRUE(exact.complete("read").values.empty());
+}
+
+TEST(CompletionIndex, CapsAtSpecLimitWithTotal) {
+    std::vector<CompletionCandidate> candidates;
+    for (int i = 0; i < 250; ++i) {
+        candidates.push_back({"item" + std::to_string(i), static_cast<uint32_t>(i), std::nullopt});
+    }
+    CompletionIndex index(std::move(candidates));
+
+    auto result = index.complete("item");
+    EXPECT_EQ(result.values.size(), MAX_COMPLETION_VALUES);
+    EXPECT_EQ(result.total, 250u);
+    EXPECT_TRUE(result.has_more);
+    EXPECT_EQ(result.values.front().value, "item249");
+
+    EXPECT_EQ(index.complete("item", 3).values.size(), 3u);
+}
+
+// ============================================================================
+// Fuzzy matching
+// ============================================================================
+
+TEST(CompletionIndex, FuzzyMatchesRankAfterExactMatches) {
+    CompletionIndex index(std::vector<CompletionCandidate>{
+        {"config", 1, std::nullopt},
+        {"conflict", 1, std::nullopt},
+        {"cinfig", 50, std::nullopt},
+        {"console", 99, std::nullopt},
+    });
+
+    // "conf" matches config/conflict exactly; console and cinfig are one
+    // substitution away and rank after them, by weight
+    auto result = index.complete("conf");
+    EXPECT_EQ(values_of(result),
+              (std::vector<std::string>{"config", "conflict", "console", "cinfig"}));
+    EXPECT_EQ(result.total, 4u);
+
+    // Two edits from every candidate prefix
+    EXPECT_TRUE(index.complete("cnfx").values.empty());
+
+    // Short prefixes don't go fuzzy
+    EXPECT_EQ(values_of(index.complete("ci")), std::vector<std::string>{"cinfig"});
+}
+
+TEST(CompletionIndex, FuzzyHandlesInsertionAndDeletion) {
+    CompletionIndex index(std::vector<std::string>{"database", "datastore", "dashboard"});
+
+    EXPECT_EQ(values_of(index.complete("dtab")), std::vector<std::string>{"database"});
+    EXPECT_EQ(values_of(index.complete("daata")),
+              (std::vector<std::string>{"database", "datastore"}));
+}
+
+TEST(CompletionIndex, FuzzyOverLargeCandidateSet) {
+    std::vector<CompletionCandidate> candidates;
+    for (int i = 0; i < 1000; ++i) {
+        candidates.push_back({"alpha" + std::to_string(i), static_cast<uint32_t>(i), std::nullopt});
+        candidates.push_back({"beta" + std::to_string(i), static_cast<uint32_t>(i), std::nullopt});
+    }
+    CompletionIndex index(std::move(candidates));
+
+    auto alpha = index.complete("alphx");
+    EXPECT_EQ(alpha.total, 1000u);
+    EXPECT_TRUE(alpha.has_more);
+    EXPECT_EQ(alpha.values.front().value, "alpha999");
+
+    auto beta = index.complete("bata");
+    EXPECT_EQ(beta.total, 1000u);
+    EXPECT_EQ(beta.values.front().value, "beta999");
+
+    // beta12, beta120..beta129 match exactly and come before one-edit matches
+    auto exact_first = index.complete("beta12");
+    EXPECT_GT(exact_first.total, 11u);
+    for (size_t i = 0; i < 11; ++i) {
+        EXPECT_EQ(exact_first.values[i].value.rfind("beta12", 0), 0u) << exact_first.values[i].value;
+    }
+    EXPECT_NE(exact_first.values[11].value.rfind("beta12", 0), 0u);
+}
+
+// ============================================================================
+// Refreshable sources
+// ============================================================================
+
+TEST(CompletionIndex, SourceIsReReadAfterTtl) {
+    auto clock = std::make_shared<mcpp::util::ManualClock>();
+    CompletionIndex index(CompletionIndex::Options{}, clock);
+
+    std::atomic<int> reads{0};
+    index.set_source([&reads] {
+        const int n = ++reads;
+        return std::vector<CompletionCandidate>{{"v" + std::to_string(n), 0, std::nullopt}};
+    }, std::chrono::seconds(10));
+    EXPECT_EQ(reads, 1);
+    EXPECT_EQ(values_of(index.complete("v")), std::vector<std::string>{"v1"});
+
+    clock->advance(std::chrono::seconds(5));
+    index.complete("v");
+    EXPECT_EQ(reads, 1);
+
+    clock->advance(std::chrono::seconds(5));
+    EXPECT_EQ(wait_for_value(index, "v2"), std::vector<std::string>{"v2"});
+    EXPECT_EQ(reads, 2);
+}
+
+TEST(CompletionIndex, ExpiredSourceIsRebuiltInTheBackground) {
+    auto clock = std::make_shared<mcpp::util::ManualClock>();
+    CompletionIndex index(CompletionIndex::Options{}, clock);
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool release = false;
+    std::atomic<int> reads{0};
+    index.set_source([&] {
+        const int n = ++reads;
+        if (n > 1) {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [&] { return release; });
+        }
+        return std::vector<CompletionCandidate>{{"v" + std::to_string(n), 0, std::nullopt}};
+    }, std::chrono::seconds(10));
+
+    // The slow re-read does not hold up completions, which keep the old data
+    clock->advance(std::chrono::seconds(10));
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(values_of(index.complete("v")), std::vector<std::string>{"v1"});
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        release = true;
+    }
+    cv.notify_all();
+    EXPECT_EQ(wait_for_value(index, "v2"), std::vector<std::string>{"v2"});
+    EXPECT_EQ(reads, 2);
+}
+
+// ============================================================================
+// Server integration
+// ============================================================================
+
+TEST(CompletionIndex, ServerReturnsSpecCompleteResult) {
+    McpServer server;
+    server.set_prompt_completion_index(
+        "greet", "language",
+        std::make_shared<CompletionIndex>(std::vector<std::string>{"python", "perl", "rust"}));
+    server.set_resource_completion_handler("file:///{path}",
+        [](const std::string&, const nlohmann::json&, const std::optional<nlohmann::json>&) {
+            return std::vector<Completion>{{"a.txt", std::nullopt}, {"b.txt", std::nullopt}};
+        });
+
+    auto response = server.handle_request({
+        {"jsonrpc", "2.0"}, {"id", 1}, {"method", "prompts/complete"},
+        {"params", {{"name", "greet"}, {"argument", "language"}, {"value", "p"}}}
+    });
+    ASSERT_TRUE(response.has_value());
+    const auto& completion = (*response)["result"]["completion"];
+    EXPECT_EQ(completion["values"], (nlohmann::json{"perl", "python"}));
+    EXPECT_EQ(completion["total"], 2);
+    EXPECT_EQ(completion["hasMore"], false);
+
+    response = server.handle_request({
+        {"jsonrpc", "2.0"}, {"id", 2}, {"method", "resources/complete"},
+        {"params", {{"name", "file:///{path}"}, {"argument", "path"}, {"value", ""}}}
+    });
+    ASSERT_TRUE(response.has_value());
+    EXPECT_EQ((*response)["result"]["completion"]["values"], (nlohmann::json{"a.txt", "b.txt"}));
+
+    response = server.handle_request({
+        {"jsonrpc", "2.0"}, {"id", 3}, {"method", "prompts/complete"},
+        {"params", {{"name", "unknown"}, {"argument", "x"}}}
+    });
+    EXPECT_TRUE((*response)["result"]["completion"]["values"].empty());
+}
+
+// ============================================================================
+// Completion cache
+// ============================================================================
+
+TEST(CompletionCache, RefinesLongerPrefixFromCachedCandidates) {
+    CompletionCache cache(8);
+    auto scope = CompletionCache::make_scope("prompt", "p", "lang", "");
+
+    EXPECT_FALSE(cache.lookup(scope, "p").has_value());
+    cache.store(scope, "p", {{"python", std::nullopt}, {"perl", std::nullopt}, {"PHP", std::nullopt}});
+
+    auto exact = cache.lookup(scope, "p");
+    ASSERT_TRUE(exact.has_value());
+    EXPECT_EQ((*exact)->size(), 3u);
+
+    auto refined = cache.lookup(scope, "ph");
+    ASSERT_TRUE(refined.has_value());
+    ASSERT_EQ((*refined)->size(), 1u);
+    EXPECT_EQ((**refined)[0].value, "PHP");
+
+    // Different scope doesn't see the entry
+    EXPECT_FALSE(cache.lookup(CompletionCache::make_scope("prompt", "p", "other", ""), "ph"));
+
+    EXPECT_EQ(cache.hits(), 1u);
+    EXPECT_EQ(cache.refinements(), 1u);
+    EXPECT_EQ(cache.misses(), 2u);
+
+    cache.clear();
+    EXPECT_FALSE(cache.lookup(scope, "ph").has_value());
+}
+
+TEST(CompletionCache, ServerCallsHandlerOncePerTypingSession) {
+    McpServer server;
+    server.enable_completion_cache();
+
+    int calls = 0;
+    server.set_prompt_completion_handler("greet",
+        [&calls](const std::string&, const nlohmann::json& value, const std::optional<nlohmann::json>&) {
+            ++calls;
+            std::string prefix = value.is_string() ? value.get<std::string>() : "";
+            std::vector<Completion> out;
+            for (const char* v : {"alice", "albert", "bob"}) {
+                if (std::string(v).rfind(prefix, 0) == 0) out.push_back({v, std::nullopt});
+            }
+            return out;
+        });
+
+    auto complete = [&](const std::string& value) {
+        auto response = server.handle_request({
+            {"jsonrpc", "2.0"}, {"id", 1}, {"method", "prompts/complete"},
+            {"params", {{"name", "greet"}, {"argument", "name"}, {"value", value}}}
+        });
+        return (*response)["result"]["completion"]["values"];
+    };
+
+    EXPECT_EQ(complete("a"), (nlohmann::json{"alice", "albert"}));
+    EXPECT_EQ(complete("al"), (nlohmann::json{"alice", "albert"}));
+    EXPECT_EQ(complete("ali"), (nlohmann::json{"alice"}));
+    EXPECT_EQ(complete("alic"), (nlohmann::json{"alice"}));
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(server.completion_cache()->refinements(), 3u);
+
+    // Registering a prompt invalidates cached completions
+    server.register_prompt("other", std::nullopt, {},
+        [](const std::string&, const nlohmann::json&) { return std::vector<PromptMessage>{}; });
+    complete("al");
+    EXPECT_EQ(calls, 2);
+}
@@ -0,0 +1,111 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+#include "mcpp/server/mcp_server.h"
+#include "mcpp/transport/null_transport.h"
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+
+using namespace mcpp;
+using namespace mcpp::server;
+using namespace std::chrono_literals;
+
+namespace {
+
+nlohmann::json request(int id, const std::string& method,
+                       nlohmann::json params = nlohmann::json::object()) {
+    return {{"jsonrpc", "2.0"}, {"id", id}, {"method", method}, {"params", std::move(params)}};
+}
+
+} // namespace
+
+TEST(DrainTest, RejectsNewWorkWithRetryableError) {
+    McpServer server;
+    transport::NullTransport transport;
+    server.set_transport(transport);
+    EXPECT_FALSE(server.is_draining());
+
+    server.begin_drain(250ms);
+    EXPECT_TRUE(server.is_draining());
+
+    for (const char* method : {"initialize", "tools/list", "tasks/send"}) {
+        auto response = server.handle_request(request(1, method));
+        ASSERT_TRUE(response) << method;
+        EXPECT_EQ((*response)["error"]["code"], -32031) << method;
+        EXPECT_EQ((*response)["error"]["data"]["retryAfterMs"], 250) << method;
+    }
+    auto serialized = server.handle_request_serialized(request(2, "resources/list"));
+    ASSERT_TRUE(serialized);
+    EXPECT_EQ(nlohmann::json::parse(*serialized)["error"]["code"], -32031);
+
+    // Liveness, task collection and notifications still work
+    EXPECT_TRUE(server.handle_request(request(3, "ping"))->contains("result"));
+    EXPECT_TRUE(server.handle_request(request(4, "tasks/list"))->contains("result"));
+    EXPECT_FALSE(server.handle_request({{"jsonrpc", "2.0"}, {"method", "notifications/initialized"}}));
+}
+
+TEST(DrainTest, WaitsForInFlightRequests) {
+    McpServer server;
+    transport::NullTransport transport;
+    server.set_transport(transport);
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::atomic<bool> entered{false};
+    server.register_tool("slow", "Slow", {{"type", "object"}},
+        [&](const std::string&, const nlohmann::json&, RequestContext&) {
+            entered = true;
+            released.wait();
+            return nlohmann::json{{"content", nlohmann::json::array()}};
+        });
+
+    auto call = std::async(std::launch::async, [&] {
+        return server.handle_request(request(1, "tools/call", {{"name", "slow"}, {"arguments", nlohmann::json::object()}}));
+    });
+    while (!entered) {
+        std::this_thread::sleep_for(1ms);
+    }
+    EXPECT_EQ(server.in_flight_requests(), 1u);
+
+    auto drained = std::async(std::launch::async, [&] { return server.drain(5s); });
+    EXPECT_EQ(drained.wait_for(50ms), std::future_status::timeout);
+
+    release.set_value();
+    EXPECT_TRUE(drained.get());
+    auto response = call.get();
+    ASSERT_TRUE(response);
+    EXPECT_TRUE(response->contains("result"));
+    EXPECT_EQ(server.in_flight_requests(), 0u);
+}
+
+TEST(DrainTest, CancelsTasksStillWorkingAtDeadline) {
+    McpServer server;
+    transport::NullTransport transport;
+    server.set_transport(transport);
+
+    auto created = server.handle_request(request(1, "tasks/send"));
+    ASSERT_TRUE(created && created->contains("result"));
+    const std::string task_id = (*created)["result"]["id"];
+
+    const auto started = std::chrono::steady_clock::now();
+    EXPECT_FALSE(server.drain(30ms));
+    EXPECT_GE(std::chrono::steady_clock::now() - started, 30ms);
+
+    auto task = server.handle_request(request(2, "tasks/get", {{"id", task_id}}));
+    ASSERT_TRUE(task && task->contains("result"));
+    EXPECT_EQ((*task)["result"]["status"], "cancelled");
+}
+
+TEST(DrainTest, IdleServerDrainsImmediately) {
+    McpServer server;
+    const auto started = std::chrono::steady_clock::now();
+    EXPECT_TRUE(server.drain(5s));
+    EXPECT_LT(std::chrono::steady_clock::now() - started, 1s);
+}
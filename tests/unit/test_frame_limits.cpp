@@ -0,0 +1,203 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+#include "mcpp/transport/frame_limits.h"
+#include "mcpp/transport/http_transport.h"
+#include "mcpp/util/utf8.h"
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace mcpp;
+
+// ============================================================================
+// UTF-8 validation
+// ============================================================================
+
+TEST(Utf8Test, AcceptsWellFormedInput) {
+    const std::string valid[] = {
+        "",
+        "plain ascii",
+        "caf\xc3\xa9",                       // U+00E9
+        "\xe2\x82\xac",                      // U+20AC
+        "\xef\xbf\xbf",                      // U+FFFF
+        "\xf0\x9f\x98\x80",                  // U+1F600
+        "\xf4\x8f\xbf\xbf",                  // U+10FFFF
+        std::string(100, 'a') + "\xe2\x82\xac" + std::string(100, 'b'),
+    };
+    for (const auto& s : valid) {
+        EXPECT_TRUE(util::is_valid_utf8(s)) << s;
+        EXPECT_TRUE(util::is_valid_utf8_scalar(s)) << s;
+    }
+}
+
+TEST(Utf8Test, RejectsMalformedInput) {
+    const std::string invalid[] = {
+        "\x80",                              // Lone continuation
+        "\xc0\xaf",                          // Overlong '/'
+        "\xc3",                              // Truncated
+        "\xe0\x80\xaf",                      // Overlong 3-byte
+        "\xed\xa0\x80",                      // Surrogate U+D800
+        "\xf0\x80\x80\xaf",                  // Overlong 4-byte
+        "\xf4\x90\x80\x80",                  // Above U+10FFFF
+        "\xff",
+        // Error inside and at the very end of a SIMD block
+        std::string(40, 'a') + "\xc3(" + std::string(40, 'b'),
+        std::string(63, 'a') + "\xe2\x82",
+    };
+    for (const auto& s : invalid) {
+        EXPECT_FALSE(util::is_valid_utf8(s));
+        EXPECT_FALSE(util::is_valid_utf8_scalar(s));
+    }
+}
+
+TEST(Utf8Test, SimdAgreesWithScalarOnRandomInput) {
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::uniform_int_distribution<int> pick(0, 9);
+    const std::string snippets[] = {"\xc3\xa9", "\xe2\x82\xac", "\xf0\x9f\x98\x80", "\xed\xa0\x80", "\x80"};
+
+    for (int round = 0; round < 2000; ++round) {
+        std::string s;
+        while (s.size() < 96) {
+            int p = pick(rng);
+            if (p < 6) {
+                s.push_back(static_cast<char>('a' + p));
+            } else if (p < 9) {
+                s += snippets[static_cast<size_t>(byte(rng)) % 5];
+            } else {
+                s.push_back(static_cast<char>(byte(rng)));
+            }
+        }
+        ASSERT_EQ(util::is_valid_utf8(s), util::is_valid_utf8_scalar(s)) << round;
+    }
+    EXPECT_NE(std::string(util::utf8_backend()), "");
+}
+
+// ============================================================================
+// Frame checks
+// ============================================================================
+
+TEST(FrameLimitsTest, EnforcesSizeDepthAndEncoding) {
+    transport::FrameLimits limits;
+    limits.max_frame_bytes = 64;
+    limits.max_depth = 3;
+
+    using transport::FrameError;
+    EXPECT_EQ(transport::check_frame(R"({"a":[1,{"b":2}]})", limits), FrameError::None);
+    EXPECT_EQ(transport::check_frame(R"({"a":[[{"b":2}]]})", limits), FrameError::TooDeep);
+    EXPECT_EQ(transport::check_frame(std::string(65, ' '), limits), FrameError::TooLarge);
+    EXPECT_EQ(transport::check_frame("{\"a\":\"\xc0\xaf\"}", limits), FrameError::InvalidUtf8);
+
+    // Brackets inside strings (including after escaped quotes) don't count
+    EXPECT_EQ(transport::check_frame(R"({"a":"[[[[\"[[[[","b":"\\"})", limits), FrameError::None);
+
+    limits.max_depth = 0;
+    limits.max_frame_bytes = 0;
+    EXPECT_EQ(transport::check_frame(std::string(1000, '['), limits), FrameError::None);
+}
+
+TEST(FrameLimitsTest, ErrorResponseIsJsonRpcParseError) {
+    auto response = nlohmann::json::parse(
+        transport::make_frame_error_response(transport::FrameError::TooDeep));
+    EXPECT_EQ(response["jsonrpc"], "2.0");
+    EXPECT_TRUE(response["id"].is_null());
+    EXPECT_EQ(response["error"]["code"], -32700);
+    EXPECT_EQ(response["error"]["data"], "frame exceeds max_depth");
+}
+
+namespace {
+
+struct FakeResponse {
+    int status = 0;
+    std::string body;
+    void set_header(const std::string&, const std::string&) {}
+    void write(const std::string& data) { body += data; }
+    void set_status(int code) { status = code; }
+};
+
+} // anonymous namespace
+
+TEST(FrameLimitsTest, HttpTransportRejectsBeforeCallback) {
+    transport::HttpTransport http;
+    ASSERT_TRUE(http.connect());
+    transport::FrameLimits limits;
+    limits.max_frame_bytes = 32;
+    http.set_frame_limits(limits);
+
+    int delivered = 0;
+    http.set_message_callback([&](std::string_view) { ++delivered; });
+
+    FakeResponse raw;
+    transport::HttpTransport::HttpResponseAdapter<FakeResponse> response(raw);
+    http.handle_post_request(std::string(64, ' '), "", response);
+    EXPECT_EQ(raw.status, 413);
+    EXPECT_EQ(nlohmann::json::parse(raw.body)["error"]["code"], -32700);
+
+    raw = FakeResponse{};
+    http.handle_post_request("\"\xff\"", "", response);
+    EXPECT_EQ(raw.status, 400);
+    EXPECT_EQ(delivered, 0);
+
+    raw = FakeResponse{};
+    http.handle_post_request(R"({"jsonrpc":"2.0"})", "", response);
+    EXPECT_EQ(raw.status, 200);
+    EXPECT_EQ(delivered, 1);
+}
+
+TEST(LineFramerTest, SplitsLinesAcrossChunks) {
+    transport::LineFramer framer;
+    std::vector<std::string> frames;
+    auto sink = [&](std::string_view line, transport::FrameError error) {
+        EXPECT_EQ(error, transport::FrameError::None);
+        frames.emplace_back(line);
+        return true;
+    };
+
+    EXPECT_TRUE(framer.feed("{\"a\":1}\n{\"b\"", {}, sink));
+    EXPECT_TRUE(framer.feed(":2}\r\n\n", {}, sink));
+    ASSERT_EQ(frames.size(), 2u);
+    EXPECT_EQ(frames[0], "{\"a\":1}");
+    EXPECT_EQ(frames[1], "{\"b\":2}");
+}
+
+TEST(LineFramerTest, RejectsOversizedPartialLineOnce) {
+    transport::FrameLimits limits;
+    limits.max_frame_bytes = 16;
+    transport::LineFramer framer;
+    int rejected = 0;
+    std::vector<std::string> frames;
+    auto sink = [&](std::string_view line, transport::FrameError error) {
+        if (error == transport::FrameError::TooLarge) {
+            ++rejected;
+        } else {
+            frames.emplace_back(line);
+        }
+        return true;
+    };
+
+    // Many refills of one long line before its newline arrives
+    for (int i = 0; i < 10; ++i) {
+        framer.feed(std::string(10, 'x'), limits, sink);
+    }
+    framer.feed("xx\n[1]\n", limits, sink);
+    EXPECT_EQ(rejected, 1);
+    ASSERT_EQ(frames.size(), 1u);
+    EXPECT_EQ(frames[0], "[1]");
+}
+
+TEST(LineFramerTest, SinkCanStopFeeding) {
+    transport::LineFramer framer;
+    int calls = 0;
+    EXPECT_FALSE(framer.feed("[1]\n[2]\n", {}, [&](std::string_view, transport::FrameError) {
+        ++calls;
+        return false;
+    }));
+    EXPECT_EQ(calls, 1);
+}
@@ -0,0 +1,314 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+#include "mcpp/util/heartbeat.h"
+#include "mcpp/client.h"
+#include "mcpp/server/mcp_server.h"
+#include "mcpp/util/clock.h"
+#include "fixtures/common.h"
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mcpp;
+using namespace mcpp::test;
+using namespace std::chrono_literals;
+
+namespace {
+
+/// Records sends; never replies
+class SilentTransport : public transport::Transport {
+public:
+    bool connect() override { connected = true; return true; }
+    void disconnect() override { connected = false; }
+    bool is_connected() const override { return connected; }
+    bool send(std::string_view message) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        sent.emplace_back(message);
+        return true;
+    }
+    void set_message_callback(MessageCallback cb) override { on_message = std::move(cb); }
+    void set_error_callback(ErrorCallback) override {}
+
+    std::vector<std::string> take() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return std::move(sent);
+    }
+
+    std::atomic<bool> connected{false};
+    std::mutex mutex;
+    std::vector<std::string> sent;
+    MessageCallback on_message;
+};
+
+util::Heartbeat::Options manual_options(std::shared_ptr<util::ManualClock> clock) {
+    util::Heartbeat::Options options;
+    options.interval = 1000ms;
+    options.timeout = 100ms;
+    options.max_missed = 2;
+    options.metrics_prefix = "test.heartbeat";
+    options.clock = std::move(clock);
+    return options;
+}
+
+} // namespace
+
+TEST(HeartbeatTest, PingsWhenIdleAndTracksRtt) {
+    auto clock = std::make_shared<util::ManualClock>();
+    std::vector<util::Heartbeat::Pong> pongs;
+    util::Heartbeat heartbeat(manual_options(clock),
+        [&](util::Heartbeat::Pong pong) { pongs.push_back(std::move(pong)); }, {});
+
+    heartbeat.tick();
+    EXPECT_TRUE(pongs.empty());
+
+    clock->advance(1000ms);
+    heartbeat.tick();
+    ASSERT_EQ(pongs.size(), 1u);
+    clock->advance(40ms);
+    pongs[0]();
+
+    util::Heartbeat::Stats stats = heartbeat.stats();
+    EXPECT_EQ(stats.pings, 1u);
+    EXPECT_EQ(stats.pongs, 1u);
+    EXPECT_EQ(stats.srtt, 40ms);
+    EXPECT_EQ(stats.rttvar, 20ms);
+    EXPECT_EQ(stats.last_rtt, 40ms);
+
+    clock->advance(1000ms);
+    heartbeat.tick();
+    ASSERT_EQ(pongs.size(), 2u);
+    clock->advance(80ms);
+    pongs[1]();
+
+    stats = heartbeat.stats();
+    EXPECT_EQ(stats.last_rtt, 80ms);
+    EXPECT_EQ(stats.srtt, 45ms);    // 7/8 * 40 + 1/8 * 80
+    EXPECT_EQ(stats.rttvar, 25ms);  // 3/4 * 20 + 1/4 * |40 - 80|
+}
+
+TEST(HeartbeatTest, ActivityPostponesPing) {
+    auto clock = std::make_shared<util::ManualClock>();
+    int pings = 0;
+    util::Heartbeat heartbeat(manual_options(clock),
+        [&](util::Heartbeat::Pong) { ++pings; }, {});
+
+    clock->advance(900ms);
+    heartbeat.on_activity();
+    clock->advance(900ms);
+    heartbeat.tick();
+    EXPECT_EQ(pings, 0);
+
+    clock->advance(100ms);
+    heartbeat.tick();
+    EXPECT_EQ(pings, 1);
+}
+
+TEST(HeartbeatTest, DeclaresDeadAfterMissedPongs) {
+    auto clock = std::make_shared<util::ManualClock>();
+    std::vector<util::Heartbeat::Pong> pongs;
+    int dead = 0;
+    util::Heartbeat heartbeat(manual_options(clock),
+        [&](util::Heartbeat::Pong pong) { pongs.push_back(std::move(pong)); },
+        [&](const std::string&) { ++dead; });
+
+    clock->advance(1000ms);
+    heartbeat.tick();
+    ASSERT_EQ(pongs.size(), 1u);
+
+    // First miss retries at once
+    clock->advance(100ms);
+    heartbeat.tick();
+    EXPECT_EQ(pongs.size(), 2u);
+    EXPECT_EQ(heartbeat.stats().missed, 1u);
+    EXPECT_EQ(dead, 0);
+
+    // A late pong for the missed ping is ignored
+    pongs[0]();
+    EXPECT_EQ(heartbeat.stats().pongs, 0u);
+
+    clock->advance(100ms);
+    heartbeat.tick();
+    EXPECT_EQ(dead, 1);
+    EXPECT_TRUE(heartbeat.stats().dead);
+    EXPECT_EQ(heartbeat.stats().timeouts, 2u);
+
+    // Dead stays dead until reset
+    clock->advance(5000ms);
+    heartbeat.tick();
+    EXPECT_EQ(dead, 1);
+    EXPECT_EQ(pongs.size(), 2u);
+
+    heartbeat.reset();
+    EXPECT_FALSE(heartbeat.stats().dead);
+    clock->advance(1000ms);
+    heartbeat.tick();
+    EXPECT_EQ(pongs.size(), 3u);
+}
+
+TEST(HeartbeatTest, PongAfterDestructionIsSafe) {
+    auto clock = std::make_shared<util::ManualClock>();
+    util::Heartbeat::Pong pong;
+    {
+        util::Heartbeat heartbeat(manual_options(clock),
+            [&](util::Heartbeat::Pong p) { pong = std::move(p); }, {});
+        clock->advance(1000ms);
+        heartbeat.tick();
+    }
+    ASSERT_TRUE(pong);
+    pong();
+}
+
+TEST(HeartbeatTest, ServerAnswersPingBeforeRateLimits) {
+    server::McpServer server;
+    auto limiter = std::make_shared<server::RateLimiter>();
+    limiter->set_global({0.001, 1});
+    server.set_rate_limiter(limiter);
+
+    const nlohmann::json ping = {{"jsonrpc", "2.0"}, {"id", 7}, {"method", "ping"}};
+    for (int i = 0; i < 3; ++i) {
+        auto response = server.handle_request(ping);
+        ASSERT_TRUE(response);
+        EXPECT_EQ((*response)["id"], 7);
+        EXPECT_TRUE((*response)["result"].is_object());
+
+        auto serialized = server.handle_request_serialized(ping);
+        ASSERT_TRUE(serialized);
+        EXPECT_EQ(nlohmann::json::parse(*serialized), *response);
+    }
+}
+
+TEST(HeartbeatTest, ServerKeepaliveMatchesPongs) {
+    SilentTransport transport;
+    server::McpServer server;
+    server.set_transport(transport);
+
+    util::Heartbeat::Options options;
+    options.interval = 10ms;
+    options.timeout = 1000ms;
+    server.enable_keepalive(options);
+
+    std::string ping;
+    ASSERT_TRUE(eventually([&] {
+        auto sent = transport.take();
+        if (!sent.empty()) {
+            ping = sent.front();
+        }
+        return !ping.empty();
+    }));
+    auto request = nlohmann::json::parse(ping);
+    EXPECT_EQ(request["method"], "ping");
+
+    nlohmann::json pong = {{"jsonrpc", "2.0"}, {"id", request["id"]}, {"result", nlohmann::json::object()}};
+    EXPECT_FALSE(server.handle_request(pong));
+    EXPECT_TRUE(eventually([&] { return server.keepalive_stats()->pongs >= 1; }));
+    server.disable_keepalive();
+    EXPECT_FALSE(server.keepalive_stats());
+}
+
+TEST(HeartbeatTest, ServerKeepaliveDetectsDeadClient) {
+    SilentTransport transport;
+    server::McpServer server;
+    server.set_transport(transport);
+
+    util::Heartbeat::Options options;
+    options.interval = 10ms;
+    options.timeout = 20ms;
+    options.max_missed = 2;
+    std::atomic<int> dead{0};
+    server.enable_keepalive(options, [&](const std::string&) { ++dead; });
+
+    EXPECT_TRUE(eventually([&] { return dead.load() == 1; }));
+    EXPECT_TRUE(server.keepalive_stats()->dead);
+}
+
+TEST(HeartbeatTest, ClientFailsInFlightRequestsWhenServerIsDead) {
+    McpClient client(std::make_unique<SilentTransport>());
+    ASSERT_TRUE(client.connect());
+
+    std::atomic<bool> failed{false};
+    std::string message;
+    client.send_request("tools/list", nlohmann::json::object(),
+        [](const nlohmann::json&) {},
+        [&](const core::JsonRpcError& error) {
+            message = error.message;
+            failed = true;
+        });
+
+    std::atomic<int> lost{0};
+    client.set_connection_lost_handler([&](std::string_view) { ++lost; });
+
+    util::Heartbeat::Options options;
+    options.interval = 10ms;
+    options.timeout = 20ms;
+    options.max_missed = 2;
+    client.enable_keepalive(options);
+
+    ASSERT_TRUE(eventually([&] { return lost.load() == 1; }));
+    EXPECT_TRUE(failed);
+    EXPECT_EQ(message.rfind("Connection lost", 0), 0u);
+    EXPECT_GE(client.keepalive_stats()->pings, 2u);
+    EXPECT_TRUE(client.keepalive_stats()->dead);
+}
+
+TEST(HeartbeatTest, DeadCallbackMayDestroyHeartbeat) {
+    util::Heartbeat::Options options;
+    options.interval = 10ms;
+    options.timeout = 20ms;
+    options.max_missed = 1;
+
+    std::atomic<bool> destroyed{false};
+    auto heartbeat = std::make_shared<std::unique_ptr<util::Heartbeat>>();
+    *heartbeat = std::make_unique<util::Heartbeat>(options, [](util::Heartbeat::Pong) {},
+        [&, heartbeat](const std::string&) {
+            heartbeat->reset();  // stops from the timer thread
+            destroyed = true;
+        });
+    (*heartbeat)->start();
+
+    ASSERT_TRUE(eventually([&] { return destroyed.load(); }));
+}
+
+TEST(HeartbeatTest, ClientLostHandlerMayDisableKeepalive) {
+    McpClient client(std::make_unique<SilentTransport>());
+    ASSERT_TRUE(client.connect());
+
+    std::atomic<int> lost{0};
+    client.set_connection_lost_handler([&](std::string_view) {
+        client.disable_keepalive();
+        ++lost;
+    });
+
+    util::Heartbeat::Options options;
+    options.interval = 10ms;
+    options.timeout = 20ms;
+    options.max_missed = 1;
+    client.enable_keepalive(options);
+
+    ASSERT_TRUE(eventually([&] { return lost.load() == 1; }));
+    EXPECT_FALSE(client.keepalive_stats());
+}
+
+TEST(HeartbeatTest, ClientAnswersServerPing) {
+    auto owned = std::make_unique<SilentTransport>();
+    SilentTransport* transport = owned.get();
+    McpClient client(std::move(owned));
+    ASSERT_TRUE(client.connect());
+
+    transport->on_message(R"({"jsonrpc":"2.0","id":"mcpp-ping-1","method":"ping"})");
+    auto sent = transport->take();
+    ASSERT_EQ(sent.size(), 1u);
+    auto response = nlohmann::json::parse(sent[0]);
+    EXPECT_EQ(response["id"], "mcpp-ping-1");
+    EXPECT_TRUE(response["result"].is_object());
+}
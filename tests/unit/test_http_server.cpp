@@ -0,0 +1,451 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+#include "mcpp/transport/http_server.h"
+#include "mcpp/server/mcp_server.h"
+#include "mcpp/server/tenant.h"
+#include "mcpp/transport/null_transport.h"
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+using namespace mcpp;
+using namespace mcpp::transport;
+using namespace std::chrono_literals;
+
+namespace {
+
+/// Body of a sessionless POST that opens a session
+const std::string INITIALIZE = R"({"jsonrpc":"2.0","id":0,"method":"initialize","params":{}})";
+
+struct Response {
+    int status = 0;
+    std::map<std::string, std::string> headers;  ///< Lowercased names
+    std::string body;
+};
+
+int connect_to(uint16_t port) {
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    ::inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    timeval tv{2, 0};
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    return fd;
+}
+
+void send_all(int fd, const std::string& data) {
+    size_t off = 0;
+    while (off < data.size()) {
+        ssize_t n = ::write(fd, data.data() + off, data.size() - off);
+        if (n <= 0) {
+            return;
+        }
+        off += static_cast<size_t>(n);
+    }
+}
+
+std::string build_request(const std::string& method, const std::string& session,
+                          const std::string& body, const std::string& path = "/mcp") {
+    std::string req = method + " " + path + " HTTP/1.1\r\nHost: localhost\r\n";
+    if (!session.empty()) {
+        req += "Mcp-Session-Id: " + session + "\r\n";
+    }
+    req += "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+    return req;
+}
+
+/// Read one Content-Length delimited response from a keep-alive connection
+bool read_response(int fd, std::string& buffer, Response& out) {
+    while (true) {
+        size_t head_end = buffer.find("\r\n\r\n");
+        if (head_end != std::string::npos) {
+            out = Response{};
+            out.status = std::stoi(buffer.substr(9, 3));
+            size_t pos = buffer.find("\r\n") + 2;
+            while (pos < head_end) {
+                size_t end = buffer.find("\r\n", pos);
+                std::string line = buffer.substr(pos, end - pos);
+                size_t colon = line.find(':');
+                std::string name = line.substr(0, colon);
+                for (char& c : name) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+                out.headers[name] = line.substr(colon + 2);
+                pos = end + 2;
+            }
+            size_t length = std::stoul(out.headers["content-length"]);
+            if (buffer.size() >= head_end + 4 + length) {
+                out.body = buffer.substr(head_end + 4, length);
+                buffer.erase(0, head_end + 4 + length);
+                return true;
+            }
+        }
+        char chunk[4096];
+        ssize_t n = ::read(fd, chunk, sizeof(chunk));
+        if (n <= 0) {
+            return false;
+        }
+        buffer.append(chunk, static_cast<size_t>(n));
+    }
+}
+
+Response request(uint16_t port, const std::string& method, const std::string& session,
+                 const std::string& body = "", const std::string& path = "/mcp") {
+    Response response;
+    int fd = connect_to(port);
+    if (fd < 0) {
+        return response;
+    }
+    send_all(fd, build_request(method, session, body, path));
+    std::string buffer;
+    read_response(fd, buffer, response);
+    ::close(fd);
+    return response;
+}
+
+/// Read from an SSE stream until @p needle shows up (or timeout)
+std::string read_until(int fd, std::string& buffer, const std::string& needle) {
+    while (buffer.find(needle) == std::string::npos) {
+        char chunk[4096];
+        ssize_t n = ::read(fd, chunk, sizeof(chunk));
+        if (n <= 0) {
+            break;
+        }
+        buffer.append(chunk, static_cast<size_t>(n));
+    }
+    return buffer;
+}
+
+} // namespace
+
+class HttpServerTest : public ::testing::Test {
+protected:
+    void start(size_t shards, size_t max_sessions = 0) {
+        HttpServer::Options options;
+        options.shards = shards;
+        options.max_sessions = max_sessions;
+        server = std::make_unique<HttpServer>(options, [this](size_t shard) {
+            // Per-shard handler: counts requests per session without locks
+            return [this, shard](HttpServer::Session& session, std::string_view body)
+                       -> std::optional<std::string> {
+                if (session.shard() != shard) {
+                    misrouted = true;
+                }
+                if (!session.state) {
+                    session.state = std::make_shared<int>(0);
+                }
+                int& count = *std::static_pointer_cast<int>(session.state);
+                ++count;
+                if (body == "notify") {
+                    return std::nullopt;
+                }
+                return "{\"count\":" + std::to_string(count) + "}";
+            };
+        });
+        ASSERT_TRUE(server->start());
+        ASSERT_NE(server->port(), 0);
+    }
+
+    std::unique_ptr<HttpServer> server;
+    std::atomic<bool> misrouted{false};
+};
+
+TEST(HttpServerIdTest, ShardIsEncodedInSessionId) {
+    EXPECT_EQ(HttpServer::shard_of("0003" + std::string(28, 'a')), 3u);
+    EXPECT_EQ(HttpServer::shard_of("00ff" + std::string(28, '0')), 255u);
+    EXPECT_FALSE(HttpServer::shard_of("short"));
+    EXPECT_FALSE(HttpServer::shard_of("0003" + std::string(28, 'Z')));
+}
+
+TEST_F(HttpServerTest, PostCreatesSessionAndKeepsState) {
+    start(1);
+    Response first = request(server->port(), "POST", "", INITIALIZE);
+    ASSERT_EQ(first.status, 200);
+    EXPECT_EQ(first.headers["content-type"], "application/json");
+    EXPECT_EQ(first.body, "{\"count\":1}");
+    std::string session = first.headers["mcp-session-id"];
+    ASSERT_EQ(session.size(), 32u);
+    EXPECT_EQ(HttpServer::shard_of(session), 0u);
+
+    Response second = request(server->port(), "POST", session, "{}");
+    EXPECT_EQ(second.status, 200);
+    EXPECT_EQ(second.body, "{\"count\":2}");
+
+    Response notify = request(server->port(), "POST", session, "notify");
+    EXPECT_EQ(notify.status, 202);
+    EXPECT_EQ(server->session_count(), 1u);
+}
+
+TEST_F(HttpServerTest, RejectsUnknownSessionsPathsAndMethods) {
+    start(2);
+    EXPECT_EQ(request(server->port(), "POST", "0000" + std::string(28, 'a'), "{}").status, 404);
+    EXPECT_EQ(request(server->port(), "POST", "not-a-session", "{}").status, 404);
+    EXPECT_EQ(request(server->port(), "POST", "", INITIALIZE, "/other").status, 404);
+    EXPECT_EQ(request(server->port(), "PUT", "", "{}").status, 405);
+    EXPECT_EQ(request(server->port(), "GET", "").status, 400);
+    EXPECT_EQ(request(server->port(), "POST", "", "{\"a\":\"\xc0\xaf\"}").status, 400);
+}
+
+TEST_F(HttpServerTest, OnlyInitializeOpensSessions) {
+    start(2, 2);
+    EXPECT_EQ(request(server->port(), "POST", "", "{}").status, 400);
+    EXPECT_EQ(request(server->port(), "POST", "", R"({"params":{"method":"initialize"},"method":"tools/list"})").status, 400);
+    EXPECT_EQ(request(server->port(), "POST", "", "[" + INITIALIZE + "]").status, 400);
+    EXPECT_EQ(server->session_count(), 0u);
+
+    EXPECT_EQ(request(server->port(), "POST", "", INITIALIZE).status, 200);
+    EXPECT_EQ(request(server->port(), "POST", "", INITIALIZE).status, 200);
+    Response full = request(server->port(), "POST", "", INITIALIZE);
+    EXPECT_EQ(full.status, 503);
+    EXPECT_EQ(full.headers["retry-after"], "1");
+    EXPECT_EQ(server->session_count(), 2u);
+}
+
+TEST_F(HttpServerTest, FollowUpRequestsReachTheOwningShard) {
+    start(4);
+    std::vector<std::string> sessions;
+    for (int i = 0; i < 8; ++i) {
+        Response created = request(server->port(), "POST", "", INITIALIZE);
+        ASSERT_EQ(created.status, 200);
+        sessions.push_back(created.headers["mcp-session-id"]);
+    }
+    // Each follow-up opens a new connection, which the kernel may give to
+    // any shard; the server must route it to the session's owner
+    for (int round = 0; round < 4; ++round) {
+        for (const auto& session : sessions) {
+            Response r = request(server->port(), "POST", session, "{}");
+            ASSERT_EQ(r.status, 200);
+            EXPECT_EQ(r.body, "{\"count\":" + std::to_string(round + 2) + "}");
+        }
+    }
+    EXPECT_FALSE(misrouted);
+    EXPECT_EQ(server->session_count(), sessions.size());
+}
+
+TEST_F(HttpServerTest, KeepAliveConnectionServesSessionsOfAnyShard) {
+    start(4);
+    std::vector<std::string> sessions;
+    for (int i = 0; i < 6; ++i) {
+        sessions.push_back(request(server->port(), "POST", "", INITIALIZE).headers["mcp-session-id"]);
+    }
+    int fd = connect_to(server->port());
+    ASSERT_GE(fd, 0);
+    std::string buffer;
+    for (const auto& session : sessions) {
+        send_all(fd, build_request("POST", session, "{}"));
+        Response r;
+        ASSERT_TRUE(read_response(fd, buffer, r));
+        EXPECT_EQ(r.status, 200);
+        EXPECT_EQ(r.body, "{\"count\":2}");
+    }
+    // Pipelined requests on one connection still answer in order
+    send_all(fd, build_request("POST", sessions[0], "{}") + build_request("POST", sessions[1], "{}"));
+    Response a, b;
+    ASSERT_TRUE(read_response(fd, buffer, a));
+    ASSERT_TRUE(read_response(fd, buffer, b));
+    EXPECT_EQ(a.body, "{\"count\":3}");
+    EXPECT_EQ(b.body, "{\"count\":3}");
+    ::close(fd);
+    EXPECT_FALSE(misrouted);
+}
+
+TEST_F(HttpServerTest, SseStreamDeliversAndResumes) {
+    start(2);
+    std::string session = request(server->port(), "POST", "", INITIALIZE).headers["mcp-session-id"];
+    ASSERT_FALSE(session.empty());
+
+    // Queued before any stream exists
+    ASSERT_TRUE(server->send(session, "{\"n\":1}"));
+
+    int fd = connect_to(server->port());
+    send_all(fd, build_request("GET", session, ""));
+    std::string stream;
+    read_until(fd, stream, "{\"n\":1}");
+    EXPECT_NE(stream.find("text/event-stream"), std::string::npos);
+    EXPECT_NE(stream.find("id: 1\ndata: {\"n\":1}\n\n"), std::string::npos);
+
+    ASSERT_TRUE(server->send(session, "{\"n\":2}"));
+    read_until(fd, stream, "{\"n\":2}");
+    EXPECT_NE(stream.find("id: 2\ndata: {\"n\":2}\n\n"), std::string::npos);
+    ::close(fd);
+
+    // Resume after event 1 replays event 2 only
+    fd = connect_to(server->port());
+    send_all(fd, "GET /mcp HTTP/1.1\r\nMcp-Session-Id: " + session + "\r\nLast-Event-ID: 1\r\n\r\n");
+    std::string resumed;
+    read_until(fd, resumed, "{\"n\":2}");
+    EXPECT_EQ(resumed.find("{\"n\":1}"), std::string::npos);
+    EXPECT_NE(resumed.find("{\"n\":2}"), std::string::npos);
+    ::close(fd);
+}
+
+TEST_F(HttpServerTest, DeleteEndsSession) {
+    start(2);
+    std::string session = request(server->port(), "POST", "", INITIALIZE).headers["mcp-session-id"];
+    EXPECT_EQ(request(server->port(), "DELETE", session).status, 200);
+    EXPECT_EQ(request(server->port(), "POST", session, "{}").status, 404);
+    EXPECT_EQ(request(server->port(), "DELETE", session).status, 404);
+    EXPECT_EQ(server->session_count(), 0u);
+}
+
+TEST_F(HttpServerTest, IdleSessionsExpire) {
+    HttpServer::Options options;
+    options.shards = 1;
+    options.session_timeout = 50ms;
+    options.sweep_interval = 10ms;
+    server = std::make_unique<HttpServer>(options, HttpServer::Handler(
+        [](HttpServer::Session&, std::string_view) { return std::optional<std::string>("{}"); }));
+    ASSERT_TRUE(server->start());
+    std::string session = request(server->port(), "POST", "", INITIALIZE).headers["mcp-session-id"];
+    EXPECT_EQ(server->session_count(), 1u);
+    for (int i = 0; i < 100 && server->session_count() != 0; ++i) {
+        std::this_thread::sleep_for(10ms);
+    }
+    EXPECT_EQ(server->session_count(), 0u);
+    EXPECT_EQ(request(server->port(), "POST", session, "{}").status, 404);
+}
+
+TEST(HttpServerTenantTest, SessionsOnOneShardKeepTheirOwnTenant) {
+    transport::NullTransport null_transport;
+    server::McpServer mcp("tenants", "1.0.0");
+    mcp.set_transport(null_transport);
+    auto tool = [](const std::string&, const nlohmann::json&, server::RequestContext&) {
+        return nlohmann::json{{"content", nlohmann::json::array()}};
+    };
+    mcp.register_tool("shared", "", {{"type", "object"}}, tool);
+    mcp.register_tool("acme_only", "", {{"type", "object"}}, tool);
+
+    auto tenants = std::make_shared<server::TenantManager>();
+    server::TenantConfig acme;
+    acme.tools = std::unordered_set<std::string>{"shared", "acme_only"};
+    tenants->set_tenant("acme", acme);
+    server::TenantConfig globex;
+    globex.tools = std::unordered_set<std::string>{"shared"};
+    tenants->set_tenant("globex", globex);
+    mcp.set_tenants(tenants);
+
+    // One shard, so both sessions share the McpServer and its thread
+    HttpServer::Options options;
+    options.shards = 1;
+    options.on_session_closed = [&](HttpServer::Session& session) { mcp.end_session(session.id()); };
+    HttpServer http(options, HttpServer::Handler([&](HttpServer::Session&, std::string_view body) {
+        return mcp.handle_raw_message(body);
+    }));
+    ASSERT_TRUE(http.start());
+
+    auto initialize = [&](const std::string& tenant) {
+        nlohmann::json message = {{"jsonrpc", "2.0"}, {"id", 0}, {"method", "initialize"},
+                                  {"params", {{"protocolVersion", "2025-11-25"},
+                                              {"capabilities", nlohmann::json::object()},
+                                              {"clientInfo", {{"name", "test"}, {"version", "1"}}},
+                                              {"_meta", {{"tenant", tenant}}}}}};
+        return request(http.port(), "POST", "", message.dump()).headers["mcp-session-id"];
+    };
+    auto tool_count = [&](const std::string& session) {
+        Response response = request(http.port(), "POST", session,
+                                    R"({"jsonrpc":"2.0","id":1,"method":"tools/list"})");
+        return nlohmann::json::parse(response.body)["result"]["tools"].size();
+    };
+
+    std::string acme_session = initialize("acme");
+    std::string globex_session = initialize("globex");
+    ASSERT_FALSE(acme_session.empty());
+    ASSERT_FALSE(globex_session.empty());
+
+    // Binding globex must not rebind the acme session
+    EXPECT_EQ(tool_count(acme_session), 2u);
+    EXPECT_EQ(tool_count(globex_session), 1u);
+    EXPECT_EQ(tenants->tenant_id_for(acme_session), "acme");
+    EXPECT_EQ(tenants->tenant_id_for(globex_session), "globex");
+
+    EXPECT_EQ(request(http.port(), "DELETE", acme_session).status, 200);
+    EXPECT_EQ(tenants->tenant_id_for(acme_session), "");
+    EXPECT_EQ(tenants->tenant_id_for(globex_session), "globex");
+}
+
+TEST_F(HttpServerTest, ReleasedListenersServeReplacement) {
+    start(2);
+    Response before = request(server->port(), "POST", "", INITIALIZE);
+    ASSERT_EQ(before.status, 200);
+
+    std::vector<int> fds = server->release_listeners();
+    ASSERT_EQ(fds.size(), 2u);
+
+    HttpServer::Options options;
+    options.shards = 3;
+    options.listen_fds = fds;
+    HttpServer replacement(options, HttpServer::Handler(
+        [](HttpServer::Session&, std::string_view) { return std::optional<std::string>("{\"new\":true}"); }));
+    ASSERT_TRUE(replacement.start());
+    EXPECT_EQ(replacement.port(), server->port());
+
+    // New connections reach the replacement; the old server still runs
+    for (int i = 0; i < 10; ++i) {
+        Response after = request(server->port(), "POST", "", INITIALIZE);
+        EXPECT_EQ(after.status, 200);
+        EXPECT_EQ(after.body, "{\"new\":true}");
+    }
+    EXPECT_TRUE(server->is_running());
+    EXPECT_TRUE(server->drain(1s));
+    EXPECT_FALSE(server->is_running());
+    EXPECT_EQ(request(replacement.port(), "POST", "", INITIALIZE).status, 200);
+}
+
+TEST(HttpServerDrainTest, FinishesInFlightRequestThenStops) {
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::atomic<bool> entered{false};
+    HttpServer::Options options;
+    options.shards = 1;
+    HttpServer server(options, HttpServer::Handler(
+        [&](HttpServer::Session&, std::string_view) {
+            entered = true;
+            released.wait();
+            return std::optional<std::string>("{}");
+        }));
+    ASSERT_TRUE(server.start());
+
+    int fd = connect_to(server.port());
+    ASSERT_GE(fd, 0);
+    send_all(fd, build_request("POST", "", INITIALIZE));
+    while (!entered) {
+        std::this_thread::sleep_for(1ms);
+    }
+
+    auto drained = std::async(std::launch::async, [&] { return server.drain(2s); });
+    std::this_thread::sleep_for(20ms);
+    release.set_value();
+    EXPECT_TRUE(drained.get());
+    EXPECT_FALSE(server.is_running());
+
+    // The in-flight request was answered, and told to reconnect elsewhere
+    std::string buffer;
+    Response response;
+    ASSERT_TRUE(read_response(fd, buffer, response));
+    EXPECT_EQ(response.status, 200);
+    EXPECT_EQ(response.headers["connection"], "close");
+    ::close(fd);
+    EXPECT_LT(connect_to(server.port()), 0);
+}
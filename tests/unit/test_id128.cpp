@@ -0,0 +1,74 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+#include "mcpp/util/id128.h"
+#include "mcpp/transport/http_transport.h"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <unordered_set>
+
+using namespace mcpp;
+
+TEST(Id128, FormatsHexAndUuid) {
+    util::Id128 id{0x0123456789abcdefULL, 0xfedcba9876543210ULL};
+    EXPECT_EQ(id.to_hex(), "0123456789abcdeffedcba9876543210");
+    EXPECT_EQ(id.to_uuid(), "01234567-89ab-cdef-fedc-ba9876543210");
+}
+
+TEST(Id128, FormatsBase32) {
+    EXPECT_EQ(util::Id128{}.to_base32(), std::string(26, 'a'));
+    EXPECT_EQ((util::Id128{~0ULL, ~0ULL}.to_base32()), std::string(25, '7') + "4");
+    // Top five bits first: 0b00001 -> 'b'
+    EXPECT_EQ((util::Id128{1ULL << 59, 0}.to_base32()), "b" + std::string(25, 'a'));
+    // Lowest bit lands in the last character's third bit: 0b00100 -> 'e'
+    EXPECT_EQ((util::Id128{0, 1}.to_base32()), std::string(25, 'a') + "e");
+}
+
+TEST(Id128, ParseRoundTripsBothForms) {
+    util::Id128 id{0xdeadbeef00000001ULL, 0x8000000000000abcULL};
+    EXPECT_EQ(util::Id128::parse(id.to_hex()), id);
+    EXPECT_EQ(util::Id128::parse(id.to_uuid()), id);
+}
+
+TEST(Id128, ParseRejectsMalformed) {
+    EXPECT_FALSE(util::Id128::parse(""));
+    EXPECT_FALSE(util::Id128::parse("0123"));
+    EXPECT_FALSE(util::Id128::parse(std::string(32, 'A')));   // uppercase
+    EXPECT_FALSE(util::Id128::parse(std::string(32, 'g')));
+    EXPECT_FALSE(util::Id128::parse(std::string(36, '0')));   // no dashes
+    EXPECT_FALSE(util::Id128::parse("01234567-89ab-cdef-fedc_ba9876543210"));
+}
+
+TEST(Id128, UuidV4Bits) {
+    util::Id128 id = util::Id128{~0ULL, ~0ULL}.as_uuid_v4();
+    std::string uuid = id.to_uuid();
+    EXPECT_EQ(uuid[14], '4');
+    EXPECT_EQ(uuid[19], 'b');
+    id = util::Id128{0, 0}.as_uuid_v4();
+    EXPECT_EQ(id.to_uuid()[19], '8');
+}
+
+TEST(Id128, HashSetLookup) {
+    std::unordered_set<util::Id128, util::Id128Hash> ids;
+    ids.insert({1, 2});
+    ids.insert({2, 1});
+    EXPECT_EQ(ids.size(), 2u);
+    EXPECT_EQ(ids.count(util::Id128{1, 2}), 1u);
+    EXPECT_EQ(ids.count(util::Id128{1, 1}), 0u);
+}
+
+TEST(Id128, HttpTransportSessionsKeyedByBinaryId) {
+    transport::HttpTransport transport;
+    std::string session = transport.create_session();
+    ASSERT_EQ(session.size(), util::Id128::UUID_LENGTH);
+    EXPECT_EQ(session[14], '4');
+    EXPECT_TRUE(transport.validate_session(session));
+    EXPECT_FALSE(transport.validate_session(util::Id128::parse(session)->to_hex() + "x"));
+    EXPECT_TRUE(transport.terminate_session(session));
+    EXPECT_FALSE(transport.validate_session(session));
+    EXPECT_FALSE(transport.terminate_session("not-a-session"));
+}
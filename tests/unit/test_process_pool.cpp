@@ -0,0 +1,214 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+#include "mcpp/client/process_pool.h"
+#include "mcpp/transport/process_transport.h"
+#include "fixtures/common.h"
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mcpp;
+using namespace mcpp::test;
+using namespace mcpp::client;
+using namespace std::chrono_literals;
+
+namespace {
+
+ProcessPool::Launcher fake_launcher(std::shared_ptr<FakeServerState> state) {
+    return [state](std::string&) -> std::unique_ptr<transport::Transport> {
+        return std::make_unique<FakeServerTransport>(state);
+    };
+}
+
+ProcessPool::Options fast_options() {
+    ProcessPool::Options options;
+    options.maintenance_interval = 5ms;
+    options.health_check_interval = 0ms;
+    return options;
+}
+
+} // namespace
+
+TEST(ProcessPoolTest, PrewarmsMinIdleServers) {
+    auto options = fast_options();
+    options.min_idle = 2;
+    ProcessPool pool(fake_launcher(std::make_shared<FakeServerState>()), options);
+    pool.start();
+
+    ASSERT_TRUE(pool.wait_ready(2s));
+    auto stats = pool.stats();
+    EXPECT_EQ(stats.idle, 2u);
+    EXPECT_EQ(stats.spawned, 2u);
+}
+
+TEST(ProcessPoolTest, LeaseHandsOutInitializedClientAndReturnsIt) {
+    ProcessPool pool(fake_launcher(std::make_shared<FakeServerState>()), fast_options());
+    pool.start();
+    ASSERT_TRUE(pool.wait_ready(2s));
+
+    {
+        auto lease = pool.acquire(1s);
+        ASSERT_TRUE(lease);
+        EXPECT_EQ(lease.server_info().serverInfo.name, "fake");
+        EXPECT_TRUE(lease->is_connected());
+        EXPECT_EQ(pool.stats().leased, 1u);
+    }
+
+    auto stats = pool.stats();
+    EXPECT_EQ(stats.leased, 0u);
+    EXPECT_EQ(stats.idle, 1u);
+    EXPECT_EQ(stats.spawned, 1u);
+    EXPECT_EQ(stats.acquired, 1u);
+}
+
+TEST(ProcessPoolTest, RecyclesServerAfterMaxUses) {
+    auto options = fast_options();
+    options.max_uses = 2;
+    ProcessPool pool(fake_launcher(std::make_shared<FakeServerState>()), options);
+    pool.start();
+    ASSERT_TRUE(pool.wait_ready(2s));
+
+    pool.acquire(1s).release();
+    EXPECT_EQ(pool.stats().retired, 0u);
+    pool.acquire(1s).release();
+
+    EXPECT_TRUE(eventually([&]() {
+        auto stats = pool.stats();
+        return stats.retired == 1 && stats.spawned == 2 && stats.idle == 1;
+    }));
+}
+
+TEST(ProcessPoolTest, DiscardedLeaseIsReplaced) {
+    ProcessPool pool(fake_launcher(std::make_shared<FakeServerState>()), fast_options());
+    pool.start();
+    ASSERT_TRUE(pool.wait_ready(2s));
+
+    {
+        auto lease = pool.acquire(1s);
+        ASSERT_TRUE(lease);
+        lease.discard();
+    }
+
+    EXPECT_TRUE(eventually([&]() {
+        auto stats = pool.stats();
+        return stats.retired == 1 && stats.idle == 1;
+    }));
+}
+
+TEST(ProcessPoolTest, GrowsToMaxSizeThenShrinksBackToMinIdle) {
+    auto options = fast_options();
+    options.max_size = 3;
+    options.idle_timeout = 50ms;
+    ProcessPool pool(fake_launcher(std::make_shared<FakeServerState>()), options);
+    pool.start();
+
+    std::vector<ProcessPool::Lease> leases;
+    for (int i = 0; i < 3; ++i) {
+        leases.push_back(pool.acquire(2s));
+        ASSERT_TRUE(leases.back());
+    }
+    EXPECT_FALSE(pool.acquire(50ms));
+    EXPECT_EQ(pool.stats().acquire_timeouts, 1u);
+
+    leases.clear();
+    EXPECT_TRUE(eventually([&]() { return pool.stats().idle == 1; }));
+    EXPECT_EQ(pool.stats().retired, 2u);
+}
+
+TEST(ProcessPoolTest, UnresponsiveServerFailsHealthCheck) {
+    auto state = std::make_shared<FakeServerState>();
+    auto options = fast_options();
+    options.health_check_interval = 10ms;
+    options.ping_timeout = 30ms;
+    ProcessPool pool(fake_launcher(state), options);
+    pool.start();
+    ASSERT_TRUE(pool.wait_ready(2s));
+
+    EXPECT_TRUE(eventually([&]() { return state->pings > 0; }));
+    EXPECT_EQ(pool.stats().health_failures, 0u);
+
+    state->answer_pings = false;
+    EXPECT_TRUE(eventually([&]() {
+        auto stats = pool.stats();
+        return stats.health_failures >= 1 && stats.retired >= 1;
+    }));
+}
+
+TEST(ProcessPoolTest, AcquireAfterStopReturnsEmptyLease) {
+    ProcessPool pool(fake_launcher(std::make_shared<FakeServerState>()), fast_options());
+    pool.start();
+    ASSERT_TRUE(pool.wait_ready(2s));
+    auto lease = pool.acquire(1s);
+    ASSERT_TRUE(lease);
+
+    pool.stop();
+    EXPECT_FALSE(pool.acquire(10ms));
+    lease.release();
+    EXPECT_EQ(pool.stats().leased, 0u);
+}
+
+TEST(ProcessTransportTest, EchoesThroughChildAndTerminatesIt) {
+    std::string error;
+    auto transport = transport::ProcessTransport::spawn("cat", {}, error);
+    ASSERT_TRUE(transport) << error;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<std::string> received;
+    transport->set_message_callback([&](std::string_view message) {
+        std::lock_guard<std::mutex> lock(mutex);
+        received.emplace_back(message);
+        cv.notify_all();
+    });
+    ASSERT_TRUE(transport->connect());
+    ASSERT_TRUE(transport->send(R"({"jsonrpc":"2.0","method":"a"})"));
+    ASSERT_TRUE(transport->send(R"({"jsonrpc":"2.0","method":"b"})"));
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ASSERT_TRUE(cv.wait_for(lock, 2s, [&]() { return received.size() == 2; }));
+    }
+    EXPECT_EQ(received[1], R"({"jsonrpc":"2.0","method":"b"})");
+
+    EXPECT_TRUE(transport->is_alive());
+    transport->disconnect();
+    transport->terminate();
+    EXPECT_FALSE(transport->is_alive());
+    EXPECT_FALSE(transport->send("{}"));
+}
+
+TEST(ProcessTransportTest, SpawnReportsMissingCommand) {
+    std::string error;
+    auto transport = transport::ProcessTransport::spawn("/nonexistent/mcp-server", {}, error);
+    EXPECT_FALSE(transport);
+    EXPECT_FALSE(error.empty());
+}
+
+TEST(ProcessPoolTest, PrewarmsRealChildProcesses) {
+    // A stdio "server" that answers initialize by rewriting the request
+    const std::string script =
+        R"(s/^{"id":\([0-9]*\),"jsonrpc":"2.0","method":"initialize".*/)"
+        R"({"jsonrpc":"2.0","id":\1,"result":{"protocolVersion":"2025-11-25",)"
+        R"("capabilities":{},"serverInfo":{"name":"sed","version":"1"}}}/p)";
+    auto options = fast_options();
+    options.min_idle = 2;
+    ProcessPool pool("sed", {"-u", "-n", script}, options);
+    pool.start();
+
+    ASSERT_TRUE(pool.wait_ready(5s));
+    auto lease = pool.acquire(1s);
+    ASSERT_TRUE(lease);
+    EXPECT_EQ(lease.server_info().serverInfo.name, "sed");
+}
@@ -397,3 +397,88 @@ TEST(PromptRegistry, PromptContent_WithStructuredContent) {
     EXPECT_EQ((*result)["messages"][0]["role"], "user");
     EXPECT_EQ((*result)["messages"][0]["content"]["type"], "text");
 }
+
+// ============================================================================
+// Declarative templates
+// ============================================================================
+
+TEST(PromptTemplate, CompilesLiteralAndSlotSegments) {
+    PromptTemplate tmpl("Hello, {{ name }}! You are {{age}} ({{name}}).");
+
+    EXPECT_EQ(tmpl.placeholders(), (std::vector<std::string>{"name", "age"}));
+    EXPECT_EQ(tmpl.render({{"name", "Ada"}, {"age", 36}}), "Hello, Ada! You are 36 (Ada).");
+    EXPECT_EQ(tmpl.render(nlohmann::json::object()), "Hello, ! You are  ().");
+}
+
+TEST(PromptTemplate, KeepsMalformedPlaceholdersAsLiterals) {
+    PromptTemplate tmpl("{{}} {{{x}} {{open");
+
+    EXPECT_EQ(tmpl.placeholders(), std::vector<std::string>{"x"});
+    EXPECT_EQ(tmpl.render({{"x", "1"}}), "{{}} {1 {{open");
+    EXPECT_EQ(PromptTemplate("{{}} and {{open").render({{"open", "no"}}), "{{}} and {{open");
+    EXPECT_EQ(PromptTemplate("{{{x}}").render({{"x", "1"}}), "{1");
+}
+
+TEST(PromptRegistry, TemplatePrompt_RendersTextMessages) {
+    PromptRegistry registry;
+
+    bool registered = registry.register_prompt(
+        "review",
+        "Code review",
+        {{"language", std::nullopt, true}, {"code", std::nullopt, true}},
+        std::vector<PromptMessageTemplate>{
+            {"assistant", "You are a careful {{language}} reviewer."},
+            {"user", "Review:\n{{code}}"}
+        }
+    );
+    ASSERT_TRUE(registered);
+
+    auto result = registry.get_prompt("review", {{"language", "C++"}, {"code", "int x;"}});
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ((*result)["messages"].size(), 2u);
+    EXPECT_EQ((*result)["messages"][0]["role"], "assistant");
+    EXPECT_EQ((*result)["messages"][0]["content"]["type"], "text");
+    EXPECT_EQ((*result)["messages"][0]["content"]["text"], "You are a careful C++ reviewer.");
+    EXPECT_EQ((*result)["messages"][1]["content"]["text"], "Review:\nint x;");
+
+    // Unreferenced arguments don't affect the cached result
+    auto again = registry.get_prompt("review", {{"language", "C++"}, {"code", "int x;"}, {"extra", 1}});
+    EXPECT_EQ(*again, *result);
+
+    auto other = registry.get_prompt("review", {{"language", "Rust"}, {"code", "let x;"}});
+    EXPECT_EQ((*other)["messages"][1]["content"]["text"], "Review:\nlet x;");
+}
+
+TEST(PromptRegistry, RenderCache_SkipsDeterministicHandler) {
+    PromptRegistry registry;
+    int calls = 0;
+
+    registry.register_prompt(
+        "echo",
+        std::nullopt,
+        {{"text", std::nullopt, true}},
+        [&calls](const std::string&, const nlohmann::json& args) {
+            ++calls;
+            return std::vector<PromptMessage>{
+                {"user", {{"type", "text"}, {"text", args.value("text", "")}}}
+            };
+        }
+    );
+
+    registry.get_prompt("echo", {{"text", "a"}});
+    registry.get_prompt("echo", {{"text", "a"}});
+    EXPECT_EQ(calls, 2);
+
+    ASSERT_TRUE(registry.set_render_cache("echo", 1));
+    EXPECT_FALSE(registry.set_render_cache("missing", 1));
+
+    registry.get_prompt("echo", {{"text", "a"}});
+    auto cached = registry.get_prompt("echo", {{"text", "a"}});
+    EXPECT_EQ(calls, 3);
+    EXPECT_EQ((*cached)["messages"][0]["content"]["text"], "a");
+
+    // Capacity 1: a new key evicts the old one
+    registry.get_prompt("echo", {{"text", "b"}});
+    registry.get_prompt("echo", {{"text", "a"}});
+    EXPECT_EQ(calls, 5);
+}
@@ -0,0 +1,305 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+#include "mcpp/server/rate_limiter.h"
+#include "mcpp/server/mcp_server.h"
+#include "mcpp/transport/null_transport.h"
+#include "mcpp/util/metrics.h"
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mcpp;
+using namespace mcpp::server;
+using namespace std::chrono_literals;
+
+namespace {
+
+std::shared_ptr<util::ManualClock> make_clock() {
+    return std::make_shared<util::ManualClock>();
+}
+
+nlohmann::json tool_call(int id, const std::string& name) {
+    return {{"jsonrpc", "2.0"}, {"id", id}, {"method", "tools/call"},
+            {"params", {{"name", name}, {"arguments", nlohmann::json::object()}}}};
+}
+
+} // namespace
+
+TEST(RateLimiterTest, UnconfiguredAdmitsEverything) {
+    RateLimiter limiter(make_clock());
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_TRUE(limiter.check("s", "tools/call", "echo").allowed);
+    }
+    EXPECT_EQ(limiter.session_count(), 0u);
+}
+
+TEST(RateLimiterTest, BurstThenRefill) {
+    auto clock = make_clock();
+    RateLimiter limiter(clock);
+    limiter.set_global({10.0, 3});  // one token per 100ms
+
+    EXPECT_TRUE(limiter.check("", "ping").allowed);
+    EXPECT_TRUE(limiter.check("", "ping").allowed);
+    EXPECT_TRUE(limiter.check("", "ping").allowed);
+
+    RateLimiter::Decision rejected = limiter.check("", "ping");
+    EXPECT_FALSE(rejected.allowed);
+    EXPECT_EQ(rejected.scope, "global");
+    EXPECT_EQ(rejected.retry_after, 100ms);
+
+    clock->advance(40ms);
+    EXPECT_EQ(limiter.check("", "ping").retry_after, 60ms);
+
+    clock->advance(60ms);
+    EXPECT_TRUE(limiter.check("", "ping").allowed);
+    EXPECT_FALSE(limiter.check("", "ping").allowed);
+
+    // Idle time refills up to the burst, never beyond it
+    clock->advance(10s);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_TRUE(limiter.check("", "ping").allowed);
+    }
+    EXPECT_FALSE(limiter.check("", "ping").allowed);
+}
+
+TEST(RateLimiterTest, SessionsHaveIndependentBuckets) {
+    auto clock = make_clock();
+    RateLimiter limiter(clock);
+    limiter.set_session_default({1.0, 2});
+
+    EXPECT_TRUE(limiter.check("a", "tools/list").allowed);
+    EXPECT_TRUE(limiter.check("a", "tools/list").allowed);
+    RateLimiter::Decision rejected = limiter.check("a", "tools/list");
+    EXPECT_FALSE(rejected.allowed);
+    EXPECT_EQ(rejected.scope, "session");
+    EXPECT_EQ(rejected.retry_after, 1000ms);
+
+    // A runaway session does not starve another one
+    EXPECT_TRUE(limiter.check("b", "tools/list").allowed);
+    EXPECT_EQ(limiter.session_count(), 2u);
+
+    limiter.set_session("vip", {100.0, 50});
+    for (int i = 0; i < 50; ++i) {
+        EXPECT_TRUE(limiter.check("vip", "tools/list").allowed);
+    }
+
+    limiter.remove_session("a");
+    EXPECT_EQ(limiter.session_count(), 2u);
+    EXPECT_TRUE(limiter.check("a", "tools/list").allowed);
+}
+
+TEST(RateLimiterTest, ToolAndMethodLevels) {
+    auto clock = make_clock();
+    RateLimiter limiter(clock);
+    limiter.set_tool("search", {1.0, 1});
+    limiter.set_method("resources/read", {2.0, 1});
+
+    EXPECT_TRUE(limiter.check("a", "tools/call", "search").allowed);
+    RateLimiter::Decision rejected = limiter.check("b", "tools/call", "search");
+    EXPECT_FALSE(rejected.allowed);
+    EXPECT_EQ(rejected.scope, "tool");
+    EXPECT_TRUE(limiter.check("a", "tools/call", "echo").allowed);
+
+    EXPECT_TRUE(limiter.check("a", "resources/read").allowed);
+    rejected = limiter.check("a", "resources/read");
+    EXPECT_FALSE(rejected.allowed);
+    EXPECT_EQ(rejected.scope, "method");
+    EXPECT_EQ(rejected.retry_after, 500ms);
+}
+
+TEST(RateLimiterTest, RejectionRefundsOtherLevels) {
+    auto clock = make_clock();
+    RateLimiter limiter(clock);
+    limiter.set_global({1.0, 2});
+    limiter.set_tool("slow", {1.0, 1});
+
+    EXPECT_TRUE(limiter.check("", "tools/call", "slow").allowed);
+    // Rejected by the tool level; the global token it took is returned
+    EXPECT_FALSE(limiter.check("", "tools/call", "slow").allowed);
+    EXPECT_TRUE(limiter.check("", "tools/call", "other").allowed);
+    EXPECT_FALSE(limiter.check("", "tools/call", "other").allowed);
+}
+
+TEST(RateLimiterTest, ReconfigureAtRuntime) {
+    auto clock = make_clock();
+    RateLimiter limiter(clock);
+    limiter.set_session_default({1.0, 1});
+
+    EXPECT_TRUE(limiter.check("a", "ping").allowed);
+    EXPECT_FALSE(limiter.check("a", "ping").allowed);
+
+    // Existing sessions follow a new default without a fresh burst
+    limiter.set_session_default({1000.0, 1});
+    EXPECT_FALSE(limiter.check("a", "ping").allowed);
+    clock->advance(1ms);
+    EXPECT_TRUE(limiter.check("a", "ping").allowed);
+
+    limiter.clear_session_default();
+    EXPECT_EQ(limiter.session_count(), 0u);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_TRUE(limiter.check("a", "ping").allowed);
+    }
+
+    limiter.set_global({1.0, 1});
+    EXPECT_TRUE(limiter.check("a", "ping").allowed);
+    EXPECT_FALSE(limiter.check("a", "ping").allowed);
+    limiter.clear_global();
+    EXPECT_TRUE(limiter.check("a", "ping").allowed);
+}
+
+TEST(RateLimiterTest, ExportsMetrics) {
+    auto& registry = util::MetricsRegistry::global();
+    auto clock = make_clock();
+    RateLimiter limiter(clock);
+    limiter.set_tool("metered", {4.0, 2});
+
+    EXPECT_EQ(registry.gauge("ratelimit.tool.metered.interval_us").value(), 250000);
+    EXPECT_EQ(registry.gauge("ratelimit.tool.metered.burst").value(), 2);
+
+    const uint64_t allowed = registry.counter("ratelimit.tool.metered.allowed").value();
+    const uint64_t rejected = registry.counter("ratelimit.tool.metered.rejected").value();
+    for (int i = 0; i < 5; ++i) {
+        limiter.check("", "tools/call", "metered");
+    }
+    EXPECT_EQ(registry.counter("ratelimit.tool.metered.allowed").value() - allowed, 2u);
+    EXPECT_EQ(registry.counter("ratelimit.tool.metered.rejected").value() - rejected, 3u);
+
+    limiter.clear_tool("metered");
+    EXPECT_EQ(registry.gauge("ratelimit.tool.metered.interval_us").value(), 0);
+}
+
+TEST(RateLimiterTest, ConcurrentChecksNeverOverAdmit) {
+    auto clock = make_clock();
+    RateLimiter limiter(clock);
+    limiter.set_global({1.0, 1000});
+
+    std::atomic<int> admitted{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&, t] {
+            const std::string session = "s" + std::to_string(t);
+            for (int i = 0; i < 500; ++i) {
+                if (limiter.check(session, "tools/call", "echo").allowed) {
+                    admitted.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(admitted.load(), 1000);
+}
+
+TEST(RateLimiterTest, ServerRejectsWithRetryAfter) {
+    auto clock = make_clock();
+    McpServer server("limited", "1.0.0", clock);
+    transport::NullTransport transport;
+    server.set_transport(transport);
+    server.register_tool("echo", "Echo", {{"type", "object"}},
+        [](const std::string&, const nlohmann::json&, RequestContext&) {
+            return nlohmann::json{{"content", nlohmann::json::array()}};
+        });
+
+    auto limiter = std::make_shared<RateLimiter>(clock);
+    limiter->set_tool("echo", {2.0, 1});
+    server.set_rate_limiter(limiter, "stdio");
+
+    auto first = server.handle_request(tool_call(1, "echo"));
+    ASSERT_TRUE(first.has_value());
+    EXPECT_TRUE(first->contains("result"));
+
+    auto second = server.handle_request(tool_call(2, "echo"));
+    ASSERT_TRUE(second.has_value());
+    ASSERT_TRUE(second->contains("error"));
+    EXPECT_EQ((*second)["id"], 2);
+    EXPECT_EQ((*second)["error"]["code"], -32029);
+    EXPECT_EQ((*second)["error"]["data"]["retryAfterMs"], 500);
+    EXPECT_EQ((*second)["error"]["data"]["scope"], "tool");
+
+    // Notifications are not charged
+    EXPECT_FALSE(server.handle_request({{"jsonrpc", "2.0"}, {"method", "notifications/initialized"}}));
+
+    clock->advance(500ms);
+    auto serialized = server.handle_request_serialized(tool_call(3, "echo"));
+    ASSERT_TRUE(serialized.has_value());
+    EXPECT_NE(serialized->find("\"result\""), std::string::npos);
+}
+
+TEST(RateLimiterTest, SessionScopeSelectsBucket) {
+    auto clock = make_clock();
+    McpServer server("limited", "1.0.0", clock);
+    auto limiter = std::make_shared<RateLimiter>(clock);
+    limiter->set_session_default({1.0, 1});
+    server.set_rate_limiter(limiter);
+
+    nlohmann::json list = {{"jsonrpc", "2.0"}, {"id", 1}, {"method", "tools/list"}};
+    {
+        RateLimiter::SessionScope scope("a");
+        EXPECT_EQ(RateLimiter::SessionScope::current(), "a");
+        EXPECT_TRUE(server.handle_request(list)->contains("result"));
+        EXPECT_TRUE(server.handle_request(list)->contains("error"));
+    }
+    {
+        RateLimiter::SessionScope scope("b");
+        EXPECT_TRUE(server.handle_request(list)->contains("result"));
+    }
+    EXPECT_FALSE(RateLimiter::SessionScope::current().has_value());
+
+    // Without a scope or default session the session level is skipped
+    EXPECT_TRUE(server.handle_request(list)->contains("result"));
+    EXPECT_TRUE(server.handle_request(list)->contains("result"));
+}
+
+TEST(RateLimiterTest, IdleSessionBucketsAreEvicted) {
+    auto clock = make_clock();
+    RateLimiter limiter(clock);
+    limiter.set_session_default({1.0, 2});
+    limiter.set_session("vip", {1.0, 1});
+    EXPECT_TRUE(limiter.check("vip", "ping").allowed);
+
+    // Sessions that come and go without remove_session() do not pile up
+    for (int round = 0; round < 20; ++round) {
+        for (int i = 0; i < 100; ++i) {
+            EXPECT_TRUE(limiter.check("s" + std::to_string(round * 100 + i), "ping").allowed);
+        }
+        clock->advance(2s);
+    }
+    EXPECT_LE(limiter.session_count(), 512u);
+
+    // A busy session keeps what it owes, an override survives idling
+    for (int i = 0; i < 300; ++i) {
+        limiter.check("busy", "ping");
+        limiter.check("t" + std::to_string(i), "ping");
+    }
+    EXPECT_FALSE(limiter.check("busy", "ping").allowed);
+    EXPECT_TRUE(limiter.check("vip", "ping").allowed);
+    EXPECT_FALSE(limiter.check("vip", "ping").allowed);
+}
+
+TEST(RateLimiterTest, EndSessionReleasesBucket) {
+    auto clock = make_clock();
+    McpServer server("limited", "1.0.0", clock);
+    auto limiter = std::make_shared<RateLimiter>(clock);
+    limiter->set_session_default({1.0, 1});
+    server.set_rate_limiter(limiter);
+
+    nlohmann::json list = {{"jsonrpc", "2.0"}, {"id", 1}, {"method", "tools/list"}};
+    {
+        SessionScope scope("a");
+        EXPECT_TRUE(server.handle_request(list)->contains("result"));
+    }
+    EXPECT_EQ(limiter->session_count(), 1u);
+    server.end_session("a");
+    EXPECT_EQ(limiter->session_count(), 0u);
+}
@@ -0,0 +1,436 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+#include "mcpp/async/reactor.h"
+#include "mcpp/transport/fd_transport.h"
+#include "mcpp/util/clock.h"
+#include "mcpp/util/concurrency.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mcpp;
+using namespace std::chrono_literals;
+
+// ============================================================================
+// Concurrency policy
+// ============================================================================
+
+TEST(ConcurrencyTest, PlainAtomicMatchesAtomicInterface) {
+    util::PlainAtomic<uint64_t> value{5};
+    EXPECT_EQ(value.fetch_add(3), 5u);
+    EXPECT_EQ(value.load(), 8u);
+
+    uint64_t expected = 1;
+    EXPECT_FALSE(value.compare_exchange_strong(expected, 2));
+    EXPECT_EQ(expected, 8u);
+    EXPECT_TRUE(value.compare_exchange_strong(expected, 2));
+    EXPECT_EQ(value.exchange(7), 2u);
+    EXPECT_EQ(static_cast<uint64_t>(value), 7u);
+}
+
+TEST(ConcurrencyTest, NullMutexIsLockable) {
+    util::NullMutex mutex{"test"};
+    std::lock_guard<util::NullMutex> lock(mutex);
+    EXPECT_TRUE(mutex.try_lock());
+}
+
+// ============================================================================
+// Reactor timers
+// ============================================================================
+
+class ReactorTest : public ::testing::Test {
+protected:
+    std::shared_ptr<util::ManualClock> clock = std::make_shared<util::ManualClock>();
+    async::Reactor reactor{clock};
+};
+
+TEST_F(ReactorTest, OneShotTimerFiresWhenClockReachesDeadline) {
+    ASSERT_TRUE(reactor.valid());
+    int fired = 0;
+    reactor.call_after(10ms, [&] { ++fired; });
+
+    reactor.run_once(0ms);
+    EXPECT_EQ(fired, 0);
+
+    clock->advance(10ms);
+    reactor.run_once(0ms);
+    EXPECT_EQ(fired, 1);
+    EXPECT_EQ(reactor.timer_count(), 0u);
+
+    clock->advance(1s);
+    reactor.run_once(0ms);
+    EXPECT_EQ(fired, 1);
+}
+
+TEST_F(ReactorTest, TimersFireInDeadlineOrder) {
+    std::vector<int> order;
+    reactor.call_after(30ms, [&] { order.push_back(3); });
+    reactor.call_after(10ms, [&] { order.push_back(1); });
+    reactor.call_after(20ms, [&] { order.push_back(2); });
+
+    clock->advance(30ms);
+    reactor.run_once(0ms);
+    EXPECT_EQ(order, (std::vector<int>{1, 2, 3}));
+}
+
+TEST_F(ReactorTest, CancelledTimerDoesNotFire) {
+    int fired = 0;
+    auto id = reactor.call_after(5ms, [&] { ++fired; });
+    reactor.cancel_timer(id);
+
+    clock->advance(10ms);
+    reactor.run_once(0ms);
+    EXPECT_EQ(fired, 0);
+}
+
+TEST_F(ReactorTest, RepeatingTimerFiresEachInterval) {
+    int fired = 0;
+    auto id = reactor.call_every(10ms, [&] { ++fired; });
+
+    for (int i = 0; i < 3; ++i) {
+        clock->advance(10ms);
+        reactor.run_once(0ms);
+    }
+    EXPECT_EQ(fired, 3);
+
+    reactor.cancel_timer(id);
+    clock->advance(10ms);
+    reactor.run_once(0ms);
+    EXPECT_EQ(fired, 3);
+}
+
+TEST(ReactorThreadTest, PostAndStopFromAnotherThread) {
+    async::Reactor reactor;
+    int ran = 0;
+    std::thread poster([&] {
+        reactor.post([&] { ++ran; });
+        reactor.post([&] { reactor.stop(); });
+    });
+    reactor.run();
+    poster.join();
+    EXPECT_EQ(ran, 1);
+}
+
+// ============================================================================
+// FdTransport
+// ============================================================================
+
+class FdTransportTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    }
+
+    void TearDown() override {
+        ::close(fds[1]);
+    }
+
+    void write_peer(const std::string& data) {
+        ASSERT_EQ(::write(fds[1], data.data(), data.size()), static_cast<ssize_t>(data.size()));
+    }
+
+    std::string read_peer() {
+        char buf[4096];
+        ssize_t n = ::read(fds[1], buf, sizeof(buf));
+        return n > 0 ? std::string(buf, static_cast<size_t>(n)) : std::string();
+    }
+
+    int fds[2] = {-1, -1};
+    async::Reactor reactor;
+};
+
+TEST_F(FdTransportTest, DeliversCompleteLinesAcrossReads) {
+    transport::FdTransport::Options options;
+    options.owns_fds = true;
+    transport::FdTransport transport(reactor, fds[0], fds[0], options);
+
+    std::vector<std::string> received;
+    transport.set_message_callback([&](std::string_view msg) { received.emplace_back(msg); });
+    ASSERT_TRUE(transport.connect());
+
+    write_peer("{\"a\":1}\n{\"b\"");
+    reactor.run_once(100ms);
+    ASSERT_EQ(received.size(), 1u);
+    EXPECT_EQ(received[0], "{\"a\":1}");
+
+    write_peer(":2}\r\n");
+    reactor.run_once(100ms);
+    ASSERT_EQ(received.size(), 2u);
+    EXPECT_EQ(received[1], "{\"b\":2}");
+}
+
+TEST_F(FdTransportTest, SendAppendsNewline) {
+    transport::FdTransport::Options options;
+    options.owns_fds = true;
+    transport::FdTransport transport(reactor, fds[0], fds[0], options);
+    ASSERT_TRUE(transport.connect());
+
+    EXPECT_TRUE(transport.send("{\"jsonrpc\":\"2.0\"}"));
+    EXPECT_EQ(read_peer(), "{\"jsonrpc\":\"2.0\"}\n");
+    EXPECT_EQ(transport.pending_output(), 0u);
+}
+
+TEST_F(FdTransportTest, ReportsEofAndDisconnects) {
+    transport::FdTransport::Options options;
+    options.owns_fds = true;
+    transport::FdTransport transport(reactor, fds[0], fds[0], options);
+
+    std::string error;
+    transport.set_error_callback([&](std::string_view e) { error = e; });
+    ASSERT_TRUE(transport.connect());
+
+    ::shutdown(fds[1], SHUT_WR);
+    reactor.run_once(100ms);
+    EXPECT_EQ(error, "EOF");
+    EXPECT_FALSE(transport.is_connected());
+    EXPECT_EQ(reactor.watched_count(), 0u);
+}
+
+TEST_F(FdTransportTest, DropsOversizedLines) {
+    transport::FdTransport::Options options;
+    options.owns_fds = true;
+    options.limits.max_frame_bytes = 8;
+    transport::FdTransport transport(reactor, fds[0], fds[0], options);
+
+    std::vector<std::string> received;
+    std::string error;
+    transport.set_message_callback([&](std::string_view msg) { received.emplace_back(msg); });
+    transport.set_error_callback([&](std::string_view e) { error = e; });
+    ASSERT_TRUE(transport.connect());
+
+    write_peer("0123456789abcdef");
+    reactor.run_once(100ms);
+    write_peer("tail\n{}\n");
+    reactor.run_once(100ms);
+
+    EXPECT_FALSE(error.empty());
+    ASSERT_EQ(received.size(), 1u);
+    EXPECT_EQ(received[0], "{}");
+    EXPECT_TRUE(transport.is_connected());
+}
+
+TEST_F(FdTransportTest, AnswersInvalidFramesWithParseError) {
+    transport::FdTransport::Options options;
+    options.owns_fds = true;
+    options.limits.max_depth = 4;
+    transport::FdTransport transport(reactor, fds[0], fds[0], options);
+
+    std::vector<std::string> received;
+    transport.set_message_callback([&](std::string_view msg) { received.emplace_back(msg); });
+    ASSERT_TRUE(transport.connect());
+
+    write_peer("{\"a\":\"\xc0\xaf\"}\n[[[[[1]]]]]\n{\"ok\":true}\n");
+    reactor.run_once(100ms);
+    reactor.run_once(10ms);
+
+    ASSERT_EQ(received.size(), 1u);
+    EXPECT_EQ(received[0], "{\"ok\":true}");
+
+    std::string replies = read_peer();
+    EXPECT_EQ(std::count(replies.begin(), replies.end(), '\n'), 2);
+    EXPECT_NE(replies.find("-32700"), std::string::npos);
+    EXPECT_NE(replies.find("not valid UTF-8"), std::string::npos);
+    EXPECT_NE(replies.find("max_depth"), std::string::npos);
+}
+
+// ============================================================================
+// io_uring backend
+// ============================================================================
+
+TEST(ReactorBackendTest, EpollRejectsCompletionOperations) {
+    async::Reactor reactor;
+    EXPECT_EQ(reactor.backend(), async::Reactor::Backend::Epoll);
+    EXPECT_EQ(reactor.recv_multishot(0, [](std::string_view, int) {}), 0u);
+    EXPECT_FALSE(reactor.write_chain(1, {util::SharedBuffer("x")}, [](int) {}));
+}
+
+class IoUringReactorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        if (!async::IoUring::supported()) {
+            GTEST_SKIP() << "io_uring not available";
+        }
+        async::Reactor::Options options;
+        options.backend = async::Reactor::Backend::IoUring;
+        options.recv_buffer_count = 4;
+        options.recv_buffer_size = 64;
+        reactor = std::make_unique<async::Reactor>(options);
+        ASSERT_EQ(reactor->backend(), async::Reactor::Backend::IoUring);
+        ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds), 0);
+    }
+
+    void TearDown() override {
+        reactor.reset();
+        for (int fd : fds) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+    }
+
+    std::string drain_peer() {
+        std::string out;
+        char buf[65536];
+        ssize_t n;
+        while ((n = ::read(fds[1], buf, sizeof(buf))) > 0) {
+            out.append(buf, static_cast<size_t>(n));
+        }
+        return out;
+    }
+
+    int fds[2] = {-1, -1};
+    std::unique_ptr<async::Reactor> reactor;
+};
+
+TEST_F(IoUringReactorTest, ReadinessIsLevelTriggered) {
+    int calls = 0;
+    ASSERT_TRUE(reactor->add(fds[0], async::Reactor::Readable, [&](uint32_t events) {
+        EXPECT_TRUE(events & async::Reactor::Readable);
+        ++calls;
+    }));
+    ASSERT_EQ(::write(fds[1], "x", 1), 1);
+    reactor->run_once(100ms);
+    EXPECT_EQ(calls, 1);
+
+    // Not drained: a level-triggered poll reports it again
+    reactor->run_once(100ms);
+    EXPECT_EQ(calls, 2);
+
+    reactor->remove(fds[0]);
+    reactor->run_once(10ms);
+    EXPECT_EQ(calls, 2);
+    EXPECT_EQ(reactor->watched_count(), 0u);
+}
+
+TEST_F(IoUringReactorTest, PostWakesTheRing) {
+    int ran = 0;
+    std::thread poster([&] {
+        reactor->post([&] { ++ran; });
+        reactor->post([&] { reactor->stop(); });
+    });
+    reactor->run();
+    poster.join();
+    EXPECT_EQ(ran, 1);
+}
+
+TEST_F(IoUringReactorTest, MultishotRecvKeepsDeliveringUntilCancelled) {
+    std::string received;
+    int calls = 0;
+    auto op = reactor->recv_multishot(fds[0], [&](std::string_view data, int result) {
+        EXPECT_GT(result, 0);
+        received.append(data);
+        ++calls;
+    });
+    if (op == 0) {
+        GTEST_SKIP() << "provided buffer rings not available";
+    }
+
+    // More data than all provided buffers together (4 x 64 bytes)
+    std::string payload(1000, 'a');
+    for (size_t i = 0; i < payload.size(); ++i) {
+        payload[i] = static_cast<char>('a' + i % 26);
+    }
+    ASSERT_EQ(::write(fds[1], payload.data(), payload.size()), static_cast<ssize_t>(payload.size()));
+    for (int i = 0; i < 50 && received.size() < payload.size(); ++i) {
+        reactor->run_once(20ms);
+    }
+    EXPECT_EQ(received, payload);
+
+    reactor->cancel(op);
+    int before = calls;
+    ASSERT_EQ(::write(fds[1], "late", 4), 4);
+    reactor->run_once(20ms);
+    EXPECT_EQ(calls, before);
+}
+
+TEST_F(IoUringReactorTest, MultishotRecvReportsEof) {
+    int last = 1;
+    auto op = reactor->recv_multishot(fds[0], [&](std::string_view, int result) { last = result; });
+    if (op == 0) {
+        GTEST_SKIP() << "provided buffer rings not available";
+    }
+    ::shutdown(fds[1], SHUT_WR);
+    reactor->run_once(100ms);
+    EXPECT_EQ(last, 0);
+    EXPECT_EQ(reactor->inflight_count(), 0u);
+}
+
+TEST_F(IoUringReactorTest, WriteChainPreservesOrderPastTheLinkLimit) {
+    std::vector<util::SharedBuffer> buffers;
+    std::string expected;
+    for (int i = 0; i < 100; ++i) {
+        std::string line = "message-" + std::to_string(i) + "\n";
+        expected += line;
+        buffers.emplace_back(std::move(line));
+    }
+    int result = 1;
+    ASSERT_TRUE(reactor->write_chain(fds[0], std::move(buffers), [&](int error) { result = error; }));
+    for (int i = 0; i < 20 && result == 1; ++i) {
+        reactor->run_once(20ms);
+    }
+    EXPECT_EQ(result, 0);
+    EXPECT_EQ(drain_peer(), expected);
+}
+
+TEST_F(IoUringReactorTest, WriteChainResumesWhenTheSocketIsFull) {
+    // Several MiB overflow the socket buffer, forcing short writes / EAGAIN
+    std::vector<util::SharedBuffer> buffers;
+    std::string expected;
+    for (int i = 0; i < 8; ++i) {
+        std::string chunk(512 * 1024, static_cast<char>('A' + i));
+        expected += chunk;
+        buffers.emplace_back(std::move(chunk));
+    }
+    int result = 1;
+    ASSERT_TRUE(reactor->write_chain(fds[0], std::move(buffers), [&](int error) { result = error; }));
+
+    std::string received;
+    for (int i = 0; i < 1000 && (result == 1 || received.size() < expected.size()); ++i) {
+        reactor->run_once(1ms);
+        received += drain_peer();
+    }
+    EXPECT_EQ(result, 0);
+    EXPECT_EQ(received.size(), expected.size());
+    EXPECT_TRUE(received == expected);
+}
+
+TEST_F(IoUringReactorTest, FdTransportBatchesSendsAndReceivesMessages) {
+    transport::FdTransport transport(*reactor, fds[0], fds[0]);
+    std::vector<std::string> received;
+    transport.set_message_callback([&](std::string_view msg) {
+        received.emplace_back(msg);
+        // Replies sent from inside dispatch go out together
+        transport.send(std::string("{\"echo\":") + std::string(msg) + "}");
+    });
+    ASSERT_TRUE(transport.connect());
+
+    ASSERT_EQ(::write(fds[1], "1\n2\n3\n", 6), 6);
+    std::string replies;
+    for (int i = 0; i < 20 && (std::count(replies.begin(), replies.end(), '\n') < 3 ||
+                               transport.pending_output() != 0); ++i) {
+        reactor->run_once(20ms);
+        replies += drain_peer();
+    }
+    EXPECT_EQ(received, (std::vector<std::string>{"1", "2", "3"}));
+    EXPECT_EQ(replies, "{\"echo\":1}\n{\"echo\":2}\n{\"echo\":3}\n");
+    EXPECT_EQ(transport.pending_output(), 0u);
+
+    std::string error;
+    transport.set_error_callback([&](std::string_view e) { error = e; });
+    ::shutdown(fds[1], SHUT_WR);
+    reactor->run_once(100ms);
+    EXPECT_EQ(error, "EOF");
+    EXPECT_FALSE(transport.is_connected());
+}
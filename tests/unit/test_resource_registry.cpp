@@ -390,3 +390,66 @@ TEST(ResourceRegistry, SetTransport_NotificationUsesTransport) {
     // Transport should have received the notification
     EXPECT_FALSE(transport.last_sent.empty());
 }
+
+// ============================================================================
+// Direct serialization
+// ============================================================================
+
+TEST(ResourceRegistry, WriteResourceMatchesDomSerialization) {
+    ResourceRegistry registry;
+
+    registry.register_resource(
+        "file://notes",
+        "Notes",
+        std::nullopt,
+        "text/plain",
+        [](const std::string& uri) -> ResourceContent {
+            return ResourceContent{uri, std::nullopt, true, "line \"one\"\n\ttwo \\ \x01 caf\xc3\xa9", ""};
+        }
+    );
+    registry.register_resource(
+        "file://image",
+        "Image",
+        std::nullopt,
+        "image/png",
+        [](const std::string& uri) -> ResourceContent {
+            return ResourceContent{uri, "image/webp", false, "", "iVBORw0KGgo="};
+        }
+    );
+
+    for (const char* uri : {"file://notes", "file://image"}) {
+        std::string out;
+        ASSERT_TRUE(registry.write_resource(uri, out));
+        EXPECT_EQ(out, registry.read_resource(uri)->dump()) << uri;
+    }
+
+    std::string untouched = "prefix";
+    EXPECT_FALSE(registry.write_resource("file://missing", untouched));
+    EXPECT_EQ(untouched, "prefix");
+}
+
+TEST(ResourceRegistry, HandlerPayloadIsSharedNotCopied) {
+    ResourceRegistry registry;
+    util::SharedBuffer payload(std::string(1 << 20, 'A'));
+
+    registry.register_resource(
+        "file://big",
+        "Big",
+        std::nullopt,
+        "application/octet-stream",
+        [payload](const std::string& uri) -> ResourceContent {
+            ResourceContent content;
+            content.uri = uri;
+            content.is_text = false;
+            content.blob = payload;
+            // The handler's copy and the returned content share one allocation
+            EXPECT_EQ(content.blob.data(), payload.data());
+            return content;
+        }
+    );
+
+    std::string out;
+    ASSERT_TRUE(registry.write_resource("file://big", out));
+    EXPECT_GT(out.size(), payload.size());
+    EXPECT_NE(out.find(payload.view()), std::string::npos);
+}
@@ -0,0 +1,190 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+#include "mcpp/client/roots.h"
+#include "mcpp/client/roots_watcher.h"
+#include "mcpp/util/path_trie.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <thread>
+
+using namespace mcpp;
+
+// ============================================================================
+// PathTrie
+// ============================================================================
+
+TEST(PathTrieTest, NormalizeResolvesDotSegmentsAndUris) {
+    EXPECT_EQ(util::PathTrie::normalize("/a/./b//c/../d"), "/a/b/d");
+    EXPECT_EQ(util::PathTrie::normalize("/a/b/"), "/a/b");
+    EXPECT_EQ(util::PathTrie::normalize("/../.."), "/");
+    EXPECT_EQ(util::PathTrie::normalize("file:///home/user/my%20project"), "/home/user/my project");
+    EXPECT_EQ(util::PathTrie::normalize("file://localhost/srv"), "/srv");
+
+    EXPECT_FALSE(util::PathTrie::normalize("relative/path").has_value());
+    EXPECT_FALSE(util::PathTrie::normalize("https://example.com/a").has_value());
+    EXPECT_FALSE(util::PathTrie::normalize("file:///bad%zz").has_value());
+}
+
+TEST(PathTrieTest, FileUriRoundTrips) {
+    auto uri = util::PathTrie::to_file_uri("/home/user/my project#1");
+    EXPECT_EQ(uri, "file:///home/user/my%20project%231");
+    EXPECT_EQ(util::PathTrie::normalize(uri), "/home/user/my project#1");
+}
+
+TEST(PathTrieTest, ContainsMatchesWholeSegmentsOnly) {
+    util::PathTrie trie;
+    EXPECT_TRUE(trie.insert("/home/user/project"));
+    EXPECT_FALSE(trie.insert("file:///home/user/project/"));
+
+    EXPECT_TRUE(trie.contains("/home/user/project"));
+    EXPECT_TRUE(trie.contains("/home/user/project/src/main.cpp"));
+    EXPECT_TRUE(trie.contains("file:///home/user/project/docs"));
+    EXPECT_FALSE(trie.contains("/home/user/project2"));
+    EXPECT_FALSE(trie.contains("/home/user"));
+    EXPECT_FALSE(trie.contains("/home/user/project/../other"));
+}
+
+TEST(PathTrieTest, RootForReturnsDeepestRoot) {
+    util::PathTrie trie;
+    trie.insert("/repo");
+    trie.insert("/repo/vendor/lib");
+
+    EXPECT_EQ(trie.root_for("/repo/src/a.cpp"), "/repo");
+    EXPECT_EQ(trie.root_for("/repo/vendor/lib/b.cpp"), "/repo/vendor/lib");
+    EXPECT_FALSE(trie.root_for("/elsewhere").has_value());
+
+    EXPECT_TRUE(trie.erase("/repo/vendor/lib"));
+    EXPECT_FALSE(trie.erase("/repo/vendor/lib"));
+    EXPECT_EQ(trie.root_for("/repo/vendor/lib/b.cpp"), "/repo");
+    EXPECT_EQ(trie.size(), 1u);
+
+    trie.clear();
+    EXPECT_TRUE(trie.empty());
+    EXPECT_FALSE(trie.contains("/repo"));
+}
+
+// ============================================================================
+// RootsManager
+// ============================================================================
+
+TEST(RootsManagerTest, LooksUpPathsAgainstRoots) {
+    client::RootsManager manager;
+    manager.set_roots({
+        client::Root{"file:///work/app", "app"},
+        client::Root{"file:///work/app/third_party", std::nullopt},
+    });
+
+    EXPECT_TRUE(manager.contains("/work/app/src/x.cpp"));
+    EXPECT_FALSE(manager.contains("/work/other"));
+
+    auto root = manager.root_for("file:///work/app/third_party/zlib/zlib.h");
+    ASSERT_TRUE(root.has_value());
+    EXPECT_EQ(root->uri, "file:///work/app/third_party");
+
+    root = manager.root_for("/work/app/README.md");
+    ASSERT_TRUE(root.has_value());
+    EXPECT_EQ(root->name, "app");
+}
+
+TEST(RootsManagerTest, ListResultIsCachedUntilRootsChange) {
+    client::RootsManager manager;
+    manager.set_roots({client::Root{"file:///a", "a"}});
+
+    auto first = manager.list_result();
+    ASSERT_EQ(first["roots"].size(), 1u);
+    EXPECT_EQ(first["roots"][0]["uri"], "file:///a");
+    EXPECT_EQ(manager.list_result(), first);
+
+    manager.set_roots({client::Root{"file:///a", "a"}, client::Root{"file:///b", std::nullopt}});
+    EXPECT_EQ(manager.list_result()["roots"].size(), 2u);
+}
+
+// ============================================================================
+// RootsWatcher
+// ============================================================================
+
+namespace {
+
+class TempDir {
+public:
+    TempDir() {
+        char pattern[] = "/tmp/mcpp_roots_XXXXXX";
+        path_ = ::mkdtemp(pattern);
+    }
+    ~TempDir() {
+        std::error_code ec;
+        std::filesystem::remove_all(path_, ec);
+    }
+    const std::string& path() const { return path_; }
+
+private:
+    std::string path_;
+};
+
+} // anonymous namespace
+
+TEST(RootsWatcherTest, RescanPublishesWorkspaceChildren) {
+    TempDir dir;
+    std::filesystem::create_directory(dir.path() + "/alpha");
+
+    client::RootsManager manager;
+    int notified = 0;
+    manager.set_notify_callback([&] { ++notified; });
+
+    client::RootsWatcher watcher(manager);
+    watcher.add_workspace(dir.path());
+    watcher.add_root(dir.path() + "/pinned", "pinned");
+
+    EXPECT_TRUE(watcher.rescan());
+    EXPECT_EQ(manager.get_roots().size(), 1u);
+    EXPECT_EQ(notified, 1);
+
+    // Nothing changed: no notification
+    EXPECT_FALSE(watcher.rescan());
+    EXPECT_EQ(notified, 1);
+
+    std::filesystem::create_directory(dir.path() + "/beta");
+    std::filesystem::create_directory(dir.path() + "/pinned");
+    EXPECT_TRUE(watcher.rescan());
+    EXPECT_EQ(notified, 2);
+    EXPECT_TRUE(manager.contains(dir.path() + "/beta/file.txt"));
+    // The pinned root is both fixed and a workspace child; the deepest match wins
+    ASSERT_TRUE(manager.root_for(dir.path() + "/pinned").has_value());
+}
+
+TEST(RootsWatcherTest, InotifyEventsAreDebouncedIntoOneNotification) {
+    TempDir dir;
+
+    client::RootsManager manager;
+    std::atomic<int> notified{0};
+    manager.set_notify_callback([&] { ++notified; });
+
+    client::RootsWatcher watcher(manager, client::RootsWatcher::Options{std::chrono::milliseconds(50)});
+    watcher.add_workspace(dir.path());
+    ASSERT_TRUE(watcher.start());
+    EXPECT_TRUE(manager.get_roots().empty());
+    EXPECT_EQ(notified.load(), 0);
+
+    for (int i = 0; i < 5; ++i) {
+        std::filesystem::create_directory(dir.path() + "/p" + std::to_string(i));
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (notified.load() == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    // Let any stray trailing timer fire
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    watcher.stop();
+
+    EXPECT_EQ(notified.load(), 1);
+    EXPECT_EQ(manager.get_roots().size(), 5u);
+}
@@ -0,0 +1,100 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+#include "mcpp/util/secure_random.h"
+
+#include <gtest/gtest.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+using namespace mcpp;
+
+TEST(SecureRandom, ChaCha20MatchesRfc8439Vector) {
+    // RFC 8439 section 2.3.2: key 00..1f, counter 1, nonce 00000009 0000004a 00000000
+    uint32_t key[8];
+    for (uint32_t i = 0; i < 8; ++i) {
+        uint32_t b = 4 * i;
+        key[i] = b | ((b + 1) << 8) | ((b + 2) << 16) | ((b + 3) << 24);
+    }
+    uint8_t out[64];
+    util::SecureRandom::chacha20_block(key, 1 | (0x09000000ULL << 32), 0x4a000000, out);
+
+    std::string hex;
+    char byte[3];
+    for (uint8_t b : out) {
+        std::snprintf(byte, sizeof(byte), "%02x", b);
+        hex += byte;
+    }
+    EXPECT_EQ(hex,
+              "10f1e7e4d13b5915500fdd1fa32071c4c7d1f4c733c068030422aa9ac3d46c4e"
+              "d2826446079faa0914c2d705d98b02a2b5129cd1de164eb9cbd083e8a2503c4e");
+}
+
+TEST(SecureRandom, FillSpansBatches) {
+    // Larger than one batch, with an odd length to cross block boundaries
+    std::vector<uint8_t> bytes(util::SecureRandom::BATCH_BLOCKS * 64 * 3 + 7, 0);
+    util::SecureRandom::fill(bytes.data(), bytes.size());
+    size_t counts[256] = {};
+    for (uint8_t b : bytes) {
+        ++counts[b];
+    }
+    // Every byte value shows up in ~3 KiB of uniform output
+    size_t seen = 0;
+    for (size_t c : counts) {
+        seen += c != 0;
+    }
+    EXPECT_GT(seen, 240u);
+}
+
+TEST(SecureRandom, IdsAreUniqueAcrossThreads) {
+    std::mutex mutex;
+    std::unordered_set<util::Id128, util::Id128Hash> ids;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            std::vector<util::Id128> local;
+            for (int i = 0; i < 5000; ++i) {
+                local.push_back(util::SecureRandom::next_id128());
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            ids.insert(local.begin(), local.end());
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    EXPECT_EQ(ids.size(), 20000u);
+}
+
+TEST(SecureRandom, ChildRekeysAfterFork) {
+    util::SecureRandom::next_u64();  // buffer now holds unread output
+
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+    pid_t pid = ::fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        uint64_t value = util::SecureRandom::next_u64();
+        ssize_t n = ::write(fds[1], &value, sizeof(value));
+        ::_exit(n == sizeof(value) ? 0 : 1);
+    }
+    ::close(fds[1]);
+    uint64_t child = 0;
+    ASSERT_EQ(::read(fds[0], &child, sizeof(child)), static_cast<ssize_t>(sizeof(child)));
+    ::close(fds[0]);
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+
+    EXPECT_NE(child, util::SecureRandom::next_u64());
+}
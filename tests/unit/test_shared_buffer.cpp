@@ -0,0 +1,116 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+#include "mcpp/client/sampling.h"
+#include "mcpp/content/content.h"
+#include "mcpp/util/json_writer.h"
+#include "mcpp/util/shared_buffer.h"
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <string>
+
+using namespace mcpp;
+
+// ============================================================================
+// SharedBuffer
+// ============================================================================
+
+TEST(SharedBufferTest, AdoptsMovedStringsAndSharesCopies) {
+    std::string bytes(4096, 'x');
+    const char* storage = bytes.data();
+
+    util::SharedBuffer buffer(std::move(bytes));
+    EXPECT_EQ(buffer.data(), storage);
+    EXPECT_EQ(buffer.size(), 4096u);
+
+    util::SharedBuffer copy = buffer;
+    EXPECT_EQ(copy.data(), storage);
+    EXPECT_EQ(buffer.use_count(), 2);
+    EXPECT_EQ(copy, buffer);
+}
+
+TEST(SharedBufferTest, BehavesLikeAStringField) {
+    util::SharedBuffer empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty, "");
+    EXPECT_EQ(empty.use_count(), 0);
+
+    util::SharedBuffer text = "hello";
+    EXPECT_EQ(text, "hello");
+    EXPECT_EQ(text, std::string("hello"));
+    EXPECT_EQ(std::string_view(text), "hello");
+    EXPECT_EQ(text.str(), "hello");
+    EXPECT_FALSE(text == "world");
+
+    nlohmann::json j;
+    j["text"] = text;
+    EXPECT_EQ(j["text"], "hello");
+    EXPECT_EQ(j["text"].get<util::SharedBuffer>(), "hello");
+}
+
+// ============================================================================
+// Direct JSON writing
+// ============================================================================
+
+TEST(JsonWriterTest, EscapingMatchesNlohmannDump) {
+    const std::string samples[] = {
+        "",
+        "plain base64+/=",
+        "quote \" backslash \\ slash /",
+        "\b\f\n\r\t",
+        std::string("nul \0 and \x1f", 13),
+        "utf-8 \xe2\x82\xac \xf0\x9f\x98\x80 del \x7f",
+    };
+    for (const auto& sample : samples) {
+        std::string out;
+        util::append_json_string(out, sample);
+        EXPECT_EQ(out, nlohmann::json(sample).dump());
+    }
+}
+
+TEST(JsonWriterTest, InvalidUtf8IsReplacedLikeDump) {
+    const std::string samples[] = {
+        "bad \xff byte",
+        "truncated \xe2\x82",
+        "surrogate \xed\xa0\x80 and \"quote\"",
+        "overlong \xc0\xaf",
+    };
+    for (const auto& sample : samples) {
+        std::string out;
+        util::append_json_string(out, sample);
+        EXPECT_EQ(out, nlohmann::json(sample).dump(-1, ' ', false,
+                                                   nlohmann::json::error_handler_t::replace));
+        EXPECT_NO_THROW(nlohmann::json::parse(out)) << out;
+    }
+}
+
+TEST(JsonWriterTest, ContentBlocksMatchDomSerialization) {
+    content::ImageContent image;
+    image.data = std::string(1000, 'Q');
+    image.mime_type = "image/png";
+    image.annotations = content::Annotations({{"user"}}, 0.5, std::nullopt);
+
+    content::AudioContent audio;
+    audio.data = "UklGRg==";
+    audio.mime_type = "audio/wav";
+
+    content::EmbeddedResource text_resource;
+    text_resource.resource = server::ResourceContent{"file:///a.txt", "text/plain", true, "a\nb", ""};
+
+    content::EmbeddedResource blob_resource;
+    blob_resource.resource = server::ResourceContent{"file:///a.bin", std::nullopt, false, "", "AAEC"};
+
+    auto check = [](const auto& block) {
+        std::string out;
+        content::append_json(out, block);
+        EXPECT_EQ(out, client::content_to_json(block).dump());
+    };
+    check(image);
+    check(audio);
+    check(text_resource);
+    check(blob_resource);
+}
@@ -0,0 +1,320 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+#include "mcpp/server/tenant.h"
+#include "mcpp/server/fair_executor.h"
+#include "mcpp/server/mcp_server.h"
+#include "mcpp/transport/null_transport.h"
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mcpp;
+using namespace mcpp::server;
+using namespace std::chrono_literals;
+
+namespace {
+
+nlohmann::json request(int id, const std::string& method, nlohmann::json params = nlohmann::json::object()) {
+    return {{"jsonrpc", "2.0"}, {"id", id}, {"method", method}, {"params", std::move(params)}};
+}
+
+nlohmann::json initialize(const std::string& tenant) {
+    return request(0, "initialize", {
+        {"protocolVersion", "2025-11-25"},
+        {"capabilities", nlohmann::json::object()},
+        {"clientInfo", {{"name", "test"}, {"version", "1"}}},
+        {"_meta", {{"tenant", tenant}}}
+    });
+}
+
+std::vector<std::string> names(const nlohmann::json& list, const char* field, const char* key) {
+    std::vector<std::string> out;
+    for (const auto& entry : list["result"][field]) {
+        out.push_back(entry.value(key, ""));
+    }
+    return out;
+}
+
+class TenantServerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        server.set_transport(transport);
+        auto tool = [](const std::string& name, const nlohmann::json& args, RequestContext&) {
+            return nlohmann::json{{"content", {{{"type", "text"}, {"text", name + args.value("pad", "")}}}}};
+        };
+        server.register_tool("shared", "", {{"type", "object"}}, tool);
+        server.register_tool("acme_only", "", {{"type", "object"}}, tool);
+        server.register_resource("file:///acme/readme", "readme", std::nullopt, "text/plain",
+            [](const std::string& uri) { return ResourceContent{uri, "text/plain", true, "acme", ""}; });
+        server.register_resource("file:///globex/readme", "readme", std::nullopt, "text/plain",
+            [](const std::string& uri) { return ResourceContent{uri, "text/plain", true, "globex", ""}; });
+        server.register_prompt("greet", std::nullopt, {}, [](const std::string&, const nlohmann::json&) {
+            return std::vector<PromptMessage>{{"user", {{"type", "text"}, {"text", "hi"}}}};
+        });
+
+        TenantConfig acme;
+        acme.tools = std::unordered_set<std::string>{"shared", "acme_only"};
+        acme.resources = std::vector<std::string>{"file:///acme/"};
+        tenants->set_tenant("acme", acme);
+
+        TenantConfig globex;
+        globex.tools = std::unordered_set<std::string>{"shared"};
+        globex.resources = std::vector<std::string>{"file:///globex/"};
+        globex.prompts = std::unordered_set<std::string>{};
+        tenants->set_tenant("globex", globex);
+
+        server.set_tenants(tenants);
+    }
+
+    /// Handle a request as a session
+    nlohmann::json as(const std::string& session, const nlohmann::json& message) {
+        SessionScope scope(session);
+        return *server.handle_request(message);
+    }
+
+    transport::NullTransport transport;
+    McpServer server{"tenants", "1.0.0"};
+    std::shared_ptr<TenantManager> tenants = std::make_shared<TenantManager>();
+};
+
+} // namespace
+
+TEST_F(TenantServerTest, SessionsAreBoundOnInitialize) {
+    as("s1", initialize("acme"));
+    as("s2", initialize("globex"));
+    as("s3", initialize("unknown"));
+
+    EXPECT_EQ(tenants->tenant_id_for("s1"), "acme");
+    EXPECT_EQ(tenants->tenant_id_for("s2"), "globex");
+    EXPECT_EQ(tenants->tenant_id_for("s3"), "");
+    EXPECT_EQ(tenants->tenant_for("s3"), nullptr);
+
+    tenants->set_default_tenant("globex");
+    EXPECT_EQ(tenants->tenant_for("s3")->id(), "globex");
+
+    tenants->unbind("s1");
+    EXPECT_EQ(tenants->tenant_id_for("s1"), "globex");
+}
+
+TEST_F(TenantServerTest, RegistryOverlaysHideOtherTenants) {
+    as("a", initialize("acme"));
+    as("g", initialize("globex"));
+
+    EXPECT_EQ(names(as("a", request(1, "tools/list")), "tools", "name").size(), 2u);
+    EXPECT_EQ(names(as("g", request(1, "tools/list")), "tools", "name"),
+              std::vector<std::string>{"shared"});
+    EXPECT_EQ(names(as("g", request(1, "resources/list")), "resources", "uri"),
+              std::vector<std::string>{"file:///globex/readme"});
+    EXPECT_TRUE(as("g", request(1, "prompts/list"))["result"]["prompts"].empty());
+
+    auto hidden = as("g", request(2, "tools/call", {{"name", "acme_only"}}));
+    ASSERT_TRUE(hidden.contains("error"));
+    EXPECT_EQ(hidden["error"]["message"], "Tool not found: acme_only");
+    EXPECT_TRUE(as("a", request(2, "tools/call", {{"name", "acme_only"}})).contains("result"));
+
+    EXPECT_TRUE(as("g", request(3, "resources/read", {{"uri", "file:///acme/readme"}})).contains("error"));
+    EXPECT_TRUE(as("g", request(3, "prompts/get", {{"name", "greet"}})).contains("error"));
+
+    // The serialized path (no DOM for resources/read) applies the same overlay
+    SessionScope scope("g");
+    auto read = server.handle_request_serialized(request(4, "resources/read", {{"uri", "file:///acme/readme"}}));
+    EXPECT_NE(read->find("Resource not found"), std::string::npos);
+}
+
+TEST_F(TenantServerTest, TasksAreNamespaced) {
+    as("a", initialize("acme"));
+    as("g", initialize("globex"));
+
+    auto created = as("a", request(1, "tasks/send"));
+    const std::string task_id = created["result"]["id"];
+
+    EXPECT_EQ(as("a", request(2, "tasks/list"))["result"]["items"].size(), 1u);
+    EXPECT_TRUE(as("g", request(2, "tasks/list"))["result"]["items"].empty());
+    EXPECT_TRUE(as("g", request(3, "tasks/get", {{"id", task_id}})).contains("error"));
+    EXPECT_TRUE(as("g", request(4, "tasks/cancel", {{"id", task_id}})).contains("error"));
+    EXPECT_TRUE(as("a", request(4, "tasks/cancel", {{"id", task_id}})).contains("result"));
+}
+
+TEST_F(TenantServerTest, TaskBudget) {
+    TenantConfig config;
+    config.budget.max_tasks = 2;
+    tenants->set_tenant("small", config);
+    as("s", initialize("small"));
+
+    EXPECT_TRUE(as("s", request(1, "tasks/send")).contains("result"));
+    EXPECT_TRUE(as("s", request(2, "tasks/send")).contains("result"));
+    auto rejected = as("s", request(3, "tasks/send"));
+    ASSERT_TRUE(rejected.contains("error"));
+    EXPECT_EQ(rejected["error"]["code"], -32030);
+    EXPECT_EQ(rejected["error"]["data"]["budget"], "tasks");
+    EXPECT_EQ(rejected["error"]["data"]["tenant"], "small");
+
+    // Another tenant's tasks do not count
+    as("a", initialize("acme"));
+    EXPECT_TRUE(as("a", request(4, "tasks/send")).contains("result"));
+}
+
+TEST_F(TenantServerTest, ResultBytesBudget) {
+    TenantConfig config;
+    config.budget.max_result_bytes = 200;
+    tenants->set_tenant("small", config);
+    as("s", initialize("small"));
+
+    SessionScope scope("s");
+    auto small = server.handle_request_serialized(request(1, "tools/call", {{"name", "shared"}}));
+    EXPECT_TRUE(nlohmann::json::parse(*small).contains("result"));
+
+    auto big = request(2, "tools/call", {{"name", "shared"}, {"arguments", {{"pad", std::string(500, 'x')}}}});
+    auto rejected = nlohmann::json::parse(*server.handle_request_serialized(big));
+    ASSERT_TRUE(rejected.contains("error"));
+    EXPECT_EQ(rejected["id"], 2);
+    EXPECT_EQ(rejected["error"]["data"]["budget"], "resultBytes");
+    EXPECT_EQ(rejected["error"]["data"]["limit"], 200);
+
+    // handle_request() returns a DOM and leaves serializing (and this
+    // budget) to the caller
+    EXPECT_TRUE(server.handle_request(big)->contains("result"));
+}
+
+TEST_F(TenantServerTest, InFlightBudget) {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool entered = false;
+    bool release = false;
+    server.register_tool("block", "", {{"type", "object"}},
+        [&](const std::string&, const nlohmann::json&, RequestContext&) {
+            std::unique_lock<std::mutex> lock(mutex);
+            entered = true;
+            cv.notify_all();
+            cv.wait(lock, [&] { return release; });
+            return nlohmann::json{{"content", nlohmann::json::array()}};
+        });
+
+    TenantConfig config;
+    config.budget.max_in_flight = 1;
+    tenants->set_tenant("small", config);
+    as("s1", initialize("small"));
+    as("s2", initialize("small"));
+    as("a", initialize("acme"));
+
+    auto first = std::async(std::launch::async, [&] {
+        return as("s1", request(1, "tools/call", {{"name", "block"}}));
+    });
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] { return entered; });
+    }
+    EXPECT_EQ(tenants->find("small")->in_flight(), 1u);
+
+    // The budget spans the tenant's sessions, not other tenants
+    auto rejected = as("s2", request(2, "tools/list"));
+    EXPECT_EQ(rejected["error"]["data"]["budget"], "inFlight");
+    EXPECT_TRUE(as("a", request(3, "tools/list")).contains("result"));
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        release = true;
+    }
+    cv.notify_all();
+    EXPECT_TRUE(first.get().contains("result"));
+    EXPECT_EQ(tenants->find("small")->in_flight(), 0u);
+    EXPECT_TRUE(as("s2", request(4, "tools/list")).contains("result"));
+}
+
+TEST(CompletionCacheTest, ByteBudgetEvictsOldest) {
+    CompletionCache cache(100, 600);
+    std::vector<Completion> values{{std::string(100, 'a'), std::nullopt}};
+    cache.store("scope", "a", values);
+    cache.store("scope", "b", values);
+    EXPECT_LE(cache.bytes(), 600u);
+    cache.store("scope", "c", values);
+    cache.store("scope", "d", values);
+    EXPECT_LE(cache.bytes(), 600u);
+
+    EXPECT_TRUE(cache.lookup("scope", "d").has_value());
+    EXPECT_FALSE(cache.lookup("scope", "a").has_value());
+
+    // An entry larger than the whole budget is not cached
+    cache.store("scope", "huge", {{std::string(1000, 'h'), std::nullopt}});
+    EXPECT_FALSE(cache.lookup("other", "huge").has_value());
+    EXPECT_LE(cache.bytes(), 600u);
+
+    cache.clear();
+    EXPECT_EQ(cache.bytes(), 0u);
+}
+
+TEST(FairExecutorTest, WeightedShareUnderBacklog) {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool open = false;
+    std::vector<std::string> order;
+
+    FairExecutor::Options options;
+    options.threads = 1;
+    options.weight_of = [](const std::string& flow) { return flow == "heavy" ? 3u : 1u; };
+    FairExecutor executor(options);
+
+    // Hold the single worker until both backlogs are queued
+    executor.submit("gate", [&] {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] { return open; });
+    });
+    for (int i = 0; i < 30; ++i) {
+        executor.submit("noisy", [&] { order.push_back("noisy"); });
+    }
+    for (int i = 0; i < 30; ++i) {
+        executor.submit("heavy", [&] { order.push_back("heavy"); });
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        open = true;
+    }
+    cv.notify_all();
+    executor.stop();
+
+    ASSERT_EQ(order.size(), 60u);
+    EXPECT_EQ(executor.completed("noisy"), 30u);
+    // While both are backlogged, heavy runs three jobs per noisy job
+    int heavy = 0;
+    for (size_t i = 0; i < 20; ++i) {
+        heavy += order[i] == "heavy";
+    }
+    EXPECT_EQ(heavy, 15);
+}
+
+TEST(FairExecutorTest, CostAndQueueBound) {
+    FairExecutor::Options options;
+    options.threads = 1;
+    options.max_queued_per_flow = 1;
+    FairExecutor executor(options);
+
+    std::promise<void> started;
+    std::promise<void> release;
+    auto release_future = release.get_future().share();
+    EXPECT_TRUE(executor.submit("t", [&] {
+        started.set_value();
+        release_future.wait();
+    }));
+    started.get_future().wait();
+    EXPECT_TRUE(executor.submit("t", [] {}, 5));
+    EXPECT_FALSE(executor.submit("t", [] {}));
+
+    release.set_value();
+    executor.stop();
+    EXPECT_EQ(executor.completed("t"), 2u);
+    EXPECT_EQ(executor.pending(), 0u);
+    EXPECT_FALSE(executor.submit("t", [] {}));
+}
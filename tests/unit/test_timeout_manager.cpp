@@ -4,9 +4,76 @@
 // Copyright (c) 2025 mcpp contributors
 // Distributed under MIT License
 
+#include "mcpp/async/timeout.h"
+#include "mcpp/util/clock.h"
+
 #include <gtest/gtest.h>
+#include <chrono>
+#include <memory>
+#include <string>
+
+using namespace mcpp;
+using namespace mcpp::async;
+
+// ============================================================================
+// TimeoutManager with ManualClock
+// ============================================================================
+
+class VirtualTimeoutManagerTest : public ::testing::Test {
+protected:
+    std::shared_ptr<util::ManualClock> clock = std::make_shared<util::ManualClock>();
+    TimeoutManager manager{std::chrono::seconds(30), clock};
+};
+
+TEST_F(VirtualTimeoutManagerTest, DoesNotExpireUntilClockAdvances) {
+    int fired = 0;
+    manager.set_timeout(int64_t{1}, std::chrono::minutes(30), [&](const RequestId&) { ++fired; });
+
+    EXPECT_TRUE(manager.check_timeouts().empty());
+
+    clock->advance(std::chrono::minutes(29));
+    EXPECT_TRUE(manager.check_timeouts().empty());
+
+    clock->advance(std::chrono::minutes(1));
+    auto expired = manager.check_timeouts();
+    ASSERT_EQ(expired.size(), 1u);
+    EXPECT_EQ(std::get<int64_t>(expired[0]), 1);
+    EXPECT_EQ(fired, 1);
+    EXPECT_EQ(manager.pending_count(), 0u);
+}
+
+TEST_F(VirtualTimeoutManagerTest, ExpiresOnlyDueTimers) {
+    for (int64_t i = 0; i < 1000; ++i) {
+        manager.set_timeout(i, std::chrono::milliseconds(i + 1), nullptr);
+    }
+
+    clock->advance(std::chrono::milliseconds(500));
+    EXPECT_EQ(manager.check_timeouts().size(), 500u);
+    EXPECT_EQ(manager.pending_count(), 500u);
+
+    clock->advance(std::chrono::milliseconds(500));
+    EXPECT_EQ(manager.check_timeouts().size(), 500u);
+    EXPECT_EQ(manager.pending_count(), 0u);
+}
+
+TEST_F(VirtualTimeoutManagerTest, ResetReplacesDeadline) {
+    manager.set_timeout(std::string("a"), std::chrono::seconds(10), nullptr);
+    clock->advance(std::chrono::seconds(8));
+    manager.set_timeout(std::string("a"), std::chrono::seconds(10), nullptr);
+    clock->advance(std::chrono::seconds(8));
+
+    EXPECT_TRUE(manager.check_timeouts().empty());
+    clock->advance(std::chrono::seconds(2));
+    EXPECT_EQ(manager.check_timeouts().size(), 1u);
+}
+
+TEST(TimeoutManagerClock, UsesProcessDefaultClock) {
+    auto clock = std::make_shared<util::ManualClock>();
+    util::Clock::set_default_clock(clock);
+    TimeoutManager manager(std::chrono::seconds(1));
+    util::Clock::set_default_clock(nullptr);
 
-// Placeholder - to be implemented in plan 07-02b
-TEST(TimeoutManager, Placeholder) {
-    SUCCEED() << "Unit test placeholder - to be implemented in 07-02b";
+    manager.set_timeout(int64_t{5}, std::chrono::hours(1), nullptr);
+    clock->advance(std::chrono::hours(1));
+    EXPECT_EQ(manager.check_timeouts().size(), 1u);
 }
@@ -0,0 +1,87 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+#include "mcpp/util/timestamp.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <random>
+#include <string>
+#include <thread>
+
+using namespace mcpp;
+using namespace std::chrono;
+
+namespace {
+
+system_clock::time_point at_ms(int64_t ms) {
+    return system_clock::time_point(milliseconds(ms));
+}
+
+std::string gmtime_reference(int64_t seconds) {
+    std::time_t t = static_cast<std::time_t>(seconds);
+    std::tm tm{};
+    ::gmtime_r(&t, &tm);
+    char buf[32];
+    std::strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%S", &tm);
+    return buf;
+}
+
+} // namespace
+
+TEST(Timestamp, FormatsMilliseconds) {
+    EXPECT_EQ(util::format_iso8601(at_ms(0)), "1970-01-01T00:00:00.000Z");
+    EXPECT_EQ(util::format_iso8601(at_ms(1735689600000 + 7)), "2025-01-01T00:00:00.007Z");
+    EXPECT_EQ(util::format_iso8601(at_ms(1735689600000 + 999)), "2025-01-01T00:00:00.999Z");
+    // Leap day, then the second rolls over within the same cache
+    EXPECT_EQ(util::format_iso8601(at_ms(951825599123)), "2000-02-29T11:59:59.123Z");
+    EXPECT_EQ(util::format_iso8601(at_ms(951825600000)), "2000-02-29T12:00:00.000Z");
+}
+
+TEST(Timestamp, BeforeEpochRoundsDown) {
+    EXPECT_EQ(util::format_iso8601(at_ms(-1)), "1969-12-31T23:59:59.999Z");
+}
+
+TEST(Timestamp, WritesExactlyIso8601Length) {
+    char buf[util::ISO8601_LENGTH + 1];
+    buf[util::ISO8601_LENGTH] = '#';
+    char* end = util::write_iso8601(at_ms(1735689600000), buf);
+    EXPECT_EQ(end, buf + util::ISO8601_LENGTH);
+    EXPECT_EQ(buf[util::ISO8601_LENGTH], '#');
+}
+
+TEST(Timestamp, MatchesGmtime) {
+    std::mt19937_64 rng(42);
+    // system_clock counts nanoseconds here, which overflows after 2262
+    std::uniform_int_distribution<int64_t> seconds(-2208988800, 9000000000);  // 1900-2255
+    for (int i = 0; i < 10000; ++i) {
+        int64_t s = seconds(rng);
+        std::string text = util::format_iso8601(at_ms(s * 1000 + 250));
+        ASSERT_EQ(text, gmtime_reference(s) + ".250Z") << s;
+    }
+}
+
+TEST(Timestamp, CacheIsPerThread) {
+    std::string a;
+    std::string b;
+    std::thread t1([&] {
+        for (int i = 0; i < 1000; ++i) {
+            a = util::format_iso8601(at_ms(1000LL * (i % 2)));
+        }
+    });
+    std::thread t2([&] {
+        for (int i = 0; i < 1000; ++i) {
+            b = util::format_iso8601(at_ms(86400000LL + 1000LL * (i % 2)));
+        }
+    });
+    t1.join();
+    t2.join();
+    EXPECT_EQ(a, "1970-01-01T00:00:01.000Z");
+    EXPECT_EQ(b, "1970-01-02T00:00:01.000Z");
+}
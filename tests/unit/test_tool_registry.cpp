@@ -5,6 +5,7 @@
 // Distributed under MIT License
 
 #include "mcpp/server/tool_registry.h"
+#include "mcpp/util/metrics.h"
 #include <gtest/gtest.h>
 #include <nlohmann/json.hpp>
 
@@ -324,3 +325,33 @@ TEST(ToolRegistry, CallTool_PassesArgumentsToHandler) {
     EXPECT_EQ(received_y, 32);
     EXPECT_EQ((*result)["content"][0]["text"], "42");
 }
+
+TEST(ToolRegistry, CpuAccounting_RecordsPerToolMetrics) {
+    ToolRegistry registry;
+    MockTransport transport;
+    RequestContext ctx("cpu-1", transport);
+
+    registry.register_tool("spin", "Burns some CPU", nlohmann::json{{"type", "object"}},
+        [](const std::string&, const nlohmann::json&, RequestContext&) {
+            volatile uint64_t acc = 0;
+            for (uint64_t i = 0; i < 2000000; ++i) {
+                acc = acc + i;
+            }
+            return nlohmann::json{{"content", nlohmann::json::array()}, {"isError", false}};
+        }
+    );
+
+    auto& registry_metrics = util::MetricsRegistry::global();
+    auto& calls = registry_metrics.counter("tool.spin.calls");
+    auto& cpu_ns = registry_metrics.histogram("tool.spin.cpu_ns");
+    uint64_t calls_before = calls.value();
+
+    // Disabled by default
+    registry.call_tool("spin", nlohmann::json::object(), ctx);
+    EXPECT_EQ(calls.value(), calls_before);
+
+    registry.set_cpu_accounting(true);
+    registry.call_tool("spin", nlohmann::json::object(), ctx);
+    EXPECT_EQ(calls.value(), calls_before + 1);
+    EXPECT_GT(cpu_ns.max(), 0u);
+}
@@ -0,0 +1,367 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+#include "mcpp/transport/websocket_server.h"
+#include "mcpp/transport/websocket_transport.h"
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mcpp::transport;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Collects messages and errors delivered on a transport's read thread
+struct Inbox {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<std::string> messages;
+    std::vector<std::string> errors;
+
+    void attach(WebSocketTransport& transport) {
+        transport.set_message_callback([this](std::string_view message) {
+            std::lock_guard<std::mutex> lock(mutex);
+            messages.emplace_back(message);
+            cv.notify_all();
+        });
+        transport.set_error_callback([this](std::string_view error) {
+            std::lock_guard<std::mutex> lock(mutex);
+            errors.emplace_back(error);
+            cv.notify_all();
+        });
+    }
+
+    bool wait_messages(size_t count, std::chrono::milliseconds timeout = 3s) {
+        std::unique_lock<std::mutex> lock(mutex);
+        return cv.wait_for(lock, timeout, [&]() { return messages.size() >= count; });
+    }
+
+    bool wait_error(std::chrono::milliseconds timeout = 3s) {
+        std::unique_lock<std::mutex> lock(mutex);
+        return cv.wait_for(lock, timeout, [&]() { return !errors.empty(); });
+    }
+};
+
+// Server that echoes every message back on the same connection
+class EchoServer {
+public:
+    explicit EchoServer(WebSocketServer::Options options = {}, bool start_reading = true)
+        : server_(std::move(options)) {
+        server_.start([this, start_reading](std::unique_ptr<WebSocketTransport> transport) {
+            WebSocketTransport* raw = transport.get();
+            raw->set_message_callback([raw](std::string_view message) { raw->send(message); });
+            if (start_reading) {
+                raw->connect();
+            }
+            std::lock_guard<std::mutex> lock(mutex_);
+            sessions_.push_back(std::move(transport));
+        });
+    }
+
+    uint16_t port() const { return server_.port(); }
+
+    WebSocketTransport* session(std::chrono::milliseconds timeout = 2s) {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (std::chrono::steady_clock::now() < deadline) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!sessions_.empty()) {
+                    return sessions_.front().get();
+                }
+            }
+            std::this_thread::sleep_for(1ms);
+        }
+        return nullptr;
+    }
+
+private:
+    WebSocketServer server_;
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<WebSocketTransport>> sessions_;
+};
+
+std::unique_ptr<WebSocketTransport> dial(uint16_t port, WebSocketTransport::Options options = {}) {
+    std::string error;
+    auto transport = WebSocketTransport::connect_to("127.0.0.1", port, options, error);
+    EXPECT_TRUE(transport) << error;
+    return transport;
+}
+
+std::string request(int i, const std::string& padding = "") {
+    return nlohmann::json{{"jsonrpc", "2.0"}, {"id", i}, {"method", "ping"},
+                          {"params", {{"pad", padding}}}}.dump();
+}
+
+// Handshake by hand so the test controls every byte sent afterwards;
+// returns the connected socket, or -1
+int raw_dial(uint16_t port, const std::string& protocol) {
+    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        return -1;
+    }
+    std::string request = "GET /mcp HTTP/1.1\r\n"
+                          "Host: 127.0.0.1\r\n"
+                          "Upgrade: websocket\r\n"
+                          "Connection: Upgrade\r\n"
+                          "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+                          "Sec-WebSocket-Version: 13\r\n"
+                          "Sec-WebSocket-Protocol: " + protocol + "\r\n\r\n";
+    ::send(fd, request.data(), request.size(), MSG_NOSIGNAL);
+    std::string head;
+    char c;
+    while (head.find("\r\n\r\n") == std::string::npos && ::recv(fd, &c, 1, 0) == 1) {
+        head += c;
+    }
+    if (head.find(" 101 ") == std::string::npos) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+} // namespace
+
+TEST(WebSocketTransportTest, AcceptKeyMatchesRfcExample) {
+    EXPECT_EQ(WebSocketTransport::accept_key("dGhlIHNhbXBsZSBub25jZQ=="),
+              "s3pPLMBiTxaQ9kYGzzhZRbK+xOo=");
+}
+
+TEST(WebSocketTransportTest, EchoesMessagesInOrder) {
+    EchoServer server;
+    auto client = dial(server.port());
+    ASSERT_TRUE(client);
+    EXPECT_EQ(client->role(), WebSocketTransport::Role::Client);
+    EXPECT_EQ(client->encoding(), WebSocketTransport::Encoding::Text);
+
+    Inbox inbox;
+    inbox.attach(*client);
+    ASSERT_TRUE(client->connect());
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(client->send(request(i)));
+    }
+
+    ASSERT_TRUE(inbox.wait_messages(100));
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(inbox.messages[i], request(i));
+    }
+}
+
+TEST(WebSocketTransportTest, LargeMessageIsFragmentedAndReassembled) {
+    WebSocketServer::Options server_options;
+    server_options.transport.fragment_size = 1024;
+    EchoServer server(server_options);
+
+    WebSocketTransport::Options options;
+    options.fragment_size = 4096;
+    auto client = dial(server.port(), options);
+    ASSERT_TRUE(client);
+
+    Inbox inbox;
+    inbox.attach(*client);
+    ASSERT_TRUE(client->connect());
+    std::string big = request(1, std::string(300 * 1024, 'x'));
+    ASSERT_TRUE(client->send(big));
+
+    ASSERT_TRUE(inbox.wait_messages(1));
+    EXPECT_EQ(inbox.messages[0], big);
+}
+
+TEST(WebSocketTransportTest, NegotiatesCborEncoding) {
+    WebSocketServer::Options server_options;
+    server_options.transport.allow_cbor = true;
+    EchoServer server(server_options);
+
+    WebSocketTransport::Options options;
+    options.allow_cbor = true;
+    auto client = dial(server.port(), options);
+    ASSERT_TRUE(client);
+    EXPECT_EQ(client->encoding(), WebSocketTransport::Encoding::Cbor);
+
+    Inbox inbox;
+    inbox.attach(*client);
+    ASSERT_TRUE(client->connect());
+    ASSERT_TRUE(client->send(request(7, "héllo")));
+
+    ASSERT_TRUE(inbox.wait_messages(1));
+    EXPECT_EQ(nlohmann::json::parse(inbox.messages[0]), nlohmann::json::parse(request(7, "héllo")));
+    ASSERT_NE(server.session(), nullptr);
+    EXPECT_EQ(server.session()->encoding(), WebSocketTransport::Encoding::Cbor);
+}
+
+TEST(WebSocketTransportTest, CborWithInvalidUtf8ClosesConnection) {
+    WebSocketServer::Options server_options;
+    server_options.transport.allow_cbor = true;
+    EchoServer server(server_options);
+
+    int fd = raw_dial(server.port(), "mcp.cbor");
+    ASSERT_GE(fd, 0);
+    // Masked binary frame holding the CBOR text string "\xff"
+    const unsigned char frame[] = {0x82, 0x82, 0, 0, 0, 0, 0x61, 0xff};
+    ASSERT_EQ(::send(fd, frame, sizeof(frame), MSG_NOSIGNAL), static_cast<ssize_t>(sizeof(frame)));
+
+    std::string reply;
+    char buf[64];
+    ssize_t n;
+    while ((n = ::recv(fd, buf, sizeof(buf), 0)) > 0) {
+        reply.append(buf, static_cast<size_t>(n));
+    }
+    ::close(fd);
+    // Close frame with status 1007 (invalid frame payload data)
+    EXPECT_EQ(reply, std::string("\x88\x02\x03\xef", 4));
+}
+
+TEST(WebSocketTransportTest, ServerWithoutCborFallsBackToText) {
+    EchoServer server;
+    WebSocketTransport::Options options;
+    options.allow_cbor = true;
+    auto client = dial(server.port(), options);
+    ASSERT_TRUE(client);
+    EXPECT_EQ(client->encoding(), WebSocketTransport::Encoding::Text);
+}
+
+TEST(WebSocketTransportTest, PermessageDeflateRoundTrips) {
+    if (!WebSocketTransport::deflate_supported()) {
+        GTEST_SKIP() << "built without MCPP_WITH_ZLIB";
+    }
+    EchoServer server;
+    auto client = dial(server.port());
+    ASSERT_TRUE(client);
+    EXPECT_TRUE(client->uses_deflate());
+
+    Inbox inbox;
+    inbox.attach(*client);
+    ASSERT_TRUE(client->connect());
+    std::string small = request(1);
+    std::string big = request(2, std::string(200 * 1024, 'z'));
+    ASSERT_TRUE(client->send(small));
+    ASSERT_TRUE(client->send(big));
+
+    ASSERT_TRUE(inbox.wait_messages(2));
+    EXPECT_EQ(inbox.messages[0], small);
+    EXPECT_EQ(inbox.messages[1], big);
+}
+
+TEST(WebSocketTransportTest, KeepalivePingsAreAnswered) {
+    EchoServer server;
+    WebSocketTransport::Options options;
+    options.ping_interval = 10ms;
+    options.pong_timeout = 1s;
+    auto client = dial(server.port(), options);
+    ASSERT_TRUE(client);
+
+    Inbox inbox;
+    inbox.attach(*client);
+    ASSERT_TRUE(client->connect());
+
+    auto deadline = std::chrono::steady_clock::now() + 3s;
+    while (client->pongs_received() < 3 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(5ms);
+    }
+    EXPECT_GE(client->pongs_received(), 3u);
+    EXPECT_TRUE(client->is_connected());
+    EXPECT_TRUE(inbox.errors.empty());
+}
+
+TEST(WebSocketTransportTest, KeepaliveDetectsSilentPeer) {
+    // The server side never starts reading, so pings go unanswered
+    EchoServer server({}, false);
+    WebSocketTransport::Options options;
+    options.ping_interval = 10ms;
+    options.pong_timeout = 30ms;
+    auto client = dial(server.port(), options);
+    ASSERT_TRUE(client);
+
+    Inbox inbox;
+    inbox.attach(*client);
+    ASSERT_TRUE(client->connect());
+
+    ASSERT_TRUE(inbox.wait_error());
+    EXPECT_EQ(inbox.errors[0], "keepalive timeout");
+    EXPECT_FALSE(client->is_connected());
+}
+
+TEST(WebSocketTransportTest, ServerSessionIsNamedAndReportedClosed) {
+    std::promise<std::string> closed;
+    WebSocketServer::Options server_options;
+    server_options.transport.on_session_closed = [&](std::string_view session) {
+        closed.set_value(std::string(session));
+    };
+    EchoServer server(server_options);
+
+    auto client = dial(server.port());
+    ASSERT_TRUE(client);
+    EXPECT_TRUE(client->session_id().empty());
+    ASSERT_TRUE(client->connect());
+    WebSocketTransport* session = server.session();
+    ASSERT_NE(session, nullptr);
+    EXPECT_EQ(session->session_id().size(), 32u);
+
+    client->disconnect();
+    auto future = closed.get_future();
+    ASSERT_EQ(future.wait_for(2s), std::future_status::ready);
+    EXPECT_EQ(future.get(), session->session_id());
+}
+
+TEST(WebSocketTransportTest, PeerCloseIsReported) {
+    EchoServer server;
+    auto client = dial(server.port());
+    ASSERT_TRUE(client);
+    Inbox inbox;
+    inbox.attach(*client);
+    ASSERT_TRUE(client->connect());
+
+    WebSocketTransport* session = server.session();
+    ASSERT_NE(session, nullptr);
+    session->disconnect();
+
+    ASSERT_TRUE(inbox.wait_error());
+    EXPECT_EQ(inbox.errors[0], "connection closed by peer");
+    EXPECT_FALSE(client->is_connected());
+    EXPECT_FALSE(client->send(request(1)));
+}
+
+TEST(WebSocketTransportTest, OversizedMessageClosesConnection) {
+    WebSocketServer::Options server_options;
+    server_options.transport.limits.max_frame_bytes = 1024;
+    EchoServer server(server_options);
+
+    auto client = dial(server.port());
+    ASSERT_TRUE(client);
+    Inbox inbox;
+    inbox.attach(*client);
+    ASSERT_TRUE(client->connect());
+    ASSERT_TRUE(client->send(request(1, std::string(4096, 'x'))));
+
+    ASSERT_TRUE(inbox.wait_error());
+    EXPECT_FALSE(client->is_connected());
+}
+
+TEST(WebSocketTransportTest, HandshakeRejectsUnknownPath) {
+    EchoServer server;
+    WebSocketTransport::Options options;
+    options.path = "/other";
+    std::string error;
+    auto client = WebSocketTransport::connect_to("127.0.0.1", server.port(), options, error);
+    EXPECT_FALSE(client);
+    EXPECT_NE(error.find("404"), std::string::npos);
+}
@@ -0,0 +1,300 @@
+// mcpp - MCP C++ library
+// https://github.com/mcpp-project/mcpp
+//
+// Copyright (c) 2025 mcpp contributors
+// Distributed under MIT License
+
+#include "mcpp/server/worker_pool.h"
+#include "mcpp/server/tool_registry.h"
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace mcpp;
+using namespace mcpp::server;
+using namespace std::chrono_literals;
+
+namespace {
+
+class RecordingTransport : public transport::Transport {
+public:
+    bool connect() override { return true; }
+    void disconnect() override {}
+    bool is_connected() const override { return true; }
+    bool send(std::string_view message) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        sent.emplace_back(message);
+        return true;
+    }
+    void set_message_callback(MessageCallback) override {}
+    void set_error_callback(ErrorCallback) override {}
+
+    std::mutex mutex;
+    std::vector<std::string> sent;
+};
+
+nlohmann::json text_result(const std::string& text) {
+    return {{"content", {{{"type", "text"}, {"text", text}}}}};
+}
+
+std::string result_text(const nlohmann::json& result) {
+    return result["content"][0]["text"].get<std::string>();
+}
+
+ToolHandler pid_handler() {
+    return [](const std::string&, const nlohmann::json&, RequestContext&) {
+        return text_result(std::to_string(::getpid()));
+    };
+}
+
+ToolHandler sleep_handler() {
+    return [](const std::string&, const nlohmann::json&, RequestContext&) {
+        std::this_thread::sleep_for(10s);
+        return text_result("woke");
+    };
+}
+
+} // namespace
+
+TEST(WorkerPoolTest, RunsHandlerInWorkerProcess) {
+    WorkerPool pool;
+    auto handler = pool.isolate("pid", pid_handler());
+    ASSERT_TRUE(pool.start());
+    EXPECT_EQ(pool.stats().workers, 2u);
+
+    RecordingTransport transport;
+    RequestContext ctx("1", transport);
+    auto result = handler("pid", nlohmann::json::object(), ctx);
+
+    EXPECT_FALSE(result.value("isError", false));
+    EXPECT_NE(result_text(result), std::to_string(::getpid()));
+    EXPECT_EQ(pool.stats().calls, 1u);
+}
+
+TEST(WorkerPoolTest, WorkersAreForkedFromZygoteNotServer) {
+    WorkerPool::Options options;
+    options.workers = 1;
+    options.max_calls_per_worker = 1;
+    WorkerPool pool(options);
+    auto handler = pool.isolate("ppid", [](const std::string&, const nlohmann::json&, RequestContext&) {
+        return text_result(std::to_string(::getppid()));
+    });
+    ASSERT_TRUE(pool.start());
+
+    RecordingTransport transport;
+    RequestContext ctx("1", transport);
+    auto first = handler("ppid", nlohmann::json::object(), ctx);
+    auto replacement = handler("ppid", nlohmann::json::object(), ctx);
+
+    // The replacement worker comes from the same zygote, never the server
+    EXPECT_NE(result_text(first), std::to_string(::getpid()));
+    EXPECT_EQ(result_text(replacement), result_text(first));
+    EXPECT_EQ(pool.stats().restarts, 2u);
+}
+
+TEST(WorkerPoolTest, CrashingHandlerIsReportedAndWorkerRestarted) {
+    WorkerPool::Options options;
+    options.workers = 1;
+    WorkerPool pool(options);
+    auto crash = pool.isolate("crash", [](const std::string&, const nlohmann::json&, RequestContext&)
+                                           -> nlohmann::json { std::abort(); });
+    auto pid = pool.isolate("pid", pid_handler());
+    ASSERT_TRUE(pool.start());
+
+    RecordingTransport transport;
+    RequestContext ctx("1", transport);
+    auto result = crash("crash", nlohmann::json::object(), ctx);
+    EXPECT_TRUE(result.value("isError", false));
+    EXPECT_NE(result_text(result).find("signal"), std::string::npos);
+
+    auto after = pid("pid", nlohmann::json::object(), ctx);
+    EXPECT_FALSE(after.value("isError", false));
+
+    auto stats = pool.stats();
+    EXPECT_EQ(stats.crashes, 1u);
+    EXPECT_EQ(stats.restarts, 1u);
+    EXPECT_EQ(stats.workers, 1u);
+}
+
+TEST(WorkerPoolTest, HandlerExceptionBecomesToolError) {
+    WorkerPool pool;
+    auto handler = pool.isolate("throw", [](const std::string&, const nlohmann::json&, RequestContext&)
+                                             -> nlohmann::json { throw std::runtime_error("boom"); });
+    ASSERT_TRUE(pool.start());
+
+    RecordingTransport transport;
+    RequestContext ctx("1", transport);
+    auto result = handler("throw", nlohmann::json::object(), ctx);
+    EXPECT_TRUE(result.value("isError", false));
+    EXPECT_NE(result_text(result).find("boom"), std::string::npos);
+    EXPECT_EQ(pool.stats().restarts, 0u);
+}
+
+TEST(WorkerPoolTest, DeadlineKillsWorker) {
+    WorkerPool::Options options;
+    options.workers = 1;
+    WorkerPool pool(options);
+    auto handler = pool.isolate("sleep", sleep_handler());
+    ASSERT_TRUE(pool.start());
+
+    RecordingTransport transport;
+    RequestContext ctx("1", transport, 50ms);
+    auto start = std::chrono::steady_clock::now();
+    auto result = handler("sleep", nlohmann::json::object(), ctx);
+
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 5s);
+    EXPECT_TRUE(result.value("isError", false));
+    EXPECT_EQ(pool.stats().timeouts, 1u);
+    EXPECT_EQ(pool.stats().workers, 1u);
+}
+
+TEST(WorkerPoolTest, ReplacingWorkerDoesNotBlockPool) {
+    WorkerPool::Options options;
+    options.workers = 2;
+    WorkerPool pool(options);
+    auto sleep = pool.isolate("sleep", sleep_handler());
+    auto pid = pool.isolate("pid", pid_handler());
+    ASSERT_TRUE(pool.start());
+
+    // The timed-out worker ignores EOF, so its reap waits out the exit grace
+    std::atomic<bool> done{false};
+    std::thread caller([&] {
+        RecordingTransport transport;
+        RequestContext ctx("1", transport, 50ms);
+        sleep("sleep", nlohmann::json::object(), ctx);
+        done = true;
+    });
+
+    auto slowest = 0ms;
+    while (!done) {
+        auto start = std::chrono::steady_clock::now();
+        pool.stats();
+        slowest = std::max(slowest, std::chrono::duration_cast<std::chrono::milliseconds>(
+                                        std::chrono::steady_clock::now() - start));
+    }
+    caller.join();
+    EXPECT_LT(slowest, 50ms);
+
+    RecordingTransport transport;
+    RequestContext ctx("2", transport);
+    EXPECT_FALSE(pid("pid", nlohmann::json::object(), ctx).value("isError", false));
+    EXPECT_EQ(pool.stats().timeouts, 1u);
+    EXPECT_EQ(pool.stats().workers, 2u);
+}
+
+TEST(WorkerPoolTest, CancelKillsInFlightCall) {
+    WorkerPool::Options options;
+    options.workers = 1;
+    WorkerPool pool(options);
+    auto handler = pool.isolate("sleep", sleep_handler());
+    ASSERT_TRUE(pool.start());
+
+    std::thread canceller([&pool]() {
+        while (!pool.cancel("req-7")) {
+            std::this_thread::sleep_for(5ms);
+        }
+    });
+
+    RecordingTransport transport;
+    RequestContext ctx("req-7", transport);
+    auto result = handler("sleep", nlohmann::json::object(), ctx);
+    canceller.join();
+
+    EXPECT_TRUE(result.value("isError", false));
+    EXPECT_EQ(result_text(result), "Tool call cancelled");
+    EXPECT_EQ(pool.stats().cancellations, 1u);
+    EXPECT_EQ(pool.stats().crashes, 0u);
+}
+
+TEST(WorkerPoolTest, ProgressIsRelayedToServerTransport) {
+    WorkerPool pool;
+    auto handler = pool.isolate("progress", [](const std::string&, const nlohmann::json&,
+                                               RequestContext& ctx) {
+        ctx.report_progress(50, "halfway");
+        return text_result("done");
+    });
+    ASSERT_TRUE(pool.start());
+
+    RecordingTransport transport;
+    RequestContext ctx("1", transport);
+    ctx.set_progress_token("tok");
+    auto result = handler("progress", nlohmann::json::object(), ctx);
+
+    EXPECT_EQ(result_text(result), "done");
+    ASSERT_EQ(transport.sent.size(), 1u);
+    auto notification = nlohmann::json::parse(transport.sent[0]);
+    EXPECT_EQ(notification["method"], "notifications/progress");
+    EXPECT_EQ(notification["params"]["progressToken"], "tok");
+}
+
+TEST(WorkerPoolTest, MemoryLimitFailsAllocationInWorker) {
+    WorkerPool::Options options;
+    options.limits.max_memory_bytes = 512ull * 1024 * 1024;
+    WorkerPool pool(options);
+    auto handler = pool.isolate("hog", [](const std::string&, const nlohmann::json&, RequestContext&) {
+        std::vector<char> block(2ull * 1024 * 1024 * 1024, 1);
+        return text_result(std::to_string(block.size()));
+    });
+    ASSERT_TRUE(pool.start());
+
+    RecordingTransport transport;
+    RequestContext ctx("1", transport);
+    auto result = handler("hog", nlohmann::json::object(), ctx);
+    EXPECT_TRUE(result.value("isError", false));
+}
+
+TEST(WorkerPoolTest, RecyclesWorkerAfterMaxCalls) {
+    WorkerPool::Options options;
+    options.workers = 1;
+    options.max_calls_per_worker = 2;
+    WorkerPool pool(options);
+    auto handler = pool.isolate("pid", pid_handler());
+    ASSERT_TRUE(pool.start());
+
+    RecordingTransport transport;
+    RequestContext ctx("1", transport);
+    std::string first = result_text(handler("pid", {}, ctx));
+    EXPECT_EQ(result_text(handler("pid", {}, ctx)), first);
+    EXPECT_NE(result_text(handler("pid", {}, ctx)), first);
+    EXPECT_EQ(pool.stats().restarts, 1u);
+}
+
+TEST(WorkerPoolTest, IsolatedToolIsCalledThroughRegistry) {
+    WorkerPool pool;
+    ToolRegistry registry;
+    registry.register_tool(
+        "add", "Add two numbers",
+        {{"type", "object"},
+         {"properties", {{"a", {{"type", "integer"}}}, {"b", {{"type", "integer"}}}}}},
+        pool.isolate("add", [](const std::string&, const nlohmann::json& args, RequestContext&) {
+            return text_result(std::to_string(args["a"].get<int>() + args["b"].get<int>()));
+        }));
+    ASSERT_TRUE(pool.start());
+
+    RecordingTransport transport;
+    RequestContext ctx("1", transport);
+    auto result = registry.call_tool("add", {{"a", 2}, {"b", 40}}, ctx);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(result_text(*result), "42");
+}
+
+TEST(WorkerPoolTest, CallAfterStopReturnsError) {
+    WorkerPool pool;
+    auto handler = pool.isolate("pid", pid_handler());
+    ASSERT_TRUE(pool.start());
+    pool.stop();
+    EXPECT_EQ(pool.stats().workers, 0u);
+
+    RecordingTransport transport;
+    RequestContext ctx("1", transport);
+    EXPECT_TRUE(handler("pid", {}, ctx).value("isError", false));
+}